@@ -397,6 +397,18 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0.0, max=1.0,
         default=0.01,
     )
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Pick point, spot and area lights based on their estimated contribution to the shading point, "
+        "rather than only on their number. Reduces noise in scenes with many lights",
+        default=False,
+    )
+    use_path_guiding: BoolProperty(
+        name="Path Guiding",
+        description="Learn the distribution of indirect light while rendering and use it to sample diffuse bounces. "
+        "Reduces noise in scenes lit mostly by indirect light. Only supported by the CPU with Path Tracing",
+        default=False,
+    )
 
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
@@ -677,6 +689,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_types,
         default='DYNAMIC_BVH',
     )
+    use_render_statistics: BoolProperty(
+        name="Render Statistics",
+        description="Measure the render time spent in kernel stages, shaders and objects, and store it in the "
+        "render result metadata (only for final renders on the CPU)",
+        default=False,
+    )
+
     debug_use_spatial_splits: BoolProperty(
         name="Use Spatial Splits",
         description="Use BVH spatial splits: longer builder time, faster render",
@@ -708,6 +727,14 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         "but time can be saved by manually stopping the render when the noise is low enough)",
         default=False,
     )
+    time_limit: FloatProperty(
+        name="Time Limit",
+        description="Stop refining the image when the next pass of samples would exceed this render time in seconds. "
+        "Combined with adaptive sampling, the remaining time goes to the noisiest pixels of the image. "
+        "Zero to disable",
+        min=0.0, soft_max=3600.0,
+        default=0.0,
+    )
 
     bake_type: EnumProperty(
         name="Bake Type",
@@ -1370,6 +1397,12 @@ class CyclesRenderLayerSettings(bpy.types.PropertyGroup):
         default=False,
         update=update_render_passes,
     )
+    pass_debug_adaptive_error: BoolProperty(
+        name="Debug Adaptive Error",
+        description="Noise level estimated by adaptive sampling per pixel, in the same units as the adaptive sampling threshold",
+        default=False,
+        update=update_render_passes,
+    )
     use_pass_volume_direct: BoolProperty(
         name="Volume Direct",
         description="Deliver direct volumetric scattering pass",
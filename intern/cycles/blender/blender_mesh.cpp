@@ -36,6 +36,8 @@
 
 #include "mikktspace.h"
 
+#include "DNA_meshdata_types.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* Tangent Space */
@@ -731,6 +733,28 @@ static void attr_create_random_per_island(Scene *scene,
 
 /* Create Mesh */
 
+/* Direct access to the DNA arrays of the mesh, the collections are contiguous arrays so the
+ * first element points to all of them. Only valid for non-empty collections. */
+static const MVert *mesh_vertices(BL::Mesh &b_mesh)
+{
+  return static_cast<const MVert *>(b_mesh.vertices[0].ptr.data);
+}
+
+static const MLoop *mesh_loops(BL::Mesh &b_mesh)
+{
+  return static_cast<const MLoop *>(b_mesh.loops[0].ptr.data);
+}
+
+static const MPoly *mesh_polygons(BL::Mesh &b_mesh)
+{
+  return static_cast<const MPoly *>(b_mesh.polygons[0].ptr.data);
+}
+
+static const MLoopTri *mesh_loop_triangles(BL::Mesh &b_mesh)
+{
+  return static_cast<const MLoopTri *>(b_mesh.loop_triangles[0].ptr.data);
+}
+
 static void create_mesh(Scene *scene,
                         Mesh *mesh,
                         BL::Mesh &b_mesh,
@@ -770,18 +794,22 @@ static void create_mesh(Scene *scene,
 
   mesh->reserve_mesh(numverts, numtris);
 
-  /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  /* create vertex coordinates and normals
+   *
+   * Read the vertex array of the evaluated mesh directly, going through RNA for every
+   * vertex is a lot slower on dense meshes. */
+  const MVert *mverts = mesh_vertices(b_mesh);
+  for (int i = 0; i < numverts; i++)
+    mesh->add_vertex(make_float3(mverts[i].co[0], mverts[i].co[1], mverts[i].co[2]));
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  for (int i = 0; i < numverts; i++) {
+    const short *no = mverts[i].no;
+    N[i] = make_float3(no[0], no[1], no[2]) * (1.0f / 32767.0f);
+  }
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.length() == 0) &&
@@ -796,6 +824,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -803,22 +832,18 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
-    BL::Mesh::loop_triangles_iterator t;
-
-    for (b_mesh.loop_triangles.begin(t); t != b_mesh.loop_triangles.end(); ++t) {
-      BL::MeshPolygon p = b_mesh.polygons[t->polygon_index()];
-      int3 vi = get_int3(t->vertices());
+    const MLoopTri *looptris = mesh_loop_triangles(b_mesh);
+    const MLoop *mloops = mesh_loops(b_mesh);
+    const MPoly *mpolys = mesh_polygons(b_mesh);
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int i = 0; i < numtris; i++) {
+      const MLoopTri &looptri = looptris[i];
+      const MPoly &poly = mpolys[looptri.poly];
+      int3 vi = make_int3(
+          mloops[looptri.tri[0]].v, mloops[looptri.tri[1]].v, mloops[looptri.tri[2]].v);
 
-      if (use_loop_normals) {
-        BL::Array<float, 9> loop_normals = t->split_normals();
-        for (int i = 0; i < 3; i++) {
-          N[vi[i]] = make_float3(
-              loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
-        }
-      }
+      int shader = clamp((int)poly.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (poly.flag & ME_SMOOTH) || use_loop_normals;
 
       /* Create triangles.
        *
@@ -826,6 +851,20 @@ static void create_mesh(Scene *scene,
        */
       mesh->add_triangle(vi[0], vi[1], vi[2], shader, smooth);
     }
+
+    if (use_loop_normals) {
+      BL::Mesh::loop_triangles_iterator t;
+      int i = 0;
+
+      for (b_mesh.loop_triangles.begin(t); t != b_mesh.loop_triangles.end(); ++t, ++i) {
+        const int *vi = &mesh->get_triangles()[i * 3];
+        BL::Array<float, 9> loop_normals = t->split_normals();
+        for (int j = 0; j < 3; j++) {
+          N[vi[j]] = make_float3(
+              loop_normals[j * 3], loop_normals[j * 3 + 1], loop_normals[j * 3 + 2]);
+        }
+      }
+    }
   }
   else {
     BL::Mesh::polygons_iterator p;
@@ -225,7 +225,6 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   }
 
   session->progress.reset();
-  scene->reset();
 
   session->tile_manager.set_tile_order(session_params.tile_order);
 
@@ -234,12 +233,11 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
    */
   session->stats.mem_peak = session->stats.mem_used;
 
-  /* There is no single depsgraph to use for the entire render.
-   * See note on create_session().
-   */
-  /* sync object should be re-created */
-  delete sync;
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  /* With persistent data Blender keeps the depsgraph between renders, so the scene and sync
+   * object are kept as well and only data updated since the previous render is synced again.
+   * A new depsgraph has new evaluated data, which is then synced as new data while the old
+   * data is removed as unused. */
+  sync->sync_recalc(b_depsgraph, b_v3d);
 
   BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
   BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
@@ -426,6 +424,44 @@ static void add_cryptomatte_layer(BL::RenderResult &b_rr, string name, string ma
   render_add_metadata(b_rr, prefix + "manifest", manifest);
 }
 
+static void stamp_nested_sample_stats(BL::RenderResult &b_rr,
+                                      const string &prefix,
+                                      const NamedNestedSampleStats &stats)
+{
+  const string name = prefix + stats.name;
+  b_rr.stamp_data_add_field(name.c_str(),
+                            string_printf("%.2fs (self %.2fs)",
+                                          stats.sum_samples * 0.001,
+                                          stats.self_samples * 0.001)
+                                .c_str());
+
+  foreach (const NamedNestedSampleStats &entry, stats.entries) {
+    stamp_nested_sample_stats(b_rr, name + ".", entry);
+  }
+}
+
+static void stamp_sample_count_stats(BL::RenderResult &b_rr,
+                                     const string &prefix,
+                                     const NamedSampleCountStats &stats)
+{
+  uint64_t total_hits = 0, total_samples = 0;
+  foreach (NamedSampleCountStats::entry_map::const_reference entry, stats.entries) {
+    total_hits += entry.second.hits;
+    total_samples += entry.second.samples;
+  }
+  const double avg_samples_per_hit = (total_hits) ? ((double)total_samples) / total_hits : 0.0;
+
+  foreach (NamedSampleCountStats::entry_map::const_reference entry, stats.entries) {
+    const NamedSampleCountPair &pair = entry.second;
+    const double expected_samples = pair.hits * avg_samples_per_hit;
+    const double relative = (expected_samples > 0.0) ? pair.samples / expected_samples : 0.0;
+
+    b_rr.stamp_data_add_field(
+        (prefix + pair.name.string()).c_str(),
+        string_printf("%.2fs (relative cost %.2f)", pair.samples * 0.001, relative).c_str());
+  }
+}
+
 void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_layer_name)
 {
   BL::RenderResult b_rr = b_engine.get_result();
@@ -469,6 +505,20 @@ void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_
                             time_human_readable_from_seconds(render_time).c_str());
   b_rr.stamp_data_add_field((prefix + "synchronization_time").c_str(),
                             time_human_readable_from_seconds(total_time - render_time).c_str());
+
+  /* Store profiling statistics, to find the kernel stages, shaders and objects that take most
+   * of the render time. */
+  if (session->params.use_profiling) {
+    RenderStats stats;
+    session->collect_statistics(&stats);
+
+    if (stats.has_profiling) {
+      stats.kernel.update_sum();
+      stamp_nested_sample_stats(b_rr, prefix + "stats.kernel.", stats.kernel);
+      stamp_sample_count_stats(b_rr, prefix + "stats.shader.", stats.shaders);
+      stamp_sample_count_stats(b_rr, prefix + "stats.object.", stats.objects);
+    }
+  }
 }
 
 void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
@@ -316,6 +316,8 @@ void BlenderSync::sync_integrator()
   integrator->set_sample_all_lights_direct(get_boolean(cscene, "sample_all_lights_direct"));
   integrator->set_sample_all_lights_indirect(get_boolean(cscene, "sample_all_lights_indirect"));
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
+  integrator->set_use_path_guiding(get_boolean(cscene, "use_path_guiding"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
@@ -536,6 +538,7 @@ PassType BlenderSync::get_pass_type(BL::RenderPass &b_pass)
   MAP_PASS("Debug Render Time", PASS_RENDER_TIME);
   MAP_PASS("AdaptiveAuxBuffer", PASS_ADAPTIVE_AUX_BUFFER);
   MAP_PASS("Debug Sample Count", PASS_SAMPLE_COUNT);
+  MAP_PASS("Debug Adaptive Error", PASS_ADAPTIVE_ERROR);
   if (string_startswith(name, cryptomatte_prefix)) {
     return PASS_CRYPTOMATTE;
   }
@@ -656,6 +659,10 @@ vector<Pass> BlenderSync::sync_render_passes(BL::RenderLayer &b_rlay,
     b_engine.add_pass("Debug Sample Count", 1, "X", b_view_layer.name().c_str());
     Pass::add(PASS_SAMPLE_COUNT, passes, "Debug Sample Count");
   }
+  if (get_boolean(crl, "pass_debug_adaptive_error")) {
+    b_engine.add_pass("Debug Adaptive Error", 1, "X", b_view_layer.name().c_str());
+    Pass::add(PASS_ADAPTIVE_ERROR, passes, "Debug Adaptive Error");
+  }
   if (get_boolean(crl, "use_pass_volume_direct")) {
     b_engine.add_pass("VolumeDir", 3, "RGB", b_view_layer.name().c_str());
     Pass::add(PASS_VOLUME_DIRECT, passes, "VolumeDir");
@@ -938,6 +945,8 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
     else
       params.progressive = false;
 
+    params.time_limit = params.progressive_refine ? (double)get_float(cscene, "time_limit") : 0.0;
+
     params.start_resolution = INT_MAX;
     params.pixel_size = 1;
   }
@@ -963,7 +972,8 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   }
 
   params.use_profiling = params.device.has_profiling && !b_engine.is_preview() && background &&
-                         BlenderSession::print_render_stats;
+                         (BlenderSession::print_render_stats ||
+                          get_boolean(cscene, "use_render_statistics"));
 
   params.adaptive_sampling = RNA_boolean_get(&cscene, "use_adaptive_sampling");
 
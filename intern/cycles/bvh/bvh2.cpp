@@ -23,6 +23,8 @@
 #include "bvh/bvh_node.h"
 #include "bvh/bvh_unaligned.h"
 
+#include "util/util_tbb.h"
+
 CCL_NAMESPACE_BEGIN
 
 BVH2::BVH2(const BVHParams &params_,
@@ -244,7 +246,10 @@ void BVH2::refit_nodes()
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
 }
 
-void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
+/* Subtrees below this depth are refit in the same task as their parent. */
+#define REFIT_PARALLEL_MAX_DEPTH 6
+
+void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, int depth)
 {
   if (leaf) {
     /* refit leaf node */
@@ -274,8 +279,16 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     BoundBox bbox0 = BoundBox::empty, bbox1 = BoundBox::empty;
     uint visibility0 = 0, visibility1 = 0;
 
-    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0);
-    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1);
+    if (depth < REFIT_PARALLEL_MAX_DEPTH) {
+      /* Children write to distinct nodes, so subtrees near the root are refit in parallel. */
+      parallel_invoke(
+          [&]() { refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, depth + 1); },
+          [&]() { refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, depth + 1); });
+    }
+    else {
+      refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, depth + 1);
+      refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, depth + 1);
+    }
 
     if (is_unaligned) {
       Transform aligned_space = transform_identity();
@@ -71,6 +71,24 @@ class BVHObjectBinning : public BVHRange {
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Ranges of at least this many primitives are binned in parallel, in at most this many
+   * blocks. */
+  enum { PARALLEL_MIN_SIZE = 65536 };
+  enum { PARALLEL_MAX_BLOCKS = 64 };
+
+  /* Bins of a block of primitives, merged after binning the blocks in parallel. */
+  struct Bins {
+    BoundBox bounds[MAX_BINS][4];
+    int4 count[MAX_BINS];
+  };
+
+  /* map the primitives in the range to bins, growing the given bin bounds and counts. */
+  void bin_range(const BVHReference *prims,
+                 const size_t range_start,
+                 const size_t range_end,
+                 BoundBox (*bin_bounds)[4],
+                 int4 *bin_count) const;
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
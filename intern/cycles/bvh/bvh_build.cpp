@@ -540,6 +540,8 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
   size_t num_motion_triangles = 0;
   size_t num_curves = 0;
   size_t num_motion_curves = 0;
+  const BVHReference *first_curve = NULL;
+  bool single_curve = true;
 
   for (int i = 0; i < size; i++) {
     const BVHReference &ref = references[range.start() + i];
@@ -549,6 +551,13 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
         num_motion_curves++;
       }
       else {
+        if (first_curve == NULL) {
+          first_curve = &ref;
+        }
+        else if (ref.prim_object() != first_curve->prim_object() ||
+                 ref.prim_index() != first_curve->prim_index()) {
+          single_curve = false;
+        }
         num_curves++;
       }
     }
@@ -564,7 +573,7 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
 
   return (num_triangles <= params.max_triangle_leaf_size) &&
          (num_motion_triangles <= params.max_motion_triangle_leaf_size) &&
-         (num_curves <= params.max_curve_leaf_size) &&
+         (num_curves <= (single_curve ? params.max_curve_leaf_size : 1)) &&
          (num_motion_curves <= params.max_motion_curve_leaf_size);
 }
 
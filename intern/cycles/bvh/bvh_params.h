@@ -60,6 +60,9 @@ class BVHParams {
   int min_leaf_size;
   int max_triangle_leaf_size;
   int max_motion_triangle_leaf_size;
+  /* Only applies to segments of the same curve, other static curve leaves have a single
+   * segment. Consecutive segments of a strand are coherent so the leaf bounds stay tight,
+   * while dense hair needs much fewer nodes than with a leaf per segment. */
   int max_curve_leaf_size;
   int max_motion_curve_leaf_size;
 
@@ -109,7 +112,7 @@ class BVHParams {
     min_leaf_size = 1;
     max_triangle_leaf_size = 8;
     max_motion_triangle_leaf_size = 8;
-    max_curve_leaf_size = 1;
+    max_curve_leaf_size = 4;
     max_motion_curve_leaf_size = 4;
 
     top_level = false;
@@ -139,12 +139,16 @@ class CUDADevice : public Device {
 
   void generic_copy_to(device_memory &mem);
 
+  void generic_copy_to(device_memory &mem, size_t offset, size_t size);
+
   void generic_free(device_memory &mem);
 
   void mem_alloc(device_memory &mem) override;
 
   void mem_copy_to(device_memory &mem) override;
 
+  void mem_copy_to_range(device_memory &mem, size_t offset, size_t size) override;
+
   void mem_copy_from(device_memory &mem, int y, int w, int h, int elem) override;
 
   void mem_zero(device_memory &mem) override;
@@ -940,6 +940,20 @@ void CUDADevice::generic_copy_to(device_memory &mem)
   }
 }
 
+void CUDADevice::generic_copy_to(device_memory &mem, size_t offset, size_t size)
+{
+  if (!mem.host_pointer || !mem.device_pointer) {
+    return;
+  }
+
+  if (!cuda_mem_map[&mem].use_mapped_host || mem.host_pointer != mem.shared_pointer) {
+    const CUDAContextScope scope(this);
+    cuda_assert(cuMemcpyHtoD((CUdeviceptr)mem.device_pointer + offset,
+                             (const char *)mem.host_pointer + offset,
+                             size));
+  }
+}
+
 void CUDADevice::generic_free(device_memory &mem)
 {
   if (mem.device_pointer) {
@@ -1014,6 +1028,19 @@ void CUDADevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void CUDADevice::mem_copy_to_range(device_memory &mem, size_t offset, size_t size)
+{
+  if (mem.type == MEM_PIXELS || mem.type == MEM_TEXTURE) {
+    mem_copy_to(mem);
+  }
+  else if (mem.type == MEM_GLOBAL && !mem.is_resident(this)) {
+    /* Memory owned by another device, nothing to copy and the global pointer is unchanged. */
+  }
+  else {
+    generic_copy_to(mem, offset, size);
+  }
+}
+
 void CUDADevice::mem_copy_from(device_memory &mem, int y, int w, int h, int elem)
 {
   if (mem.type == MEM_PIXELS && !background) {
@@ -1951,6 +1978,11 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
       if (task.need_finish_queue == false)
         break;
     }
+
+    if (rtile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen(rtile)) {
+      rtile.stealing_state = RenderTile::WAS_STOLEN;
+      break;
+    }
   }
 
   /* Finalize adaptive sampling. */
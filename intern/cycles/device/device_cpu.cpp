@@ -932,7 +932,7 @@ class CPUDevice : public Device {
           break;
       }
 
-      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen()) {
+      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen(tile)) {
         tile.stealing_state = RenderTile::WAS_STOLEN;
         break;
       }
@@ -977,7 +977,42 @@ class CPUDevice : public Device {
     }
   }
 
+  /* Layout of the passes read and written by OpenImageDenoise in an interleaved buffer. */
+  struct OIDNPassLayout {
+    int pass_stride;
+    int output;
+    int color;
+    int albedo;
+    int normal;
+  };
+
+  /* Layout of the passes in the render buffers of the task. */
+  static OIDNPassLayout oidn_render_buffer_layout(const DeviceTask &task)
+  {
+    OIDNPassLayout layout;
+    layout.pass_stride = task.pass_stride;
+    layout.output = 0;
+    layout.color = task.pass_denoising_data + DENOISING_PASS_COLOR;
+    layout.albedo = task.pass_denoising_data + DENOISING_PASS_ALBEDO;
+    layout.normal = task.pass_denoising_data + DENOISING_PASS_NORMAL;
+    return layout;
+  }
+
+  /* Compact layout holding only the passes used for denoising, to avoid copying all
+   * render passes when merging neighboring tiles. */
+  static OIDNPassLayout oidn_compact_layout()
+  {
+    OIDNPassLayout layout;
+    layout.pass_stride = 12;
+    layout.output = 0;
+    layout.color = 3;
+    layout.albedo = 6;
+    layout.normal = 9;
+    return layout;
+  }
+
   void denoise_openimagedenoise_buffer(DeviceTask &task,
+                                       const OIDNPassLayout &layout,
                                        float *buffer,
                                        const size_t offset,
                                        const size_t stride,
@@ -1017,16 +1052,16 @@ class CPUDevice : public Device {
       const bool scale;
       const bool use;
       array<float> scaled_buffer;
-    } passes[] = {{"color", task.pass_denoising_data + DENOISING_PASS_COLOR, false, true},
+    } passes[] = {{"color", layout.color, false, true},
                   {"albedo",
-                   task.pass_denoising_data + DENOISING_PASS_ALBEDO,
+                   layout.albedo,
                    true,
                    task.denoising.input_passes >= DENOISER_INPUT_RGB_ALBEDO},
                   {"normal",
-                   task.pass_denoising_data + DENOISING_PASS_NORMAL,
+                   layout.normal,
                    true,
                    task.denoising.input_passes >= DENOISER_INPUT_RGB_ALBEDO_NORMAL},
-                  {"output", 0, false, true},
+                  {"output", layout.output, false, true},
                   { NULL,
                     0 }};
 
@@ -1036,8 +1071,8 @@ class CPUDevice : public Device {
       }
 
       const int64_t pixel_offset = offset + x + y * stride;
-      const int64_t buffer_offset = (pixel_offset * task.pass_stride + passes[i].offset);
-      const int64_t pixel_stride = task.pass_stride;
+      const int64_t buffer_offset = (pixel_offset * layout.pass_stride + passes[i].offset);
+      const int64_t pixel_stride = layout.pass_stride;
       const int64_t row_stride = stride * pixel_stride;
 
       if (passes[i].scale && scale != 1.0f) {
@@ -1077,6 +1112,7 @@ class CPUDevice : public Device {
     oidn_filter.execute();
 #else
     (void)task;
+    (void)layout;
     (void)buffer;
     (void)offset;
     (void)stride;
@@ -1095,6 +1131,7 @@ class CPUDevice : public Device {
       rtile.buffers->buffer.copy_from_device();
 
       denoise_openimagedenoise_buffer(task,
+                                      oidn_render_buffer_layout(task),
                                       (float *)rtile.buffer,
                                       rtile.offset,
                                       rtile.stride,
@@ -1128,8 +1165,12 @@ class CPUDevice : public Device {
       const int4 rect = rect_clip(rect_expand(center_tile.bounds(), 64), neighbors.bounds());
       const int2 rect_size = make_int2(rect.z - rect.x, rect.w - rect.y);
 
-      /* Adjacent tiles are in separate memory regions, copy into single buffer. */
-      array<float> merged(rect_size.x * rect_size.y * task.pass_stride);
+      /* Adjacent tiles are in separate memory regions, copy into single buffer. Only the
+       * passes used by the denoiser are copied, which are a fraction of the pass stride. */
+      const OIDNPassLayout buffer_layout = oidn_render_buffer_layout(task);
+      const OIDNPassLayout merged_layout = oidn_compact_layout();
+      const size_t merged_pass_stride = merged_layout.pass_stride;
+      array<float> merged(rect_size.x * rect_size.y * merged_pass_stride);
 
       for (int i = 0; i < RenderTileNeighbors::SIZE; i++) {
         RenderTile &ntile = neighbors.tiles[i];
@@ -1147,20 +1188,35 @@ class CPUDevice : public Device {
 
         const size_t merged_stride = rect_size.x;
         const size_t merged_offset = (xmin - rect.x) + (ymin - rect.y) * merged_stride;
-        float *merged_buffer = merged.data() + merged_offset * pass_stride;
+        float *merged_buffer = merged.data() + merged_offset * merged_pass_stride;
 
         for (int y = ymin; y < ymax; y++) {
-          for (int x = 0; x < pass_stride * (xmax - xmin); x++) {
-            merged_buffer[x] = tile_buffer[x] * scale;
+          for (int x = 0; x < xmax - xmin; x++) {
+            const float *in = tile_buffer + x * pass_stride;
+            float *out = merged_buffer + x * merged_pass_stride;
+
+            for (int c = 0; c < 3; c++) {
+              out[merged_layout.color + c] = in[buffer_layout.color + c] * scale;
+              out[merged_layout.albedo + c] = in[buffer_layout.albedo + c] * scale;
+              out[merged_layout.normal + c] = in[buffer_layout.normal + c] * scale;
+            }
           }
           tile_buffer += ntile.stride * pass_stride;
-          merged_buffer += merged_stride * pass_stride;
+          merged_buffer += merged_stride * merged_pass_stride;
         }
       }
 
       /* Denoise */
-      denoise_openimagedenoise_buffer(
-          task, merged.data(), 0, rect_size.x, 0, 0, rect_size.x, rect_size.y, 1.0f);
+      denoise_openimagedenoise_buffer(task,
+                                      merged_layout,
+                                      merged.data(),
+                                      0,
+                                      rect_size.x,
+                                      0,
+                                      0,
+                                      rect_size.x,
+                                      rect_size.y,
+                                      1.0f);
 
       /* Copy back result from merged buffer. */
       RenderTile &ntile = neighbors.target;
@@ -1175,16 +1231,19 @@ class CPUDevice : public Device {
 
         const size_t merged_stride = rect_size.x;
         const size_t merged_offset = (xmin - rect.x) + (ymin - rect.y) * merged_stride;
-        const float *merged_buffer = merged.data() + merged_offset * pass_stride;
+        const float *merged_buffer = merged.data() + merged_offset * merged_pass_stride;
 
         for (int y = ymin; y < ymax; y++) {
-          for (int x = 0; x < pass_stride * (xmax - xmin); x += pass_stride) {
-            tile_buffer[x + 0] = merged_buffer[x + 0] * invscale;
-            tile_buffer[x + 1] = merged_buffer[x + 1] * invscale;
-            tile_buffer[x + 2] = merged_buffer[x + 2] * invscale;
+          for (int x = 0; x < xmax - xmin; x++) {
+            float *out = tile_buffer + x * pass_stride + buffer_layout.output;
+            const float *in = merged_buffer + x * merged_pass_stride + merged_layout.output;
+
+            out[0] = in[0] * invscale;
+            out[1] = in[1] * invscale;
+            out[2] = in[2] * invscale;
           }
           tile_buffer += ntile.stride * pass_stride;
-          merged_buffer += merged_stride * pass_stride;
+          merged_buffer += merged_stride * merged_pass_stride;
         }
       }
 
@@ -1602,7 +1661,9 @@ int2 CPUSplitKernel::split_kernel_global_size(device_memory & /*kg*/,
                                               device_memory & /*data*/,
                                               DeviceTask & /*task*/)
 {
-  return make_int2(1, 1);
+  /* Keep a batch of paths in flight per thread, so that the shader sort kernel can group
+   * them by shader before evaluation. Stays within one shader sort block. */
+  return make_int2(64, 16);
 }
 
 uint64_t CPUSplitKernel::state_buffer_size(device_memory &kernel_globals,
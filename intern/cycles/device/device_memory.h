@@ -253,6 +253,7 @@ class device_memory {
   void device_alloc();
   void device_free();
   void device_copy_to();
+  void device_copy_to(size_t offset, size_t size);
   void device_copy_from(int y, int w, int h, int elem);
   void device_zero();
 
@@ -435,6 +436,14 @@ template<typename T> class device_vector : public device_memory {
     device_copy_to();
   }
 
+  /* Copy only a range of elements to the device, when the rest of the host data
+   * is known to be unchanged since the last copy. */
+  void copy_to_device(size_t offset, size_t num)
+  {
+    assert(offset + num <= data_size);
+    device_copy_to(offset * sizeof(T), num * sizeof(T));
+  }
+
   void copy_from_device()
   {
     device_copy_from(0, data_width, data_height, sizeof(T));
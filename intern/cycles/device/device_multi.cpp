@@ -378,6 +378,29 @@ class MultiDevice : public Device {
     stats.mem_alloc(mem.device_size - existing_size);
   }
 
+  void mem_copy_to_range(device_memory &mem, size_t offset, size_t size)
+  {
+    device_ptr key = mem.device_pointer;
+
+    if (strcmp(mem.name, "RenderBuffers") == 0 || mem.type == MEM_TEXTURE) {
+      mem_copy_to(mem);
+      return;
+    }
+
+    /* Only the owner of the memory in each island needs the data, the pointers
+     * stored on the other devices stay the same. */
+    foreach (const vector<SubDevice *> &island, peer_islands) {
+      SubDevice *owner_sub = find_matching_mem_device(key, *island.front());
+      mem.device = owner_sub->device;
+      mem.device_pointer = owner_sub->ptr_map[key];
+
+      owner_sub->device->mem_copy_to_range(mem, offset, size);
+    }
+
+    mem.device = this;
+    mem.device_pointer = key;
+  }
+
   void mem_copy_from(device_memory &mem, int y, int w, int h, int elem)
   {
     device_ptr key = mem.device_pointer;
@@ -20,6 +20,7 @@
 
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
+#include "util/util_murmurhash.h"
 
 #if defined(WITH_NETWORK)
 
@@ -28,10 +29,35 @@ CCL_NAMESPACE_BEGIN
 typedef map<device_ptr, device_ptr> PtrMap;
 typedef vector<uint8_t> DataVector;
 typedef map<device_ptr, DataVector> DataMap;
+typedef map<device_ptr, uint64_t> MemHashMap;
 
 /* tile list */
 typedef vector<RenderTile> TileList;
 
+/* Hash of device memory contents, used by the server to detect data it already has. Zero is
+ * reserved for memory that is not cached. */
+static uint64_t network_memory_hash(const device_memory &mem)
+{
+  /* Kernels write to these, so the server copy can differ from what was sent. */
+  if (mem.type == MEM_READ_WRITE || mem.type == MEM_DEVICE_ONLY || mem.type == MEM_PIXELS) {
+    return 0;
+  }
+
+  const uint8_t *data = (const uint8_t *)mem.host_pointer;
+  const size_t size = mem.memory_size();
+  const size_t chunk_size = (size_t)1 << 30;
+
+  uint32_t hash_lo = 0, hash_hi = 0x9e3779b9;
+  for (size_t offset = 0; offset < size; offset += chunk_size) {
+    const int len = (int)min(size - offset, chunk_size);
+    hash_lo = util_murmur_hash3(data + offset, len, hash_lo);
+    hash_hi = util_murmur_hash3(data + offset, len, hash_hi);
+  }
+
+  const uint64_t hash = ((uint64_t)hash_hi << 32) | hash_lo;
+  return (hash != 0) ? hash : 1;
+}
+
 /* search a list of tiles and find the one that matches the passed render tile */
 static TileList::iterator tile_list_find(TileList &tile_list, RenderTile &tile)
 {
@@ -109,13 +135,26 @@ class NetworkDevice : public Device {
 
   void mem_copy_to(device_memory &mem)
   {
+    const uint64_t hash = network_memory_hash(mem);
+
     thread_scoped_lock lock(rpc_lock);
 
     RPCSend snd(socket, &error_func, "mem_copy_to");
 
     snd.add(mem);
+    snd.add(hash);
     snd.write();
-    snd.write_buffer(mem.host_pointer, mem.memory_size());
+
+    /* The server replies whether it already has memory with the same contents. */
+    bool need_data = true;
+    if (hash) {
+      RPCReceive rcv(socket, &error_func);
+      rcv.read(need_data);
+    }
+
+    if (need_data) {
+      snd.write_buffer(mem.host_pointer, mem.memory_size());
+    }
   }
 
   void mem_copy_from(device_memory &mem, int y, int w, int h, int elem)
@@ -318,6 +357,53 @@ void device_network_info(vector<DeviceInfo> &devices)
   devices.push_back(info);
 }
 
+/* Contents of freed device memory kept by the server, so that scene data which did not change
+ * since an earlier render does not have to be sent over the network again. */
+class DataCache {
+ public:
+  DataCache() : size(0)
+  {
+  }
+
+  void insert(uint64_t hash, DataVector &data)
+  {
+    if (data.size() > SERVER_DATA_CACHE_SIZE) {
+      return;
+    }
+
+    /* Evict the oldest entries to stay within the size limit. */
+    while (size + data.size() > SERVER_DATA_CACHE_SIZE) {
+      size -= entries.front().second.size();
+      entries.pop_front();
+    }
+
+    entries.push_back(Entry(hash, DataVector()));
+    entries.back().second.swap(data);
+    size += entries.back().second.size();
+  }
+
+  bool take(uint64_t hash, DataVector &data)
+  {
+    for (list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      if (it->first == hash && it->second.size() == data.size()) {
+        /* Copy rather than swap, the device may reference the existing buffer. */
+        if (data.size()) {
+          memcpy(&data[0], &it->second[0], data.size());
+        }
+        size -= data.size();
+        entries.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+ protected:
+  typedef pair<uint64_t, DataVector> Entry;
+  list<Entry> entries;
+  size_t size;
+};
+
 class DeviceServer {
  public:
   thread_mutex rpc_lock;
@@ -332,8 +418,12 @@ class DeviceServer {
     return error_func.have_error();
   }
 
-  DeviceServer(Device *device_, tcp::socket &socket_)
-      : device(device_), socket(socket_), stop(false), blocked_waiting(false)
+  DeviceServer(Device *device_, tcp::socket &socket_, DataCache &data_cache_)
+      : device(device_),
+        socket(socket_),
+        data_cache(data_cache_),
+        stop(false),
+        blocked_waiting(false)
   {
     error_func = NetworkError();
   }
@@ -460,28 +550,48 @@ class DeviceServer {
     else if (rcv.name == "mem_copy_to") {
       string name;
       network_device_memory mem(device);
+      uint64_t hash;
       rcv.read(mem, name);
-      lock.unlock();
+      rcv.read(hash);
 
       size_t data_size = mem.memory_size();
       device_ptr client_pointer = mem.device_pointer;
 
-      if (client_pointer) {
-        /* Lookup existing host side data buffer. */
-        DataVector &data_v = data_vector_find(client_pointer);
-        mem.host_pointer = (void *)&data_v[0];
+      DataVector &data_v = (client_pointer) ? data_vector_find(client_pointer) :
+                                              data_vector_insert(client_pointer, data_size);
+
+      /* Reuse the data if it is unchanged since the last copy, or if it was kept from memory
+       * freed by an earlier render. */
+      bool need_data = true;
+      if (hash) {
+        MemHashMap::iterator it = mem_hash.find(client_pointer);
+        if (client_pointer && it != mem_hash.end() && it->second == hash) {
+          need_data = false;
+        }
+        else if (data_cache.take(hash, data_v)) {
+          need_data = false;
+        }
+
+        RPCSend snd(socket, &error_func, "mem_copy_to");
+        snd.add(need_data);
+        snd.write();
+      }
+      lock.unlock();
+
+      mem.host_pointer = (data_size) ? (void *)&(data_v[0]) : 0;
 
+      if (client_pointer) {
         /* Translate the client pointer to a real device pointer. */
         mem.device_pointer = device_ptr_from_client_pointer(client_pointer);
       }
-      else {
-        /* Allocate host side data buffer. */
-        DataVector &data_v = data_vector_insert(client_pointer, data_size);
-        mem.host_pointer = (data_size) ? (void *)&(data_v[0]) : 0;
-      }
 
       /* Copy data from network into memory buffer. */
-      rcv.read_buffer((uint8_t *)mem.host_pointer, data_size);
+      if (need_data) {
+        rcv.read_buffer((uint8_t *)mem.host_pointer, data_size);
+      }
+      if (client_pointer) {
+        mem_hash[client_pointer] = hash;
+      }
 
       /* Copy the data from the memory buffer to the device buffer. */
       device->mem_copy_to(mem);
@@ -510,6 +620,7 @@ class DeviceServer {
       mem.host_pointer = (device_ptr) & (data_v[0]);
 
       device->mem_copy_from(mem, y, w, h, elem);
+      mem_hash.erase(client_pointer);
 
       size_t data_size = mem.memory_size();
 
@@ -543,6 +654,7 @@ class DeviceServer {
 
       /* Zero memory. */
       device->mem_zero(mem);
+      mem_hash.erase(client_pointer);
 
       if (!client_pointer) {
         /* Store a mapping to/from client_pointer and real device pointer. */
@@ -558,6 +670,13 @@ class DeviceServer {
 
       device_ptr client_pointer = mem.device_pointer;
 
+      /* Keep the contents for later renders that copy the same data again. */
+      MemHashMap::iterator it = mem_hash.find(client_pointer);
+      if (it != mem_hash.end()) {
+        data_cache.insert(it->second, data_vector_find(client_pointer));
+        mem_hash.erase(it);
+      }
+
       mem.device_pointer = device_ptr_from_client_pointer_erase(client_pointer);
 
       device->mem_free(mem);
@@ -762,6 +881,10 @@ class DeviceServer {
   PtrMap ptr_imap;
   DataMap mem_data;
 
+  /* hash of the contents last copied to memory, for memory that kernels don't write to */
+  MemHashMap mem_hash;
+  DataCache &data_cache;
+
   struct AcquireEntry {
     string name;
     RenderTile tile;
@@ -785,6 +908,9 @@ void Device::server_run()
     /* starts thread that responds to discovery requests */
     ServerDiscovery discovery;
 
+    /* memory contents kept across connections */
+    DataCache data_cache;
+
     for (;;) {
       /* accept connection */
       boost::asio::io_service io_service;
@@ -796,7 +922,7 @@ void Device::server_run()
       string remote_address = socket.remote_endpoint().address().to_string();
       printf("Connected to remote client at: %s\n", remote_address.c_str());
 
-      DeviceServer server(this, socket);
+      DeviceServer server(this, socket, data_cache);
       server.listen();
 
       printf("Disconnected.\n");
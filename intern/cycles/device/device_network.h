@@ -55,6 +55,8 @@ static const int SERVER_PORT = 5120;
 static const int DISCOVER_PORT = 5121;
 static const string DISCOVER_REQUEST_MSG = "REQUEST_RENDER_SERVER_IP";
 static const string DISCOVER_REPLY_MSG = "REPLY_RENDER_SERVER_IP";
+/* Maximum size of the freed device memory contents that a server keeps for later renders. */
+static const size_t SERVER_DATA_CACHE_SIZE = (size_t)4 << 30;
 
 #  if 0
 typedef boost::archive::text_oarchive o_archive;
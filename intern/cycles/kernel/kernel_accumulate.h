@@ -535,6 +535,21 @@ ccl_device_inline void path_radiance_accum_shadowcatcher(PathRadiance *L,
 }
 #endif
 
+#ifdef __PATH_GUIDING__
+/* Sum of the radiance accumulated so far along the path, only valid before the indirect
+ * light has been split into passes by path_radiance_sum_indirect(). */
+ccl_device_inline float3 path_radiance_guiding_sum(const PathRadiance *L)
+{
+#  ifdef __PASSES__
+  if (L->use_light_pass) {
+    return L->emission + L->background + L->direct_diffuse + L->direct_glossy +
+           L->direct_transmission + L->direct_volume + L->direct_emission + L->indirect;
+  }
+#  endif
+  return L->emission;
+}
+#endif
+
 ccl_device_inline void path_radiance_sum_indirect(PathRadiance *L)
 {
 #ifdef __PASSES__
@@ -15,6 +15,7 @@
  */
 
 #include "kernel_light_background.h"
+#include "kernel_light_tree.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -293,6 +294,11 @@ ccl_device bool lamp_light_eval(
 
   ls->pdf *= kernel_data.integrator.pdf_lights;
 
+  if (kernel_data.integrator.use_light_tree && light_tree_use_light_type(type)) {
+    /* The light tree is sampled in place of a uniform pick among the lights it contains. */
+    ls->pdf *= light_tree_pdf(kg, lamp, P) * kernel_data.integrator.num_light_tree_lights;
+  }
+
   return true;
 }
 
@@ -650,6 +656,23 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
       return (ls->pdf > 0.0f);
     }
 
+    if (prim == LIGHT_DISTRIBUTION_PRIM_TREE) {
+      float tree_pdf;
+      lamp = light_tree_sample(kg, P, &randu, &tree_pdf);
+
+      if (UNLIKELY(light_select_reached_max_bounces(kg, lamp, bounce))) {
+        return false;
+      }
+
+      /* The probability returned by lamp_light_sample assumes a uniform pick among the lights,
+       * the distribution entry of the tree covers all of its lights. */
+      if (!lamp_light_sample(kg, lamp, randu, randv, P, ls)) {
+        return false;
+      }
+      ls->pdf *= tree_pdf * kernel_data.integrator.num_light_tree_lights;
+      return (ls->pdf > 0.0f);
+    }
+
     lamp = -prim - 1;
   }
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Selects one of many local lights proportional to an estimate of its contribution to the
+ * shading point, based on:
+ *
+ * Alejandro Conty Estevez and Christopher Kulla.
+ * Importance Sampling of Many Lights with Adaptive Tree Splitting.
+ *
+ * The normal at the shading point is not taken into account, so that the same probabilities
+ * can be computed when evaluating lights hit by rays for multiple importance sampling. */
+
+ccl_device float light_tree_node_importance(KernelGlobals *kg, int node_index, float3 P)
+{
+  const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                  node_index);
+  const float3 bbox_min = make_float3(knode->bbox_min[0], knode->bbox_min[1], knode->bbox_min[2]);
+  const float3 bbox_max = make_float3(knode->bbox_max[0], knode->bbox_max[1], knode->bbox_max[2]);
+  const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+
+  const float3 centroid = 0.5f * (bbox_min + bbox_max);
+  const float radius = 0.5f * len(bbox_max - bbox_min);
+
+  float distance;
+  const float3 D = normalize_len(P - centroid, &distance);
+
+  /* Angle between the axis and the shading point, reduced by the spread of the orientations and
+   * by the angle the bounds span as seen from the shading point. */
+  const float theta = safe_acosf(dot(axis, D));
+  const float theta_u = (distance > radius) ? safe_asinf(radius / distance) : M_PI_F;
+  const float theta_i = max(theta - knode->theta_o - theta_u, 0.0f);
+
+  if (theta_i >= knode->theta_e) {
+    return 0.0f;
+  }
+
+  /* Avoid the importance growing without bounds for points near or inside the bounds. */
+  const float distance_sq = max(sqr(distance), sqr(radius));
+
+  return knode->energy * cosf(theta_i) / distance_sq;
+}
+
+ccl_device float light_tree_left_probability(KernelGlobals *kg,
+                                             int node_index,
+                                             const ccl_global KernelLightTreeNode *knode,
+                                             float3 P)
+{
+  const float importance_left = light_tree_node_importance(kg, node_index + 1, P);
+  const float importance_right = light_tree_node_importance(kg, knode->child_right, P);
+  const float importance = importance_left + importance_right;
+
+  return (importance > 0.0f) ? importance_left / importance : 0.5f;
+}
+
+/* Traverse the tree from the root, returns the index of the selected light. The random number is
+ * rescaled at every level so it can be used again to sample the light. */
+ccl_device int light_tree_sample(KernelGlobals *kg, float3 P, float *randu, float *pdf)
+{
+  float r = *randu;
+  int node_index = 0;
+  *pdf = 1.0f;
+
+  while (true) {
+    const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                    node_index);
+    if (knode->light_index >= 0) {
+      *randu = r;
+      return knode->light_index;
+    }
+
+    const float prob_left = light_tree_left_probability(kg, node_index, knode, P);
+    if (r < prob_left) {
+      node_index = node_index + 1;
+      r = r / prob_left;
+      *pdf *= prob_left;
+    }
+    else {
+      const float prob_right = 1.0f - prob_left;
+      node_index = knode->child_right;
+      r = (r - prob_left) / prob_right;
+      *pdf *= prob_right;
+    }
+  }
+}
+
+/* Probability of selecting the light from the shading point, following the light trail. */
+ccl_device float light_tree_pdf(KernelGlobals *kg, int lamp, float3 P)
+{
+  uint trail = kernel_tex_fetch(__lights, lamp).tree_trail;
+  int node_index = 0;
+  float pdf = 1.0f;
+
+  while (true) {
+    const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                    node_index);
+    if (knode->light_index >= 0) {
+      kernel_assert(knode->light_index == lamp);
+      return pdf;
+    }
+
+    const float prob_left = light_tree_left_probability(kg, node_index, knode, P);
+    if (trail & 1) {
+      node_index = knode->child_right;
+      pdf *= 1.0f - prob_left;
+    }
+    else {
+      node_index = node_index + 1;
+      pdf *= prob_left;
+    }
+    trail >>= 1;
+  }
+}
+
+/* Whether lights of this type are selected from the light tree when it is used. */
+ccl_device_inline bool light_tree_use_light_type(LightType type)
+{
+  return (type == LIGHT_POINT || type == LIGHT_SPOT || type == LIGHT_AREA);
+}
+
+CCL_NAMESPACE_END
@@ -47,6 +47,7 @@
 #include "kernel/kernel_shadow.h"
 #include "kernel/kernel_emission.h"
 #include "kernel/kernel_path_common.h"
+#include "kernel/kernel_path_guiding.h"
 #include "kernel/kernel_path_surface.h"
 #include "kernel/kernel_path_volume.h"
 #include "kernel/kernel_path_subsurface.h"
@@ -519,6 +520,11 @@ ccl_device_forceinline void kernel_path_integrate(KernelGlobals *kg,
   /* Shader data memory used for both volumes and surfaces, saves stack space. */
   ShaderData sd;
 
+#  ifdef __PATH_GUIDING__
+  PathGuidingVertices guiding_vertices;
+  path_guiding_init(&guiding_vertices);
+#  endif
+
 #  ifdef __SUBSURFACE__
   SubsurfaceIndirectRays ss_indirect;
   kernel_path_subsurface_init_indirect(&ss_indirect);
@@ -624,8 +630,16 @@ ccl_device_forceinline void kernel_path_integrate(KernelGlobals *kg,
       /* compute direct lighting and next bounce */
       if (!kernel_path_surface_bounce(kg, &sd, &throughput, state, &L->state, ray))
         break;
+
+#  ifdef __PATH_GUIDING__
+      path_guiding_record(kg, &guiding_vertices, &sd, state, ray, throughput, L);
+#  endif
     }
 
+#  ifdef __PATH_GUIDING__
+    path_guiding_train(kg, &guiding_vertices, L);
+#  endif
+
 #  ifdef __SUBSURFACE__
     /* Trace indirect subsurface rays by restarting the loop. this uses less
      * stack memory than invoking kernel_path_indirect.
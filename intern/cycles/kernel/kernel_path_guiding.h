@@ -0,0 +1,258 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "util/util_atomic.h"
+
+CCL_NAMESPACE_BEGIN
+
+#ifdef __PATH_GUIDING__
+
+/* Path Guiding
+ *
+ * Each cell of a uniform grid over the scene stores a histogram of incoming radiance over
+ * equal area bins on the sphere of directions. The histograms are trained while rendering,
+ * from the radiance that paths bring back to their diffuse vertices, and are used to sample
+ * diffuse bounces in a one sample mixture with the BSDF.
+ *
+ * Other threads keep writing to the cache while it is used, so sampling works on a local copy
+ * of a histogram and evaluates the PDF from that same copy, which keeps the result unbiased. */
+
+/* Probability of sampling the guiding distribution instead of the BSDF. */
+#  define GUIDING_SAMPLE_PROBABILITY 0.5f
+/* Number of training samples in a cell before it is used for sampling. */
+#  define GUIDING_MIN_TRAINING_SAMPLES 16.0f
+/* Number of path vertices recorded for training. */
+#  define GUIDING_MAX_VERTICES 8
+
+typedef struct PathGuidingVertices {
+  int num_vertices;
+  int cell[GUIDING_MAX_VERTICES];
+  int bin[GUIDING_MAX_VERTICES];
+  float inv_pdf[GUIDING_MAX_VERTICES];
+  float3 throughput[GUIDING_MAX_VERTICES];
+  float3 L_sum[GUIDING_MAX_VERTICES];
+} PathGuidingVertices;
+
+ccl_device_inline int path_guiding_cell(KernelGlobals *kg, float3 P)
+{
+  const float3 bounds_min = make_float3(kernel_data.integrator.guiding_bounds_min_x,
+                                        kernel_data.integrator.guiding_bounds_min_y,
+                                        kernel_data.integrator.guiding_bounds_min_z);
+  const float3 co = (P - bounds_min) * kernel_data.integrator.guiding_inv_cell_size;
+
+  const int res_x = kernel_data.integrator.guiding_resolution_x;
+  const int res_y = kernel_data.integrator.guiding_resolution_y;
+  const int res_z = kernel_data.integrator.guiding_resolution_z;
+
+  const int x = clamp(float_to_int(floorf(co.x)), 0, res_x - 1);
+  const int y = clamp(float_to_int(floorf(co.y)), 0, res_y - 1);
+  const int z = clamp(float_to_int(floorf(co.z)), 0, res_z - 1);
+
+  return (z * res_y + y) * res_x + x;
+}
+
+/* Equal area mapping of directions to bins, uniform in cosine of the polar angle and in the
+ * azimuth. */
+ccl_device_inline int path_guiding_direction_bin(float3 D)
+{
+  const float u = 0.5f * (D.z + 1.0f);
+  const float v = (atan2f(D.y, D.x) + M_PI_F) * M_1_2PI_F;
+
+  const int i = clamp(float_to_int(u * GUIDING_DIRECTION_RESOLUTION),
+                      0,
+                      GUIDING_DIRECTION_RESOLUTION - 1);
+  const int j = clamp(float_to_int(v * GUIDING_DIRECTION_RESOLUTION),
+                      0,
+                      GUIDING_DIRECTION_RESOLUTION - 1);
+
+  return i * GUIDING_DIRECTION_RESOLUTION + j;
+}
+
+ccl_device_inline float3 path_guiding_bin_direction(int bin, float randu, float randv)
+{
+  const float u = ((bin / GUIDING_DIRECTION_RESOLUTION) + randu) *
+                  (1.0f / GUIDING_DIRECTION_RESOLUTION);
+  const float v = ((bin % GUIDING_DIRECTION_RESOLUTION) + randv) *
+                  (1.0f / GUIDING_DIRECTION_RESOLUTION);
+
+  const float z = 2.0f * u - 1.0f;
+  const float r = safe_sqrtf(1.0f - z * z);
+  const float phi = M_2PI_F * v - M_PI_F;
+
+  return make_float3(r * cosf(phi), r * sinf(phi), z);
+}
+
+/* Only use guiding for purely diffuse closures, so that the mixture with guided directions
+ * has a well defined PDF in all directions. */
+ccl_device_inline bool path_guiding_shader_supported(const ShaderData *sd)
+{
+  if (!(sd->flag & SD_BSDF)) {
+    return false;
+  }
+
+  for (int i = 0; i < sd->num_closure; i++) {
+    const ShaderClosure *sc = &sd->closure[i];
+
+    if (CLOSURE_IS_BSDF(sc->type) && !CLOSURE_IS_BSDF_DIFFUSE(sc->type)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* Copy the histogram of a cell, returns false when it is not trained enough for sampling. */
+ccl_device_inline bool path_guiding_load(KernelGlobals *kg, int cell, float *bins, float *sum)
+{
+  const float *data = kernel_tex_array(__guiding_radiance) + cell * GUIDING_CELL_SIZE;
+
+  if (data[GUIDING_DIRECTION_BINS] < GUIDING_MIN_TRAINING_SAMPLES) {
+    return false;
+  }
+
+  float total = 0.0f;
+  for (int i = 0; i < GUIDING_DIRECTION_BINS; i++) {
+    bins[i] = data[i];
+    total += bins[i];
+  }
+
+  *sum = total;
+  return total > 0.0f && isfinite_safe(total);
+}
+
+/* Sample a direction from the mixture of the BSDF and the guiding distribution, falling back
+ * to regular BSDF sampling where guiding is not available. */
+ccl_device int path_guiding_bsdf_sample(KernelGlobals *kg,
+                                        ShaderData *sd,
+                                        float randu,
+                                        float randv,
+                                        BsdfEval *bsdf_eval,
+                                        float3 *omega_in,
+                                        differential3 *domega_in,
+                                        float *pdf)
+{
+  float bins[GUIDING_DIRECTION_BINS];
+  float sum;
+
+  if (!path_guiding_shader_supported(sd) ||
+      !path_guiding_load(kg, path_guiding_cell(kg, sd->P), bins, &sum)) {
+    return shader_bsdf_sample(kg, sd, randu, randv, bsdf_eval, omega_in, domega_in, pdf);
+  }
+
+  int label;
+  float bsdf_pdf = 0.0f;
+
+  if (randu < GUIDING_SAMPLE_PROBABILITY) {
+    /* Pick a bin proportional to its radiance, and reuse the remainder of the random number
+     * for the position within the bin. */
+    float r = (randu / GUIDING_SAMPLE_PROBABILITY) * sum;
+    int bin = 0;
+    for (; bin < GUIDING_DIRECTION_BINS - 1; bin++) {
+      if (r < bins[bin]) {
+        break;
+      }
+      r -= bins[bin];
+    }
+
+    const float bin_u = (bins[bin] > 0.0f) ? saturate(r / bins[bin]) : 0.5f;
+    *omega_in = path_guiding_bin_direction(bin, bin_u, randv);
+    domega_in->dx = make_float3(0.0f, 0.0f, 0.0f);
+    domega_in->dy = make_float3(0.0f, 0.0f, 0.0f);
+
+    bsdf_eval_init(bsdf_eval,
+                   NBUILTIN_CLOSURES,
+                   make_float3(0.0f, 0.0f, 0.0f),
+                   kernel_data.film.use_light_pass);
+    _shader_bsdf_multi_eval(kg, sd, *omega_in, &bsdf_pdf, NULL, bsdf_eval, 0.0f, 0.0f);
+
+    label = LABEL_DIFFUSE | ((dot(sd->Ng, *omega_in) > 0.0f) ? LABEL_REFLECT : LABEL_TRANSMIT);
+  }
+  else {
+    randu = (randu - GUIDING_SAMPLE_PROBABILITY) / (1.0f - GUIDING_SAMPLE_PROBABILITY);
+    label = shader_bsdf_sample(kg, sd, randu, randv, bsdf_eval, omega_in, domega_in, &bsdf_pdf);
+
+    if (bsdf_pdf == 0.0f) {
+      *pdf = 0.0f;
+      return label;
+    }
+  }
+
+  /* All bins cover the same solid angle of 4 * pi / GUIDING_DIRECTION_BINS. */
+  const float guide_pdf = bins[path_guiding_direction_bin(*omega_in)] / sum *
+                          (GUIDING_DIRECTION_BINS * 0.25f * M_1_PI_F);
+
+  *pdf = GUIDING_SAMPLE_PROBABILITY * guide_pdf + (1.0f - GUIDING_SAMPLE_PROBABILITY) * bsdf_pdf;
+  return label;
+}
+
+ccl_device_inline void path_guiding_init(PathGuidingVertices *vertices)
+{
+  vertices->num_vertices = 0;
+}
+
+/* Record a diffuse bounce, after the throughput and ray were updated for it. */
+ccl_device_inline void path_guiding_record(KernelGlobals *kg,
+                                           PathGuidingVertices *vertices,
+                                           const ShaderData *sd,
+                                           const PathState *state,
+                                           const Ray *ray,
+                                           float3 throughput,
+                                           const PathRadiance *L)
+{
+  if (!kernel_data.integrator.use_path_guiding ||
+      vertices->num_vertices == GUIDING_MAX_VERTICES || !path_guiding_shader_supported(sd) ||
+      state->ray_pdf == 0.0f) {
+    return;
+  }
+
+  const int i = vertices->num_vertices++;
+  vertices->cell[i] = path_guiding_cell(kg, sd->P);
+  vertices->bin[i] = path_guiding_direction_bin(ray->D);
+  vertices->inv_pdf[i] = 1.0f / state->ray_pdf;
+  vertices->throughput[i] = throughput;
+  vertices->L_sum[i] = path_radiance_guiding_sum(L);
+}
+
+/* Add the radiance that arrived at each recorded vertex to the cache, estimated from
+ * everything the path gathered after it. */
+ccl_device_inline void path_guiding_train(KernelGlobals *kg,
+                                          PathGuidingVertices *vertices,
+                                          const PathRadiance *L)
+{
+  if (vertices->num_vertices == 0) {
+    return;
+  }
+
+  float *data = kernel_tex_array(__guiding_radiance);
+  const float3 L_sum = path_radiance_guiding_sum(L);
+
+  for (int i = 0; i < vertices->num_vertices; i++) {
+    float *cell_data = data + vertices->cell[i] * GUIDING_CELL_SIZE;
+    const float3 L_in = safe_divide_color(L_sum - vertices->L_sum[i], vertices->throughput[i]);
+    const float value = average(L_in) * vertices->inv_pdf[i];
+
+    if (value > 0.0f && isfinite_safe(value)) {
+      atomic_add_and_fetch_float(cell_data + vertices->bin[i], value);
+    }
+    atomic_add_and_fetch_float(cell_data + GUIDING_DIRECTION_BINS, 1.0f);
+  }
+
+  vertices->num_vertices = 0;
+}
+
+#endif /* __PATH_GUIDING__ */
+
+CCL_NAMESPACE_END
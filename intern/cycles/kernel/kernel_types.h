@@ -128,6 +128,9 @@ CCL_NAMESPACE_BEGIN
 #  endif
 #  define __VOLUME_DECOUPLED__
 #  define __VOLUME_RECORD_ALL__
+#  ifndef __SPLIT_KERNEL__
+#    define __PATH_GUIDING__
+#  endif
 #endif /* __KERNEL_CPU__ */
 
 #ifdef __KERNEL_CUDA__
@@ -374,6 +377,7 @@ typedef enum PassType {
   PASS_AOV_VALUE,
   PASS_ADAPTIVE_AUX_BUFFER,
   PASS_SAMPLE_COUNT,
+  PASS_ADAPTIVE_ERROR,
   PASS_CATEGORY_MAIN_END = 31,
 
   PASS_MIST = 32,
@@ -1318,6 +1322,14 @@ typedef struct KernelBackground {
 } KernelBackground;
 static_assert_align(KernelBackground, 16);
 
+/* Path guiding cache. Each cell of a uniform grid over the scene bounds stores a histogram
+ * of incoming radiance over the sphere of directions, followed by its number of training
+ * samples. */
+#define GUIDING_GRID_MAX_RESOLUTION 32
+#define GUIDING_DIRECTION_RESOLUTION 8
+#define GUIDING_DIRECTION_BINS (GUIDING_DIRECTION_RESOLUTION * GUIDING_DIRECTION_RESOLUTION)
+#define GUIDING_CELL_SIZE (GUIDING_DIRECTION_BINS + 1)
+
 typedef struct KernelIntegrator {
   /* emission */
   int use_direct_light;
@@ -1389,7 +1401,19 @@ typedef struct KernelIntegrator {
 
   int max_closures;
 
-  int pad1, pad2;
+  /* light tree */
+  int use_light_tree;
+  int num_light_tree_lights;
+
+  /* path guiding */
+  int use_path_guiding;
+  int guiding_resolution_x;
+  int guiding_resolution_y;
+  int guiding_resolution_z;
+  float guiding_bounds_min_x;
+  float guiding_bounds_min_y;
+  float guiding_bounds_min_z;
+  float guiding_inv_cell_size;
 } KernelIntegrator;
 static_assert_align(KernelIntegrator, 16);
 
@@ -1521,7 +1545,8 @@ typedef struct KernelLight {
   float max_bounces;
   float random;
   float strength[3];
-  float pad1;
+  /* Child taken at each level of the light tree to reach this light, 0 for the left child. */
+  uint tree_trail;
   Transform tfm;
   Transform itfm;
   union {
@@ -1548,6 +1573,24 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+/* Primitive of the light distribution entry standing for all lights in the light tree. */
+#define LIGHT_DISTRIBUTION_PRIM_TREE (-0x7FFFFFFF)
+
+typedef struct KernelLightTreeNode {
+  float bbox_min[3];
+  float energy;
+  float bbox_max[3];
+  /* Bounds of the light orientations and of the emission around them. */
+  float theta_o;
+  float axis[3];
+  float theta_e;
+  /* The left child follows its parent, leaves store the light index instead. */
+  int child_right;
+  int light_index;
+  int pad1, pad2;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
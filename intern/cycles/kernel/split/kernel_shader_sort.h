@@ -16,9 +16,45 @@
 
 CCL_NAMESPACE_BEGIN
 
+#ifdef __KERNEL_CPU__
+/* Stable bottom-up merge sort of the block indices by shader. On the CPU a single work item
+ * handles the whole block, so there is no need for a parallel sorting network. */
+ccl_device void kernel_shader_sort_block(const uint *value, ushort *index)
+{
+  ushort temp[SHADER_SORT_BLOCK_SIZE];
+  ushort *src = index;
+  ushort *dst = temp;
+
+  for (int width = 1; width < SHADER_SORT_BLOCK_SIZE; width <<= 1) {
+    for (int start = 0; start < SHADER_SORT_BLOCK_SIZE; start += 2 * width) {
+      const int mid = min(start + width, SHADER_SORT_BLOCK_SIZE);
+      const int end = min(start + 2 * width, SHADER_SORT_BLOCK_SIZE);
+      int i = start, j = mid, k = start;
+
+      while (i < mid && j < end) {
+        dst[k++] = (value[src[j]] < value[src[i]]) ? src[j++] : src[i++];
+      }
+      while (i < mid) {
+        dst[k++] = src[i++];
+      }
+      while (j < end) {
+        dst[k++] = src[j++];
+      }
+    }
+
+    ushort *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != index) {
+    memcpy(index, src, sizeof(ushort) * SHADER_SORT_BLOCK_SIZE);
+  }
+}
+#endif /* __KERNEL_CPU__ */
+
 ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSortLocals *locals)
 {
-#ifndef __KERNEL_CUDA__
   int tid = ccl_global_id(1) * ccl_global_size(0) + ccl_global_id(0);
   uint qsize = kernel_split_params.queue_index[QUEUE_ACTIVE_AND_REGENERATED_RAYS];
   if (tid == 0) {
@@ -54,9 +90,7 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
-#  ifdef __KERNEL_OPENCL__
-
+#if defined(__KERNEL_OPENCL__) || defined(__KERNEL_CUDA__)
   /* bitonic sort */
   for (uint length = 1; length < SHADER_SORT_BLOCK_SIZE; length <<= 1) {
     for (uint inc = length; inc > 0; inc >>= 1) {
@@ -77,7 +111,9 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
-#  endif /* __KERNEL_OPENCL__ */
+#elif defined(__KERNEL_CPU__)
+  kernel_shader_sort_block(local_value, local_index);
+#endif
 
   /* copy to destination */
   for (uint i = 0; i < SHADER_SORT_BLOCK_SIZE; i += SHADER_SORT_LOCAL_SIZE) {
@@ -91,7 +127,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
                                                               kernel_split_state.queue_data[ini];
     }
   }
-#endif /* __KERNEL_CUDA__ */
 }
 
 CCL_NAMESPACE_END
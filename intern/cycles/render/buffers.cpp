@@ -126,6 +126,7 @@ RenderTile::RenderTile()
 
   buffers = NULL;
   stealing_state = NO_STEALING;
+  start_time = 0.0;
 }
 
 /* Render Buffers */
@@ -306,6 +307,40 @@ bool RenderBuffers::get_pass_rect(
         pixels[0] = val;
       }
     }
+    else if (components == 1 && type == PASS_ADAPTIVE_ERROR) {
+      /* Error estimate of adaptive sampling, computed from the combined pass and the auxiliary
+       * buffer that holds the even samples, in the same units as the adaptive threshold. */
+      int combined_offset = -1, aux_offset = -1;
+      int offset = 0;
+      for (size_t k = 0; k < params.passes.size(); k++) {
+        Pass &other_pass = params.passes[k];
+        if (other_pass.type == PASS_COMBINED) {
+          combined_offset = offset;
+        }
+        else if (other_pass.type == PASS_ADAPTIVE_AUX_BUFFER) {
+          aux_offset = offset;
+        }
+        offset += other_pass.components;
+      }
+
+      if (combined_offset == -1 || aux_offset == -1) {
+        for (int i = 0; i < size; i++, pixels++) {
+          pixels[0] = 0.0f;
+        }
+        return true;
+      }
+
+      const float *in_combined = buffer.data() + combined_offset;
+      const float *in_aux = buffer.data() + aux_offset;
+
+      for (int i = 0; i < size; i++, in_combined += pass_stride, in_aux += pass_stride, pixels++) {
+        const float3 I = make_float3(in_combined[0], in_combined[1], in_combined[2]);
+        const float3 A = make_float3(in_aux[0], in_aux[1], in_aux[2]);
+        const float error = reduce_add(fabs(I - A)) /
+                            (sample * 0.0001f + sqrtf(max(reduce_add(I), 0.0f)));
+        pixels[0] = error / sample;
+      }
+    }
     else if (components == 1) {
       assert(pass.components == components);
 
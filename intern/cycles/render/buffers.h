@@ -149,6 +149,9 @@ class RenderTile {
   typedef enum { NO_STEALING = 0, CAN_BE_STOLEN = 1, WAS_STOLEN = 2 } StealingState;
   StealingState stealing_state;
 
+  /* Time at which the device started rendering the tile. */
+  double start_time;
+
   RenderBuffers *buffers;
 
   RenderTile();
@@ -63,6 +63,7 @@ static NodeEnum *get_pass_type_enum()
   pass_type_enum.insert("aov_value", PASS_AOV_VALUE);
   pass_type_enum.insert("adaptive_aux_buffer", PASS_ADAPTIVE_AUX_BUFFER);
   pass_type_enum.insert("sample_count", PASS_SAMPLE_COUNT);
+  pass_type_enum.insert("adaptive_error", PASS_ADAPTIVE_ERROR);
   pass_type_enum.insert("mist", PASS_MIST);
   pass_type_enum.insert("emission", PASS_EMISSION);
   pass_type_enum.insert("background", PASS_BACKGROUND);
@@ -210,6 +211,7 @@ void Pass::add(PassType type, vector<Pass> &passes, const char *name)
       break;
 #endif
     case PASS_RENDER_TIME:
+    case PASS_ADAPTIVE_ERROR:
       /* This pass is handled entirely on the host side. */
       pass.components = 0;
       break;
@@ -585,6 +587,7 @@ void Film::device_update(Device *device, DeviceScene *dscene, Scene *scene)
         break;
 #endif
       case PASS_RENDER_TIME:
+      case PASS_ADAPTIVE_ERROR:
         break;
       case PASS_CRYPTOMATTE:
         kfilm->pass_cryptomatte = have_cryptomatte ?
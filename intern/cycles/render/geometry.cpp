@@ -61,6 +61,7 @@ Geometry::Geometry(const NodeType *node_type, const Type type)
     : Node(node_type), geometry_type(type), attributes(this, ATTR_PRIM_GEOMETRY)
 {
   need_update_rebuild = false;
+  need_update_device_data = true;
 
   transform_applied = false;
   transform_negative_scaled = false;
@@ -165,6 +166,12 @@ bool Geometry::need_build_bvh(BVHLayout layout) const
   return !transform_applied || has_surface_bssrdf || layout == BVH_LAYOUT_OPTIX;
 }
 
+bool Geometry::need_update_bvh(BVHLayout layout)
+{
+  /* The BVH may also have been released after building the scene BVH. */
+  return need_build_bvh(layout) && (is_modified() || bvh == NULL);
+}
+
 bool Geometry::is_instanced() const
 {
   /* Currently we treat subsurface objects as instanced.
@@ -932,6 +939,12 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
     if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
       Mesh *mesh = static_cast<Mesh *>(geom);
 
+      if (mesh->vert_offset != vert_size || mesh->prim_offset != tri_size ||
+          mesh->patch_offset != patch_size || mesh->face_offset != face_size ||
+          mesh->corner_offset != corner_size) {
+        mesh->need_update_device_data = true;
+      }
+
       mesh->vert_offset = vert_size;
       mesh->prim_offset = tri_size;
 
@@ -962,6 +975,10 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
     else if (geom->is_hair()) {
       Hair *hair = static_cast<Hair *>(geom);
 
+      if (hair->curvekey_offset != curve_key_size || hair->prim_offset != curve_size) {
+        hair->need_update_device_data = true;
+      }
+
       hair->curvekey_offset = curve_key_size;
       hair->prim_offset = curve_size;
 
@@ -1037,13 +1054,22 @@ void GeometryManager::device_update_mesh(
     }
   }
 
+  /* When the arrays kept from the previous update still have the same layout, only the data
+   * of modified geometry is packed and copied to the device. Triangle vertex indices refer to
+   * the primitive layout of the BVH and are always packed. */
+  const bool update_modified_only = !for_displacement && dscene->tri_shader.size() == tri_size &&
+                                    dscene->tri_vnormal.size() == vert_size &&
+                                    dscene->curve_keys.size() == curve_key_size &&
+                                    dscene->curves.size() == curve_size &&
+                                    dscene->patches.size() == patch_size;
+
   /* Fill in all the arrays. */
   if (tri_size != 0) {
     /* normals */
     progress.set_status("Updating Mesh", "Computing normals");
 
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    float4 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
@@ -1051,8 +1077,10 @@ void GeometryManager::device_update_mesh(
     foreach (Geometry *geom, scene->geometry) {
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
-        mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
-        mesh->pack_normals(&vnormal[mesh->vert_offset]);
+        if (!update_modified_only || mesh->need_update_device_data) {
+          mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+          mesh->pack_normals(&vnormal[mesh->vert_offset]);
+        }
         mesh->pack_verts(tri_prim_index,
                          &tri_vindex[mesh->prim_offset],
                          &tri_patch[mesh->prim_offset],
@@ -1067,11 +1095,25 @@ void GeometryManager::device_update_mesh(
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
 
-    dscene->tri_shader.copy_to_device();
-    dscene->tri_vnormal.copy_to_device();
+    if (update_modified_only) {
+      foreach (Geometry *geom, scene->geometry) {
+        if ((geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) &&
+            geom->need_update_device_data) {
+          Mesh *mesh = static_cast<Mesh *>(geom);
+          dscene->tri_shader.copy_to_device(mesh->prim_offset, mesh->num_triangles());
+          dscene->tri_vnormal.copy_to_device(mesh->vert_offset, mesh->verts.size());
+          dscene->tri_patch.copy_to_device(mesh->prim_offset, mesh->num_triangles());
+          dscene->tri_patch_uv.copy_to_device(mesh->vert_offset, mesh->verts.size());
+        }
+      }
+    }
+    else {
+      dscene->tri_shader.copy_to_device();
+      dscene->tri_vnormal.copy_to_device();
+      dscene->tri_patch.copy_to_device();
+      dscene->tri_patch_uv.copy_to_device();
+    }
     dscene->tri_vindex.copy_to_device();
-    dscene->tri_patch.copy_to_device();
-    dscene->tri_patch_uv.copy_to_device();
   }
 
   if (curve_size != 0) {
@@ -1083,17 +1125,29 @@ void GeometryManager::device_update_mesh(
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_hair()) {
         Hair *hair = static_cast<Hair *>(geom);
+        if (update_modified_only && !hair->need_update_device_data) {
+          continue;
+        }
+
         hair->pack_curves(scene,
                           &curve_keys[hair->curvekey_offset],
                           &curves[hair->prim_offset],
                           hair->curvekey_offset);
+
+        if (update_modified_only) {
+          dscene->curve_keys.copy_to_device(hair->curvekey_offset, hair->get_curve_keys().size());
+          dscene->curves.copy_to_device(hair->prim_offset, hair->num_curves());
+        }
+
         if (progress.get_cancel())
           return;
       }
     }
 
-    dscene->curve_keys.copy_to_device();
-    dscene->curves.copy_to_device();
+    if (!update_modified_only) {
+      dscene->curve_keys.copy_to_device();
+      dscene->curves.copy_to_device();
+    }
   }
 
   if (patch_size != 0) {
@@ -1104,14 +1158,29 @@ void GeometryManager::device_update_mesh(
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_mesh()) {
         Mesh *mesh = static_cast<Mesh *>(geom);
+        if (update_modified_only && !mesh->need_update_device_data) {
+          continue;
+        }
+
         mesh->pack_patches(&patch_data[mesh->patch_offset],
                            mesh->vert_offset,
                            mesh->face_offset,
                            mesh->corner_offset);
 
+        size_t mesh_patch_size = 0;
+        if (mesh->get_num_subd_faces()) {
+          Mesh::SubdFace last = mesh->get_subd_face(mesh->get_num_subd_faces() - 1);
+          mesh_patch_size = (last.ptex_offset + last.num_ptex_faces()) * 8;
+        }
+
         if (mesh->patch_table) {
           mesh->patch_table->copy_adjusting_offsets(&patch_data[mesh->patch_table_offset],
                                                     mesh->patch_table_offset);
+          mesh_patch_size += mesh->patch_table->total_size();
+        }
+
+        if (update_modified_only) {
+          dscene->patches.copy_to_device(mesh->patch_offset, mesh_patch_size);
         }
 
         if (progress.get_cancel())
@@ -1119,7 +1188,9 @@ void GeometryManager::device_update_mesh(
       }
     }
 
-    dscene->patches.copy_to_device();
+    if (!update_modified_only) {
+      dscene->patches.copy_to_device();
+    }
   }
 
   if (for_displacement) {
@@ -1138,6 +1209,11 @@ void GeometryManager::device_update_mesh(
     }
     dscene->prim_tri_verts.copy_to_device();
   }
+  else {
+    foreach (Geometry *geom, scene->geometry) {
+      geom->need_update_device_data = false;
+    }
+  }
 }
 
 void GeometryManager::device_update_bvh(Device *device,
@@ -1230,6 +1306,19 @@ void GeometryManager::device_update_bvh(Device *device,
   bvh->copy_to_device(progress, dscene);
 
   delete bvh;
+
+  /* With the BVH2 layout the data of instanced geometry BVHs was copied into the scene BVH,
+   * so for final renders that do not keep the scene around there is no need to keep a second
+   * copy of it in host memory. Released BVHs are built again if the scene is updated. */
+  if (bparams.bvh_layout == BVH_LAYOUT_BVH2 && scene->params.background &&
+      !scene->params.persistent_data) {
+    foreach (Geometry *geom, scene->geometry) {
+      if (geom->bvh) {
+        delete geom->bvh;
+        geom->bvh = NULL;
+      }
+    }
+  }
 }
 
 void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Progress &progress)
@@ -1388,6 +1477,10 @@ void GeometryManager::device_update(Device *device,
           geom->tag_modified();
       }
 
+      if (geom->is_modified()) {
+        geom->need_update_device_data = true;
+      }
+
       if (geom->is_modified() &&
           (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME)) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -1483,8 +1576,9 @@ void GeometryManager::device_update(Device *device,
     scene->object_manager->device_update_flags(device, dscene, scene, progress, false);
   }
 
-  /* Device update. */
-  device_free(device, dscene);
+  /* Device update. Mesh arrays are kept so unchanged geometry does not have to be copied
+   * to the device again. */
+  device_free(device, dscene, false);
 
   mesh_calc_offset(scene);
   if (true_displacement_used) {
@@ -1533,10 +1627,10 @@ void GeometryManager::device_update(Device *device,
             displacement_done = true;
           }
         }
+      }
 
-        if (geom->need_build_bvh(bvh_layout)) {
-          num_bvh++;
-        }
+      if (geom->need_update_bvh(bvh_layout)) {
+        num_bvh++;
       }
 
       if (progress.get_cancel()) {
@@ -1575,7 +1669,7 @@ void GeometryManager::device_update(Device *device,
 
     size_t i = 0;
     foreach (Geometry *geom, scene->geometry) {
-      if (geom->is_modified()) {
+      if (geom->is_modified() || geom->need_update_bvh(bvh_layout)) {
         pool.push(function_bind(
             &Geometry::compute_bvh, geom, device, dscene, &scene->params, &progress, i, num_bvh));
         if (geom->need_build_bvh(bvh_layout)) {
@@ -1651,7 +1745,7 @@ void GeometryManager::device_update(Device *device,
   }
 }
 
-void GeometryManager::device_free(Device *device, DeviceScene *dscene)
+void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool force_free)
 {
 #ifdef WITH_EMBREE
   if (dscene->data.bvh.scene) {
@@ -1671,14 +1765,16 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene)
   dscene->prim_index.free();
   dscene->prim_object.free();
   dscene->prim_time.free();
-  dscene->tri_shader.free();
-  dscene->tri_vnormal.free();
-  dscene->tri_vindex.free();
-  dscene->tri_patch.free();
-  dscene->tri_patch_uv.free();
-  dscene->curves.free();
-  dscene->curve_keys.free();
-  dscene->patches.free();
+  if (force_free) {
+    dscene->tri_shader.free();
+    dscene->tri_vnormal.free();
+    dscene->tri_vindex.free();
+    dscene->tri_patch.free();
+    dscene->tri_patch_uv.free();
+    dscene->curves.free();
+    dscene->curve_keys.free();
+    dscene->patches.free();
+  }
   dscene->attributes_map.free();
   dscene->attributes_float.free();
   dscene->attributes_float2.free();
@@ -89,6 +89,9 @@ class Geometry : public Node {
 
   /* Update Flags */
   bool need_update_rebuild;
+  /* Packed data in the global device arrays is out of date, either because the geometry was
+   * modified or because its offsets in the arrays changed. */
+  bool need_update_device_data;
 
   /* Index into scene->geometry (only valid during update) */
   size_t index;
@@ -135,6 +138,9 @@ class Geometry : public Node {
    */
   bool need_build_bvh(BVHLayout layout) const;
 
+  /* Test if the own BVH of the geometry needs to be (re)built or refitted. */
+  bool need_update_bvh(BVHLayout layout);
+
   /* Test if the geometry should be treated as instanced. */
   bool is_instanced() const;
 
@@ -171,7 +177,7 @@ class GeometryManager {
   /* Device Updates */
   void device_update_preprocess(Device *device, Scene *scene, Progress &progress);
   void device_update(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
-  void device_free(Device *device, DeviceScene *dscene);
+  void device_free(Device *device, DeviceScene *dscene, bool force_free = true);
 
   /* Updates */
   void tag_update(Scene *scene);
@@ -219,7 +219,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
-      compress_as_srgb(false)
+      compress_as_srgb(false),
+      miplevel(0)
 {
 }
 
@@ -279,6 +280,11 @@ ustring ImageLoader::osl_filepath() const
   return ustring();
 }
 
+bool ImageLoader::load_metadata_miplevel(ImageMetaData & /*metadata*/, const int /*max_size*/)
+{
+  return false;
+}
+
 bool ImageLoader::equals(const ImageLoader *a, const ImageLoader *b)
 {
   if (a == NULL && b == NULL) {
@@ -498,11 +504,22 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     return false;
   }
 
+  /* Files storing levels of detail can provide one within the texture limit, which avoids loading
+   * the full resolution image only to scale it down. */
+  ImageMetaData metadata = img->metadata;
+  if (texture_limit > 0 && max(max(metadata.width, metadata.height), metadata.depth) >
+                               (size_t)texture_limit) {
+    if (img->loader->load_metadata_miplevel(metadata, texture_limit)) {
+      VLOG(1) << "Loading image " << img->loader->name() << " from level of detail "
+              << metadata.miplevel << ".";
+    }
+  }
+
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -529,8 +546,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
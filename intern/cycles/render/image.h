@@ -91,6 +91,9 @@ class ImageMetaData {
   /* Automatically set. */
   bool compress_as_srgb;
 
+  /* Level of detail to load from files that store several, 0 for the full resolution. */
+  int miplevel;
+
   ImageMetaData();
   bool operator==(const ImageMetaData &other) const;
   bool is_float() const;
@@ -119,6 +122,10 @@ class ImageLoader {
   /* Optional for OSL texture cache. */
   virtual ustring osl_filepath() const;
 
+  /* Optional, change the metadata to the largest level of detail stored in the file that fits
+   * within the size. Returns false when there is no such level. */
+  virtual bool load_metadata_miplevel(ImageMetaData &metadata, const int max_size);
+
   /* Free any memory used for loading metadata and pixels. */
   virtual void cleanup(){};
 
@@ -103,6 +103,43 @@ bool OIIOImageLoader::load_metadata(ImageMetaData &metadata)
   return true;
 }
 
+bool OIIOImageLoader::load_metadata_miplevel(ImageMetaData &metadata, const int max_size)
+{
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+
+  if (!in) {
+    return false;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Mipmapped files like .tx and tiled EXR store each level as a MIP-level of the image. */
+  int miplevel = 0;
+  while (max(max(spec.width, spec.height), spec.depth) > max_size) {
+    if (!in->seek_subimage(0, miplevel + 1, spec)) {
+      in->close();
+      return false;
+    }
+    miplevel++;
+  }
+
+  in->close();
+
+  if (miplevel == 0 || spec.nchannels != metadata.channels) {
+    return false;
+  }
+
+  metadata.width = spec.width;
+  metadata.height = spec.height;
+  metadata.depth = spec.depth;
+  metadata.miplevel = miplevel;
+
+  return true;
+}
+
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 static void oiio_load_pixels(const ImageMetaData &metadata,
                              const unique_ptr<ImageInput> &in,
@@ -192,6 +229,11 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (metadata.miplevel > 0 && !in->seek_subimage(0, metadata.miplevel, spec)) {
+    in->close();
+    return false;
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
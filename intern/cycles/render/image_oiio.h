@@ -27,6 +27,7 @@ class OIIOImageLoader : public ImageLoader {
   ~OIIOImageLoader();
 
   bool load_metadata(ImageMetaData &metadata) override;
+  bool load_metadata_miplevel(ImageMetaData &metadata, const int max_size) override;
 
   bool load_pixels(const ImageMetaData &metadata,
                    void *pixels,
@@ -110,7 +110,14 @@ bool VDBImageLoader::load_metadata(ImageMetaData &metadata)
   else if (grid->isType<openvdb::MaskGrid>()) {
     metadata.channels = 1;
 #  ifdef WITH_NANOVDB
-    return false;  // Unsupported
+    /* NanoVDB has no mask grids, store the topology as a float grid that is one in active
+     * voxels, matching the dense conversion. */
+    openvdb::FloatGrid float_grid(0.0f);
+    float_grid.tree().topologyUnion(openvdb::gridConstPtrCast<openvdb::MaskGrid>(grid)->tree());
+    for (openvdb::FloatGrid::ValueOnIter iter = float_grid.beginValueOn(); iter; ++iter) {
+      iter.setValue(1.0f);
+    }
+    nanogrid = nanovdb::openToNanoVDB(float_grid);
 #  endif
   }
   else {
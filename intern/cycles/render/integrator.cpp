@@ -20,6 +20,7 @@
 #include "render/film.h"
 #include "render/jitter.h"
 #include "render/light.h"
+#include "render/object.h"
 #include "render/scene.h"
 #include "render/shader.h"
 #include "render/sobol.h"
@@ -79,6 +80,8 @@ NODE_DEFINE(Integrator)
   SOCKET_BOOLEAN(sample_all_lights_direct, "Sample All Lights Direct", true);
   SOCKET_BOOLEAN(sample_all_lights_indirect, "Sample All Lights Indirect", true);
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", false);
+  SOCKET_BOOLEAN(use_path_guiding, "Use Path Guiding", false);
 
   static NodeEnum method_enum;
   method_enum.insert("path", PATH);
@@ -221,6 +224,43 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
     kintegrator->light_inv_rr_threshold = 0.0f;
   }
 
+  /* Path guiding, only supported by the CPU path tracing kernel. The radiance cache covers
+   * the scene bounds with cubic cells and is reset whenever the integrator is updated. */
+  kintegrator->use_path_guiding = false;
+
+  if (use_path_guiding && method == PATH && device->info.type == DEVICE_CPU) {
+    BoundBox bounds = BoundBox::empty;
+    foreach (Object *object, scene->objects) {
+      if (object->bounds.valid()) {
+        bounds.grow(object->bounds);
+      }
+    }
+
+    if (bounds.valid()) {
+      const float3 size = bounds.size();
+      const float cell_size = max(max3(size) / GUIDING_GRID_MAX_RESOLUTION, 1e-5f);
+      const int res_x = clamp((int)ceilf(size.x / cell_size), 1, GUIDING_GRID_MAX_RESOLUTION);
+      const int res_y = clamp((int)ceilf(size.y / cell_size), 1, GUIDING_GRID_MAX_RESOLUTION);
+      const int res_z = clamp((int)ceilf(size.z / cell_size), 1, GUIDING_GRID_MAX_RESOLUTION);
+
+      kintegrator->use_path_guiding = true;
+      kintegrator->guiding_resolution_x = res_x;
+      kintegrator->guiding_resolution_y = res_y;
+      kintegrator->guiding_resolution_z = res_z;
+      kintegrator->guiding_bounds_min_x = bounds.min.x;
+      kintegrator->guiding_bounds_min_y = bounds.min.y;
+      kintegrator->guiding_bounds_min_z = bounds.min.z;
+      kintegrator->guiding_inv_cell_size = 1.0f / cell_size;
+
+      const size_t num_cells = (size_t)res_x * res_y * res_z;
+      float *radiance = dscene->guiding_radiance.alloc(num_cells * GUIDING_CELL_SIZE);
+      memset(radiance, 0, sizeof(float) * dscene->guiding_radiance.size());
+      dscene->guiding_radiance.copy_to_device();
+
+      VLOG(1) << "Path guiding cache resolution: " << res_x << "x" << res_y << "x" << res_z;
+    }
+  }
+
   /* sobol directions table */
   int max_samples = 1;
 
@@ -270,6 +310,7 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
 void Integrator::device_free(Device *, DeviceScene *dscene)
 {
   dscene->sample_pattern_lut.free();
+  dscene->guiding_radiance.free();
 }
 
 void Integrator::tag_update(Scene *scene)
@@ -280,6 +321,10 @@ void Integrator::tag_update(Scene *scene)
       break;
     }
   }
+  if (use_light_tree_is_modified() || method_is_modified() ||
+      sample_all_lights_direct_is_modified() || sample_all_lights_indirect_is_modified()) {
+    scene->light_manager->tag_update(scene);
+  }
   tag_modified();
 }
 
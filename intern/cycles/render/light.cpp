@@ -20,6 +20,7 @@
 #include "render/film.h"
 #include "render/graph.h"
 #include "render/integrator.h"
+#include "render/light_tree.h"
 #include "render/mesh.h"
 #include "render/nodes.h"
 #include "render/object.h"
@@ -276,6 +277,49 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+static bool light_tree_use_light(const Light *light)
+{
+  const LightType type = light->get_light_type();
+  return (type == LIGHT_POINT || type == LIGHT_SPOT || type == LIGHT_AREA);
+}
+
+static LightTreePrimitive light_tree_primitive(const Light *light, int light_index)
+{
+  LightTreePrimitive primitive;
+  primitive.light_index = light_index;
+  primitive.energy = average(fabs(light->get_strength()));
+  primitive.bounds = BoundBox::empty;
+
+  const float3 co = light->get_co();
+  const float3 dir = safe_normalize(light->get_dir());
+  const float size = light->get_size();
+
+  if (light->get_light_type() == LIGHT_AREA) {
+    const float3 axisu = light->get_axisu() * (light->get_sizeu() * size);
+    const float3 axisv = light->get_axisv() * (light->get_sizev() * size);
+    const float3 extent = 0.5f * (fabs(axisu) + fabs(axisv));
+
+    primitive.bounds.grow(co - extent);
+    primitive.bounds.grow(co + extent);
+    /* One sided, emitting in the hemisphere around the direction. */
+    primitive.orientation = {dir, 0.0f, M_PI_2_F};
+  }
+  else {
+    const float3 extent = make_float3(size, size, size);
+
+    primitive.bounds.grow(co - extent);
+    primitive.bounds.grow(co + extent);
+    if (light->get_light_type() == LIGHT_SPOT) {
+      primitive.orientation = {dir, 0.0f, light->get_spot_angle() * 0.5f};
+    }
+    else {
+      primitive.orientation = {make_float3(0.0f, 0.0f, 1.0f), M_PI_F, M_PI_2_F};
+    }
+  }
+
+  return primitive;
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -323,7 +367,35 @@ void LightManager::device_update_distribution(Device *,
     }
   }
 
-  size_t num_distribution = num_triangles + num_lights;
+  /* Lights in the light tree share a single entry of the distribution. When all lights are
+   * sampled, the branched path integrator does not use the distribution and the tree would only
+   * change the multiple importance sampling weights. */
+  Integrator *integrator = scene->integrator;
+  const bool use_light_tree = integrator->get_use_light_tree() &&
+                              !(integrator->get_method() == Integrator::BRANCHED_PATH &&
+                                (integrator->get_sample_all_lights_direct() ||
+                                 integrator->get_sample_all_lights_indirect()));
+
+  vector<LightTreePrimitive> tree_primitives;
+  if (use_light_tree) {
+    int light_index = 0;
+    foreach (Light *light, scene->lights) {
+      if (!light->is_enabled) {
+        continue;
+      }
+      if (light_tree_use_light(light)) {
+        tree_primitives.push_back(light_tree_primitive(light, light_index));
+      }
+      light_index++;
+    }
+    if (tree_primitives.size() < 2) {
+      tree_primitives.clear();
+    }
+  }
+  const size_t num_tree_lights = tree_primitives.size();
+
+  size_t num_distribution = num_triangles + num_lights - num_tree_lights +
+                            ((num_tree_lights > 0) ? 1 : 0);
   VLOG(1) << "Total " << num_distribution << " of light distribution primitives.";
 
   /* emission area */
@@ -412,11 +484,14 @@ void LightManager::device_update_distribution(Device *,
     if (!light->is_enabled)
       continue;
 
-    distribution[offset].totarea = totarea;
-    distribution[offset].prim = ~light_index;
-    distribution[offset].lamp.pad = 1.0f;
-    distribution[offset].lamp.size = light->size;
-    totarea += lightarea;
+    if (!(num_tree_lights > 0 && light_tree_use_light(light))) {
+      distribution[offset].totarea = totarea;
+      distribution[offset].prim = ~light_index;
+      distribution[offset].lamp.pad = 1.0f;
+      distribution[offset].lamp.size = light->size;
+      totarea += lightarea;
+      offset++;
+    }
 
     if (light->light_type == LIGHT_DISTANT) {
       use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
@@ -433,6 +508,15 @@ void LightManager::device_update_distribution(Device *,
     }
 
     light_index++;
+  }
+
+  /* light tree */
+  if (num_tree_lights > 0) {
+    distribution[offset].totarea = totarea;
+    distribution[offset].prim = LIGHT_DISTRIBUTION_PRIM_TREE;
+    distribution[offset].lamp.pad = 1.0f;
+    distribution[offset].lamp.size = 0.0f;
+    totarea += lightarea * num_tree_lights;
     offset++;
   }
 
@@ -495,6 +579,28 @@ void LightManager::device_update_distribution(Device *,
     /* CDF */
     dscene->light_distribution.copy_to_device();
 
+    /* Light tree */
+    if (num_tree_lights > 0) {
+      LightTree tree(tree_primitives, light_index);
+
+      KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(tree.nodes.size());
+      memcpy(knodes, tree.nodes.data(), sizeof(KernelLightTreeNode) * tree.nodes.size());
+      dscene->light_tree_nodes.copy_to_device();
+
+      /* The trails are only known once the tree is built, after the lights were copied. */
+      KernelLight *klights = dscene->lights.data();
+      for (int i = 0; i < light_index; i++) {
+        klights[i].tree_trail = tree.trails[i];
+      }
+      dscene->lights.copy_to_device();
+
+      VLOG(1) << "Light tree with " << tree.nodes.size() << " nodes over " << num_tree_lights
+              << " lights.";
+    }
+
+    kintegrator->use_light_tree = (num_tree_lights > 0);
+    kintegrator->num_light_tree_lights = num_tree_lights;
+
     /* Portals */
     if (num_portals > 0) {
       kbackground->portal_offset = light_index;
@@ -512,12 +618,15 @@ void LightManager::device_update_distribution(Device *,
   }
   else {
     dscene->light_distribution.free();
+    dscene->light_tree_nodes.free();
 
     kintegrator->num_distribution = 0;
     kintegrator->num_all_lights = 0;
     kintegrator->pdf_triangles = 0.0f;
     kintegrator->pdf_lights = 0.0f;
     kintegrator->use_lamp_mis = false;
+    kintegrator->use_light_tree = false;
+    kintegrator->num_light_tree_lights = 0;
 
     kbackground->num_portals = 0;
     kbackground->portal_offset = 0;
@@ -901,6 +1010,7 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
 
     klights[light_index].max_bounces = max_bounces;
     klights[light_index].random = random;
+    klights[light_index].tree_trail = 0;
 
     klights[light_index].tfm = light->tfm;
     klights[light_index].itfm = transform_inverse(light->tfm);
@@ -1006,6 +1116,7 @@ void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_ba
 {
   dscene->light_distribution.free();
   dscene->lights.free();
+  dscene->light_tree_nodes.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
     dscene->light_background_conditional_cdf.free();
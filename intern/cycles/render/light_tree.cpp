@@ -0,0 +1,137 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/light_tree.h"
+
+#include "util/util_algorithm.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+LightTreeOrientation LightTreeOrientation::merge(const LightTreeOrientation &a,
+                                                 const LightTreeOrientation &b)
+{
+  /* Grow the widest cone to include the other one. */
+  if (b.theta_o > a.theta_o) {
+    return merge(b, a);
+  }
+
+  const float theta_d = safe_acosf(dot(a.axis, b.axis));
+  const float theta_e = max(a.theta_e, b.theta_e);
+
+  if (min(theta_d + b.theta_o, M_PI_F) <= a.theta_o) {
+    return {a.axis, a.theta_o, theta_e};
+  }
+
+  const float theta_o = 0.5f * (a.theta_o + theta_d + b.theta_o);
+  if (theta_o >= M_PI_F) {
+    return {a.axis, M_PI_F, theta_e};
+  }
+
+  /* Rotate the axis towards the other one, around the axis perpendicular to both. */
+  const float3 ortho = cross(a.axis, b.axis);
+  if (len_squared(ortho) < 1e-12f) {
+    return {a.axis, M_PI_F, theta_e};
+  }
+
+  const float theta_r = theta_o - a.theta_o;
+  const float3 axis = a.axis * cosf(theta_r) + cross(normalize(ortho), a.axis) * sinf(theta_r);
+  return {normalize(axis), theta_o, theta_e};
+}
+
+LightTree::LightTree(vector<LightTreePrimitive> &primitives, int num_lights)
+{
+  trails.resize(num_lights, 0);
+
+  if (primitives.empty()) {
+    return;
+  }
+
+  nodes.reserve(primitives.size() * 2 - 1);
+  build(primitives, 0, primitives.size(), 0, 0);
+}
+
+int LightTree::build(
+    vector<LightTreePrimitive> &primitives, int start, int end, uint trail, int depth)
+{
+  const int node_index = nodes.size();
+  nodes.push_back(KernelLightTreeNode());
+
+  BoundBox bounds = BoundBox::empty;
+  BoundBox centroid_bounds = BoundBox::empty;
+  LightTreeOrientation orientation = primitives[start].orientation;
+  float energy = 0.0f;
+
+  for (int i = start; i < end; i++) {
+    bounds.grow(primitives[i].bounds);
+    centroid_bounds.grow(primitives[i].bounds.center());
+    if (i != start) {
+      orientation = LightTreeOrientation::merge(orientation, primitives[i].orientation);
+    }
+    energy += primitives[i].energy;
+  }
+
+  int light_index = -1;
+  int child_right = -1;
+
+  if (end - start == 1) {
+    light_index = primitives[start].light_index;
+    trails[light_index] = trail;
+  }
+  else {
+    /* Median split along the largest axis of the centroids, this keeps the depth of the tree
+     * within the bits of the trail. */
+    assert(depth < 32);
+
+    const float3 size = centroid_bounds.size();
+    const int axis = (size.x > size.y) ? ((size.x > size.z) ? 0 : 2) :
+                                         ((size.y > size.z) ? 1 : 2);
+    const int middle = (start + end) / 2;
+
+    std::nth_element(primitives.begin() + start,
+                     primitives.begin() + middle,
+                     primitives.begin() + end,
+                     [axis](const LightTreePrimitive &a, const LightTreePrimitive &b) {
+                       return a.bounds.center()[axis] < b.bounds.center()[axis];
+                     });
+
+    build(primitives, start, middle, trail, depth + 1);
+    child_right = build(primitives, middle, end, trail | (1u << depth), depth + 1);
+  }
+
+  /* Filled in last, the vector may have been reallocated by the children. */
+  KernelLightTreeNode &knode = nodes[node_index];
+  knode.bbox_min[0] = bounds.min.x;
+  knode.bbox_min[1] = bounds.min.y;
+  knode.bbox_min[2] = bounds.min.z;
+  knode.energy = energy;
+  knode.bbox_max[0] = bounds.max.x;
+  knode.bbox_max[1] = bounds.max.y;
+  knode.bbox_max[2] = bounds.max.z;
+  knode.theta_o = orientation.theta_o;
+  knode.axis[0] = orientation.axis.x;
+  knode.axis[1] = orientation.axis.y;
+  knode.axis[2] = orientation.axis.z;
+  knode.theta_e = orientation.theta_e;
+  knode.child_right = child_right;
+  knode.light_index = light_index;
+  knode.pad1 = 0;
+  knode.pad2 = 0;
+
+  return node_index;
+}
+
+CCL_NAMESPACE_END
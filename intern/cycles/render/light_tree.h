@@ -0,0 +1,64 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/kernel_types.h"
+
+#include "util/util_boundbox.h"
+#include "util/util_types.h"
+#include "util/util_vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Bounds of a set of directions: all of them are within theta_o of the axis, and light is
+ * emitted within theta_e of each of them. */
+struct LightTreeOrientation {
+  float3 axis;
+  float theta_o;
+  float theta_e;
+
+  static LightTreeOrientation merge(const LightTreeOrientation &a,
+                                    const LightTreeOrientation &b);
+};
+
+struct LightTreePrimitive {
+  BoundBox bounds;
+  LightTreeOrientation orientation;
+  float energy;
+  int light_index;
+};
+
+/* Binary tree over lights, sampled in the kernel proportional to the estimated contribution
+ * of every node to the shading point. */
+class LightTree {
+ public:
+  /* Reorders the primitives. */
+  LightTree(vector<LightTreePrimitive> &primitives, int num_lights);
+
+  /* Nodes in depth first order, the left child of a node directly follows it. */
+  vector<KernelLightTreeNode> nodes;
+  /* Child taken at each level to reach each light, 0 for the left child. */
+  vector<uint> trails;
+
+ protected:
+  int build(vector<LightTreePrimitive> &primitives, int start, int end, uint trail, int depth);
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
@@ -656,6 +656,11 @@ void ObjectManager::device_update(Device *device,
 
   device_free(device, dscene);
 
+  /* Radiance learned for path guiding no longer matches the scene. */
+  if (scene->integrator->get_use_path_guiding()) {
+    scene->integrator->tag_modified();
+  }
+
   if (scene->objects.size() == 0)
     return;
 
@@ -80,7 +80,7 @@ class DeviceScene {
 
   /* mesh */
   device_vector<uint> tri_shader;
-  device_vector<float4> tri_vnormal;
+  device_vector<uint> tri_vnormal;
   device_vector<uint4> tri_vindex;
   device_vector<uint> tri_patch;
   device_vector<float2> tri_patch_uv;
@@ -110,6 +110,7 @@ class DeviceScene {
   /* lights */
   device_vector<KernelLightDistribution> light_distribution;
   device_vector<KernelLight> lights;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
 
@@ -125,6 +126,7 @@ class DeviceScene {
 
   /* integrator */
   device_vector<uint> sample_pattern_lut;
+  device_vector<float> guiding_radiance;
 
   /* ies lights */
   device_vector<float> ies_lights;
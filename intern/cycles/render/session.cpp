@@ -75,12 +75,12 @@ Session::Session(const SessionParams &params_)
   gpu_need_display_buffer_update = false;
   pause = false;
 
+  stealable_tiles = 0;
+  thief_speed = 0.0;
+
   buffers = NULL;
   display = NULL;
 
-  /* Validate denoising parameters. */
-  set_denoising(params.denoising);
-
   /* Create CPU/GPU devices. */
   device = Device::create(params.device, stats, profiler, params.background);
 
@@ -94,6 +94,16 @@ Session::Session(const SessionParams &params_)
     buffers = new RenderBuffers(device);
     display = new DisplayBuffer(device, params.display_buffer_linear);
   }
+  else if (params.progressive_refine) {
+    /* Progressive refine renders all tiles into a single buffer for the full frame, which is
+     * allocated once and written to the render result in one piece, instead of keeping
+     * separate buffers alive for every tile. */
+    buffers = new RenderBuffers(device);
+  }
+
+  /* Validate denoising parameters, after the buffers are created since they decide whether
+   * denoising is scheduled per tile. */
+  set_denoising(params.denoising);
 }
 
 Session::~Session()
@@ -307,6 +317,8 @@ void Session::run_gpu()
       update_status_time();
 
       /* render */
+      update_time_limit();
+
       bool delayed_denoise = false;
       const bool need_denoise = render_need_denoise(delayed_denoise);
       render(need_denoise);
@@ -387,6 +399,29 @@ bool Session::draw_cpu(BufferParams &buffer_params, DeviceDrawParams &draw_param
   return false;
 }
 
+Session::GPUTileStats &Session::get_gpu_tile_stats(Device *tile_device)
+{
+  const int device_num = max(device->device_number(tile_device), 0);
+  if (device_num >= gpu_tile_stats.size()) {
+    gpu_tile_stats.resize(device_num + 1);
+  }
+  return gpu_tile_stats[device_num];
+}
+
+bool Session::has_tile_to_steal(double speed)
+{
+  int num_gpu_tiles = 0;
+  foreach (const GPUTileStats &stats, gpu_tile_stats) {
+    if (stats.stealable_tiles > 0 && stats.speed() > 0.0 && stats.speed() < speed) {
+      return true;
+    }
+    num_gpu_tiles += stats.stealable_tiles;
+  }
+
+  /* Remaining stealable tiles are on CPU devices. */
+  return stealable_tiles > num_gpu_tiles;
+}
+
 bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_lock &tile_lock)
 {
   /* Devices that can get their tiles stolen don't steal tiles themselves.
@@ -395,29 +430,37 @@ bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_l
     return false;
   }
 
+  const double speed = get_gpu_tile_stats(tile_device).speed();
+
   /* Wait until no other thread is trying to steal a tile. */
   while (tile_stealing_state != NOT_STEALING && stealable_tiles > 0) {
     /* Someone else is currently trying to get a tile.
      * Wait on the condition variable and try later. */
     tile_steal_cond.wait(tile_lock);
   }
-  /* If another thread stole the last stealable tile in the meantime, give up. */
-  if (stealable_tiles == 0) {
+  /* If another thread stole the last stealable tile in the meantime, or only faster devices
+   * have tiles left, give up. */
+  if (!has_tile_to_steal(speed)) {
     return false;
   }
 
   /* There are stealable tiles in flight, so signal that one should be released. */
+  thief_speed = speed;
   tile_stealing_state = WAITING_FOR_TILE;
 
   /* Wait until a device notices the signal and releases its tile. */
-  while (tile_stealing_state != GOT_TILE && stealable_tiles > 0) {
+  while (tile_stealing_state != GOT_TILE) {
+    if (!has_tile_to_steal(speed)) {
+      /* The last tile that could be stolen finished on its own, give up unless a device
+       * already started releasing its tile. */
+      TileStealingState expected = WAITING_FOR_TILE;
+      if (tile_stealing_state.compare_exchange_strong(expected, NOT_STEALING)) {
+        tile_steal_cond.notify_all();
+        return false;
+      }
+    }
     tile_steal_cond.wait(tile_lock);
   }
-  /* If the last stealable tile finished on its own, give up. */
-  if (tile_stealing_state != GOT_TILE) {
-    tile_stealing_state = NOT_STEALING;
-    return false;
-  }
 
   /* Successfully stole a tile, now move it to the new device. */
   rtile = stolen_tile;
@@ -426,6 +469,7 @@ bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_l
   rtile.stealing_state = RenderTile::NO_STEALING;
   rtile.num_samples -= (rtile.sample - rtile.start_sample);
   rtile.start_sample = rtile.sample;
+  rtile.start_time = time_dt();
 
   tile_stealing_state = NOT_STEALING;
 
@@ -435,8 +479,22 @@ bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_l
   return true;
 }
 
-bool Session::get_tile_stolen()
+bool Session::get_tile_stolen(const RenderTile &rtile)
 {
+  Device *tile_device = rtile.buffers->buffer.device;
+
+  if (tile_device->info.type != DEVICE_CPU) {
+    /* Only release the tile of a GPU when the waiting device is faster. */
+    if (tile_stealing_state != WAITING_FOR_TILE) {
+      return false;
+    }
+
+    thread_scoped_lock tile_lock(tile_mutex);
+    if (get_gpu_tile_stats(tile_device).speed() >= thief_speed) {
+      return false;
+    }
+  }
+
   /* If tile_stealing_state is WAITING_FOR_TILE, atomically set it to RELEASING_TILE
    * and return true. */
   TileStealingState expected = WAITING_FOR_TILE;
@@ -486,6 +544,15 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
       stealable_tiles++;
       rtile.stealing_state = RenderTile::CAN_BE_STOLEN;
     }
+    else if (tile_device->info.type == DEVICE_CUDA && !buffers && !params.adaptive_sampling) {
+      /* Let faster GPUs take over the remaining samples, so a slow GPU doesn't keep rendering
+       * the last tiles while the other devices are idle. */
+      stealable_tiles++;
+      get_gpu_tile_stats(tile_device).stealable_tiles++;
+      rtile.stealing_state = RenderTile::CAN_BE_STOLEN;
+    }
+
+    rtile.start_time = time_dt();
 
     if (read_bake_tile_cb) {
       rtile.task = RenderTile::BAKE;
@@ -577,6 +644,18 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 {
   thread_scoped_lock tile_lock(tile_mutex);
 
+  if (rtile.task == RenderTile::PATH_TRACE && !buffers &&
+      rtile.buffers->buffer.device->info.type != DEVICE_CPU) {
+    /* Measure the speed of the GPU, including samples of tiles that are being stolen. */
+    GPUTileStats &stats = get_gpu_tile_stats(rtile.buffers->buffer.device);
+    stats.pixel_samples += (double)rtile.w * rtile.h * (rtile.sample - rtile.start_sample);
+    stats.render_time += time_dt() - rtile.start_time;
+
+    if (rtile.stealing_state != RenderTile::NO_STEALING) {
+      stats.stealable_tiles--;
+    }
+  }
+
   if (rtile.stealing_state != RenderTile::NO_STEALING) {
     stealable_tiles--;
     if (rtile.stealing_state == RenderTile::WAS_STOLEN) {
@@ -591,8 +670,9 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
       tile_steal_cond.notify_all();
       return;
     }
-    else if (stealable_tiles == 0) {
-      /* If this was the last stealable tile, wake up any threads still waiting for one. */
+    else {
+      /* Wake up any threads still waiting for a tile, this may have been the last one they
+       * could steal. */
       tile_steal_cond.notify_all();
     }
   }
@@ -811,6 +891,8 @@ void Session::run_cpu()
       update_status_time();
 
       /* render */
+      update_time_limit();
+
       bool delayed_denoise = false;
       const bool need_denoise = render_need_denoise(delayed_denoise);
       render(need_denoise);
@@ -906,6 +988,9 @@ void Session::reset_(BufferParams &buffer_params, int samples)
   tile_manager.reset(buffer_params, samples);
   stealable_tiles = 0;
   tile_stealing_state = NOT_STEALING;
+  foreach (GPUTileStats &stats, gpu_tile_stats) {
+    stats.stealable_tiles = 0;
+  }
   progress.reset_sample();
 
   bool show_progress = params.background || tile_manager.get_num_effective_samples() != INT_MAX;
@@ -1162,7 +1247,7 @@ void Session::render(bool need_denoise)
   task.get_cancel = function_bind(&Progress::get_cancel, &this->progress);
   task.update_tile_sample = function_bind(&Session::update_tile_sample, this, _1);
   task.update_progress_sample = function_bind(&Progress::add_samples, &this->progress, _1, _2);
-  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this);
+  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this, _1);
   task.need_finish_queue = params.progressive_refine;
   task.integrator_branched = scene->integrator->get_method() == Integrator::BRANCHED_PATH;
 
@@ -1254,7 +1339,26 @@ bool Session::update_progressive_refine(bool cancel)
       return false;
   }
 
-  if (params.progressive_refine) {
+  if (params.progressive_refine && buffers) {
+    /* Write the full frame buffer at once. */
+    RenderTile rtile;
+    rtile.x = tile_manager.state.buffer.full_x;
+    rtile.y = tile_manager.state.buffer.full_y;
+    rtile.w = tile_manager.state.buffer.width;
+    rtile.h = tile_manager.state.buffer.height;
+    rtile.sample = sample;
+    rtile.buffers = buffers;
+
+    if (write) {
+      if (write_render_tile_cb)
+        write_render_tile_cb(rtile);
+    }
+    else {
+      if (update_render_tile_cb)
+        update_render_tile_cb(rtile, true);
+    }
+  }
+  else if (params.progressive_refine) {
     foreach (Tile &tile, tile_manager.state.tiles) {
       if (!tile.buffers) {
         continue;
@@ -1284,6 +1388,38 @@ bool Session::update_progressive_refine(bool cancel)
   return write;
 }
 
+void Session::update_time_limit()
+{
+  if (!(params.background && params.progressive_refine) || params.time_limit <= 0.0) {
+    return;
+  }
+
+  /* Sample ranges are set up to be merged with other renders, keep them complete. */
+  if (tile_manager.range_num_samples != -1) {
+    return;
+  }
+
+  double total_time, render_time;
+  progress.get_time(total_time, render_time);
+
+  /* Estimate the time of the next pass from the passes rendered so far. With adaptive sampling
+   * passes only get faster, so this does not overshoot the limit. */
+  const int num_passes = tile_manager.state.sample;
+  const double pass_time = (num_passes > 0) ? render_time / num_passes : 0.0;
+
+  if (render_time + pass_time < params.time_limit) {
+    return;
+  }
+
+  /* Make the pass that is about to be rendered the last one, so it gets denoised and written
+   * like the final sample. */
+  const int num_samples = tile_manager.state.sample + 1;
+  if (num_samples < tile_manager.num_samples) {
+    tile_manager.set_samples(num_samples);
+    progress.set_total_pixel_samples(tile_manager.state.total_pixel_samples);
+  }
+}
+
 void Session::device_free()
 {
   scene->device_free();
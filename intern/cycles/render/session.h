@@ -68,6 +68,8 @@ class SessionParams {
   double reset_timeout;
   double text_timeout;
   double progressive_update_timeout;
+  /* Render time after which progressive refine stops adding samples, zero for unlimited. */
+  double time_limit;
 
   ShadingSystem shadingsystem;
 
@@ -96,6 +98,7 @@ class SessionParams {
     reset_timeout = 0.1;
     text_timeout = 1.0;
     progressive_update_timeout = 1.0;
+    time_limit = 0.0;
 
     shadingsystem = SHADINGSYSTEM_SVM;
     tile_order = TILE_CENTER;
@@ -116,6 +119,7 @@ class SessionParams {
              cancel_timeout == params.cancel_timeout && reset_timeout == params.reset_timeout &&
              text_timeout == params.text_timeout &&
              progressive_update_timeout == params.progressive_update_timeout &&
+             time_limit == params.time_limit &&
              tile_order == params.tile_order && shadingsystem == params.shadingsystem &&
              denoising.type == params.denoising.type);
   }
@@ -195,7 +199,8 @@ class Session {
   bool render_need_denoise(bool &delayed);
 
   bool steal_tile(RenderTile &tile, Device *tile_device, thread_scoped_lock &tile_lock);
-  bool get_tile_stolen();
+  bool get_tile_stolen(const RenderTile &tile);
+  bool has_tile_to_steal(double speed);
   bool acquire_tile(RenderTile &tile, Device *tile_device, uint tile_types);
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile, const bool need_denoise);
@@ -236,8 +241,30 @@ class Session {
   std::atomic<TileStealingState> tile_stealing_state;
   int stealable_tiles;
 
+  /* Tiles of CPU devices can be stolen by any GPU. Tiles of a GPU can only be stolen by a GPU
+   * that rendered faster so far, measured in pixel samples per second over finished tiles. */
+  struct GPUTileStats {
+    GPUTileStats() : stealable_tiles(0), pixel_samples(0.0), render_time(0.0)
+    {
+    }
+
+    double speed() const
+    {
+      return (render_time > 0.0) ? pixel_samples / render_time : 0.0;
+    }
+
+    int stealable_tiles;
+    double pixel_samples;
+    double render_time;
+  };
+  vector<GPUTileStats> gpu_tile_stats;
+  double thief_speed;
+
+  GPUTileStats &get_gpu_tile_stats(Device *tile_device);
+
   /* progressive refine */
   bool update_progressive_refine(bool cancel);
+  void update_time_limit();
 };
 
 CCL_NAMESPACE_END
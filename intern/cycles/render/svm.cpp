@@ -92,19 +92,36 @@ void SVMShaderManager::device_update(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
+  /* Build all modified shaders, and reuse the nodes of the others. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
+  Shader *background_shader = scene->background->get_shader(scene);
+  int num_reused = 0;
+
   for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
+
+    if (!shader->is_modified()) {
+      auto it = compiled_shaders.find(shader);
+      if (it != compiled_shaders.end() && it->second.background == (shader == background_shader)) {
+        shader_svm_nodes[i].steal_data(it->second.svm_nodes);
+        num_reused++;
+        continue;
+      }
+    }
+
     task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
                                  this,
                                  scene,
-                                 scene->shaders[i],
+                                 shader,
                                  &progress,
                                  &shader_svm_nodes[i]));
   }
   task_pool.wait_work();
 
+  /* Entries of removed shaders are dropped here as well. */
+  compiled_shaders.clear();
+
   if (progress.get_cancel()) {
     return;
   }
@@ -142,13 +159,19 @@ void SVMShaderManager::device_update(Device *device,
     node_offset += shader_svm_nodes[i].size() - 1;
   }
 
-  /* Copy the nodes of each shader into the correct location. */
+  /* Copy the nodes of each shader into the correct location, and keep them for the next
+   * update. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
     int shader_size = shader_svm_nodes[i].size() - 1;
 
     memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
     svm_nodes += shader_size;
+
+    CompiledShader &compiled = compiled_shaders[shader];
+    compiled.svm_nodes.steal_data(shader_svm_nodes[i]);
+    compiled.background = (shader == background_shader);
   }
 
   if (progress.get_cancel()) {
@@ -161,8 +184,8 @@ void SVMShaderManager::device_update(Device *device,
 
   need_update = false;
 
-  VLOG(1) << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
-          << " seconds.";
+  VLOG(1) << "Shader manager updated " << num_shaders << " shaders (" << num_reused
+          << " reused) in " << time_dt() - start_time << " seconds.";
 }
 
 void SVMShaderManager::device_free(Device *device, DeviceScene *dscene, Scene *scene)
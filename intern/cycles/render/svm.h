@@ -22,6 +22,7 @@
 #include "render/shader.h"
 
 #include "util/util_array.h"
+#include "util/util_map.h"
 #include "util/util_set.h"
 #include "util/util_string.h"
 #include "util/util_thread.h"
@@ -54,6 +55,15 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  /* Nodes of the shaders compiled in the previous update, reused for shaders that were not
+   * modified since. The nodes of a shader do not depend on where they are placed in the global
+   * node array, only the jump table is rebuilt. */
+  struct CompiledShader {
+    array<int4> svm_nodes;
+    bool background;
+  };
+  unordered_map<Shader *, CompiledShader> compiled_shaders;
 };
 
 /* Graph Compiler */
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "render/light_tree.h"
+
+CCL_NAMESPACE_BEGIN
+
+static LightTreePrimitive point_light_primitive(float3 co, float energy, int light_index)
+{
+  LightTreePrimitive primitive;
+  primitive.bounds = BoundBox(co - make_float3(0.1f), co + make_float3(0.1f));
+  primitive.orientation = {make_float3(0.0f, 0.0f, 1.0f), M_PI_F, M_PI_2_F};
+  primitive.energy = energy;
+  primitive.light_index = light_index;
+  return primitive;
+}
+
+TEST(light_tree, trails_reach_lights)
+{
+  const int num_lights = 7;
+  vector<LightTreePrimitive> primitives;
+  for (int i = 0; i < num_lights; i++) {
+    primitives.push_back(point_light_primitive(make_float3(i * 3 % 7, 0.0f, 0.0f), 1.0f, i));
+  }
+
+  LightTree tree(primitives, num_lights);
+
+  ASSERT_EQ(tree.nodes.size(), (size_t)(num_lights * 2 - 1));
+  EXPECT_FLOAT_EQ(tree.nodes[0].energy, (float)num_lights);
+
+  for (int i = 0; i < num_lights; i++) {
+    uint trail = tree.trails[i];
+    int node_index = 0;
+    while (tree.nodes[node_index].light_index < 0) {
+      node_index = (trail & 1) ? tree.nodes[node_index].child_right : node_index + 1;
+      trail >>= 1;
+    }
+    EXPECT_EQ(tree.nodes[node_index].light_index, i);
+  }
+}
+
+TEST(light_tree, orientation_merge)
+{
+  const LightTreeOrientation up = {make_float3(0.0f, 0.0f, 1.0f), 0.0f, M_PI_2_F};
+  const LightTreeOrientation side = {make_float3(1.0f, 0.0f, 0.0f), 0.0f, M_PI_4_F};
+
+  const LightTreeOrientation merged = LightTreeOrientation::merge(up, side);
+  EXPECT_NEAR(merged.theta_o, M_PI_4_F, 1e-5f);
+  EXPECT_NEAR(merged.theta_e, M_PI_2_F, 1e-5f);
+  EXPECT_NEAR(dot(merged.axis, normalize(make_float3(1.0f, 0.0f, 1.0f))), 1.0f, 1e-5f);
+
+  const LightTreeOrientation same = LightTreeOrientation::merge(up, up);
+  EXPECT_NEAR(same.theta_o, 0.0f, 1e-5f);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(util_math, encode_normal_oct_axes)
+{
+  const float3 axes[] = {make_float3(1.0f, 0.0f, 0.0f),
+                         make_float3(-1.0f, 0.0f, 0.0f),
+                         make_float3(0.0f, 1.0f, 0.0f),
+                         make_float3(0.0f, -1.0f, 0.0f),
+                         make_float3(0.0f, 0.0f, 1.0f),
+                         make_float3(0.0f, 0.0f, -1.0f)};
+
+  for (const float3 &N : axes) {
+    const float3 D = decode_normal_oct(encode_normal_oct(N));
+    EXPECT_NEAR(len(D - N), 0.0f, 1e-4f);
+  }
+}
+
+TEST(util_math, encode_normal_oct_sphere)
+{
+  /* Spherical Fibonacci points cover all octants. */
+  const int num_points = 10000;
+  for (int i = 0; i < num_points; i++) {
+    const float z = 1.0f - (2.0f * i + 1.0f) / num_points;
+    const float r = safe_sqrtf(1.0f - z * z);
+    const float phi = M_2PI_F * fractf(i * 0.618034f);
+    const float3 N = make_float3(r * cosf(phi), r * sinf(phi), z);
+
+    const float3 D = decode_normal_oct(encode_normal_oct(N));
+    EXPECT_NEAR(len(D), 1.0f, 1e-5f);
+    EXPECT_NEAR(len(D - N), 0.0f, 1e-4f);
+  }
+}
+
+CCL_NAMESPACE_END
@@ -494,6 +494,41 @@ ccl_device_inline float3 ensure_finite3(float3 v)
   return v;
 }
 
+/* Octahedral encoding of a unit vector into 16 bits per coordinate, as described in
+ * "A Survey of Efficient Representations for Independent Unit Vectors". */
+
+ccl_device_inline uint encode_normal_oct(const float3 N)
+{
+  const float inv_len = 1.0f / max(fabsf(N.x) + fabsf(N.y) + fabsf(N.z), 1e-20f);
+  float u = N.x * inv_len;
+  float v = N.y * inv_len;
+
+  if (N.z < 0.0f) {
+    const float u_fold = (1.0f - fabsf(v)) * signf(u);
+    v = (1.0f - fabsf(u)) * signf(v);
+    u = u_fold;
+  }
+
+  const uint x = (uint)(saturate(u * 0.5f + 0.5f) * 65535.0f + 0.5f);
+  const uint y = (uint)(saturate(v * 0.5f + 0.5f) * 65535.0f + 0.5f);
+  return x | (y << 16);
+}
+
+ccl_device_inline float3 decode_normal_oct(const uint data)
+{
+  float u = (float)(data & 0xFFFF) * (2.0f / 65535.0f) - 1.0f;
+  float v = (float)(data >> 16) * (2.0f / 65535.0f) - 1.0f;
+  const float z = 1.0f - fabsf(u) - fabsf(v);
+
+  if (z < 0.0f) {
+    const float u_fold = (1.0f - fabsf(v)) * signf(u);
+    v = (1.0f - fabsf(u)) * signf(v);
+    u = u_fold;
+  }
+
+  return normalize(make_float3(u, v, z));
+}
+
 CCL_NAMESPACE_END
 
 #endif /* __UTIL_MATH_FLOAT3_H__ */
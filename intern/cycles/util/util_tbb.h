@@ -33,6 +33,7 @@ CCL_NAMESPACE_BEGIN
 using tbb::blocked_range;
 using tbb::enumerable_thread_specific;
 using tbb::parallel_for;
+using tbb::parallel_invoke;
 
 static inline void parallel_for_cancel()
 {
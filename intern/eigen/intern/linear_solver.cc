@@ -268,16 +268,10 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 /* Solve */
 
-bool EIG_linear_solver_solve(LinearSolver *solver)
+static bool linear_solver_factorize(LinearSolver *solver)
 {
-  /* nothing to solve, perhaps all variables were locked */
-  if (solver->m == 0 || solver->n == 0)
-    return true;
-
   bool result = true;
 
-  assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
-
   if (solver->state == LinearSolver::STATE_MATRIX_CONSTRUCT) {
     /* create matrix from triplets */
     solver->M.resize(solver->m, solver->n);
@@ -302,6 +296,30 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
     solver->state = LinearSolver::STATE_MATRIX_SOLVED;
   }
 
+  return result;
+}
+
+bool EIG_linear_solver_factorize(LinearSolver *solver)
+{
+  /* nothing to solve, perhaps all variables were locked */
+  if (solver->m == 0 || solver->n == 0)
+    return true;
+
+  assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
+
+  return linear_solver_factorize(solver);
+}
+
+bool EIG_linear_solver_solve(LinearSolver *solver)
+{
+  /* nothing to solve, perhaps all variables were locked */
+  if (solver->m == 0 || solver->n == 0)
+    return true;
+
+  assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
+
+  bool result = linear_solver_factorize(solver);
+
   if (result) {
     /* solve for each right hand side */
     for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
@@ -344,6 +362,51 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
   return result;
 }
 
+bool EIG_linear_solver_solve_vector(const LinearSolver *solver, const double *b, double *r_x)
+{
+  assert(!solver->least_squares);
+
+  if (solver->m == 0 || solver->n == 0) {
+    for (int i = 0; i < solver->num_variables; i++)
+      r_x[i] = solver->variable[i].value[0];
+    return true;
+  }
+
+  assert(solver->state == LinearSolver::STATE_MATRIX_SOLVED);
+
+  /* modify for locked variables, using their value for the first right hand side */
+  EigenVectorX bv(solver->m);
+  bv.setZero();
+
+  for (int i = 0; i < solver->num_variables; i++) {
+    const LinearSolver::Variable *variable = &solver->variable[i];
+
+    if (!variable->locked)
+      bv[variable->index] += b[i];
+  }
+
+  for (int i = 0; i < solver->num_variables; i++) {
+    const LinearSolver::Variable *variable = &solver->variable[i];
+
+    if (variable->locked) {
+      const std::vector<LinearSolver::Coeff> &a = variable->a;
+
+      for (int j = 0; j < a.size(); j++)
+        bv[a[j].index] -= a[j].value * variable->value[0];
+    }
+  }
+
+  /* solve, only reading the factorization so this can run from multiple threads */
+  EigenVectorX x = solver->sparseLU->solve(bv);
+
+  for (int i = 0; i < solver->num_variables; i++) {
+    const LinearSolver::Variable *variable = &solver->variable[i];
+    r_x[i] = (variable->locked) ? variable->value[0] : x[variable->index];
+  }
+
+  return true;
+}
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver)
@@ -58,6 +58,13 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 bool EIG_linear_solver_solve(LinearSolver *solver);
 
+/* Factorize A without solving. Afterwards #EIG_linear_solver_solve_vector can be used to
+ * solve for arbitrary right hand sides b (indexed by variable, as is the resulting x)
+ * concurrently, since that only reads the factorization. Not for least squares. */
+
+bool EIG_linear_solver_factorize(LinearSolver *solver);
+bool EIG_linear_solver_solve_vector(const LinearSolver *solver, const double *b, double *r_x);
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver);
@@ -182,6 +182,43 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/** Memory usage of all blocks allocated with the same name, see #MEM_profile_stats_foreach. */
+typedef struct MEM_ProfileStats {
+  const char *name;
+  /** Memory and number of blocks currently allocated. */
+  size_t live_len;
+  size_t live_blocks;
+  /** Memory and number of blocks allocated since profiling started, including freed blocks.
+   * Sampling these over time gives the allocation rate. */
+  size_t total_len;
+  size_t total_blocks;
+} MEM_ProfileStats;
+
+/**
+ * Start collecting per-name statistics for blocks allocated from now on.
+ *
+ * Profiling can not be disabled again, it adds a small overhead to every allocation. The guarded
+ * allocator always knows the names of its blocks, there it only reports live blocks (including
+ * the ones allocated before profiling started) and totals are the same as the live statistics.
+ */
+extern void (*MEM_profile_enable)(void);
+
+/** Is profiling enabled, see #MEM_profile_enable. */
+extern bool (*MEM_profile_is_enabled)(void);
+
+/**
+ * Calls the function with the statistics of every block name.
+ *
+ * The same name may be reported more than once (for example when the same string literal has
+ * different addresses in different modules), callers should accumulate by name.
+ */
+extern void (*MEM_profile_stats_foreach)(void (*func)(const MEM_ProfileStats *stats,
+                                                      void *user_data),
+                                         void *user_data);
+
+/** Print the profile statistics merged by name, sorted by the amount of live memory. */
+void MEM_profile_print(void);
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -26,6 +26,10 @@
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
 #include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "mallocn_intern.h"
 
@@ -60,6 +64,10 @@ size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 unsigned int (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
+void (*MEM_profile_enable)(void) = MEM_lockfree_profile_enable;
+bool (*MEM_profile_is_enabled)(void) = MEM_lockfree_profile_is_enabled;
+void (*MEM_profile_stats_foreach)(void (*func)(const MEM_ProfileStats *stats, void *user_data),
+                                  void *user_data) = MEM_lockfree_profile_stats_foreach;
 
 #ifndef NDEBUG
 const char *(*MEM_name_ptr)(void *vmemh) = MEM_lockfree_name_ptr;
@@ -96,6 +104,84 @@ void aligned_free(void *ptr)
 #endif
 }
 
+typedef struct MemProfilePrintData {
+  MEM_ProfileStats *stats;
+  size_t stats_num;
+  size_t stats_alloc;
+} MemProfilePrintData;
+
+static void mem_profile_print_add(const MEM_ProfileStats *stats, void *user_data)
+{
+  MemProfilePrintData *data = (MemProfilePrintData *)user_data;
+  if (data->stats_num == data->stats_alloc) {
+    const size_t stats_alloc = data->stats_alloc ? data->stats_alloc * 2 : 256;
+    MEM_ProfileStats *new_stats = realloc(data->stats, sizeof(MEM_ProfileStats) * stats_alloc);
+    if (new_stats == NULL) {
+      return;
+    }
+    data->stats = new_stats;
+    data->stats_alloc = stats_alloc;
+  }
+  data->stats[data->stats_num++] = *stats;
+}
+
+static int mem_profile_compare_name(const void *p1, const void *p2)
+{
+  const MEM_ProfileStats *stats1 = (const MEM_ProfileStats *)p1;
+  const MEM_ProfileStats *stats2 = (const MEM_ProfileStats *)p2;
+  return strcmp(stats1->name, stats2->name);
+}
+
+static int mem_profile_compare_live_len(const void *p1, const void *p2)
+{
+  const MEM_ProfileStats *stats1 = (const MEM_ProfileStats *)p1;
+  const MEM_ProfileStats *stats2 = (const MEM_ProfileStats *)p2;
+  if (stats1->live_len != stats2->live_len) {
+    return (stats1->live_len < stats2->live_len) ? 1 : -1;
+  }
+  return (stats1->total_len < stats2->total_len) ? 1 : (stats1->total_len > stats2->total_len);
+}
+
+void MEM_profile_print(void)
+{
+  MemProfilePrintData data = {NULL, 0, 0};
+  MEM_profile_stats_foreach(mem_profile_print_add, &data);
+
+  /* Sort by name and add together entries with the same name. */
+  size_t stats_num = 0;
+  if (data.stats_num > 0) {
+    qsort(data.stats, data.stats_num, sizeof(MEM_ProfileStats), mem_profile_compare_name);
+    for (size_t i = 1; i < data.stats_num; i++) {
+      MEM_ProfileStats *stats = &data.stats[stats_num];
+      if (strcmp(stats->name, data.stats[i].name) == 0) {
+        stats->live_len += data.stats[i].live_len;
+        stats->live_blocks += data.stats[i].live_blocks;
+        stats->total_len += data.stats[i].total_len;
+        stats->total_blocks += data.stats[i].total_blocks;
+      }
+      else {
+        data.stats[++stats_num] = data.stats[i];
+      }
+    }
+    stats_num++;
+    qsort(data.stats, stats_num, sizeof(MEM_ProfileStats), mem_profile_compare_live_len);
+  }
+
+  printf("\nmemory profile%s:\n", MEM_profile_is_enabled() ? "" : " (profiling is disabled)");
+  printf(" LIVE-BLOCKS LIVE-MiB   TOTAL-BLOCKS TOTAL-MiB  NAME\n");
+  for (size_t i = 0; i < stats_num; i++) {
+    const MEM_ProfileStats *stats = &data.stats[i];
+    printf("%12" PRIu64 " %9.3f  %12" PRIu64 " %10.3f  %s\n",
+           (uint64_t)stats->live_blocks,
+           (double)stats->live_len / (double)(1024 * 1024),
+           (uint64_t)stats->total_blocks,
+           (double)stats->total_len / (double)(1024 * 1024),
+           stats->name);
+  }
+
+  free(data.stats);
+}
+
 /* Perform assert checks on allocator type change.
  *
  * Helps catching issues (in debug build) caused by an unintended allocator type change when there
@@ -139,6 +225,9 @@ void MEM_use_lockfree_allocator(void)
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
+  MEM_profile_enable = MEM_lockfree_profile_enable;
+  MEM_profile_is_enabled = MEM_lockfree_profile_is_enabled;
+  MEM_profile_stats_foreach = MEM_lockfree_profile_stats_foreach;
 
 #ifndef NDEBUG
   MEM_name_ptr = MEM_lockfree_name_ptr;
@@ -170,6 +259,9 @@ void MEM_use_guarded_allocator(void)
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
+  MEM_profile_enable = MEM_guarded_profile_enable;
+  MEM_profile_is_enabled = MEM_guarded_profile_is_enabled;
+  MEM_profile_stats_foreach = MEM_guarded_profile_stats_foreach;
 
 #ifndef NDEBUG
   MEM_name_ptr = MEM_guarded_name_ptr;
@@ -1204,6 +1204,91 @@ unsigned int MEM_guarded_get_memory_blocks_in_use(void)
   return _totblock;
 }
 
+void MEM_guarded_profile_enable(void)
+{
+  /* The names of all blocks are always known. */
+}
+
+bool MEM_guarded_profile_is_enabled(void)
+{
+  return true;
+}
+
+void MEM_guarded_profile_stats_foreach(void (*func)(const MEM_ProfileStats *stats,
+                                                    void *user_data),
+                                       void *user_data)
+{
+  MemHead *membl;
+  MemPrintBlock *printblock;
+  unsigned int totpb = 0, a, b;
+
+  mem_lock_thread();
+
+  if (totblock == 0) {
+    mem_unlock_thread();
+    return;
+  }
+
+  printblock = malloc(sizeof(MemPrintBlock) * totblock);
+  if (UNLIKELY(!printblock)) {
+    mem_unlock_thread();
+    print_error("malloc returned null while generating stats");
+    return;
+  }
+
+  membl = membase->first;
+  if (membl) {
+    membl = MEMNEXT(membl);
+  }
+
+  while (membl && totpb < totblock) {
+    printblock[totpb].name = membl->name;
+    printblock[totpb].len = membl->len;
+    printblock[totpb].items = 1;
+    totpb++;
+
+    if (membl->next) {
+      membl = MEMNEXT(membl->next);
+    }
+    else {
+      break;
+    }
+  }
+
+  /* Call the function outside of the lock, it may allocate memory. */
+  mem_unlock_thread();
+
+  /* sort by name and add together blocks with the same name */
+  if (totpb > 1) {
+    qsort(printblock, totpb, sizeof(MemPrintBlock), compare_name);
+  }
+
+  for (a = 0, b = 0; a < totpb; a++) {
+    if (a == b) {
+      continue;
+    }
+    if (strcmp(printblock[a].name, printblock[b].name) == 0) {
+      printblock[b].len += printblock[a].len;
+      printblock[b].items++;
+    }
+    else {
+      b++;
+      memcpy(&printblock[b], &printblock[a], sizeof(MemPrintBlock));
+    }
+  }
+  totpb = totpb ? b + 1 : 0;
+
+  for (a = 0; a < totpb; a++) {
+    MEM_ProfileStats stats;
+    stats.name = printblock[a].name;
+    stats.live_len = stats.total_len = (size_t)printblock[a].len;
+    stats.live_blocks = stats.total_blocks = (size_t)printblock[a].items;
+    func(&stats, user_data);
+  }
+
+  free(printblock);
+}
+
 #ifndef NDEBUG
 const char *MEM_guarded_name_ptr(void *vmemh)
 {
@@ -89,6 +89,17 @@ size_t malloc_usable_size(void *ptr);
 #  define MEM_INLINE static inline
 #endif
 
+#if defined(_MSC_VER)
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#  define MEM_ALIGNED(alignment) __declspec(align(alignment))
+#else
+#  define MEM_THREAD_LOCAL __thread
+#  define MEM_ALIGNED(alignment) __attribute__((aligned(alignment)))
+#endif
+
+/* Assumed cache line size, to avoid false sharing of data updated from different threads. */
+#define MEM_CACHE_LINE_SIZE 64
+
 #define IS_POW2(a) (((a) & ((a)-1)) == 0)
 
 /* Extra padding which needs to be applied on MemHead to make it aligned. */
@@ -151,6 +162,10 @@ size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
 size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_lockfree_profile_enable(void);
+bool MEM_lockfree_profile_is_enabled(void);
+void MEM_lockfree_profile_stats_foreach(void (*func)(const MEM_ProfileStats *stats, void *user_data),
+                                        void *user_data);
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh);
 #endif
@@ -194,6 +209,10 @@ size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
 size_t MEM_guarded_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_guarded_profile_enable(void);
+bool MEM_guarded_profile_is_enabled(void);
+void MEM_guarded_profile_stats_foreach(void (*func)(const MEM_ProfileStats *stats, void *user_data),
+                                       void *user_data);
 #ifndef NDEBUG
 const char *MEM_guarded_name_ptr(void *vmemh);
 #endif
@@ -43,20 +43,76 @@ typedef struct MemHeadAligned {
   size_t len;
 } MemHeadAligned;
 
-static unsigned int totblock = 0;
-static size_t mem_in_use = 0, peak_mem = 0;
+/* Counters are sharded over separate cache lines, with every thread updating its own shard, so
+ * that allocating from many threads at once does not contend on a single cache line.
+ *
+ * Memory may be freed by another thread than the one that allocated it, so the counters of a
+ * single shard may wrap around below zero. Only their (unsigned, wrapping) sum is meaningful.
+ *
+ * The peak is tracked on a global counter to which shards only flush their changes once they
+ * exceed #MEM_COUNTER_FLUSH_THRESHOLD, so it is exact up to that threshold per shard. */
+#define MEM_COUNTER_SHARDS_NUM 64
+#define MEM_COUNTER_FLUSH_THRESHOLD ((int64_t)(1 << 20))
+
+typedef struct MemCounterShard {
+  unsigned int totblock;
+  size_t mem_in_use;
+  /* Change of `mem_in_use` not yet added to #mem_in_use_flushed. */
+  int64_t mem_in_use_pending;
+} MemCounterShard;
+
+typedef union MemCounterShardPadded {
+  MemCounterShard shard;
+  char _pad[MEM_CACHE_LINE_SIZE];
+} MemCounterShardPadded;
+
+static MEM_ALIGNED(MEM_CACHE_LINE_SIZE)
+    MemCounterShardPadded mem_counter_shards[MEM_COUNTER_SHARDS_NUM];
+static unsigned int mem_counter_shard_next = 0;
+static MEM_THREAD_LOCAL MemCounterShard *mem_counter_shard_thread = NULL;
+
+static size_t mem_in_use_flushed = 0, peak_mem = 0;
+
+/* Per-name statistics, collected once #MEM_lockfree_profile_enable has been called.
+ *
+ * Entries are found by the address of the name string in an open addressing table which is never
+ * resized or freed, since blocks keep a pointer to their entry. When the table is full, blocks
+ * are counted in the last, overflow entry. */
+#define MEM_PROFILE_TABLE_SIZE 8192
+
+typedef struct MemProfileEntry {
+  const char *name;
+  size_t live_len;
+  size_t live_blocks;
+  size_t total_len;
+  size_t total_blocks;
+} MemProfileEntry;
+
+/* Stored in front of the #MemHead (or #MemHeadAligned) of blocks allocated while profiling. */
+typedef struct MemHeadProfile {
+  MemProfileEntry *entry;
+} MemHeadProfile;
+
+static MemProfileEntry *mem_profile_table = NULL;
 static bool malloc_debug_memset = false;
 
 static void (*error_callback)(const char *) = NULL;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  MEMHEAD_PROFILE_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
+#define MEMHEAD_IS_PROFILED(memhead) ((memhead)->len & (size_t)MEMHEAD_PROFILE_FLAG)
+
+/* Same as #MEMHEAD_ALIGN_PADDING, for aligned blocks with a #MemHeadProfile. */
+#define MEMHEAD_PROFILE_ALIGN_PADDING(alignment) \
+  ((size_t)alignment - \
+   ((sizeof(MemHeadAligned) + sizeof(MemHeadProfile)) % (size_t)alignment))
 
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
@@ -70,6 +126,108 @@ MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 #endif
 }
 
+MEM_INLINE MemCounterShard *mem_counter_shard_get(void)
+{
+  MemCounterShard *shard = mem_counter_shard_thread;
+  if (UNLIKELY(shard == NULL)) {
+    const unsigned int index = atomic_fetch_and_add_u(&mem_counter_shard_next, 1) %
+                               MEM_COUNTER_SHARDS_NUM;
+    shard = &mem_counter_shards[index].shard;
+    mem_counter_shard_thread = shard;
+  }
+  return shard;
+}
+
+static void mem_counter_shard_flush(MemCounterShard *shard, int64_t pending)
+{
+  /* Another thread using the same shard may flush concurrently, what matters is that exactly
+   * what is removed from the shard is added to the global counter. */
+  atomic_sub_and_fetch_int64(&shard->mem_in_use_pending, pending);
+  const size_t total = atomic_add_and_fetch_z(&mem_in_use_flushed, (size_t)pending);
+  update_maximum(&peak_mem, total);
+}
+
+MEM_INLINE void mem_counters_add_block(size_t len)
+{
+  MemCounterShard *shard = mem_counter_shard_get();
+  atomic_add_and_fetch_u(&shard->totblock, 1);
+  atomic_add_and_fetch_z(&shard->mem_in_use, len);
+  const int64_t pending = atomic_add_and_fetch_int64(&shard->mem_in_use_pending, (int64_t)len);
+  if (UNLIKELY(pending > MEM_COUNTER_FLUSH_THRESHOLD)) {
+    mem_counter_shard_flush(shard, pending);
+  }
+}
+
+MEM_INLINE void mem_counters_remove_block(size_t len)
+{
+  MemCounterShard *shard = mem_counter_shard_get();
+  atomic_sub_and_fetch_u(&shard->totblock, 1);
+  atomic_sub_and_fetch_z(&shard->mem_in_use, len);
+  const int64_t pending = atomic_sub_and_fetch_int64(&shard->mem_in_use_pending, (int64_t)len);
+  if (UNLIKELY(pending < -MEM_COUNTER_FLUSH_THRESHOLD)) {
+    mem_counter_shard_flush(shard, pending);
+  }
+}
+
+static MemProfileEntry *mem_profile_entry_ensure(const char *name)
+{
+  size_t hash = (size_t)(uintptr_t)name;
+  hash = (hash >> 3) ^ (hash >> 17);
+  hash *= (size_t)2654435761u;
+
+  for (size_t i = 0; i < MEM_PROFILE_TABLE_SIZE; i++) {
+    MemProfileEntry *entry = &mem_profile_table[(hash + i) & (MEM_PROFILE_TABLE_SIZE - 1)];
+    const char *entry_name = entry->name;
+    if (entry_name == NULL) {
+      entry_name = atomic_cas_ptr((void **)&entry->name, NULL, (void *)name);
+      if (entry_name == NULL) {
+        return entry;
+      }
+    }
+    if (entry_name == name) {
+      return entry;
+    }
+  }
+  return &mem_profile_table[MEM_PROFILE_TABLE_SIZE];
+}
+
+MEM_INLINE void mem_profile_add_block(MemHeadProfile *memh_profile, const char *name, size_t len)
+{
+  MemProfileEntry *entry = mem_profile_entry_ensure(name);
+  memh_profile->entry = entry;
+  atomic_add_and_fetch_z(&entry->live_len, len);
+  atomic_add_and_fetch_z(&entry->live_blocks, 1);
+  atomic_add_and_fetch_z(&entry->total_len, len);
+  atomic_add_and_fetch_z(&entry->total_blocks, 1);
+}
+
+MEM_INLINE void mem_profile_remove_block(MemHeadProfile *memh_profile, size_t len)
+{
+  MemProfileEntry *entry = memh_profile->entry;
+  atomic_sub_and_fetch_z(&entry->live_len, len);
+  atomic_sub_and_fetch_z(&entry->live_blocks, 1);
+}
+
+/* Profile header of the block, or null when it was allocated without profiling. */
+MEM_INLINE MemHeadProfile *mem_profile_head_get(const void *vmemh)
+{
+  const MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+  if (LIKELY(!MEMHEAD_IS_PROFILED(memh))) {
+    return NULL;
+  }
+  if (MEMHEAD_IS_ALIGNED(memh)) {
+    return ((MemHeadProfile *)MEMHEAD_ALIGNED_FROM_PTR(vmemh)) - 1;
+  }
+  return ((MemHeadProfile *)memh) - 1;
+}
+
+/* Name for a new block holding a copy of the given block, so it stays in the same statistics. */
+MEM_INLINE const char *mem_profile_copy_name(const void *vmemh, const char *name)
+{
+  const MemHeadProfile *memh_profile = mem_profile_head_get(vmemh);
+  return memh_profile ? memh_profile->entry->name : name;
+}
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -92,7 +250,8 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len &
+           ~((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_PROFILE_FLAG));
   }
 
   return 0;
@@ -115,13 +274,24 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  mem_counters_remove_block(len);
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
   }
-  if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
+
+  MemHeadProfile *memh_profile = mem_profile_head_get(vmemh);
+  if (UNLIKELY(memh_profile)) {
+    mem_profile_remove_block(memh_profile, len);
+    if (MEMHEAD_IS_ALIGNED(memh)) {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      aligned_free((char *)memh_profile - MEMHEAD_PROFILE_ALIGN_PADDING(memh_aligned->alignment));
+    }
+    else {
+      free(memh_profile);
+    }
+  }
+  else if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
     MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
@@ -136,13 +306,13 @@ void *MEM_lockfree_dupallocN(const void *vmemh)
   if (vmemh) {
     MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     const size_t prev_size = MEM_lockfree_allocN_len(vmemh);
+    const char *name = mem_profile_copy_name(vmemh, "dupli_malloc");
     if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(
-          prev_size, (size_t)memh_aligned->alignment, "dupli_malloc");
+      newp = MEM_lockfree_mallocN_aligned(prev_size, (size_t)memh_aligned->alignment, name);
     }
     else {
-      newp = MEM_lockfree_mallocN(prev_size, "dupli_malloc");
+      newp = MEM_lockfree_mallocN(prev_size, name);
     }
     memcpy(newp, vmemh, prev_size);
   }
@@ -156,13 +326,14 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
   if (vmemh) {
     MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
+    const char *name = mem_profile_copy_name(vmemh, "realloc");
 
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "realloc");
+      newp = MEM_lockfree_mallocN(len, name);
     }
     else {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, name);
     }
 
     if (newp) {
@@ -192,13 +363,14 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
   if (vmemh) {
     MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
+    const char *name = mem_profile_copy_name(vmemh, "recalloc");
 
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "recalloc");
+      newp = MEM_lockfree_mallocN(len, name);
     }
     else {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "recalloc");
+      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, name);
     }
 
     if (newp) {
@@ -232,20 +404,25 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  const size_t profile_size = mem_profile_table ? sizeof(MemHeadProfile) : 0;
+  memh = (MemHead *)calloc(1, len + sizeof(MemHead) + profile_size);
 
   if (LIKELY(memh)) {
+    memh = (MemHead *)((char *)memh + profile_size);
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add_block(len);
+
+    if (UNLIKELY(profile_size)) {
+      memh->len |= (size_t)MEMHEAD_PROFILE_FLAG;
+      mem_profile_add_block(((MemHeadProfile *)memh) - 1, str, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)MEM_lockfree_get_memory_in_use());
   return NULL;
 }
 
@@ -259,7 +436,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)MEM_lockfree_get_memory_in_use());
     abort();
     return NULL;
   }
@@ -273,24 +450,30 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  const size_t profile_size = mem_profile_table ? sizeof(MemHeadProfile) : 0;
+  memh = (MemHead *)malloc(len + sizeof(MemHead) + profile_size);
 
   if (LIKELY(memh)) {
+    memh = (MemHead *)((char *)memh + profile_size);
+
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add_block(len);
+
+    if (UNLIKELY(profile_size)) {
+      memh->len |= (size_t)MEMHEAD_PROFILE_FLAG;
+      mem_profile_add_block(((MemHeadProfile *)memh) - 1, str, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)MEM_lockfree_get_memory_in_use());
   return NULL;
 }
 
@@ -304,7 +487,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)MEM_lockfree_get_memory_in_use());
     abort();
     return NULL;
   }
@@ -332,19 +515,21 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
    * We only support small alignments which fits into short in
    * order to save some bits in MemHead structure.
    */
-  size_t extra_padding = MEMHEAD_ALIGN_PADDING(alignment);
+  const size_t profile_size = mem_profile_table ? sizeof(MemHeadProfile) : 0;
+  size_t extra_padding = profile_size ? MEMHEAD_PROFILE_ALIGN_PADDING(alignment) :
+                                        MEMHEAD_ALIGN_PADDING(alignment);
 
   len = SIZET_ALIGN_4(len);
 
   MemHeadAligned *memh = (MemHeadAligned *)aligned_malloc(
-      len + extra_padding + sizeof(MemHeadAligned), alignment);
+      len + extra_padding + profile_size + sizeof(MemHeadAligned), alignment);
 
   if (LIKELY(memh)) {
     /* We keep padding in the beginning of MemHead,
      * this way it's always possible to get MemHead
      * from the data pointer.
      */
-    memh = (MemHeadAligned *)((char *)memh + extra_padding);
+    memh = (MemHeadAligned *)((char *)memh + extra_padding + profile_size);
 
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
@@ -352,16 +537,19 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
 
     memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add_block(len);
+
+    if (UNLIKELY(profile_size)) {
+      memh->len |= (size_t)MEMHEAD_PROFILE_FLAG;
+      mem_profile_add_block(((MemHeadProfile *)memh) - 1, str, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)MEM_lockfree_get_memory_in_use());
   return NULL;
 }
 
@@ -381,8 +569,10 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_memory_in_use() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_peak_memory() / (double)(1024 * 1024));
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -410,30 +600,84 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
+  size_t mem_in_use = 0;
+  for (int i = 0; i < MEM_COUNTER_SHARDS_NUM; i++) {
+    mem_in_use += mem_counter_shards[i].shard.mem_in_use;
+  }
   return mem_in_use;
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
+  unsigned int totblock = 0;
+  for (int i = 0; i < MEM_COUNTER_SHARDS_NUM; i++) {
+    totblock += mem_counter_shards[i].shard.totblock;
+  }
   return totblock;
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  peak_mem = MEM_lockfree_get_memory_in_use();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
+  /* The flushed peak may miss the pending changes of the shards. */
+  update_maximum(&peak_mem, MEM_lockfree_get_memory_in_use());
   return peak_mem;
 }
 
+void MEM_lockfree_profile_enable(void)
+{
+  if (mem_profile_table != NULL) {
+    return;
+  }
+  MemProfileEntry *table = calloc(MEM_PROFILE_TABLE_SIZE + 1, sizeof(MemProfileEntry));
+  if (table == NULL) {
+    print_error("calloc returned null while enabling profiling\n");
+    return;
+  }
+  table[MEM_PROFILE_TABLE_SIZE].name = "(other)";
+  if (atomic_cas_ptr((void **)&mem_profile_table, NULL, table) != NULL) {
+    free(table);
+  }
+}
+
+bool MEM_lockfree_profile_is_enabled(void)
+{
+  return mem_profile_table != NULL;
+}
+
+void MEM_lockfree_profile_stats_foreach(void (*func)(const MEM_ProfileStats *stats,
+                                                     void *user_data),
+                                        void *user_data)
+{
+  if (mem_profile_table == NULL) {
+    return;
+  }
+  for (size_t i = 0; i <= MEM_PROFILE_TABLE_SIZE; i++) {
+    const MemProfileEntry *entry = &mem_profile_table[i];
+    if (entry->name == NULL || entry->total_blocks == 0) {
+      continue;
+    }
+    MEM_ProfileStats stats;
+    stats.name = entry->name;
+    stats.live_len = entry->live_len;
+    stats.live_blocks = entry->live_blocks;
+    stats.total_len = entry->total_len;
+    stats.total_blocks = entry->total_blocks;
+    func(&stats, user_data);
+  }
+}
+
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh)
 {
   if (vmemh) {
-    return "unknown block name ptr";
+    const MemHeadProfile *memh_profile = mem_profile_head_get(vmemh);
+    return memh_profile ? memh_profile->entry->name : "unknown block name ptr";
   }
 
   return "MEM_lockfree_name_ptr(NULL)";
@@ -0,0 +1,57 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+const int threads_num = 8;
+const int blocks_num = 1000;
+const size_t block_size = 4096;
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, CountersAcrossThreads)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+  MEM_reset_peak_memory();
+
+  std::vector<std::vector<void *>> blocks(threads_num);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&blocks, i]() {
+      for (int j = 0; j < blocks_num; j++) {
+        blocks[i].push_back(MEM_mallocN(block_size, __func__));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use + threads_num * blocks_num * block_size);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + threads_num * blocks_num);
+  EXPECT_GE(MEM_get_peak_memory(), mem_in_use + threads_num * blocks_num * block_size);
+
+  /* Free from other threads than the ones allocating. */
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&blocks, i]() {
+      for (void *block : blocks[(i + 1) % threads_num]) {
+        MEM_freeN(block);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
@@ -0,0 +1,92 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+const char *profile_test_name = "profile_test_block";
+
+void find_stats(const MEM_ProfileStats *stats, void *user_data)
+{
+  MEM_ProfileStats *r_stats = static_cast<MEM_ProfileStats *>(user_data);
+  if (strcmp(stats->name, profile_test_name) == 0) {
+    r_stats->live_len += stats->live_len;
+    r_stats->live_blocks += stats->live_blocks;
+    r_stats->total_len += stats->total_len;
+    r_stats->total_blocks += stats->total_blocks;
+  }
+}
+
+MEM_ProfileStats get_stats()
+{
+  MEM_ProfileStats stats = {profile_test_name, 0, 0, 0, 0};
+  MEM_profile_stats_foreach(find_stats, &stats);
+  return stats;
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, ProfileStats)
+{
+  MEM_profile_enable();
+  EXPECT_TRUE(MEM_profile_is_enabled());
+
+  const MEM_ProfileStats stats_before = get_stats();
+
+  void *a = MEM_mallocN(100, profile_test_name);
+  void *b = MEM_callocN(200, profile_test_name);
+  void *c = MEM_mallocN_aligned(300, 64, profile_test_name);
+  EXPECT_EQ(MEM_allocN_len(a), 100u);
+  EXPECT_EQ(MEM_allocN_len(c), 300u);
+  EXPECT_TRUE(((size_t)c % 64) == 0);
+
+  MEM_ProfileStats stats = get_stats();
+  EXPECT_EQ(stats.live_blocks - stats_before.live_blocks, 3u);
+  EXPECT_EQ(stats.live_len - stats_before.live_len, 600u);
+  EXPECT_EQ(stats.total_blocks - stats_before.total_blocks, 3u);
+
+  /* Copies keep the name of the original block. */
+  a = MEM_reallocN(a, 400);
+  void *d = MEM_dupallocN(c);
+  EXPECT_EQ(MEM_allocN_len(d), 300u);
+  EXPECT_TRUE(((size_t)d % 64) == 0);
+
+  stats = get_stats();
+  EXPECT_EQ(stats.live_blocks - stats_before.live_blocks, 4u);
+  EXPECT_EQ(stats.live_len - stats_before.live_len, 1200u);
+  EXPECT_EQ(stats.total_blocks - stats_before.total_blocks, 5u);
+
+  MEM_freeN(a);
+  MEM_freeN(b);
+  MEM_freeN(c);
+  MEM_freeN(d);
+
+  stats = get_stats();
+  EXPECT_EQ(stats.live_blocks, stats_before.live_blocks);
+  EXPECT_EQ(stats.live_len, stats_before.live_len);
+  EXPECT_EQ(stats.total_blocks - stats_before.total_blocks, 5u);
+  EXPECT_EQ(stats.total_len - stats_before.total_len, 1300u);
+}
+
+TEST_F(GuardedAllocatorTest, ProfileStats)
+{
+  EXPECT_TRUE(MEM_profile_is_enabled());
+
+  void *a = MEM_mallocN(100, profile_test_name);
+  void *b = MEM_mallocN_aligned(200, 32, profile_test_name);
+
+  MEM_ProfileStats stats = get_stats();
+  EXPECT_EQ(stats.live_blocks, 2u);
+  EXPECT_EQ(stats.live_len, 300u);
+
+  MEM_freeN(a);
+  MEM_freeN(b);
+
+  stats = get_stats();
+  EXPECT_EQ(stats.live_blocks, 0u);
+}
@@ -21,6 +21,7 @@
 #include "libmv/simple_pipeline/bundle.h"
 
 #include <map>
+#include <set>
 #include <thread>
 
 #include "ceres/ceres.h"
@@ -566,6 +567,28 @@ void AddResidualBlockToProblem(const CameraIntrinsics *invariant_intrinsics,
 //
 // At this point we only need to bundle points positions, cameras
 // are to be totally still here.
+// Create ordering for the Schur based linear solvers which eliminates points
+// first and keeps cameras and intrinsics in the reduced camera system.
+//
+// Without an explicit ordering Ceres searches for an independent set of
+// parameter blocks itself, which gets slow for shots with many tracks and
+// frames.
+ceres::ParameterBlockOrdering *CreateSchurOrdering(
+    const ceres::Problem &problem,
+    const std::set<double*> &point_blocks) {
+  ceres::ParameterBlockOrdering *ordering =
+    new ceres::ParameterBlockOrdering();
+
+  std::vector<double*> parameter_blocks;
+  problem.GetParameterBlocks(&parameter_blocks);
+  for (int i = 0; i < parameter_blocks.size(); ++i) {
+    double *block = parameter_blocks[i];
+    ordering->AddElementToGroup(block, point_blocks.count(block) ? 0 : 1);
+  }
+
+  return ordering;
+}
+
 void EuclideanBundlePointsOnly(const CameraIntrinsics *invariant_intrinsics,
                                const vector<Marker> &markers,
                                map<int, Vec6> &all_cameras_R_t,
@@ -682,6 +705,7 @@ void EuclideanBundleCommonIntrinsics(
   ceres::Problem problem(problem_options);
   int num_residuals = 0;
   bool have_locked_camera = false;
+  std::set<double*> point_blocks;
   for (int i = 0; i < markers.size(); ++i) {
     const Marker &marker = markers[i];
     EuclideanCamera *camera = reconstruction->CameraForImage(marker.image);
@@ -718,6 +742,7 @@ void EuclideanBundleCommonIntrinsics(
       }
 
       zero_weight_tracks_flags[marker.track] = false;
+      point_blocks.insert(&point->X(0));
       num_residuals++;
     }
   }
@@ -782,6 +807,8 @@ void EuclideanBundleCommonIntrinsics(
   options.use_inner_iterations = true;
   options.max_num_iterations = 100;
   options.num_threads = std::thread::hardware_concurrency();
+  options.linear_solver_ordering.reset(
+      CreateSchurOrdering(problem, point_blocks));
 
   // Solve!
   ceres::Solver::Summary summary;
@@ -577,7 +577,7 @@ MANTA::~MANTA()
  */
 static PyObject *manta_main_module = nullptr;
 
-bool MANTA::runPythonString(vector<string> commands)
+bool MANTA::runPythonString(const vector<string> &commands)
 {
   bool success = true;
   PyGILState_STATE gilstate = PyGILState_Ensure();
@@ -586,10 +586,8 @@ bool MANTA::runPythonString(vector<string> commands)
     manta_main_module = PyImport_ImportModule("__main__");
   }
 
-  for (vector<string>::iterator it = commands.begin(); it != commands.end(); ++it) {
-    string command = *it;
-
-    PyObject *globals_dict = PyModule_GetDict(manta_main_module);
+  PyObject *globals_dict = PyModule_GetDict(manta_main_module);
+  for (const string &command : commands) {
     PyObject *return_value = PyRun_String(
         command.c_str(), Py_file_input, globals_dict, globals_dict);
 
@@ -1026,8 +1024,7 @@ string MANTA::getRealValue(const string &varName)
   it = mRNAMap.find(varName);
 
   if (it == mRNAMap.end()) {
-    cerr << "Fluid Error -- variable " << varName << " not found in RNA map " << it->second
-         << endl;
+    cerr << "Fluid Error -- variable " << varName << " not found in RNA map" << endl;
     return "";
   }
 
@@ -1042,11 +1039,12 @@ string MANTA::parseLine(const string &line)
   int currPos = 0, start_del = 0, end_del = -1;
   bool readingVar = false;
   const char delimiter = '$';
+  res.reserve(line.size());
   while (currPos < line.size()) {
     if (line[currPos] == delimiter && !readingVar) {
       readingVar = true;
       start_del = currPos + 1;
-      res += line.substr(end_del + 1, currPos - end_del - 1);
+      res.append(line, end_del + 1, currPos - end_del - 1);
     }
     else if (line[currPos] == delimiter && readingVar) {
       readingVar = false;
@@ -1055,7 +1053,7 @@ string MANTA::parseLine(const string &line)
     }
     currPos++;
   }
-  res += line.substr(end_del + 1, line.size() - end_del);
+  res.append(line, end_del + 1, line.size() - end_del);
   return res;
 }
 
@@ -1064,18 +1062,26 @@ string MANTA::parseScript(const string &setup_string, FluidModifierData *fmd)
   if (MANTA::with_debug)
     cout << "MANTA::parseScript()" << endl;
 
-  istringstream f(setup_string);
-  ostringstream res;
-  string line = "";
+  string res;
+  res.reserve(setup_string.size());
 
   /* Update RNA map if modifier data is handed over. */
   if (fmd) {
     initializeRNAMap(fmd);
   }
-  while (getline(f, line)) {
-    res << parseLine(line) << "\n";
+
+  /* Substitute the variables line by line, same as reading the script with getline(). */
+  size_t line_start = 0;
+  while (line_start < setup_string.size()) {
+    size_t line_end = setup_string.find('\n', line_start);
+    if (line_end == string::npos) {
+      line_end = setup_string.size();
+    }
+    res += parseLine(setup_string.substr(line_start, line_end - line_start));
+    res += '\n';
+    line_start = line_end + 1;
   }
-  return res.str();
+  return res;
 }
 
 /* Dirty hack: Needed to format paths from python code that is run via PyRun_SimpleString */
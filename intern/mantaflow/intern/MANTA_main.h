@@ -874,7 +874,7 @@ struct MANTA {
   bool initSmokeNoise(struct FluidModifierData *doRnaRefresh = nullptr);
   void initializeMantaflow();
   void terminateMantaflow();
-  bool runPythonString(vector<string> commands);
+  bool runPythonString(const vector<string> &commands);
   string getRealValue(const string &varName);
   string parseLine(const string &line);
   string parseScript(const string &setup_string, FluidModifierData *fmd = nullptr);
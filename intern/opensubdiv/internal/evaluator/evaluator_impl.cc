@@ -781,17 +781,20 @@ OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
   const bool stencil_generate_intermediate_levels = is_adaptive;
   const bool stencil_generate_offsets = true;
   const bool use_inf_sharp_patch = true;
-  // Refine the topology with given settings.
-  // TODO(sergey): What if topology is already refined?
-  if (is_adaptive) {
-    TopologyRefiner::AdaptiveOptions options(level);
-    options.considerFVarChannels = has_face_varying_data;
-    options.useInfSharpPatch = use_inf_sharp_patch;
-    refiner->RefineAdaptive(options);
-  }
-  else {
-    TopologyRefiner::UniformOptions options(level);
-    refiner->RefineUniform(options);
+  // Refine the topology with given settings, unless it was already refined for an evaluator
+  // created earlier.
+  if (!topology_refiner->impl->is_refined) {
+    if (is_adaptive) {
+      TopologyRefiner::AdaptiveOptions options(level);
+      options.considerFVarChannels = has_face_varying_data;
+      options.useInfSharpPatch = use_inf_sharp_patch;
+      refiner->RefineAdaptive(options);
+    }
+    else {
+      TopologyRefiner::UniformOptions options(level);
+      refiner->RefineUniform(options);
+    }
+    topology_refiner->impl->is_refined = true;
   }
   // Generate stencil table to update the bi-cubic patches control vertices
   // after they have been re-posed (both for vertex & varying interpolation).
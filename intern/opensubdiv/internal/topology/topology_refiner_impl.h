@@ -54,6 +54,10 @@ class TopologyRefinerImpl {
   // Subdivision settingsa this refiner is created for.
   OpenSubdiv_TopologyRefinerSettings settings;
 
+  // Refinement only depends on the settings, so it is only done once. After that the refiner is
+  // not modified anymore, which allows multiple evaluators to be created from it.
+  bool is_refined;
+
   // Topology of the mesh which corresponds to the base level.
   //
   // All the indices and values are kept exactly the same as user-defined
@@ -174,6 +174,10 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
         import time
         t_main = time.time()
 
+    # (description, seconds) of imports, registration and add-ons,
+    # the slowest are printed when timing is enabled.
+    time_trace = [] if use_time else None
+
     loaded_modules = set()
 
     if refresh_scripts:
@@ -233,7 +237,12 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
             mod = test_reload(mod)
 
         if mod:
+            if use_time:
+                t_register = time.time()
             register_module_call(mod)
+            if use_time:
+                time_trace.append(
+                    ("register " + mod.__name__, time.time() - t_register))
             _global_loaded_modules.append(mod.__name__)
 
     if reload_scripts:
@@ -263,7 +272,13 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
 
                     # Only add to 'sys.modules' unless this is 'startup'.
                     if path_subdir == "startup":
-                        for mod in modules_from_path(path, loaded_modules):
+                        if use_time:
+                            t_import = time.time()
+                        mods = modules_from_path(path, loaded_modules)
+                        if use_time:
+                            time_trace.append(
+                                ("import " + path, time.time() - t_import))
+                        for mod in mods:
                             test_register(mod)
 
     # load template (if set)
@@ -276,7 +291,7 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
     _initialize = getattr(_addon_utils, "_initialize", None)
     if _initialize is not None:
         # first time, use fast-path
-        _initialize()
+        _initialize(time_trace=time_trace)
         del _addon_utils._initialize
     else:
         _addon_utils.reset_all(reload_scripts=reload_scripts)
@@ -290,6 +305,9 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
 
     if use_time:
         print("Python Script Load Time %.4f" % (time.time() - t_main))
+        time_trace.sort(key=lambda item: item[1], reverse=True)
+        for name, t in time_trace[:20]:
+            print("  %.4f %s" % (t, name))
 
     if use_class_register_check:
         for cls in _bpy.types.bpy_struct.__subclasses__():
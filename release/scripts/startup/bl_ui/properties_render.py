@@ -514,6 +514,7 @@ class RENDER_PT_eevee_hair(RenderButtonsPanel, Panel):
 
         layout.prop(rd, "hair_type", expand=True)
         layout.prop(rd, "hair_subdiv")
+        layout.prop(rd, "use_hair_lod")
 
 
 class RENDER_PT_eevee_performance(RenderButtonsPanel, Panel):
@@ -712,6 +712,7 @@ class USERPREF_PT_viewport_textures(ViewportPanel, CenterAlignMixIn, Panel):
 
         col = layout.column()
         col.prop(system, "gl_texture_limit", text="Limit Size")
+        col.prop(system, "use_gpu_texture_compression")
         col.prop(system, "anisotropic_filter")
         col.prop(system, "gl_clip_alpha", slider=True)
         col.prop(system, "image_draw_method", text="Image Display Method")
@@ -2202,6 +2203,9 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
                 ({"property": "use_new_hair_type"}, "T68981"),
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
                 ({"property": "use_new_geometry_nodes"}, "project/profile/121"),
+                ({"property": "use_undo_skip_unchanged_ids"}, None),
+                ({"property": "use_cow_reference_custom_data"}, None),
+                ({"property": "use_persistent_evaluated_data"}, None),
             ),
         )
 
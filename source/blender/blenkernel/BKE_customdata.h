@@ -33,6 +33,7 @@
 extern "C" {
 #endif
 
+struct BLI_HashMurmur2A;
 struct BMesh;
 struct BlendDataReader;
 struct BlendWriter;
@@ -423,6 +424,10 @@ const char *CustomData_layertype_name(int type);
 bool CustomData_layertype_is_singleton(int type);
 int CustomData_layertype_layers_max(const int type);
 
+bool CustomData_hash_mm2a(const struct CustomData *data,
+                          int totelem,
+                          struct BLI_HashMurmur2A *mm2);
+
 /* make sure the name of layer at index is unique */
 void CustomData_set_layer_unique_name(struct CustomData *data, int index);
 
@@ -36,6 +36,7 @@ struct BMesh;
 struct BoundBox;
 struct Depsgraph;
 struct EditMeshData;
+struct EditMeshEvalInput;
 struct Mesh;
 struct MeshStatVis;
 struct Object;
@@ -67,6 +68,13 @@ typedef struct BMEditMesh {
   /** Cached cage bounding box for selection. */
   struct BoundBox *bb_cage;
 
+  /**
+   * Conversion of the edit-mesh for the modifier stack, reused while only vertex coordinates
+   * change (see #BKE_editmesh_tag_coords_only_update). Unlike the members above this is shared
+   * with the copy-on-write copies of the edit-mesh, it is owned by the original.
+   */
+  struct EditMeshEvalInput *eval_input;
+
   /*derivedmesh stuff*/
   CustomData_MeshMasks lastDataMask;
 
@@ -93,6 +101,11 @@ BMEditMesh *BKE_editmesh_from_object(struct Object *ob);
 void BKE_editmesh_free_derivedmesh(BMEditMesh *em);
 void BKE_editmesh_free(BMEditMesh *em);
 
+void BKE_editmesh_tag_coords_only_update(BMEditMesh *em, const bool coords_only);
+bool BKE_editmesh_eval_input_use_cache(const BMEditMesh *em);
+struct Mesh *BKE_editmesh_eval_input_mesh_get(BMEditMesh *em, const struct Mesh *me_settings);
+void BKE_editmesh_eval_input_update_end(BMEditMesh *em);
+
 float (*BKE_editmesh_vert_coords_alloc(struct Depsgraph *depsgraph,
                                        struct BMEditMesh *em,
                                        struct Scene *scene,
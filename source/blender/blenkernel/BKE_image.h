@@ -43,6 +43,7 @@ struct ReportList;
 struct Scene;
 struct StampData;
 struct anim;
+struct rcti;
 
 #define IMA_MAX_SPACE 64
 #define IMA_UDIM_MAX 1999
@@ -380,8 +381,16 @@ struct GPUTexture *BKE_image_get_gpu_tilemap(struct Image *image,
                                              struct ImageUser *iuser,
                                              struct ImBuf *ibuf);
 bool BKE_image_has_gpu_texture_premultiplied_alpha(struct Image *image, struct ImBuf *ibuf);
+bool BKE_image_gpu_texture_load_async(struct Image *ima, struct ImageUser *iuser);
+void BKE_image_gpu_load_cancel(struct Image *ima);
+int BKE_image_gpu_load_pending_len(void);
+void BKE_image_gpu_load_exit(void);
 void BKE_image_update_gputexture(
     struct Image *ima, struct ImageUser *iuser, int x, int y, int w, int h);
+void BKE_image_update_gputexture_regions(struct Image *ima,
+                                         struct ImageUser *iuser,
+                                         const struct rcti *regions,
+                                         int regions_len);
 void BKE_image_paint_set_mipmap(struct Main *bmain, bool mipmap);
 
 /* Delayed free of OpenGL buffers by main thread */
@@ -304,6 +304,9 @@ void BKE_mesh_calc_normals_poly(struct MVert *mverts,
                                 int numPolys,
                                 float (*r_polyNors)[3],
                                 const bool only_face_normals);
+void BKE_mesh_calc_normals_poly_for_mesh(struct Mesh *mesh,
+                                         float (*r_polynors)[3],
+                                         const bool only_face_normals);
 void BKE_mesh_calc_normals(struct Mesh *me);
 void BKE_mesh_ensure_normals(struct Mesh *me);
 void BKE_mesh_ensure_normals_for_display(struct Mesh *mesh);
@@ -40,6 +40,7 @@ struct ListBase;
 struct Main;
 struct Mesh;
 struct ModifierData;
+struct ModifierResultCache;
 struct Object;
 struct Scene;
 struct bArmature;
@@ -531,6 +532,20 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
                                  float (*vertexCos)[3],
                                  int numVerts);
 
+/* Result cache of constructive modifiers, see #eModifierFlag_CacheResult. */
+
+bool BKE_modifier_result_cache_hash(struct ModifierData *md,
+                                    const struct ModifierEvalContext *ctx,
+                                    const struct Mesh *mesh,
+                                    const struct CustomData_MeshMasks *mask,
+                                    uint32_t *r_hash);
+struct Mesh *BKE_modifier_result_cache_lookup(struct ModifierData *md, const uint32_t hash);
+void BKE_modifier_result_cache_store(struct ModifierData *md,
+                                     const uint32_t hash,
+                                     const struct Mesh *mesh);
+void BKE_modifier_result_cache_free(struct ModifierData *md);
+void BKE_modifier_result_cache_free_data(struct ModifierResultCache *cache);
+
 struct Mesh *BKE_modifier_get_evaluated_mesh_from_evaluated_object(struct Object *ob_eval,
                                                                    const bool get_cage_mesh);
 
@@ -321,6 +321,14 @@ typedef struct SculptClothSimulation {
   int capacity_length_constraints;
   float *length_constraint_tweak;
 
+  /* Indices of the length constraints sorted into groups which don't share any vertex, so the
+   * constraints of a group can be solved in parallel. `constraint_group_offsets` has one extra
+   * group for constraints which can be solved serially only, and the end offset. The groups
+   * are created again when constraints were added since, see `constraint_groups_len`. */
+  int *constraint_groups;
+  int *constraint_group_offsets;
+  int constraint_groups_len;
+
   /* Position anchors for deformation brushes. These positions are modified by the brush and the
    * final positions of the simulated vertices are updated with constraints that use these points
    * as targets. */
@@ -475,6 +483,12 @@ typedef struct SculptSession {
   struct MeshElemMap *pmap;
   int *pmap_mem;
 
+  /* Neighbors of each vertex from `pmap`, the neighbors of vertex `i` are stored from
+   * `vert_neighbors_offset[i]` to `vert_neighbors_offset[i + 1]` in `vert_neighbors`.
+   * Only created on demand for #PBVH_FACES, see `SCULPT_vertex_neighbors_ensure`. */
+  int *vert_neighbors_offset;
+  int *vert_neighbors;
+
   /* Mesh Face Sets */
   /* Total number of polys of the base mesh. */
   int totfaces;
@@ -149,6 +149,38 @@ void BKE_scene_graph_evaluated_ensure(struct Depsgraph *depsgraph, struct Main *
 
 void BKE_scene_graph_update_for_newframe(struct Depsgraph *depsgraph);
 
+/* Evaluation of a frame range with multiple dependency graphs in parallel. */
+
+/* Build relations of a dependency graph used for frame range evaluation. */
+typedef void (*SceneFrameRangeBuildFn)(struct Depsgraph *depsgraph, void *user_data);
+/* Called once the given frame is evaluated, return false to stop the evaluation. */
+typedef bool (*SceneFrameRangeEvaluatedFn)(struct Depsgraph *depsgraph,
+                                           int frame,
+                                           void *user_data);
+
+typedef struct SceneFrameRangeSettings {
+  int frame_start;
+  int frame_end;
+  int frame_step;
+  bool for_render;
+  /* Number of dependency graphs evaluated in parallel, 0 to use the number of threads of the
+   * system. Each of them holds a full evaluated copy of the data. */
+  int num_depsgraphs;
+  /* Call evaluated_fn one frame at a time, in frame order. Evaluation of the following frames
+   * continues in other dependency graphs meanwhile. Otherwise it is called as soon as a frame is
+   * evaluated, from multiple threads at the same time. */
+  bool ordered;
+  /* Builds the dependency graph from the view layer when NULL. */
+  SceneFrameRangeBuildFn build_fn;
+  SceneFrameRangeEvaluatedFn evaluated_fn;
+  void *user_data;
+} SceneFrameRangeSettings;
+
+void BKE_scene_graph_evaluate_frame_range(struct Main *bmain,
+                                          struct Scene *scene,
+                                          struct ViewLayer *view_layer,
+                                          const SceneFrameRangeSettings *settings);
+
 void BKE_scene_view_layer_graph_evaluated_ensure(struct Main *bmain,
                                                  struct Scene *scene,
                                                  struct ViewLayer *view_layer);
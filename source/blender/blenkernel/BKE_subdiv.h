@@ -182,6 +182,11 @@ typedef struct Subdiv {
   struct OpenSubdiv_Evaluator *evaluator;
   /* Optional displacement evaluator. */
   struct SubdivDisplacement *displacement_evaluator;
+  /* Hash of the topology the refiner is created for. */
+  uint topology_hash;
+  /* The topology refiner is shared with other subdivision surfaces which have the same settings
+   * and topology, see BKE_subdiv_topology_refiner_share(). */
+  bool is_topology_refiner_shared;
   /* Statistics for debugging. */
   SubdivStats stats;
 
@@ -247,6 +252,11 @@ Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
 
 void BKE_subdiv_free(Subdiv *subdiv);
 
+/* Make the topology refiner available to other subdivision surfaces with the same settings and
+ * topology, so they don't need to create and refine their own.
+ * Is to be called once the refiner is refined, which happens when the evaluator is created. */
+void BKE_subdiv_topology_refiner_share(Subdiv *subdiv);
+
 /* ============================ DISPLACEMENT API ============================ */
 
 void BKE_subdiv_displacement_attach_from_multires(Subdiv *subdiv,
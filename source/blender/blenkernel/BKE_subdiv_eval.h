@@ -63,6 +63,15 @@ void BKE_subdiv_eval_limit_point_and_derivatives(struct Subdiv *subdiv,
                                                  float r_P[3],
                                                  float r_dPdu[3],
                                                  float r_dPdv[3]);
+/* Evaluate limit points and derivatives at multiple locations of the same ptex face at once,
+ * which avoids per-point evaluator overhead. Derivatives are either both NULL or both given. */
+void BKE_subdiv_eval_limit_points_and_derivatives(struct Subdiv *subdiv,
+                                                  const int ptex_face_index,
+                                                  const float (*uvs)[2],
+                                                  const int num_points,
+                                                  float (*r_P)[3],
+                                                  float (*r_dPdu)[3],
+                                                  float (*r_dPdv)[3]);
 void BKE_subdiv_eval_limit_point_and_normal(struct Subdiv *subdiv,
                                             const int ptex_face_index,
                                             const float u,
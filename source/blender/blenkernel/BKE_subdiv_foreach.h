@@ -100,6 +100,13 @@ typedef void (*SubdivForeachLooseCb)(const struct SubdivForeachContext *context,
                                      const int coarse_vertex_index,
                                      const int subdiv_vertex_index);
 
+typedef void (*SubdivForeachVerticesInnerGridCb)(const struct SubdivForeachContext *context,
+                                                 void *tls,
+                                                 const int ptex_face_index,
+                                                 const int resolution,
+                                                 const int coarse_poly_index,
+                                                 const int start_subdiv_vertex_index);
+
 typedef void (*SubdivForeachVertexOfLooseEdgeCb)(const struct SubdivForeachContext *context,
                                                  void *tls,
                                                  const int coarse_edge_index,
@@ -127,6 +134,11 @@ typedef struct SubdivForeachContext {
   SubdivForeachVertexFromEdgeCb vertex_edge;
   /* Called exactly once, always corresponds to a single ptex face. */
   SubdivForeachVertexInnerCb vertex_inner;
+  /* Optional, called instead of vertex_inner for all inner vertices of a quad coarse polygon,
+   * which allows them to be evaluated as a batch. Requires vertex_inner to be set as well. The vertices form a grid with rows of
+   * (resolution - 2) vertices, and have continuous indices starting at the given one.
+   */
+  SubdivForeachVerticesInnerGridCb vertices_inner_grid;
   /* Called once for each loose vertex. One loose coarse vertexcorresponds
    * to a single subdivision vertex.
    */
@@ -66,6 +66,8 @@
 
 #include "BLI_sys_types.h" /* for intptr_t support */
 
+#include "PIL_time.h"
+
 #include "BKE_shrinkwrap.h"
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
@@ -799,15 +801,7 @@ static void mesh_calc_modifier_final_normals(const Mesh *mesh_input,
     if (!CustomData_has_layer(&mesh_final->pdata, CD_NORMAL)) {
       float(*polynors)[3] = CustomData_add_layer(
           &mesh_final->pdata, CD_NORMAL, CD_CALLOC, NULL, mesh_final->totpoly);
-      BKE_mesh_calc_normals_poly(mesh_final->mvert,
-                                 NULL,
-                                 mesh_final->totvert,
-                                 mesh_final->mloop,
-                                 mesh_final->mpoly,
-                                 mesh_final->totloop,
-                                 mesh_final->totpoly,
-                                 polynors,
-                                 false);
+      BKE_mesh_calc_normals_poly_for_mesh(mesh_final, polynors, false);
     }
   }
 
@@ -979,7 +973,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
           BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
         }
 
+        const double start_time = PIL_check_seconds_timer();
         BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
+        md->execution_time = PIL_check_seconds_timer() - start_time;
 
         isPrevDeform = true;
       }
@@ -1098,7 +1094,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
         BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
       }
+      const double start_time = PIL_check_seconds_timer();
       BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
+      md->execution_time = PIL_check_seconds_timer() - start_time;
     }
     else {
       bool check_for_needs_mapping = false;
@@ -1180,7 +1178,29 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
       }
 
-      Mesh *mesh_next = BKE_modifier_modify_mesh(md, &mectx, mesh_final);
+      /* Reuse the result of the previous evaluation when nothing the modifier depends on has
+       * changed. Orco meshes need the modifier to run anyway, so don't cache in that case. */
+      uint32_t result_hash = 0;
+      const bool use_result_cache = (md->flag & eModifierFlag_CacheResult) &&
+                                    (nextmask.vmask & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO)) == 0 &&
+                                    BKE_modifier_result_cache_hash(
+                                        md, &mectx, mesh_final, &mask, &result_hash);
+      if (!use_result_cache) {
+        BKE_modifier_result_cache_free(md);
+      }
+
+      const double start_time = PIL_check_seconds_timer();
+      Mesh *mesh_next = NULL;
+      if (use_result_cache) {
+        mesh_next = BKE_modifier_result_cache_lookup(md, result_hash);
+      }
+      if (mesh_next == NULL) {
+        mesh_next = BKE_modifier_modify_mesh(md, &mectx, mesh_final);
+        if (use_result_cache && mesh_next != NULL && md->error == NULL) {
+          BKE_modifier_result_cache_store(md, result_hash, mesh_next);
+        }
+      }
+      md->execution_time = PIL_check_seconds_timer() - start_time;
       ASSERT_IS_VALID_MESH(mesh_next);
 
       if (mesh_next) {
@@ -1296,6 +1316,11 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       mesh_final = mesh_input;
     }
     else {
+      if (deformed_verts) {
+        /* The normals of the copy are computed again after deforming, keep the vertex to loop
+         * map for that on the input so the copies of following evaluations share it. */
+        BKE_mesh_runtime_vert_loop_map_ensure(mesh_input);
+      }
       mesh_final = BKE_mesh_copy_for_eval(mesh_input, true);
     }
   }
@@ -1419,15 +1444,7 @@ static void editbmesh_calc_modifier_final_normals(Mesh *mesh_final,
     if (!CustomData_has_layer(&mesh_final->pdata, CD_NORMAL)) {
       float(*polynors)[3] = CustomData_add_layer(
           &mesh_final->pdata, CD_NORMAL, CD_CALLOC, NULL, mesh_final->totpoly);
-      BKE_mesh_calc_normals_poly(mesh_final->mvert,
-                                 NULL,
-                                 mesh_final->totvert,
-                                 mesh_final->mloop,
-                                 mesh_final->mpoly,
-                                 mesh_final->totloop,
-                                 mesh_final->totpoly,
-                                 polynors,
-                                 false);
+      BKE_mesh_calc_normals_poly_for_mesh(mesh_final, polynors, false);
     }
   }
 
@@ -1563,6 +1580,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
       }
 
+      const double start_time = PIL_check_seconds_timer();
       if (mti->deformVertsEM) {
         BKE_modifier_deform_vertsEM(
             md, &mectx, em_input, mesh_final, deformed_verts, num_deformed_verts);
@@ -1570,6 +1588,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       else {
         BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
       }
+      md->execution_time = PIL_check_seconds_timer() - start_time;
     }
     else {
       /* apply vertex coordinates or build a DerivedMesh as necessary */
@@ -1587,6 +1606,19 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
           mesh_final = BKE_mesh_copy_for_eval(mesh_final, false);
         }
       }
+      else if (BKE_editmesh_eval_input_use_cache(em_input) &&
+               (mti->flags & eModifierTypeFlag_AcceptsBMesh) == 0) {
+        /* Only coordinates changed since the last update, reuse its conversion. */
+        mesh_final = BKE_editmesh_eval_input_mesh_get(em_input, mesh_input);
+        if (deformed_verts) {
+          BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
+          MEM_freeN(deformed_verts);
+          deformed_verts = NULL;
+        }
+        else {
+          mesh_final->runtime.is_original = true;
+        }
+      }
       else {
         mesh_final = BKE_mesh_wrapper_from_editmesh_with_coords(
             em_input, NULL, deformed_verts, mesh_input);
@@ -1637,7 +1669,9 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
       }
 
+      const double start_time = PIL_check_seconds_timer();
       Mesh *mesh_next = BKE_modifier_modify_mesh(md, &mectx, mesh_final);
+      md->execution_time = PIL_check_seconds_timer() - start_time;
       ASSERT_IS_VALID_MESH(mesh_next);
 
       if (mesh_next) {
@@ -1682,6 +1716,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
   }
 
   BLI_linklist_free((LinkNode *)datamasks, NULL);
+  BKE_editmesh_eval_input_update_end(em_input);
 
   /* Yay, we are done. If we have a DerivedMesh and deformed vertices need
    * to apply these back onto the DerivedMesh. If we have no DerivedMesh
@@ -1758,6 +1793,54 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/**
+ * Take the batch cache of the previous evaluated mesh of the object when the new one can only
+ * differ by its vertex positions: the previous result was only deformed, the input mesh was not
+ * updated and the same data is requested. Buffers which don't depend on positions (UVs,
+ * indices, ...) can then be kept instead of being extracted again for every frame.
+ */
+static void *mesh_build_data_batch_cache_take(Object *ob,
+                                              const CustomData_MeshMasks *dataMask,
+                                              const bool need_mapping)
+{
+  Mesh *mesh_prev = (Mesh *)ob->runtime.data_eval;
+  if (mesh_prev == NULL || !ob->runtime.is_data_eval_owned || GS(mesh_prev->id.name) != ID_ME) {
+    return NULL;
+  }
+  const Mesh *mesh_input = (const Mesh *)ob->runtime.data_orig;
+  if (mesh_prev->runtime.batch_cache == NULL || !mesh_prev->runtime.deformed_only ||
+      mesh_prev->edit_mesh != NULL || mesh_input == NULL ||
+      (mesh_input->id.recalc & ID_RECALC_ALL) != 0) {
+    return NULL;
+  }
+  if (ob->runtime.last_need_mapping != need_mapping ||
+      memcmp(&ob->runtime.last_data_mask, dataMask, sizeof(*dataMask)) != 0) {
+    return NULL;
+  }
+  void *batch_cache = mesh_prev->runtime.batch_cache;
+  mesh_prev->runtime.batch_cache = NULL;
+  return batch_cache;
+}
+
+static void mesh_build_data_batch_cache_restore(Mesh *mesh_eval,
+                                                const bool is_mesh_eval_owned,
+                                                const bool is_same_size,
+                                                void *batch_cache)
+{
+  if (is_mesh_eval_owned && is_same_size && mesh_eval->runtime.deformed_only &&
+      mesh_eval->runtime.batch_cache == NULL) {
+    mesh_eval->runtime.batch_cache = batch_cache;
+    mesh_eval->runtime.batch_cache_deformed_only = true;
+    return;
+  }
+
+  /* The mesh is shared or has a different topology, free the cache. */
+  void *batch_cache_eval = mesh_eval->runtime.batch_cache;
+  mesh_eval->runtime.batch_cache = batch_cache;
+  BKE_mesh_batch_cache_free(mesh_eval);
+  mesh_eval->runtime.batch_cache = batch_cache_eval;
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1770,6 +1853,10 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  void *batch_cache_prev = mesh_build_data_batch_cache_take(ob, dataMask, need_mapping);
+  const int totvert_prev = (batch_cache_prev) ? ((Mesh *)ob->runtime.data_eval)->totvert : 0;
+  const int totloop_prev = (batch_cache_prev) ? ((Mesh *)ob->runtime.data_eval)->totloop : 0;
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1807,6 +1894,13 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime.mesh_eval);
   BKE_object_eval_assign_data(ob, &mesh_eval->id, is_mesh_eval_owned);
 
+  if (batch_cache_prev != NULL) {
+    const bool is_same_size = (mesh_eval->totvert == totvert_prev &&
+                               mesh_eval->totloop == totloop_prev);
+    mesh_build_data_batch_cache_restore(
+        mesh_eval, is_mesh_eval_owned, is_same_size, batch_cache_prev);
+  }
+
   ob->runtime.mesh_deform_eval = mesh_deform_eval;
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
@@ -362,53 +362,67 @@ void BKE_keyingsets_blend_read_expand(BlendExpander *expander, ListBase *list)
 /* ***************************************** */
 /* Evaluation Data-Setting Backend */
 
+/* Resolve the animated property of a path, without looking at the array index yet. */
+static bool animsys_resolve_rna_setting(PointerRNA *ptr,
+                                        const char *path,
+                                        const int array_index,
+                                        PathResolvedRNA *r_result)
+{
+  if (path == NULL) {
+    return false;
+  }
+
+  /* get property to write to */
+  if (RNA_path_resolve_property(ptr, path, &r_result->ptr, &r_result->prop)) {
+    return (ptr->owner_id == NULL) || RNA_property_animateable(&r_result->ptr, r_result->prop);
+  }
+
+  /* failed to get path */
+  /* XXX don't tag as failed yet though, as there are some legit situations (Action Constraint)
+   * where some channels will not exist, but shouldn't lock up Action */
+  if (G.debug & G_DEBUG) {
+    CLOG_WARN(&LOG,
+              "Animato: Invalid path. ID = '%s',  '%s[%d]'",
+              (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
+              path,
+              array_index);
+  }
+  return false;
+}
+
+/* Set the array index of an already resolved property. */
+static bool animsys_rna_setting_index_set(PointerRNA *ptr,
+                                          const char *path,
+                                          const int array_index,
+                                          PathResolvedRNA *r_result)
+{
+  int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+
+  if (array_len && array_index >= array_len) {
+    if (G.debug & G_DEBUG) {
+      CLOG_WARN(&LOG,
+                "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
+                (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
+                path,
+                array_index,
+                array_len - 1);
+    }
+    return false;
+  }
+
+  r_result->prop_index = array_len ? array_index : -1;
+  return true;
+}
+
 bool BKE_animsys_store_rna_setting(PointerRNA *ptr,
                                    /* typically 'fcu->rna_path', 'fcu->array_index' */
                                    const char *rna_path,
                                    const int array_index,
                                    PathResolvedRNA *r_result)
 {
-  bool success = false;
-  const char *path = rna_path;
-
   /* write value to setting */
-  if (path) {
-    /* get property to write to */
-    if (RNA_path_resolve_property(ptr, path, &r_result->ptr, &r_result->prop)) {
-      if ((ptr->owner_id == NULL) || RNA_property_animateable(&r_result->ptr, r_result->prop)) {
-        int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
-
-        if (array_len && array_index >= array_len) {
-          if (G.debug & G_DEBUG) {
-            CLOG_WARN(&LOG,
-                      "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
-                      (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                      path,
-                      array_index,
-                      array_len - 1);
-          }
-        }
-        else {
-          r_result->prop_index = array_len ? array_index : -1;
-          success = true;
-        }
-      }
-    }
-    else {
-      /* failed to get path */
-      /* XXX don't tag as failed yet though, as there are some legit situations (Action Constraint)
-       * where some channels will not exist, but shouldn't lock up Action */
-      if (G.debug & G_DEBUG) {
-        CLOG_WARN(&LOG,
-                  "Animato: Invalid path. ID = '%s',  '%s[%d]'",
-                  (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                  path,
-                  array_index);
-      }
-    }
-  }
-
-  return success;
+  return animsys_resolve_rna_setting(ptr, rna_path, array_index, r_result) &&
+         animsys_rna_setting_index_set(ptr, rna_path, array_index, r_result);
 }
 
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
@@ -592,6 +606,12 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  /* The curves for the components of a property (e.g. `location[0..2]`) are usually next to
+   * each other, so the path of the previous curve is kept to avoid parsing it again. */
+  const char *resolved_path = NULL;
+  PathResolvedRNA resolved_rna;
+  bool resolved_ok = false;
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
     /* Check if this F-Curve doesn't belong to a muted group. */
@@ -606,8 +626,19 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     if (BKE_fcurve_is_empty(fcu)) {
       continue;
     }
-    PathResolvedRNA anim_rna;
-    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (fcu->rna_path == NULL) {
+      continue;
+    }
+    if (resolved_path == NULL || !STREQ(resolved_path, fcu->rna_path)) {
+      resolved_path = fcu->rna_path;
+      resolved_ok = animsys_resolve_rna_setting(
+          ptr, fcu->rna_path, fcu->array_index, &resolved_rna);
+    }
+    if (!resolved_ok) {
+      continue;
+    }
+    PathResolvedRNA anim_rna = resolved_rna;
+    if (animsys_rna_setting_index_set(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_rna_setting(&anim_rna, curval);
       if (flush_to_original) {
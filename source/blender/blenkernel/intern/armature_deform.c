@@ -229,6 +229,52 @@ static void pchan_bone_deform(bPoseChannel *pchan,
   (*contrib) += weight;
 }
 
+/**
+ * Whether the bone deforms vertices with its plain deform matrix, in which case the weighted
+ * matrices of all such bones can be summed and the vertex transformed only once.
+ */
+static bool pchan_deform_is_linear(const bPoseChannel *pchan, const bool use_quaternion)
+{
+  const Bone *bone = pchan->bone;
+
+  if (use_quaternion || (bone->flag & BONE_MULT_VG_ENV)) {
+    return false;
+  }
+  return !(bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments);
+}
+
+/* Add the weighted affine part of the deform matrix to the accumulated one. */
+static void pchan_deform_mat_accumulate(const float deform_mat[4][4],
+                                        float weight,
+                                        float mat_accum[4][3])
+{
+  for (int a = 0; a < 4; a++) {
+    madd_v3_v3fl(mat_accum[a], deform_mat[a], weight);
+  }
+}
+
+/**
+ * Apply the result of #pchan_deform_mat_accumulate, this matches calling
+ * #pchan_deform_accumulate for every bone that was accumulated.
+ */
+static void pchan_deform_mat_apply(const float mat_accum[4][3],
+                                   float weight_accum,
+                                   const float co[3],
+                                   float co_accum[3],
+                                   float defmat_accum[3][3])
+{
+  for (int a = 0; a < 3; a++) {
+    co_accum[a] += co[0] * mat_accum[0][a] + co[1] * mat_accum[1][a] + co[2] * mat_accum[2][a] +
+                   mat_accum[3][a] - weight_accum * co[a];
+  }
+
+  if (defmat_accum) {
+    for (int a = 0; a < 3; a++) {
+      add_v3_v3(defmat_accum[a], mat_accum[a]);
+    }
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -256,6 +302,8 @@ typedef struct ArmatureUserdata {
   int dverts_len;
 
   bPoseChannel **pchan_from_defbase;
+  /** Per deform group, whether the bone can use #pchan_deform_mat_accumulate. */
+  const bool *pchan_linear_from_defbase;
   int defbase_len;
 
   float premat[4][4];
@@ -329,6 +377,9 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
   if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
     const MDeformWeight *dw = dvert->dw;
+    const bool *pchan_linear_from_defbase = data->pchan_linear_from_defbase;
+    float linear_mat[4][3] = {{0.0f}};
+    float linear_weight = 0.0f;
     int deformed = 0;
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
@@ -339,6 +390,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
         deformed = 1;
 
+        if (pchan_linear_from_defbase[index]) {
+          if (weight != 0.0f) {
+            pchan_deform_mat_accumulate(pchan->chan_mat, weight, linear_mat);
+            linear_weight += weight;
+          }
+          continue;
+        }
+
         if (bone && bone->flag & BONE_MULT_VG_ENV) {
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
@@ -347,6 +406,10 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
         pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
       }
     }
+    if (linear_weight != 0.0f) {
+      pchan_deform_mat_apply(linear_mat, linear_weight, co, vec, smat);
+      contrib += linear_weight;
+    }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
       for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
@@ -473,6 +536,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 {
   bArmature *arm = ob_arm->data;
   bPoseChannel **pchan_from_defbase = NULL;
+  bool *pchan_linear_from_defbase = NULL;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -543,6 +607,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 
       if (use_dverts) {
         pchan_from_defbase = MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone");
+        pchan_linear_from_defbase = MEM_callocN(sizeof(*pchan_linear_from_defbase) * defbase_len,
+                                                "defnrToBoneLinear");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
@@ -554,6 +620,10 @@ static void armature_deform_coords_impl(const Object *ob_arm,
             if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
               pchan_from_defbase[i] = NULL;
             }
+            else {
+              pchan_linear_from_defbase[i] = pchan_deform_is_linear(pchan_from_defbase[i],
+                                                                   use_quaternion);
+            }
           }
         }
       }
@@ -575,6 +645,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .dverts = dverts,
       .dverts_len = dverts_len,
       .pchan_from_defbase = pchan_from_defbase,
+      .pchan_linear_from_defbase = pchan_linear_from_defbase,
       .defbase_len = defbase_len,
       .bmesh =
           {
@@ -610,6 +681,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 
   if (pchan_from_defbase) {
     MEM_freeN(pchan_from_defbase);
+    MEM_freeN(pchan_linear_from_defbase);
   }
 }
 
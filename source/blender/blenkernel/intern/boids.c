@@ -418,48 +418,40 @@ static bool rule_separate(BoidRule *UNUSED(rule),
                           BoidValues *val,
                           ParticleData *pa)
 {
-  KDTreeNearest_3d *ptn = NULL;
+  /* Only the closest neighbors are used, so there is no need to gather and sort everything within
+   * the personal space. The closest one in the own system is the particle itself. */
+  KDTreeNearest_3d ptn[2];
   ParticleTarget *pt;
-  float len = 2.0f * val->personal_space * pa->size + 1.0f;
+  const float space = 2.0f * val->personal_space * pa->size;
+  float len = space + 1.0f;
   float vec[3] = {0.0f, 0.0f, 0.0f};
-  int neighbors = BLI_kdtree_3d_range_search(
-      bbd->sim->psys->tree, pa->prev_state.co, &ptn, 2.0f * val->personal_space * pa->size);
+  int neighbors = BLI_kdtree_3d_find_nearest_n(
+      bbd->sim->psys->tree, pa->prev_state.co, ptn, ARRAY_SIZE(ptn));
   bool ret = false;
 
-  if (neighbors > 1 && ptn[1].dist != 0.0f) {
+  if (neighbors > 1 && ptn[1].dist <= space && ptn[1].dist != 0.0f) {
     sub_v3_v3v3(vec, pa->prev_state.co, bbd->sim->psys->particles[ptn[1].index].state.co);
-    mul_v3_fl(vec, (2.0f * val->personal_space * pa->size - ptn[1].dist) / ptn[1].dist);
+    mul_v3_fl(vec, (space - ptn[1].dist) / ptn[1].dist);
     add_v3_v3(bbd->wanted_co, vec);
     bbd->wanted_speed = val->max_speed;
     len = ptn[1].dist;
     ret = 1;
   }
-  if (ptn) {
-    MEM_freeN(ptn);
-    ptn = NULL;
-  }
 
   /* check other boid systems */
   for (pt = bbd->sim->psys->targets.first; pt; pt = pt->next) {
     ParticleSystem *epsys = psys_get_target_system(bbd->sim->ob, pt);
 
     if (epsys) {
-      neighbors = BLI_kdtree_3d_range_search(
-          epsys->tree, pa->prev_state.co, &ptn, 2.0f * val->personal_space * pa->size);
-
-      if (neighbors > 0 && ptn[0].dist < len) {
+      if (BLI_kdtree_3d_find_nearest(epsys->tree, pa->prev_state.co, &ptn[0]) != -1 &&
+          ptn[0].dist <= space && ptn[0].dist < len && ptn[0].dist != 0.0f) {
         sub_v3_v3v3(vec, pa->prev_state.co, ptn[0].co);
-        mul_v3_fl(vec, (2.0f * val->personal_space * pa->size - ptn[0].dist) / ptn[1].dist);
+        mul_v3_fl(vec, (space - ptn[0].dist) / ptn[0].dist);
         add_v3_v3(bbd->wanted_co, vec);
         bbd->wanted_speed = val->max_speed;
         len = ptn[0].dist;
         ret = true;
       }
-
-      if (ptn) {
-        MEM_freeN(ptn);
-        ptn = NULL;
-      }
     }
   }
   return ret;
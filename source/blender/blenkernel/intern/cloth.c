@@ -33,6 +33,7 @@
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DEG_depsgraph.h"
@@ -130,6 +131,44 @@ static BVHTree *bvhtree_build_from_cloth(ClothModifierData *clmd, float epsilon)
   return bvhtree;
 }
 
+typedef struct ClothBVHUpdateData {
+  BVHTree *bvhtree;
+  const ClothVertex *verts;
+  const MVertTri *tri;
+  bool moving;
+} ClothBVHUpdateData;
+
+static void bvhtree_update_from_cloth_leaf(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ClothBVHUpdateData *data = userdata;
+  const ClothVertex *verts = data->verts;
+  const MVertTri *vt = &data->tri[i];
+  float co[3][3], co_moving[3][3];
+
+  /* copy new locations into array */
+  if (data->moving) {
+    copy_v3_v3(co[0], verts[vt->tri[0]].txold);
+    copy_v3_v3(co[1], verts[vt->tri[1]].txold);
+    copy_v3_v3(co[2], verts[vt->tri[2]].txold);
+
+    /* update moving positions */
+    copy_v3_v3(co_moving[0], verts[vt->tri[0]].tx);
+    copy_v3_v3(co_moving[1], verts[vt->tri[1]].tx);
+    copy_v3_v3(co_moving[2], verts[vt->tri[2]].tx);
+
+    BLI_bvhtree_update_node(data->bvhtree, i, co[0], co_moving[0], 3);
+  }
+  else {
+    copy_v3_v3(co[0], verts[vt->tri[0]].tx);
+    copy_v3_v3(co[1], verts[vt->tri[1]].tx);
+    copy_v3_v3(co[2], verts[vt->tri[2]].tx);
+
+    BLI_bvhtree_update_node(data->bvhtree, i, co[0], NULL, 3);
+  }
+}
+
 void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
 {
   unsigned int i = 0;
@@ -156,36 +195,20 @@ void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
   /* update vertex position in bvh tree */
   if (clmd->hairdata == NULL) {
     if (verts && vt) {
-      for (i = 0; i < cloth->primitive_num; i++, vt++) {
-        float co[3][3], co_moving[3][3];
-        bool ret;
-
-        /* copy new locations into array */
-        if (moving) {
-          copy_v3_v3(co[0], verts[vt->tri[0]].txold);
-          copy_v3_v3(co[1], verts[vt->tri[1]].txold);
-          copy_v3_v3(co[2], verts[vt->tri[2]].txold);
-
-          /* update moving positions */
-          copy_v3_v3(co_moving[0], verts[vt->tri[0]].tx);
-          copy_v3_v3(co_moving[1], verts[vt->tri[1]].tx);
-          copy_v3_v3(co_moving[2], verts[vt->tri[2]].tx);
-
-          ret = BLI_bvhtree_update_node(bvhtree, i, co[0], co_moving[0], 3);
-        }
-        else {
-          copy_v3_v3(co[0], verts[vt->tri[0]].tx);
-          copy_v3_v3(co[1], verts[vt->tri[1]].tx);
-          copy_v3_v3(co[2], verts[vt->tri[2]].tx);
-
-          ret = BLI_bvhtree_update_node(bvhtree, i, co[0], NULL, 3);
-        }
-
-        /* check if tree is already full */
-        if (ret == false) {
-          break;
-        }
-      }
+      /* Leaves are independent, only the branches have to be joined in order afterwards. */
+      ClothBVHUpdateData data = {
+          .bvhtree = bvhtree,
+          .verts = verts,
+          .tri = vt,
+          .moving = moving,
+      };
+      const int leaf_num = min_ii((int)cloth->primitive_num, BLI_bvhtree_get_len(bvhtree));
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (leaf_num > 1024);
+      settings.min_iter_per_thread = 256;
+      BLI_task_parallel_range(0, leaf_num, &data, bvhtree_update_from_cloth_leaf, &settings);
 
       BLI_bvhtree_update_tree(bvhtree);
     }
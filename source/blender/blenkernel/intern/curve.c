@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_ghash.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -2639,6 +2640,42 @@ void BKE_curve_bevelList_free(ListBase *bev)
   BLI_listbase_clear(bev);
 }
 
+typedef struct BevelListOrientationData {
+  BevList **bevlists;
+  bool is_3d;
+  int smooth_iter;
+  int twist_mode;
+} BevelListOrientationData;
+
+static void bevel_list_orientation_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BevelListOrientationData *data = userdata;
+  BevList *bl = data->bevlists[i];
+
+  if (bl->nr < 2) {
+    BevPoint *bevp = bl->bevpoints;
+    unit_qt(bevp->quat);
+  }
+  else if (bl->nr == 2) { /* 2 pnt, treat separate */
+    if (data->is_3d) {
+      make_bevel_list_segment_3D(bl);
+    }
+    else {
+      make_bevel_list_segment_2D(bl);
+    }
+  }
+  else {
+    if (data->is_3d) {
+      make_bevel_list_3D(bl, data->smooth_iter, data->twist_mode);
+    }
+    else {
+      make_bevel_list_2D(bl);
+    }
+  }
+}
+
 void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
 {
   /*
@@ -3150,35 +3187,27 @@ void BKE_curve_bevelList_make(Object *ob, ListBase *nurbs, bool for_render)
   }
 
   /* STEP 4: 2D-COSINES or 3D ORIENTATION */
-  if ((cu->flag & CU_3D) == 0) {
-    /* 2D Curves */
+  /* Each bevel list is oriented on its own, which matters for text where every character
+   * contributes several splines. */
+  const int bevlists_len = BLI_listbase_count(bev);
+  if (bevlists_len > 0) {
+    BevelListOrientationData data = {
+        .bevlists = MEM_malloc_arrayN(bevlists_len, sizeof(BevList *), __func__),
+        .is_3d = (cu->flag & CU_3D) != 0,
+        .smooth_iter = (int)(resolu * cu->twist_smooth),
+        .twist_mode = cu->twist_mode,
+    };
+    a = 0;
     LISTBASE_FOREACH (BevList *, bl, bev) {
-      if (bl->nr < 2) {
-        BevPoint *bevp = bl->bevpoints;
-        unit_qt(bevp->quat);
-      }
-      else if (bl->nr == 2) { /* 2 pnt, treat separate */
-        make_bevel_list_segment_2D(bl);
-      }
-      else {
-        make_bevel_list_2D(bl);
-      }
-    }
-  }
-  else {
-    /* 3D Curves */
-    LISTBASE_FOREACH (BevList *, bl, bev) {
-      if (bl->nr < 2) {
-        BevPoint *bevp = bl->bevpoints;
-        unit_qt(bevp->quat);
-      }
-      else if (bl->nr == 2) { /* 2 pnt, treat separate */
-        make_bevel_list_segment_3D(bl);
-      }
-      else {
-        make_bevel_list_3D(bl, (int)(resolu * cu->twist_smooth), cu->twist_mode);
-      }
+      data.bevlists[a++] = bl;
     }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 8;
+    BLI_task_parallel_range(0, bevlists_len, &data, bevel_list_orientation_cb, &settings);
+
+    MEM_freeN(data.bevlists);
   }
 }
 
@@ -36,12 +36,14 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_endian_switch.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
 #include "BLI_math_color_blend.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -2865,6 +2867,43 @@ void CustomData_copy_elements(int type, void *src_data_ofs, void *dst_data_ofs,
   }
 }
 
+/* Layers with more elements than this are copied in chunks of this size, in parallel. */
+#define CUSTOMDATA_COPY_CHUNK_SIZE 16384
+
+typedef struct CustomDataCopyLayerData {
+  const LayerTypeInfo *typeInfo;
+  const void *src_data;
+  void *dst_data;
+  int count;
+} CustomDataCopyLayerData;
+
+static void customdata_copy_data_layer_chunk(const LayerTypeInfo *typeInfo,
+                                             const void *src_data,
+                                             void *dst_data,
+                                             int count)
+{
+  if (typeInfo->copy) {
+    typeInfo->copy(src_data, dst_data, count);
+  }
+  else {
+    memcpy(dst_data, src_data, (size_t)count * typeInfo->size);
+  }
+}
+
+static void customdata_copy_data_layer_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CustomDataCopyLayerData *data = userdata;
+  const int start = chunk * CUSTOMDATA_COPY_CHUNK_SIZE;
+  const size_t offset = (size_t)start * data->typeInfo->size;
+
+  customdata_copy_data_layer_chunk(data->typeInfo,
+                                   POINTER_OFFSET(data->src_data, offset),
+                                   POINTER_OFFSET(data->dst_data, offset),
+                                   min_ii(CUSTOMDATA_COPY_CHUNK_SIZE, data->count - start));
+}
+
 static void CustomData_copy_data_layer(const CustomData *source,
                                        CustomData *dest,
                                        int src_i,
@@ -2894,15 +2933,30 @@ static void CustomData_copy_data_layer(const CustomData *source,
     return;
   }
 
-  if (typeInfo->copy) {
-    typeInfo->copy(
-        POINTER_OFFSET(src_data, src_offset), POINTER_OFFSET(dst_data, dst_offset), count);
-  }
-  else {
-    memcpy(POINTER_OFFSET(dst_data, dst_offset),
-           POINTER_OFFSET(src_data, src_offset),
-           (size_t)count * typeInfo->size);
+  src_data = POINTER_OFFSET(src_data, src_offset);
+  dst_data = POINTER_OFFSET(dst_data, dst_offset);
+
+  if (count <= CUSTOMDATA_COPY_CHUNK_SIZE) {
+    customdata_copy_data_layer_chunk(typeInfo, src_data, dst_data, count);
+    return;
   }
+
+  /* Copy callbacks work on independent ranges of elements, so large layers can be split. This
+   * helps most for layers that allocate per element, like deform weights and displacements. */
+  CustomDataCopyLayerData data = {
+      .typeInfo = typeInfo,
+      .src_data = src_data,
+      .dst_data = dst_data,
+      .count = count,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0,
+                          divide_ceil_u(count, CUSTOMDATA_COPY_CHUNK_SIZE),
+                          &data,
+                          customdata_copy_data_layer_cb,
+                          &settings);
 }
 
 void CustomData_copy_data_named(
@@ -4292,6 +4346,46 @@ int CustomData_layertype_layers_max(const int type)
   return typeInfo->layers_max();
 }
 
+/**
+ * Add the type, name and contents of all layers to \a mm2, so changes to the data can be
+ * detected without keeping a copy around.
+ *
+ * \return False when a layer stores data that can't be hashed (e.g. pointers to other data).
+ */
+bool CustomData_hash_mm2a(const CustomData *data, int totelem, BLI_HashMurmur2A *mm2)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+
+    BLI_hash_mm2a_add_int(mm2, layer->type);
+    BLI_hash_mm2a_add_int(mm2, layer->flag);
+    BLI_hash_mm2a_add(mm2, (const uchar *)layer->name, strlen(layer->name));
+
+    if (layer->data == NULL) {
+      continue;
+    }
+    if (layer->type == CD_MDEFORMVERT) {
+      const MDeformVert *dvert = layer->data;
+      for (int j = 0; j < totelem; j++) {
+        BLI_hash_mm2a_add_int(mm2, dvert[j].totweight);
+        if (dvert[j].dw) {
+          BLI_hash_mm2a_add(
+              mm2, (const uchar *)dvert[j].dw, sizeof(*dvert[j].dw) * (size_t)dvert[j].totweight);
+        }
+      }
+    }
+    else if (typeInfo->free != NULL) {
+      /* Layers that need freeing reference other allocations. */
+      return false;
+    }
+    else {
+      BLI_hash_mm2a_add(mm2, layer->data, (size_t)typeInfo->size * (size_t)totelem);
+    }
+  }
+  return true;
+}
+
 static bool cd_layer_find_dupe(CustomData *data, const char *name, int type, int index)
 {
   /* see if there is a duplicate */
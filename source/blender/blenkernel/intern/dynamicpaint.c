@@ -855,6 +855,21 @@ static void surfaceGenerateGrid(struct DynamicPaintSurface *surface)
   }
 }
 
+/* Move an existing grid along with a canvas that was only translated,
+ * point to cell assignment stays the same. */
+static void surfaceTranslateGrid(VolumeGrid *grid, const float offset[3])
+{
+  const int grid_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
+
+  add_v3_v3(grid->grid_bounds.min, offset);
+  add_v3_v3(grid->grid_bounds.max, offset);
+
+  for (int i = 0; i < grid_cells; i++) {
+    add_v3_v3(grid->bounds[i].min, offset);
+    add_v3_v3(grid->bounds[i].max, offset);
+  }
+}
+
 /***************************** Freeing data ******************************/
 
 /* Free brush data */
@@ -5061,6 +5076,8 @@ typedef struct DynamicPaintEffectData {
   float *force;
   ListBase *effectors;
   const void *prevPoint;
+  /** Output points of double buffered effects, initialized from prevPoint per point. */
+  void *newPoint;
   const float eff_scale;
 
   uint8_t *point_locks;
@@ -5209,6 +5226,10 @@ static void dynamic_paint_effect_spread_cb(void *__restrict userdata,
 
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
+  const PaintPoint *prevPoint = data->prevPoint;
+  PaintPoint *pPoint = &((PaintPoint *)data->newPoint)[index];
+
+  *pPoint = prevPoint[index];
 
   if (sData->adj_data->flags[index] & ADJ_BORDER_PIXEL) {
     return;
@@ -5216,8 +5237,6 @@ static void dynamic_paint_effect_spread_cb(void *__restrict userdata,
 
   const int numOfNeighs = sData->adj_data->n_num[index];
   BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  PaintPoint *pPoint = &((PaintPoint *)sData->type_data)[index];
-  const PaintPoint *prevPoint = data->prevPoint;
   const float eff_scale = data->eff_scale;
 
   const int *n_index = sData->adj_data->n_index;
@@ -5268,6 +5287,10 @@ static void dynamic_paint_effect_shrink_cb(void *__restrict userdata,
 
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
+  const PaintPoint *prevPoint = data->prevPoint;
+  PaintPoint *pPoint = &((PaintPoint *)data->newPoint)[index];
+
+  *pPoint = prevPoint[index];
 
   if (sData->adj_data->flags[index] & ADJ_BORDER_PIXEL) {
     return;
@@ -5275,8 +5298,6 @@ static void dynamic_paint_effect_shrink_cb(void *__restrict userdata,
 
   const int numOfNeighs = sData->adj_data->n_num[index];
   BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  PaintPoint *pPoint = &((PaintPoint *)sData->type_data)[index];
-  const PaintPoint *prevPoint = data->prevPoint;
   const float eff_scale = data->eff_scale;
   float totalAlpha = 0.0f;
 
@@ -5447,12 +5468,16 @@ static void dynamic_paint_effect_drip_cb(void *__restrict userdata,
   }
 }
 
+/**
+ * Spread and shrink write into the spare \a r_prevPoint buffer and then swap it with the surface
+ * data, so the previous state doesn't have to be copied for them.
+ */
 static void dynamicPaint_doEffectStep(
     DynamicPaintSurface *surface,
     /* Cannot be const, because it is assigned to non-const variable.
      * NOLINTNEXTLINE: readability-non-const-parameter. */
     float *force,
-    PaintPoint *prevPoint,
+    PaintPoint **r_prevPoint,
     float timescale,
     float steps)
 {
@@ -5471,13 +5496,13 @@ static void dynamicPaint_doEffectStep(
   if (surface->effect & MOD_DPAINT_EFFECT_DO_SPREAD) {
     const float eff_scale = distance_scale * EFF_MOVEMENT_PER_FRAME * surface->spread_speed *
                             timescale;
+    PaintPoint *curPoint = sData->type_data;
 
-    /* Copy current surface to the previous points array to read unmodified values */
-    memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(struct PaintPoint));
-
+    /* Read unmodified values from the current surface, write the result to the spare buffer */
     DynamicPaintEffectData data = {
         .surface = surface,
-        .prevPoint = prevPoint,
+        .prevPoint = curPoint,
+        .newPoint = *r_prevPoint,
         .eff_scale = eff_scale,
     };
     TaskParallelSettings settings;
@@ -5485,6 +5510,9 @@ static void dynamicPaint_doEffectStep(
     settings.use_threading = (sData->total_points > 1000);
     BLI_task_parallel_range(
         0, sData->total_points, &data, dynamic_paint_effect_spread_cb, &settings);
+
+    sData->type_data = *r_prevPoint;
+    *r_prevPoint = curPoint;
   }
 
   /*
@@ -5493,13 +5521,13 @@ static void dynamicPaint_doEffectStep(
   if (surface->effect & MOD_DPAINT_EFFECT_DO_SHRINK) {
     const float eff_scale = distance_scale * EFF_MOVEMENT_PER_FRAME * surface->shrink_speed *
                             timescale;
+    PaintPoint *curPoint = sData->type_data;
 
-    /* Copy current surface to the previous points array to read unmodified values */
-    memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(struct PaintPoint));
-
+    /* Read unmodified values from the current surface, write the result to the spare buffer */
     DynamicPaintEffectData data = {
         .surface = surface,
-        .prevPoint = prevPoint,
+        .prevPoint = curPoint,
+        .newPoint = *r_prevPoint,
         .eff_scale = eff_scale,
     };
     TaskParallelSettings settings;
@@ -5507,6 +5535,9 @@ static void dynamicPaint_doEffectStep(
     settings.use_threading = (sData->total_points > 1000);
     BLI_task_parallel_range(
         0, sData->total_points, &data, dynamic_paint_effect_shrink_cb, &settings);
+
+    sData->type_data = *r_prevPoint;
+    *r_prevPoint = curPoint;
   }
 
   /*
@@ -5519,7 +5550,10 @@ static void dynamicPaint_doEffectStep(
     const size_t point_locks_size = (sData->total_points / 8) + 1;
     uint8_t *point_locks = MEM_callocN(sizeof(*point_locks) * point_locks_size, __func__);
 
-    /* Copy current surface to the previous points array to read unmodified values */
+    PaintPoint *prevPoint = *r_prevPoint;
+
+    /* Drip writes to neighboring points, so copy current surface to the previous points array to
+     * read unmodified values */
     memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(struct PaintPoint));
 
     DynamicPaintEffectData data = {
@@ -5892,7 +5926,11 @@ static void dynamic_paint_surface_pre_step_cb(void *__restrict userdata,
   }
 }
 
-static bool dynamicPaint_surfaceHasMoved(DynamicPaintSurface *surface, Object *ob)
+/* Check whether the surface moved since the previous step. When it did, r_translated is set if
+ * the mesh kept its shape and the object matrix only changed its translation. */
+static bool dynamicPaint_surfaceHasMoved(DynamicPaintSurface *surface,
+                                         Object *ob,
+                                         bool *r_translated)
 {
   PaintSurfaceData *sData = surface->data;
   PaintBakeData *bData = sData->bData;
@@ -5901,12 +5939,9 @@ static bool dynamicPaint_surfaceHasMoved(DynamicPaintSurface *surface, Object *o
 
   int numOfVerts = mesh->totvert;
 
-  if (!bData->prev_verts) {
-    return true;
-  }
+  *r_translated = false;
 
-  /* matrix comparison */
-  if (!equals_m4m4(bData->prev_obmat, ob->obmat)) {
+  if (!bData->prev_verts) {
     return true;
   }
 
@@ -5917,6 +5952,18 @@ static bool dynamicPaint_surfaceHasMoved(DynamicPaintSurface *surface, Object *o
     }
   }
 
+  /* matrix comparison */
+  if (!equals_m4m4(bData->prev_obmat, ob->obmat)) {
+    *r_translated = equals_v3v3(bData->prev_obmat[0], ob->obmat[0]) &&
+                    equals_v3v3(bData->prev_obmat[1], ob->obmat[1]) &&
+                    equals_v3v3(bData->prev_obmat[2], ob->obmat[2]) &&
+                    bData->prev_obmat[0][3] == ob->obmat[0][3] &&
+                    bData->prev_obmat[1][3] == ob->obmat[1][3] &&
+                    bData->prev_obmat[2][3] == ob->obmat[2][3] &&
+                    bData->prev_obmat[3][3] == ob->obmat[3][3];
+    return true;
+  }
+
   return false;
 }
 
@@ -6059,9 +6106,13 @@ static bool dynamicPaint_generateBakeData(DynamicPaintSurface *surface,
   int canvasNumOfVerts = mesh->totvert;
   MVert *mvert = mesh->mvert;
   Vec3f *canvas_verts;
+  /* Grid and adjacency data can be moved along when the canvas only translates. */
+  bool reuse_grid = false;
+  float grid_offset[3];
 
   if (bData) {
-    const bool surface_moved = dynamicPaint_surfaceHasMoved(surface, ob);
+    bool surface_translated;
+    const bool surface_moved = dynamicPaint_surfaceHasMoved(surface, ob, &surface_translated);
 
     /* get previous speed for accelertaion */
     if (do_accel_data && bData->prev_velocity && bData->velocity) {
@@ -6077,6 +6128,12 @@ static bool dynamicPaint_generateBakeData(DynamicPaintSurface *surface,
     if (!surface_moved) {
       return true;
     }
+
+    if (surface_translated && bData->grid &&
+        (bData->bNeighs || !surface_usesAdjDistance(surface) || !sData->adj_data)) {
+      sub_v3_v3v3(grid_offset, ob->obmat[3], bData->prev_obmat[3]);
+      reuse_grid = true;
+    }
   }
 
   canvas_verts = (struct Vec3f *)MEM_mallocN(canvasNumOfVerts * sizeof(struct Vec3f),
@@ -6174,10 +6231,16 @@ static bool dynamicPaint_generateBakeData(DynamicPaintSurface *surface,
 
   MEM_freeN(canvas_verts);
 
-  /* generate surface space partitioning grid */
-  surfaceGenerateGrid(surface);
-  /* calculate current frame adjacency point distances and global dirs */
-  dynamicPaint_prepareAdjacencyData(surface, false);
+  if (reuse_grid) {
+    /* point distances and directions don't change with translation, only move the grid */
+    surfaceTranslateGrid(bData->grid, grid_offset);
+  }
+  else {
+    /* generate surface space partitioning grid */
+    surfaceGenerateGrid(surface);
+    /* calculate current frame adjacency point distances and global dirs */
+    dynamicPaint_prepareAdjacencyData(surface, false);
+  }
 
   /* Copy current frame vertices to check against in next frame */
   copy_m4_m4(bData->prev_obmat, ob->obmat);
@@ -6348,7 +6411,7 @@ static int dynamicPaint_doStep(Depsgraph *depsgraph,
       /* Prepare effects and get number of required steps */
       steps = dynamicPaint_prepareEffectStep(depsgraph, surface, scene, ob, &force, timescale);
       for (s = 0; s < steps; s++) {
-        dynamicPaint_doEffectStep(surface, force, prevPoint, timescale, (float)steps);
+        dynamicPaint_doEffectStep(surface, force, &prevPoint, timescale, (float)steps);
       }
 
       /* Free temporary effect data */
@@ -39,11 +39,19 @@
 #include "BKE_mesh_wrapper.h"
 #include "BKE_object.h"
 
+typedef struct EditMeshEvalInput {
+  /** Result of #BM_mesh_bm_to_me_for_eval, without deformation by modifiers. */
+  Mesh *mesh;
+  /** Only vertex coordinates changed since the last evaluation. */
+  bool coords_only;
+} EditMeshEvalInput;
+
 BMEditMesh *BKE_editmesh_create(BMesh *bm, const bool do_tessellate)
 {
   BMEditMesh *em = MEM_callocN(sizeof(BMEditMesh), __func__);
 
   em->bm = bm;
+  em->eval_input = MEM_callocN(sizeof(*em->eval_input), __func__);
   if (do_tessellate) {
     BKE_editmesh_looptri_calc(em);
   }
@@ -58,6 +66,7 @@ BMEditMesh *BKE_editmesh_copy(BMEditMesh *em)
 
   em_copy->mesh_eval_cage = em_copy->mesh_eval_final = NULL;
   em_copy->bb_cage = NULL;
+  em_copy->eval_input = MEM_callocN(sizeof(*em_copy->eval_input), __func__);
 
   em_copy->bm = BM_mesh_copy(em->bm);
 
@@ -170,11 +179,91 @@ void BKE_editmesh_free(BMEditMesh *em)
     MEM_freeN(em->looptris);
   }
 
+  if (em->eval_input) {
+    if (em->eval_input->mesh) {
+      BKE_id_free(NULL, em->eval_input->mesh);
+    }
+    MEM_freeN(em->eval_input);
+  }
+
   if (em->bm) {
     BM_mesh_free(em->bm);
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Stack Input
+ *
+ * While transforming, only the vertex coordinates of the edit-mesh change, so the mesh
+ * the modifier stack converts the edit-mesh to can be kept and updated, instead of converting
+ * the whole #BMesh again for every update.
+ * \{ */
+
+/**
+ * Tag that the only changes to \a em until its next evaluation are the vertex coordinates
+ * (and normals), so the conversion to a mesh of the previous evaluation can be reused.
+ * Clearing the tag makes the next evaluation release the kept mesh.
+ */
+void BKE_editmesh_tag_coords_only_update(BMEditMesh *em, const bool coords_only)
+{
+  if (em->eval_input) {
+    em->eval_input->coords_only = coords_only;
+  }
+}
+
+bool BKE_editmesh_eval_input_use_cache(const BMEditMesh *em)
+{
+  return em->eval_input && em->eval_input->coords_only;
+}
+
+/**
+ * \return The edit-mesh converted to a mesh, owned by the caller.
+ * Only to be used when #BKE_editmesh_eval_input_use_cache returns true.
+ */
+Mesh *BKE_editmesh_eval_input_mesh_get(BMEditMesh *em, const Mesh *me_settings)
+{
+  EditMeshEvalInput *input = em->eval_input;
+  BMesh *bm = em->bm;
+  BLI_assert(BKE_editmesh_eval_input_use_cache(em));
+
+  if (input->mesh != NULL) {
+    const Mesh *me = input->mesh;
+    if (me->totvert != bm->totvert || me->totedge != bm->totedge ||
+        me->totloop != bm->totloop || me->totpoly != bm->totface) {
+      BKE_id_free(NULL, input->mesh);
+      input->mesh = NULL;
+    }
+  }
+
+  if (input->mesh == NULL) {
+    input->mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, NULL, me_settings);
+  }
+  else {
+    BM_mesh_bm_to_me_for_eval_vert_coords(bm, input->mesh);
+  }
+
+  return BKE_mesh_copy_for_eval(input->mesh, false);
+}
+
+/**
+ * Called at the end of the evaluation of \a em, releases the kept mesh when it can't be used
+ * for the next evaluation.
+ */
+void BKE_editmesh_eval_input_update_end(BMEditMesh *em)
+{
+  EditMeshEvalInput *input = em->eval_input;
+  if (input == NULL) {
+    return;
+  }
+  if (!input->coords_only && input->mesh != NULL) {
+    BKE_id_free(NULL, input->mesh);
+    input->mesh = NULL;
+  }
+  input->coords_only = false;
+}
+
+/** \} */
+
 struct CageUserData {
   int totvert;
   float (*cos_cage)[3];
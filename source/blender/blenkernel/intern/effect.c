@@ -147,16 +147,23 @@ void BKE_partdeflect_free(PartDeflect *pd)
 
 /******************** EFFECTOR RELATIONS ***********************/
 
-static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
+static void effector_random_reset(struct Depsgraph *depsgraph, PartDeflect *pd)
 {
   float ctime = DEG_get_ctime(depsgraph);
   uint cfra = (uint)(ctime >= 0 ? ctime : -ctime);
-  if (!eff->pd->rng) {
-    eff->pd->rng = BLI_rng_new(eff->pd->seed + cfra);
+  if (!pd->rng) {
+    pd->rng = BLI_rng_new(pd->seed + cfra);
   }
   else {
-    BLI_rng_srandom(eff->pd->rng, eff->pd->seed + cfra);
+    BLI_rng_srandom(pd->rng, pd->seed + cfra);
   }
+}
+
+static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
+{
+  float ctime = DEG_get_ctime(depsgraph);
+
+  effector_random_reset(depsgraph, eff->pd);
 
   if (eff->pd->forcefield == PFIELD_GUIDE && eff->ob->type == OB_CURVE) {
     Curve *cu = eff->ob->data;
@@ -324,6 +331,20 @@ ListBase *BKE_effectors_create(Depsgraph *depsgraph,
   return effectors;
 }
 
+/**
+ * Reset the random number generators of the effectors to the state they have right after
+ * #BKE_effectors_create, so an effector list can be reused for several objects that are each
+ * expected to see the same noise.
+ */
+void BKE_effectors_reset_random(Depsgraph *depsgraph, ListBase *effectors)
+{
+  if (effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+      effector_random_reset(depsgraph, eff->pd);
+    }
+  }
+}
+
 void BKE_effectors_free(ListBase *lb)
 {
   if (lb) {
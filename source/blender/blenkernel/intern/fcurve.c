@@ -1760,6 +1760,45 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Find the keyframe index for evaluation in between the first and the last keyframe, with the same
+ * result as #BKE_fcurve_bezt_binarysearch_index_ex for the given threshold. The segment found by
+ * the previous evaluation and the one following it are tried before doing the binary search.
+ */
+static int fcurve_bezt_segment_index(FCurve *fcu,
+                                     BezTriple *bezts,
+                                     float evaltime,
+                                     float threshold,
+                                     bool *r_exact)
+{
+  const int totvert = (int)fcu->totvert;
+  /* Actions can be shared between data-blocks which are evaluated from multiple threads, so the
+   * hint may be written concurrently. It is only ever used after checking it. */
+  const int hint = fcu->segment_hint;
+  for (int index = hint; index <= hint + 1; index++) {
+    if (index < 1 || index >= totvert) {
+      continue;
+    }
+    const float prev_frame = bezts[index - 1].vec[1][0];
+    const float frame = bezts[index].vec[1][0];
+    if (prev_frame < evaltime && evaltime < frame && !IS_EQT(evaltime, prev_frame, threshold)) {
+      /* The binary search reports the closest keyframe within the threshold as exact. */
+      *r_exact = IS_EQT(evaltime, frame, threshold);
+      if (index != hint) {
+        fcu->segment_hint = index;
+      }
+      return index;
+    }
+  }
+
+  const int index = BKE_fcurve_bezt_binarysearch_index_ex(
+      bezts, evaltime, totvert, threshold, r_exact);
+  if (index != hint) {
+    fcu->segment_hint = index;
+  }
+  return index;
+}
+
 static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -1779,7 +1818,7 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  a = fcurve_bezt_segment_index(fcu, bezts, evaltime, 0.0001f, &exact);
   bezt = bezts + a;
 
   if (exact) {
@@ -2082,17 +2121,15 @@ static float fcurve_eval_samples(FCurve *fcu, FPoint *fpts, float evaltime)
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * Note: this is also used for drivers.
  */
-static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_with_storage(FModifiersStackStorage *storage,
+                                          FCurve *fcu,
+                                          float evaltime,
+                                          float cvalue)
 {
   float devaltime;
 
   /* Evaluate modifiers which modify time to evaluate the base curve at. */
-  FModifiersStackStorage storage;
-  storage.modifier_count = BLI_listbase_count(&fcu->modifiers);
-  storage.size_per_modifier = evaluate_fmodifiers_storage_size_per_modifier(&fcu->modifiers);
-  storage.buffer = alloca(storage.modifier_count * storage.size_per_modifier);
-
-  devaltime = evaluate_time_fmodifiers(&storage, &fcu->modifiers, fcu, cvalue, evaltime);
+  devaltime = evaluate_time_fmodifiers(storage, &fcu->modifiers, fcu, cvalue, evaltime);
 
   /* Evaluate curve-data
    * - 'devaltime' instead of 'evaltime', as this is the time that the last time-modifying
@@ -2106,7 +2143,7 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
   }
 
   /* Evaluate modifiers. */
-  evaluate_value_fmodifiers(&storage, &fcu->modifiers, fcu, &cvalue, devaltime);
+  evaluate_value_fmodifiers(storage, &fcu->modifiers, fcu, &cvalue, devaltime);
 
   /* If curve can only have integral values, perform truncation (i.e. drop the decimal part)
    * here so that the curve can be sampled correctly.
@@ -2118,6 +2155,16 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
   return cvalue;
 }
 
+static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
+{
+  FModifiersStackStorage storage;
+  storage.modifier_count = BLI_listbase_count(&fcu->modifiers);
+  storage.size_per_modifier = evaluate_fmodifiers_storage_size_per_modifier(&fcu->modifiers);
+  storage.buffer = alloca(storage.modifier_count * storage.size_per_modifier);
+
+  return evaluate_fcurve_with_storage(&storage, fcu, evaltime, cvalue);
+}
+
 float evaluate_fcurve(FCurve *fcu, float evaltime)
 {
   BLI_assert(fcu->driver == NULL);
@@ -2125,6 +2172,28 @@ float evaluate_fcurve(FCurve *fcu, float evaltime)
   return evaluate_fcurve_ex(fcu, evaltime, 0.0);
 }
 
+/**
+ * Evaluate the F-Curve at multiple times, same as calling #evaluate_fcurve for each of them.
+ * Modifier storage is set up once for all of them, and consecutive times in increasing order
+ * benefit most from the cached keyframe segment lookup.
+ */
+void BKE_fcurve_evaluate_times(FCurve *fcu,
+                               const float *evaltimes,
+                               float *r_values,
+                               const int times_num)
+{
+  BLI_assert(fcu->driver == NULL);
+
+  FModifiersStackStorage storage;
+  storage.modifier_count = BLI_listbase_count(&fcu->modifiers);
+  storage.size_per_modifier = evaluate_fmodifiers_storage_size_per_modifier(&fcu->modifiers);
+  storage.buffer = alloca(storage.modifier_count * storage.size_per_modifier);
+
+  for (int i = 0; i < times_num; i++) {
+    r_values[i] = evaluate_fcurve_with_storage(&storage, fcu, evaltimes[i], 0.0f);
+  }
+}
+
 float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
 {
   /* Can be used to evaluate the (keyframed) fcurve only.
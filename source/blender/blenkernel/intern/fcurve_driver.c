@@ -59,6 +59,9 @@ static ThreadMutex python_driver_lock = BLI_MUTEX_INITIALIZER;
 #endif
 
 static CLG_LogRef LOG = {"bke.fcurve"};
+/* Reports drivers which can not use the simple expression evaluator, and need Python (which
+ * serializes evaluation on the GIL). */
+static CLG_LogRef LOG_PYTHON_FALLBACK = {"bke.fcurve.driver_python_fallback"};
 
 /* -------------------------------------------------------------------- */
 /** \name Driver Variables
@@ -1064,6 +1067,12 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
   if (atomic_cas_ptr((void **)&driver->expr_simple, NULL, expr) != NULL) {
     BLI_expr_pylike_free(expr);
   }
+  else if (!BLI_expr_pylike_is_valid(expr) && driver->expression[0] != '\0') {
+    CLOG_INFO(&LOG_PYTHON_FALLBACK,
+              1,
+              "driver expression is evaluated with Python: '%s'",
+              driver->expression);
+  }
 
   return true;
 }
@@ -1256,6 +1265,15 @@ static void evaluate_driver_python(PathResolvedRNA *anim_rna,
   else if (!driver_try_evaluate_simple_expr(
                driver, driver_orig, &driver->curval, anim_eval_context->eval_time)) {
 #ifdef WITH_PYTHON
+    /* Only the expression itself needs Python. Variables which are not passed to Python as RNA
+     * values are evaluated before taking the lock, so other depsgraph threads evaluating Python
+     * drivers don't have to wait for them. */
+    LISTBASE_FOREACH (DriverVar *, dvar, &driver->variables) {
+      if (dvar->type != DVAR_TYPE_SINGLE_PROP) {
+        driver_get_variable_value(driver, dvar);
+      }
+    }
+
     /* This evaluates the expression using Python, and returns its result:
      * - on errors it reports, then returns 0.0f. */
     BLI_mutex_lock(&python_driver_lock);
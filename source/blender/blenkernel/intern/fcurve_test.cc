@@ -212,6 +212,49 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 8; i++) {
+    insert_vert_fcurve(fcu, i, i * i, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  }
+
+  /* Evaluate with a hint left by an evaluation in another segment, and compare with a fresh
+   * lookup. Also test within the binary search threshold of the keys. */
+  const float times[] = {0.5f, 6.5f, 6.99995f, 1.00005f, 3.0f, 2.5f, 3.5f, 4.5f, 0.25f};
+  for (const float time : times) {
+    for (int hint = -1; hint <= 8; hint++) {
+      fcu->segment_hint = 0;
+      const float expected = evaluate_fcurve(fcu, time);
+      fcu->segment_hint = hint;
+      EXPECT_NEAR(evaluate_fcurve(fcu, time), expected, EPSILON);
+    }
+  }
+
+  BKE_fcurve_free(fcu);
+}
+
+TEST(evaluate_fcurve, EvaluateTimes)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  insert_vert_fcurve(fcu, 1.0f, 7.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  insert_vert_fcurve(fcu, 2.0f, 13.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  insert_vert_fcurve(fcu, 3.0f, 19.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  insert_vert_fcurve(fcu, 5.0f, 11.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+
+  constexpr int times_num = 9;
+  const float times[times_num] = {0.0f, 1.25f, 1.5f, 2.0f, 2.75f, 4.0f, 4.5f, 1.75f, 6.0f};
+  float values[times_num];
+  BKE_fcurve_evaluate_times(fcu, times, values, times_num);
+  for (int i = 0; i < times_num; i++) {
+    EXPECT_NEAR(values[i], evaluate_fcurve(fcu, times[i]), EPSILON);
+  }
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
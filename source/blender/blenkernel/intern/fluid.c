@@ -2229,66 +2229,49 @@ static void emit_from_mesh(
 /** \name Fluid Step
  * \{ */
 
-static void adaptive_domain_adjust(
-    FluidDomainSettings *fds, Object *ob, FluidObjectBB *bb_maps, uint numflowobj, float dt)
-{
-  /* calculate domain shift for current frame */
-  int new_shift[3] = {0};
-  int total_shift[3];
-  float frame_shift_f[3];
-  float ob_loc[3] = {0};
+/* Number of x columns in one parallel task of the adaptive domain bounds scan. */
+#define ADAPTIVE_DOMAIN_SLAB_SIZE 4
 
-  mul_m4_v3(ob->obmat, ob_loc);
-
-  sub_v3_v3v3(frame_shift_f, ob_loc, fds->prev_loc);
-  copy_v3_v3(fds->prev_loc, ob_loc);
-  /* convert global space shift to local "cell" space */
-  mul_mat3_m4_v3(fds->imat, frame_shift_f);
-  frame_shift_f[0] = frame_shift_f[0] / fds->cell_size[0];
-  frame_shift_f[1] = frame_shift_f[1] / fds->cell_size[1];
-  frame_shift_f[2] = frame_shift_f[2] / fds->cell_size[2];
-  /* add to total shift */
-  add_v3_v3(fds->shift_f, frame_shift_f);
-  /* convert to integer */
-  total_shift[0] = (int)(floorf(fds->shift_f[0]));
-  total_shift[1] = (int)(floorf(fds->shift_f[1]));
-  total_shift[2] = (int)(floorf(fds->shift_f[2]));
-  int temp_shift[3];
-  copy_v3_v3_int(temp_shift, fds->shift);
-  sub_v3_v3v3_int(new_shift, total_shift, fds->shift);
-  copy_v3_v3_int(fds->shift, total_shift);
+typedef struct AdaptiveDomainBounds {
+  int min[3], max[3];
+  float min_vel[3], max_vel[3];
+} AdaptiveDomainBounds;
 
-  /* calculate new domain boundary points so that smoke doesn't slide on sub-cell movement */
-  fds->p0[0] = fds->dp0[0] - fds->cell_size[0] * (fds->shift_f[0] - total_shift[0] - 0.5f);
-  fds->p0[1] = fds->dp0[1] - fds->cell_size[1] * (fds->shift_f[1] - total_shift[1] - 0.5f);
-  fds->p0[2] = fds->dp0[2] - fds->cell_size[2] * (fds->shift_f[2] - total_shift[2] - 0.5f);
-  fds->p1[0] = fds->p0[0] + fds->cell_size[0] * fds->base_res[0];
-  fds->p1[1] = fds->p0[1] + fds->cell_size[1] * fds->base_res[1];
-  fds->p1[2] = fds->p0[2] + fds->cell_size[2] * fds->base_res[2];
+typedef struct AdaptiveDomainBoundsData {
+  FluidDomainSettings *fds;
+  const int *new_shift;
+  const float *density, *fuel, *bigdensity, *bigfuel;
+  const float *vx, *vy, *vz;
+  int wt_res[3];
+  int block_size;
+  AdaptiveDomainBounds *slabs;
+} AdaptiveDomainBoundsData;
 
-  /* adjust domain resolution */
-  const int block_size = fds->noise_scale;
-  int min[3] = {32767, 32767, 32767}, max[3] = {-32767, -32767, -32767}, res[3];
-  int total_cells = 1, res_changed = 0, shift_changed = 0;
-  float min_vel[3], max_vel[3];
+static void adaptive_domain_bounds_slab(void *__restrict userdata,
+                                        const int slab_index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AdaptiveDomainBoundsData *data = userdata;
+  FluidDomainSettings *fds = data->fds;
+  const int *new_shift = data->new_shift;
+  const float *density = data->density, *fuel = data->fuel;
+  const float *bigdensity = data->bigdensity, *bigfuel = data->bigfuel;
+  const float *vx = data->vx, *vy = data->vy, *vz = data->vz;
+  const int *wt_res = data->wt_res;
+  const int block_size = data->block_size;
+  AdaptiveDomainBounds *slab = &data->slabs[slab_index];
+  int *min = slab->min, *max = slab->max;
+  float *min_vel = slab->min_vel, *max_vel = slab->max_vel;
   int x, y, z;
-  float *density = manta_smoke_get_density(fds->fluid);
-  float *fuel = manta_smoke_get_fuel(fds->fluid);
-  float *bigdensity = manta_noise_get_density(fds->fluid);
-  float *bigfuel = manta_noise_get_fuel(fds->fluid);
-  float *vx = manta_get_velocity_x(fds->fluid);
-  float *vy = manta_get_velocity_y(fds->fluid);
-  float *vz = manta_get_velocity_z(fds->fluid);
-  int wt_res[3];
 
-  if (fds->flags & FLUID_DOMAIN_USE_NOISE && fds->fluid) {
-    manta_noise_get_res(fds->fluid, wt_res);
-  }
+  const int x_start = fds->res_min[0] + slab_index * ADAPTIVE_DOMAIN_SLAB_SIZE;
+  const int x_end = MIN2(x_start + ADAPTIVE_DOMAIN_SLAB_SIZE, fds->res_max[0]);
 
   INIT_MINMAX(min_vel, max_vel);
+  copy_vn_i(min, 3, 32767);
+  copy_vn_i(max, 3, -32767);
 
-  /* Calculate bounds for current domain content */
-  for (x = fds->res_min[0]; x < fds->res_max[0]; x++) {
+  for (x = x_start; x < x_end; x++) {
     for (y = fds->res_min[1]; y < fds->res_max[1]; y++) {
       for (z = fds->res_min[2]; z < fds->res_max[2]; z++) {
         int xn = x - new_shift[0];
@@ -2376,6 +2359,103 @@ static void adaptive_domain_adjust(
       }
     }
   }
+}
+
+static void adaptive_domain_adjust(
+    FluidDomainSettings *fds, Object *ob, FluidObjectBB *bb_maps, uint numflowobj, float dt)
+{
+  /* calculate domain shift for current frame */
+  int new_shift[3] = {0};
+  int total_shift[3];
+  float frame_shift_f[3];
+  float ob_loc[3] = {0};
+
+  mul_m4_v3(ob->obmat, ob_loc);
+
+  sub_v3_v3v3(frame_shift_f, ob_loc, fds->prev_loc);
+  copy_v3_v3(fds->prev_loc, ob_loc);
+  /* convert global space shift to local "cell" space */
+  mul_mat3_m4_v3(fds->imat, frame_shift_f);
+  frame_shift_f[0] = frame_shift_f[0] / fds->cell_size[0];
+  frame_shift_f[1] = frame_shift_f[1] / fds->cell_size[1];
+  frame_shift_f[2] = frame_shift_f[2] / fds->cell_size[2];
+  /* add to total shift */
+  add_v3_v3(fds->shift_f, frame_shift_f);
+  /* convert to integer */
+  total_shift[0] = (int)(floorf(fds->shift_f[0]));
+  total_shift[1] = (int)(floorf(fds->shift_f[1]));
+  total_shift[2] = (int)(floorf(fds->shift_f[2]));
+  int temp_shift[3];
+  copy_v3_v3_int(temp_shift, fds->shift);
+  sub_v3_v3v3_int(new_shift, total_shift, fds->shift);
+  copy_v3_v3_int(fds->shift, total_shift);
+
+  /* calculate new domain boundary points so that smoke doesn't slide on sub-cell movement */
+  fds->p0[0] = fds->dp0[0] - fds->cell_size[0] * (fds->shift_f[0] - total_shift[0] - 0.5f);
+  fds->p0[1] = fds->dp0[1] - fds->cell_size[1] * (fds->shift_f[1] - total_shift[1] - 0.5f);
+  fds->p0[2] = fds->dp0[2] - fds->cell_size[2] * (fds->shift_f[2] - total_shift[2] - 0.5f);
+  fds->p1[0] = fds->p0[0] + fds->cell_size[0] * fds->base_res[0];
+  fds->p1[1] = fds->p0[1] + fds->cell_size[1] * fds->base_res[1];
+  fds->p1[2] = fds->p0[2] + fds->cell_size[2] * fds->base_res[2];
+
+  /* adjust domain resolution */
+  const int block_size = fds->noise_scale;
+  int min[3] = {32767, 32767, 32767}, max[3] = {-32767, -32767, -32767}, res[3];
+  int total_cells = 1, res_changed = 0, shift_changed = 0;
+  float min_vel[3], max_vel[3];
+  int x, y, z;
+  float *density = manta_smoke_get_density(fds->fluid);
+  float *fuel = manta_smoke_get_fuel(fds->fluid);
+  float *bigdensity = manta_noise_get_density(fds->fluid);
+  float *bigfuel = manta_noise_get_fuel(fds->fluid);
+  float *vx = manta_get_velocity_x(fds->fluid);
+  float *vy = manta_get_velocity_y(fds->fluid);
+  float *vz = manta_get_velocity_z(fds->fluid);
+  int wt_res[3];
+
+  if (fds->flags & FLUID_DOMAIN_USE_NOISE && fds->fluid) {
+    manta_noise_get_res(fds->fluid, wt_res);
+  }
+
+  INIT_MINMAX(min_vel, max_vel);
+
+  /* Calculate bounds for current domain content, in slabs along x that are scanned in parallel
+   * and merged afterwards. */
+  AdaptiveDomainBoundsData data = {
+      .fds = fds,
+      .new_shift = new_shift,
+      .density = density,
+      .fuel = fuel,
+      .bigdensity = bigdensity,
+      .bigfuel = bigfuel,
+      .vx = vx,
+      .vy = vy,
+      .vz = vz,
+      .block_size = block_size,
+  };
+  copy_v3_v3_int(data.wt_res, wt_res);
+
+  const int num_slabs = (fds->res_max[0] - fds->res_min[0] + ADAPTIVE_DOMAIN_SLAB_SIZE - 1) /
+                        ADAPTIVE_DOMAIN_SLAB_SIZE;
+  if (num_slabs > 0) {
+    data.slabs = MEM_malloc_arrayN(num_slabs, sizeof(*data.slabs), __func__);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, num_slabs, &data, adaptive_domain_bounds_slab, &settings);
+
+    for (int i = 0; i < num_slabs; i++) {
+      const AdaptiveDomainBounds *slab = &data.slabs[i];
+      for (int j = 0; j < 3; j++) {
+        min[j] = MIN2(min[j], slab->min[j]);
+        max[j] = MAX2(max[j], slab->max[j]);
+        min_vel[j] = MIN2(min_vel[j], slab->min_vel[j]);
+        max_vel[j] = MAX2(max_vel[j], slab->max_vel[j]);
+      }
+    }
+
+    MEM_freeN(data.slabs);
+  }
 
   /* also apply emission maps */
   for (int i = 0; i < numflowobj; i++) {
@@ -29,6 +29,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -731,6 +732,91 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
  * \param scene: Current scene
  * \param ob: Grease pencil object
  */
+typedef struct GpencilDeformStroke {
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke *gps;
+} GpencilDeformStroke;
+
+typedef struct GpencilDeformStrokesData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  GpencilDeformStroke *strokes;
+} GpencilDeformStrokesData;
+
+static void gpencil_deform_strokes_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilDeformStrokesData *data = userdata;
+  GpencilDeformStroke *stroke = &data->strokes[i];
+
+  data->mti->deformStroke(
+      data->md, data->depsgraph, data->ob, stroke->gpl, stroke->gpf, stroke->gps);
+}
+
+/* Apply a deform modifier to the strokes of the evaluated frame of every layer. Strokes are
+ * deformed independently of each other, so all strokes of all layers are done in parallel. */
+static void gpencil_deform_strokes(GpencilModifierData *md,
+                                   const GpencilModifierTypeInfo *mti,
+                                   Depsgraph *depsgraph,
+                                   Scene *scene,
+                                   Object *ob)
+{
+  bGPdata *gpd = (bGPdata *)ob->data;
+  const int totlayers = BLI_listbase_count(&gpd->layers);
+  if (totlayers == 0) {
+    return;
+  }
+
+  bGPDframe **frames = MEM_malloc_arrayN(totlayers, sizeof(*frames), __func__);
+  int totstrokes = 0;
+  int l = 0;
+
+  LISTBASE_FOREACH_INDEX (bGPDlayer *, gpl, &gpd->layers, l) {
+    frames[l] = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
+    if (frames[l] != NULL && mti && mti->deformStroke) {
+      totstrokes += BLI_listbase_count(&frames[l]->strokes);
+    }
+  }
+
+  if (totstrokes > 0) {
+    GpencilDeformStroke *strokes = MEM_malloc_arrayN(totstrokes, sizeof(*strokes), __func__);
+    int i = 0;
+
+    LISTBASE_FOREACH_INDEX (bGPDlayer *, gpl, &gpd->layers, l) {
+      if (frames[l] == NULL) {
+        continue;
+      }
+      LISTBASE_FOREACH (bGPDstroke *, gps, &frames[l]->strokes) {
+        strokes[i].gpl = gpl;
+        strokes[i].gpf = frames[l];
+        strokes[i].gps = gps;
+        i++;
+      }
+    }
+
+    GpencilDeformStrokesData data = {
+        .md = md,
+        .mti = mti,
+        .depsgraph = depsgraph,
+        .ob = ob,
+        .strokes = strokes,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (totstrokes > 16);
+    BLI_task_parallel_range(0, totstrokes, &data, gpencil_deform_strokes_cb, &settings);
+
+    MEM_freeN(strokes);
+  }
+
+  MEM_freeN(frames);
+}
+
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
@@ -766,18 +852,7 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 
       /* Apply deform modifiers and Time remap (only change geometry). */
       if ((time_remap) || (mti && mti->deformStroke)) {
-        LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
-          bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
-          if (gpf == NULL) {
-            continue;
-          }
-
-          if (mti->deformStroke) {
-            LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-              mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
-            }
-          }
-        }
+        gpencil_deform_strokes(md, mti, depsgraph, scene, ob);
       }
     }
   }
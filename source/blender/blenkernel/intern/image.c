@@ -169,6 +169,9 @@ static void image_free_data(ID *id)
 {
   Image *image = (Image *)id;
 
+  /* The background loading task may still be using the image. */
+  BKE_image_gpu_load_cancel(image);
+
   /* Also frees animdata. */
   BKE_image_free_buffers(image);
 
@@ -24,8 +24,11 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_boxpack_2d.h"
+#include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
+#include "BLI_rect.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "DNA_image_types.h"
@@ -140,10 +143,47 @@ static int compare_packtile(const void *a, const void *b)
   return tile_a->pack_score < tile_b->pack_score;
 }
 
+/**
+ * Number of times the tiles resolution is halved so that the tile array fits in the video memory
+ * that is still available. Without this, scenes with many high resolution UDIM tiles fail to
+ * allocate the array or make the driver swap textures in and out of video memory on every draw.
+ */
+static int tile_array_downscale_level(const ListBase *boxes, const bool use_high_bitdepth)
+{
+  if (!GPU_mem_stats_supported()) {
+    return 0;
+  }
+  int totalmem_kb, freemem_kb;
+  GPU_mem_stats_get(&totalmem_kb, &freemem_kb);
+  if (freemem_kb <= 0) {
+    return 0;
+  }
+
+  /* Leave room for the other textures and buffers of the scene. */
+  const double budget = (double)freemem_kb * 1024.0 * 0.5;
+  /* RGBA8 or RGBA16F, and a third more for the mipmaps. */
+  const double texel_size = (use_high_bitdepth ? 8.0 : 4.0) * (4.0 / 3.0);
+
+  double size = 0.0;
+  int min_size = INT_MAX;
+  LISTBASE_FOREACH (const PackTile *, packtile, boxes) {
+    size += (double)packtile->boxpack.w * (double)packtile->boxpack.h * texel_size;
+    min_size = min_iii(min_size, packtile->boxpack.w, packtile->boxpack.h);
+  }
+
+  int level = 0;
+  while (size > budget && (min_size >> level) > 1) {
+    size *= 0.25;
+    level++;
+  }
+  return level;
+}
+
 static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 {
   int arraywidth = 0, arrayheight = 0;
   ListBase boxes = {NULL};
+  const bool use_high_bitdepth = (ima->flag & IMA_HIGH_BITDEPTH);
 
   LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
     ImageUser iuser;
@@ -161,19 +201,32 @@ static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
         packtile->boxpack.w = smaller_power_of_2_limit(packtile->boxpack.w);
         packtile->boxpack.h = smaller_power_of_2_limit(packtile->boxpack.h);
       }
-      arraywidth = max_ii(arraywidth, packtile->boxpack.w);
-      arrayheight = max_ii(arrayheight, packtile->boxpack.h);
-
-      /* We sort the tiles by decreasing size, with an additional penalty term
-       * for high aspect ratios. This improves packing efficiency. */
-      float w = packtile->boxpack.w, h = packtile->boxpack.h;
-      packtile->pack_score = max_ff(w, h) / min_ff(w, h) * w * h;
 
       BKE_image_release_ibuf(ima, ibuf, NULL);
       BLI_addtail(&boxes, packtile);
     }
   }
 
+  const int downscale_level = tile_array_downscale_level(&boxes, use_high_bitdepth);
+  if (downscale_level > 0 && (G.debug & G_DEBUG_GPU)) {
+    printf("%s: %s tiles downscaled %d times to fit in video memory\n",
+           __func__,
+           ima->id.name + 2,
+           downscale_level);
+  }
+
+  LISTBASE_FOREACH (PackTile *, packtile, &boxes) {
+    packtile->boxpack.w = max_ii(1, packtile->boxpack.w >> downscale_level);
+    packtile->boxpack.h = max_ii(1, packtile->boxpack.h >> downscale_level);
+    arraywidth = max_ii(arraywidth, packtile->boxpack.w);
+    arrayheight = max_ii(arrayheight, packtile->boxpack.h);
+
+    /* We sort the tiles by decreasing size, with an additional penalty term
+     * for high aspect ratios. This improves packing efficiency. */
+    float w = packtile->boxpack.w, h = packtile->boxpack.h;
+    packtile->pack_score = max_ff(w, h) / min_ff(w, h) * w * h;
+  }
+
   BLI_assert(arraywidth > 0 && arrayheight > 0);
 
   BLI_listbase_sort(&boxes, compare_packtile);
@@ -200,7 +253,6 @@ static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
     arraylayers++;
   }
 
-  const bool use_high_bitdepth = (ima->flag & IMA_HIGH_BITDEPTH);
   /* Create Texture without content. */
   GPUTexture *tex = IMB_touch_gpu_texture(
       ima->id.name + 2, main_ibuf, arraywidth, arrayheight, arraylayers, use_high_bitdepth);
@@ -355,16 +407,27 @@ static GPUTexture *image_get_gpu_texture(Image *ima,
     const bool store_premultiplied = BKE_image_has_gpu_texture_premultiplied_alpha(ima,
                                                                                    ibuf_intern);
 
-    *tex = IMB_create_gpu_texture(
-        ima->id.name + 2, ibuf_intern, use_high_bitdepth, store_premultiplied);
+    /* Compressed textures are created with all their mipmaps. */
+    if ((U.gpu_flag & USER_GPU_FLAG_TEXTURE_COMPRESSION) &&
+        (ima->gpuflag & IMA_GPU_NO_COMPRESSION) == 0) {
+      *tex = IMB_create_gpu_texture_compressed(
+          ima->id.name + 2, ibuf_intern, store_premultiplied);
+      if (*tex != NULL) {
+        ima->gpuflag |= IMA_GPU_COMPRESSED;
+      }
+    }
+    if (*tex == NULL) {
+      *tex = IMB_create_gpu_texture(
+          ima->id.name + 2, ibuf_intern, use_high_bitdepth, store_premultiplied);
+    }
 
     GPU_texture_wrap_mode(*tex, true, false);
 
     if (GPU_mipmap_enabled()) {
-      GPU_texture_generate_mipmap(*tex);
-      if (ima) {
-        ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+      if ((ima->gpuflag & IMA_GPU_COMPRESSED) == 0) {
+        GPU_texture_generate_mipmap(*tex);
       }
+      ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
       GPU_texture_mipmap_mode(*tex, true, true);
     }
     else {
@@ -399,6 +462,168 @@ GPUTexture *BKE_image_get_gpu_tilemap(Image *image, ImageUser *iuser, ImBuf *ibu
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Asynchronous image loading
+ *
+ * Decoding image files is by far the most expensive part of creating their GPU textures. To avoid
+ * blocking the UI while drawing, the draw manager can ask for the image buffer to be loaded in a
+ * background task and draw a placeholder until it is available. The texture upload itself still
+ * happens on the drawing thread, as it requires the OpenGL context.
+ * \{ */
+
+typedef struct ImageLoadTask {
+  Image *ima;
+  ImageUser iuser;
+  bool use_iuser;
+  /** Both protected by #image_load_mutex. */
+  bool is_cancelled;
+  bool is_running;
+} ImageLoadTask;
+
+static TaskPool *image_load_pool = NULL;
+/** Pending #ImageLoadTask, keyed by image. */
+static GHash *image_load_tasks = NULL;
+static ThreadMutex image_load_mutex = BLI_MUTEX_INITIALIZER;
+static ThreadCondition image_load_cond;
+
+static void image_load_task_run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ImageLoadTask *task = taskdata;
+
+  BLI_mutex_lock(&image_load_mutex);
+  if (task->is_cancelled) {
+    BLI_mutex_unlock(&image_load_mutex);
+    return;
+  }
+  task->is_running = true;
+  BLI_mutex_unlock(&image_load_mutex);
+
+  /* Loading the buffer stores it in the image cache, where the drawing code will find it. */
+  ImageUser *iuser = task->use_iuser ? &task->iuser : NULL;
+  ImBuf *ibuf = BKE_image_acquire_ibuf(task->ima, iuser, NULL);
+  BKE_image_release_ibuf(task->ima, ibuf, NULL);
+
+  BLI_mutex_lock(&image_load_mutex);
+  BLI_ghash_remove(image_load_tasks, task->ima, NULL, NULL);
+  task->is_running = false;
+  BLI_condition_notify_all(&image_load_cond);
+  BLI_mutex_unlock(&image_load_mutex);
+}
+
+/**
+ * Start loading the image buffer of \a ima in a background task if it is needed to create its
+ * GPU texture.
+ *
+ * \return True while the image is being loaded, in that case #BKE_image_get_gpu_texture would
+ * block and the caller should draw a placeholder instead. False when the GPU texture can be
+ * created without loading the image file.
+ */
+bool BKE_image_gpu_texture_load_async(Image *ima, ImageUser *iuser)
+{
+  /* Only single image files, other sources are either generated or depend on the frame. */
+  if (ima == NULL || ima->source != IMA_SRC_FILE || ima->type != IMA_TYPE_IMAGE) {
+    return false;
+  }
+  if ((ima->gpuflag & IMA_GPU_REFRESH) == 0 &&
+      (ima->gputexture[TEXTARGET_2D][0] != NULL || ima->gputexture[TEXTARGET_2D][1] != NULL)) {
+    return false;
+  }
+  ImageTile *tile = BKE_image_get_tile(ima, 0);
+  if (tile == NULL || tile->ok == 0) {
+    return false;
+  }
+  if (BKE_image_has_loaded_ibuf(ima)) {
+    return false;
+  }
+
+  BLI_mutex_lock(&image_load_mutex);
+  if (image_load_pool == NULL) {
+    image_load_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+    image_load_tasks = BLI_ghash_ptr_new(__func__);
+    BLI_condition_init(&image_load_cond);
+  }
+  if (!BLI_ghash_haskey(image_load_tasks, ima)) {
+    ImageLoadTask *task = MEM_callocN(sizeof(*task), __func__);
+    task->ima = ima;
+    if (iuser != NULL) {
+      task->iuser = *iuser;
+      task->use_iuser = true;
+    }
+    BLI_ghash_insert(image_load_tasks, ima, task);
+    BLI_task_pool_push(image_load_pool, image_load_task_run, task, true, NULL);
+  }
+  BLI_mutex_unlock(&image_load_mutex);
+
+  return true;
+}
+
+/**
+ * Cancel the background loading of \a ima, waiting for it to finish when it already started.
+ * Must be called before freeing the image data.
+ */
+void BKE_image_gpu_load_cancel(Image *ima)
+{
+  if (image_load_pool == NULL) {
+    return;
+  }
+
+  BLI_mutex_lock(&image_load_mutex);
+  ImageLoadTask *task = BLI_ghash_lookup(image_load_tasks, ima);
+  if (task != NULL) {
+    if (task->is_running) {
+      while (BLI_ghash_lookup(image_load_tasks, ima) == task) {
+        BLI_condition_wait(&image_load_cond, &image_load_mutex);
+      }
+    }
+    else {
+      task->is_cancelled = true;
+      BLI_ghash_remove(image_load_tasks, ima, NULL, NULL);
+    }
+  }
+  BLI_mutex_unlock(&image_load_mutex);
+}
+
+/**
+ * \return The number of images waiting for their buffer to be loaded. Engines with progressive
+ * accumulation compare it between redraws to restart when an image finished loading.
+ */
+int BKE_image_gpu_load_pending_len(void)
+{
+  if (image_load_pool == NULL) {
+    return 0;
+  }
+
+  BLI_mutex_lock(&image_load_mutex);
+  const int len = (int)BLI_ghash_len(image_load_tasks);
+  BLI_mutex_unlock(&image_load_mutex);
+  return len;
+}
+
+void BKE_image_gpu_load_exit(void)
+{
+  if (image_load_pool == NULL) {
+    return;
+  }
+
+  BLI_mutex_lock(&image_load_mutex);
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, image_load_tasks) {
+    ImageLoadTask *task = BLI_ghashIterator_getValue(&gh_iter);
+    task->is_cancelled = true;
+  }
+  BLI_mutex_unlock(&image_load_mutex);
+
+  /* Waits for the running tasks. */
+  BLI_task_pool_cancel(image_load_pool);
+  BLI_task_pool_free(image_load_pool);
+  BLI_ghash_free(image_load_tasks, NULL, NULL);
+  BLI_condition_end(&image_load_cond);
+  image_load_pool = NULL;
+  image_load_tasks = NULL;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Delayed GPU texture free
  *
@@ -457,7 +682,7 @@ static void image_free_gpu(Image *ima, const bool immediate)
     }
   }
 
-  ima->gpuflag &= ~IMA_GPU_MIPMAP_COMPLETE;
+  ima->gpuflag &= ~(IMA_GPU_MIPMAP_COMPLETE | IMA_GPU_COMPRESSED);
 }
 
 void BKE_image_free_gputextures(Image *ima)
@@ -735,7 +960,12 @@ static void gpu_texture_update_from_ibuf(
   if (rect_float && rect_float != ibuf->rect_float) {
     MEM_freeN(rect_float);
   }
+}
 
+/* Call once after all regions of the texture are updated, generating the mipmaps is much
+ * slower than updating small regions. */
+static void gpu_texture_update_finish(GPUTexture *tex, Image *ima)
+{
   if (GPU_mipmap_enabled()) {
     GPU_texture_generate_mipmap(tex);
   }
@@ -749,25 +979,67 @@ static void gpu_texture_update_from_ibuf(
 /* Partial update of texture for texture painting. This is often much
  * quicker than fully updating the texture for high resolution images. */
 void BKE_image_update_gputexture(Image *ima, ImageUser *iuser, int x, int y, int w, int h)
+{
+  rcti region;
+  BLI_rcti_init(&region, x, x + w, y, y + h);
+  BKE_image_update_gputexture_regions(ima, iuser, &region, 1);
+}
+
+/* Same as #BKE_image_update_gputexture for multiple regions of the same image, the image buffer
+ * is acquired and the mipmaps are generated only once for all of them. */
+void BKE_image_update_gputexture_regions(Image *ima,
+                                         ImageUser *iuser,
+                                         const rcti *regions,
+                                         int regions_len)
 {
   ImBuf *ibuf = BKE_image_acquire_ibuf(ima, iuser, NULL);
   ImageTile *tile = BKE_image_get_tile_from_iuser(ima, iuser);
 
-  if ((ibuf == NULL) || (w == 0) || (h == 0)) {
+  bool is_empty = true;
+  for (int i = 0; i < regions_len; i++) {
+    if (!BLI_rcti_is_empty(&regions[i])) {
+      is_empty = false;
+      break;
+    }
+  }
+
+  if ((ibuf == NULL) || is_empty) {
     /* Full reload of texture. */
     BKE_image_free_gputextures(ima);
   }
-
-  GPUTexture *tex = ima->gputexture[TEXTARGET_2D][0];
-  /* Check if we need to update the main gputexture. */
-  if (tex != NULL && tile == ima->tiles.first) {
-    gpu_texture_update_from_ibuf(tex, ima, ibuf, NULL, x, y, w, h);
+  else if (ima->gpuflag & IMA_GPU_COMPRESSED) {
+    /* Compressed textures can't be partially updated, use an uncompressed one from now on. */
+    BKE_image_free_gputextures(ima);
+    ima->gpuflag |= IMA_GPU_NO_COMPRESSION;
   }
 
-  /* Check if we need to update the array gputexture. */
-  tex = ima->gputexture[TEXTARGET_2D_ARRAY][0];
-  if (tex != NULL) {
-    gpu_texture_update_from_ibuf(tex, ima, ibuf, tile, x, y, w, h);
+  /* Check if we need to update the main gputexture, and the array gputexture. */
+  GPUTexture *textures[2] = {
+      (tile == ima->tiles.first) ? ima->gputexture[TEXTARGET_2D][0] : NULL,
+      ima->gputexture[TEXTARGET_2D_ARRAY][0],
+  };
+  ImageTile *texture_tiles[2] = {NULL, tile};
+
+  for (int t = 0; t < ARRAY_SIZE(textures); t++) {
+    GPUTexture *tex = textures[t];
+    if (tex == NULL) {
+      continue;
+    }
+    for (int i = 0; i < regions_len; i++) {
+      const rcti *region = &regions[i];
+      if (BLI_rcti_is_empty(region)) {
+        continue;
+      }
+      gpu_texture_update_from_ibuf(tex,
+                                   ima,
+                                   ibuf,
+                                   texture_tiles[t],
+                                   region->xmin,
+                                   region->ymin,
+                                   BLI_rcti_size_x(region),
+                                   BLI_rcti_size_y(region));
+    }
+    gpu_texture_update_finish(tex, ima);
   }
 
   BKE_image_release_ibuf(ima, ibuf, NULL);
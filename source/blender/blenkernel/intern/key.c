@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -907,7 +908,7 @@ static void key_evaluate_relative(const int start,
       if (!(kb->flag & KEYBLOCK_MUTE) && icuval != 0.0f && kb->totelem == tot) {
         KeyBlock *refb;
         float weight,
-            *weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : NULL;
+            *weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] + start : NULL;
         char *freefrom = NULL;
 
         /* reference now can be any block */
@@ -1381,6 +1382,34 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* Number of vertices evaluated by each task, small enough to keep the output in cache while
+ * all the key-blocks are accumulated. */
+#define KEY_MESH_RELATIVE_CHUNK_SIZE 4096
+
+typedef struct MeshKeyRelativeData {
+  Key *key;
+  KeyBlock *actkb;
+  char *out;
+  float **per_keyblock_weights;
+  int tot;
+} MeshKeyRelativeData;
+
+static void do_mesh_key_relative_task(void *__restrict userdata,
+                                      const int chunk,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshKeyRelativeData *data = userdata;
+  const int start = chunk * KEY_MESH_RELATIVE_CHUNK_SIZE;
+  key_evaluate_relative(start,
+                        start + KEY_MESH_RELATIVE_CHUNK_SIZE,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1391,8 +1420,31 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    /* In edit-mode the data of the active key-block is copied from the edit-mesh for each
+     * call, keep a single range there. */
+    const Mesh *me = (const Mesh *)key->from;
+    if (tot > KEY_MESH_RELATIVE_CHUNK_SIZE && me != NULL && me->edit_mesh == NULL) {
+      MeshKeyRelativeData data = {
+          .key = key,
+          .actkb = actkb,
+          .out = out,
+          .per_keyblock_weights = per_keyblock_weights,
+          .tot = tot,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(0,
+                              (tot + KEY_MESH_RELATIVE_CHUNK_SIZE - 1) /
+                                  KEY_MESH_RELATIVE_CHUNK_SIZE,
+                              &data,
+                              do_mesh_key_relative_task,
+                              &settings);
+    }
+    else {
+      key_evaluate_relative(
+          0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    }
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
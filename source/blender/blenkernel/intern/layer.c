@@ -718,27 +718,10 @@ static void layer_collection_sync(ViewLayer *view_layer,
    * For local edits we can make editing operating do the appropriate thing, but for
    * linking we can only sync after the fact. */
 
-  /* Remove layer collections that no longer have a corresponding scene collection. */
-  LISTBASE_FOREACH_MUTABLE (LayerCollection *, lc, lb_layer_collections) {
-    /* Note that ID remap can set lc->collection to NULL when deleting collections. */
-    Collection *collection = (lc->collection) ?
-                                 BLI_findptr(lb_collections,
-                                             lc->collection,
-                                             offsetof(CollectionChild, collection)) :
-                                 NULL;
-
-    if (!collection) {
-      if (lc == view_layer->active_collection) {
-        view_layer->active_collection = NULL;
-      }
-
-      /* Free recursively. */
-      layer_collection_free(view_layer, lc);
-      BLI_freelinkN(lb_layer_collections, lc);
-    }
-  }
-
-  /* Add layer collections for any new scene collections, and ensure order is the same. */
+  /* Add layer collections for any new scene collections, and ensure order is the same.
+   * Existing layer collections are moved to the new list as they are found. When the order did
+   * not change, the one found is always the first remaining one, so this stays linear in the
+   * number of collections. */
   ListBase new_lb_layer = {NULL, NULL};
 
   LISTBASE_FOREACH (const CollectionChild *, child, lb_collections) {
@@ -853,6 +836,15 @@ static void layer_collection_sync(ViewLayer *view_layer,
     }
   }
 
+  /* Remove layer collections that no longer have a corresponding scene collection, those are the
+   * ones that were not moved to the new list.
+   * Note that ID remap can set lc->collection to NULL when deleting collections. */
+  LISTBASE_FOREACH_MUTABLE (LayerCollection *, lc, lb_layer_collections) {
+    /* Free recursively. */
+    layer_collection_free(view_layer, lc);
+    BLI_freelinkN(lb_layer_collections, lc);
+  }
+
   /* Replace layer collection list with new one. */
   *lb_layer_collections = new_lb_layer;
   BLI_assert(BLI_listbase_count(lb_collections) == BLI_listbase_count(lb_layer_collections));
@@ -28,6 +28,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 
 #include "BKE_anim_data.h"
@@ -288,15 +289,22 @@ static void id_delete(Main *bmain, const bool do_tagged_deletion)
         dummy_link.next = tagged_deleted_ids.first;
         last_remapped_id = (ID *)(&dummy_link);
       }
+      /* Will tag 'never NULL' users of these IDs too.
+       * Note that we cannot use BKE_libblock_unlink() here,
+       * since it would ignore indirect (and proxy!)
+       * links, this can lead to nasty crashing here in second, actual deleting loop.
+       * Also, this will also flag users of deleted data that cannot be unlinked
+       * (object using deleted obdata, etc.), so that they also get deleted.
+       * All IDs removed from Main in this iteration are unlinked at once, in a single pass over
+       * the remaining IDs of Main. */
+      GHash *old_to_new_ids = BLI_ghash_ptr_new(__func__);
+      for (id = last_remapped_id->next; id; id = id->next) {
+        BLI_ghash_insert(old_to_new_ids, id, NULL);
+      }
+      BKE_libblock_remap_multiple_locked(
+          bmain, old_to_new_ids, ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE);
+      BLI_ghash_free(old_to_new_ids, NULL, NULL);
       for (id = last_remapped_id->next; id; id = id->next) {
-        /* Will tag 'never NULL' users of this ID too.
-         * Note that we cannot use BKE_libblock_unlink() here,
-         * since it would ignore indirect (and proxy!)
-         * links, this can lead to nasty crashing here in second, actual deleting loop.
-         * Also, this will also flag users of deleted data that cannot be unlinked
-         * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(
-            bmain, id, NULL, ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE);
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
         BKE_libblock_relink_ex(bmain, id, NULL, NULL, 0);
@@ -749,6 +749,9 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
     return success;
   }
 
+  /* Old override IDs are all remapped to their new overrides at once. */
+  GHash *old_to_new_overrides = BLI_ghash_ptr_new(__func__);
+
   ListBase *lb;
   FOREACH_MAIN_LISTBASE_BEGIN (bmain, lb) {
     FOREACH_MAIN_LISTBASE_ID_BEGIN (lb, id) {
@@ -769,9 +772,7 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
            * IDs, which are always *after* all local ones, and we only affect local IDs. */
           BLI_listbase_swaplinks(lb, id_override_old, id_override_new);
 
-          /* Remap the whole local IDs to use the new override. */
-          BKE_libblock_remap(
-              bmain, id_override_old, id_override_new, ID_REMAP_SKIP_INDIRECT_USAGE);
+          BLI_ghash_insert(old_to_new_overrides, id_override_old, id_override_new);
 
           /* Copy over overrides rules from old override ID to new one. */
           BLI_duplicatelist(&id_override_new->override_library->properties,
@@ -790,6 +791,10 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
   }
   FOREACH_MAIN_LISTBASE_END;
 
+  /* Remap the whole local IDs to use the new overrides. */
+  BKE_libblock_remap_multiple(bmain, old_to_new_overrides, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BLI_ghash_free(old_to_new_overrides, NULL, NULL);
+
   /* We need to apply override rules in a separate loop, after all ID pointers have been properly
    * remapped, and all new local override IDs have gotten their proper original names, otherwise
    * override operations based on those ID names would fail. */
@@ -870,19 +875,21 @@ void BKE_lib_override_library_delete(Main *bmain, ID *id_root)
   /* Tag all library overrides in the chains of dependencies from the given root one. */
   BKE_lib_override_library_override_group_tag(bmain, id_root, LIB_TAG_DOIT, true);
 
+  GHash *old_to_new_ids = BLI_ghash_ptr_new(__func__);
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (id->tag & LIB_TAG_DOIT) {
       if (ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
-        ID *id_override_reference = id->override_library->reference;
-
-        /* Remap the whole local IDs to use the linked data. */
-        BKE_libblock_remap(bmain, id, id_override_reference, ID_REMAP_SKIP_INDIRECT_USAGE);
+        BLI_ghash_insert(old_to_new_ids, id, id->override_library->reference);
       }
     }
   }
   FOREACH_MAIN_ID_END;
 
+  /* Remap the whole local IDs to use the linked data. */
+  BKE_libblock_remap_multiple(bmain, old_to_new_ids, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BLI_ghash_free(old_to_new_ids, NULL, NULL);
+
   /* Delete the override IDs. */
   BKE_id_multi_tagged_delete(bmain);
 
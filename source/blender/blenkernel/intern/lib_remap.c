@@ -22,6 +22,9 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
@@ -67,6 +70,11 @@ typedef struct IDRemap {
   Main *bmain; /* Only used to trigger depsgraph updates in the right bmain. */
   ID *old_id;
   ID *new_id;
+  /**
+   * When remapping several IDs at once, maps each old ID to its own #IDRemap data, which also
+   * stores the 'output' data of that ID. NULL otherwise.
+   */
+  GHash *id_map;
   /** The ID in which we are replacing old_id by new_id usages. */
   ID *id_owner;
   short flag;
@@ -102,6 +110,18 @@ static int foreach_libblock_remap_callback(LibraryIDLinkCallbackData *cb_data)
   ID *id_self = cb_data->id_self;
   ID **id_p = cb_data->id_pointer;
   IDRemap *id_remap_data = cb_data->user_data;
+
+  if (id_remap_data->id_map != NULL) {
+    IDRemap *id_remap_data_item = (*id_p != NULL) ?
+                                      BLI_ghash_lookup(id_remap_data->id_map, *id_p) :
+                                      NULL;
+    if (id_remap_data_item == NULL) {
+      return IDWALK_RET_NOP;
+    }
+    id_remap_data_item->id_owner = id_remap_data->id_owner;
+    id_remap_data = id_remap_data_item;
+  }
+
   ID *old_id = id_remap_data->old_id;
   ID *new_id = id_remap_data->new_id;
 
@@ -242,6 +262,14 @@ static void libblock_remap_data_preprocess(IDRemap *r_id_remap_data)
   switch (GS(r_id_remap_data->id_owner->name)) {
     case ID_OB: {
       ID *old_id = r_id_remap_data->old_id;
+      if (r_id_remap_data->id_map != NULL) {
+        /* When remapping several IDs, only the object data may matter here. */
+        Object *ob = (Object *)r_id_remap_data->id_owner;
+        if (ob->data == NULL || !BLI_ghash_haskey(r_id_remap_data->id_map, ob->data)) {
+          break;
+        }
+        old_id = ob->data;
+      }
       if (!old_id || GS(old_id->name) == ID_AR) {
         Object *ob = (Object *)r_id_remap_data->id_owner;
         /* Object's pose holds reference to armature bones. sic */
@@ -345,6 +373,33 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
   ntreeUpdateAllUsers(bmain, new_id);
 }
 
+/**
+ * Update user and linking status of the old and new IDs, once all usages of \a old_id have been
+ * processed.
+ */
+static void libblock_remap_data_finalize(IDRemap *id_remap_data)
+{
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
+
+  /* XXX We may not want to always 'transfer' fake-user from old to new id...
+   *     Think for now it's desired behavior though,
+   *     we can always add an option (flag) to control this later if needed. */
+  if (old_id && (old_id->flag & LIB_FAKEUSER)) {
+    id_fake_user_clear(old_id);
+    id_fake_user_set(new_id);
+  }
+
+  id_us_clear_real(old_id);
+
+  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
+      (id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
+    new_id->tag &= ~LIB_TAG_INDIRECT;
+    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
+    new_id->tag |= LIB_TAG_EXTERN;
+  }
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -382,6 +437,7 @@ static void libblock_remap_data(
   r_id_remap_data->bmain = bmain;
   r_id_remap_data->old_id = old_id;
   r_id_remap_data->new_id = new_id;
+  r_id_remap_data->id_map = NULL;
   r_id_remap_data->id_owner = NULL;
   r_id_remap_data->flag = remap_flags;
   r_id_remap_data->status = 0;
@@ -421,22 +477,7 @@ static void libblock_remap_data(
     FOREACH_MAIN_ID_END;
   }
 
-  /* XXX We may not want to always 'transfer' fake-user from old to new id...
-   *     Think for now it's desired behavior though,
-   *     we can always add an option (flag) to control this later if needed. */
-  if (old_id && (old_id->flag & LIB_FAKEUSER)) {
-    id_fake_user_clear(old_id);
-    id_fake_user_set(new_id);
-  }
-
-  id_us_clear_real(old_id);
-
-  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
-      (r_id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
-    new_id->tag &= ~LIB_TAG_INDIRECT;
-    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
-    new_id->tag |= LIB_TAG_EXTERN;
-  }
+  libblock_remap_data_finalize(r_id_remap_data);
 
 #ifdef DEBUG_PRINT
   printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
@@ -448,21 +489,13 @@ static void libblock_remap_data(
 }
 
 /**
- * Replace all references in given Main to \a old_id by \a new_id
- * (if \a new_id is NULL, it unlinks \a old_id).
+ * Handle editors' references and user counts of an old ID once all its usages in Main have been
+ * remapped.
  */
-void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+static void libblock_remap_old_id_finalize(IDRemap *id_remap_data)
 {
-  IDRemap id_remap_data;
-  ID *old_id = old_idv;
-  ID *new_id = new_idv;
-  int skipped_direct, skipped_refcounted;
-
-  BLI_assert(old_id != NULL);
-  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
-  BLI_assert(old_id != new_id);
-
-  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
 
   if (free_notifier_reference_cb) {
     free_notifier_reference_cb(old_id);
@@ -475,14 +508,14 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     remap_editor_id_reference_cb(old_id, new_id);
   }
 
-  skipped_direct = id_remap_data.skipped_direct;
-  skipped_refcounted = id_remap_data.skipped_refcounted;
+  const int skipped_direct = id_remap_data->skipped_direct;
+  const int skipped_refcounted = id_remap_data->skipped_refcounted;
 
   /* If old_id was used by some ugly 'user_one' stuff (like Image or Clip editors...), and user
    * count has actually been incremented for that, we have to decrease once more its user count...
    * unless we had to skip some 'user_one' cases. */
   if ((old_id->tag & LIB_TAG_EXTRAUSER_SET) &&
-      !(id_remap_data.status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
+      !(id_remap_data->status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
     id_us_clear_real(old_id);
   }
 
@@ -505,6 +538,25 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
       old_id->tag |= LIB_TAG_INDIRECT;
     }
   }
+}
+
+/**
+ * Replace all references in given Main to \a old_id by \a new_id
+ * (if \a new_id is NULL, it unlinks \a old_id).
+ */
+void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+{
+  IDRemap id_remap_data;
+  ID *old_id = old_idv;
+  ID *new_id = new_idv;
+
+  BLI_assert(old_id != NULL);
+  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+  BLI_assert(old_id != new_id);
+
+  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+
+  libblock_remap_old_id_finalize(&id_remap_data);
 
   /* Some after-process updates.
    * This is a bit ugly, but cannot see a way to avoid it.
@@ -554,6 +606,174 @@ void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short r
   BKE_main_unlock(bmain);
 }
 
+/**
+ * Replace all references in given Main to each key of \a old_to_new_ids by its value
+ * (a NULL value unlinks the old ID).
+ *
+ * Same as calling #BKE_libblock_remap_locked for each old ID, but Main is only walked once, and
+ * the post-processing (collections, objects, node trees...) is also only done once. New IDs are
+ * not expected to be remapped themselves, i.e. they should not be keys of the map.
+ */
+void BKE_libblock_remap_multiple_locked(Main *bmain,
+                                        GHash *old_to_new_ids,
+                                        const short remap_flags)
+{
+  const int items_len = BLI_ghash_len(old_to_new_ids);
+  if (items_len == 0) {
+    return;
+  }
+
+  IDRemap *items = MEM_malloc_arrayN((size_t)items_len, sizeof(*items), __func__);
+  GHash *id_map = BLI_ghash_ptr_new_ex(__func__, (uint)items_len);
+  /* ID types of the old IDs, to skip IDs that cannot use any of them. */
+  short id_types[INDEX_ID_MAX];
+  int id_types_len = 0;
+
+  IDRemap *item = items;
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, old_to_new_ids) {
+    ID *old_id = BLI_ghashIterator_getKey(&gh_iter);
+    ID *new_id = BLI_ghashIterator_getValue(&gh_iter);
+    BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+    BLI_assert(new_id == NULL || !BLI_ghash_haskey(old_to_new_ids, new_id));
+
+    item->bmain = bmain;
+    item->old_id = old_id;
+    item->new_id = new_id;
+    item->id_map = NULL;
+    item->id_owner = NULL;
+    item->flag = remap_flags;
+    item->status = 0;
+    item->skipped_direct = 0;
+    item->skipped_indirect = 0;
+    item->skipped_refcounted = 0;
+    BLI_ghash_insert(id_map, old_id, item);
+    item++;
+
+    int i = 0;
+    while (i < id_types_len && id_types[i] != GS(old_id->name)) {
+      i++;
+    }
+    if (i == id_types_len) {
+      id_types[id_types_len++] = GS(old_id->name);
+    }
+  }
+
+  IDRemap id_remap_data = {.bmain = bmain, .id_map = id_map, .flag = remap_flags};
+  const int foreach_id_flags = (remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
+                                   IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
+                                   IDWALK_NOP;
+  ID *id_curr;
+  FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
+    for (int i = 0; i < id_types_len; i++) {
+      if (BKE_library_id_can_use_idtype(id_curr, id_types[i])) {
+        id_remap_data.id_owner = id_curr;
+        libblock_remap_data_preprocess(&id_remap_data);
+        BKE_library_foreach_ID_link(NULL,
+                                    id_curr,
+                                    foreach_libblock_remap_callback,
+                                    (void *)&id_remap_data,
+                                    foreach_id_flags);
+        break;
+      }
+    }
+  }
+  FOREACH_MAIN_ID_END;
+
+  bool do_object_update = false;
+  bool do_collection_unlink = false;
+  Collection *collection_relinked = NULL;
+  bool do_nodetree_unlink = false;
+  GSet *new_obdata = BLI_gset_ptr_new(__func__);
+  GSet *new_ids = BLI_gset_ptr_new(__func__);
+
+  for (int i = 0; i < items_len; i++) {
+    item = &items[i];
+    libblock_remap_data_finalize(item);
+    libblock_remap_old_id_finalize(item);
+
+    ID *new_id = item->new_id;
+    switch (GS(item->old_id->name)) {
+      case ID_OB:
+        do_object_update = true;
+        break;
+      case ID_GR:
+        if (new_id) {
+          collection_relinked = (Collection *)new_id;
+        }
+        else {
+          do_collection_unlink = true;
+        }
+        break;
+      case ID_ME:
+      case ID_CU:
+      case ID_MB:
+      case ID_HA:
+      case ID_PT:
+      case ID_VO:
+        if (new_id) {
+          BLI_gset_add(new_obdata, new_id);
+        }
+        break;
+      default:
+        break;
+    }
+
+    if (new_id) {
+      BLI_gset_add(new_ids, new_id);
+    }
+    else {
+      do_nodetree_unlink = true;
+    }
+  }
+
+  /* Same after-process updates as in #BKE_libblock_remap_locked, done once for all IDs. */
+  if (do_object_update) {
+    libblock_remap_data_postprocess_object_update(bmain, NULL, NULL);
+  }
+  if (do_collection_unlink) {
+    libblock_remap_data_postprocess_collection_update(bmain, NULL, NULL);
+  }
+  if (collection_relinked != NULL) {
+    libblock_remap_data_postprocess_collection_update(bmain, NULL, collection_relinked);
+  }
+  if (BLI_gset_len(new_obdata) != 0) {
+    for (Object *ob = bmain->objects.first; ob; ob = ob->id.next) {
+      if (ob->data != NULL && BLI_gset_haskey(new_obdata, ob->data)) {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, ob->data);
+      }
+    }
+  }
+
+  /* See #BKE_libblock_remap_locked about unlocking here. */
+  BKE_main_unlock(bmain);
+  GSET_FOREACH_BEGIN (ID *, new_id, new_ids) {
+    libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
+  }
+  GSET_FOREACH_END();
+  if (do_nodetree_unlink) {
+    libblock_remap_data_postprocess_nodetree_update(bmain, NULL);
+  }
+  BKE_main_lock(bmain);
+
+  BLI_gset_free(new_obdata, NULL);
+  BLI_gset_free(new_ids, NULL);
+  BLI_ghash_free(id_map, NULL, NULL);
+  MEM_freeN(items);
+
+  /* Full rebuild of DEG! */
+  DEG_relations_tag_update(bmain);
+}
+
+void BKE_libblock_remap_multiple(Main *bmain, GHash *old_to_new_ids, const short remap_flags)
+{
+  BKE_main_lock(bmain);
+
+  BKE_libblock_remap_multiple_locked(bmain, old_to_new_ids, remap_flags);
+
+  BKE_main_unlock(bmain);
+}
+
 /**
  * Unlink given \a id from given \a bmain
  * (does not touch to indirect, i.e. library, usages of the ID).
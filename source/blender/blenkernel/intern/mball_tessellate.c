@@ -38,6 +38,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -408,22 +409,27 @@ static float densfunc(const MetaElem *ball, float x, float y, float z)
  * Computes density at given position form all meta-balls which contain this point in their box.
  * Traverses BVH using a queue.
  */
-static float metaball(PROCESS *process, float x, float y, float z)
+/**
+ * Evaluates the field at given point, using \a bvh_queue as storage for the BVH traversal
+ * (it needs #PROCESS.bvh_queue_size elements). Can be called from several threads at once if
+ * each uses its own queue.
+ */
+static float metaball_ex(PROCESS *process, MetaballBVHNode **bvh_queue, float x, float y, float z)
 {
   float dens = 0.0f;
   unsigned int front = 0, back = 0;
   MetaballBVHNode *node;
 
-  process->bvh_queue[front++] = &process->metaball_bvh;
+  bvh_queue[front++] = &process->metaball_bvh;
 
   while (front != back) {
-    node = process->bvh_queue[back++];
+    node = bvh_queue[back++];
 
     for (int i = 0; i < 2; i++) {
       if ((node->bb[i].min[0] <= x) && (node->bb[i].max[0] >= x) && (node->bb[i].min[1] <= y) &&
           (node->bb[i].max[1] >= y) && (node->bb[i].min[2] <= z) && (node->bb[i].max[2] >= z)) {
         if (node->child[i]) {
-          process->bvh_queue[front++] = node->child[i];
+          bvh_queue[front++] = node->child[i];
         }
         else {
           dens += densfunc(node->bb[i].ml, x, y, z);
@@ -435,6 +441,11 @@ static float metaball(PROCESS *process, float x, float y, float z)
   return process->thresh - dens;
 }
 
+static float metaball(PROCESS *process, float x, float y, float z)
+{
+  return metaball_ex(process, process->bvh_queue, x, y, z);
+}
+
 /**
  * Adds face to indices, expands memory if needed.
  */
@@ -963,14 +974,57 @@ static void addtovertices(PROCESS *process, const float v[3], const float no[3])
  *
  * \note Doesn't do normalization!
  */
-static void vnormal(PROCESS *process, const float point[3], float r_no[3])
+static void vnormal(PROCESS *process,
+                    MetaballBVHNode **bvh_queue,
+                    const float point[3],
+                    float r_no[3])
 {
   const float delta = process->delta;
-  const float f = metaball(process, point[0], point[1], point[2]);
+  const float f = metaball_ex(process, bvh_queue, point[0], point[1], point[2]);
+
+  r_no[0] = metaball_ex(process, bvh_queue, point[0] + delta, point[1], point[2]) - f;
+  r_no[1] = metaball_ex(process, bvh_queue, point[0], point[1] + delta, point[2]) - f;
+  r_no[2] = metaball_ex(process, bvh_queue, point[0], point[1], point[2] + delta) - f;
+}
+
+typedef struct VertexNormalsTLSData {
+  MetaballBVHNode **bvh_queue;
+} VertexNormalsTLSData;
+
+static void vertex_normals_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict tls_v)
+{
+  PROCESS *process = userdata;
+  VertexNormalsTLSData *tls = tls_v->userdata_chunk;
+
+  if (tls->bvh_queue == NULL) {
+    tls->bvh_queue = MEM_mallocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size, __func__);
+  }
+
+  vnormal(process, tls->bvh_queue, process->co[i], process->no[i]);
+}
 
-  r_no[0] = metaball(process, point[0] + delta, point[1], point[2]) - f;
-  r_no[1] = metaball(process, point[0], point[1] + delta, point[2]) - f;
-  r_no[2] = metaball(process, point[0], point[1], point[2] + delta) - f;
+static void vertex_normals_free(const void *__restrict UNUSED(userdata), void *__restrict tls_v)
+{
+  VertexNormalsTLSData *tls = tls_v;
+  MEM_SAFE_FREE(tls->bvh_queue);
+}
+
+/**
+ * Computes normals of all vertices from the density field. This is done once polygonization is
+ * finished, so that these field evaluations (the majority of them) run in parallel.
+ */
+static void vertex_normals_calc(PROCESS *process)
+{
+  VertexNormalsTLSData tls_data = {NULL};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_free = vertex_normals_free;
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, (int)process->curvertex, process, vertex_normals_task, &settings);
 }
 #endif /* USE_ACCUM_NORMAL */
 
@@ -990,11 +1044,8 @@ static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
 
   converge(process, c1, c2, v); /* position */
 
-#ifdef USE_ACCUM_NORMAL
+  /* Normals are accumulated from faces, or computed for all vertices at the end. */
   zero_v3(no);
-#else
-  vnormal(process, v, no);
-#endif
 
   addtovertices(process, v, no); /* save vertex */
   vid = (int)process->curvertex - 1;
@@ -1442,6 +1493,9 @@ void BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob, ListBa
         ob->scale[1] > 0.00001f * (process.allbb.max[1] - process.allbb.min[1]) ||
         ob->scale[2] > 0.00001f * (process.allbb.max[2] - process.allbb.min[2])) {
       polygonize(&process);
+#ifndef USE_ACCUM_NORMAL
+      vertex_normals_calc(&process);
+#endif
 
       /* add resulting surface to displist */
       if (process.curindex) {
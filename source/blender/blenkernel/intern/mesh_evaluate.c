@@ -49,6 +49,8 @@
 #include "BKE_editmesh_cache.h"
 #include "BKE_global.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
+#include "BKE_mesh_runtime.h"
 #include "BKE_multires.h"
 #include "BKE_report.h"
 
@@ -213,6 +215,9 @@ typedef struct MeshCalcNormalsData {
   float (*pnors)[3];
   float (*lnors_weighted)[3];
   float (*vnors)[3];
+  const MeshElemMap *vert_loop_map;
+  /** Set when #vert_loop_map doesn't match the loops. */
+  bool vert_loop_map_is_invalid;
 } MeshCalcNormalsData;
 
 static void mesh_calc_normals_poly_cb(void *__restrict userdata,
@@ -305,15 +310,42 @@ static void mesh_calc_normals_poly_finalize_cb(void *__restrict userdata,
   normal_float_to_short_v3(mv->no, no);
 }
 
-void BKE_mesh_calc_normals_poly(MVert *mverts,
-                                float (*r_vertnors)[3],
-                                int numVerts,
-                                const MLoop *mloop,
-                                const MPoly *mpolys,
-                                int numLoops,
-                                int numPolys,
-                                float (*r_polynors)[3],
-                                const bool only_face_normals)
+/**
+ * Accumulate the weighted loop normals of each vertex and finalize its normal,
+ * the vertex to loop map avoids writing to the same vertex from multiple threads.
+ */
+static void mesh_calc_normals_poly_accum_finalize_cb(void *__restrict userdata,
+                                                     const int vidx,
+                                                     const TaskParallelTLS *__restrict tls)
+{
+  MeshCalcNormalsData *data = userdata;
+  const MeshElemMap *vert_loops = &data->vert_loop_map[vidx];
+  float *no = data->vnors[vidx];
+
+  zero_v3(no);
+  for (int i = 0; i < vert_loops->count; i++) {
+    const int lidx = vert_loops->indices[i];
+    if (UNLIKELY(data->mloop[lidx].v != (uint)vidx)) {
+      /* The topology changed since the map was created, the caller uses the serial path. */
+      data->vert_loop_map_is_invalid = true;
+      return;
+    }
+    add_v3_v3(no, data->lnors_weighted[lidx]);
+  }
+
+  mesh_calc_normals_poly_finalize_cb(userdata, vidx, tls);
+}
+
+static void mesh_calc_normals_poly_ex(MVert *mverts,
+                                      float (*r_vertnors)[3],
+                                      int numVerts,
+                                      const MLoop *mloop,
+                                      const MPoly *mpolys,
+                                      int numLoops,
+                                      int numPolys,
+                                      float (*r_polynors)[3],
+                                      const bool only_face_normals,
+                                      Mesh *mesh_for_vert_loop_map)
 {
   float(*pnors)[3] = r_polynors;
 
@@ -343,12 +375,9 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
 
   /* first go through and calculate normals for all the polys */
   if (vnors == NULL) {
-    vnors = MEM_calloc_arrayN((size_t)numVerts, sizeof(*vnors), __func__);
+    vnors = MEM_malloc_arrayN((size_t)numVerts, sizeof(*vnors), __func__);
     free_vnors = true;
   }
-  else {
-    memset(vnors, 0, sizeof(*vnors) * (size_t)numVerts);
-  }
 
   MeshCalcNormalsData data = {
       .mpolys = mpolys,
@@ -362,16 +391,28 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
   /* Compute poly normals, and prepare weighted loop normals. */
   BLI_task_parallel_range(0, numPolys, &data, mesh_calc_normals_poly_prepare_cb, &settings);
 
-  /* Actually accumulate weighted loop normals into vertex ones. */
-  /* Unfortunately, not possible to thread that
-   * (not in a reasonable, totally lock- and barrier-free fashion),
-   * since several loops will point to the same vertex... */
-  for (int lidx = 0; lidx < numLoops; lidx++) {
-    add_v3_v3(vnors[mloop[lidx].v], data.lnors_weighted[lidx]);
+  /* Actually accumulate weighted loop normals into vertex ones, and normalize them.
+   * Several loops point to the same vertex, so this is only threaded when the mesh keeps a map
+   * of the loops of each vertex. */
+  if (mesh_for_vert_loop_map != NULL) {
+    data.vert_loop_map = BKE_mesh_runtime_vert_loop_map_ensure(mesh_for_vert_loop_map);
+    BLI_task_parallel_range(
+        0, numVerts, &data, mesh_calc_normals_poly_accum_finalize_cb, &settings);
+    if (UNLIKELY(data.vert_loop_map_is_invalid)) {
+      BKE_mesh_runtime_vert_loop_map_clear(mesh_for_vert_loop_map);
+      data.vert_loop_map = NULL;
+    }
   }
 
-  /* Normalize and validate computed vertex normals. */
-  BLI_task_parallel_range(0, numVerts, &data, mesh_calc_normals_poly_finalize_cb, &settings);
+  if (data.vert_loop_map == NULL) {
+    memset(vnors, 0, sizeof(*vnors) * (size_t)numVerts);
+    for (int lidx = 0; lidx < numLoops; lidx++) {
+      add_v3_v3(vnors[mloop[lidx].v], data.lnors_weighted[lidx]);
+    }
+
+    /* Normalize and validate computed vertex normals. */
+    BLI_task_parallel_range(0, numVerts, &data, mesh_calc_normals_poly_finalize_cb, &settings);
+  }
 
   if (free_vnors) {
     MEM_freeN(vnors);
@@ -379,6 +420,49 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
   MEM_freeN(lnors_weighted);
 }
 
+void BKE_mesh_calc_normals_poly(MVert *mverts,
+                                float (*r_vertnors)[3],
+                                int numVerts,
+                                const MLoop *mloop,
+                                const MPoly *mpolys,
+                                int numLoops,
+                                int numPolys,
+                                float (*r_polynors)[3],
+                                const bool only_face_normals)
+{
+  mesh_calc_normals_poly_ex(mverts,
+                            r_vertnors,
+                            numVerts,
+                            mloop,
+                            mpolys,
+                            numLoops,
+                            numPolys,
+                            r_polynors,
+                            only_face_normals,
+                            NULL);
+}
+
+/**
+ * Same as #BKE_mesh_calc_normals_poly for the data of \a mesh (vertex normals are only written
+ * to the vertices). Uses the vertex to loop map kept in the mesh run-time data
+ * to accumulate vertex normals in parallel.
+ */
+void BKE_mesh_calc_normals_poly_for_mesh(Mesh *mesh,
+                                         float (*r_polynors)[3],
+                                         const bool only_face_normals)
+{
+  mesh_calc_normals_poly_ex(mesh->mvert,
+                            NULL,
+                            mesh->totvert,
+                            mesh->mloop,
+                            mesh->mpoly,
+                            mesh->totloop,
+                            mesh->totpoly,
+                            r_polynors,
+                            only_face_normals,
+                            only_face_normals ? NULL : mesh);
+}
+
 void BKE_mesh_ensure_normals(Mesh *mesh)
 {
   if (mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) {
@@ -418,15 +502,7 @@ void BKE_mesh_ensure_normals_for_display(Mesh *mesh)
     }
 
     /* calculate poly/vert normals */
-    BKE_mesh_calc_normals_poly(mesh->mvert,
-                               NULL,
-                               mesh->totvert,
-                               mesh->mloop,
-                               mesh->mpoly,
-                               mesh->totloop,
-                               mesh->totpoly,
-                               poly_nors,
-                               !do_vert_normals);
+    BKE_mesh_calc_normals_poly_for_mesh(mesh, poly_nors, !do_vert_normals);
 
     if (do_add_poly_nors_cddata) {
       CustomData_add_layer(&mesh->pdata, CD_NORMAL, CD_ASSIGN, poly_nors, mesh->totpoly);
@@ -444,15 +520,7 @@ void BKE_mesh_calc_normals(Mesh *mesh)
 #ifdef DEBUG_TIME
   TIMEIT_START_AVERAGED(BKE_mesh_calc_normals);
 #endif
-  BKE_mesh_calc_normals_poly(mesh->mvert,
-                             NULL,
-                             mesh->totvert,
-                             mesh->mloop,
-                             mesh->mpoly,
-                             mesh->totloop,
-                             mesh->totpoly,
-                             NULL,
-                             false);
+  BKE_mesh_calc_normals_poly_for_mesh(mesh, NULL, false);
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(BKE_mesh_calc_normals);
 #endif
@@ -2060,15 +2128,7 @@ static void mesh_set_custom_normals(Mesh *mesh, float (*r_custom_nors)[3], const
   bool free_polynors = false;
   if (polynors == NULL) {
     polynors = MEM_mallocN(sizeof(float[3]) * (size_t)mesh->totpoly, __func__);
-    BKE_mesh_calc_normals_poly(mesh->mvert,
-                               NULL,
-                               mesh->totvert,
-                               mesh->mloop,
-                               mesh->mpoly,
-                               mesh->totloop,
-                               mesh->totpoly,
-                               polynors,
-                               false);
+    BKE_mesh_calc_normals_poly_for_mesh(mesh, polynors, false);
     free_polynors = true;
   }
 
@@ -36,6 +36,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.h"
@@ -497,6 +498,158 @@ typedef struct IslandResult {
 /* Will be enough in 99% of cases. */
 #define MREMAP_DEFAULT_BUFSIZE 32
 
+/* -------------------------------------------------------------------- */
+/** \name Threaded BVH Queries
+ *
+ * The BVH queries are the expensive part of most mapping modes, they are done for all
+ * destination elements in parallel first. Defining the map items allocates from its memory
+ * arena, so that is done afterwards in a serial loop.
+ * \{ */
+
+/** Result of the BVH query of one destination element. */
+typedef struct MeshRemapQuery {
+  /** Query point, in the space of the source tree. */
+  float co[3];
+  /** Nearest or hit point on the source. */
+  float hit_co[3];
+  float hit_dist;
+  /** Index of the nearest or hit tree element, -1 when there is no source. */
+  int index;
+} MeshRemapQuery;
+
+typedef struct MeshRemapQueryData {
+  BVHTreeFromMesh *treedata;
+  const SpaceTransform *space_transform;
+  /* Query points and ray directions (only used for ray-casting), in destination space. */
+  const float (*cos)[3];
+  const float (*nos)[3];
+  /* Alternatively, use vertices of the destination mesh. */
+  const MVert *verts;
+
+  bool use_raycast;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+
+  MeshRemapQuery *queries;
+} MeshRemapQueryData;
+
+static void mesh_remap_query_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict tls)
+{
+  MeshRemapQueryData *data = userdata;
+  MeshRemapQuery *query = &data->queries[i];
+  float no[3];
+
+  if (data->verts) {
+    copy_v3_v3(query->co, data->verts[i].co);
+    if (data->use_raycast) {
+      normal_short_to_float_v3(no, data->verts[i].no);
+    }
+  }
+  else {
+    copy_v3_v3(query->co, data->cos[i]);
+    if (data->use_raycast) {
+      copy_v3_v3(no, data->nos[i]);
+    }
+  }
+
+  /* Convert the point to tree coordinates, if needed. */
+  if (data->space_transform) {
+    BLI_space_transform_apply(data->space_transform, query->co);
+    if (data->use_raycast) {
+      BLI_space_transform_apply_normal(data->space_transform, no);
+    }
+  }
+
+  query->index = -1;
+  query->hit_dist = FLT_MAX;
+
+  if (data->use_raycast) {
+    BVHTreeRayHit rayhit = {0};
+    if (mesh_remap_bvhtree_query_raycast(data->treedata,
+                                         &rayhit,
+                                         query->co,
+                                         no,
+                                         data->ray_radius,
+                                         data->max_dist,
+                                         &query->hit_dist)) {
+      query->index = rayhit.index;
+      copy_v3_v3(query->hit_co, rayhit.co);
+    }
+  }
+  else {
+    /* Thread local, so the proximity heuristic of the nearest query still applies. */
+    BVHTreeNearest *nearest = tls->userdata_chunk;
+    if (mesh_remap_bvhtree_query_nearest(
+            data->treedata, nearest, query->co, data->max_dist_sq, &query->hit_dist)) {
+      query->index = nearest->index;
+      copy_v3_v3(query->hit_co, nearest->co);
+    }
+  }
+}
+
+static MeshRemapQuery *mesh_remap_query_ex(MeshRemapQueryData *data, const int items_num)
+{
+  data->queries = MEM_malloc_arrayN((size_t)items_num, sizeof(*data->queries), __func__);
+  data->max_dist_sq = data->max_dist * data->max_dist;
+
+  BVHTreeNearest nearest = {0};
+  nearest.index = -1;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  settings.userdata_chunk = &nearest;
+  settings.userdata_chunk_size = sizeof(nearest);
+
+  BLI_task_parallel_range(0, items_num, data, mesh_remap_query_cb, &settings);
+
+  return data->queries;
+}
+
+static MeshRemapQuery *mesh_remap_verts_query(BVHTreeFromMesh *treedata,
+                                              const SpaceTransform *space_transform,
+                                              const MVert *verts_dst,
+                                              const int numverts_dst,
+                                              const bool use_raycast,
+                                              const float max_dist,
+                                              const float ray_radius)
+{
+  MeshRemapQueryData data = {
+      .treedata = treedata,
+      .space_transform = space_transform,
+      .verts = verts_dst,
+      .use_raycast = use_raycast,
+      .max_dist = max_dist,
+      .ray_radius = ray_radius,
+  };
+  return mesh_remap_query_ex(&data, numverts_dst);
+}
+
+static MeshRemapQuery *mesh_remap_points_query(BVHTreeFromMesh *treedata,
+                                               const SpaceTransform *space_transform,
+                                               const float (*cos)[3],
+                                               const float (*nos)[3],
+                                               const int points_num,
+                                               const float max_dist,
+                                               const float ray_radius)
+{
+  MeshRemapQueryData data = {
+      .treedata = treedata,
+      .space_transform = space_transform,
+      .cos = cos,
+      .nos = nos,
+      .use_raycast = (nos != NULL),
+      .max_dist = max_dist,
+      .ray_radius = ray_radius,
+  };
+  return mesh_remap_query_ex(&data, points_num);
+}
+
+/** \} */
+
 void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -508,7 +661,6 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          MeshPairRemap *r_map)
 {
   const float full_weight = 1.0f;
-  const float max_dist_sq = max_dist * max_dist;
   int i;
 
   BLI_assert(mode & MREMAP_MODE_VERT);
@@ -523,59 +675,46 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
+      MeshRemapQuery *queries = mesh_remap_verts_query(
+          &treedata, space_transform, verts_dst, numverts_dst, false, max_dist, ray_radius);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+        const MeshRemapQuery *query = &queries[i];
+        if (query->index != -1) {
+          mesh_remap_item_define(r_map, i, query->hit_dist, 0, 1, &query->index, &full_weight);
         }
         else {
           /* No source for this dest vertex! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(queries);
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
+      MeshRemapQuery *queries = mesh_remap_verts_query(
+          &treedata, space_transform, verts_dst, numverts_dst, false, max_dist, ray_radius);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+        const MeshRemapQuery *query = &queries[i];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
+        if (query->index != -1) {
+          MEdge *me = &edges_src[query->index];
           const float *v1cos = vcos_src[me->v1];
           const float *v2cos = vcos_src[me->v2];
 
           if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+            const float dist_v1 = len_squared_v3v3(query->co, v1cos);
+            const float dist_v2 = len_squared_v3v3(query->co, v2cos);
             const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
+            mesh_remap_item_define(r_map, i, query->hit_dist, 0, 1, &index, &full_weight);
           }
           else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
             int indices[2];
@@ -585,11 +724,11 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             indices[1] = (int)me->v2;
 
             /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+            weights[0] = line_point_factor_v3(query->co, v2cos, v1cos);
             CLAMP(weights[0], 0.0f, 1.0f);
             weights[1] = 1.0f - weights[0];
 
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
+            mesh_remap_item_define(r_map, i, query->hit_dist, 0, 2, indices, weights);
           }
         }
         else {
@@ -598,6 +737,7 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
         }
       }
 
+      MEM_freeN(queries);
       MEM_freeN(vcos_src);
     }
     else if (ELEM(mode,
@@ -614,26 +754,42 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       float *weights = MEM_mallocN(sizeof(*weights) * tmp_buff_size, __func__);
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+      MeshRemapQuery *queries = mesh_remap_verts_query(&treedata,
+                                                       space_transform,
+                                                       verts_dst,
+                                                       numverts_dst,
+                                                       mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ,
+                                                       max_dist,
+                                                       ray_radius);
 
-      if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-          normal_short_to_float_v3(tmp_no, verts_dst[i].no);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
+      for (i = 0; i < numverts_dst; i++) {
+        const MeshRemapQuery *query = &queries[i];
+
+        if (query->index != -1) {
+          const MLoopTri *lt = &treedata.looptri[query->index];
+          MPoly *mp = &polys_src[lt->poly];
+
+          if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
+            int index;
+            mesh_remap_interp_poly_data_get(mp,
+                                            loops_src,
+                                            (const float(*)[3])vcos_src,
+                                            query->hit_co,
+                                            &tmp_buff_size,
+                                            &vcos,
+                                            false,
+                                            &indices,
+                                            &weights,
+                                            false,
+                                            &index);
+
+            mesh_remap_item_define(r_map, i, query->hit_dist, 0, 1, &index, &full_weight);
           }
-
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[rayhit.index];
-            MPoly *mp_src = &polys_src[lt->poly];
-            const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
+          else {
+            const int sources_num = mesh_remap_interp_poly_data_get(mp,
                                                                     loops_src,
                                                                     (const float(*)[3])vcos_src,
-                                                                    rayhit.co,
+                                                                    query->hit_co,
                                                                     &tmp_buff_size,
                                                                     &vcos,
                                                                     false,
@@ -642,69 +798,16 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                                                     true,
                                                                     NULL);
 
-            mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
+            mesh_remap_item_define(r_map, i, query->hit_dist, 0, sources_num, indices, weights);
           }
         }
-      }
-      else {
-        nearest.index = -1;
-
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
-
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[nearest.index];
-            MPoly *mp = &polys_src[lt->poly];
-
-            if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
-              int index;
-              mesh_remap_interp_poly_data_get(mp,
-                                              loops_src,
-                                              (const float(*)[3])vcos_src,
-                                              nearest.co,
-                                              &tmp_buff_size,
-                                              &vcos,
-                                              false,
-                                              &indices,
-                                              &weights,
-                                              false,
-                                              &index);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-            }
-            else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
-              const int sources_num = mesh_remap_interp_poly_data_get(mp,
-                                                                      loops_src,
-                                                                      (const float(*)[3])vcos_src,
-                                                                      nearest.co,
-                                                                      &tmp_buff_size,
-                                                                      &vcos,
-                                                                      false,
-                                                                      &indices,
-                                                                      &weights,
-                                                                      true,
-                                                                      NULL);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-            }
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
+        else {
+          /* No source for this dest vertex! */
+          BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
 
+      MEM_freeN(queries);
       MEM_freeN(vcos_src);
       MEM_freeN(vcos);
       MEM_freeN(indices);
@@ -753,13 +856,11 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
     float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_EDGE_VERT_NEAREST) {
-      const int num_verts_src = me_src->totvert;
-      const int num_edges_src = me_src->totedge;
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
-      MeshElemMap *vert_to_edge_src_map;
-      int *vert_to_edge_src_map_mem;
+      /* Cached on the source mesh, it is typically used for many evaluations. */
+      const MeshElemMap *vert_to_edge_src_map = BKE_mesh_runtime_vert_edge_map_ensure(me_src);
 
       struct {
         float hit_dist;
@@ -771,12 +872,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
         v_dst_to_src_map[i].hit_dist = -1.0f;
       }
 
-      BKE_mesh_vert_edge_map_create(&vert_to_edge_src_map,
-                                    &vert_to_edge_src_map_mem,
-                                    edges_src,
-                                    num_verts_src,
-                                    num_edges_src);
-
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
       nearest.index = -1;
 
@@ -876,8 +971,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
       MEM_freeN(vcos_src);
       MEM_freeN(v_dst_to_src_map);
-      MEM_freeN(vert_to_edge_src_map);
-      MEM_freeN(vert_to_edge_src_map_mem);
     }
     else if (mode == MREMAP_MODE_EDGE_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
@@ -1317,10 +1410,8 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
 
     float(*poly_cents_src)[3] = NULL;
 
-    MeshElemMap *vert_to_loop_map_src = NULL;
-    int *vert_to_loop_map_src_buff = NULL;
-    MeshElemMap *vert_to_poly_map_src = NULL;
-    int *vert_to_poly_map_src_buff = NULL;
+    const MeshElemMap *vert_to_loop_map_src = NULL;
+    const MeshElemMap *vert_to_poly_map_src = NULL;
     MeshElemMap *edge_to_poly_map_src = NULL;
     int *edge_to_poly_map_src_buff = NULL;
     MeshElemMap *poly_to_looptri_map_src = NULL;
@@ -1431,21 +1522,10 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     }
 
     if (use_from_vert) {
-      BKE_mesh_vert_loop_map_create(&vert_to_loop_map_src,
-                                    &vert_to_loop_map_src_buff,
-                                    polys_src,
-                                    loops_src,
-                                    num_verts_src,
-                                    num_polys_src,
-                                    num_loops_src);
+      /* Cached on the source mesh, it is typically used for many evaluations. */
+      vert_to_loop_map_src = BKE_mesh_runtime_vert_loop_map_ensure(me_src);
       if (mode & MREMAP_USE_POLY) {
-        BKE_mesh_vert_poly_map_create(&vert_to_poly_map_src,
-                                      &vert_to_poly_map_src_buff,
-                                      polys_src,
-                                      loops_src,
-                                      num_verts_src,
-                                      num_polys_src,
-                                      num_loops_src);
+        vert_to_poly_map_src = BKE_mesh_runtime_vert_poly_map_ensure(me_src);
       }
     }
 
@@ -1650,7 +1730,7 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
         ml_dst = &loops_dst[mp_dst->loopstart];
         for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
           if (use_from_vert) {
-            MeshElemMap *vert_to_refelem_map_src = NULL;
+            const MeshElemMap *vert_to_refelem_map_src = NULL;
 
             copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
             nearest.index = -1;
@@ -2157,18 +2237,6 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     if (vcos_src) {
       MEM_freeN(vcos_src);
     }
-    if (vert_to_loop_map_src) {
-      MEM_freeN(vert_to_loop_map_src);
-    }
-    if (vert_to_loop_map_src_buff) {
-      MEM_freeN(vert_to_loop_map_src_buff);
-    }
-    if (vert_to_poly_map_src) {
-      MEM_freeN(vert_to_poly_map_src);
-    }
-    if (vert_to_poly_map_src_buff) {
-      MEM_freeN(vert_to_poly_map_src_buff);
-    }
     if (edge_to_poly_map_src) {
       MEM_freeN(edge_to_poly_map_src);
     }
@@ -2215,7 +2283,6 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
                                          MeshPairRemap *r_map)
 {
   const float full_weight = 1.0f;
-  const float max_dist_sq = max_dist * max_dist;
   float(*poly_nors_dst)[3] = NULL;
   float tmp_co[3], tmp_no[3];
   int i;
@@ -2252,64 +2319,46 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
     BVHTreeRayHit rayhit = {0};
     float hit_dist;
 
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
-    if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
+    if (ELEM(mode, MREMAP_MODE_POLY_NEAREST, MREMAP_MODE_POLY_NOR)) {
+      const bool use_raycast = (mode == MREMAP_MODE_POLY_NOR);
+      BLI_assert(!use_raycast || poly_nors_dst);
 
+      float(*poly_cents_dst)[3] = MEM_malloc_arrayN(
+          (size_t)numpolys_dst, sizeof(*poly_cents_dst), __func__);
       for (i = 0; i < numpolys_dst; i++) {
         MPoly *mp = &polys_dst[i];
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[nearest.index];
-          const int poly_index = (int)lt->poly;
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
+        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, poly_cents_dst[i]);
       }
-    }
-    else if (mode == MREMAP_MODE_POLY_NOR) {
-      BLI_assert(poly_nors_dst);
 
-      for (i = 0; i < numpolys_dst; i++) {
-        MPoly *mp = &polys_dst[i];
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-        copy_v3_v3(tmp_no, poly_nors_dst[i]);
+      MeshRemapQuery *queries = mesh_remap_points_query(
+          &treedata,
+          space_transform,
+          (const float(*)[3])poly_cents_dst,
+          use_raycast ? (const float(*)[3])poly_nors_dst : NULL,
+          numpolys_dst,
+          max_dist,
+          ray_radius);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
-        }
-
-        if (mesh_remap_bvhtree_query_raycast(
-                &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[rayhit.index];
+      for (i = 0; i < numpolys_dst; i++) {
+        const MeshRemapQuery *query = &queries[i];
+        if (query->index != -1) {
+          const MLoopTri *lt = &treedata.looptri[query->index];
           const int poly_index = (int)lt->poly;
-
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
+          mesh_remap_item_define(r_map, i, query->hit_dist, 0, 1, &poly_index, &full_weight);
         }
         else {
           /* No source for this dest poly! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(queries);
+      MEM_freeN(poly_cents_dst);
     }
     else if (mode == MREMAP_MODE_POLY_POLYINTERP_PNORPROJ) {
       /* We cast our rays randomly, with a pseudo-even distribution
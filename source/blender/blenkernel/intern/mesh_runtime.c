@@ -35,10 +35,26 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
 
+/**
+ * A vertex to element map kept in the run-time data of meshes, shared by copies of a mesh.
+ * See #BKE_mesh_runtime_vert_loop_map_ensure.
+ */
+typedef struct MeshTopologyMap {
+  MeshElemMap *map;
+  int *mem;
+  /** Element amounts of the mesh the map was created for. */
+  int totvert;
+  int totedge;
+  int totloop;
+  int totpoly;
+  int32_t users;
+} MeshTopologyMap;
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Runtime Struct Utils
  * \{ */
@@ -64,11 +80,21 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   runtime->mesh_eval = NULL;
   runtime->edit_data = NULL;
   runtime->batch_cache = NULL;
+  runtime->batch_cache_deformed_only = false;
   runtime->subdiv_ccg = NULL;
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
 
+  /* The copy has the same topology, the maps are immutable so they can be shared. */
+  MeshTopologyMap *topology_maps[] = {
+      runtime->vert_loop_map, runtime->vert_poly_map, runtime->vert_edge_map};
+  for (int i = 0; i < ARRAY_SIZE(topology_maps); i++) {
+    if (topology_maps[i] != NULL) {
+      atomic_add_and_fetch_int32(&topology_maps[i]->users, 1);
+    }
+  }
+
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
   BLI_mutex_init(mesh->runtime.eval_mutex);
 }
@@ -175,6 +201,156 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(Mesh *mesh)
   return looptri;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Vertex Topology Maps
+ *
+ * Maps from vertices to the elements using them, as created by the functions in
+ * 'mesh_mapping.c'. The topology of meshes rarely changes in place, so they are kept with the
+ * mesh and shared between its copies, which avoids creating them again for every modifier or
+ * evaluation that needs them. Maps are created again when the amount of elements changed,
+ * and they are cleared with the other geometry caches (#BKE_mesh_runtime_clear_geometry).
+ * Code changing the topology in place without clearing the caches must not use them.
+ * \{ */
+
+typedef enum eMeshTopologyMapType {
+  MESH_TOPOLOGY_MAP_VERT_LOOP,
+  MESH_TOPOLOGY_MAP_VERT_POLY,
+  MESH_TOPOLOGY_MAP_VERT_EDGE,
+} eMeshTopologyMapType;
+
+static ThreadMutex topology_map_lock = BLI_MUTEX_INITIALIZER;
+
+static MeshTopologyMap **mesh_topology_map_p(Mesh *mesh, const eMeshTopologyMapType type)
+{
+  switch (type) {
+    case MESH_TOPOLOGY_MAP_VERT_LOOP:
+      return &mesh->runtime.vert_loop_map;
+    case MESH_TOPOLOGY_MAP_VERT_POLY:
+      return &mesh->runtime.vert_poly_map;
+    case MESH_TOPOLOGY_MAP_VERT_EDGE:
+      return &mesh->runtime.vert_edge_map;
+  }
+  BLI_assert(0);
+  return NULL;
+}
+
+static bool mesh_topology_map_is_valid(const MeshTopologyMap *topology_map, const Mesh *mesh)
+{
+  return (topology_map->totvert == mesh->totvert) && (topology_map->totedge == mesh->totedge) &&
+         (topology_map->totloop == mesh->totloop) && (topology_map->totpoly == mesh->totpoly);
+}
+
+static void mesh_topology_map_release(MeshTopologyMap *topology_map)
+{
+  if (atomic_sub_and_fetch_int32(&topology_map->users, 1) == 0) {
+    MEM_freeN(topology_map->map);
+    MEM_freeN(topology_map->mem);
+    MEM_freeN(topology_map);
+  }
+}
+
+/**
+ * \note The lock is needed, since this is also called for meshes shared between objects.
+ */
+static const MeshElemMap *mesh_topology_map_ensure(Mesh *mesh, const eMeshTopologyMapType type)
+{
+  MeshTopologyMap **topology_map_p = mesh_topology_map_p(mesh, type);
+
+  BLI_mutex_lock(&topology_map_lock);
+
+  MeshTopologyMap *topology_map = *topology_map_p;
+  if (topology_map == NULL || !mesh_topology_map_is_valid(topology_map, mesh)) {
+    if (topology_map != NULL) {
+      mesh_topology_map_release(topology_map);
+    }
+    topology_map = MEM_mallocN(sizeof(*topology_map), __func__);
+    switch (type) {
+      case MESH_TOPOLOGY_MAP_VERT_LOOP:
+        BKE_mesh_vert_loop_map_create(&topology_map->map,
+                                      &topology_map->mem,
+                                      mesh->mpoly,
+                                      mesh->mloop,
+                                      mesh->totvert,
+                                      mesh->totpoly,
+                                      mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_VERT_POLY:
+        BKE_mesh_vert_poly_map_create(&topology_map->map,
+                                      &topology_map->mem,
+                                      mesh->mpoly,
+                                      mesh->mloop,
+                                      mesh->totvert,
+                                      mesh->totpoly,
+                                      mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_VERT_EDGE:
+        BKE_mesh_vert_edge_map_create(
+            &topology_map->map, &topology_map->mem, mesh->medge, mesh->totvert, mesh->totedge);
+        break;
+    }
+    topology_map->totvert = mesh->totvert;
+    topology_map->totedge = mesh->totedge;
+    topology_map->totloop = mesh->totloop;
+    topology_map->totpoly = mesh->totpoly;
+    topology_map->users = 1;
+    *topology_map_p = topology_map;
+  }
+
+  BLI_mutex_unlock(&topology_map_lock);
+
+  return topology_map->map;
+}
+
+static void mesh_topology_map_clear(Mesh *mesh, const eMeshTopologyMapType type)
+{
+  MeshTopologyMap **topology_map_p = mesh_topology_map_p(mesh, type);
+  if (*topology_map_p != NULL) {
+    mesh_topology_map_release(*topology_map_p);
+    *topology_map_p = NULL;
+  }
+}
+
+/**
+ * \return The map from vertices to the loops using them (see #BKE_mesh_vert_loop_map_create).
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_loop_map_ensure(Mesh *mesh)
+{
+  return mesh_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_LOOP);
+}
+
+/**
+ * \return The map from vertices to the polygons using them (see #BKE_mesh_vert_poly_map_create).
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(Mesh *mesh)
+{
+  return mesh_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_POLY);
+}
+
+/**
+ * \return The map from vertices to the edges using them (see #BKE_mesh_vert_edge_map_create).
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(Mesh *mesh)
+{
+  return mesh_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_EDGE);
+}
+
+/**
+ * Clear the vertex to loop map, for users that found it doesn't match the loops of the mesh.
+ */
+void BKE_mesh_runtime_vert_loop_map_clear(Mesh *mesh)
+{
+  mesh_topology_map_clear(mesh, MESH_TOPOLOGY_MAP_VERT_LOOP);
+}
+
+void BKE_mesh_runtime_topology_maps_clear(Mesh *mesh)
+{
+  mesh_topology_map_clear(mesh, MESH_TOPOLOGY_MAP_VERT_LOOP);
+  mesh_topology_map_clear(mesh, MESH_TOPOLOGY_MAP_VERT_POLY);
+  mesh_topology_map_clear(mesh, MESH_TOPOLOGY_MAP_VERT_EDGE);
+}
+
+/** \} */
+
 /* This is a copy of DM_verttri_from_looptri(). */
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
@@ -240,6 +416,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.subdiv_ccg = NULL;
   }
   BKE_shrinkwrap_discard_boundary_data(mesh);
+  BKE_mesh_runtime_topology_maps_clear(mesh);
 }
 
 /** \} */
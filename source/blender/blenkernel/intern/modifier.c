@@ -203,6 +203,7 @@ void BKE_modifier_free_ex(ModifierData *md, const int flag)
   if (md->error) {
     MEM_freeN(md->error);
   }
+  BKE_modifier_result_cache_free(md);
 
   MEM_freeN(md);
 }
@@ -1356,6 +1357,8 @@ void BKE_modifier_blend_read_data(BlendDataReader *reader, ListBase *lb, Object
 
     md->error = NULL;
     md->runtime = NULL;
+    md->result_cache = NULL;
+    md->execution_time = 0.0;
 
     /* Modifier data has been allocated as a part of data migration process and
      * no reading of nested fields from file is needed. */
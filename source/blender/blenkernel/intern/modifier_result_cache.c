@@ -0,0 +1,199 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bke
+ *
+ * Cache of the result of a constructive modifier, so that editing modifiers further down
+ * the stack does not run expensive modifiers (e.g. Boolean or Remesh) again.
+ *
+ * The cache is keyed by a hash of everything the result depends on: the input mesh, the
+ * modifier settings and the objects the modifier references. Modifiers with inputs that can't
+ * be hashed reliably (time, collections, textures, ...) are never cached.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+
+#include "BLI_hash_mm2a.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_customdata.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_modifier.h"
+#include "BKE_object.h"
+
+typedef struct ModifierResultCache {
+  uint32_t hash;
+  struct Mesh *mesh;
+} ModifierResultCache;
+
+static bool result_cache_hash_mesh(const Mesh *mesh, BLI_HashMurmur2A *mm2)
+{
+  BLI_hash_mm2a_add_int(mm2, mesh->totvert);
+  BLI_hash_mm2a_add_int(mm2, mesh->totedge);
+  BLI_hash_mm2a_add_int(mm2, mesh->totface);
+  BLI_hash_mm2a_add_int(mm2, mesh->totloop);
+  BLI_hash_mm2a_add_int(mm2, mesh->totpoly);
+  BLI_hash_mm2a_add_int(mm2, mesh->flag);
+  BLI_hash_mm2a_add_int(mm2, mesh->cd_flag);
+  BLI_hash_mm2a_add(mm2, (const uchar *)&mesh->smoothresh, sizeof(mesh->smoothresh));
+  BLI_hash_mm2a_add_int(mm2, mesh->totcol);
+  if (mesh->mat != NULL) {
+    BLI_hash_mm2a_add(mm2, (const uchar *)mesh->mat, sizeof(*mesh->mat) * (size_t)mesh->totcol);
+  }
+
+  return CustomData_hash_mm2a(&mesh->vdata, mesh->totvert, mm2) &&
+         CustomData_hash_mm2a(&mesh->edata, mesh->totedge, mm2) &&
+         CustomData_hash_mm2a(&mesh->fdata, mesh->totface, mm2) &&
+         CustomData_hash_mm2a(&mesh->ldata, mesh->totloop, mm2) &&
+         CustomData_hash_mm2a(&mesh->pdata, mesh->totpoly, mm2);
+}
+
+typedef struct ResultCacheIDHashData {
+  BLI_HashMurmur2A *mm2;
+  bool is_valid;
+} ResultCacheIDHashData;
+
+static void result_cache_hash_id_cb(void *userData,
+                                    Object *UNUSED(ob),
+                                    ID **idpoin,
+                                    int UNUSED(cb_flag))
+{
+  ResultCacheIDHashData *data = userData;
+  ID *id = *idpoin;
+
+  if (id == NULL || !data->is_valid) {
+    return;
+  }
+
+  /* Only mesh objects are supported, for other data there is no cheap way to tell whether
+   * its evaluated state changed. */
+  if (GS(id->name) != ID_OB) {
+    data->is_valid = false;
+    return;
+  }
+
+  Object *ob = (Object *)id;
+  const Mesh *mesh = (ob->type == OB_MESH) ? BKE_object_get_evaluated_mesh(ob) : NULL;
+  if (mesh == NULL) {
+    data->is_valid = false;
+    return;
+  }
+
+  BLI_hash_mm2a_add(data->mm2, (const uchar *)ob->obmat, sizeof(ob->obmat));
+  data->is_valid = result_cache_hash_mesh(mesh, data->mm2);
+}
+
+/**
+ * Compute the key of the modifier result for the given input \a mesh.
+ *
+ * \return False when the result of the modifier can't be cached.
+ */
+bool BKE_modifier_result_cache_hash(ModifierData *md,
+                                    const ModifierEvalContext *ctx,
+                                    const Mesh *mesh,
+                                    const CustomData_MeshMasks *mask,
+                                    uint32_t *r_hash)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+
+  if (mti->type == eModifierTypeType_OnlyDeform || mti->modifyMesh == NULL) {
+    return false;
+  }
+  if (mti->dependsOnTime && mti->dependsOnTime(md)) {
+    return false;
+  }
+  if (mti->flags & (eModifierTypeFlag_UsesPointCache | eModifierTypeFlag_UsesPreview)) {
+    return false;
+  }
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  BLI_hash_mm2a_add_int(&mm2, md->type);
+  BLI_hash_mm2a_add_int(&mm2, ctx->flag);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)mask, sizeof(*mask));
+  BLI_hash_mm2a_add(&mm2, (const uchar *)ctx->object->obmat, sizeof(ctx->object->obmat));
+
+  /* Settings of the modifier are stored after the common modifier data. */
+  BLI_assert(mti->structSize >= sizeof(ModifierData));
+  BLI_hash_mm2a_add(&mm2,
+                    (const uchar *)md + sizeof(ModifierData),
+                    (size_t)mti->structSize - sizeof(ModifierData));
+
+  if (mti->foreachIDLink) {
+    ResultCacheIDHashData data = {&mm2, true};
+    mti->foreachIDLink(md, ctx->object, result_cache_hash_id_cb, &data);
+    if (!data.is_valid) {
+      return false;
+    }
+  }
+
+  if (!result_cache_hash_mesh(mesh, &mm2)) {
+    return false;
+  }
+
+  *r_hash = BLI_hash_mm2a_end(&mm2);
+  return true;
+}
+
+/**
+ * \return A copy of the cached result when it was computed for the same \a hash, or NULL.
+ */
+Mesh *BKE_modifier_result_cache_lookup(ModifierData *md, const uint32_t hash)
+{
+  const ModifierResultCache *cache = md->result_cache;
+  if (cache == NULL || cache->hash != hash) {
+    return NULL;
+  }
+  return BKE_mesh_copy_for_eval(cache->mesh, false);
+}
+
+void BKE_modifier_result_cache_store(ModifierData *md, const uint32_t hash, const Mesh *mesh)
+{
+  ModifierResultCache *cache = md->result_cache;
+  if (cache == NULL) {
+    cache = MEM_callocN(sizeof(*cache), __func__);
+    md->result_cache = cache;
+  }
+  else if (cache->mesh != NULL) {
+    BKE_id_free(NULL, cache->mesh);
+  }
+
+  /* Store a copy, the result itself is modified by the following modifiers. */
+  cache->hash = hash;
+  cache->mesh = BKE_mesh_copy_for_eval((Mesh *)mesh, false);
+}
+
+void BKE_modifier_result_cache_free_data(ModifierResultCache *cache)
+{
+  if (cache->mesh != NULL) {
+    BKE_id_free(NULL, cache->mesh);
+  }
+  MEM_freeN(cache);
+}
+
+void BKE_modifier_result_cache_free(ModifierData *md)
+{
+  if (md->result_cache != NULL) {
+    BKE_modifier_result_cache_free_data(md->result_cache);
+    md->result_cache = NULL;
+  }
+}
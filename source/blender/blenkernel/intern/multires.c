@@ -477,6 +477,9 @@ void multires_force_sculpt_rebuild(Object *object)
     MEM_freeN(ss->pmap_mem);
     ss->pmap_mem = NULL;
   }
+
+  MEM_SAFE_FREE(ss->vert_neighbors_offset);
+  MEM_SAFE_FREE(ss->vert_neighbors);
 }
 
 void multires_force_external_reload(Object *object)
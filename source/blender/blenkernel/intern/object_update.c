@@ -304,7 +304,7 @@ void BKE_object_sync_to_original(Depsgraph *depsgraph, Object *object)
   object_orig->transflag = object->transflag;
   object_orig->flag = object->flag;
 
-  /* Copy back error messages from modifiers. */
+  /* Copy back error messages and execution times from modifiers. */
   for (ModifierData *md = object->modifiers.first, *md_orig = object_orig->modifiers.first;
        md != NULL && md_orig != NULL;
        md = md->next, md_orig = md_orig->next) {
@@ -313,6 +313,7 @@ void BKE_object_sync_to_original(Depsgraph *depsgraph, Object *object)
     if (md->error != NULL) {
       md_orig->error = BLI_strdup(md->error);
     }
+    md_orig->execution_time = md->execution_time;
   }
 }
 
@@ -348,9 +349,17 @@ void BKE_object_eval_uber_transform(Depsgraph *depsgraph, Object *object)
 void BKE_object_batch_cache_dirty_tag(Object *ob)
 {
   switch (ob->type) {
-    case OB_MESH:
-      BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
+    case OB_MESH: {
+      Mesh *mesh = ob->data;
+      if (mesh->runtime.batch_cache_deformed_only) {
+        mesh->runtime.batch_cache_deformed_only = false;
+        BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_DEFORM);
+      }
+      else {
+        BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_ALL);
+      }
       break;
+    }
     case OB_LATTICE:
       BKE_lattice_batch_cache_dirty_tag(ob->data, BKE_LATTICE_BATCH_DIRTY_ALL);
       break;
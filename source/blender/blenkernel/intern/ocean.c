@@ -1372,179 +1372,225 @@ void BKE_ocean_simulate_cache(struct OceanCache *och, int frame)
   och->ibufs_norm[f] = IMB_loadiffname(string, 0, NULL);
 }
 
-void BKE_ocean_bake(struct Ocean *o,
-                    struct OceanCache *och,
-                    void (*update_cb)(void *, float progress, int *cancel),
-                    void *update_cb_data)
+typedef struct OceanBakeFrameData {
+  Ocean *o;
+  OceanCache *och;
+  /* Index of the frame in the bake, and its frame number. */
+  int i;
+  int frame;
+
+  ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
+  float *prev_foam;
+} OceanBakeFrameData;
+
+static void ocean_bake_frame_row_cb(void *__restrict userdata,
+                                    const int y,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  const OceanBakeFrameData *fd = userdata;
+  Ocean *o = fd->o;
+  const OceanCache *och = fd->och;
+  const int res_x = och->resolution_x;
+
   /* note: some of these values remain uninitialized unless certain options
    * are enabled, take care that BKE_ocean_eval_ij() initializes a member
    * before use - campbell */
   OceanResult ocr;
 
-  ImageFormatData imf = {0};
+  for (int x = 0; x < res_x; x++) {
 
-  int f, i = 0, x, y, cancel = 0;
-  float progress;
+    BKE_ocean_eval_ij(o, &ocr, x, y);
 
-  ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
-  float *prev_foam;
-  int res_x = och->resolution_x;
-  int res_y = och->resolution_y;
-  char string[FILE_MAX];
-  // RNG *rng;
+    /* add to the image */
+    rgb_to_rgba_unit_alpha(&fd->ibuf_disp->rect_float[4 * (res_x * y + x)], ocr.disp);
 
-  if (!o) {
-    return;
-  }
+    if (o->_do_jacobian) {
+      /* TODO, cleanup unused code - campbell */
 
-  if (o->_do_jacobian) {
-    prev_foam = MEM_callocN(res_x * res_y * sizeof(float), "previous frame foam bake data");
-  }
-  else {
-    prev_foam = NULL;
-  }
+      float /*r, */ /* UNUSED */ pr = 0.0f, foam_result;
+      float neg_disp, neg_eplus;
 
-  // rng = BLI_rng_new(0);
+      ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
 
-  /* setup image format */
-  imf.imtype = R_IMF_IMTYPE_OPENEXR;
-  imf.depth = R_IMF_CHAN_DEPTH_16;
-  imf.exr_codec = R_IMF_EXR_CODEC_ZIP;
+      /* accumulate previous value for this cell */
+      if (fd->i > 0) {
+        pr = fd->prev_foam[res_x * y + x];
+      }
 
-  for (f = och->start, i = 0; f <= och->end; f++, i++) {
+      /* r = BLI_rng_get_float(rng); */ /* UNUSED */ /* randomly reduce foam */
 
-    /* create a new imbuf to store image for this frame */
-    ibuf_foam = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_disp = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_normal = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_spray = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_spray_inverse = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+      /* pr = pr * och->foam_fade; */ /* overall fade */
 
-    BKE_ocean_simulate(o, och->time[i], och->wave_scale, och->chop_amount);
+      /* Remember ocean coord sys is Y up!
+       * break up the foam where height (Y) is low (wave valley),
+       * and X and Z displacement is greatest. */
 
-    /* add new foam */
-    for (y = 0; y < res_y; y++) {
-      for (x = 0; x < res_x; x++) {
+      neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
+      neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
 
-        BKE_ocean_eval_ij(o, &ocr, x, y);
+      /* foam, 'ocr.Eplus' only initialized with do_jacobian */
+      neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
+      neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
 
-        /* add to the image */
-        rgb_to_rgba_unit_alpha(&ibuf_disp->rect_float[4 * (res_x * y + x)], ocr.disp);
+      if (pr < 1.0f) {
+        pr *= pr;
+      }
 
-        if (o->_do_jacobian) {
-          /* TODO, cleanup unused code - campbell */
+      pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
 
-          float /*r, */ /* UNUSED */ pr = 0.0f, foam_result;
-          float neg_disp, neg_eplus;
+      /* A full clamping should not be needed! */
+      foam_result = min_ff(pr + ocr.foam, 1.0f);
 
-          ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
+      fd->prev_foam[res_x * y + x] = foam_result;
 
-          /* accumulate previous value for this cell */
-          if (i > 0) {
-            pr = prev_foam[res_x * y + x];
-          }
+      /*foam_result = min_ff(foam_result, 1.0f); */
 
-          /* r = BLI_rng_get_float(rng); */ /* UNUSED */ /* randomly reduce foam */
+      value_to_rgba_unit_alpha(&fd->ibuf_foam->rect_float[4 * (res_x * y + x)], foam_result);
 
-          /* pr = pr * och->foam_fade; */ /* overall fade */
+      /* spray map baking */
+      if (o->_do_spray) {
+        rgb_to_rgba_unit_alpha(&fd->ibuf_spray->rect_float[4 * (res_x * y + x)], ocr.Eplus);
+        rgb_to_rgba_unit_alpha(&fd->ibuf_spray_inverse->rect_float[4 * (res_x * y + x)],
+                               ocr.Eminus);
+      }
+    }
 
-          /* Remember ocean coord sys is Y up!
-           * break up the foam where height (Y) is low (wave valley),
-           * and X and Z displacement is greatest. */
+    if (o->_do_normals) {
+      rgb_to_rgba_unit_alpha(&fd->ibuf_normal->rect_float[4 * (res_x * y + x)], ocr.normal);
+    }
+  }
+}
 
-          neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
-          neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
+/* Write the images of a frame and free them, this runs in the background while the next frame
+ * is simulated. */
+static void ocean_bake_frame_write(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  OceanBakeFrameData *fd = taskdata;
+  const Ocean *o = fd->o;
+  const OceanCache *och = fd->och;
+  char string[FILE_MAX];
 
-          /* foam, 'ocr.Eplus' only initialized with do_jacobian */
-          neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
-          neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
+  /* setup image format */
+  ImageFormatData imf = {0};
+  imf.imtype = R_IMF_IMTYPE_OPENEXR;
+  imf.depth = R_IMF_CHAN_DEPTH_16;
+  imf.exr_codec = R_IMF_EXR_CODEC_ZIP;
 
-          if (pr < 1.0f) {
-            pr *= pr;
-          }
+  cache_filename(string, och->bakepath, och->relbase, fd->frame, CACHE_TYPE_DISPLACE);
+  if (0 == BKE_imbuf_write(fd->ibuf_disp, string, &imf)) {
+    printf("Cannot save Displacement File Output to %s\n", string);
+  }
 
-          pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
+  if (o->_do_jacobian) {
+    cache_filename(string, och->bakepath, och->relbase, fd->frame, CACHE_TYPE_FOAM);
+    if (0 == BKE_imbuf_write(fd->ibuf_foam, string, &imf)) {
+      printf("Cannot save Foam File Output to %s\n", string);
+    }
 
-          /* A full clamping should not be needed! */
-          foam_result = min_ff(pr + ocr.foam, 1.0f);
+    if (o->_do_spray) {
+      cache_filename(string, och->bakepath, och->relbase, fd->frame, CACHE_TYPE_SPRAY);
+      if (0 == BKE_imbuf_write(fd->ibuf_spray, string, &imf)) {
+        printf("Cannot save Spray File Output to %s\n", string);
+      }
 
-          prev_foam[res_x * y + x] = foam_result;
+      cache_filename(string, och->bakepath, och->relbase, fd->frame, CACHE_TYPE_SPRAY_INVERSE);
+      if (0 == BKE_imbuf_write(fd->ibuf_spray_inverse, string, &imf)) {
+        printf("Cannot save Spray Inverse File Output to %s\n", string);
+      }
+    }
+  }
 
-          /*foam_result = min_ff(foam_result, 1.0f); */
+  if (o->_do_normals) {
+    cache_filename(string, och->bakepath, och->relbase, fd->frame, CACHE_TYPE_NORMAL);
+    if (0 == BKE_imbuf_write(fd->ibuf_normal, string, &imf)) {
+      printf("Cannot save Normal File Output to %s\n", string);
+    }
+  }
 
-          value_to_rgba_unit_alpha(&ibuf_foam->rect_float[4 * (res_x * y + x)], foam_result);
+  IMB_freeImBuf(fd->ibuf_disp);
+  IMB_freeImBuf(fd->ibuf_foam);
+  IMB_freeImBuf(fd->ibuf_normal);
+  IMB_freeImBuf(fd->ibuf_spray);
+  IMB_freeImBuf(fd->ibuf_spray_inverse);
+}
 
-          /* spray map baking */
-          if (o->_do_spray) {
-            rgb_to_rgba_unit_alpha(&ibuf_spray->rect_float[4 * (res_x * y + x)], ocr.Eplus);
-            rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->rect_float[4 * (res_x * y + x)],
-                                   ocr.Eminus);
-          }
-        }
+void BKE_ocean_bake(struct Ocean *o,
+                    struct OceanCache *och,
+                    void (*update_cb)(void *, float progress, int *cancel),
+                    void *update_cb_data)
+{
+  int f, i = 0, cancel = 0;
+  float progress;
 
-        if (o->_do_normals) {
-          rgb_to_rgba_unit_alpha(&ibuf_normal->rect_float[4 * (res_x * y + x)], ocr.normal);
-        }
-      }
-    }
+  float *prev_foam;
+  int res_x = och->resolution_x;
+  int res_y = och->resolution_y;
+  // RNG *rng;
 
-    /* write the images */
-    cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_DISPLACE);
-    if (0 == BKE_imbuf_write(ibuf_disp, string, &imf)) {
-      printf("Cannot save Displacement File Output to %s\n", string);
-    }
+  if (!o) {
+    return;
+  }
 
-    if (o->_do_jacobian) {
-      cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_FOAM);
-      if (0 == BKE_imbuf_write(ibuf_foam, string, &imf)) {
-        printf("Cannot save Foam File Output to %s\n", string);
-      }
+  if (o->_do_jacobian) {
+    prev_foam = MEM_callocN(res_x * res_y * sizeof(float), "previous frame foam bake data");
+  }
+  else {
+    prev_foam = NULL;
+  }
 
-      if (o->_do_spray) {
-        cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_SPRAY);
-        if (0 == BKE_imbuf_write(ibuf_spray, string, &imf)) {
-          printf("Cannot save Spray File Output to %s\n", string);
-        }
-
-        cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_SPRAY_INVERSE);
-        if (0 == BKE_imbuf_write(ibuf_spray_inverse, string, &imf)) {
-          printf("Cannot save Spray Inverse File Output to %s\n", string);
-        }
-      }
-    }
+  // rng = BLI_rng_new(0);
 
-    if (o->_do_normals) {
-      cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_NORMAL);
-      if (0 == BKE_imbuf_write(ibuf_normal, string, &imf)) {
-        printf("Cannot save Normal File Output to %s\n", string);
-      }
-    }
+  /* Images of a frame are written while the next frame is computed, the pool holds at most one
+   * frame to keep memory usage bounded. */
+  TaskPool *write_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+
+  for (f = och->start, i = 0; f <= och->end; f++, i++) {
+    OceanBakeFrameData *fd = MEM_callocN(sizeof(*fd), __func__);
+    fd->o = o;
+    fd->och = och;
+    fd->i = i;
+    fd->frame = f;
+    fd->prev_foam = prev_foam;
+
+    /* create a new imbuf to store image for this frame */
+    fd->ibuf_foam = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+    fd->ibuf_disp = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+    fd->ibuf_normal = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+    fd->ibuf_spray = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+    fd->ibuf_spray_inverse = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+
+    BKE_ocean_simulate(o, och->time[i], och->wave_scale, och->chop_amount);
 
-    IMB_freeImBuf(ibuf_disp);
-    IMB_freeImBuf(ibuf_foam);
-    IMB_freeImBuf(ibuf_normal);
-    IMB_freeImBuf(ibuf_spray);
-    IMB_freeImBuf(ibuf_spray_inverse);
+    /* add new foam */
+    BLI_task_parallel_range(0, res_y, fd, ocean_bake_frame_row_cb, &settings);
+
+    /* write the images */
+    BLI_task_pool_work_and_wait(write_pool);
+    BLI_task_pool_push(write_pool, ocean_bake_frame_write, fd, true, NULL);
 
     progress = (f - och->start) / (float)och->duration;
 
     update_cb(update_cb_data, progress, &cancel);
 
     if (cancel) {
-      if (prev_foam) {
-        MEM_freeN(prev_foam);
-      }
-      // BLI_rng_free(rng);
-      return;
+      break;
     }
   }
 
+  BLI_task_pool_work_and_wait(write_pool);
+  BLI_task_pool_free(write_pool);
+
   // BLI_rng_free(rng);
   if (prev_foam) {
     MEM_freeN(prev_foam);
   }
-  och->baked = 1;
+  if (!cancel) {
+    och->baked = 1;
+  }
 }
 
 #else /* WITH_OCEANSIM */
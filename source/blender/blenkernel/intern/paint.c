@@ -1415,6 +1415,8 @@ static void sculptsession_free_pbvh(Object *object)
 
   MEM_SAFE_FREE(ss->pmap);
   MEM_SAFE_FREE(ss->pmap_mem);
+  MEM_SAFE_FREE(ss->vert_neighbors_offset);
+  MEM_SAFE_FREE(ss->vert_neighbors);
 
   MEM_SAFE_FREE(ss->persistent_base);
 
@@ -1465,6 +1467,8 @@ void BKE_sculptsession_free(Object *ob)
 
     MEM_SAFE_FREE(ss->pmap);
     MEM_SAFE_FREE(ss->pmap_mem);
+    MEM_SAFE_FREE(ss->vert_neighbors_offset);
+    MEM_SAFE_FREE(ss->vert_neighbors);
     if (ss->bm_log) {
       BM_log_free(ss->bm_log);
     }
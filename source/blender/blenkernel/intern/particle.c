@@ -2679,10 +2679,35 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
 
   BLI_kdtree_3d_balance(tree);
 
-  for (; p < totchild; p++, cpa++) {
-    psys_particle_on_emitter(
-        sim->psmd, from, cpa->num, DMCACHE_ISCHILD, cpa->fuv, cpa->foffset, co, 0, 0, 0, orco);
-    cpa->parent = BLI_kdtree_3d_find_nearest(tree, orco, NULL);
+  if (p < totchild) {
+    const int orcos_len = totchild - p;
+    float(*orcos)[3] = MEM_malloc_arrayN(orcos_len, sizeof(*orcos), __func__);
+    int *parents = MEM_malloc_arrayN(orcos_len, sizeof(*parents), __func__);
+    ChildParticle *cpa_first = cpa;
+
+    for (int i = 0; i < orcos_len; i++, cpa++) {
+      psys_particle_on_emitter(sim->psmd,
+                               from,
+                               cpa->num,
+                               DMCACHE_ISCHILD,
+                               cpa->fuv,
+                               cpa->foffset,
+                               co,
+                               0,
+                               0,
+                               0,
+                               orcos[i]);
+    }
+
+    BLI_kdtree_3d_find_nearest_batch(tree, (const float(*)[3])orcos, orcos_len, parents, NULL);
+
+    cpa = cpa_first;
+    for (int i = 0; i < orcos_len; i++, cpa++) {
+      cpa->parent = parents[i];
+    }
+
+    MEM_freeN(orcos);
+    MEM_freeN(parents);
   }
 
   BLI_kdtree_3d_free(tree);
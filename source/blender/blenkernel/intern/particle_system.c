@@ -457,6 +457,9 @@ void psys_calc_dmcache(Object *ob, Mesh *mesh_final, Mesh *mesh_original, Partic
   }
 }
 
+/* Maximum number of particles handled by one task. */
+#define PSYS_TASK_MAX_PARTICLES 1024
+
 /* threaded child particle distribution and path caching */
 void psys_thread_context_init(ParticleThreadContext *ctx, ParticleSimulationData *sim)
 {
@@ -473,7 +476,12 @@ void psys_tasks_create(ParticleThreadContext *ctx,
                        int *r_numtasks)
 {
   ParticleTask *tasks;
-  int numtasks = min_ii(BLI_system_thread_count() * 4, endpart - startpart);
+  /* Use at least a few tasks per thread, and more for large counts so that the uneven cost of
+   * particles (e.g. children with kink or clumping) is balanced between threads. */
+  int numtasks = max_ii(BLI_system_thread_count() * 4,
+                        (endpart - startpart + PSYS_TASK_MAX_PARTICLES - 1) /
+                            PSYS_TASK_MAX_PARTICLES);
+  numtasks = min_ii(numtasks, endpart - startpart);
   float particles_per_task = (float)(endpart - startpart) / (float)numtasks, p, pnext;
   int i;
 
@@ -3813,6 +3821,51 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   }
 }
 
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DynamicStepSolverTaskData *data = userdata;
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+/* Newtonian particles can only be integrated in parallel when no shared random generator is
+ * used, otherwise the result would depend on the order in which particles are processed. */
+static bool dynamics_step_newton_use_threading(ParticleSimulationData *sim)
+{
+  ParticleSystem *psys = sim->psys;
+
+  /* brownian force and collision responses use sim->rng */
+  if (psys->part->brownfac != 0.0f || sim->colliders) {
+    return false;
+  }
+
+  /* effector noise uses the field's rng */
+  if (psys->effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, psys->effectors) {
+      if (eff->pd && eff->pd->f_noise > 0.0f) {
+        return false;
+      }
+    }
+  }
+
+  return psys->totpart > 100;
+}
+
 /* unbaked particles are calculated dynamically */
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
@@ -3941,6 +3994,21 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
+      if (dynamics_step_newton_use_threading(sim)) {
+        DynamicStepSolverTaskData task_data = {
+            .sim = sim,
+            .cfra = cfra,
+            .timestep = timestep,
+            .dtime = dtime,
+        };
+
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        BLI_task_parallel_range(
+            0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
+        break;
+      }
+
       LOOP_DYNAMIC_PARTICLES
       {
         /* do global forces & effectors */
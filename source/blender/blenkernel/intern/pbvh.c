@@ -251,17 +251,21 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
 }
 
 /* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
+ * a negative value for additional vertices. A vertex is unique to the first
+ * leaf in build order that uses it, see #PBVH.vert_owner. */
+static int map_insert_vert(PBVH *pbvh,
+                           GHash *map,
+                           unsigned int *face_verts,
+                           unsigned int *uniq_verts,
+                           int vertex,
+                           int leaf_order)
 {
   void *key, **value_p;
 
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+    if (pbvh->vert_owner[vertex] == leaf_order) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -277,7 +281,7 @@ static int map_insert_vert(
 }
 
 /* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node, int leaf_order)
 {
   bool has_visible = false;
 
@@ -299,7 +303,7 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
       face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v, leaf_order);
     }
 
     if (has_visible == false) {
@@ -413,24 +417,6 @@ static void build_grid_leaf_node(PBVH *pbvh, PBVHNode *node)
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
-static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, int count)
-{
-  pbvh->nodes[node_index].flag |= PBVH_Leaf;
-
-  pbvh->nodes[node_index].prim_indices = pbvh->prim_indices + offset;
-  pbvh->nodes[node_index].totprim = count;
-
-  /* Still need vb for searches */
-  update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
-
-  if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
-  else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
-}
-
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
 static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
@@ -465,19 +451,192 @@ static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
   return false;
 }
 
-/* Recursively build a node in the tree
+/* -------------------------------------------------------------------- */
+/** \name Tree Building
  *
- * vb is the voxel box around all of the primitives contained in
- * this node.
+ * The primitives are first partitioned into a temporary tree, building large subtrees in
+ * their own task. The temporary tree is then stored in #PBVH.nodes in the same order a serial
+ * recursive build creates the nodes, after which leaves are filled in parallel.
+ * \{ */
+
+/* Number of bins used to find the split position with the surface area heuristic. */
+#define BUILD_SAH_BINS 16
+/* Minimum number of primitives to gather split bins with multiple threads. */
+#define BUILD_SAH_THREADED_LIMIT 10000
+
+typedef struct PBVHBuildNode {
+  /* Both children are set for interior nodes, none for leaves. */
+  struct PBVHBuildNode *children[2];
+  /* Range in the array of primitive indices. */
+  int offset, count;
+  /* Index in #PBVH.nodes, set once the tree is partitioned. */
+  int node_index;
+} PBVHBuildNode;
+
+typedef struct PBVHBuildData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+  /* Subtrees with at least this many primitives are built in their own task. */
+  int task_limit;
+} PBVHBuildData;
+
+typedef struct SAHBin {
+  BB bb;
+  int count;
+} SAHBin;
+
+typedef struct SAHBinChunk {
+  SAHBin bins[BUILD_SAH_BINS];
+} SAHBinChunk;
+
+typedef struct SAHBinData {
+  const int *prim_indices;
+  const BBC *prim_bbc;
+  int offset;
+  int axis;
+  float min, scale;
+} SAHBinData;
+
+BLI_INLINE int sah_bin_index(const BBC *bbc, int axis, float min, float scale)
+{
+  const int bin = (int)((bbc->bcentroid[axis] - min) * scale);
+  return CLAMPIS(bin, 0, BUILD_SAH_BINS - 1);
+}
+
+static float bb_half_area(const BB *bb)
+{
+  float dim[3];
+  sub_v3_v3v3(dim, bb->bmax, bb->bmin);
+  return dim[0] * dim[1] + dim[1] * dim[2] + dim[2] * dim[0];
+}
+
+static void sah_bin_cb(void *__restrict userdata,
+                       const int i,
+                       const TaskParallelTLS *__restrict tls)
+{
+  const SAHBinData *data = userdata;
+  SAHBinChunk *chunk = tls->userdata_chunk;
+  const BBC *bbc = &data->prim_bbc[data->prim_indices[data->offset + i]];
+  SAHBin *bin = &chunk->bins[sah_bin_index(bbc, data->axis, data->min, data->scale)];
+
+  BB_expand_with_bb(&bin->bb, (BB *)bbc);
+  bin->count++;
+}
+
+static void sah_bin_reduce(const void *__restrict UNUSED(userdata),
+                           void *__restrict chunk_join,
+                           void *__restrict chunk)
+{
+  SAHBinChunk *join = chunk_join;
+  SAHBinChunk *bins = chunk;
+
+  for (int i = 0; i < BUILD_SAH_BINS; i++) {
+    BB_expand_with_bb(&join->bins[i].bb, &bins->bins[i].bb);
+    join->bins[i].count += bins->bins[i].count;
+  }
+}
+
+/* Partition primitives at the split with the lowest surface area heuristic cost along the
+ * widest axis of the centroid bounds, or at the middle of that axis when there is no split.
+ * Returns the index of the first element on the right of the partition */
+static int partition_indices_sah(PBVH *pbvh, BBC *prim_bbc, const BB *cb, int offset, int count)
+{
+  int *prim_indices = pbvh->prim_indices;
+  const int axis = BB_widest_axis(cb);
+  const float extent = cb->bmax[axis] - cb->bmin[axis];
+  const float mid = (cb->bmax[axis] + cb->bmin[axis]) * 0.5f;
+
+  if (!(extent > 0.0f)) {
+    return partition_indices(prim_indices, offset, offset + count - 1, axis, mid, prim_bbc);
+  }
+
+  SAHBinData data = {
+      .prim_indices = prim_indices,
+      .prim_bbc = prim_bbc,
+      .offset = offset,
+      .axis = axis,
+      .min = cb->bmin[axis],
+      .scale = BUILD_SAH_BINS / extent,
+  };
+
+  SAHBinChunk chunk;
+  for (int i = 0; i < BUILD_SAH_BINS; i++) {
+    BB_reset(&chunk.bins[i].bb);
+    chunk.bins[i].count = 0;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = BUILD_SAH_THREADED_LIMIT;
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_reduce = sah_bin_reduce;
+  BLI_task_parallel_range(0, count, &data, sah_bin_cb, &settings);
+
+  /* Cost of the right side of the split before each bin. */
+  float right_cost[BUILD_SAH_BINS];
+  BB bb;
+  int totprim = 0;
+  BB_reset(&bb);
+  for (int i = BUILD_SAH_BINS - 1; i > 0; i--) {
+    BB_expand_with_bb(&bb, &chunk.bins[i].bb);
+    totprim += chunk.bins[i].count;
+    right_cost[i] = (totprim != 0) ? bb_half_area(&bb) * (float)totprim : 0.0f;
+  }
+
+  /* Don't split off slivers, those end up as tiny leaves with their own draw buffers. */
+  const int min_count = max_ii(min_ii(count / 4, pbvh->leaf_limit / 2), 1);
+  float best_cost = FLT_MAX;
+  int best_bin = -1;
+  totprim = 0;
+  BB_reset(&bb);
+  for (int i = 0; i < BUILD_SAH_BINS - 1; i++) {
+    BB_expand_with_bb(&bb, &chunk.bins[i].bb);
+    totprim += chunk.bins[i].count;
+    if (totprim < min_count || count - totprim < min_count) {
+      continue;
+    }
+    const float cost = bb_half_area(&bb) * (float)totprim + right_cost[i + 1];
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_bin = i;
+    }
+  }
+
+  if (best_bin == -1) {
+    return partition_indices(prim_indices, offset, offset + count - 1, axis, mid, prim_bbc);
+  }
+
+  int i = offset, j = offset + count - 1;
+  while (i <= j) {
+    if (sah_bin_index(&prim_bbc[prim_indices[i]], axis, data.min, data.scale) <= best_bin) {
+      i++;
+    }
+    else {
+      SWAP(int, prim_indices[i], prim_indices[j]);
+      j--;
+    }
+  }
+  return i;
+}
+
+static void build_sub(TaskPool *__restrict pool, PBVHBuildData *data, PBVHBuildNode *node, BB *cb);
+
+static void build_sub_task(TaskPool *__restrict pool, void *taskdata)
+{
+  build_sub(pool, BLI_task_pool_user_data(pool), taskdata, NULL);
+}
+
+/* Recursively partition the primitives of a node in the tree
  *
  * cb is the bounding box around all the centroids of the primitives
- * contained in this node
- *
- * offset and start indicate a range in the array of primitive indices
+ * contained in this node, computed when NULL
  */
-
-static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int offset, int count)
+static void build_sub(TaskPool *__restrict pool, PBVHBuildData *data, PBVHBuildNode *node, BB *cb)
 {
+  PBVH *pbvh = data->pbvh;
+  const int offset = node->offset;
+  const int count = node->count;
   int end;
   BB cb_backing;
 
@@ -485,50 +644,142 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
   const bool below_leaf_limit = count <= pbvh->leaf_limit;
   if (below_leaf_limit) {
     if (!leaf_needs_material_split(pbvh, offset, count)) {
-      build_leaf(pbvh, node_index, prim_bbc, offset, count);
       return;
     }
   }
 
-  /* Add two child nodes */
-  pbvh->nodes[node_index].children_offset = pbvh->totnode;
-  pbvh_grow_nodes(pbvh, pbvh->totnode + 2);
-
-  /* Update parent node bounding box */
-  update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
-
   if (!below_leaf_limit) {
-    /* Find axis with widest range of primitive centroids */
     if (!cb) {
       cb = &cb_backing;
       BB_reset(cb);
       for (int i = offset + count - 1; i >= offset; i--) {
-        BB_expand(cb, prim_bbc[pbvh->prim_indices[i]].bcentroid);
+        BB_expand(cb, data->prim_bbc[pbvh->prim_indices[i]].bcentroid);
       }
     }
-    const int axis = BB_widest_axis(cb);
 
-    /* Partition primitives along that axis */
-    end = partition_indices(pbvh->prim_indices,
-                            offset,
-                            offset + count - 1,
-                            axis,
-                            (cb->bmax[axis] + cb->bmin[axis]) * 0.5f,
-                            prim_bbc);
+    /* Partition primitives along the widest axis of the centroids */
+    end = partition_indices_sah(pbvh, data->prim_bbc, cb, offset, count);
   }
   else {
     /* Partition primitives by material */
     end = partition_indices_material(pbvh, offset, offset + count - 1);
   }
 
+  /* Add two child nodes */
+  for (int i = 0; i < 2; i++) {
+    PBVHBuildNode *child = MEM_callocN(sizeof(*child), __func__);
+    child->offset = (i == 0) ? offset : end;
+    child->count = (i == 0) ? end - offset : offset + count - end;
+    node->children[i] = child;
+  }
+
   /* Build children */
-  build_sub(pbvh, pbvh->nodes[node_index].children_offset, NULL, prim_bbc, offset, end - offset);
-  build_sub(pbvh,
-            pbvh->nodes[node_index].children_offset + 1,
-            NULL,
-            prim_bbc,
-            end,
-            offset + count - end);
+  if (node->children[0]->count >= data->task_limit) {
+    BLI_task_pool_push(pool, build_sub_task, node->children[0], false, NULL);
+  }
+  else {
+    build_sub(pool, data, node->children[0], NULL);
+  }
+  build_sub(pool, data, node->children[1], NULL);
+}
+
+static int build_leaves_count(const PBVHBuildNode *node)
+{
+  if (node->children[0] == NULL) {
+    return 1;
+  }
+  return build_leaves_count(node->children[0]) + build_leaves_count(node->children[1]);
+}
+
+/* Add the nodes of the partitioned tree, storing the leaves in build order in r_leaves */
+static void build_nodes_add(PBVH *pbvh, PBVHBuildNode *node, int *r_leaves, int *r_totleaf)
+{
+  PBVHNode *pnode = &pbvh->nodes[node->node_index];
+
+  if (node->children[0] == NULL) {
+    pnode->flag |= PBVH_Leaf;
+    pnode->prim_indices = pbvh->prim_indices + node->offset;
+    pnode->totprim = node->count;
+    r_leaves[(*r_totleaf)++] = node->node_index;
+    return;
+  }
+
+  pnode->children_offset = pbvh->totnode;
+  node->children[0]->node_index = pbvh->totnode;
+  node->children[1]->node_index = pbvh->totnode + 1;
+  pbvh_grow_nodes(pbvh, pbvh->totnode + 2);
+
+  build_nodes_add(pbvh, node->children[0], r_leaves, r_totleaf);
+  build_nodes_add(pbvh, node->children[1], r_leaves, r_totleaf);
+}
+
+/* Update the bounding boxes of interior nodes from their children (leaves are already done)
+ * and free the partitioned tree */
+static void build_nodes_finish(PBVH *pbvh, PBVHBuildNode *node)
+{
+  if (node->children[0] != NULL) {
+    PBVHNode *pnode = &pbvh->nodes[node->node_index];
+
+    BB_reset(&pnode->vb);
+    for (int i = 0; i < 2; i++) {
+      build_nodes_finish(pbvh, node->children[i]);
+      BB_expand_with_bb(&pnode->vb, &pbvh->nodes[pnode->children_offset + i].vb);
+    }
+    pnode->orig_vb = pnode->vb;
+  }
+
+  MEM_freeN(node);
+}
+
+typedef struct PBVHBuildLeafData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+  const int *leaves;
+} PBVHBuildLeafData;
+
+static void pbvh_build_vert_owner_cb(void *__restrict userdata,
+                                     const int leaf_order,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeafData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  const PBVHNode *node = &pbvh->nodes[data->leaves[leaf_order]];
+
+  for (int i = 0; i < node->totprim; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      int *owner = &pbvh->vert_owner[pbvh->mloop[lt->tri[j]].v];
+      /* Atomic minimum, the vertex belongs to the first leaf that uses it. */
+      int old_owner = *owner;
+      while (leaf_order < old_owner) {
+        const int prev_owner = atomic_cas_int32(owner, old_owner, leaf_order);
+        if (prev_owner == old_owner) {
+          break;
+        }
+        old_owner = prev_owner;
+      }
+    }
+  }
+}
+
+static void pbvh_build_leaf_cb(void *__restrict userdata,
+                               const int leaf_order,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeafData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = &pbvh->nodes[data->leaves[leaf_order]];
+
+  /* Still need vb for searches */
+  const int offset = (int)(node->prim_indices - pbvh->prim_indices);
+  update_vb(pbvh, node, data->prim_bbc, offset, node->totprim);
+
+  if (pbvh->looptri) {
+    build_mesh_leaf_node(pbvh, node, leaf_order);
+  }
+  else {
+    build_grid_leaf_node(pbvh, node);
+  }
 }
 
 static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
@@ -552,10 +803,44 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
     }
   }
 
+  PBVHBuildData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+      .task_limit = pbvh->leaf_limit * 4,
+  };
+
+  PBVHBuildNode *root = MEM_callocN(sizeof(*root), __func__);
+  root->count = totprim;
+
+  TaskPool *pool = BLI_task_pool_create(&data, TASK_PRIORITY_HIGH);
+  build_sub(pool, &data, root, cb);
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  int *leaves = MEM_mallocN(sizeof(int) * build_leaves_count(root), __func__);
+  int totleaf = 0;
   pbvh->totnode = 1;
-  build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  build_nodes_add(pbvh, root, leaves, &totleaf);
+
+  PBVHBuildLeafData leaf_data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+      .leaves = leaves,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  if (pbvh->looptri) {
+    BLI_task_parallel_range(0, totleaf, &leaf_data, pbvh_build_vert_owner_cb, &settings);
+  }
+  BLI_task_parallel_range(0, totleaf, &leaf_data, pbvh_build_leaf_cb, &settings);
+
+  build_nodes_finish(pbvh, root);
+  MEM_freeN(leaves);
 }
 
+/** \} */
+
 /**
  * Do a full rebuild with on Mesh data structure.
  *
@@ -583,7 +868,8 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->mloop = mloop;
   pbvh->looptri = looptri;
   pbvh->verts = verts;
-  pbvh->vert_bitmap = BLI_BITMAP_NEW(totvert, "bvh->vert_bitmap");
+  pbvh->vert_owner = MEM_mallocN(sizeof(int) * totvert, "bvh->vert_owner");
+  copy_vn_i(pbvh->vert_owner, totvert, INT_MAX);
   pbvh->totvert = totvert;
   pbvh->leaf_limit = LEAF_LIMIT;
   pbvh->vdata = vdata;
@@ -619,7 +905,7 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   }
 
   MEM_freeN(prim_bbc);
-  MEM_freeN(pbvh->vert_bitmap);
+  MEM_freeN(pbvh->vert_owner);
 }
 
 /* Do a full rebuild with on Grids data structure */
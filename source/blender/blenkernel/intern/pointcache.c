@@ -1532,7 +1532,7 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
       /* do nothing */
     }
     else {
-      in = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
+      in = (unsigned char *)MEM_mallocN(sizeof(unsigned char) * in_len,
                                         "pointcache_compressed_buffer");
       ptcache_file_read(pf, in, in_len, sizeof(unsigned char));
 #ifdef WITH_LZO
@@ -1640,31 +1640,92 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot,
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
+/* Size of one point in an uncompressed file, where the data types are interleaved. */
+static unsigned int ptcache_file_point_size(unsigned int data_types)
 {
-  int i;
+  unsigned int point_size = 0;
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      point_size += ptcache_data_size[i];
     }
   }
 
-  return 1;
+  return point_size;
 }
-static int ptcache_file_data_write(PTCacheFile *pf)
+/* Number of points read or written with a single call for uncompressed files. */
+#define PTCACHE_FILE_POINTS_CHUNK 4096
+/* Read all points of an uncompressed file in large blocks,
+ * instead of one read call per point and data type. */
+static int ptcache_file_data_read_mem(PTCacheFile *pf, PTCacheMem *pm)
 {
-  int i;
+  const unsigned int point_size = ptcache_file_point_size(pf->data_types);
+  unsigned char *buffer = MEM_mallocN(
+      (size_t)point_size * MIN2(pm->totpoint, PTCACHE_FILE_POINTS_CHUNK), __func__);
+  int error = 0;
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
+  for (unsigned int start = 0; start < pm->totpoint; start += PTCACHE_FILE_POINTS_CHUNK) {
+    const unsigned int tot = MIN2(pm->totpoint - start, PTCACHE_FILE_POINTS_CHUNK);
+
+    if (!ptcache_file_read(pf, buffer, tot, point_size)) {
+      error = 1;
+      break;
+    }
+
+    const unsigned char *src = buffer;
+    for (unsigned int p = start; p < start + tot; p++) {
+      for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pf->data_types & (1 << i)) {
+          if (pm->data[i]) {
+            memcpy((char *)pm->data[i] + (size_t)p * ptcache_data_size[i],
+                   src,
+                   ptcache_data_size[i]);
+          }
+          src += ptcache_data_size[i];
+        }
+      }
     }
   }
 
-  return 1;
+  MEM_freeN(buffer);
+  return !error;
+}
+/* Write all points to an uncompressed file in large blocks. */
+static int ptcache_file_data_write_mem(PTCacheFile *pf, PTCacheMem *pm)
+{
+  const unsigned int point_size = ptcache_file_point_size(pf->data_types);
+  unsigned char *buffer = MEM_mallocN(
+      (size_t)point_size * MIN2(pm->totpoint, PTCACHE_FILE_POINTS_CHUNK), __func__);
+  int error = 0;
+
+  for (unsigned int start = 0; start < pm->totpoint; start += PTCACHE_FILE_POINTS_CHUNK) {
+    const unsigned int tot = MIN2(pm->totpoint - start, PTCACHE_FILE_POINTS_CHUNK);
+
+    unsigned char *dst = buffer;
+    for (unsigned int p = start; p < start + tot; p++) {
+      for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pf->data_types & (1 << i)) {
+          if (pm->data[i]) {
+            memcpy(dst,
+                   (const char *)pm->data[i] + (size_t)p * ptcache_data_size[i],
+                   ptcache_data_size[i]);
+          }
+          else {
+            memset(dst, 0, ptcache_data_size[i]);
+          }
+          dst += ptcache_data_size[i];
+        }
+      }
+    }
+
+    if (!ptcache_file_write(pf, buffer, tot, point_size)) {
+      error = 1;
+      break;
+    }
+  }
+
+  MEM_freeN(buffer);
+  return !error;
 }
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
@@ -1832,17 +1893,6 @@ static void ptcache_data_free(PTCacheMem *pm)
     }
   }
 }
-static void ptcache_data_copy(void *from[], void *to[])
-{
-  int i;
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    /* note, durian file 03.4b_comp crashes if to[i] is not tested
-     * its NULL, not sure if this should be fixed elsewhere but for now its needed */
-    if (from[i] && to[i]) {
-      memcpy(to[i], from[i], ptcache_data_size[i]);
-    }
-  }
-}
 
 static void ptcache_extra_free(PTCacheMem *pm)
 {
@@ -1973,19 +2023,8 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_data_read_mem(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2067,7 +2106,7 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           unsigned int in_len = pm->totpoint * ptcache_data_size[i];
-          unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
+          unsigned char *out = (unsigned char *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4,
                                                             "pointcache_lzo_buffer");
           ptcache_file_compressed_write(
               pf, (unsigned char *)(pm->data[i]), in_len, out, pid->cache->compression);
@@ -2075,19 +2114,8 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_data_write_mem(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2104,7 +2132,7 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
       if (pid->cache->compression) {
         unsigned int in_len = extra->totdata * ptcache_extra_datasize[extra->type];
-        unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
+        unsigned char *out = (unsigned char *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4,
                                                           "pointcache_lzo_buffer");
         ptcache_file_compressed_write(
             pf, (unsigned char *)(extra->data), in_len, out, pid->cache->compression);
@@ -1659,8 +1659,12 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+static void rigidbody_update_sim_ob(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    Object *ob,
+                                    RigidBodyOb *rbo,
+                                    ListBase *effectors)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
@@ -1717,10 +1721,7 @@ static void rigidbody_update_sim_ob(
            ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
     EffectorWeights *effector_weights = rbw->effector_weights;
     EffectedPoint epoint;
-    ListBase *effectors;
 
-    /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1733,6 +1734,9 @@ static void rigidbody_update_sim_ob(
 
       pd_point_from_loc(scene, eff_loc, eff_vel, 0, &epoint);
 
+      /* Every body sees the noise of the effectors as if it had its own effector list. */
+      BKE_effectors_reset_random(depsgraph, effectors);
+
       /* Calculate net force of effectors, and apply to sim object:
        * - we use 'central force' since apply force requires a "relative position"
        *   which we don't have... */
@@ -1753,9 +1757,6 @@ static void rigidbody_update_sim_ob(
     else if (G.f & G_DEBUG) {
       printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
     }
-
-    /* cleanup */
-    BKE_effectors_free(effectors);
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1803,6 +1804,11 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Get effectors present in the group specified by effector_weights. Only bodies without a
+   * force field receive forces, so none of them has to be excluded from the list, and it is
+   * created once for all bodies. */
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, rbw->effector_weights);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1852,11 +1858,13 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo, effectors);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  BKE_effectors_free(effectors);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -2690,6 +2690,126 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
   }
 }
 
+typedef struct SceneFrameRangeState {
+  const SceneFrameRangeSettings *settings;
+  Scene *scene;
+  int num_frames;
+  int num_depsgraphs;
+  /* Index of the frame to be passed to the callback next, for ordered evaluation. */
+  int next_frame_index;
+  bool is_stopped;
+  ThreadMutex mutex;
+  ThreadCondition condition;
+} SceneFrameRangeState;
+
+typedef struct SceneFrameRangeThread {
+  SceneFrameRangeState *state;
+  Depsgraph *depsgraph;
+  int index;
+} SceneFrameRangeThread;
+
+static void *scene_graph_evaluate_frame_range_thread(void *thread_v)
+{
+  SceneFrameRangeThread *thread = thread_v;
+  SceneFrameRangeState *state = thread->state;
+  const SceneFrameRangeSettings *settings = state->settings;
+
+  /* Frames are interleaved between dependency graphs, so each of them goes forward in time. */
+  for (int frame_index = thread->index; frame_index < state->num_frames;
+       frame_index += state->num_depsgraphs) {
+    if (state->is_stopped) {
+      break;
+    }
+    const int frame = settings->frame_start + frame_index * settings->frame_step;
+    DEG_evaluate_on_framechange(thread->depsgraph, BKE_scene_frame_to_ctime(state->scene, frame));
+
+    if (settings->ordered) {
+      BLI_mutex_lock(&state->mutex);
+      while (state->next_frame_index != frame_index && !state->is_stopped) {
+        BLI_condition_wait(&state->condition, &state->mutex);
+      }
+      BLI_mutex_unlock(&state->mutex);
+      if (state->is_stopped) {
+        break;
+      }
+    }
+
+    const bool do_continue = settings->evaluated_fn(thread->depsgraph, frame, settings->user_data);
+
+    if (settings->ordered || !do_continue) {
+      BLI_mutex_lock(&state->mutex);
+      state->next_frame_index++;
+      if (!do_continue) {
+        state->is_stopped = true;
+      }
+      BLI_condition_notify_all(&state->condition);
+      BLI_mutex_unlock(&state->mutex);
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Evaluate frames of the given range with multiple dependency graphs in parallel, passing each
+ * evaluated frame to the callback of the settings.
+ *
+ * The dependency graphs are not active, so nothing is written back to the original data, and
+ * frame change handlers are not run. Data which depends on the evaluation of previous frames
+ * (simulations, point caches) must be baked beforehand.
+ */
+void BKE_scene_graph_evaluate_frame_range(Main *bmain,
+                                          Scene *scene,
+                                          ViewLayer *view_layer,
+                                          const SceneFrameRangeSettings *settings)
+{
+  BLI_assert(settings->frame_step > 0);
+  if (settings->frame_end < settings->frame_start) {
+    return;
+  }
+
+  SceneFrameRangeState state = {NULL};
+  state.settings = settings;
+  state.scene = scene;
+  state.num_frames = (settings->frame_end - settings->frame_start) / settings->frame_step + 1;
+  state.num_depsgraphs = (settings->num_depsgraphs > 0) ? settings->num_depsgraphs :
+                                                          BLI_system_thread_count();
+  state.num_depsgraphs = min_ii(state.num_depsgraphs, state.num_frames);
+  BLI_mutex_init(&state.mutex);
+  BLI_condition_init(&state.condition);
+
+  /* Building registers the dependency graphs in main, so it is done from this thread. */
+  const eEvaluationMode mode = settings->for_render ? DAG_EVAL_RENDER : DAG_EVAL_VIEWPORT;
+  SceneFrameRangeThread *threads = MEM_calloc_arrayN(
+      state.num_depsgraphs, sizeof(*threads), "SceneFrameRangeThread");
+  for (int i = 0; i < state.num_depsgraphs; i++) {
+    threads[i].state = &state;
+    threads[i].index = i;
+    threads[i].depsgraph = DEG_graph_new(bmain, scene, view_layer, mode);
+    DEG_debug_name_set(threads[i].depsgraph, "FRAME RANGE");
+    if (settings->build_fn != NULL) {
+      settings->build_fn(threads[i].depsgraph, settings->user_data);
+    }
+    else {
+      DEG_graph_build_from_view_layer(threads[i].depsgraph);
+    }
+  }
+
+  ListBase threadbase;
+  BLI_threadpool_init(
+      &threadbase, scene_graph_evaluate_frame_range_thread, state.num_depsgraphs);
+  for (int i = 0; i < state.num_depsgraphs; i++) {
+    BLI_threadpool_insert(&threadbase, &threads[i]);
+  }
+  BLI_threadpool_end(&threadbase);
+
+  for (int i = 0; i < state.num_depsgraphs; i++) {
+    DEG_graph_free(threads[i].depsgraph);
+  }
+  MEM_freeN(threads);
+  BLI_condition_end(&state.condition);
+  BLI_mutex_end(&state.mutex);
+}
+
 /**
  * Ensures given scene/view_layer pair has a valid, up-to-date depsgraph.
  *
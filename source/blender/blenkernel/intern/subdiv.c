@@ -27,6 +27,9 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_hash.h"
+#include "BLI_listbase.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -96,6 +99,135 @@ bool BKE_subdiv_settings_equal(const SubdivSettings *settings_a, const SubdivSet
           settings_a->fvar_linear_interpolation == settings_b->fvar_linear_interpolation);
 }
 
+/* ============================ TOPOLOGY SHARING ============================ */
+
+/* Topology refiners which are used by multiple subdivision surfaces with the same settings and
+ * topology, for example by copies of the same character.
+ *
+ * Only refiners which are already refined are shared: after refinement the refiner is only read
+ * from, so multiple evaluators can be created from it in parallel. Entries only exist while the
+ * refiner has users, so no memory is kept around. */
+typedef struct SharedTopologyRefiner {
+  struct SharedTopologyRefiner *next, *prev;
+  struct OpenSubdiv_TopologyRefiner *topology_refiner;
+  SubdivSettings settings;
+  uint topology_hash;
+  int num_users;
+} SharedTopologyRefiner;
+
+static ListBase shared_topology_refiners = {NULL, NULL};
+static ThreadMutex shared_topology_refiners_lock = BLI_MUTEX_INITIALIZER;
+
+BLI_INLINE uint hash_float(uint hash, const float value)
+{
+  union {
+    float f;
+    uint i;
+  } value_bits = {value};
+  return BLI_hash_int_2d(hash, value_bits.i);
+}
+
+/* Hash of the topology described by the converter. Collisions are fine, topology is compared
+ * in full before a refiner is shared. */
+static uint subdiv_converter_topology_hash(const OpenSubdiv_Converter *converter)
+{
+  const int num_vertices = converter->getNumVertices(converter);
+  const int num_edges = converter->getNumEdges(converter);
+  const int num_faces = converter->getNumFaces(converter);
+  uint hash = BLI_hash_int_2d(BLI_hash_int_2d(num_vertices, num_edges), num_faces);
+  hash = BLI_hash_int_2d(hash, converter->getNumUVLayers(converter));
+
+  int *face_vertices = NULL;
+  int face_vertices_size = 0;
+  for (int face_index = 0; face_index < num_faces; face_index++) {
+    const int num_face_vertices = converter->getNumFaceVertices(converter, face_index);
+    if (num_face_vertices > face_vertices_size) {
+      MEM_SAFE_FREE(face_vertices);
+      face_vertices = MEM_malloc_arrayN(num_face_vertices, sizeof(int), __func__);
+      face_vertices_size = num_face_vertices;
+    }
+    converter->getFaceVertices(converter, face_index, face_vertices);
+    hash = BLI_hash_int_2d(hash, num_face_vertices);
+    for (int i = 0; i < num_face_vertices; i++) {
+      hash = BLI_hash_int_2d(hash, face_vertices[i]);
+    }
+  }
+  MEM_SAFE_FREE(face_vertices);
+
+  for (int edge_index = 0; edge_index < num_edges; edge_index++) {
+    int edge_vertices[2];
+    converter->getEdgeVertices(converter, edge_index, edge_vertices);
+    hash = BLI_hash_int_2d(hash, edge_vertices[0]);
+    hash = BLI_hash_int_2d(hash, edge_vertices[1]);
+    hash = hash_float(hash, converter->getEdgeSharpness(converter, edge_index));
+  }
+  for (int vertex_index = 0; vertex_index < num_vertices; vertex_index++) {
+    if (converter->isInfiniteSharpVertex(converter, vertex_index)) {
+      hash = BLI_hash_int_2d(hash, 1);
+    }
+    else {
+      hash = hash_float(hash, converter->getVertexSharpness(converter, vertex_index));
+    }
+  }
+  return hash;
+}
+
+/* Find a shared refiner for the given settings and topology, and add a user to it. */
+static struct OpenSubdiv_TopologyRefiner *subdiv_shared_topology_refiner_acquire(
+    const SubdivSettings *settings, OpenSubdiv_Converter *converter, const uint topology_hash)
+{
+  struct OpenSubdiv_TopologyRefiner *topology_refiner = NULL;
+  BLI_mutex_lock(&shared_topology_refiners_lock);
+  LISTBASE_FOREACH (SharedTopologyRefiner *, shared, &shared_topology_refiners) {
+    if (shared->topology_hash == topology_hash &&
+        BKE_subdiv_settings_equal(&shared->settings, settings) &&
+        openSubdiv_topologyRefinerCompareWithConverter(shared->topology_refiner, converter)) {
+      shared->num_users++;
+      topology_refiner = shared->topology_refiner;
+      break;
+    }
+  }
+  BLI_mutex_unlock(&shared_topology_refiners_lock);
+  return topology_refiner;
+}
+
+void BKE_subdiv_topology_refiner_share(Subdiv *subdiv)
+{
+  if (subdiv->is_topology_refiner_shared || subdiv->topology_refiner == NULL) {
+    return;
+  }
+  SharedTopologyRefiner *shared = MEM_callocN(sizeof(*shared), __func__);
+  shared->topology_refiner = subdiv->topology_refiner;
+  shared->settings = subdiv->settings;
+  shared->topology_hash = subdiv->topology_hash;
+  shared->num_users = 1;
+  BLI_mutex_lock(&shared_topology_refiners_lock);
+  BLI_addtail(&shared_topology_refiners, shared);
+  BLI_mutex_unlock(&shared_topology_refiners_lock);
+  subdiv->is_topology_refiner_shared = true;
+}
+
+/* Remove a user from the shared refiner, the refiner is freed when it has no users left. */
+static void subdiv_shared_topology_refiner_release(
+    struct OpenSubdiv_TopologyRefiner *topology_refiner)
+{
+  bool do_free = false;
+  BLI_mutex_lock(&shared_topology_refiners_lock);
+  LISTBASE_FOREACH (SharedTopologyRefiner *, shared, &shared_topology_refiners) {
+    if (shared->topology_refiner == topology_refiner) {
+      if (--shared->num_users == 0) {
+        BLI_freelinkN(&shared_topology_refiners, shared);
+        do_free = true;
+      }
+      break;
+    }
+  }
+  BLI_mutex_unlock(&shared_topology_refiners_lock);
+  if (do_free) {
+    openSubdiv_deleteTopologyRefiner(topology_refiner);
+  }
+}
+
 /* ============================== CONSTRUCTION ============================== */
 
 /* Creation from scratch. */
@@ -110,9 +242,17 @@ Subdiv *BKE_subdiv_new_from_converter(const SubdivSettings *settings,
   topology_refiner_settings.level = settings->level;
   topology_refiner_settings.is_adaptive = settings->is_adaptive;
   struct OpenSubdiv_TopologyRefiner *osd_topology_refiner = NULL;
+  bool is_topology_refiner_shared = false;
+  uint topology_hash = 0;
   if (converter->getNumVertices(converter) != 0) {
-    osd_topology_refiner = openSubdiv_createTopologyRefinerFromConverter(
-        converter, &topology_refiner_settings);
+    topology_hash = subdiv_converter_topology_hash(converter);
+    osd_topology_refiner = subdiv_shared_topology_refiner_acquire(
+        settings, converter, topology_hash);
+    is_topology_refiner_shared = (osd_topology_refiner != NULL);
+    if (osd_topology_refiner == NULL) {
+      osd_topology_refiner = openSubdiv_createTopologyRefinerFromConverter(
+          converter, &topology_refiner_settings);
+    }
   }
   else {
     /* TODO(sergey): Check whether original geometry had any vertices.
@@ -124,6 +264,8 @@ Subdiv *BKE_subdiv_new_from_converter(const SubdivSettings *settings,
   subdiv->topology_refiner = osd_topology_refiner;
   subdiv->evaluator = NULL;
   subdiv->displacement_evaluator = NULL;
+  subdiv->topology_hash = topology_hash;
+  subdiv->is_topology_refiner_shared = is_topology_refiner_shared;
   BKE_subdiv_stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
   subdiv->stats = stats;
   return subdiv;
@@ -192,7 +334,12 @@ void BKE_subdiv_free(Subdiv *subdiv)
     openSubdiv_deleteEvaluator(subdiv->evaluator);
   }
   if (subdiv->topology_refiner != NULL) {
-    openSubdiv_deleteTopologyRefiner(subdiv->topology_refiner);
+    if (subdiv->is_topology_refiner_shared) {
+      subdiv_shared_topology_refiner_release(subdiv->topology_refiner);
+    }
+    else {
+      openSubdiv_deleteTopologyRefiner(subdiv->topology_refiner);
+    }
   }
   BKE_subdiv_displacement_detach(subdiv);
   if (subdiv->cache_.face_ptex_offset != NULL) {
@@ -28,6 +28,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_bitmap.h"
 #include "BLI_math_bits.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
@@ -46,6 +47,11 @@
 
 static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key);
 
+static void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
+                                                            CCGKey *key,
+                                                            struct CCGFace **effected_faces,
+                                                            int num_effected_faces);
+
 static void subdiv_ccg_average_inner_face_grids(SubdivCCG *subdiv_ccg,
                                                 CCGKey *key,
                                                 SubdivCCGFace *face);
@@ -889,11 +895,10 @@ void BKE_subdiv_ccg_update_normals(SubdivCCG *subdiv_ccg,
     return;
   }
   subdiv_ccg_recalc_modified_inner_grid_normals(subdiv_ccg, effected_faces, num_effected_faces);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
   CCGKey key;
   BKE_subdiv_ccg_key_top_level(&key, subdiv_ccg);
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  subdiv_ccg_average_faces_boundaries_and_corners(
+      subdiv_ccg, &key, effected_faces, num_effected_faces);
 }
 
 /** \} */
@@ -1032,6 +1037,9 @@ static void subdiv_ccg_average_inner_grids_task(void *__restrict userdata_v,
 typedef struct AverageGridsBoundariesData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+
+  /* Optional lookup table. Maps task index to index in `subdiv_ccg->adjacent_edges`. */
+  const int *adjacent_edge_index_map;
 } AverageGridsBoundariesData;
 
 typedef struct AverageGridsBoundariesTLSData {
@@ -1086,7 +1094,10 @@ static void subdiv_ccg_average_grids_boundaries_task(void *__restrict userdata_v
   AverageGridsBoundariesTLSData *tls = tls_v->userdata_chunk;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
-  SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[adjacent_edge_index];
+  const int edge_index = data->adjacent_edge_index_map ?
+                             data->adjacent_edge_index_map[adjacent_edge_index] :
+                             adjacent_edge_index;
+  SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[edge_index];
   subdiv_ccg_average_grids_boundary(subdiv_ccg, key, adjacent_edge, tls);
 }
 
@@ -1100,6 +1111,9 @@ static void subdiv_ccg_average_grids_boundaries_free(const void *__restrict UNUS
 typedef struct AverageGridsCornerData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+
+  /* Optional lookup table. Maps task index to index in `subdiv_ccg->adjacent_vertices`. */
+  const int *adjacent_vert_index_map;
 } AverageGridsCornerData;
 
 static void subdiv_ccg_average_grids_corners(SubdivCCG *subdiv_ccg,
@@ -1134,39 +1148,50 @@ static void subdiv_ccg_average_grids_corners_task(void *__restrict userdata_v,
   AverageGridsCornerData *data = userdata_v;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
-  SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[adjacent_vertex_index];
+  const int vertex_index = data->adjacent_vert_index_map ?
+                               data->adjacent_vert_index_map[adjacent_vertex_index] :
+                               adjacent_vertex_index;
+  SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[vertex_index];
   subdiv_ccg_average_grids_corners(subdiv_ccg, key, adjacent_vertex);
 }
 
-static void subdiv_ccg_average_all_boundaries(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_boundaries(SubdivCCG *subdiv_ccg,
+                                          CCGKey *key,
+                                          const int *adjacent_edge_index_map,
+                                          int num_adjacent_edges)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsBoundariesData boundaries_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .adjacent_edge_index_map = adjacent_edge_index_map,
   };
   AverageGridsBoundariesTLSData tls_data = {NULL};
   parallel_range_settings.userdata_chunk = &tls_data;
   parallel_range_settings.userdata_chunk_size = sizeof(tls_data);
   parallel_range_settings.func_free = subdiv_ccg_average_grids_boundaries_free;
   BLI_task_parallel_range(0,
-                          subdiv_ccg->num_adjacent_edges,
+                          num_adjacent_edges,
                           &boundaries_data,
                           subdiv_ccg_average_grids_boundaries_task,
                           &parallel_range_settings);
 }
 
-static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_corners(SubdivCCG *subdiv_ccg,
+                                       CCGKey *key,
+                                       const int *adjacent_vert_index_map,
+                                       int num_adjacent_vertices)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsCornerData corner_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .adjacent_vert_index_map = adjacent_vert_index_map,
   };
   BLI_task_parallel_range(0,
-                          subdiv_ccg->num_adjacent_vertices,
+                          num_adjacent_vertices,
                           &corner_data,
                           subdiv_ccg_average_grids_corners_task,
                           &parallel_range_settings);
@@ -1174,8 +1199,95 @@ static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 
 static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 {
-  subdiv_ccg_average_all_boundaries(subdiv_ccg, key);
-  subdiv_ccg_average_all_corners(subdiv_ccg, key);
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, NULL, subdiv_ccg->num_adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, NULL, subdiv_ccg->num_adjacent_vertices);
+}
+
+/* Gather indices of the coarse edges and vertices which are used by any of the given faces,
+ * each index only once. */
+static void subdiv_ccg_affected_face_adjacency(SubdivCCG *subdiv_ccg,
+                                               struct CCGFace **effected_faces,
+                                               int num_effected_faces,
+                                               int **r_adjacent_edge_indices,
+                                               int *r_num_adjacent_edges,
+                                               int **r_adjacent_vert_indices,
+                                               int *r_num_adjacent_vertices)
+{
+  Subdiv *subdiv = subdiv_ccg->subdiv;
+  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
+
+  BLI_bitmap *adjacent_edge_used = BLI_BITMAP_NEW(subdiv_ccg->num_adjacent_edges, __func__);
+  BLI_bitmap *adjacent_vert_used = BLI_BITMAP_NEW(subdiv_ccg->num_adjacent_vertices, __func__);
+  int *adjacent_edge_indices = MEM_malloc_arrayN(
+      max_ii(subdiv_ccg->num_adjacent_edges, 1), sizeof(int), __func__);
+  int *adjacent_vert_indices = MEM_malloc_arrayN(
+      max_ii(subdiv_ccg->num_adjacent_vertices, 1), sizeof(int), __func__);
+  int num_adjacent_edges = 0;
+  int num_adjacent_vertices = 0;
+
+  StaticOrHeapIntStorage face_vertices_storage;
+  StaticOrHeapIntStorage face_edges_storage;
+  static_or_heap_storage_init(&face_vertices_storage);
+  static_or_heap_storage_init(&face_edges_storage);
+
+  for (int i = 0; i < num_effected_faces; i++) {
+    SubdivCCGFace *face = (SubdivCCGFace *)effected_faces[i];
+    const int face_index = face - subdiv_ccg->faces;
+    const int num_face_grids = face->num_grids;
+    /* Edges and vertices of a face are in the same order as its grids. */
+    int *face_vertices = static_or_heap_storage_get(&face_vertices_storage, num_face_grids);
+    topology_refiner->getFaceVertices(topology_refiner, face_index, face_vertices);
+    int *face_edges = static_or_heap_storage_get(&face_edges_storage, num_face_grids);
+    topology_refiner->getFaceEdges(topology_refiner, face_index, face_edges);
+    for (int corner = 0; corner < num_face_grids; corner++) {
+      const int vertex_index = face_vertices[corner];
+      const int edge_index = face_edges[corner];
+      if (!BLI_BITMAP_TEST(adjacent_vert_used, vertex_index)) {
+        BLI_BITMAP_ENABLE(adjacent_vert_used, vertex_index);
+        adjacent_vert_indices[num_adjacent_vertices++] = vertex_index;
+      }
+      if (!BLI_BITMAP_TEST(adjacent_edge_used, edge_index)) {
+        BLI_BITMAP_ENABLE(adjacent_edge_used, edge_index);
+        adjacent_edge_indices[num_adjacent_edges++] = edge_index;
+      }
+    }
+  }
+
+  static_or_heap_storage_free(&face_vertices_storage);
+  static_or_heap_storage_free(&face_edges_storage);
+  MEM_freeN(adjacent_edge_used);
+  MEM_freeN(adjacent_vert_used);
+
+  *r_adjacent_edge_indices = adjacent_edge_indices;
+  *r_num_adjacent_edges = num_adjacent_edges;
+  *r_adjacent_vert_indices = adjacent_vert_indices;
+  *r_num_adjacent_vertices = num_adjacent_vertices;
+}
+
+/* Average boundaries and corners of the given faces only.
+ *
+ * Boundaries of the other faces were averaged already and their elements are not changed, so
+ * this gives the same result as averaging all of them. */
+static void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
+                                                            CCGKey *key,
+                                                            struct CCGFace **effected_faces,
+                                                            int num_effected_faces)
+{
+  int *adjacent_edge_indices, *adjacent_vert_indices;
+  int num_adjacent_edges, num_adjacent_vertices;
+  subdiv_ccg_affected_face_adjacency(subdiv_ccg,
+                                     effected_faces,
+                                     num_effected_faces,
+                                     &adjacent_edge_indices,
+                                     &num_adjacent_edges,
+                                     &adjacent_vert_indices,
+                                     &num_adjacent_vertices);
+
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, adjacent_edge_indices, num_adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, adjacent_vert_indices, num_adjacent_vertices);
+
+  MEM_freeN(adjacent_edge_indices);
+  MEM_freeN(adjacent_vert_indices);
 }
 
 void BKE_subdiv_ccg_average_grids(SubdivCCG *subdiv_ccg)
@@ -1236,9 +1348,8 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG *subdiv_ccg,
                           &data,
                           subdiv_ccg_stitch_face_inner_grids_task,
                           &parallel_range_settings);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  subdiv_ccg_average_faces_boundaries_and_corners(
+      subdiv_ccg, &key, effected_faces, num_effected_faces);
 }
 
 void BKE_subdiv_ccg_topology_counters(const SubdivCCG *subdiv_ccg,
@@ -35,6 +35,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_evaluator_capi.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
@@ -53,6 +54,7 @@ bool BKE_subdiv_eval_begin(Subdiv *subdiv)
     if (subdiv->evaluator == NULL) {
       return false;
     }
+    BKE_subdiv_topology_refiner_share(subdiv);
   }
   else {
     /* TODO(sergey): Check for topology change. */
@@ -208,6 +210,47 @@ void BKE_subdiv_eval_limit_point_and_derivatives(Subdiv *subdiv,
   }
 }
 
+void BKE_subdiv_eval_limit_points_and_derivatives(Subdiv *subdiv,
+                                                  const int ptex_face_index,
+                                                  const float (*uvs)[2],
+                                                  const int num_points,
+                                                  float (*r_P)[3],
+                                                  float (*r_dPdu)[3],
+                                                  float (*r_dPdv)[3])
+{
+  BLI_assert((r_dPdu == NULL) == (r_dPdv == NULL));
+  OpenSubdiv_PatchCoord patch_coords_stack[64];
+  OpenSubdiv_PatchCoord *patch_coords = patch_coords_stack;
+  if (num_points > ARRAY_SIZE(patch_coords_stack)) {
+    patch_coords = MEM_malloc_arrayN(num_points, sizeof(*patch_coords), __func__);
+  }
+  for (int i = 0; i < num_points; i++) {
+    patch_coords[i].ptex_face = ptex_face_index;
+    patch_coords[i].u = uvs[i][0];
+    patch_coords[i].v = uvs[i][1];
+  }
+  subdiv->evaluator->evaluatePatchesLimit(subdiv->evaluator,
+                                          patch_coords,
+                                          num_points,
+                                          (float *)r_P,
+                                          (float *)r_dPdu,
+                                          (float *)r_dPdv);
+  if (patch_coords != patch_coords_stack) {
+    MEM_freeN(patch_coords);
+  }
+
+  /* Degenerate derivatives are handled by stepping inside of the face, same as for the single
+   * point evaluation. */
+  if (r_dPdu != NULL) {
+    for (int i = 0; i < num_points; i++) {
+      if ((is_zero_v3(r_dPdu[i]) || is_zero_v3(r_dPdv[i])) || equals_v3v3(r_dPdu[i], r_dPdv[i])) {
+        BKE_subdiv_eval_limit_point_and_derivatives(
+            subdiv, ptex_face_index, uvs[i][0], uvs[i][1], r_P[i], r_dPdu[i], r_dPdv[i]);
+      }
+    }
+  }
+}
+
 void BKE_subdiv_eval_limit_point_and_normal(Subdiv *subdiv,
                                             const int ptex_face_index,
                                             const float u,
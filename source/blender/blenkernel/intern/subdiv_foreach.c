@@ -636,6 +636,15 @@ static void subdiv_foreach_inner_vertices_regular(SubdivForeachTaskContext *ctx,
   const int ptex_face_index = ctx->face_ptex_offset[coarse_poly_index];
   const int start_vertex_index = ctx->subdiv_vertex_offset[coarse_poly_index];
   int subdiv_vertex_index = ctx->vertices_inner_offset + start_vertex_index;
+  if (ctx->foreach_context->vertices_inner_grid != NULL) {
+    ctx->foreach_context->vertices_inner_grid(ctx->foreach_context,
+                                              tls,
+                                              ptex_face_index,
+                                              resolution,
+                                              coarse_poly_index,
+                                              subdiv_vertex_index);
+    return;
+  }
   for (int y = 1; y < resolution - 1; y++) {
     const float v = y * inv_resolution_1;
     for (int x = 1; x < resolution - 1; x++, subdiv_vertex_index++) {
@@ -435,6 +435,13 @@ typedef struct SubdivMeshTLS {
   LoopsForInterpolation loop_interpolation;
   const MPoly *loop_interpolation_coarse_poly;
   int loop_interpolation_coarse_corner;
+
+  /* Buffers for batched evaluation of inner vertices of a ptex face. */
+  int grid_buffer_size;
+  float (*grid_uvs)[2];
+  float (*grid_P)[3];
+  float (*grid_dPdu)[3];
+  float (*grid_dPdv)[3];
 } SubdivMeshTLS;
 
 static void subdiv_mesh_tls_free(void *tls_v)
@@ -446,6 +453,26 @@ static void subdiv_mesh_tls_free(void *tls_v)
   if (tls->loop_interpolation_initialized) {
     loop_interpolation_end(&tls->loop_interpolation);
   }
+  MEM_SAFE_FREE(tls->grid_uvs);
+  MEM_SAFE_FREE(tls->grid_P);
+  MEM_SAFE_FREE(tls->grid_dPdu);
+  MEM_SAFE_FREE(tls->grid_dPdv);
+}
+
+static void subdiv_mesh_tls_grid_buffers_ensure(SubdivMeshTLS *tls, const int num_points)
+{
+  if (tls->grid_buffer_size >= num_points) {
+    return;
+  }
+  MEM_SAFE_FREE(tls->grid_uvs);
+  MEM_SAFE_FREE(tls->grid_P);
+  MEM_SAFE_FREE(tls->grid_dPdu);
+  MEM_SAFE_FREE(tls->grid_dPdv);
+  tls->grid_uvs = MEM_malloc_arrayN(num_points, sizeof(*tls->grid_uvs), "grid uvs");
+  tls->grid_P = MEM_malloc_arrayN(num_points, sizeof(*tls->grid_P), "grid P");
+  tls->grid_dPdu = MEM_malloc_arrayN(num_points, sizeof(*tls->grid_dPdu), "grid dPdu");
+  tls->grid_dPdv = MEM_malloc_arrayN(num_points, sizeof(*tls->grid_dPdv), "grid dPdv");
+  tls->grid_buffer_size = num_points;
 }
 
 /** \} */
@@ -797,6 +824,63 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
 }
 
+static void subdiv_mesh_vertices_inner_grid(const SubdivForeachContext *foreach_context,
+                                            void *tls_v,
+                                            const int ptex_face_index,
+                                            const int resolution,
+                                            const int coarse_poly_index,
+                                            const int start_subdiv_vertex_index)
+{
+  SubdivMeshContext *ctx = foreach_context->user_data;
+  SubdivMeshTLS *tls = tls_v;
+  Subdiv *subdiv = ctx->subdiv;
+  const Mesh *coarse_mesh = ctx->coarse_mesh;
+  const MPoly *coarse_poly = &coarse_mesh->mpoly[coarse_poly_index];
+  MVert *subdiv_mvert = ctx->subdiv_mesh->mvert;
+  const int grid_size = resolution - 2;
+  const int num_points = grid_size * grid_size;
+  if (num_points == 0) {
+    return;
+  }
+  subdiv_mesh_tls_grid_buffers_ensure(tls, num_points);
+  const float inv_resolution_1 = 1.0f / (float)(resolution - 1);
+  for (int y = 0, i = 0; y < grid_size; y++) {
+    for (int x = 0; x < grid_size; x++, i++) {
+      tls->grid_uvs[i][0] = (x + 1) * inv_resolution_1;
+      tls->grid_uvs[i][1] = (y + 1) * inv_resolution_1;
+    }
+  }
+  BKE_subdiv_eval_limit_points_and_derivatives(subdiv,
+                                               ptex_face_index,
+                                               (const float(*)[2])tls->grid_uvs,
+                                               num_points,
+                                               tls->grid_P,
+                                               tls->grid_dPdu,
+                                               tls->grid_dPdv);
+  subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, 0);
+  for (int i = 0; i < num_points; i++) {
+    const float u = tls->grid_uvs[i][0];
+    const float v = tls->grid_uvs[i][1];
+    MVert *subdiv_vert = &subdiv_mvert[start_subdiv_vertex_index + i];
+    subdiv_vertex_data_interpolate(ctx, subdiv_vert, &tls->vertex_interpolation, u, v);
+    /* Matches eval_final_point_and_vertex_normal(). */
+    if (subdiv->displacement_evaluator == NULL) {
+      float N[3];
+      copy_v3_v3(subdiv_vert->co, tls->grid_P[i]);
+      cross_v3_v3v3(N, tls->grid_dPdu[i], tls->grid_dPdv[i]);
+      normalize_v3(N);
+      normal_float_to_short_v3(subdiv_vert->no, N);
+    }
+    else {
+      float D[3];
+      BKE_subdiv_eval_displacement(
+          subdiv, ptex_face_index, u, v, tls->grid_dPdu[i], tls->grid_dPdv[i], D);
+      add_v3_v3v3(subdiv_vert->co, tls->grid_P[i], D);
+    }
+    subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1178,6 +1262,7 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
   foreach_context->vertex_corner = subdiv_mesh_vertex_corner;
   foreach_context->vertex_edge = subdiv_mesh_vertex_edge;
   foreach_context->vertex_inner = subdiv_mesh_vertex_inner;
+  foreach_context->vertices_inner_grid = subdiv_mesh_vertices_inner_grid;
   foreach_context->edge = subdiv_mesh_edge;
   foreach_context->loop = subdiv_mesh_loop;
   foreach_context->poly = subdiv_mesh_poly;
@@ -439,16 +439,42 @@ static void autotrack_context_step_cb(void *__restrict userdata,
   atomic_fetch_and_or_uint8((uint8_t *)&context->step_ok, true);
 }
 
+static void autotrack_context_prefetch_cb(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  AutoTrackContext *context = BLI_task_pool_user_data(pool);
+  const int frame_delta = context->backwards ? -1 : 1;
+
+  for (int clip_index = 0; clip_index < context->num_clips; clip_index++) {
+    const int frame = BKE_movieclip_remap_scene_to_clip_frame(context->clips[clip_index],
+                                                              context->user.framenr);
+    /* Frame which the next step tracks to. */
+    tracking_image_accessor_prefetch_frame(
+        context->image_accessor, clip_index, frame + 2 * frame_delta);
+  }
+}
+
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   const int frame_delta = context->backwards ? -1 : 1;
   context->step_ok = false;
 
+  /* Read the frame needed by the next step while tracks are tracked in this one. */
+  TaskPool *prefetch_pool = NULL;
+  if (context->sequence) {
+    prefetch_pool = BLI_task_pool_create_background(context, TASK_PRIORITY_LOW);
+    BLI_task_pool_push(prefetch_pool, autotrack_context_prefetch_cb, NULL, false, NULL);
+  }
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (context->num_tracks > 1);
   BLI_task_parallel_range(0, context->num_tracks, context, autotrack_context_step_cb, &settings);
 
+  if (prefetch_pool != NULL) {
+    BLI_task_pool_work_and_wait(prefetch_pool);
+    BLI_task_pool_free(prefetch_pool);
+  }
+
   /* Advance the frame. */
   BLI_spin_lock(&context->spin_lock);
   context->user.framenr += frame_delta;
@@ -37,6 +37,7 @@
 #  endif
 
 #  include "BLI_math_base.h"
+#  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_global.h"
@@ -63,6 +64,15 @@
 
 struct StampData;
 
+/* Number of frames in Blender's pixel format that can wait for encoding, rendering blocks once
+ * they are all in use. */
+#  define FFMPEG_ENCODE_QUEUE_SIZE 3
+
+typedef struct FFMpegInputFrame {
+  AVFrame *frame;
+  int pts;
+} FFMpegInputFrame;
+
 typedef struct FFMpegContext {
   int ffmpeg_type;
   int ffmpeg_codec;
@@ -81,12 +91,20 @@ typedef struct FFMpegContext {
   AVFormatContext *outfile;
   AVStream *video_stream;
   AVStream *audio_stream;
-  AVFrame *current_frame; /* Image frame in output pixel format. */
-
-  /* Image frame in Blender's own pixel format, may need conversion to the output pixel format. */
-  AVFrame *img_convert_frame;
+  AVFrame *current_frame; /* Image frame in output pixel format, when conversion is needed. */
   struct SwsContext *img_convert_ctx;
 
+  /* Pixel format conversion and encoding run on a thread of their own, so the next frame is
+   * rendered while the previous ones are encoded. Input frames in Blender's own pixel format
+   * cycle between the free and the encode queue, which bounds the number of frames in flight. */
+  FFMpegInputFrame input_frames[FFMPEG_ENCODE_QUEUE_SIZE];
+  ThreadQueue *encode_queue;
+  ThreadQueue *encode_free_queue;
+  ListBase encode_threads;
+  bool encode_error;
+  /* Video and audio packets are muxed from different threads. */
+  ThreadMutex outfile_mutex;
+
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
   int audio_input_samples;
@@ -232,7 +250,11 @@ static int write_audio_frame(FFMpegContext *context)
 
     pkt.flags |= AV_PKT_FLAG_KEY;
 
-    if (av_interleaved_write_frame(context->outfile, &pkt) != 0) {
+    BLI_mutex_lock(&context->outfile_mutex);
+    const int ret = av_interleaved_write_frame(context->outfile, &pkt);
+    BLI_mutex_unlock(&context->outfile_mutex);
+
+    if (ret != 0) {
       fprintf(stderr, "Error writing audio packet!\n");
       if (frame) {
         av_frame_free(&frame);
@@ -339,9 +361,8 @@ static const char **get_file_extensions(int format)
   }
 }
 
-/* Write a frame to the output file */
-static int write_video_frame(
-    FFMpegContext *context, const RenderData *rd, int cfra, AVFrame *frame, ReportList *reports)
+/* Write a frame to the output file, called from the encode thread. */
+static int write_video_frame(FFMpegContext *context, int cfra, AVFrame *frame)
 {
   int got_output;
   int ret, success = 1;
@@ -371,37 +392,24 @@ static int write_video_frame(
     }
 
     packet.stream_index = context->video_stream->index;
+    BLI_mutex_lock(&context->outfile_mutex);
     ret = av_interleaved_write_frame(context->outfile, &packet);
+    BLI_mutex_unlock(&context->outfile_mutex);
     success = (ret == 0);
   }
   else if (ret < 0) {
     success = 0;
   }
 
-  if (!success) {
-    BKE_report(reports, RPT_ERROR, "Error writing frame");
-  }
-
   return success;
 }
 
-/* read and encode a frame of audio from the buffer */
-static AVFrame *generate_video_frame(FFMpegContext *context,
-                                     const uint8_t *pixels,
-                                     ReportList *reports)
+/* Fill an input frame from the rendered pixels, conversion to the output pixel format is left
+ * to the encode thread. */
+static void generate_video_frame(FFMpegContext *context, const uint8_t *pixels, AVFrame *rgb_frame)
 {
   AVCodecContext *c = context->video_stream->codec;
   int height = c->height;
-  AVFrame *rgb_frame;
-
-  if (context->img_convert_frame != NULL) {
-    /* Pixel format conversion is needed. */
-    rgb_frame = context->img_convert_frame;
-  }
-  else {
-    /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
-  }
 
   /* Copy the Blender pixels into the FFmpeg datastructure, taking care of endianness and flipping
    * the image vertically. */
@@ -428,20 +436,79 @@ static AVFrame *generate_video_frame(FFMpegContext *context,
 #    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
 #  endif
   }
+}
+
+static void *ffmpeg_encode_thread(void *context_v)
+{
+  FFMpegContext *context = context_v;
+  AVCodecContext *c = context->video_stream->codec;
+  FFMpegInputFrame *input;
+
+  while ((input = BLI_thread_queue_pop(context->encode_queue))) {
+    /* After an error the remaining frames are only given back, the error is reported from
+     * BKE_ffmpeg_append. */
+    if (!context->encode_error) {
+      AVFrame *frame = input->frame;
+
+      /* Convert to the output pixel format, if it's different that Blender's internal one. */
+      if (context->img_convert_ctx != NULL) {
+        sws_scale(context->img_convert_ctx,
+                  (const uint8_t *const *)frame->data,
+                  frame->linesize,
+                  0,
+                  c->height,
+                  context->current_frame->data,
+                  context->current_frame->linesize);
+        frame = context->current_frame;
+      }
+
+      if (!write_video_frame(context, input->pts, frame)) {
+        context->encode_error = true;
+      }
+    }
+
+    BLI_thread_queue_push(context->encode_free_queue, input);
+  }
+
+  return NULL;
+}
+
+static void ffmpeg_encode_pipeline_start(FFMpegContext *context)
+{
+  AVCodecContext *c = context->video_stream->codec;
+
+  context->encode_queue = BLI_thread_queue_init();
+  context->encode_free_queue = BLI_thread_queue_init();
+  context->encode_error = false;
+
+  for (int i = 0; i < FFMPEG_ENCODE_QUEUE_SIZE; i++) {
+    context->input_frames[i].frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
+    BLI_thread_queue_push(context->encode_free_queue, &context->input_frames[i]);
+  }
+
+  BLI_threadpool_init(&context->encode_threads, ffmpeg_encode_thread, 1);
+  BLI_threadpool_insert(&context->encode_threads, context);
+}
 
-  /* Convert to the output pixel format, if it's different that Blender's internal one. */
-  if (context->img_convert_frame != NULL) {
-    BLI_assert(context->img_convert_ctx != NULL);
-    sws_scale(context->img_convert_ctx,
-              (const uint8_t *const *)rgb_frame->data,
-              rgb_frame->linesize,
-              0,
-              c->height,
-              context->current_frame->data,
-              context->current_frame->linesize);
+/* Encode all queued frames and stop the encode thread. */
+static void ffmpeg_encode_pipeline_end(FFMpegContext *context)
+{
+  if (context->encode_queue == NULL) {
+    return;
   }
 
-  return context->current_frame;
+  BLI_thread_queue_nowait(context->encode_queue);
+  BLI_threadpool_end(&context->encode_threads);
+
+  BLI_thread_queue_free(context->encode_queue);
+  BLI_thread_queue_free(context->encode_free_queue);
+  context->encode_queue = NULL;
+  context->encode_free_queue = NULL;
+
+  for (int i = 0; i < FFMPEG_ENCODE_QUEUE_SIZE; i++) {
+    delete_picture(context->input_frames[i].frame);
+    context->input_frames[i].frame = NULL;
+  }
 }
 
 static void set_ffmpeg_property_option(AVCodecContext *c,
@@ -733,17 +800,14 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   }
   av_dict_free(&opts);
 
-  /* FFmpeg expects its data in the output pixel format. */
-  context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
-
   if (c->pix_fmt == AV_PIX_FMT_RGBA) {
     /* Output pixel format is the same we use internally, no conversion necessary. */
-    context->img_convert_frame = NULL;
+    context->current_frame = NULL;
     context->img_convert_ctx = NULL;
   }
   else {
-    /* Output pixel format is different, allocate frame for conversion. */
-    context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
+    /* FFmpeg expects its data in the output pixel format, allocate frame for conversion. */
+    context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
     context->img_convert_ctx = sws_getContext(c->width,
                                               c->height,
                                               AV_PIX_FMT_RGBA,
@@ -1136,6 +1200,10 @@ static int start_ffmpeg_impl(FFMpegContext *context,
   av_dump_format(of, 0, name, 1);
   av_dict_free(&opts);
 
+  if (context->video_stream) {
+    ffmpeg_encode_pipeline_start(context);
+  }
+
   return 1;
 
 fail:
@@ -1376,7 +1444,6 @@ int BKE_ffmpeg_append(void *context_v,
                       ReportList *reports)
 {
   FFMpegContext *context = context_v;
-  AVFrame *avframe;
   int success = 1;
 
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, rectx, recty);
@@ -1385,11 +1452,24 @@ int BKE_ffmpeg_append(void *context_v,
   //  write_audio_frames(frame / (((double)rd->frs_sec) / rd->frs_sec_base));
 
   if (context->video_stream) {
-    avframe = generate_video_frame(context, (unsigned char *)pixels, reports);
-    success = (avframe && write_video_frame(context, rd, frame - start_frame, avframe, reports));
+    /* Blocks while all input frames are waiting to be encoded. */
+    FFMpegInputFrame *input = BLI_thread_queue_pop(context->encode_free_queue);
+    generate_video_frame(context, (const uint8_t *)pixels, input->frame);
+    input->pts = frame - start_frame;
+    BLI_thread_queue_push(context->encode_queue, input);
+
+    /* Errors from earlier frames surface here, the encode thread can't report them. */
+    if (context->encode_error) {
+      BKE_report(reports, RPT_ERROR, "Error writing frame");
+      success = 0;
+    }
 
     if (context->ffmpeg_autosplit) {
-      if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
+      BLI_mutex_lock(&context->outfile_mutex);
+      const int64_t file_size = avio_tell(context->outfile->pb);
+      BLI_mutex_unlock(&context->outfile_mutex);
+
+      if (file_size > FFMPEG_AUTOSPLIT_SIZE) {
         end_ffmpeg_impl(context, true);
         context->ffmpeg_autosplit_count++;
         success &= start_ffmpeg_impl(context, rd, rectx, recty, suffix, reports);
@@ -1417,6 +1497,8 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
   }
 #  endif
 
+  ffmpeg_encode_pipeline_end(context);
+
   if (context->video_stream && context->video_stream->codec) {
     PRINT("Flushing delayed frames...\n");
     flush_ffmpeg(context);
@@ -1444,10 +1526,6 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     delete_picture(context->current_frame);
     context->current_frame = NULL;
   }
-  if (context->img_convert_frame != NULL) {
-    delete_picture(context->img_convert_frame);
-    context->img_convert_frame = NULL;
-  }
 
   if (context->outfile != NULL && context->outfile->oformat) {
     if (!(context->outfile->oformat->flags & AVFMT_NOFILE)) {
@@ -1884,6 +1962,7 @@ void *BKE_ffmpeg_context_create(void)
   context->ffmpeg_autosplit_count = 0;
   context->ffmpeg_preview = false;
   context->stamp_data = NULL;
+  BLI_mutex_init(&context->outfile_mutex);
 
   return context;
 }
@@ -1897,6 +1976,7 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
+  BLI_mutex_end(&context->outfile_mutex);
   MEM_freeN(context);
 }
 
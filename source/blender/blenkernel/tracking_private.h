@@ -130,6 +130,14 @@ float *tracking_track_get_mask_for_region(int frame_width,
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+#define MAX_ACCESSOR_FRAMES 4
+
+typedef struct TrackingAccessorFrame {
+  int clip_index;
+  int frame;
+  struct ImBuf *ibuf;
+} TrackingAccessorFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieCache *cache;
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
@@ -139,6 +147,11 @@ typedef struct TrackingImageAccessor {
   int start_frame;
   struct libmv_FrameAccessor *libmv_accessor;
   SpinLock cache_lock;
+
+  /* Original frames shared by all tracks, so that every track doesn't go through the movie clip
+   * cache and its global lock. Protected by cache_lock, replaced in round-robin order. */
+  TrackingAccessorFrame frames[MAX_ACCESSOR_FRAMES];
+  int next_frame_slot;
 } TrackingImageAccessor;
 
 TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR_CLIP],
@@ -147,6 +160,9 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
                                                    int num_tracks,
                                                    int start_frame);
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor);
+void tracking_image_accessor_prefetch_frame(TrackingImageAccessor *accessor,
+                                            int clip_index,
+                                            int frame);
 
 #ifdef __cplusplus
 }
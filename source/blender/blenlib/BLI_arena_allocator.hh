@@ -0,0 +1,114 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * An `ArenaAllocator` is a container allocator (see `BLI_allocator.hh`) that takes its memory
+ * from a `LinearAllocator` (the arena) instead of the guarded allocator. Deallocation does
+ * nothing, all memory is freed at once when the arena is reset or destructed. This avoids the
+ * cost of many small allocations and frees in hot code, e.g. for temporary containers during
+ * an evaluation pass.
+ *
+ * The arena is either passed in explicitly, or it is the arena that is active on the current
+ * thread (see #ScopedThreadArena) when the allocator is constructed. When there is no arena,
+ * the allocator falls back to the guarded allocator, so code using it also works without one:
+ *
+ *   LinearAllocator<> arena;
+ *   {
+ *     ScopedThreadArena scoped_arena(arena);
+ *     Vector<int, 4, ArenaAllocator> vec;
+ *     ...
+ *   }
+ *   arena.reset();
+ *
+ * Since a `LinearAllocator` is not thread-safe, containers using an arena must only grow on the
+ * thread that owns it, and they must not outlive the arena or its next reset.
+ */
+
+#include "BLI_linear_allocator.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+/**
+ * Makes the given arena active on the current thread while this object is alive, so that
+ * `ArenaAllocator`'s constructed in that scope allocate from it. Scopes can be nested.
+ */
+class ScopedThreadArena : NonCopyable, NonMovable {
+ private:
+  LinearAllocator<> *previous_arena_;
+
+ public:
+  ScopedThreadArena(LinearAllocator<> &arena) : previous_arena_(active_ref())
+  {
+    active_ref() = &arena;
+  }
+
+  ~ScopedThreadArena()
+  {
+    active_ref() = previous_arena_;
+  }
+
+  /**
+   * \return The arena that is active on the current thread, or null.
+   */
+  static LinearAllocator<> *active()
+  {
+    return active_ref();
+  }
+
+ private:
+  static LinearAllocator<> *&active_ref()
+  {
+    static thread_local LinearAllocator<> *active_arena = nullptr;
+    return active_arena;
+  }
+};
+
+class ArenaAllocator {
+ private:
+  LinearAllocator<> *arena_;
+
+ public:
+  ArenaAllocator() : arena_(ScopedThreadArena::active())
+  {
+  }
+
+  ArenaAllocator(LinearAllocator<> &arena) : arena_(&arena)
+  {
+  }
+
+  void *allocate(size_t size, size_t alignment, const char *name)
+  {
+    if (arena_ != nullptr) {
+      return arena_->allocate(static_cast<int64_t>(size), static_cast<int64_t>(alignment));
+    }
+    return MEM_mallocN_aligned(size, alignment, name);
+  }
+
+  void deallocate(void *ptr)
+  {
+    /* Memory from the arena is freed all at once. */
+    if (arena_ == nullptr) {
+      MEM_freeN(ptr);
+    }
+  }
+};
+
+}  // namespace blender
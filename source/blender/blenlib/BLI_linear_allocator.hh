@@ -39,6 +39,7 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
   uintptr_t current_begin_;
   uintptr_t current_end_;
   int64_t next_min_alloc_size_;
+  int64_t last_owned_buffer_size_ = 0;
 
 #ifdef DEBUG
   int64_t debug_allocated_amount_ = 0;
@@ -194,6 +195,37 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
     this->provide_buffer(aligned_buffer.ptr(), Size);
   }
 
+  /**
+   * Make the memory owned by this allocator available for new allocations, e.g. to reuse it for
+   * every pass of an evaluation. All memory buffers handed out before become invalid and no
+   * destructors are called. Only the largest buffer is kept, after a few passes it is usually big
+   * enough to hold all allocations. Buffers passed to #provide_buffer are not used anymore.
+   */
+  void reset()
+  {
+    unused_borrowed_buffers_.clear();
+#ifdef DEBUG
+    debug_allocated_amount_ = 0;
+#endif
+
+    if (owned_buffers_.is_empty()) {
+      current_begin_ = 0;
+      current_end_ = 0;
+      return;
+    }
+
+    /* Buffer sizes are increasing, so the last one is the largest. */
+    void *largest_buffer = owned_buffers_.pop_last();
+    for (void *ptr : owned_buffers_) {
+      allocator_.deallocate(ptr);
+    }
+    owned_buffers_.clear();
+    owned_buffers_.append(largest_buffer);
+
+    current_begin_ = (uintptr_t)largest_buffer;
+    current_end_ = current_begin_ + last_owned_buffer_size_;
+  }
+
  private:
   void allocate_new_buffer(int64_t min_allocation_size)
   {
@@ -213,6 +245,7 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
 
     void *buffer = allocator_.allocate(size_in_bytes, 8, AT);
     owned_buffers_.append(buffer);
+    last_owned_buffer_size_ = size_in_bytes;
     current_begin_ = (uintptr_t)buffer;
     current_end_ = current_begin_ + size_in_bytes;
   }
@@ -0,0 +1,124 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * C API for hash tables with pointer keys, wrapping #blender::Map and #blender::Set.
+ *
+ * Unlike #GHash, these use open addressing: entries are stored inline in one array, so there is
+ * no per-entry allocation and no hashing through function pointers. Use them instead of
+ * #BLI_ghash_ptr_new and #BLI_gset_ptr_new in performance sensitive C code.
+ *
+ * Keys are hashed by address, so they should be real pointers and not integers cast to
+ * pointers. Iterators are invalidated by adding keys, removing keys during iteration is fine.
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PtrMap PtrMap;
+typedef struct PtrSet PtrSet;
+
+typedef struct PtrMapIterator {
+  PtrMap *map;
+  /* Storage for the position in the map, only accessed by the implementation. */
+  uint64_t _data[3];
+} PtrMapIterator;
+
+typedef struct PtrSetIterator {
+  const PtrSet *set;
+  /* Storage for the position in the set, only accessed by the implementation. */
+  uint64_t _data[3];
+} PtrSetIterator;
+
+/* -------------------------------------------------------------------- */
+/** \name PtrMap API
+ * \{ */
+
+PtrMap *BLI_ptr_map_new(void) ATTR_WARN_UNUSED_RESULT;
+PtrMap *BLI_ptr_map_new_ex(const unsigned int nentries_reserve) ATTR_WARN_UNUSED_RESULT;
+void BLI_ptr_map_free(PtrMap *map) ATTR_NONNULL(1);
+void BLI_ptr_map_clear(PtrMap *map) ATTR_NONNULL(1);
+unsigned int BLI_ptr_map_len(const PtrMap *map) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
+void BLI_ptr_map_insert(PtrMap *map, const void *key, void *val) ATTR_NONNULL(1);
+bool BLI_ptr_map_add(PtrMap *map, const void *key, void *val) ATTR_NONNULL(1);
+void BLI_ptr_map_reinsert(PtrMap *map, const void *key, void *val) ATTR_NONNULL(1);
+bool BLI_ptr_map_ensure_p(PtrMap *map, const void *key, void ***r_val) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1, 3);
+bool BLI_ptr_map_remove(PtrMap *map, const void *key) ATTR_NONNULL(1);
+
+bool BLI_ptr_map_haskey(const PtrMap *map, const void *key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void *BLI_ptr_map_lookup(const PtrMap *map, const void *key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void *BLI_ptr_map_lookup_default(const PtrMap *map, const void *key, void *val_default)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void **BLI_ptr_map_lookup_p(PtrMap *map, const void *key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+
+void BLI_ptr_map_iter_init(PtrMapIterator *iter, PtrMap *map) ATTR_NONNULL(1, 2);
+void BLI_ptr_map_iter_step(PtrMapIterator *iter) ATTR_NONNULL(1);
+bool BLI_ptr_map_iter_done(const PtrMapIterator *iter) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_ptr_map_iter_key(const PtrMapIterator *iter) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_ptr_map_iter_value(const PtrMapIterator *iter) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void **BLI_ptr_map_iter_value_p(const PtrMapIterator *iter) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+
+#define PTR_MAP_ITER(iter_, map_) \
+  for (BLI_ptr_map_iter_init(&iter_, map_); BLI_ptr_map_iter_done(&iter_) == false; \
+       BLI_ptr_map_iter_step(&iter_))
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name PtrSet API
+ * \{ */
+
+PtrSet *BLI_ptr_set_new(void) ATTR_WARN_UNUSED_RESULT;
+PtrSet *BLI_ptr_set_new_ex(const unsigned int nentries_reserve) ATTR_WARN_UNUSED_RESULT;
+void BLI_ptr_set_free(PtrSet *set) ATTR_NONNULL(1);
+void BLI_ptr_set_clear(PtrSet *set) ATTR_NONNULL(1);
+unsigned int BLI_ptr_set_len(const PtrSet *set) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
+void BLI_ptr_set_insert(PtrSet *set, const void *key) ATTR_NONNULL(1);
+bool BLI_ptr_set_add(PtrSet *set, const void *key) ATTR_NONNULL(1);
+bool BLI_ptr_set_remove(PtrSet *set, const void *key) ATTR_NONNULL(1);
+bool BLI_ptr_set_haskey(const PtrSet *set, const void *key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+
+void BLI_ptr_set_iter_init(PtrSetIterator *iter, const PtrSet *set) ATTR_NONNULL(1, 2);
+void BLI_ptr_set_iter_step(PtrSetIterator *iter) ATTR_NONNULL(1);
+bool BLI_ptr_set_iter_done(const PtrSetIterator *iter) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_ptr_set_iter_key(const PtrSetIterator *iter) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
+#define PTR_SET_ITER(iter_, set_) \
+  for (BLI_ptr_set_iter_init(&iter_, set_); BLI_ptr_set_iter_done(&iter_) == false; \
+       BLI_ptr_set_iter_step(&iter_))
+
+/** \} */
+
+#ifdef __cplusplus
+}
+#endif
@@ -125,18 +125,31 @@ class RandomNumberGenerator {
    */
   void skip(int64_t n)
   {
-    while (n--) {
-      this->step();
+    /* Jump ahead in O(log n) steps, by composing the affine step `x -> a * x + c` with itself.
+     * Arithmetic is modulo 2^64 before masking, which is exact modulo 2^48. */
+    uint64_t step_mult = multiplier;
+    uint64_t step_add = addend;
+    uint64_t skip_mult = 1;
+    uint64_t skip_add = 0;
+    while (n > 0) {
+      if (n & 1) {
+        skip_mult = (skip_mult * step_mult) & mask;
+        skip_add = (skip_add * step_mult + step_add) & mask;
+      }
+      step_add = ((step_mult + 1) * step_add) & mask;
+      step_mult = (step_mult * step_mult) & mask;
+      n >>= 1;
     }
+    x_ = (skip_mult * x_ + skip_add) & mask;
   }
 
  private:
+  static constexpr uint64_t multiplier = 0x5DEECE66Dll;
+  static constexpr uint64_t addend = 0xB;
+  static constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
+
   void step()
   {
-    constexpr uint64_t multiplier = 0x5DEECE66Dll;
-    constexpr uint64_t addend = 0xB;
-    constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
-
     x_ = (multiplier * x_ + addend) & mask;
   }
 };
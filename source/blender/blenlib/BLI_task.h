@@ -296,6 +296,16 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS *tls);
  *    TaskNode *node_3 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  *    TaskNode *node_4 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  *
+ * ** Scheduling Hints **
+ *
+ * When a node finishes, its successors are started ordered by priority and then by the estimated
+ * cost of the longest chain of nodes depending on them (critical path), so expensive work does
+ * not start last. Nodes have a low priority and a cost of 1 by default.
+ * Hints must be set before pushing work.
+ *
+ *    BLI_task_graph_node_priority_set(node_2, TASK_PRIORITY_HIGH);
+ *    BLI_task_graph_node_cost_set(node_3, (float)mesh->totpoly);
+ *
  */
 struct TaskGraph;
 struct TaskNode;
@@ -310,6 +320,8 @@ struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             TaskGraphNodeRunFunction run,
                                             void *user_data,
                                             TaskGraphNodeFreeFunction free_func);
+void BLI_task_graph_node_priority_set(struct TaskNode *task_node, TaskPriority priority);
+void BLI_task_graph_node_cost_set(struct TaskNode *task_node, float cost);
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node);
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node);
 
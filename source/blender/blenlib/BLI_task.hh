@@ -41,8 +41,12 @@
 #  endif
 #endif
 
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_index_range.hh"
+#include "BLI_span.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 namespace blender {
 
@@ -75,4 +79,148 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #endif
 }
 
+/**
+ * Reduce a range to a single value. `function(sub_range, value)` has to return `value` combined
+ * with the result for `sub_range`, and `reduction(a, b)` combines two partial results. Both
+ * have to be associative and `identity` must not change a value it is combined with.
+ */
+template<typename Value, typename Function, typename Reduction>
+Value parallel_reduce(IndexRange range,
+                      int64_t grain_size,
+                      const Value &identity,
+                      const Function &function,
+                      const Reduction &reduction)
+{
+#ifdef WITH_TBB
+  return tbb::parallel_reduce(
+      tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
+      identity,
+      [&](const tbb::blocked_range<int64_t> &subrange, const Value &ident) {
+        return function(IndexRange(subrange.begin(), subrange.size()), ident);
+      },
+      reduction);
+#else
+  UNUSED_VARS(grain_size, reduction);
+  return function(range, identity);
+#endif
+}
+
+/**
+ * Write the exclusive prefix sum of `values` into `r_sums`: `r_sums[i]` is the sum of all values
+ * before `i`, starting at `init`. `r_sums` may be the same memory as `values`.
+ *
+ * \return The total sum (`init` plus all values), which is the value that would follow the last
+ * element, so it can be used directly to fill offset arrays with one more element.
+ */
+template<typename T>
+T parallel_exclusive_scan(Span<T> values, MutableSpan<T> r_sums, int64_t grain_size, T init = T())
+{
+  BLI_assert(values.size() == r_sums.size());
+  const int64_t size = values.size();
+  if (size <= grain_size) {
+    T sum = init;
+    for (const int64_t i : IndexRange(size)) {
+      const T value = values[i];
+      r_sums[i] = sum;
+      sum += value;
+    }
+    return sum;
+  }
+
+  /* Sum all chunks in parallel, then scan the chunk sums and finally each chunk again. */
+  const int64_t chunks_num = (size + grain_size - 1) / grain_size;
+  Array<T> chunk_sums(chunks_num);
+  parallel_for(IndexRange(chunks_num), 1, [&](IndexRange chunk_range) {
+    for (const int64_t chunk : chunk_range) {
+      const IndexRange chunk_indices = IndexRange(size).slice(
+          chunk * grain_size, std::min(grain_size, size - chunk * grain_size));
+      T sum = T();
+      for (const int64_t i : chunk_indices) {
+        sum += values[i];
+      }
+      chunk_sums[chunk] = sum;
+    }
+  });
+
+  T total = init;
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const T chunk_sum = chunk_sums[chunk];
+    chunk_sums[chunk] = total;
+    total += chunk_sum;
+  }
+
+  parallel_for(IndexRange(chunks_num), 1, [&](IndexRange chunk_range) {
+    for (const int64_t chunk : chunk_range) {
+      const IndexRange chunk_indices = IndexRange(size).slice(
+          chunk * grain_size, std::min(grain_size, size - chunk * grain_size));
+      T sum = chunk_sums[chunk];
+      for (const int64_t i : chunk_indices) {
+        const T value = values[i];
+        r_sums[i] = sum;
+        sum += value;
+      }
+    }
+  });
+
+  return total;
+}
+
+/**
+ * Gather the indices in `mask` for which `predicate(index)` is true into `r_indices`, keeping
+ * their order. This is the compaction step of e.g. removing elements from a mesh.
+ *
+ * \return A mask referencing `r_indices`, so it is only valid as long as that vector is.
+ */
+template<typename Predicate>
+IndexMask parallel_filter_indices(IndexMask mask,
+                                  int64_t grain_size,
+                                  Vector<int64_t> &r_indices,
+                                  const Predicate &predicate)
+{
+  r_indices.clear();
+  const int64_t size = mask.size();
+  if (size <= grain_size) {
+    for (const int64_t i : mask.indices()) {
+      if (predicate(i)) {
+        r_indices.append(i);
+      }
+    }
+    return r_indices.as_span();
+  }
+
+  /* Filter each chunk separately, then copy the chunks to their final offset. */
+  const int64_t chunks_num = (size + grain_size - 1) / grain_size;
+  Array<Vector<int64_t>> chunk_indices(chunks_num);
+  parallel_for(IndexRange(chunks_num), 1, [&](IndexRange chunk_range) {
+    for (const int64_t chunk : chunk_range) {
+      const Span<int64_t> indices = mask.indices().slice(
+          chunk * grain_size, std::min(grain_size, size - chunk * grain_size));
+      Vector<int64_t> &filtered = chunk_indices[chunk];
+      for (const int64_t i : indices) {
+        if (predicate(i)) {
+          filtered.append(i);
+        }
+      }
+    }
+  });
+
+  Array<int64_t> chunk_offsets(chunks_num);
+  int64_t total = 0;
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    chunk_offsets[chunk] = total;
+    total += chunk_indices[chunk].size();
+  }
+
+  r_indices.resize(total);
+  parallel_for(IndexRange(chunks_num), 1, [&](IndexRange chunk_range) {
+    for (const int64_t chunk : chunk_range) {
+      r_indices.as_mutable_span()
+          .slice(chunk_offsets[chunk], chunk_indices[chunk].size())
+          .copy_from(chunk_indices[chunk]);
+    }
+  });
+
+  return r_indices.as_span();
+}
+
 }  // namespace blender
@@ -29,14 +29,17 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, inf, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
- *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      abs, fabs, floor, ceil, trunc, int, float, bool, copysign,
+ *      sin, cos, tan, asin, acos, atan, atan2, hypot,
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, log, log2, log10, sqrt, pow, fmod,
+ *      clamp, lerp, smoothstep
+ *  - Functions and constants of the math module can be prefixed with `math.`
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -325,6 +328,31 @@ static double op_sub(double a, double b)
   return a - b;
 }
 
+static double op_floordiv(double a, double b)
+{
+  return floor(a / b);
+}
+
+/* Python modulo, the result has the sign of the divisor. */
+static double op_mod(double a, double b)
+{
+  double result = fmod(a, b);
+  if (result != 0.0 && ((result < 0.0) != (b < 0.0))) {
+    result += b;
+  }
+  return result;
+}
+
+static double op_identity(double arg)
+{
+  return arg;
+}
+
+static double op_bool(double arg)
+{
+  return arg ? 1.0 : 0.0;
+}
+
 static double op_radians(double arg)
 {
   return arg * M_PI / 180.0;
@@ -404,8 +432,13 @@ typedef struct BuiltinConstDef {
   double value;
 } BuiltinConstDef;
 
-static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+static BuiltinConstDef builtin_consts[] = {{"pi", M_PI},
+                                           {"e", M_E},
+                                           {"tau", 2.0 * M_PI},
+                                           {"inf", INFINITY},
+                                           {"True", 1.0},
+                                           {"False", 0.0},
+                                           {NULL, 0.0}};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -437,12 +470,24 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"copysign", OPCODE_FUNC2, copysign},
+    {"float", OPCODE_FUNC1, op_identity},
+    {"bool", OPCODE_FUNC1, op_bool},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
@@ -477,6 +522,13 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
 #define TOKEN_IF MAKE_CHAR2('I', 'F')
 #define TOKEN_ELSE MAKE_CHAR2('E', 'L')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
+
+/* Builtins which are not part of the math module, and can't be used with the `math.` prefix. */
+static const char *builtin_non_math_names[] = {
+    "True", "False", "abs", "round", "int", "float", "bool", "min", "max", "clamp", "lerp",
+    "smoothstep", NULL};
 
 static const char *token_eq_characters = "!=><";
 static const char *token_characters = "~`!@#$%^&*+-=/\\?:;<>(){}[]|.,\"'";
@@ -713,6 +765,13 @@ static bool parse_next_token(ExprParseState *state)
     return (end == out);
   }
 
+  /* ** and // tokens */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* ?= tokens */
   if (state->cur[1] == '=' && strchr(token_eq_characters, state->cur[0])) {
     state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
@@ -792,19 +851,41 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+static bool parse_unary(ExprParseState *state);
+
+/* Check for a `math.` prefix of the current identifier and skip it. */
+static bool parse_math_module_prefix(ExprParseState *state, bool *r_has_prefix)
 {
-  int i;
+  *r_has_prefix = false;
 
-  switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
+  if (!STREQ(state->tokenbuf, "math")) {
+    return true;
+  }
 
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
+  const char *cur = state->cur;
+  while (isspace(*cur)) {
+    cur++;
+  }
+  if (*cur != '.') {
+    return true;
+  }
+
+  CHECK_ERROR(parse_next_token(state) && parse_next_token(state) && state->token == TOKEN_ID);
+
+  for (int i = 0; builtin_non_math_names[i]; i++) {
+    CHECK_ERROR(!STREQ(state->tokenbuf, builtin_non_math_names[i]));
+  }
 
+  *r_has_prefix = true;
+  return true;
+}
+
+static bool parse_primary(ExprParseState *state)
+{
+  int i;
+  bool has_math_prefix;
+
+  switch (state->token) {
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -814,9 +895,11 @@ static bool parse_unary(ExprParseState *state)
       return parse_next_token(state);
 
     case TOKEN_ID:
+      CHECK_ERROR(parse_math_module_prefix(state, &has_math_prefix));
+
       /* Parameters: search in reverse order in case of duplicate names -
        * the last one should win. */
-      for (i = state->param_names_len - 1; i >= 0; i--) {
+      for (i = has_math_prefix ? -1 : state->param_names_len - 1; i >= 0; i--) {
         if (STREQ(state->tokenbuf, state->param_names[i])) {
           parse_add_op(state, OPCODE_PARAMETER, 1)->arg.ival = i;
           return parse_next_token(state);
@@ -852,6 +935,10 @@ static bool parse_unary(ExprParseState *state)
       }
 
       /* Specially supported functions. */
+      if (has_math_prefix) {
+        return false;
+      }
+
       if (STREQ(state->tokenbuf, "min")) {
         int cnt = parse_function_args(state);
         CHECK_ERROR(cnt > 0);
@@ -875,6 +962,36 @@ static bool parse_unary(ExprParseState *state)
   }
 }
 
+/* Power binds tighter than unary operators on its left, but not on its right: -a**-b is
+ * -(a**(-b)). It is right-associative. */
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
+
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
+
+  return true;
+}
+
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
+
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
+
+    default:
+      return parse_power(state);
+  }
+}
+
 static bool parse_mul(ExprParseState *state)
 {
   CHECK_ERROR(parse_unary(state));
@@ -891,6 +1008,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -22,6 +22,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -145,20 +146,15 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Partition \a nodes around the median along \a axis, quicksort style.
+ * \return the index of the median.
+ */
+static uint kdtree_balance_partition(KDTreeNode *nodes, uint nodes_len, uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
-  /* quicksort style sorting around median */
   left = 0;
   right = nodes_len - 1;
   median = nodes_len / 2;
@@ -190,6 +186,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_partition(nodes, nodes_len, axis);
+
   /* set node and sort subnodes */
   node = &nodes[median];
   node->d = axis;
@@ -201,6 +214,69 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/* Trees with fewer nodes are balanced on a single thread. */
+#define KD_BALANCE_PARALLEL_MIN 4096
+/* Number of levels split before the sub-trees are balanced in parallel (up to 64 sub-trees). */
+#define KD_BALANCE_PARALLEL_DEPTH 6
+
+/** A sub-tree that is balanced by one task, writing its root to #r_root. */
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  uint *r_root;
+} KDTreeBalanceTask;
+
+/**
+ * Balance the first levels of the tree like #kdtree_balance,
+ * collecting the sub-trees below them in \a tasks.
+ * The sub-trees cover separate ranges of nodes, so they can be balanced independently.
+ */
+static void kdtree_balance_split(KDTreeNode *nodes,
+                                 uint nodes_len,
+                                 uint axis,
+                                 const uint ofs,
+                                 const uint depth,
+                                 uint *r_root,
+                                 KDTreeBalanceTask *tasks,
+                                 uint *tasks_len)
+{
+  if (depth == 0 || nodes_len < KD_BALANCE_PARALLEL_MIN) {
+    KDTreeBalanceTask *task = &tasks[(*tasks_len)++];
+    task->nodes = nodes;
+    task->nodes_len = nodes_len;
+    task->axis = axis;
+    task->ofs = ofs;
+    task->r_root = r_root;
+    return;
+  }
+
+  const uint median = kdtree_balance_partition(nodes, nodes_len, axis);
+  KDTreeNode *node = &nodes[median];
+  node->d = axis;
+  axis = (axis + 1) % KD_DIMS;
+  kdtree_balance_split(nodes, median, axis, ofs, depth - 1, &node->left, tasks, tasks_len);
+  kdtree_balance_split(nodes + median + 1,
+                       nodes_len - (median + 1),
+                       axis,
+                       (median + 1) + ofs,
+                       depth - 1,
+                       &node->right,
+                       tasks,
+                       tasks_len);
+
+  *r_root = median + ofs;
+}
+
+static void kdtree_balance_task_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KDTreeBalanceTask *task = &((KDTreeBalanceTask *)userdata)[i];
+  *task->r_root = kdtree_balance(task->nodes, task->nodes_len, task->axis, task->ofs);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,7 +286,26 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_PARALLEL_MIN) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
+  else {
+    KDTreeBalanceTask tasks[1 << KD_BALANCE_PARALLEL_DEPTH];
+    uint tasks_len = 0;
+    kdtree_balance_split(tree->nodes,
+                         tree->nodes_len,
+                         0,
+                         0,
+                         KD_BALANCE_PARALLEL_DEPTH,
+                         &tree->root,
+                         tasks,
+                         &tasks_len);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, (int)tasks_len, tasks, kdtree_balance_task_cb, &settings);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -332,6 +427,50 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
   return min_node->index;
 }
 
+typedef struct KDTreeFindNearestBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  int *r_index;
+  KDTreeNearest *r_nearest;
+} KDTreeFindNearestBatchData;
+
+static void kdtree_find_nearest_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeFindNearestBatchData *data = userdata;
+  const int index = BLI_kdtree_nd_(find_nearest)(
+      data->tree, data->co[i], data->r_nearest ? &data->r_nearest[i] : NULL);
+  if (data->r_index) {
+    data->r_index[i] = index;
+  }
+}
+
+/**
+ * Find the nearest node for every coordinate in \a co, in parallel.
+ *
+ * \param r_index: Optional, the index of the nearest node for each coordinate (-1 if none).
+ * \param r_nearest: Optional, the nearest node for each coordinate.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        int *r_index,
+                                        KDTreeNearest *r_nearest)
+{
+  KDTreeFindNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .r_index = r_index,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_batch_cb, &settings);
+}
+
 /**
  * A version of #BLI_kdtree_3d_find_nearest which runs a callback
  * to filter out values.
@@ -866,6 +1005,67 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+static bool deduplicate_has_neighbor_recursive(const struct DeDuplicateParams *p,
+                                               uint i,
+                                               const float search_co[KD_DIMS],
+                                               const int search)
+{
+  const KDTreeNode *node = &p->nodes[i];
+  if (search_co[node->d] + p->range <= node->co[node->d]) {
+    return (node->left != KD_NODE_UNSET) &&
+           deduplicate_has_neighbor_recursive(p, node->left, search_co, search);
+  }
+  if (search_co[node->d] - p->range >= node->co[node->d]) {
+    return (node->right != KD_NODE_UNSET) &&
+           deduplicate_has_neighbor_recursive(p, node->right, search_co, search);
+  }
+  if ((search != node->index) && (len_squared_vnvn(node->co, search_co) <= p->range_sq)) {
+    return true;
+  }
+  return ((node->left != KD_NODE_UNSET) &&
+          deduplicate_has_neighbor_recursive(p, node->left, search_co, search)) ||
+         ((node->right != KD_NODE_UNSET) &&
+          deduplicate_has_neighbor_recursive(p, node->right, search_co, search));
+}
+
+typedef struct DeDuplicateNeighborData {
+  const struct DeDuplicateParams *p;
+  uint root;
+  /* Node aligned, true when a node has another node in range. */
+  bool *has_neighbor;
+} DeDuplicateNeighborData;
+
+static void deduplicate_has_neighbor_cb(void *__restrict userdata,
+                                        const int node_index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DeDuplicateNeighborData *data = userdata;
+  const KDTreeNode *node = &data->p->nodes[node_index];
+  data->has_neighbor[node_index] = deduplicate_has_neighbor_recursive(
+      data->p, data->root, node->co, node->index);
+}
+
+/**
+ * Find the nodes that have any other node in range, in parallel.
+ * Searching from any other node can't find duplicates, so it can be skipped.
+ */
+static bool *deduplicate_has_neighbor_calc(const KDTree *tree, const struct DeDuplicateParams *p)
+{
+  DeDuplicateNeighborData data = {
+      .p = p,
+      .root = tree->root,
+      .has_neighbor = MEM_malloc_arrayN(tree->nodes_len, sizeof(bool), __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0, (int)tree->nodes_len, &data, deduplicate_has_neighbor_cb, &settings);
+
+  return data.has_neighbor;
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -898,12 +1098,20 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
+  if (tree->root == KD_NODE_UNSET) {
+    return found;
+  }
+
+  /* Merging itself depends on the order nodes are visited in and is done serially,
+   * only for nodes that have any neighbor at all. */
+  bool *has_neighbor = deduplicate_has_neighbor_calc(tree, &p);
+
   if (use_index_order) {
     uint *order = kdtree_order(tree);
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = order[i];
       const int index = (int)i;
-      if (ELEM(duplicates[index], -1, index)) {
+      if (has_neighbor[node_index] && ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
         int found_prev = found;
@@ -920,7 +1128,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = i;
       const int index = p.nodes[node_index].index;
-      if (ELEM(duplicates[index], -1, index)) {
+      if (has_neighbor[node_index] && ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
         int found_prev = found;
@@ -932,6 +1140,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+  MEM_freeN(has_neighbor);
   return found;
 }
 
@@ -37,6 +37,7 @@
 #  include "BLI_set.hh"
 #  include "BLI_span.hh"
 #  include "BLI_stack.hh"
+#  include "BLI_task.hh"
 #  include "BLI_vector.hh"
 #  include "BLI_vector_set.hh"
 
@@ -825,6 +826,34 @@ static const Vert *find_flap_vert(const Face &tri, const Edge e, bool *r_rev)
   return flapv;
 }
 
+/**
+ * Return #orient3d of the exact coordinates of \a a, \a b, \a c and \a d.
+ * The double coordinates of a vertex are within one ulp of the exact ones, so
+ * when the determinant computed in doubles is far enough from zero its sign
+ * is the exact one. Only nearly degenerate cases need exact arithmetic.
+ */
+static int filtered_orient3d(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
+{
+  double max_abs = 0.0;
+  for (const Vert *v : {a, b, c, d}) {
+    for (int i = 0; i < 3; ++i) {
+      max_abs = max_dd(max_abs, fabs(v->co[i]));
+    }
+  }
+  const double3 ad = a->co - d->co;
+  const double3 bd = b->co - d->co;
+  const double3 cd = c->co - d->co;
+  const double det = ad[2] * (bd[0] * cd[1] - cd[0] * bd[1]) +
+                     bd[2] * (cd[0] * ad[1] - ad[0] * cd[1]) +
+                     cd[2] * (ad[0] * bd[1] - bd[0] * ad[1]);
+  /* Bounds both the error from rounding the coordinates and from the arithmetic above. */
+  const double err_bound = 1024.0 * DBL_EPSILON * max_abs * max_abs * max_abs;
+  if (err_bound > DBL_MIN && fabs(det) > err_bound) {
+    return det > 0.0 ? 1 : -1;
+  }
+  return orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact);
+}
+
 /**
  * Triangle \a tri and tri0 share edge e.
  * Classify \a tri with respect to tri0 as described in
@@ -845,9 +874,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -859,9 +885,8 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of tri0. */
+  int orient = filtered_orient3d(tri0[0], tri0[1], tri0[2], flapv);
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -1030,21 +1055,16 @@ static Array<int> sort_tris_around_edge(const IMesh &tm,
  * Will modify \a pinfo and \a cinfo and the patches and cells they contain.
  */
 static void find_cells_from_edge(const IMesh &tm,
-                                 const TriMeshTopology &tmtopo,
                                  PatchesInfo &pinfo,
                                  CellsInfo &cinfo,
-                                 const Edge e)
+                                 const Edge e,
+                                 Span<int> sorted_tris)
 {
   const int dbg_level = 0;
   if (dbg_level > 0) {
     std::cout << "FIND_CELLS_FROM_EDGE " << e << "\n";
   }
-  const Vector<int> *edge_tris = tmtopo.edge_tris(e);
-  BLI_assert(edge_tris != nullptr);
-  Array<int> sorted_tris = sort_tris_around_edge(
-      tm, tmtopo, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
-
-  int n_edge_tris = edge_tris->size();
+  int n_edge_tris = sorted_tris.size();
   Array<int> edge_patches(n_edge_tris);
   for (int i = 0; i < n_edge_tris; ++i) {
     edge_patches[i] = pinfo.tri_patch(sorted_tris[i]);
@@ -1135,19 +1155,31 @@ static CellsInfo find_cells(const IMesh &tm, const TriMeshTopology &tmtopo, Patc
   }
   CellsInfo cinfo;
   /* For each unique edge shared between patch pairs, process it. */
-  Set<Edge> processed_edges;
+  VectorSet<Edge> patch_edges;
   int np = pinfo.tot_patch();
   for (int p = 0; p < np; ++p) {
     for (int q = p + 1; q < np; ++q) {
       Edge e = pinfo.patch_patch_edge(p, q);
       if (e.v0() != nullptr) {
-        if (!processed_edges.contains(e)) {
-          processed_edges.add_new(e);
-          find_cells_from_edge(tm, tmtopo, pinfo, cinfo, e);
-        }
+        patch_edges.add(e);
       }
     }
   }
+  /* Sorting the triangles around the edges needs the exact predicates and doesn't depend on
+   * the cells found so far, so do that in parallel before processing the edges in order. */
+  Array<Array<int>> sorted_edge_tris(patch_edges.size());
+  parallel_for(IndexRange(patch_edges.size()), 16, [&](IndexRange range) {
+    for (int i : range) {
+      const Edge e = patch_edges[i];
+      const Vector<int> *edge_tris = tmtopo.edge_tris(e);
+      BLI_assert(edge_tris != nullptr);
+      sorted_edge_tris[i] = sort_tris_around_edge(
+          tm, tmtopo, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
+    }
+  });
+  for (int i : IndexRange(patch_edges.size())) {
+    find_cells_from_edge(tm, pinfo, cinfo, patch_edges[i], sorted_edge_tris[i]);
+  }
   /* Some patches may have no cells at this point. These are either:
    * (a) a closed manifold patch only incident on itself (sphere, torus, klein bottle, etc.).
    * (b) an open manifold patch only incident on itself (has non-manifold boundaries).
@@ -2403,83 +2435,96 @@ static IMesh gwn_boolean(const IMesh &tm,
   IMesh ans;
   Vector<Face *> out_faces;
   out_faces.reserve(tm.face_size());
-  Array<int> winding(nshapes, 0);
-  for (int p : pinfo.index_range()) {
-    const Patch &patch = pinfo.patch(p);
-    /* For test triangle, choose one in the middle of patch list
-     * as the ones near the beginning may be very near other patches. */
-    int test_t_index = patch.tri(patch.tot_tri() / 2);
-    Face &tri_test = *tm.face(test_t_index);
-    /* Assume all triangles in a patch are in the same shape. */
-    int shape = shape_fn(tri_test.orig);
-    if (dbg_level > 0) {
-      std::cout << "process patch " << p << " = " << patch << "\n";
-      std::cout << "test tri = " << test_t_index << " = " << &tri_test << "\n";
-      std::cout << "shape = " << shape << "\n";
-    }
-    if (shape == -1) {
-      continue;
-    }
-    mpq3 test_point = calc_point_inside_tri(tri_test);
-    double3 test_point_db(test_point[0].get_d(), test_point[1].get_d(), test_point[2].get_d());
-    if (dbg_level > 0) {
-      std::cout << "test point = " << test_point_db << "\n";
-    }
-    for (int other_shape = 0; other_shape < nshapes; ++other_shape) {
-      if (other_shape == shape) {
+  /* Classifying a patch needs a winding number over all triangles, so classify the patches in
+   * parallel and only then gather the output in patch order. */
+  enum class PatchResult : int8_t { Remove, Keep, Flip };
+  Array<PatchResult> patch_result(pinfo.tot_patch(), PatchResult::Remove);
+  parallel_for(pinfo.index_range(), 1, [&](IndexRange range) {
+    Array<int> winding(nshapes, 0);
+    for (int p : range) {
+      const Patch &patch = pinfo.patch(p);
+      /* For test triangle, choose one in the middle of patch list
+       * as the ones near the beginning may be very near other patches. */
+      int test_t_index = patch.tri(patch.tot_tri() / 2);
+      Face &tri_test = *tm.face(test_t_index);
+      /* Assume all triangles in a patch are in the same shape. */
+      int shape = shape_fn(tri_test.orig);
+      if (dbg_level > 0) {
+        std::cout << "process patch " << p << " = " << patch << "\n";
+        std::cout << "test tri = " << test_t_index << " = " << &tri_test << "\n";
+        std::cout << "shape = " << shape << "\n";
+      }
+      if (shape == -1) {
         continue;
       }
-      /* The point_is_inside_shape function has to approximate if the other
-       * shape is not PWN. For most operations, even a hint of being inside
-       * gives good results, but when shape is a cutter in a Difference
-       * operation, we want to be pretty sure that the point is inside other_shape.
-       * E.g., T75827.
-       */
-      bool need_high_confidence = (op == BoolOpType::Difference) && (shape != 0);
-      bool inside = point_is_inside_shape(
-          tm, shape_fn, test_point_db, other_shape, need_high_confidence);
+      mpq3 test_point = calc_point_inside_tri(tri_test);
+      double3 test_point_db(test_point[0].get_d(), test_point[1].get_d(), test_point[2].get_d());
       if (dbg_level > 0) {
-        std::cout << "test point is " << (inside ? "inside" : "outside") << " other_shape "
-                  << other_shape << "\n";
-      }
-      winding[other_shape] = inside;
-    }
-    /* Find out the "in the output volume" flag for each of the cases of winding[shape] == 0
-     * and winding[shape] == 1. If the flags are different, this patch should be in the output.
-     * Also, if this is a Difference and the shape isn't the first one, need to flip the normals.
-     */
-    winding[shape] = 0;
-    bool in_output_volume_0 = apply_bool_op(op, winding);
-    winding[shape] = 1;
-    bool in_output_volume_1 = apply_bool_op(op, winding);
-    bool do_remove = in_output_volume_0 == in_output_volume_1;
-    bool do_flip = !do_remove && op == BoolOpType::Difference && shape != 0;
-    if (dbg_level > 0) {
-      std::cout << "winding = ";
-      for (int i = 0; i < nshapes; ++i) {
-        std::cout << winding[i] << " ";
+        std::cout << "test point = " << test_point_db << "\n";
       }
-      std::cout << "\niv0=" << in_output_volume_0 << ", iv1=" << in_output_volume_1 << "\n";
-      std::cout << "result for patch " << p << ": remove=" << do_remove << ", flip=" << do_flip
-                << "\n";
-    }
-    if (!do_remove) {
-      for (int t : patch.tris()) {
-        Face *f = tm.face(t);
-        if (!do_flip) {
-          out_faces.append(f);
+      for (int other_shape = 0; other_shape < nshapes; ++other_shape) {
+        if (other_shape == shape) {
+          continue;
         }
-        else {
-          Face &tri = *f;
-          /* We need flipped version of f. */
-          Array<const Vert *> flipped_vs = {tri[0], tri[2], tri[1]};
-          Array<int> flipped_e_origs = {tri.edge_orig[2], tri.edge_orig[1], tri.edge_orig[0]};
-          Array<bool> flipped_is_intersect = {
-              tri.is_intersect[2], tri.is_intersect[1], tri.is_intersect[0]};
-          Face *flipped_f = arena->add_face(
-              flipped_vs, f->orig, flipped_e_origs, flipped_is_intersect);
-          out_faces.append(flipped_f);
+        /* The point_is_inside_shape function has to approximate if the other
+         * shape is not PWN. For most operations, even a hint of being inside
+         * gives good results, but when shape is a cutter in a Difference
+         * operation, we want to be pretty sure that the point is inside other_shape.
+         * E.g., T75827.
+         */
+        bool need_high_confidence = (op == BoolOpType::Difference) && (shape != 0);
+        bool inside = point_is_inside_shape(
+            tm, shape_fn, test_point_db, other_shape, need_high_confidence);
+        if (dbg_level > 0) {
+          std::cout << "test point is " << (inside ? "inside" : "outside") << " other_shape "
+                    << other_shape << "\n";
+        }
+        winding[other_shape] = inside;
+      }
+      /* Find out the "in the output volume" flag for each of the cases of winding[shape] == 0
+       * and winding[shape] == 1. If the flags are different, this patch should be in the
+       * output. Also, if this is a Difference and the shape isn't the first one, need to flip
+       * the normals.
+       */
+      winding[shape] = 0;
+      bool in_output_volume_0 = apply_bool_op(op, winding);
+      winding[shape] = 1;
+      bool in_output_volume_1 = apply_bool_op(op, winding);
+      bool do_remove = in_output_volume_0 == in_output_volume_1;
+      bool do_flip = !do_remove && op == BoolOpType::Difference && shape != 0;
+      if (dbg_level > 0) {
+        std::cout << "winding = ";
+        for (int i = 0; i < nshapes; ++i) {
+          std::cout << winding[i] << " ";
         }
+        std::cout << "\niv0=" << in_output_volume_0 << ", iv1=" << in_output_volume_1 << "\n";
+        std::cout << "result for patch " << p << ": remove=" << do_remove << ", flip=" << do_flip
+                  << "\n";
+      }
+      patch_result[p] = do_remove ? PatchResult::Remove :
+                                    (do_flip ? PatchResult::Flip : PatchResult::Keep);
+    }
+  });
+  for (int p : pinfo.index_range()) {
+    if (patch_result[p] == PatchResult::Remove) {
+      continue;
+    }
+    const bool do_flip = patch_result[p] == PatchResult::Flip;
+    for (int t : pinfo.patch(p).tris()) {
+      Face *f = tm.face(t);
+      if (!do_flip) {
+        out_faces.append(f);
+      }
+      else {
+        Face &tri = *f;
+        /* We need flipped version of f. */
+        Array<const Vert *> flipped_vs = {tri[0], tri[2], tri[1]};
+        Array<int> flipped_e_origs = {tri.edge_orig[2], tri.edge_orig[1], tri.edge_orig[0]};
+        Array<bool> flipped_is_intersect = {
+            tri.is_intersect[2], tri.is_intersect[1], tri.is_intersect[0]};
+        Face *flipped_f = arena->add_face(
+            flipped_vs, f->orig, flipped_e_origs, flipped_is_intersect);
+        out_faces.append(flipped_f);
       }
     }
   }
@@ -2336,8 +2336,7 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
                                         int c,
                                         const IMesh &tm,
                                         const TriOverlaps &ov,
-                                        const Map<std::pair<int, int>, ITT_value> &itt_map,
-                                        IMeshArena *UNUSED(arena))
+                                        const Map<std::pair<int, int>, ITT_value> &itt_map)
 {
   constexpr int dbg_level = 0;
   BLI_assert(c < clinfo.tot_cluster());
@@ -2384,6 +2383,112 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
   return cd_data;
 }
 
+struct SubdivideClustersData {
+  Array<CDT_data> &r_cluster_subdivided;
+  const CoplanarClusterInfo &clinfo;
+  const IMesh &tm;
+  const TriOverlaps &ov;
+  const Map<std::pair<int, int>, ITT_value> &itt_map;
+
+  SubdivideClustersData(Array<CDT_data> &r_cluster_subdivided,
+                        const CoplanarClusterInfo &clinfo,
+                        const IMesh &tm,
+                        const TriOverlaps &ov,
+                        const Map<std::pair<int, int>, ITT_value> &itt_map)
+      : r_cluster_subdivided(r_cluster_subdivided),
+        clinfo(clinfo),
+        tm(tm),
+        ov(ov),
+        itt_map(itt_map)
+  {
+  }
+};
+
+static void calc_cluster_subdivided_range_func(void *__restrict userdata,
+                                               const int c,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubdivideClustersData *data = static_cast<SubdivideClustersData *>(userdata);
+  data->r_cluster_subdivided[c] = calc_cluster_subdivided(
+      data->clinfo, c, data->tm, data->ov, data->itt_map);
+}
+
+/**
+ * Fill in \a r_cluster_subdivided with the CDT of each co-planar cluster in \a clinfo.
+ * The clusters are independent, so the CDTs are done in parallel.
+ */
+static void calc_clusters_subdivided(Array<CDT_data> &r_cluster_subdivided,
+                                     const CoplanarClusterInfo &clinfo,
+                                     const IMesh &tm,
+                                     const TriOverlaps &ov,
+                                     const Map<std::pair<int, int>, ITT_value> &itt_map)
+{
+  SubdivideClustersData data(r_cluster_subdivided, clinfo, tm, ov, itt_map);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(
+      0, clinfo.tot_cluster(), &data, calc_cluster_subdivided_range_func, &settings);
+}
+
+struct ExtractTrisData {
+  Array<IMesh> &r_tri_subdivided;
+  const IMesh &tm;
+  const CoplanarClusterInfo &clinfo;
+  const Array<CDT_data> &cluster_subdivided;
+  IMeshArena *arena;
+
+  ExtractTrisData(Array<IMesh> &r_tri_subdivided,
+                  const IMesh &tm,
+                  const CoplanarClusterInfo &clinfo,
+                  const Array<CDT_data> &cluster_subdivided,
+                  IMeshArena *arena)
+      : r_tri_subdivided(r_tri_subdivided),
+        tm(tm),
+        clinfo(clinfo),
+        cluster_subdivided(cluster_subdivided),
+        arena(arena)
+  {
+  }
+};
+
+static void extract_remaining_tri_range_func(void *__restrict userdata,
+                                             const int t,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ExtractTrisData *data = static_cast<ExtractTrisData *>(userdata);
+  int c = data->clinfo.tri_cluster(t);
+  if (c != NO_INDEX) {
+    BLI_assert(data->r_tri_subdivided[t].face_size() == 0);
+    data->r_tri_subdivided[t] = extract_subdivided_tri(
+        data->cluster_subdivided[c], data->tm, t, data->arena);
+  }
+  else if (data->r_tri_subdivided[t].face_size() == 0) {
+    data->r_tri_subdivided[t] = extract_single_tri(data->tm, t);
+  }
+}
+
+/**
+ * Fill in the slots of \a r_tri_subdivided not set by #calc_subdivided_tris:
+ * triangles in clusters are extracted from the cluster's CDT, the others that
+ * don't intersect anything are just copied.
+ */
+static void extract_remaining_tris(Array<IMesh> &r_tri_subdivided,
+                                   const IMesh &tm,
+                                   const CoplanarClusterInfo &clinfo,
+                                   const Array<CDT_data> &cluster_subdivided,
+                                   IMeshArena *arena)
+{
+  ExtractTrisData data(r_tri_subdivided, tm, clinfo, cluster_subdivided, arena);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(
+      0, tm.face_size(), &data, extract_remaining_tri_range_func, &settings);
+}
+
 static IMesh union_tri_subdivides(const blender::Array<IMesh> &tri_subdivided)
 {
   int tot_tri = 0;
@@ -2611,6 +2716,38 @@ static IMesh remove_degenerate_tris(const IMesh &tm_in)
 }
 
 /* This is the main routine for calculating the self_intersection of a triangle mesh. */
+struct PopulatePlanesData {
+  const IMesh &tm;
+  const TriOverlaps &ov;
+
+  PopulatePlanesData(const IMesh &tm, const TriOverlaps &ov) : tm(tm), ov(ov)
+  {
+  }
+};
+
+static void populate_plane_range_func(void *__restrict userdata,
+                                      const int t,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PopulatePlanesData *data = static_cast<PopulatePlanesData *>(userdata);
+  if (data->ov.first_overlap_index(t) != -1) {
+    data->tm.face(t)->populate_plane(true);
+  }
+}
+
+/**
+ * Calculate the exact planes of all triangles in \a tm that overlap another triangle.
+ */
+static void populate_overlap_planes(const IMesh &tm, const TriOverlaps &ov)
+{
+  PopulatePlanesData data(tm, ov);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0, tm.face_size(), &data, populate_plane_range_func, &settings);
+}
+
 IMesh trimesh_self_intersect(const IMesh &tm_in, IMeshArena *arena)
 {
   return trimesh_nary_intersect(
@@ -2672,11 +2809,7 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   double overlap_time = PIL_check_seconds_timer();
   std::cout << "intersect overlaps calculated, time = " << overlap_time - bb_calc_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    if (tri_ov.first_overlap_index(t) != -1) {
-      tm_clean->face(t)->populate_plane(true);
-    }
-  }
+  populate_overlap_planes(*tm_clean, tri_ov);
 #  ifdef PERFDEBUG
   double plane_populate = PIL_check_seconds_timer();
   std::cout << "planes populated, time = " << plane_populate - overlap_time << "\n";
@@ -2708,24 +2841,13 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided tris found, time = " << subdivided_tris_time - itt_time << "\n";
 #  endif
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  calc_clusters_subdivided(cluster_subdivided, clinfo, *tm_clean, tri_ov, itt_map);
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
             << cluster_subdivide_time - subdivided_tris_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    int c = clinfo.tri_cluster(t);
-    if (c != NO_INDEX) {
-      BLI_assert(tri_subdivided[t].face_size() == 0);
-      tri_subdivided[t] = extract_subdivided_tri(cluster_subdivided[c], *tm_clean, t, arena);
-    }
-    else if (tri_subdivided[t].face_size() == 0) {
-      tri_subdivided[t] = extract_single_tri(*tm_clean, t);
-    }
-  }
+  extract_remaining_tris(tri_subdivided, *tm_clean, clinfo, cluster_subdivided, arena);
 #  ifdef PERFDEBUG
   double extract_time = PIL_check_seconds_timer();
   std::cout << "triangles extracted, time = " << extract_time - cluster_subdivide_time << "\n";
@@ -0,0 +1,305 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <cstring>
+#include <type_traits>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_map.hh"
+#include "BLI_ptr_map.h"
+#include "BLI_set.hh"
+
+using PtrMapImpl = blender::Map<const void *, void *>;
+using PtrSetImpl = blender::Set<const void *>;
+using PtrMapIteratorImpl = PtrMapImpl::MutableItemIterator;
+using PtrSetIteratorImpl = PtrSetImpl::Iterator;
+
+struct PtrMap {
+  PtrMapImpl map;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("PtrMap")
+};
+
+struct PtrSet {
+  PtrSetImpl set;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("PtrSet")
+};
+
+/* The C++ iterators are stored by value in the C iterator structs. */
+static_assert(sizeof(PtrMapIteratorImpl) <= sizeof(PtrMapIterator::_data), "");
+static_assert(sizeof(PtrSetIteratorImpl) <= sizeof(PtrSetIterator::_data), "");
+static_assert(std::is_trivially_copyable_v<PtrMapIteratorImpl>, "");
+static_assert(std::is_trivially_copyable_v<PtrSetIteratorImpl>, "");
+
+template<typename IteratorImpl> static IteratorImpl iterator_load(const uint64_t *data)
+{
+  IteratorImpl it(nullptr, 0, 0);
+  memcpy(static_cast<void *>(&it), data, sizeof(it));
+  return it;
+}
+
+template<typename IteratorImpl> static void iterator_store(uint64_t *data, const IteratorImpl &it)
+{
+  memcpy(data, static_cast<const void *>(&it), sizeof(it));
+}
+
+/* -------------------------------------------------------------------- */
+/** \name PtrMap API
+ * \{ */
+
+PtrMap *BLI_ptr_map_new(void)
+{
+  return new PtrMap();
+}
+
+/**
+ * \param nentries_reserve: Optionally reserve the number of members that the map will hold.
+ * Use this to avoid resizing while building the map.
+ */
+PtrMap *BLI_ptr_map_new_ex(const unsigned int nentries_reserve)
+{
+  PtrMap *map = new PtrMap();
+  map->map.reserve(nentries_reserve);
+  return map;
+}
+
+void BLI_ptr_map_free(PtrMap *map)
+{
+  delete map;
+}
+
+void BLI_ptr_map_clear(PtrMap *map)
+{
+  map->map.clear();
+}
+
+unsigned int BLI_ptr_map_len(const PtrMap *map)
+{
+  return static_cast<unsigned int>(map->map.size());
+}
+
+/**
+ * Insert a key that is known not to be in the map yet.
+ */
+void BLI_ptr_map_insert(PtrMap *map, const void *key, void *val)
+{
+  map->map.add_new(key, val);
+}
+
+/**
+ * Insert a key when it is not in the map yet, an existing value is kept.
+ *
+ * \return true if a new key has been added.
+ */
+bool BLI_ptr_map_add(PtrMap *map, const void *key, void *val)
+{
+  return map->map.add(key, val);
+}
+
+/**
+ * Insert a key, overwriting the value of an existing key.
+ */
+void BLI_ptr_map_reinsert(PtrMap *map, const void *key, void *val)
+{
+  map->map.add_overwrite(key, val);
+}
+
+/**
+ * Ensure \a key is in the map, a new key gets a null value.
+ *
+ * \param r_val: The address of the value, valid until the next key is added.
+ * \return true when the key was already in the map.
+ */
+bool BLI_ptr_map_ensure_p(PtrMap *map, const void *key, void ***r_val)
+{
+  return map->map.add_or_modify(
+      key,
+      [&](void **value) {
+        *value = nullptr;
+        *r_val = value;
+        return false;
+      },
+      [&](void **value) {
+        *r_val = value;
+        return true;
+      });
+}
+
+/**
+ * \return true if the key was in the map.
+ */
+bool BLI_ptr_map_remove(PtrMap *map, const void *key)
+{
+  return map->map.remove(key);
+}
+
+bool BLI_ptr_map_haskey(const PtrMap *map, const void *key)
+{
+  return map->map.contains(key);
+}
+
+/**
+ * \return the value of \a key or null when it is not in the map.
+ */
+void *BLI_ptr_map_lookup(const PtrMap *map, const void *key)
+{
+  return map->map.lookup_default(key, nullptr);
+}
+
+void *BLI_ptr_map_lookup_default(const PtrMap *map, const void *key, void *val_default)
+{
+  return map->map.lookup_default(key, val_default);
+}
+
+/**
+ * \return the address of the value of \a key or null when it is not in the map.
+ */
+void **BLI_ptr_map_lookup_p(PtrMap *map, const void *key)
+{
+  return map->map.lookup_ptr(key);
+}
+
+void BLI_ptr_map_iter_init(PtrMapIterator *iter, PtrMap *map)
+{
+  iter->map = map;
+  iterator_store(iter->_data, map->map.items().begin());
+}
+
+void BLI_ptr_map_iter_step(PtrMapIterator *iter)
+{
+  PtrMapIteratorImpl it = iterator_load<PtrMapIteratorImpl>(iter->_data);
+  ++it;
+  iterator_store(iter->_data, it);
+}
+
+bool BLI_ptr_map_iter_done(const PtrMapIterator *iter)
+{
+  const PtrMapIteratorImpl it = iterator_load<PtrMapIteratorImpl>(iter->_data);
+  return !(it != it.end());
+}
+
+void *BLI_ptr_map_iter_key(const PtrMapIterator *iter)
+{
+  const PtrMapIteratorImpl it = iterator_load<PtrMapIteratorImpl>(iter->_data);
+  return const_cast<void *>((*it).key);
+}
+
+void *BLI_ptr_map_iter_value(const PtrMapIterator *iter)
+{
+  const PtrMapIteratorImpl it = iterator_load<PtrMapIteratorImpl>(iter->_data);
+  return (*it).value;
+}
+
+void **BLI_ptr_map_iter_value_p(const PtrMapIterator *iter)
+{
+  const PtrMapIteratorImpl it = iterator_load<PtrMapIteratorImpl>(iter->_data);
+  return &(*it).value;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name PtrSet API
+ * \{ */
+
+PtrSet *BLI_ptr_set_new(void)
+{
+  return new PtrSet();
+}
+
+PtrSet *BLI_ptr_set_new_ex(const unsigned int nentries_reserve)
+{
+  PtrSet *set = new PtrSet();
+  set->set.reserve(nentries_reserve);
+  return set;
+}
+
+void BLI_ptr_set_free(PtrSet *set)
+{
+  delete set;
+}
+
+void BLI_ptr_set_clear(PtrSet *set)
+{
+  set->set.clear();
+}
+
+unsigned int BLI_ptr_set_len(const PtrSet *set)
+{
+  return static_cast<unsigned int>(set->set.size());
+}
+
+/**
+ * Insert a key that is known not to be in the set yet.
+ */
+void BLI_ptr_set_insert(PtrSet *set, const void *key)
+{
+  set->set.add_new(key);
+}
+
+/**
+ * \return true if the key has been added.
+ */
+bool BLI_ptr_set_add(PtrSet *set, const void *key)
+{
+  return set->set.add(key);
+}
+
+/**
+ * \return true if the key was in the set.
+ */
+bool BLI_ptr_set_remove(PtrSet *set, const void *key)
+{
+  return set->set.remove(key);
+}
+
+bool BLI_ptr_set_haskey(const PtrSet *set, const void *key)
+{
+  return set->set.contains(key);
+}
+
+void BLI_ptr_set_iter_init(PtrSetIterator *iter, const PtrSet *set)
+{
+  iter->set = set;
+  iterator_store(iter->_data, set->set.begin());
+}
+
+void BLI_ptr_set_iter_step(PtrSetIterator *iter)
+{
+  PtrSetIteratorImpl it = iterator_load<PtrSetIteratorImpl>(iter->_data);
+  ++it;
+  iterator_store(iter->_data, it);
+}
+
+bool BLI_ptr_set_iter_done(const PtrSetIterator *iter)
+{
+  const PtrSetIteratorImpl it = iterator_load<PtrSetIteratorImpl>(iter->_data);
+  return !(it != iter->set->set.end());
+}
+
+void *BLI_ptr_set_iter_key(const PtrSetIterator *iter)
+{
+  const PtrSetIteratorImpl it = iterator_load<PtrSetIteratorImpl>(iter->_data);
+  return const_cast<void *>(*it);
+}
+
+/** \} */
@@ -24,6 +24,7 @@
 
 #include "BLI_task.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -41,6 +42,9 @@ struct TaskGraph {
 #endif
   std::vector<std::unique_ptr<TaskNode>> nodes;
 
+  /* Edges, priorities or costs changed since the successors were last ordered. */
+  bool is_schedule_dirty = false;
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("task_graph:TaskGraph")
 #endif
@@ -51,8 +55,11 @@ struct TaskNode {
   /* TBB Node. */
 #ifdef WITH_TBB
   tbb::flow::continue_node<tbb::flow::continue_msg> tbb_node;
+  /* Successors currently connected to the TBB node, in connection order. */
+  std::vector<TaskNode *> tbb_successors;
 #endif
-  /* Successors to execute after this task, for serial execution fallback. */
+  TaskGraph *task_graph;
+  /* Successors to execute after this task, ordered by #TaskNode.schedule_key_greater. */
   std::vector<TaskNode *> successors;
 
   /* User function to be executed with given task data. */
@@ -62,6 +69,15 @@ struct TaskNode {
    * is shared between nodes, only a single task node should free the data. */
   TaskGraphNodeFreeFunction free_func;
 
+  /* Scheduling hints, see #BLI_task_graph_node_priority_set and #BLI_task_graph_node_cost_set. */
+  TaskPriority priority = TASK_PRIORITY_LOW;
+  float cost = 1.0f;
+
+  /* Derived from the hints of this node and all nodes depending on it. */
+  TaskPriority path_priority = TASK_PRIORITY_LOW;
+  float critical_path_cost = 0.0f;
+  bool is_critical_path_valid = false;
+
   TaskNode(TaskGraph *task_graph,
            TaskGraphNodeRunFunction run_func,
            void *task_data,
@@ -72,13 +88,11 @@ struct TaskNode {
                  tbb::flow::unlimited,
                  std::bind(&TaskNode::run, this, std::placeholders::_1)),
 #endif
+        task_graph(task_graph),
         run_func(run_func),
         task_data(task_data),
         free_func(free_func)
   {
-#ifndef WITH_TBB
-    UNUSED_VARS(task_graph);
-#endif
   }
 
   TaskNode(const TaskNode &other) = delete;
@@ -107,11 +121,83 @@ struct TaskNode {
     }
   }
 
+  /* Nodes with a high priority, or the longest chain of work depending on them, go first. */
+  static bool schedule_key_greater(const TaskNode *a, const TaskNode *b)
+  {
+    if (a->path_priority != b->path_priority) {
+      return a->path_priority > b->path_priority;
+    }
+    return a->critical_path_cost > b->critical_path_cost;
+  }
+
+  void ensure_critical_path()
+  {
+    if (is_critical_path_valid) {
+      return;
+    }
+    /* Edges form a DAG, so the recursion terminates. */
+    float successors_cost = 0.0f;
+    path_priority = priority;
+    for (TaskNode *successor : successors) {
+      successor->ensure_critical_path();
+      successors_cost = std::max(successors_cost, successor->critical_path_cost);
+      path_priority = std::max(path_priority, successor->path_priority);
+    }
+    critical_path_cost = cost + successors_cost;
+    is_critical_path_valid = true;
+  }
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("task_graph:TaskNode")
 #endif
 };
 
+/**
+ * Order the successors of all nodes so the most critical ones are started first.
+ *
+ * For TBB the edges are (re)connected in reverse order: when a node finishes, the flow graph
+ * spawns all successors but the last one, which is run directly by the finishing thread.
+ */
+static void task_graph_schedule_ensure(TaskGraph *task_graph)
+{
+  if (!task_graph->is_schedule_dirty) {
+    return;
+  }
+
+  for (std::unique_ptr<TaskNode> &node : task_graph->nodes) {
+    node->is_critical_path_valid = false;
+  }
+  for (std::unique_ptr<TaskNode> &node : task_graph->nodes) {
+    node->ensure_critical_path();
+  }
+
+  for (std::unique_ptr<TaskNode> &node : task_graph->nodes) {
+    std::stable_sort(
+        node->successors.begin(), node->successors.end(), TaskNode::schedule_key_greater);
+
+#ifdef WITH_TBB
+    if (BLI_task_scheduler_num_threads() > 1) {
+      /* Only touch nodes whose order changed, other trees of the forest may be running. */
+      if (std::equal(node->tbb_successors.rbegin(),
+                     node->tbb_successors.rend(),
+                     node->successors.begin(),
+                     node->successors.end())) {
+        continue;
+      }
+      for (TaskNode *successor : node->tbb_successors) {
+        tbb::flow::remove_edge(node->tbb_node, successor->tbb_node);
+      }
+      node->tbb_successors.assign(node->successors.rbegin(), node->successors.rend());
+      for (TaskNode *successor : node->tbb_successors) {
+        tbb::flow::make_edge(node->tbb_node, successor->tbb_node);
+      }
+    }
+#endif
+  }
+
+  task_graph->is_schedule_dirty = false;
+}
+
 TaskGraph *BLI_task_graph_create(void)
 {
   return new TaskGraph();
@@ -138,11 +224,27 @@ struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
 {
   TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func);
   task_graph->nodes.push_back(std::unique_ptr<TaskNode>(task_node));
+  task_graph->is_schedule_dirty = true;
   return task_node;
 }
 
+void BLI_task_graph_node_priority_set(struct TaskNode *task_node, TaskPriority priority)
+{
+  task_node->priority = priority;
+  task_node->task_graph->is_schedule_dirty = true;
+}
+
+void BLI_task_graph_node_cost_set(struct TaskNode *task_node, float cost)
+{
+  BLI_assert(cost >= 0.0f);
+  task_node->cost = cost;
+  task_node->task_graph->is_schedule_dirty = true;
+}
+
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node)
 {
+  task_graph_schedule_ensure(task_node->task_graph);
+
 #ifdef WITH_TBB
   if (BLI_task_scheduler_num_threads() > 1) {
     return task_node->tbb_node.try_put(tbb::flow::continue_msg());
@@ -155,12 +257,8 @@ bool BLI_task_graph_node_push_work(struct TaskNode *task_node)
 
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node)
 {
-#ifdef WITH_TBB
-  if (BLI_task_scheduler_num_threads() > 1) {
-    tbb::flow::make_edge(from_node->tbb_node, to_node->tbb_node);
-    return;
-  }
-#endif
-
+  BLI_assert(from_node->task_graph == to_node->task_graph);
+  /* The TBB edge is only connected once successors have been ordered by priority. */
   from_node->successors.push_back(to_node);
+  from_node->task_graph->is_schedule_dirty = true;
 }
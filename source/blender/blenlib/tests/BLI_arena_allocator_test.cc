@@ -0,0 +1,63 @@
+/* Apache License, Version 2.0 */
+
+#include "BLI_arena_allocator.hh"
+#include "BLI_strict_flags.h"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(arena_allocator, AllocateFromArena)
+{
+  LinearAllocator<> arena;
+  blender::AlignedBuffer<256, 32> buffer;
+  arena.provide_buffer(buffer);
+
+  ArenaAllocator allocator(arena);
+  uintptr_t ptr = (uintptr_t)allocator.allocate(10, 4, __func__);
+  EXPECT_EQ(ptr, (uintptr_t)buffer.ptr());
+  /* Does nothing. */
+  allocator.deallocate((void *)ptr);
+  uintptr_t ptr2 = (uintptr_t)allocator.allocate(10, 4, __func__);
+  EXPECT_EQ(ptr2, ptr + 12);
+}
+
+TEST(arena_allocator, NoActiveArena)
+{
+  EXPECT_EQ(ScopedThreadArena::active(), nullptr);
+  Vector<int, 0, ArenaAllocator> vec;
+  for (int i = 0; i < 100; i++) {
+    vec.append(i);
+  }
+  EXPECT_EQ(vec.size(), 100);
+  EXPECT_EQ(vec[42], 42);
+}
+
+TEST(arena_allocator, ScopedThreadArena)
+{
+  LinearAllocator<> arena;
+  blender::AlignedBuffer<1024, 32> buffer;
+  arena.provide_buffer(buffer);
+  LinearAllocator<> arena_nested;
+
+  {
+    ScopedThreadArena scoped_arena(arena);
+    EXPECT_EQ(ScopedThreadArena::active(), &arena);
+
+    Vector<int, 0, ArenaAllocator> vec = {1, 2, 3};
+    EXPECT_EQ((uintptr_t)vec.data(), (uintptr_t)buffer.ptr());
+
+    {
+      ScopedThreadArena scoped_arena_nested(arena_nested);
+      EXPECT_EQ(ScopedThreadArena::active(), &arena_nested);
+      /* Existing containers keep using their arena. */
+      vec.append(4);
+      EXPECT_GE((uintptr_t)vec.data(), (uintptr_t)buffer.ptr());
+      EXPECT_LT((uintptr_t)vec.data(), (uintptr_t)buffer.ptr() + 1024);
+    }
+    EXPECT_EQ(ScopedThreadArena::active(), &arena);
+  }
+  EXPECT_EQ(ScopedThreadArena::active(), nullptr);
+}
+
+}  // namespace blender::tests
@@ -111,6 +111,12 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+TEST_PARSE_FAIL(Truncated12, "2 //")
+TEST_PARSE_FAIL(Truncated13, "math.")
+TEST_PARSE_FAIL(MathModuleBuiltin, "math.min(1, 2)")
+TEST_PARSE_FAIL(MathModuleUnknown, "math.foo(1)")
+TEST_PARSE_FAIL(MathModuleName, "math.x")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -143,6 +149,9 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", M_PI * 2.0)
+TEST_CONST(MathPi, "math.pi", M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -157,6 +166,17 @@ TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
 
+TEST_CONST(Log10, "log10(100)", 2.0)
+TEST_CONST(Log2, "log2(8)", 3.0)
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+TEST_CONST(Float, "float(2)", 2.0)
+TEST_CONST(Bool1, "bool(2)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
+TEST_EVAL(Tanh, "tanh(x)", 0.5, tanh(0.5))
+TEST_EVAL(MathSin, "math.sin(x)", 0.5, sin(0.5))
+TEST_EVAL(MathSin2, "math . sin(x)", 0.5, sin(0.5))
+
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
 TEST_CONST(Round3, "round(0.4)", 0.0)
@@ -205,6 +225,23 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(Power1, "2 ** 3", 8.0)
+TEST_CONST(Power2, "-2 ** 2", -4.0)
+TEST_CONST(Power3, "2 ** -1", 0.5)
+TEST_CONST(Power4, "2 ** 3 ** 2", 512.0)
+TEST_CONST(Power5, "2 * 3 ** 2", 18.0)
+TEST_EVAL(Power1, "x ** 2", 3.0, 9.0)
+
+TEST_CONST(FloorDiv1, "7 // 2", 3.0)
+TEST_CONST(FloorDiv2, "-7 // 2", -4.0)
+TEST_EVAL(FloorDiv1, "x // 2", 7.0, 3.0)
+
+TEST_CONST(Mod1, "7 % 3", 1.0)
+TEST_CONST(Mod2, "-7 % 3", 2.0)
+TEST_CONST(Mod3, "7 % -3", -2.0)
+TEST_CONST(Mod4, "1 + 7 % 3 * 2", 3.0)
+TEST_EVAL(Mod1, "x % 3", 7.5, 1.5)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -329,6 +366,8 @@ TEST_ERROR(DivZero1, "0 / 0", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(DivZero2, "1 / 0", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(DivZero3, "1 / x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(DivZero4, "1 / x", 1.0, EXPR_PYLIKE_SUCCESS)
+TEST_ERROR(DivZero5, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(DivZero6, "0 ** x", -1.0, EXPR_PYLIKE_DIV_BY_ZERO)
 
 TEST_ERROR(SqrtDomain1, "sqrt(-1)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(SqrtDomain2, "sqrt(x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
@@ -115,4 +115,27 @@ TEST(linear_allocator, ConstructArrayCopy)
   EXPECT_EQ(span2[2], 3);
 }
 
+TEST(linear_allocator, Reset)
+{
+  LinearAllocator<> allocator;
+
+  /* Allocate enough to need multiple buffers. */
+  uintptr_t first_ptr = (uintptr_t)allocator.allocate(10, 4);
+  for (int i = 0; i < 100; i++) {
+    allocator.allocate(100, 4);
+  }
+  uintptr_t last_ptr = (uintptr_t)allocator.allocate(10, 4);
+  EXPECT_NE(first_ptr, last_ptr);
+
+  allocator.reset();
+  /* The largest buffer is reused from the start. */
+  uintptr_t ptr = (uintptr_t)allocator.allocate(10, 4);
+  EXPECT_NE(ptr, first_ptr);
+  for (int i = 0; i < 100; i++) {
+    uintptr_t next_ptr = (uintptr_t)allocator.allocate(10, 4);
+    EXPECT_EQ(next_ptr, ptr + 12);
+    ptr = next_ptr;
+  }
+}
+
 }  // namespace blender::tests
@@ -0,0 +1,138 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_ptr_map.h"
+#include "BLI_utildefines.h"
+
+#define TESTCASE_SIZE 10000
+
+TEST(ptr_map, InsertLookup)
+{
+  static int keys[TESTCASE_SIZE];
+  PtrMap *map = BLI_ptr_map_new();
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ptr_map_insert(map, &keys[i], POINTER_FROM_INT(i));
+  }
+  EXPECT_EQ(BLI_ptr_map_len(map), TESTCASE_SIZE);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_TRUE(BLI_ptr_map_haskey(map, &keys[i]));
+    EXPECT_EQ(POINTER_AS_INT(BLI_ptr_map_lookup(map, &keys[i])), i);
+  }
+  EXPECT_EQ(BLI_ptr_map_lookup(map, nullptr), nullptr);
+  EXPECT_EQ(BLI_ptr_map_lookup_p(map, nullptr), nullptr);
+
+  BLI_ptr_map_free(map);
+}
+
+TEST(ptr_map, AddReinsertRemove)
+{
+  int a, b;
+  PtrMap *map = BLI_ptr_map_new_ex(2);
+
+  EXPECT_TRUE(BLI_ptr_map_add(map, &a, &b));
+  EXPECT_FALSE(BLI_ptr_map_add(map, &a, &a));
+  EXPECT_EQ(BLI_ptr_map_lookup(map, &a), &b);
+
+  BLI_ptr_map_reinsert(map, &a, &a);
+  EXPECT_EQ(BLI_ptr_map_lookup(map, &a), &a);
+
+  EXPECT_TRUE(BLI_ptr_map_remove(map, &a));
+  EXPECT_FALSE(BLI_ptr_map_remove(map, &a));
+  EXPECT_EQ(BLI_ptr_map_len(map), 0);
+  EXPECT_EQ(BLI_ptr_map_lookup_default(map, &a, &b), &b);
+
+  BLI_ptr_map_free(map);
+}
+
+TEST(ptr_map, EnsureP)
+{
+  static int keys[TESTCASE_SIZE];
+  PtrMap *map = BLI_ptr_map_new();
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < TESTCASE_SIZE; i++) {
+      void **val_p;
+      const bool exists = BLI_ptr_map_ensure_p(map, &keys[i], &val_p);
+      EXPECT_EQ(exists, pass == 1);
+      if (!exists) {
+        EXPECT_EQ(*val_p, nullptr);
+        *val_p = POINTER_FROM_INT(i);
+      }
+      else {
+        EXPECT_EQ(POINTER_AS_INT(*val_p), i);
+      }
+    }
+  }
+  EXPECT_EQ(BLI_ptr_map_len(map), TESTCASE_SIZE);
+
+  BLI_ptr_map_free(map);
+}
+
+TEST(ptr_map, Iter)
+{
+  static int keys[TESTCASE_SIZE];
+  PtrMap *map = BLI_ptr_map_new();
+  PtrMapIterator iter;
+  int len = 0;
+
+  PTR_MAP_ITER (iter, map) {
+    len++;
+  }
+  EXPECT_EQ(len, 0);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ptr_map_insert(map, &keys[i], POINTER_FROM_INT(i));
+  }
+
+  PTR_MAP_ITER (iter, map) {
+    const int *key = static_cast<int *>(BLI_ptr_map_iter_key(&iter));
+    EXPECT_EQ(POINTER_AS_INT(BLI_ptr_map_iter_value(&iter)), key - keys);
+    *BLI_ptr_map_iter_value_p(&iter) = nullptr;
+    len++;
+  }
+  EXPECT_EQ(len, TESTCASE_SIZE);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(BLI_ptr_map_lookup(map, &keys[i]), nullptr);
+  }
+
+  BLI_ptr_map_free(map);
+}
+
+TEST(ptr_set, AddRemoveIter)
+{
+  static int keys[TESTCASE_SIZE];
+  PtrSet *set = BLI_ptr_set_new();
+  PtrSetIterator iter;
+  int len = 0;
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_TRUE(BLI_ptr_set_add(set, &keys[i]));
+    EXPECT_FALSE(BLI_ptr_set_add(set, &keys[i]));
+  }
+  EXPECT_EQ(BLI_ptr_set_len(set), TESTCASE_SIZE);
+
+  /* Remove every other key while iterating. */
+  PTR_SET_ITER (iter, set) {
+    const int *key = static_cast<int *>(BLI_ptr_set_iter_key(&iter));
+    if ((key - keys) % 2) {
+      EXPECT_TRUE(BLI_ptr_set_remove(set, key));
+    }
+    len++;
+  }
+  EXPECT_EQ(len, TESTCASE_SIZE);
+  EXPECT_EQ(BLI_ptr_set_len(set), TESTCASE_SIZE / 2);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(BLI_ptr_set_haskey(set, &keys[i]), (i % 2) == 0);
+  }
+
+  BLI_ptr_set_clear(set);
+  EXPECT_EQ(BLI_ptr_set_len(set), 0);
+  EXPECT_FALSE(BLI_ptr_set_haskey(set, &keys[0]));
+
+  BLI_ptr_set_free(set);
+}
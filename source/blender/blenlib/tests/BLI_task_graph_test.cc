@@ -6,6 +6,8 @@
 
 #include "BLI_task.h"
 
+#include <vector>
+
 struct TaskData {
   int value;
   int store;
@@ -188,3 +190,51 @@ TEST(task, GraphTaskData)
   EXPECT_EQ(1, data.value);
   EXPECT_EQ(0, data.store);
 }
+
+struct TaskOrderData {
+  std::vector<int> *order;
+  int id;
+};
+
+static void TaskOrderData_record(void *taskdata)
+{
+  TaskOrderData *data = (TaskOrderData *)taskdata;
+  data->order->push_back(data->id);
+}
+
+TEST(task, GraphSchedulingHints)
+{
+  std::vector<int> order;
+  TaskOrderData data[6];
+  for (int i = 0; i < 6; i++) {
+    data[i] = {&order, i};
+  }
+
+  TaskGraph *graph = BLI_task_graph_create();
+  TaskNode *nodes[6];
+  for (int i = 0; i < 6; i++) {
+    nodes[i] = BLI_task_graph_node_create(graph, TaskOrderData_record, &data[i], nullptr);
+  }
+
+  /* 0 => 1, 0 => 2 => 3, 0 => 4, 0 => 5 */
+  BLI_task_graph_edge_create(nodes[0], nodes[1]);
+  BLI_task_graph_edge_create(nodes[0], nodes[2]);
+  BLI_task_graph_edge_create(nodes[2], nodes[3]);
+  BLI_task_graph_edge_create(nodes[0], nodes[4]);
+  BLI_task_graph_edge_create(nodes[0], nodes[5]);
+  /* Expensive node at the end of a chain goes before a cheaper single node. */
+  BLI_task_graph_node_cost_set(nodes[1], 2.0f);
+  BLI_task_graph_node_cost_set(nodes[3], 10.0f);
+  /* Priority goes before cost. */
+  BLI_task_graph_node_priority_set(nodes[5], TASK_PRIORITY_HIGH);
+
+  EXPECT_TRUE(BLI_task_graph_node_push_work(nodes[0]));
+  BLI_task_graph_work_and_wait(graph);
+
+  EXPECT_EQ(order.size(), 6u);
+  /* Execution order is only deterministic without multi-threading. */
+  if (BLI_task_scheduler_num_threads() == 1) {
+    EXPECT_EQ(order, std::vector<int>({0, 5, 2, 3, 1, 4}));
+  }
+  BLI_task_graph_free(graph);
+}
@@ -12,6 +12,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #define NUM_ITEMS 10000
 
@@ -181,3 +182,69 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** C++ parallel algorithms. *** */
+
+namespace blender::tests {
+
+TEST(task, ParallelReduce)
+{
+  const int64_t sum = parallel_reduce(
+      IndexRange(NUM_ITEMS),
+      100,
+      int64_t(0),
+      [](IndexRange range, int64_t value) {
+        for (const int64_t i : range) {
+          value += i;
+        }
+        return value;
+      },
+      [](int64_t a, int64_t b) { return a + b; });
+  EXPECT_EQ(sum, int64_t(NUM_ITEMS) * (NUM_ITEMS - 1) / 2);
+}
+
+TEST(task, ParallelExclusiveScan)
+{
+  Array<int> values(NUM_ITEMS);
+  for (const int64_t i : values.index_range()) {
+    values[i] = i % 7;
+  }
+  Array<int> sums(NUM_ITEMS);
+  const int total = parallel_exclusive_scan<int>(values, sums, 64, 5);
+
+  int expected = 5;
+  for (const int64_t i : values.index_range()) {
+    EXPECT_EQ(sums[i], expected);
+    expected += values[i];
+  }
+  EXPECT_EQ(total, expected);
+
+  /* In place and smaller than a single chunk. */
+  Array<int> offsets = {3, 1, 2};
+  EXPECT_EQ(parallel_exclusive_scan<int>(offsets, offsets, 64), 6);
+  EXPECT_EQ(offsets[0], 0);
+  EXPECT_EQ(offsets[1], 3);
+  EXPECT_EQ(offsets[2], 4);
+}
+
+TEST(task, ParallelFilterIndices)
+{
+  Vector<int64_t> indices;
+  IndexMask mask = parallel_filter_indices(
+      IndexRange(NUM_ITEMS), 64, indices, [](int64_t i) { return i % 3 == 0; });
+  EXPECT_EQ(mask.size(), (NUM_ITEMS + 2) / 3);
+  for (const int64_t i : mask.index_range()) {
+    EXPECT_EQ(mask[i], i * 3);
+  }
+
+  /* Filter an existing mask. */
+  Vector<int64_t> indices_even;
+  IndexMask mask_even = parallel_filter_indices(
+      mask, 16, indices_even, [](int64_t i) { return i % 2 == 0; });
+  EXPECT_EQ(mask_even.size(), (NUM_ITEMS + 5) / 6);
+  for (const int64_t i : mask_even.index_range()) {
+    EXPECT_EQ(mask_even[i], i * 6);
+  }
+}
+
+}  // namespace blender::tests
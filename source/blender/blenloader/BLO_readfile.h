@@ -113,6 +113,8 @@ BlendFileData *BLO_read_from_memfile(struct Main *oldmain,
 
 void BLO_blendfiledata_free(BlendFileData *bfd);
 
+void BLO_file_dna_cache_clear(void);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -25,6 +25,8 @@
  */
 
 struct GHash;
+struct MemFileChunkBuffer;
+struct MemFileChunkStore;
 struct Scene;
 
 typedef struct {
@@ -32,7 +34,11 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   size_t size;
-  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
+  /** Reference counted storage of #MemFileChunk.buf, may be shared with any other chunk
+   * (from any #MemFile using the same #MemFile.chunk_store) that has the same content. */
+  struct MemFileChunkBuffer *buffer;
+  /** When true, this chunk is identical to the matching chunk in the previous step
+   * (used by undo code to detect unchanged IDs). */
   bool is_identical;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
@@ -45,7 +51,10 @@ typedef struct {
 
 typedef struct MemFile {
   ListBase chunks;
+  /** Size of the chunk buffers allocated for this memfile (not shared with previous steps). */
   size_t size;
+  /** Content addressed storage of the chunk buffers, shared by consecutive undo steps. */
+  struct MemFileChunkStore *chunk_store;
 } MemFile;
 
 typedef struct MemFileWriteData {
@@ -73,6 +82,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+void BLO_memfile_chunk_add_reference_id(MemFileWriteData *mem_data);
 
 /* exports */
 extern void BLO_memfile_free(MemFile *memfile);
@@ -65,6 +65,8 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
@@ -918,11 +920,38 @@ BHead *blo_bhead_next(FileData *fd, BHead *thisblock)
 }
 
 #ifdef USE_BHEAD_READ_ON_DEMAND
+/**
+ * Access the data of a block which hasn't been read yet in-place in the memory mapped file,
+ * avoiding an intermediate copy when the data is only read (e.g. as the source of DNA
+ * reconstruction).
+ *
+ * 
+eturn NULL when the file isn't memory mapped.
+ * 
+ote Use #BLI_mmap_any_io_error after accessing the data.
+ */
+static const void *blo_bhead_data_mmap_pointer(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  if ((fd->mmap_file == NULL) || new_bhead->has_data) {
+    return NULL;
+  }
+  if ((size_t)new_bhead->file_offset + (size_t)thisblock->len > fd->buffersize) {
+    return NULL;
+  }
+  return POINTER_OFFSET(BLI_mmap_get_pointer(fd->mmap_file), new_bhead->file_offset);
+}
+
 static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
 {
   bool success = true;
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
   BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->mmap_file != NULL) {
+    /* No need to seek, copy straight from the mapping. */
+    return BLI_mmap_read(
+        fd->mmap_file, buf, (size_t)new_bhead->file_offset, (size_t)new_bhead->bhead.len);
+  }
   off64_t offset_backup = fd->file_offset;
   if (UNLIKELY(fd->seek(fd, new_bhead->file_offset, SEEK_SET) == -1)) {
     success = false;
@@ -1001,6 +1030,145 @@ static void decode_blender_header(FileData *fd)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name File DNA Cache
+ *
+ * Parsing the DNA of a file and comparing it against the current DNA is done for every file
+ * that is opened, which adds up when a file links many libraries. Most of these were saved by
+ * the same Blender version, so the parsed DNA is shared between files with identical DNA.
+ *
+ * Entries are reference counted by the #FileData using them. A few unused entries are kept
+ * so that consecutive link operations can reuse them too.
+ * \{ */
+
+typedef struct FileDNACache {
+  struct FileDNACache *next, *prev;
+
+  /* Key: the raw DNA block and what #blo_do_versions_dna depends on. */
+  void *data;
+  int data_len;
+  bool do_endian_swap;
+  int fileversion, subversion;
+
+  SDNA *filesdna;
+  const char *compflags;
+  struct DNA_ReconstructInfo *reconstruct_info;
+  int id_name_offs;
+
+  int users;
+} FileDNACache;
+
+/* Maximum number of unused entries kept in the cache. */
+#define FILE_DNA_CACHE_UNUSED_MAX 4
+
+static ListBase file_dna_cache = {NULL, NULL};
+static ThreadMutex file_dna_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static void file_dna_cache_entry_free(FileDNACache *cache)
+{
+  DNA_reconstruct_info_free(cache->reconstruct_info);
+  MEM_freeN((void *)cache->compflags);
+  DNA_sdna_free(cache->filesdna);
+  MEM_freeN(cache->data);
+  MEM_freeN(cache);
+}
+
+/**
+ * Find or create the parsed DNA for a file, adding a user.
+ * \return NULL when the DNA can't be read, setting \a r_error_message.
+ */
+static FileDNACache *file_dna_cache_acquire(const void *data,
+                                            const int data_len,
+                                            const bool do_endian_swap,
+                                            const int fileversion,
+                                            const int subversion,
+                                            const SDNA *memsdna,
+                                            const char **r_error_message)
+{
+  FileDNACache *cache;
+
+  BLI_mutex_lock(&file_dna_cache_lock);
+
+  for (cache = file_dna_cache.first; cache; cache = cache->next) {
+    if (cache->data_len == data_len && cache->do_endian_swap == do_endian_swap &&
+        cache->fileversion == fileversion && cache->subversion == subversion &&
+        memcmp(cache->data, data, (size_t)data_len) == 0) {
+      cache->users++;
+      BLI_mutex_unlock(&file_dna_cache_lock);
+      return cache;
+    }
+  }
+
+  SDNA *filesdna = DNA_sdna_from_data(data, data_len, do_endian_swap, true, r_error_message);
+  if (filesdna == NULL) {
+    BLI_mutex_unlock(&file_dna_cache_lock);
+    return NULL;
+  }
+
+  cache = MEM_callocN(sizeof(*cache), __func__);
+  cache->data = MEM_mallocN((size_t)data_len, __func__);
+  memcpy(cache->data, data, (size_t)data_len);
+  cache->data_len = data_len;
+  cache->do_endian_swap = do_endian_swap;
+  cache->fileversion = fileversion;
+  cache->subversion = subversion;
+
+  blo_do_versions_dna(filesdna, fileversion, subversion);
+  cache->filesdna = filesdna;
+  cache->compflags = DNA_struct_get_compareflags(filesdna, memsdna);
+  cache->reconstruct_info = DNA_reconstruct_info_create(filesdna, memsdna, cache->compflags);
+  /* used to retrieve ID names from (bhead+1) */
+  cache->id_name_offs = DNA_elem_offset(filesdna, "ID", "char", "name[]");
+  BLI_assert(cache->id_name_offs != -1);
+
+  cache->users = 1;
+  BLI_addhead(&file_dna_cache, cache);
+
+  BLI_mutex_unlock(&file_dna_cache_lock);
+  return cache;
+}
+
+static void file_dna_cache_release(FileDNACache *cache)
+{
+  BLI_mutex_lock(&file_dna_cache_lock);
+
+  BLI_assert(cache->users > 0);
+  cache->users--;
+
+  /* Keep the most recently released entries at the front, free the oldest unused ones. */
+  BLI_remlink(&file_dna_cache, cache);
+  BLI_addhead(&file_dna_cache, cache);
+
+  int unused_len = 0;
+  LISTBASE_FOREACH_MUTABLE (FileDNACache *, cache_iter, &file_dna_cache) {
+    if (cache_iter->users == 0 && ++unused_len > FILE_DNA_CACHE_UNUSED_MAX) {
+      BLI_remlink(&file_dna_cache, cache_iter);
+      file_dna_cache_entry_free(cache_iter);
+    }
+  }
+
+  BLI_mutex_unlock(&file_dna_cache_lock);
+}
+
+/**
+ * Free the unused parsed DNA of previously read files, call on exit.
+ */
+void BLO_file_dna_cache_clear(void)
+{
+  BLI_mutex_lock(&file_dna_cache_lock);
+
+  LISTBASE_FOREACH_MUTABLE (FileDNACache *, cache, &file_dna_cache) {
+    if (cache->users == 0) {
+      BLI_remlink(&file_dna_cache, cache);
+      file_dna_cache_entry_free(cache);
+    }
+  }
+
+  BLI_mutex_unlock(&file_dna_cache_lock);
+}
+
+/** \} */
+
 /**
  * \return Success if the file is read correctly, else set \a r_error_message.
  */
@@ -1028,16 +1196,18 @@ static bool read_file_dna(FileData *fd, const char **r_error_message)
     else if (bhead->code == DNA1) {
       const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
 
-      fd->filesdna = DNA_sdna_from_data(
-          &bhead[1], bhead->len, do_endian_swap, true, r_error_message);
-      if (fd->filesdna) {
-        blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
-        fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
-        fd->reconstruct_info = DNA_reconstruct_info_create(
-            fd->filesdna, fd->memsdna, fd->compflags);
-        /* used to retrieve ID names from (bhead+1) */
-        fd->id_name_offs = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
-        BLI_assert(fd->id_name_offs != -1);
+      fd->filesdna_cache = file_dna_cache_acquire(&bhead[1],
+                                                  bhead->len,
+                                                  do_endian_swap,
+                                                  fd->fileversion,
+                                                  subversion,
+                                                  fd->memsdna,
+                                                  r_error_message);
+      if (fd->filesdna_cache) {
+        fd->filesdna = fd->filesdna_cache->filesdna;
+        fd->compflags = fd->filesdna_cache->compflags;
+        fd->reconstruct_info = fd->filesdna_cache->reconstruct_info;
+        fd->id_name_offs = fd->filesdna_cache->id_name_offs;
 
         return true;
       }
@@ -1124,6 +1294,51 @@ static off64_t fd_seek_data_from_file(FileData *filedata, off64_t offset, int wh
   return filedata->file_offset;
 }
 
+/* Memory-mapped file reading.
+ * The file is mapped read-only so that blocks can be copied (or accessed in-place)
+ * without a system call per read, pages are shared with the OS file cache. */
+
+static ssize_t fd_read_from_mmap(FileData *filedata,
+                                 void *buffer,
+                                 size_t size,
+                                 bool *UNUSED(r_is_memchunck_identical))
+{
+  /* Don't read more bytes than there are available in the mapping. */
+  const size_t readsize = MIN2(size, filedata->buffersize - (size_t)filedata->file_offset);
+
+  if (!BLI_mmap_read(filedata->mmap_file, buffer, (size_t)filedata->file_offset, readsize)) {
+    return EOF;
+  }
+
+  filedata->file_offset += readsize;
+
+  return (ssize_t)readsize;
+}
+
+static off64_t fd_seek_from_mmap(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_pos;
+  if (whence == SEEK_CUR) {
+    new_pos = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_SET) {
+    new_pos = offset;
+  }
+  else if (whence == SEEK_END) {
+    new_pos = (off64_t)filedata->buffersize + offset;
+  }
+  else {
+    return -1;
+  }
+
+  if (new_pos < 0 || new_pos > (off64_t)filedata->buffersize) {
+    return -1;
+  }
+
+  filedata->file_offset = new_pos;
+  return filedata->file_offset;
+}
+
 /* GZip file reading. */
 
 static ssize_t fd_read_gzip_from_file(FileData *filedata,
@@ -1290,6 +1505,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   FileDataSeekFn *seek_fn = NULL; /* Optional. */
 
   gzFile gzfile = (gzFile)Z_NULL;
+  BLI_mmap_file *mmap_file = NULL;
 
   char header[7];
 
@@ -1308,8 +1524,17 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   /* Regular file. */
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
-    read_fn = fd_read_data_from_file;
-    seek_fn = fd_seek_data_from_file;
+    /* Prefer memory-mapped IO, fall back to regular reading when it's not supported. */
+    mmap_file = BLI_mmap_open(file);
+    if (mmap_file != NULL) {
+      read_fn = fd_read_from_mmap;
+      seek_fn = fd_seek_from_mmap;
+    }
+    else {
+      BLI_lseek(file, 0, SEEK_SET);
+      read_fn = fd_read_data_from_file;
+      seek_fn = fd_seek_data_from_file;
+    }
   }
 
   /* Gzip file. */
@@ -1342,6 +1567,10 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   fd->filedes = file;
   fd->gzfiledes = gzfile;
+  if (mmap_file != NULL) {
+    fd->mmap_file = mmap_file;
+    fd->buffersize = BLI_mmap_get_length(mmap_file);
+  }
 
   fd->read = read_fn;
   fd->seek = seek_fn;
@@ -1494,6 +1723,10 @@ FileData *blo_filedata_from_memfile(MemFile *memfile,
 void blo_filedata_free(FileData *fd)
 {
   if (fd) {
+    if (fd->mmap_file != NULL) {
+      BLI_mmap_free(fd->mmap_file);
+    }
+
     if (fd->filedes != -1) {
       close(fd->filedes);
     }
@@ -1526,14 +1759,8 @@ void blo_filedata_free(FileData *fd)
     }
 #endif
 
-    if (fd->filesdna) {
-      DNA_sdna_free(fd->filesdna);
-    }
-    if (fd->compflags) {
-      MEM_freeN((void *)fd->compflags);
-    }
-    if (fd->reconstruct_info) {
-      DNA_reconstruct_info_free(fd->reconstruct_info);
+    if (fd->filesdna_cache) {
+      file_dna_cache_release(fd->filesdna_cache);
     }
 
     if (fd->datamap) {
@@ -2068,7 +2295,12 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
-static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
+/**
+ * \param r_is_error: Set when reading the data failed. Unlike #read_struct this doesn't modify
+ * `fd` so it's safe to call from multiple threads when the data can be read without using the
+ * file position, see #read_data_use_threads.
+ */
+static void *read_struct_ex(FileData *fd, BHead *bh, const char *blockname, bool *r_is_error)
 {
   void *temp = NULL;
 
@@ -2083,7 +2315,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
       if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
         bh = blo_bhead_read_full(fd, bh);
         if (UNLIKELY(bh == NULL)) {
-          fd->flags &= ~FD_FLAGS_FILE_OK;
+          *r_is_error = true;
           return NULL;
         }
       }
@@ -2094,15 +2326,28 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
-        if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return NULL;
+        const void *data_mmap = blo_bhead_data_mmap_pointer(fd, bh);
+        if (data_mmap != NULL) {
+          /* Reconstruct straight from the mapped file, no need to read the block first. */
+          temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data_mmap);
+          if (UNLIKELY(BLI_mmap_any_io_error(fd->mmap_file))) {
+            *r_is_error = true;
+            MEM_SAFE_FREE(temp);
           }
         }
-#endif
+        else {
+          if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == NULL)) {
+              *r_is_error = true;
+              return NULL;
+            }
+          }
+          temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        }
+#else
         temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+#endif
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -2115,7 +2360,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
           /* Instead of allocating the bhead, then copying it,
            * read the data from the file directly into the memory. */
           if (UNLIKELY(!blo_bhead_read_data(fd, bh, temp))) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
+            *r_is_error = true;
             MEM_freeN(temp);
             temp = NULL;
           }
@@ -2136,6 +2381,16 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
   return temp;
 }
 
+static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
+{
+  bool is_error = false;
+  void *temp = read_struct_ex(fd, bh, blockname, &is_error);
+  if (UNLIKELY(is_error)) {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+  }
+  return temp;
+}
+
 /* Like read_struct, but gets a pointer without allocating. Only works for
  * undo since DNA must match. */
 static const void *peek_struct_undo(FileData *fd, BHead *bhead)
@@ -3227,11 +3482,122 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+/* Threaded data reading.
+ *
+ * Converting the data blocks of an ID (endian switch, DNA reconstruction and copying into new
+ * allocations) is independent for every block. For IDs with many or large blocks (meshes,
+ * packed files, ...) this is done in parallel, when the blocks can be accessed without using
+ * the shared file position: either all data is already in memory (compressed files and undo)
+ * or the file is memory mapped.
+ *
+ * Adding the results to `fd->datamap` remains single threaded and in file order. */
+
+/** Minimum number of data blocks of an ID to convert them in parallel. */
+#define READ_DATA_THREADED_MIN_BLOCKS 256
+/** Minimum size of all data blocks of an ID to convert them in parallel. */
+#define READ_DATA_THREADED_MIN_SIZE (1 << 20)
+
+typedef struct ReadDataThreadedData {
+  FileData *fd;
+  const char *allocname;
+  BHead **bheads;
+  void **data;
+  bool *is_error;
+} ReadDataThreadedData;
+
+static bool read_data_use_threads(const FileData *fd)
+{
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  if ((fd->seek != NULL) && (fd->mmap_file == NULL)) {
+    /* Blocks might need to be read on demand with `fd->read`. */
+    return false;
+  }
+#endif
+  return BLI_task_scheduler_num_threads() > 1;
+}
+
+static void read_data_threaded_fn(void *__restrict userdata,
+                                  const int index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadDataThreadedData *data = userdata;
+  data->data[index] = read_struct_ex(
+      data->fd, data->bheads[index], data->allocname, &data->is_error[index]);
+}
+
+/**
+ * Convert the data blocks starting at `bhead_first` in parallel.
+ * \return false when there are too few blocks or too little data for threading to pay off,
+ * in that case nothing is read.
+ */
+static bool read_data_into_datamap_threaded(FileData *fd,
+                                            BHead *bhead_first,
+                                            const char *allocname)
+{
+  int bheads_num = 0;
+  size_t data_len = 0;
+  for (BHead *bhead = bhead_first; bhead && bhead->code == DATA;
+       bhead = blo_bhead_next(fd, bhead)) {
+    bheads_num++;
+    data_len += (size_t)bhead->len;
+  }
+
+  if ((bheads_num < READ_DATA_THREADED_MIN_BLOCKS) && (data_len < READ_DATA_THREADED_MIN_SIZE)) {
+    return false;
+  }
+
+  ReadDataThreadedData data = {
+      .fd = fd,
+      .allocname = allocname,
+      .bheads = MEM_malloc_arrayN((size_t)bheads_num, sizeof(*data.bheads), __func__),
+      .data = MEM_malloc_arrayN((size_t)bheads_num, sizeof(*data.data), __func__),
+      .is_error = MEM_calloc_arrayN((size_t)bheads_num, sizeof(*data.is_error), __func__),
+  };
+
+  /* Gather the blocks here, reading the block headers is not thread-safe. */
+  int i = 0;
+  for (BHead *bhead = bhead_first; i < bheads_num; bhead = blo_bhead_next(fd, bhead), i++) {
+    data.bheads[i] = bhead;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, bheads_num, &data, read_data_threaded_fn, &settings);
+
+  for (i = 0; i < bheads_num; i++) {
+    if (UNLIKELY(data.is_error[i])) {
+      fd->flags &= ~FD_FLAGS_FILE_OK;
+    }
+    if (data.data[i]) {
+      oldnewmap_insert(fd->datamap, data.bheads[i]->old, data.data[i], 0);
+    }
+  }
+
+  MEM_freeN(data.bheads);
+  MEM_freeN(data.data);
+  MEM_freeN(data.is_error);
+
+  return true;
+}
+
+#undef READ_DATA_THREADED_MIN_BLOCKS
+#undef READ_DATA_THREADED_MIN_SIZE
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
   bhead = blo_bhead_next(fd, bhead);
 
+  if (bhead && (bhead->code == DATA) && read_data_use_threads(fd) &&
+      read_data_into_datamap_threaded(fd, bhead, allocname)) {
+    /* Skip the blocks which have been read. */
+    while (bhead && bhead->code == DATA) {
+      bhead = blo_bhead_next(fd, bhead);
+    }
+    return bhead;
+  }
+
   while (bhead && bhead->code == DATA) {
     /* The code below is useful for debugging leaks in data read from the blend file.
      * Without this the messages only tell us what ID-type the memory came from,
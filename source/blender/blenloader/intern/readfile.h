@@ -85,6 +85,8 @@ typedef struct FileData {
 
   /** Regular file reading. */
   int filedes;
+  /** Memory-mapped file reading (`buffersize` is the length of the mapping). */
+  struct BLI_mmap_file *mmap_file;
 
   /** Variables needed for reading from memory / stream. */
   const char *buffer;
@@ -103,6 +105,8 @@ typedef struct FileData {
   char relabase[FILE_MAX];
 
   /** General reading variables. */
+  /** Owns #filesdna, #compflags and #reconstruct_info, which may be shared with other files. */
+  struct FileDNACache *filesdna_cache;
   struct SDNA *filesdna;
   const struct SDNA *memsdna;
   /** Array of #eSDNA_StructCompare. */
@@ -42,6 +42,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -54,53 +55,131 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/* -------------------------------------------------------------------- */
+/** \name Chunk Store
+ *
+ * Chunk buffers are reference counted and stored by their content, so identical chunks are
+ * shared between all undo steps, regardless of their position in the memfile (e.g. when IDs
+ * are written in a different order or data is inserted before them).
+ *
+ * A store is shared by all memfiles written using a previous memfile as reference.
+ * \{ */
+
+typedef struct MemFileChunkBuffer {
+  /** Points to the memory directly after this struct. */
+  const char *data;
+  size_t size;
+  uint hash;
+  /** Number of #MemFileChunk using this buffer. */
+  int users;
+} MemFileChunkBuffer;
+
+typedef struct MemFileChunkStore {
+  /** Set of #MemFileChunkBuffer, hashed by their content. */
+  GSet *buffers;
+  /** Number of #MemFile using this store. */
+  int users;
+} MemFileChunkStore;
+
+static uint chunk_buffer_hash(const void *key)
+{
+  const MemFileChunkBuffer *buffer = key;
+  return buffer->hash;
+}
+
+static bool chunk_buffer_cmp(const void *a, const void *b)
+{
+  const MemFileChunkBuffer *buffer_a = a;
+  const MemFileChunkBuffer *buffer_b = b;
+  return !((buffer_a->hash == buffer_b->hash) && (buffer_a->size == buffer_b->size) &&
+           (memcmp(buffer_a->data, buffer_b->data, buffer_a->size) == 0));
+}
+
+static MemFileChunkStore *chunk_store_new(void)
+{
+  MemFileChunkStore *store = MEM_callocN(sizeof(*store), __func__);
+  store->buffers = BLI_gset_new(chunk_buffer_hash, chunk_buffer_cmp, __func__);
+  return store;
+}
+
+static void chunk_store_user_remove(MemFileChunkStore *store)
+{
+  BLI_assert(store->users > 0);
+  if (--store->users == 0) {
+    /* All chunks have been freed, so all buffers have been removed as well. */
+    BLI_assert(BLI_gset_len(store->buffers) == 0);
+    BLI_gset_free(store->buffers, NULL);
+    MEM_freeN(store);
+  }
+}
+
+/**
+ * \return A buffer with a copy of `data` (or an existing one with the same content),
+ * with a user added for the caller.
+ */
+static MemFileChunkBuffer *chunk_store_buffer_ensure(MemFileChunkStore *store,
+                                                     const char *data,
+                                                     const size_t size,
+                                                     bool *r_is_new)
+{
+  MemFileChunkBuffer key = {
+      .data = data,
+      .size = size,
+      .hash = BLI_hash_mm2((const unsigned char *)data, size, 0),
+  };
+
+  MemFileChunkBuffer *buffer = BLI_gset_lookup(store->buffers, &key);
+  *r_is_new = (buffer == NULL);
+  if (buffer == NULL) {
+    buffer = MEM_mallocN(sizeof(*buffer) + size, "Chunk buffer");
+    char *data_new = (char *)(buffer + 1);
+    memcpy(data_new, data, size);
+    *buffer = key;
+    buffer->data = data_new;
+    buffer->users = 0;
+    BLI_gset_insert(store->buffers, buffer);
+  }
+  buffer->users++;
+  return buffer;
+}
+
+static void chunk_store_buffer_user_remove(MemFileChunkStore *store, MemFileChunkBuffer *buffer)
+{
+  BLI_assert(buffer->users > 0);
+  if (--buffer->users == 0) {
+    BLI_gset_remove(store->buffers, buffer, NULL);
+    MEM_freeN(buffer);
+  }
+}
+
+/** \} */
+
 /* not memfile itself */
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
-      MEM_freeN((void *)chunk->buf);
-    }
+    chunk_store_buffer_user_remove(memfile->chunk_store, chunk->buffer);
     MEM_freeN(chunk);
   }
   memfile->size = 0;
+
+  if (memfile->chunk_store != NULL) {
+    chunk_store_user_remove(memfile->chunk_store);
+    memfile->chunk_store = NULL;
+  }
 }
 
 /* to keep list of memfiles consistent, 'first' is always first in list */
 /* result is that 'first' is being freed */
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
-  /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
-   * by it (i.e. shared with some previous memory steps). */
-  GHash *buffer_to_second_memchunk = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
-
-  /* First, detect all memchunks in second memfile that are not owned by it. */
-  for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
-    }
-  }
-
-  /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
-   * it is also used by the second memfile, transfer the ownership. */
-  for (MemFileChunk *fc = first->chunks.first; fc != NULL; fc = fc->next) {
-    if (!fc->is_identical) {
-      MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf);
-      if (sc != NULL) {
-        BLI_assert(sc->is_identical);
-        sc->is_identical = false;
-        fc->is_identical = true;
-      }
-      /* Note that if the second memfile does not use that chunk, we assume that the first one
-       * fully owns it without sharing it with any other memfile, and hence it should be freed with
-       * it. */
-    }
-  }
-
-  BLI_ghash_free(buffer_to_second_memchunk, NULL, NULL);
+  /* Chunk buffers are reference counted, the ones still used by the second memfile (or any
+   * other one) are kept when freeing the first. */
+  BLI_assert(ELEM(first->chunk_store, NULL, second->chunk_store) ||
+             BLI_listbase_is_empty(&second->chunks));
+  UNUSED_VARS_NDEBUG(second);
 
   BLO_memfile_free(first);
 }
@@ -121,6 +200,16 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
   mem_data->reference_memfile = reference_memfile;
   mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
 
+  /* Share chunk buffers with the reference (and all memfiles it shares them with). */
+  BLI_assert(written_memfile->chunk_store == NULL);
+  if (reference_memfile != NULL && reference_memfile->chunk_store != NULL) {
+    written_memfile->chunk_store = reference_memfile->chunk_store;
+  }
+  else {
+    written_memfile->chunk_store = chunk_store_new();
+  }
+  written_memfile->chunk_store->users++;
+
   /* If we have a reference memfile, we generate a mapping between the session_uuid's of the
    * IDs stored in that previous undo step, and its first matching memchunk. This will allow
    * us to easily find the existing undo memory storage of IDs even when some re-ordering in
@@ -162,6 +251,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
   curchunk->size = size;
   curchunk->buf = NULL;
+  curchunk->buffer = NULL;
   curchunk->is_identical = false;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
@@ -176,6 +266,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->buffer = compchunk->buffer;
+        curchunk->buffer->users++;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
       }
@@ -183,13 +275,47 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = compchunk->next;
   }
 
-  /* not equal... */
+  /* Not equal to the reference chunk, but an identical chunk may still be stored already. */
   if (curchunk->buf == NULL) {
-    char *buf_new = MEM_mallocN(size, "Chunk buffer");
-    memcpy(buf_new, buf, size);
-    curchunk->buf = buf_new;
-    memfile->size += size;
+    bool is_new;
+    curchunk->buffer = chunk_store_buffer_ensure(memfile->chunk_store, buf, size, &is_new);
+    curchunk->buf = curchunk->buffer->data;
+    if (is_new) {
+      memfile->size += size;
+    }
+  }
+}
+
+/**
+ * Add all the reference chunks storing the ID currently being written
+ * (#MemFileWriteData.current_id_session_uuid), starting at
+ * #MemFileWriteData.reference_current_chunk, sharing their buffers without comparing them.
+ *
+ * Used to skip writing IDs known to be unchanged since the reference undo step.
+ */
+void BLO_memfile_chunk_add_reference_id(MemFileWriteData *mem_data)
+{
+  MemFile *memfile = mem_data->written_memfile;
+  MemFileChunk *compchunk = mem_data->reference_current_chunk;
+
+  BLI_assert(mem_data->current_id_session_uuid != MAIN_ID_SESSION_UUID_UNSET);
+
+  for (; compchunk != NULL && compchunk->id_session_uuid == mem_data->current_id_session_uuid;
+       compchunk = compchunk->next) {
+    MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    curchunk->size = compchunk->size;
+    curchunk->buf = compchunk->buf;
+    curchunk->buffer = compchunk->buffer;
+    curchunk->buffer->users++;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uuid = compchunk->id_session_uuid;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
   }
+
+  mem_data->reference_current_chunk = compchunk;
 }
 
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
@@ -100,6 +100,8 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -146,8 +148,12 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+  /** Block-parallel zlib, output is a sequence of independent gzip members. */
+  WW_WRAP_ZLIB_MT,
 } eWriteWrapType;
 
+typedef struct WriteWrapZLibMT WriteWrapZLibMT;
+
 typedef struct WriteWrap WriteWrap;
 struct WriteWrap {
   /* callbacks */
@@ -162,6 +168,7 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    WriteWrapZLibMT *zlib_mt;
   } _user_data;
 };
 
@@ -217,6 +224,212 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* zlib (multi-threaded)
+ *
+ * The stream is split into fixed size blocks which are deflated independently on the task
+ * scheduler while the main thread keeps serializing. Each block is a complete gzip member,
+ * since concatenated members are a valid gzip stream, `gzread` in `readfile.c` (and any other
+ * gzip reader) reads the result without knowing it was written in parallel.
+ *
+ * Blocks are kept in a ring and always written out to the file in submission order,
+ * the ring size bounds the memory used for blocks in flight. */
+
+/** Uncompressed size of a single block (also a gzip member). */
+#define ZLIB_MT_BLOCK_SIZE (1 << 20) /* 1mb */
+/** Number of blocks in flight per thread. */
+#define ZLIB_MT_BLOCKS_PER_THREAD 2
+
+typedef struct ZLibMTBlock {
+  /** Uncompressed data, #ZLIB_MT_BLOCK_SIZE bytes. */
+  char *data_in;
+  size_t data_in_len;
+  /** Compressed gzip member, sized using `deflateBound`. */
+  char *data_out;
+  size_t data_out_size;
+  size_t data_out_len;
+
+  /** Owner, used by the task callback. */
+  WriteWrapZLibMT *zlib_mt;
+  /** Block has been submitted for compressing and not yet written to the file. */
+  bool is_pending;
+  /** Set from the task once compression finished (protected by #WriteWrapZLibMT.mutex). */
+  bool is_done;
+  bool is_error;
+} ZLibMTBlock;
+
+struct WriteWrapZLibMT {
+  int file_handle;
+  TaskPool *task_pool;
+
+  ZLibMTBlock *blocks;
+  int blocks_len;
+  /** Index of the block being filled with data by #ww_write_zlib_mt. */
+  int block_active;
+
+  ThreadMutex mutex;
+  ThreadCondition cond;
+
+  bool error;
+};
+
+static void zlib_mt_block_compress_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ZLibMTBlock *block = taskdata;
+  WriteWrapZLibMT *zlib_mt = block->zlib_mt;
+
+  z_stream stream = {NULL};
+  bool ok = false;
+
+  /* Compression level 1 matches the single threaded writer, add 16 to window bits for a gzip
+   * header and trailer so each block is a self contained gzip member. */
+  if (deflateInit2(&stream, 1, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+    stream.next_in = (Bytef *)block->data_in;
+    stream.avail_in = (uInt)block->data_in_len;
+    stream.next_out = (Bytef *)block->data_out;
+    stream.avail_out = (uInt)block->data_out_size;
+    ok = (deflate(&stream, Z_FINISH) == Z_STREAM_END);
+    block->data_out_len = block->data_out_size - stream.avail_out;
+    deflateEnd(&stream);
+  }
+
+  BLI_mutex_lock(&zlib_mt->mutex);
+  block->is_error = !ok;
+  block->is_done = true;
+  BLI_condition_notify_all(&zlib_mt->cond);
+  BLI_mutex_unlock(&zlib_mt->mutex);
+}
+
+/**
+ * Wait for a pending block to be compressed and write it to the file.
+ */
+static void zlib_mt_block_flush(WriteWrapZLibMT *zlib_mt, ZLibMTBlock *block)
+{
+  if (!block->is_pending) {
+    return;
+  }
+
+  BLI_mutex_lock(&zlib_mt->mutex);
+  while (!block->is_done) {
+    BLI_condition_wait(&zlib_mt->cond, &zlib_mt->mutex);
+  }
+  BLI_mutex_unlock(&zlib_mt->mutex);
+
+  if (block->is_error) {
+    zlib_mt->error = true;
+  }
+  else if (!zlib_mt->error) {
+    if (write(zlib_mt->file_handle, block->data_out, block->data_out_len) !=
+        (ssize_t)block->data_out_len) {
+      zlib_mt->error = true;
+    }
+  }
+
+  block->is_pending = false;
+  block->is_done = false;
+  block->data_in_len = 0;
+}
+
+static void zlib_mt_block_submit(WriteWrapZLibMT *zlib_mt)
+{
+  ZLibMTBlock *block = &zlib_mt->blocks[zlib_mt->block_active];
+  if (block->data_in_len == 0) {
+    return;
+  }
+
+  block->is_pending = true;
+  BLI_task_pool_push(zlib_mt->task_pool, zlib_mt_block_compress_task, block, false, NULL);
+
+  /* The next block in the ring is the oldest one still in flight (if any),
+   * it needs to be written before it can be filled again. */
+  zlib_mt->block_active = (zlib_mt->block_active + 1) % zlib_mt->blocks_len;
+  zlib_mt_block_flush(zlib_mt, &zlib_mt->blocks[zlib_mt->block_active]);
+}
+
+#define ZLIB_MT(ww) (ww)->_user_data.zlib_mt
+
+static bool ww_open_zlib_mt(WriteWrap *ww, const char *filepath)
+{
+  int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+  if (file == -1) {
+    return false;
+  }
+
+  WriteWrapZLibMT *zlib_mt = MEM_callocN(sizeof(*zlib_mt), __func__);
+  zlib_mt->file_handle = file;
+  zlib_mt->task_pool = BLI_task_pool_create(zlib_mt, TASK_PRIORITY_HIGH);
+  zlib_mt->blocks_len = MAX2(2, BLI_task_scheduler_num_threads() * ZLIB_MT_BLOCKS_PER_THREAD);
+  zlib_mt->blocks = MEM_callocN(sizeof(*zlib_mt->blocks) * (size_t)zlib_mt->blocks_len, __func__);
+
+  const size_t data_out_size = compressBound(ZLIB_MT_BLOCK_SIZE) + 32; /* Gzip header/trailer. */
+  for (int i = 0; i < zlib_mt->blocks_len; i++) {
+    ZLibMTBlock *block = &zlib_mt->blocks[i];
+    block->data_in = MEM_mallocN(ZLIB_MT_BLOCK_SIZE, "zlib_mt data_in");
+    block->data_out = MEM_mallocN(data_out_size, "zlib_mt data_out");
+    block->data_out_size = data_out_size;
+    block->zlib_mt = zlib_mt;
+  }
+
+  BLI_mutex_init(&zlib_mt->mutex);
+  BLI_condition_init(&zlib_mt->cond);
+
+  ZLIB_MT(ww) = zlib_mt;
+  return true;
+}
+
+static bool ww_close_zlib_mt(WriteWrap *ww)
+{
+  WriteWrapZLibMT *zlib_mt = ZLIB_MT(ww);
+
+  zlib_mt_block_submit(zlib_mt);
+  /* Write all remaining blocks, oldest first. */
+  for (int i = 0; i < zlib_mt->blocks_len; i++) {
+    const int block_index = (zlib_mt->block_active + i) % zlib_mt->blocks_len;
+    zlib_mt_block_flush(zlib_mt, &zlib_mt->blocks[block_index]);
+  }
+  BLI_task_pool_work_and_wait(zlib_mt->task_pool);
+  BLI_task_pool_free(zlib_mt->task_pool);
+
+  for (int i = 0; i < zlib_mt->blocks_len; i++) {
+    MEM_freeN(zlib_mt->blocks[i].data_in);
+    MEM_freeN(zlib_mt->blocks[i].data_out);
+  }
+  MEM_freeN(zlib_mt->blocks);
+
+  BLI_condition_end(&zlib_mt->cond);
+  BLI_mutex_end(&zlib_mt->mutex);
+
+  bool ok = !zlib_mt->error;
+  if (close(zlib_mt->file_handle) == -1) {
+    ok = false;
+  }
+  MEM_freeN(zlib_mt);
+  ZLIB_MT(ww) = NULL;
+
+  return ok;
+}
+
+static size_t ww_write_zlib_mt(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  WriteWrapZLibMT *zlib_mt = ZLIB_MT(ww);
+  const size_t buf_len_orig = buf_len;
+
+  while (buf_len > 0) {
+    ZLibMTBlock *block = &zlib_mt->blocks[zlib_mt->block_active];
+    const size_t copy_len = MIN2(buf_len, ZLIB_MT_BLOCK_SIZE - block->data_in_len);
+    memcpy(block->data_in + block->data_in_len, buf, copy_len);
+    block->data_in_len += copy_len;
+    buf += copy_len;
+    buf_len -= copy_len;
+
+    if (block->data_in_len == ZLIB_MT_BLOCK_SIZE) {
+      zlib_mt_block_submit(zlib_mt);
+    }
+  }
+
+  return zlib_mt->error ? 0 : buf_len_orig;
+}
+#undef ZLIB_MT
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -231,6 +444,13 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+    case WW_WRAP_ZLIB_MT: {
+      r_ww->open = ww_open_zlib_mt;
+      r_ww->close = ww_close_zlib_mt;
+      r_ww->write = ww_write_zlib_mt;
+      r_ww->use_buf = false;
+      break;
+    }
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -485,6 +705,46 @@ static void mywrite_id_end(WriteData *wd, ID *UNUSED(id))
   }
 }
 
+/**
+ * Check whether the ID (about to be written, see #mywrite_id_begin) can re-use the chunks
+ * stored for it in the reference undo step, without calling its `blend_write` callback.
+ *
+ * This relies on the ID (and its embedded IDs) not having been tagged for update since last
+ * undo push, and on the stored ID struct matching the current one, which also catches renames
+ * and user-count changes that are not tagged.
+ *
+ * \param id_header: The ID struct as it would be written (tags and list pointers cleared).
+ * \param recalc_after_undo_push: Accumulated recalc flags of the ID and its embedded IDs.
+ */
+static bool mywrite_id_can_reuse_reference(WriteData *wd,
+                                           const ID *id,
+                                           const ID *id_header,
+                                           const int recalc_after_undo_push)
+{
+  if (!wd->use_memfile || wd->mem.reference_memfile == NULL || recalc_after_undo_push != 0) {
+    return false;
+  }
+  if (!USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged_ids)) {
+    return false;
+  }
+  /* UI and editing data is often modified without any depsgraph tagging. */
+  if (ELEM(GS(id->name), ID_WM, ID_SCR, ID_WS, ID_TXT, ID_BR, ID_PAL, ID_PC, ID_IM)) {
+    return false;
+  }
+
+  const MemFileChunk *chunk = wd->mem.reference_current_chunk;
+  if (chunk == NULL || chunk->id_session_uuid != id->session_uuid ||
+      chunk->size < sizeof(BHead) + sizeof(ID)) {
+    return false;
+  }
+  /* The first chunk of an ID starts with its own struct, see #BLO_write_id_struct. */
+  const BHead *bhead = (const BHead *)chunk->buf;
+  if (bhead->code != GS(id->name) || bhead->old != id || bhead->nr != 1) {
+    return false;
+  }
+  return memcmp(bhead + 1, id_header, sizeof(ID)) == 0;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -979,6 +1239,8 @@ static bool write_file_handle(Main *mainvar,
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
 
+        int recalc_after_undo_push = id->recalc_after_undo_push;
+
         if (wd->use_memfile) {
           /* Record the changes that happened up to this undo push in
            * recalc_up_to_undo_push, and clear recalc_after_undo_push again
@@ -988,12 +1250,14 @@ static bool write_file_handle(Main *mainvar,
 
           bNodeTree *nodetree = ntreeFromID(id);
           if (nodetree != NULL) {
+            recalc_after_undo_push |= nodetree->id.recalc_after_undo_push;
             nodetree->id.recalc_up_to_undo_push = nodetree->id.recalc_after_undo_push;
             nodetree->id.recalc_after_undo_push = 0;
           }
           if (GS(id->name) == ID_SCE) {
             Scene *scene = (Scene *)id;
             if (scene->master_collection != NULL) {
+              recalc_after_undo_push |= scene->master_collection->id.recalc_after_undo_push;
               scene->master_collection->id.recalc_up_to_undo_push =
                   scene->master_collection->id.recalc_after_undo_push;
               scene->master_collection->id.recalc_after_undo_push = 0;
@@ -1012,6 +1276,15 @@ static bool write_file_handle(Main *mainvar,
         ((ID *)id_buffer)->prev = NULL;
         ((ID *)id_buffer)->next = NULL;
 
+        if (!do_override &&
+            mywrite_id_can_reuse_reference(wd, id, id_buffer, recalc_after_undo_push)) {
+          /* Unchanged since previous undo step, no need to write it again. */
+          BLI_assert(wd->buf_used_len == 0);
+          BLO_memfile_chunk_add_reference_id(&wd->mem);
+          mywrite_id_end(wd, id);
+          continue;
+        }
+
         const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
         if (id_type->blend_write != NULL) {
           id_type->blend_write(&writer, (ID *)id_buffer, id);
@@ -1144,7 +1417,8 @@ bool BLO_write_file(Main *mainvar,
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
   if (write_flags & G_FILE_COMPRESS) {
-    ww_type = WW_WRAP_ZLIB;
+    /* Compressing is by far the most expensive part of saving, spread it over all threads. */
+    ww_type = (BLI_task_scheduler_num_threads() > 1) ? WW_WRAP_ZLIB_MT : WW_WRAP_ZLIB;
   }
   else {
     ww_type = WW_WRAP_NONE;
@@ -1220,9 +1494,12 @@ bool BLO_write_file(Main *mainvar,
   }
 
   /* actual file writing */
-  const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, use_userdef, thumb);
+  bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, use_userdef, thumb);
 
-  ww.close(&ww);
+  /* Compressing writers may still have buffered data, so closing can fail as well. */
+  if (ww.close(&ww) == false) {
+    err = true;
+  }
 
   if (UNLIKELY(path_list_backup)) {
     BKE_bpath_list_restore(mainvar, path_list_flag, path_list_backup);
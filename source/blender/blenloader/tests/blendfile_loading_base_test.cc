@@ -97,6 +97,7 @@ void BlendfileLoadingBaseTest::TearDownTestCase()
   RNA_exit();
 
   DEG_free_node_types();
+  BLO_file_dna_cache_clear();
   DNA_sdna_current_free();
   BLI_threadapi_exit();
 
@@ -81,6 +81,7 @@
 #include "BLI_alloca.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -987,6 +988,112 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
   BKE_mesh_runtime_clear_geometry(me);
 }
 
+typedef struct BMToMeForEvalData {
+  BMesh *bm;
+  Mesh *me;
+
+  /* Read-write data, every element only writes to its own index. */
+  MVert *mvert;
+  MEdge *medge;
+  MLoop *mloop;
+  MPoly *mpoly;
+  /* NULL when no original index layers are added. */
+  int *vert_index;
+  int *edge_index;
+  int *poly_index;
+
+  int cd_vert_bweight_offset;
+  int cd_edge_bweight_offset;
+  int cd_edge_crease_offset;
+} BMToMeForEvalData;
+
+static void bm_to_me_for_eval_vert_cb(void *userdata, MempoolIterData *mp_v)
+{
+  BMToMeForEvalData *data = userdata;
+  BMVert *eve = (BMVert *)mp_v;
+  const int i = BM_elem_index_get(eve);
+  MVert *mv = &data->mvert[i];
+
+  copy_v3_v3(mv->co, eve->co);
+
+  normal_float_to_short_v3(mv->no, eve->no);
+
+  mv->flag = BM_vert_flag_to_mflag(eve);
+
+  if (data->cd_vert_bweight_offset != -1) {
+    mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eve, data->cd_vert_bweight_offset);
+  }
+
+  if (data->vert_index) {
+    data->vert_index[i] = i;
+  }
+
+  CustomData_from_bmesh_block(&data->bm->vdata, &data->me->vdata, eve->head.data, i);
+}
+
+static void bm_to_me_for_eval_edge_cb(void *userdata, MempoolIterData *mp_e)
+{
+  BMToMeForEvalData *data = userdata;
+  BMEdge *eed = (BMEdge *)mp_e;
+  const int i = BM_elem_index_get(eed);
+  MEdge *med = &data->medge[i];
+
+  med->v1 = BM_elem_index_get(eed->v1);
+  med->v2 = BM_elem_index_get(eed->v2);
+
+  med->flag = BM_edge_flag_to_mflag(eed);
+
+  /* Handle this differently to editmode switching,
+   * only enable draw for single user edges rather than calculating angle. */
+  if ((med->flag & ME_EDGEDRAW) == 0) {
+    if (eed->l && eed->l == eed->l->radial_next) {
+      med->flag |= ME_EDGEDRAW;
+    }
+  }
+
+  if (data->cd_edge_crease_offset != -1) {
+    med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, data->cd_edge_crease_offset);
+  }
+  if (data->cd_edge_bweight_offset != -1) {
+    med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, data->cd_edge_bweight_offset);
+  }
+
+  CustomData_from_bmesh_block(&data->bm->edata, &data->me->edata, eed->head.data, i);
+  if (data->edge_index) {
+    data->edge_index[i] = i;
+  }
+}
+
+static void bm_to_me_for_eval_face_cb(void *userdata, MempoolIterData *mp_f)
+{
+  BMToMeForEvalData *data = userdata;
+  BMFace *efa = (BMFace *)mp_f;
+  const int i = BM_elem_index_get(efa);
+  MPoly *mp = &data->mpoly[i];
+  BMLoop *l_iter, *l_first;
+
+  l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
+
+  mp->totloop = efa->len;
+  mp->flag = BM_face_flag_to_mflag(efa);
+  mp->loopstart = BM_elem_index_get(l_first);
+  mp->mat_nr = efa->mat_nr;
+
+  do {
+    const int j = BM_elem_index_get(l_iter);
+    MLoop *ml = &data->mloop[j];
+    ml->v = BM_elem_index_get(l_iter->v);
+    ml->e = BM_elem_index_get(l_iter->e);
+    CustomData_from_bmesh_block(&data->bm->ldata, &data->me->ldata, l_iter->head.data, j);
+  } while ((l_iter = l_iter->next) != l_first);
+
+  CustomData_from_bmesh_block(&data->bm->pdata, &data->me->pdata, efa->head.data, i);
+
+  if (data->poly_index) {
+    data->poly_index[i] = i;
+  }
+}
+
 /**
  * A version of #BM_mesh_bm_to_me intended for getting the mesh
  * to pass to the modifier stack for evaluation,
@@ -1039,117 +1146,64 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
 
   BKE_mesh_update_customdata_pointers(me, false);
 
-  BMIter iter;
-  BMVert *eve;
-  BMEdge *eed;
-  BMFace *efa;
-  MVert *mvert = me->mvert;
-  MEdge *medge = me->medge;
-  MLoop *mloop = me->mloop;
-  MPoly *mpoly = me->mpoly;
-  int *index, add_orig;
-  unsigned int i, j;
-
-  const int cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
-  const int cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT);
-  const int cd_edge_crease_offset = CustomData_get_offset(&bm->edata, CD_CREASE);
-
-  me->runtime.deformed_only = true;
-
   /* Don't add origindex layer if one already exists. */
-  add_orig = !CustomData_has_layer(&bm->pdata, CD_ORIGINDEX);
-
-  index = CustomData_get_layer(&me->vdata, CD_ORIGINDEX);
-
-  BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
-    MVert *mv = &mvert[i];
-
-    copy_v3_v3(mv->co, eve->co);
-
-    BM_elem_index_set(eve, i); /* set_inline */
-
-    normal_float_to_short_v3(mv->no, eve->no);
-
-    mv->flag = BM_vert_flag_to_mflag(eve);
+  const bool add_orig = !CustomData_has_layer(&bm->pdata, CD_ORIGINDEX);
+
+  BMToMeForEvalData data = {
+      .bm = bm,
+      .me = me,
+      .mvert = me->mvert,
+      .medge = me->medge,
+      .mloop = me->mloop,
+      .mpoly = me->mpoly,
+      .vert_index = add_orig ? CustomData_get_layer(&me->vdata, CD_ORIGINDEX) : NULL,
+      .edge_index = add_orig ? CustomData_get_layer(&me->edata, CD_ORIGINDEX) : NULL,
+      .poly_index = add_orig ? CustomData_get_layer(&me->pdata, CD_ORIGINDEX) : NULL,
+      .cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT),
+      .cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT),
+      .cd_edge_crease_offset = CustomData_get_offset(&bm->edata, CD_CREASE),
+  };
 
-    if (cd_vert_bweight_offset != -1) {
-      mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eve, cd_vert_bweight_offset);
-    }
-
-    if (add_orig) {
-      *index++ = i;
-    }
-
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, eve->head.data, i);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  index = CustomData_get_layer(&me->edata, CD_ORIGINDEX);
-  BM_ITER_MESH_INDEX (eed, &iter, bm, BM_EDGES_OF_MESH, i) {
-    MEdge *med = &medge[i];
-
-    BM_elem_index_set(eed, i); /* set_inline */
-
-    med->v1 = BM_elem_index_get(eed->v1);
-    med->v2 = BM_elem_index_get(eed->v2);
-
-    med->flag = BM_edge_flag_to_mflag(eed);
-
-    /* Handle this differently to editmode switching,
-     * only enable draw for single user edges rather than calculating angle. */
-    if ((med->flag & ME_EDGEDRAW) == 0) {
-      if (eed->l && eed->l == eed->l->radial_next) {
-        med->flag |= ME_EDGEDRAW;
-      }
-    }
-
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_bweight_offset);
-    }
-
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, eed->head.data, i);
-    if (add_orig) {
-      *index++ = i;
-    }
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  index = CustomData_get_layer(&me->pdata, CD_ORIGINDEX);
-  j = 0;
-  BM_ITER_MESH_INDEX (efa, &iter, bm, BM_FACES_OF_MESH, i) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
-    MPoly *mp = &mpoly[i];
+  me->runtime.deformed_only = true;
 
-    BM_elem_index_set(efa, i); /* set_inline */
+  /* Every element writes to its own index, so all elements of a type can be converted in
+   * parallel once the indices (including the loop offsets of the faces) are known. */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE | BM_LOOP);
 
-    mp->totloop = efa->len;
-    mp->flag = BM_face_flag_to_mflag(efa);
-    mp->loopstart = j;
-    mp->mat_nr = efa->mat_nr;
+  BM_iter_parallel(
+      bm, BM_VERTS_OF_MESH, bm_to_me_for_eval_vert_cb, &data, bm->totvert >= BM_OMP_LIMIT);
+  BM_iter_parallel(
+      bm, BM_EDGES_OF_MESH, bm_to_me_for_eval_edge_cb, &data, bm->totedge >= BM_OMP_LIMIT);
+  BM_iter_parallel(
+      bm, BM_FACES_OF_MESH, bm_to_me_for_eval_face_cb, &data, bm->totface >= BM_OMP_LIMIT);
 
-    l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
-    do {
-      mloop->v = BM_elem_index_get(l_iter->v);
-      mloop->e = BM_elem_index_get(l_iter->e);
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+  me->cd_flag = BM_mesh_cd_flag_from_bmesh(bm);
+}
 
-      BM_elem_index_set(l_iter, j); /* set_inline */
+static void bm_to_me_for_eval_vert_coords_cb(void *userdata, MempoolIterData *mp_v)
+{
+  MVert *mvert = userdata;
+  BMVert *eve = (BMVert *)mp_v;
+  MVert *mv = &mvert[BM_elem_index_get(eve)];
 
-      j++;
-      mloop++;
-    } while ((l_iter = l_iter->next) != l_first);
+  copy_v3_v3(mv->co, eve->co);
+  normal_float_to_short_v3(mv->no, eve->no);
+}
 
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, efa->head.data, i);
+/**
+ * Update the vertex coordinates and normals of \a me, a result of #BM_mesh_bm_to_me_for_eval,
+ * after vertices of \a bm were moved without any other change.
+ */
+void BM_mesh_bm_to_me_for_eval_vert_coords(BMesh *bm, Mesh *me)
+{
+  BLI_assert(me->totvert == bm->totvert);
 
-    if (add_orig) {
-      *index++ = i;
-    }
-  }
-  bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP);
+  BM_mesh_elem_index_ensure(bm, BM_VERT);
+  BM_iter_parallel(bm,
+                   BM_VERTS_OF_MESH,
+                   bm_to_me_for_eval_vert_coords_cb,
+                   me->mvert,
+                   bm->totvert >= BM_OMP_LIMIT);
 
-  me->cd_flag = BM_mesh_cd_flag_from_bmesh(bm);
+  BKE_mesh_runtime_clear_geometry(me);
 }
@@ -32,6 +32,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -76,6 +77,21 @@ typedef enum CD_UseFlag {
 /* BMesh Helper Functions
  * ********************** */
 
+static void bm_decim_build_face_quadric_cb(void *userdata, MempoolIterData *mp_f)
+{
+  Quadric *fquadrics = userdata;
+  BMFace *f = (BMFace *)mp_f;
+
+  float center[3];
+  double plane_db[4];
+
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(plane_db, f->no);
+  plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+  BLI_quadric_from_plane(&fquadrics[BM_elem_index_get(f)], plane_db);
+}
+
 /**
  * \param vquadrics: must be calloc'd
  */
@@ -85,26 +101,27 @@ static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
   BMFace *f;
   BMEdge *e;
 
+  /* Calculate the face quadrics in parallel, then accumulate them into the vertices in order,
+   * so the result doesn't depend on the threading. */
+  Quadric *fquadrics = MEM_malloc_arrayN(bm->totface, sizeof(*fquadrics), __func__);
+
+  BM_mesh_elem_index_ensure(bm, BM_FACE);
+  BM_iter_parallel(
+      bm, BM_FACES_OF_MESH, bm_decim_build_face_quadric_cb, fquadrics, bm->totface >= BM_OMP_LIMIT);
+
   BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
     BMLoop *l_first;
     BMLoop *l_iter;
-
-    float center[3];
-    double plane_db[4];
-    Quadric q;
-
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
-
-    BLI_quadric_from_plane(&q, plane_db);
+    const Quadric *q = &fquadrics[BM_elem_index_get(f)];
 
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
+      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], q);
     } while ((l_iter = l_iter->next) != l_first);
   }
 
+  MEM_freeN(fquadrics);
+
   /* boundary edges */
   BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
     if (UNLIKELY(BM_edge_is_boundary(e))) {
@@ -236,18 +253,20 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * \return False when the edge should not be collapsed.
+ */
+static bool bm_decim_calc_edge_cost_single(BMEdge *e,
+                                           const Quadric *vquadrics,
+                                           const float *vweights,
+                                           const float vweight_factor,
+                                           float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -257,7 +276,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -266,11 +285,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -323,14 +342,38 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
 
-clear:
-  if (eheap_table[BM_elem_index_get(e)]) {
-    BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
+static void bm_decim_edge_cost_update(BMEdge *e,
+                                      const bool use_collapse,
+                                      const float cost,
+                                      Heap *eheap,
+                                      HeapNode **eheap_table)
+{
+  if (use_collapse) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+  }
+  else {
+    if (eheap_table[BM_elem_index_get(e)]) {
+      BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
+    }
+    eheap_table[BM_elem_index_get(e)] = NULL;
   }
-  eheap_table[BM_elem_index_get(e)] = NULL;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost = 0.0f;
+  const bool use_collapse = bm_decim_calc_edge_cost_single(
+      e, vquadrics, vweights, vweight_factor, &cost);
+  bm_decim_edge_cost_update(e, use_collapse, cost, eheap, eheap_table);
 }
 
 /* use this for degenerate cases - add back to the heap with an invalid cost,
@@ -341,6 +384,27 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+typedef struct EdgeCostData {
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+
+  /* Edge index aligned. */
+  float *costs;
+  bool *use_collapse;
+} EdgeCostData;
+
+static void bm_decim_build_edge_cost_cb(void *userdata, MempoolIterData *mp_e)
+{
+  EdgeCostData *data = userdata;
+  BMEdge *e = (BMEdge *)mp_e;
+  const int i = BM_elem_index_get(e);
+
+  data->costs[i] = 0.0f;
+  data->use_collapse[i] = bm_decim_calc_edge_cost_single(
+      e, data->vquadrics, data->vweights, data->vweight_factor, &data->costs[i]);
+}
+
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -352,11 +416,27 @@ static void bm_decim_build_edge_cost(BMesh *bm,
   BMEdge *e;
   uint i;
 
+  /* Calculate the costs in parallel, the heap is filled in order afterwards. */
+  EdgeCostData data = {
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .costs = MEM_malloc_arrayN(bm->totedge, sizeof(float), __func__),
+      .use_collapse = MEM_malloc_arrayN(bm->totedge, sizeof(bool), __func__),
+  };
+
+  BM_mesh_elem_index_ensure(bm, BM_EDGE);
+  BM_iter_parallel(
+      bm, BM_EDGES_OF_MESH, bm_decim_build_edge_cost_cb, &data, bm->totedge >= BM_OMP_LIMIT);
+
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
     /* keep sanity check happy */
     eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    bm_decim_edge_cost_update(e, data.use_collapse[i], data.costs[i], eheap, eheap_table);
   }
+
+  MEM_freeN(data.costs);
+  MEM_freeN(data.use_collapse);
 }
 
 #ifdef USE_SYMMETRY
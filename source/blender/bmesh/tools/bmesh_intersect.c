@@ -36,6 +36,7 @@
 #include "BLI_alloca.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_ptr_map.h"
 #include "BLI_sort_utils.h"
 #include "BLI_utildefines.h"
 
@@ -121,9 +122,9 @@ struct ISectEpsilon {
 struct ISectState {
   BMesh *bm;
   GHash *edgetri_cache;    /* int[4]: BMVert */
-  GHash *edge_verts;       /* BMEdge: LinkList(of verts), new and original edges */
+  PtrMap *edge_verts;      /* BMEdge: LinkList(of verts), new and original edges */
   GHash *face_edges;       /* BMFace-index: LinkList(of edges), only original faces */
-  GSet *wire_edges;        /* BMEdge  (could use tags instead) */
+  PtrSet *wire_edges;      /* BMEdge  (could use tags instead) */
   LinkNode *vert_dissolve; /* BMVert's */
 
   MemArena *mem_arena;
@@ -140,13 +141,17 @@ struct LinkBase {
   uint list_len;
 };
 
-static bool ghash_insert_link(GHash *gh, void *key, void *val, bool use_test, MemArena *mem_arena)
+/**
+ * \param ls_base_p: The value of a hash entry, from #BLI_ghash_ensure_p or #BLI_ptr_map_ensure_p.
+ * \param exists: When false, the entry was just added and \a ls_base_p is initialized here.
+ */
+static bool insert_link(
+    void **ls_base_p, const bool exists, void *val, bool use_test, MemArena *mem_arena)
 {
-  void **ls_base_p;
   struct LinkBase *ls_base;
   LinkNode *ls;
 
-  if (!BLI_ghash_ensure_p(gh, key, &ls_base_p)) {
+  if (!exists) {
     ls_base = *ls_base_p = BLI_memarena_alloc(mem_arena, sizeof(*ls_base));
     ls_base->list = NULL;
     ls_base->list_len = 0;
@@ -201,7 +206,9 @@ static void edge_verts_add(struct ISectState *s, BMEdge *e, BMVert *v, const boo
 {
   BLI_assert(e->head.htype == BM_EDGE);
   BLI_assert(v->head.htype == BM_VERT);
-  ghash_insert_link(s->edge_verts, (void *)e, v, use_test, s->mem_arena);
+  void **ls_base_p;
+  const bool exists = BLI_ptr_map_ensure_p(s->edge_verts, e, &ls_base_p);
+  insert_link(ls_base_p, exists, v, use_test, s->mem_arena);
 }
 
 static void face_edges_add(struct ISectState *s, const int f_index, BMEdge *e, const bool use_test)
@@ -211,7 +218,9 @@ static void face_edges_add(struct ISectState *s, const int f_index, BMEdge *e, c
   BLI_assert(BM_edge_in_face(e, s->bm->ftable[f_index]) == false);
   BLI_assert(BM_elem_index_get(s->bm->ftable[f_index]) == f_index);
 
-  ghash_insert_link(s->face_edges, f_index_key, e, use_test, s->mem_arena);
+  void **ls_base_p;
+  const bool exists = BLI_ghash_ensure_p(s->face_edges, f_index_key, &ls_base_p);
+  insert_link(ls_base_p, exists, e, use_test, s->mem_arena);
 }
 
 #ifdef USE_NET
@@ -814,12 +823,12 @@ static void bm_isect_tri_tri(
          * if not (ie_vs[0].index == -1 or ie_vs[1].index == -1):
          *     continue */
         ie = BM_edge_create(s->bm, UNPACK2(ie_vs), NULL, 0);
-        BLI_gset_insert(s->wire_edges, ie);
+        BLI_ptr_set_insert(s->wire_edges, ie);
       }
       else {
         ie_exists = true;
         /* may already exist */
-        BLI_gset_add(s->wire_edges, ie);
+        BLI_ptr_set_add(s->wire_edges, ie);
 
         if (BM_edge_in_face(ie, f)) {
           continue;
@@ -945,6 +954,72 @@ static int isect_bvhtree_point_v3(BVHTree *tree, const float **looptris, const f
   return num_isect;
 }
 
+/**
+ * Check if the vertices of \a t_other are all on the same side of the plane of \a t,
+ * further away than \a eps. Such triangles can't interact in #bm_isect_tri_tri.
+ */
+static bool isect_tri_plane_separated(BMLoop **t, BMLoop **t_other, const double eps)
+{
+  double t_cos[3][3], nor[3];
+  for (uint i = 0; i < 3; i++) {
+    copy_v3db_v3fl(t_cos[i], t[i]->v->co);
+  }
+  {
+    double e1[3], e2[3];
+    sub_v3_v3v3_db(e1, t_cos[1], t_cos[0]);
+    sub_v3_v3v3_db(e2, t_cos[2], t_cos[0]);
+    cross_v3_v3v3_db(nor, e1, e2);
+  }
+  if (normalize_v3_db(nor) == 0.0) {
+    return false;
+  }
+
+  uint side_above = 0, side_below = 0;
+  for (uint i = 0; i < 3; i++) {
+    double co[3], dir[3];
+    copy_v3db_v3fl(co, t_other[i]->v->co);
+    sub_v3_v3v3_db(dir, co, t_cos[0]);
+    const double dist = dot_v3v3_db(nor, dir);
+    if (dist > eps) {
+      side_above++;
+    }
+    else if (dist < -eps) {
+      side_below++;
+    }
+    else {
+      return false;
+    }
+  }
+  return (side_above == 3) || (side_below == 3);
+}
+
+struct ISectOverlapData {
+  struct BMLoop *(*looptris)[3];
+  float eps_margin;
+};
+
+/**
+ * Called from the (threaded) BVH overlap test, to skip pairs of triangles
+ * that only have overlapping bounds early, without touching the shared intersection state.
+ */
+static bool bm_isect_overlap_cb(void *userdata, int index_a, int index_b, int UNUSED(thread))
+{
+  const struct ISectOverlapData *data = userdata;
+  BMLoop **t_a = data->looptris[index_a];
+  BMLoop **t_b = data->looptris[index_b];
+
+  /* Account for float precision of the coordinates, on top of the margin used for the tests. */
+  float co_max = 0.0f;
+  for (uint i = 0; i < 3; i++) {
+    for (uint j = 0; j < 3; j++) {
+      co_max = max_fff(co_max, fabsf(t_a[i]->v->co[j]), fabsf(t_b[i]->v->co[j]));
+    }
+  }
+  const double eps = (double)data->eps_margin + (double)co_max * (double)FLT_EPSILON * 16.0;
+
+  return !(isect_tri_plane_separated(t_a, t_b, eps) || isect_tri_plane_separated(t_b, t_a, eps));
+}
+
 #endif /* USE_BVH */
 
 /**
@@ -991,9 +1066,9 @@ bool BM_mesh_intersect(BMesh *bm,
   s.edgetri_cache = BLI_ghash_new(
       BLI_ghashutil_inthash_v4_p, BLI_ghashutil_inthash_v4_cmp, __func__);
 
-  s.edge_verts = BLI_ghash_ptr_new(__func__);
+  s.edge_verts = BLI_ptr_map_new();
   s.face_edges = BLI_ghash_int_new(__func__);
-  s.wire_edges = BLI_gset_ptr_new(__func__);
+  s.wire_edges = BLI_ptr_set_new();
   s.vert_dissolve = NULL;
 
   s.mem_arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
@@ -1101,7 +1176,12 @@ bool BM_mesh_intersect(BMesh *bm,
     flag &= ~BVH_OVERLAP_USE_THREADING;
   }
 #  endif
-  overlap = BLI_bvhtree_overlap_ex(tree_b, tree_a, &tree_overlap_tot, NULL, NULL, 0, flag);
+  struct ISectOverlapData overlap_data = {
+      .looptris = looptris,
+      .eps_margin = s.epsilon.eps_margin,
+  };
+  overlap = BLI_bvhtree_overlap_ex(
+      tree_b, tree_a, &tree_overlap_tot, bm_isect_overlap_cb, &overlap_data, 0, flag);
 
   if (overlap) {
     uint i;
@@ -1169,11 +1249,11 @@ bool BM_mesh_intersect(BMesh *bm,
 
 #ifdef USE_SPLICE
   {
-    GHashIterator gh_iter;
+    PtrMapIterator map_iter;
 
-    GHASH_ITER (gh_iter, s.edge_verts) {
-      BMEdge *e = BLI_ghashIterator_getKey(&gh_iter);
-      struct LinkBase *v_ls_base = BLI_ghashIterator_getValue(&gh_iter);
+    PTR_MAP_ITER (map_iter, s.edge_verts) {
+      BMEdge *e = BLI_ptr_map_iter_key(&map_iter);
+      struct LinkBase *v_ls_base = BLI_ptr_map_iter_value(&map_iter);
 
       BMVert *v_start;
       BMVert *v_end;
@@ -1194,7 +1274,7 @@ bool BM_mesh_intersect(BMesh *bm,
       printf("# SPLITTING EDGE: %d, %u\n", BM_elem_index_get(e), v_ls_base->list_len);
 #  endif
       /* intersect */
-      is_wire = BLI_gset_haskey(s.wire_edges, e);
+      is_wire = BLI_ptr_set_haskey(s.wire_edges, e);
 
 #  ifdef USE_PARANOID
       for (node = v_ls_base->list; node; node = node->next) {
@@ -1224,7 +1304,7 @@ bool BM_mesh_intersect(BMesh *bm,
           }
           v_prev = vi;
           if (is_wire) {
-            BLI_gset_insert(s.wire_edges, e_split);
+            BLI_ptr_set_insert(s.wire_edges, e_split);
           }
         }
       }
@@ -1250,8 +1330,8 @@ bool BM_mesh_intersect(BMesh *bm,
       }
     }
 
-    splice_ls = MEM_mallocN(BLI_gset_len(s.wire_edges) * sizeof(*splice_ls), __func__);
-    STACK_INIT(splice_ls, BLI_gset_len(s.wire_edges));
+    splice_ls = MEM_mallocN(BLI_ptr_set_len(s.wire_edges) * sizeof(*splice_ls), __func__);
+    STACK_INIT(splice_ls, BLI_ptr_set_len(s.wire_edges));
 
     for (node = s.vert_dissolve; node; node = node->next) {
       BMEdge *e_pair[2];
@@ -1273,7 +1353,8 @@ bool BM_mesh_intersect(BMesh *bm,
       /* It's possible the vertex to dissolve is an edge on an existing face
        * that doesn't divide the face, therefor the edges are not wire
        * and shouldn't be handled here, see: T63787. */
-      if (!BLI_gset_haskey(s.wire_edges, e_pair[0]) || !BLI_gset_haskey(s.wire_edges, e_pair[1])) {
+      if (!BLI_ptr_set_haskey(s.wire_edges, e_pair[0]) ||
+          !BLI_ptr_set_haskey(s.wire_edges, e_pair[1])) {
         continue;
       }
 
@@ -1407,7 +1488,7 @@ bool BM_mesh_intersect(BMesh *bm,
             } while ((l_iter = l_iter->radial_next) != e->l);
           }
 
-          BLI_gset_remove(s.wire_edges, e, NULL);
+          BLI_ptr_set_remove(s.wire_edges, e);
           BM_edge_kill(bm, e);
         }
       }
@@ -1415,14 +1496,14 @@ bool BM_mesh_intersect(BMesh *bm,
 
     /* Remove verts! */
     {
-      GSet *verts_invalid = BLI_gset_ptr_new(__func__);
+      PtrSet *verts_invalid = BLI_ptr_set_new();
 
       for (node = s.vert_dissolve; node; node = node->next) {
         /* arena allocated, don't free */
         BMVert *v = node->link;
         if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
           if (!v->e) {
-            BLI_gset_add(verts_invalid, v);
+            BLI_ptr_set_add(verts_invalid, v);
             BM_vert_kill(bm, v);
           }
         }
@@ -1431,8 +1512,8 @@ bool BM_mesh_intersect(BMesh *bm,
       {
         uint i;
         for (i = 0; i < STACK_SIZE(splice_ls); i++) {
-          if (!BLI_gset_haskey(verts_invalid, splice_ls[i][0]) &&
-              !BLI_gset_haskey(verts_invalid, splice_ls[i][1])) {
+          if (!BLI_ptr_set_haskey(verts_invalid, splice_ls[i][0]) &&
+              !BLI_ptr_set_haskey(verts_invalid, splice_ls[i][1])) {
             if (!BM_edge_exists(UNPACK2(splice_ls[i])) &&
                 !BM_vert_splice_check_double(UNPACK2(splice_ls[i]))) {
               BM_vert_splice(bm, splice_ls[i][1], splice_ls[i][0]);
@@ -1441,7 +1522,7 @@ bool BM_mesh_intersect(BMesh *bm,
         }
       }
 
-      BLI_gset_free(verts_invalid, NULL);
+      BLI_ptr_set_free(verts_invalid);
     }
 
     MEM_freeN(splice_ls);
@@ -1487,24 +1568,24 @@ bool BM_mesh_intersect(BMesh *bm,
 
 #ifdef USE_SEPARATE
   if (use_separate) {
-    GSetIterator gs_iter;
+    PtrSetIterator set_iter;
 
     BM_mesh_elem_hflag_disable_all(bm, BM_EDGE, BM_ELEM_TAG, false);
 
-    GSET_ITER (gs_iter, s.wire_edges) {
-      BMEdge *e = BLI_gsetIterator_getKey(&gs_iter);
+    PTR_SET_ITER (set_iter, s.wire_edges) {
+      BMEdge *e = BLI_ptr_set_iter_key(&set_iter);
       BM_elem_flag_enable(e, BM_ELEM_TAG);
     }
 
     BM_mesh_edgesplit(bm, false, true, false);
   }
   else if (boolean_mode != BMESH_ISECT_BOOLEAN_NONE || use_edge_tag) {
-    GSetIterator gs_iter;
+    PtrSetIterator set_iter;
 
     /* no need to clear for boolean */
 
-    GSET_ITER (gs_iter, s.wire_edges) {
-      BMEdge *e = BLI_gsetIterator_getKey(&gs_iter);
+    PTR_SET_ITER (set_iter, s.wire_edges) {
+      BMEdge *e = BLI_ptr_set_iter_key(&set_iter);
       BM_elem_flag_enable(e, BM_ELEM_TAG);
     }
   }
@@ -1654,9 +1735,9 @@ bool BM_mesh_intersect(BMesh *bm,
   /* cleanup */
   BLI_ghash_free(s.edgetri_cache, NULL, NULL);
 
-  BLI_ghash_free(s.edge_verts, NULL, NULL);
+  BLI_ptr_map_free(s.edge_verts);
   BLI_ghash_free(s.face_edges, NULL, NULL);
-  BLI_gset_free(s.wire_edges, NULL);
+  BLI_ptr_set_free(s.wire_edges);
 
   BLI_memarena_free(s.mem_arena);
 
@@ -386,9 +386,17 @@ MemoryBuffer **ExecutionGroup::getInputBuffersOpenCL(int chunkNumber)
     ReadBufferOperation *readOperation =
         (ReadBufferOperation *)this->m_cachedReadOperations[index];
     MemoryProxy *memoryProxy = readOperation->getMemoryProxy();
-    this->determineDependingAreaOfInterest(&rect, readOperation, &output);
-    MemoryBuffer *memoryBuffer = memoryProxy->getExecutor()->constructConsolidatedMemoryBuffer(
-        memoryProxy, &output);
+    MemoryBuffer *memoryBuffer;
+    if (memoryProxy->getExecutor()->isFinished()) {
+      /* The whole input is calculated, use it directly instead of copying the area of interest,
+       * so the OpenCL device can keep it uploaded for all chunks. */
+      memoryBuffer = memoryProxy->getBuffer();
+    }
+    else {
+      this->determineDependingAreaOfInterest(&rect, readOperation, &output);
+      memoryBuffer = memoryProxy->getExecutor()->constructConsolidatedMemoryBuffer(memoryProxy,
+                                                                                   &output);
+    }
     memoryBuffers[readOperation->getOffset()] = memoryBuffer;
   }
   return memoryBuffers;
@@ -420,6 +420,14 @@ class ExecutionGroup {
    */
   bool isOpenCL();
 
+  /**
+   * \brief have all chunks of this ExecutionGroup been calculated
+   */
+  bool isFinished() const
+  {
+    return this->m_chunksFinished == this->m_numberOfChunks;
+  }
+
   void setChunksize(int chunksize)
   {
     this->m_chunkSize = chunksize;
@@ -321,6 +321,14 @@ class MemoryBuffer {
    */
   void copyContentFrom(MemoryBuffer *otherBuffer);
 
+  /**
+   * \brief get the data type of this MemoryBuffer
+   */
+  DataType getDataType() const
+  {
+    return this->m_datatype;
+  }
+
   /**
    * \brief get the rect of this MemoryBuffer
    */
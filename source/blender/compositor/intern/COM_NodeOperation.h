@@ -102,6 +102,14 @@ class NodeOperation : public SocketReader {
    */
   bool m_openCL;
 
+  /**
+   * \brief can this operation be replaced by a constant when all its inputs are constant.
+   *
+   * Only valid for operations that compute each pixel from the same pixel of their inputs,
+   * without depending on the pixel position or resolution.
+   */
+  bool m_constantFoldable;
+
   /**
    * \brief mutex reference for very special node initializations
    * \note only use when you really know what you are doing.
@@ -276,6 +284,14 @@ class NodeOperation : public SocketReader {
     return this->m_complex;
   }
 
+  /**
+   * \brief can this operation be replaced by a constant when all its inputs are constant.
+   */
+  bool isConstantFoldable() const
+  {
+    return this->m_constantFoldable;
+  }
+
   virtual bool isSetOperation() const
   {
     return false;
@@ -420,6 +436,15 @@ class NodeOperation : public SocketReader {
     this->m_openCL = openCL;
   }
 
+  /**
+   * \brief set whether this operation only computes pixels from the same pixel of its inputs
+   * \see NodeOperationBuilder.fold_constant_operations
+   */
+  void setConstantFoldable(bool constantFoldable)
+  {
+    this->m_constantFoldable = constantFoldable;
+  }
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
@@ -102,6 +102,8 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
   add_datatype_conversions();
 
+  fold_constant_operations();
+
   determineResolutions();
 
   /* surround complex ops with read/write buffer */
@@ -299,6 +301,83 @@ void NodeOperationBuilder::add_datatype_conversions()
   }
 }
 
+NodeOperation *NodeOperationBuilder::make_constant_operation(NodeOperation *operation) const
+{
+  float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  /* Evaluate a single pixel, the result is the same for every pixel. */
+  operation->initExecution();
+  operation->readSampled(value, 0.0f, 0.0f, COM_PS_NEAREST);
+  operation->deinitExecution();
+
+  switch (operation->getOutputSocket()->getDataType()) {
+    case COM_DT_VALUE: {
+      SetValueOperation *constant = new SetValueOperation();
+      constant->setValue(value[0]);
+      return constant;
+    }
+    case COM_DT_VECTOR: {
+      SetVectorOperation *constant = new SetVectorOperation();
+      constant->setVector(value);
+      return constant;
+    }
+    case COM_DT_COLOR: {
+      SetColorOperation *constant = new SetColorOperation();
+      constant->setChannels(value);
+      return constant;
+    }
+  }
+  return nullptr;
+}
+
+void NodeOperationBuilder::fold_constant_operations()
+{
+  /* Folding an operation can make the operations it is linked to constant as well, so repeat
+   * until nothing changes. Operations that are no longer used get pruned later. */
+  bool folded;
+  do {
+    folded = false;
+
+    /* Note: new constants are added to m_operations, only loop over the existing ones. */
+    const size_t num_operations = m_operations.size();
+    for (size_t i = 0; i < num_operations; i++) {
+      NodeOperation *op = m_operations[i];
+      if (!op->isConstantFoldable() || op->getNumberOfOutputSockets() != 1) {
+        continue;
+      }
+
+      bool all_inputs_constant = true;
+      for (int k = 0; k < op->getNumberOfInputSockets(); k++) {
+        NodeOperationOutput *link = op->getInputSocket(k)->getLink();
+        if (!link || !link->getOperation().isSetOperation()) {
+          all_inputs_constant = false;
+          break;
+        }
+      }
+      if (!all_inputs_constant) {
+        continue;
+      }
+
+      OpInputs targets = cache_output_links(op->getOutputSocket());
+      if (targets.empty()) {
+        continue;
+      }
+
+      NodeOperation *constant = make_constant_operation(op);
+      if (!constant) {
+        continue;
+      }
+      addOperation(constant);
+
+      for (OpInputs::const_iterator it = targets.begin(); it != targets.end(); ++it) {
+        removeInputLink(*it);
+        addLink(constant->getOutputSocket(), *it);
+      }
+      folded = true;
+    }
+  } while (folded);
+}
+
 void NodeOperationBuilder::add_operation_input_constants()
 {
   /* Note: unconnected inputs cached first to avoid modifying
@@ -139,6 +139,10 @@ class NodeOperationBuilder {
   /** Add datatype conversion where needed */
   void add_datatype_conversions();
 
+  /** Replace operations that only have constant inputs by a constant operation */
+  void fold_constant_operations();
+  NodeOperation *make_constant_operation(NodeOperation *operation) const;
+
   /** Construct a constant value operation for every unconnected input */
   void add_operation_input_constants();
   void add_input_constant_value(NodeOperationInput *input, NodeInput *node_input);
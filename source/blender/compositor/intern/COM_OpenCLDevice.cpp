@@ -54,6 +54,7 @@ bool OpenCLDevice::initialize()
 
 void OpenCLDevice::deinitialize()
 {
+  clearImageCache();
   if (this->m_queue) {
     clReleaseCommandQueue(this->m_queue);
   }
@@ -76,6 +77,16 @@ void OpenCLDevice::execute(WorkPackage *work)
 
   executionGroup->finalizeChunkExecution(chunkNumber, inputBuffers);
 }
+
+void OpenCLDevice::clearImageCache()
+{
+  for (map<MemoryBuffer *, cl_mem>::iterator it = m_imageCache.begin(); it != m_imageCache.end();
+       ++it) {
+    clReleaseMemObject(it->second);
+  }
+  m_imageCache.clear();
+}
+
 cl_mem OpenCLDevice::COM_clAttachMemoryBufferToKernelParameter(cl_kernel kernel,
                                                                int parameterIndex,
                                                                int offsetIndex,
@@ -119,22 +130,38 @@ cl_mem OpenCLDevice::COM_clAttachMemoryBufferToKernelParameter(cl_kernel kernel,
 
   MemoryBuffer *result = reader->getInputMemoryBuffer(inputMemoryBuffers);
 
-  const cl_image_format *imageFormat = determineImageFormat(result);
+  /* Buffers that are not temporary are complete inputs that don't change anymore, reuse the
+   * image uploaded for a previous chunk. */
+  const bool use_cache = !result->isTemporarily();
+  map<MemoryBuffer *, cl_mem>::iterator cached = m_imageCache.find(result);
+  cl_mem clBuffer;
 
-  cl_mem clBuffer = clCreateImage2D(this->m_context,
-                                    CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                    imageFormat,
-                                    result->getWidth(),
-                                    result->getHeight(),
-                                    0,
-                                    result->getBuffer(),
-                                    &error);
-
-  if (error != CL_SUCCESS) {
-    printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
+  if (use_cache && cached != m_imageCache.end()) {
+    clBuffer = cached->second;
   }
-  if (error == CL_SUCCESS) {
-    cleanup->push_back(clBuffer);
+  else {
+    const cl_image_format *imageFormat = determineImageFormat(result);
+
+    clBuffer = clCreateImage2D(this->m_context,
+                               CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                               imageFormat,
+                               result->getWidth(),
+                               result->getHeight(),
+                               0,
+                               result->getBuffer(),
+                               &error);
+
+    if (error != CL_SUCCESS) {
+      printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
+    }
+    if (error == CL_SUCCESS) {
+      if (use_cache) {
+        m_imageCache[result] = clBuffer;
+      }
+      else {
+        cleanup->push_back(clBuffer);
+      }
+    }
   }
 
   error = clSetKernelArg(kernel, parameterIndex, sizeof(cl_mem), &clBuffer);
@@ -25,7 +25,10 @@ class OpenCLDevice;
 #include "COM_WorkScheduler.h"
 #include "clew.h"
 
+#include <map>
+
 using std::list;
+using std::map;
 
 /**
  * \brief device representing an GPU OpenCL device.
@@ -58,6 +61,12 @@ class OpenCLDevice : public Device {
    */
   cl_int m_vendorID;
 
+  /**
+   * \brief images of fully calculated input buffers, uploaded once and reused for all chunks
+   * \see clearImageCache
+   */
+  map<MemoryBuffer *, cl_mem> m_imageCache;
+
  public:
   /**
    * \brief constructor with opencl device
@@ -88,6 +97,12 @@ class OpenCLDevice : public Device {
    */
   void execute(WorkPackage *work);
 
+  /**
+   * \brief release all cached input images
+   * Must be called when no work is executing, before the input buffers are freed.
+   */
+  void clearImageCache();
+
   /**
    * \brief determine an image format
    * \param memorybuffer:
@@ -18,9 +18,67 @@
 
 #include "COM_SingleThreadedOperation.h"
 
+#include "BLI_threads.h"
+
+#include <list>
+
+/* Results of previous executions, most recently used first. Keeps expensive operations like
+ * denoising from running again when only nodes after them were edited. */
+struct ResultCacheEntry {
+  uint32_t key;
+  MemoryBuffer *buffer;
+};
+
+#define COM_RESULT_CACHE_SIZE 4
+
+static std::list<ResultCacheEntry> result_cache;
+static ThreadMutex result_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static MemoryBuffer *copy_memory_buffer(MemoryBuffer *buffer)
+{
+  MemoryBuffer *result = new MemoryBuffer(buffer->getDataType(), buffer->getRect());
+  result->copyContentFrom(buffer);
+  return result;
+}
+
+static MemoryBuffer *result_cache_lookup(uint32_t key, int width, int height)
+{
+  MemoryBuffer *result = nullptr;
+
+  BLI_mutex_lock(&result_cache_lock);
+  for (std::list<ResultCacheEntry>::iterator it = result_cache.begin(); it != result_cache.end();
+       ++it) {
+    if (it->key == key && it->buffer->getWidth() == width &&
+        it->buffer->getHeight() == height) {
+      result_cache.splice(result_cache.begin(), result_cache, it);
+      result = copy_memory_buffer(it->buffer);
+      break;
+    }
+  }
+  BLI_mutex_unlock(&result_cache_lock);
+
+  return result;
+}
+
+static void result_cache_insert(uint32_t key, MemoryBuffer *buffer)
+{
+  ResultCacheEntry entry;
+  entry.key = key;
+  entry.buffer = copy_memory_buffer(buffer);
+
+  BLI_mutex_lock(&result_cache_lock);
+  result_cache.push_front(entry);
+  while (result_cache.size() > COM_RESULT_CACHE_SIZE) {
+    delete result_cache.back().buffer;
+    result_cache.pop_back();
+  }
+  BLI_mutex_unlock(&result_cache_lock);
+}
+
 SingleThreadedOperation::SingleThreadedOperation()
 {
   this->m_cachedInstance = nullptr;
+  this->m_useResultCache = false;
   setComplex(true);
 }
 
@@ -50,9 +108,55 @@ void *SingleThreadedOperation::initializeTileData(rcti *rect)
 
   lockMutex();
   if (this->m_cachedInstance == nullptr) {
-    //
-    this->m_cachedInstance = createMemoryBuffer(rect);
+    uint32_t key = 0;
+    bool use_cache = false;
+
+    if (this->m_useResultCache) {
+      BLI_HashMurmur2A hash;
+      BLI_hash_mm2a_init(&hash, 0);
+      use_cache = hashResult(rect, &hash);
+      key = BLI_hash_mm2a_end(&hash);
+    }
+
+    if (use_cache) {
+      this->m_cachedInstance = result_cache_lookup(key, getWidth(), getHeight());
+    }
+    if (this->m_cachedInstance == nullptr) {
+      this->m_cachedInstance = createMemoryBuffer(rect);
+      if (use_cache) {
+        result_cache_insert(key, this->m_cachedInstance);
+      }
+    }
   }
   unlockMutex();
   return this->m_cachedInstance;
 }
+
+void SingleThreadedOperation::hashMemoryBuffer(BLI_HashMurmur2A *hash, MemoryBuffer *buffer)
+{
+  if (buffer == nullptr || buffer->getBuffer() == nullptr) {
+    BLI_hash_mm2a_add_int(hash, 0);
+    return;
+  }
+
+  const int width = buffer->getWidth();
+  const int height = buffer->getHeight();
+  const unsigned int num_channels = buffer->get_num_channels();
+  BLI_hash_mm2a_add_int(hash, width);
+  BLI_hash_mm2a_add_int(hash, height);
+  BLI_hash_mm2a_add_int(hash, num_channels);
+  BLI_hash_mm2a_add(hash,
+                    (const unsigned char *)buffer->getBuffer(),
+                    sizeof(float) * num_channels * width * height);
+}
+
+void SingleThreadedOperation::clearResultCache()
+{
+  BLI_mutex_lock(&result_cache_lock);
+  for (std::list<ResultCacheEntry>::iterator it = result_cache.begin(); it != result_cache.end();
+       ++it) {
+    delete it->buffer;
+  }
+  result_cache.clear();
+  BLI_mutex_unlock(&result_cache_lock);
+}
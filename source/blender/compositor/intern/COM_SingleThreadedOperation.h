@@ -18,18 +18,40 @@
 
 #pragma once
 
+#include "BLI_hash_mm2a.h"
+
 #include "COM_NodeOperation.h"
 
 class SingleThreadedOperation : public NodeOperation {
  private:
   MemoryBuffer *m_cachedInstance;
 
+  /**
+   * \brief reuse results of previous executions with the same settings and inputs
+   */
+  bool m_useResultCache;
+
  protected:
   inline bool isCached()
   {
     return this->m_cachedInstance != NULL;
   }
 
+  /**
+   * \brief hash everything the result of createMemoryBuffer depends on
+   * Operations that support the result cache add their settings and the contents of their
+   * inputs, and return true.
+   */
+  virtual bool hashResult(rcti * /*rect*/, BLI_HashMurmur2A * /*hash*/)
+  {
+    return false;
+  }
+
+  /**
+   * \brief add the size and contents of a buffer to the hash, buffer can be NULL
+   */
+  static void hashMemoryBuffer(BLI_HashMurmur2A *hash, MemoryBuffer *buffer);
+
  public:
   SingleThreadedOperation();
 
@@ -56,4 +78,14 @@ class SingleThreadedOperation : public NodeOperation {
   {
     return true;
   }
+
+  void setUseResultCache(bool useResultCache)
+  {
+    this->m_useResultCache = useResultCache;
+  }
+
+  /**
+   * \brief free all results kept for reuse between executions
+   */
+  static void clearResultCache();
 };
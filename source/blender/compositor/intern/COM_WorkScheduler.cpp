@@ -173,6 +173,11 @@ void WorkScheduler::stop()
     BLI_threadpool_end(&g_gputhreads);
     BLI_thread_queue_free(g_gpuqueue);
     g_gpuqueue = nullptr;
+
+    /* Input buffers get freed after execution, release the images uploaded from them. */
+    for (int index = 0; index < g_gpudevices.size(); index++) {
+      g_gpudevices[index]->clearImageCache();
+    }
   }
 #  endif
 #endif
@@ -27,7 +27,7 @@ DenoiseNode::DenoiseNode(bNode *editorNode) : Node(editorNode)
 }
 
 void DenoiseNode::convertToOperations(NodeConverter &converter,
-                                      const CompositorContext & /*context*/) const
+                                      const CompositorContext &context) const
 {
   bNode *node = this->getbNode();
   NodeDenoise *denoise = (NodeDenoise *)node->storage;
@@ -35,6 +35,7 @@ void DenoiseNode::convertToOperations(NodeConverter &converter,
   DenoiseOperation *operation = new DenoiseOperation();
   converter.addOperation(operation);
   operation->setDenoiseSettings(denoise);
+  operation->setUseResultCache(!context.isRendering());
 
   converter.mapInputSocket(getInputSocket(0), operation->getInputSocket(0));
   converter.mapInputSocket(getInputSocket(1), operation->getInputSocket(1));
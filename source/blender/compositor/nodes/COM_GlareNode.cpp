@@ -33,7 +33,7 @@ GlareNode::GlareNode(bNode *editorNode) : Node(editorNode)
 }
 
 void GlareNode::convertToOperations(NodeConverter &converter,
-                                    const CompositorContext & /*context*/) const
+                                    const CompositorContext &context) const
 {
   bNode *node = this->getbNode();
   NodeGlare *glare = (NodeGlare *)node->storage;
@@ -56,6 +56,7 @@ void GlareNode::convertToOperations(NodeConverter &converter,
   }
   BLI_assert(glareoperation);
   glareoperation->setGlareSettings(glare);
+  glareoperation->setUseResultCache(!context.isRendering());
 
   GlareThresholdOperation *thresholdOperation = new GlareThresholdOperation();
   thresholdOperation->setGlareSettings(glare);
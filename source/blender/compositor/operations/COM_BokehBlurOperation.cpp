@@ -19,9 +19,14 @@
 #include "COM_BokehBlurOperation.h"
 #include "BLI_math.h"
 #include "COM_OpenCLDevice.h"
+#include "MEM_guardedalloc.h"
 
 #include "RE_pipeline.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 BokehBlurOperation::BokehBlurOperation()
 {
   this->addInputSocket(COM_DT_COLOR);
@@ -39,6 +44,9 @@ BokehBlurOperation::BokehBlurOperation()
   this->m_inputBoundingBoxReader = nullptr;
 
   this->m_extend_bounds = false;
+
+  this->m_bokehtab = nullptr;
+  this->m_bokehtabRadius = 0;
 }
 
 void *BokehBlurOperation::initializeTileData(rcti * /*rect*/)
@@ -47,11 +55,39 @@ void *BokehBlurOperation::initializeTileData(rcti * /*rect*/)
   if (!this->m_sizeavailable) {
     updateSize();
   }
+  if (this->m_bokehtab == nullptr) {
+    updateBokehTab();
+  }
   void *buffer = getInputOperation(0)->initializeTileData(nullptr);
   unlockMutex();
   return buffer;
 }
 
+void BokehBlurOperation::updateBokehTab()
+{
+  const float max_dim = max(this->getWidth(), this->getHeight());
+  const int pixelSize = this->m_size * max_dim / 100.0f;
+  if (pixelSize <= 0) {
+    return;
+  }
+
+  /* Offsets from -pixelSize to pixelSize - 1 in both directions, matching executePixel. */
+  const int size = pixelSize * 2;
+  this->m_bokehtab = (float *)MEM_mallocN_aligned(
+      sizeof(float[4]) * size * size, 16, "BokehBlurOperation bokehtab");
+  this->m_bokehtabRadius = pixelSize;
+
+  const float m = this->m_bokehDimension / pixelSize;
+  float *bokeh = this->m_bokehtab;
+  for (int dy = -pixelSize; dy < pixelSize; dy++) {
+    for (int dx = -pixelSize; dx < pixelSize; dx++, bokeh += 4) {
+      const float u = this->m_bokehMidX - dx * m;
+      const float v = this->m_bokehMidY - dy * m;
+      this->m_inputBokehProgram->readSampled(bokeh, u, v, COM_PS_NEAREST);
+    }
+  }
+}
+
 void BokehBlurOperation::initExecution()
 {
   initMutex();
@@ -72,13 +108,12 @@ void BokehBlurOperation::initExecution()
 
 void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 {
-  float color_accum[4];
+  float ATTR_ALIGN(16) color_accum[4];
   float tempBoundingBox[4];
-  float bokeh[4];
 
   this->m_inputBoundingBoxReader->readSampled(tempBoundingBox, x, y, COM_PS_NEAREST);
   if (tempBoundingBox[0] > 0.0f) {
-    float multiplier_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float ATTR_ALIGN(16) multiplier_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
     float *buffer = inputBuffer->getBuffer();
     int bufferwidth = inputBuffer->getWidth();
@@ -107,19 +142,35 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
     int step = getStep();
     int offsetadd = getOffsetAdd() * COM_NUM_CHANNELS_COLOR;
 
-    float m = this->m_bokehDimension / pixelSize;
+    BLI_assert(miny >= maxy || this->m_bokehtabRadius == pixelSize);
+    const int bokehtab_width = pixelSize * 2;
+#ifdef __SSE2__
+    __m128 color_accum_r = _mm_load_ps(color_accum);
+    __m128 multiplier_accum_r = _mm_load_ps(multiplier_accum);
+#endif
     for (int ny = miny; ny < maxy; ny += step) {
       int bufferindex = ((minx - bufferstartx) * COM_NUM_CHANNELS_COLOR) +
                         ((ny - bufferstarty) * COM_NUM_CHANNELS_COLOR * bufferwidth);
+      const float *bokeh = this->m_bokehtab +
+                           (((ny - y + pixelSize) * bokehtab_width) + (minx - x + pixelSize)) * 4;
       for (int nx = minx; nx < maxx; nx += step) {
-        float u = this->m_bokehMidX - (nx - x) * m;
-        float v = this->m_bokehMidY - (ny - y) * m;
-        this->m_inputBokehProgram->readSampled(bokeh, u, v, COM_PS_NEAREST);
+#ifdef __SSE2__
+        const __m128 bokeh_r = _mm_load_ps(bokeh);
+        color_accum_r = _mm_add_ps(color_accum_r,
+                                   _mm_mul_ps(bokeh_r, _mm_load_ps(&buffer[bufferindex])));
+        multiplier_accum_r = _mm_add_ps(multiplier_accum_r, bokeh_r);
+#else
         madd_v4_v4v4(color_accum, bokeh, &buffer[bufferindex]);
         add_v4_v4(multiplier_accum, bokeh);
+#endif
         bufferindex += offsetadd;
+        bokeh += step * 4;
       }
     }
+#ifdef __SSE2__
+    _mm_store_ps(color_accum, color_accum_r);
+    _mm_store_ps(multiplier_accum, multiplier_accum_r);
+#endif
     output[0] = color_accum[0] * (1.0f / multiplier_accum[0]);
     output[1] = color_accum[1] * (1.0f / multiplier_accum[1]);
     output[2] = color_accum[2] * (1.0f / multiplier_accum[2]);
@@ -133,6 +184,10 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 void BokehBlurOperation::deinitExecution()
 {
   deinitMutex();
+  if (this->m_bokehtab) {
+    MEM_freeN(this->m_bokehtab);
+    this->m_bokehtab = nullptr;
+  }
   this->m_inputProgram = nullptr;
   this->m_inputBokehProgram = nullptr;
   this->m_inputBoundingBoxReader = nullptr;
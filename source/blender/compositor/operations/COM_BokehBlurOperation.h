@@ -34,6 +34,15 @@ class BokehBlurOperation : public NodeOperation, public QualityStepHelper {
   float m_bokehDimension;
   bool m_extend_bounds;
 
+  /**
+   * \brief weights of the bokeh image for every offset within the blur radius
+   * Sampling the bokeh input for every pixel and offset dominates the cost of the blur, the
+   * weights only depend on the offset so they are looked up once per execution.
+   */
+  float *m_bokehtab;
+  int m_bokehtabRadius;
+  void updateBokehTab();
+
  public:
   BokehBlurOperation();
 
@@ -23,6 +23,7 @@
 ConvertBaseOperation::ConvertBaseOperation()
 {
   this->m_inputOperation = nullptr;
+  this->setConstantFoldable(true);
 }
 
 void ConvertBaseOperation::initExecution()
@@ -20,9 +20,12 @@
 
 #include "COM_NodeOperation.h"
 
+#include <unordered_set>
+
 class CryptomatteOperation : public NodeOperation {
  private:
-  std::vector<float> m_objectIndex;
+  /* Set instead of a list, so that selecting many objects stays fast. */
+  std::unordered_set<float> m_objectIndex;
 
  public:
   std::vector<SocketReader *> inputs;
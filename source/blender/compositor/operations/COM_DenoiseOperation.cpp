@@ -50,6 +50,19 @@ void DenoiseOperation::deinitExecution()
   SingleThreadedOperation::deinitExecution();
 }
 
+bool DenoiseOperation::hashResult(rcti *rect, BLI_HashMurmur2A *hash)
+{
+  if (this->m_settings == nullptr) {
+    return false;
+  }
+
+  BLI_hash_mm2a_add(hash, (const unsigned char *)this->m_settings, sizeof(NodeDenoise));
+  hashMemoryBuffer(hash, (MemoryBuffer *)this->m_inputProgramColor->initializeTileData(rect));
+  hashMemoryBuffer(hash, (MemoryBuffer *)this->m_inputProgramNormal->initializeTileData(rect));
+  hashMemoryBuffer(hash, (MemoryBuffer *)this->m_inputProgramAlbedo->initializeTileData(rect));
+  return true;
+}
+
 MemoryBuffer *DenoiseOperation::createMemoryBuffer(rcti *rect2)
 {
   MemoryBuffer *tileColor = (MemoryBuffer *)this->m_inputProgramColor->initializeTileData(rect2);
@@ -62,5 +62,6 @@ class DenoiseOperation : public SingleThreadedOperation {
                        MemoryBuffer *inputTileAlbedo,
                        NodeDenoise *settings);
 
+  bool hashResult(rcti *rect, BLI_HashMurmur2A *hash);
   MemoryBuffer *createMemoryBuffer(rcti *rect);
 };
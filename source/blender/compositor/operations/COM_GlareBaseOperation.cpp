@@ -37,6 +37,22 @@ void GlareBaseOperation::deinitExecution()
   SingleThreadedOperation::deinitExecution();
 }
 
+bool GlareBaseOperation::hashResult(rcti *rect, BLI_HashMurmur2A *hash)
+{
+  if (this->m_settings == nullptr) {
+    return false;
+  }
+
+  /* The glare type in the settings also identifies the subclass. Mix and threshold are applied
+   * outside of this operation, so changing them can reuse the cached glare. */
+  NodeGlare settings = *this->m_settings;
+  settings.mix = 0.0f;
+  settings.threshold = 0.0f;
+  BLI_hash_mm2a_add(hash, (const unsigned char *)&settings, sizeof(NodeGlare));
+  hashMemoryBuffer(hash, (MemoryBuffer *)this->m_inputProgram->initializeTileData(rect));
+  return true;
+}
+
 MemoryBuffer *GlareBaseOperation::createMemoryBuffer(rcti *rect2)
 {
   MemoryBuffer *tile = (MemoryBuffer *)this->m_inputProgram->initializeTileData(rect2);
@@ -71,5 +71,6 @@ class GlareBaseOperation : public SingleThreadedOperation {
 
   virtual void generateGlare(float *data, MemoryBuffer *inputTile, NodeGlare *settings) = 0;
 
+  bool hashResult(rcti *rect, BLI_HashMurmur2A *hash);
   MemoryBuffer *createMemoryBuffer(rcti *rect);
 };
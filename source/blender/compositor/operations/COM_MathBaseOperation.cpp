@@ -30,6 +30,7 @@ MathBaseOperation::MathBaseOperation()
   this->m_inputValue2Operation = nullptr;
   this->m_inputValue3Operation = nullptr;
   this->m_useClamp = false;
+  this->setConstantFoldable(true);
 }
 
 void MathBaseOperation::initExecution()
@@ -33,6 +33,7 @@ MixBaseOperation::MixBaseOperation()
   this->m_inputColor2Operation = nullptr;
   this->setUseValueAlphaMultiply(false);
   this->setUseClamp(false);
+  this->setConstantFoldable(true);
 }
 
 void MixBaseOperation::initExecution()
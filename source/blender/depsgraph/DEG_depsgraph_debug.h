@@ -62,6 +62,14 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* Start recording a timeline of all operations evaluated by the graph, with the thread they were
+ * evaluated on. Recording continues over multiple evaluations until #DEG_debug_trace_end. */
+void DEG_debug_trace_begin(struct Depsgraph *depsgraph);
+
+/* Stop recording and write the timeline in the Chrome trace event JSON format, which can be
+ * opened in `chrome://tracing` or the Perfetto UI. Nothing is written when `fp` is null. */
+void DEG_debug_trace_end(struct Depsgraph *depsgraph, FILE *fp);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
@@ -83,6 +83,7 @@
 #include "BKE_key.h"
 #include "BKE_lattice.h"
 #include "BKE_layer.h"
+#include "BKE_lib_query.h"
 #include "BKE_light.h"
 #include "BKE_mask.h"
 #include "BKE_material.h"
@@ -113,6 +114,8 @@
 
 #include "intern/builder/deg_builder.h"
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/depsgraph_tag.h"
 #include "intern/depsgraph_type.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
 #include "intern/node/deg_node.h"
@@ -139,14 +142,62 @@ DepsgraphNodeBuilder::DepsgraphNodeBuilder(Main *bmain,
 {
 }
 
+/* Callback for BKE_library_foreach_ID_link which collects ID pointers of a copy-on-write
+ * datablock without dereferencing them. */
+static int foreach_id_reference_callback(LibraryIDLinkCallbackData *cb_data)
+{
+  Vector<const ID *> *references = (Vector<const ID *> *)cb_data->user_data;
+  /* Embedded IDs are part of the datablock itself. */
+  if (*cb_data->id_pointer != nullptr && (cb_data->cb_flag & IDWALK_CB_EMBEDDED) == 0) {
+    references->append_non_duplicates(*cb_data->id_pointer);
+  }
+  return IDWALK_RET_NOP;
+}
+
 DepsgraphNodeBuilder::~DepsgraphNodeBuilder()
 {
-  for (IDInfo *id_info : id_info_hash_.values()) {
-    if (id_info->id_cow != nullptr) {
-      deg_free_copy_on_write_datablock(id_info->id_cow);
-      MEM_freeN(id_info->id_cow);
+  PersistentEvalCache &persistent_cache = graph_->persistent_cache;
+  Vector<ID *> id_cows_to_free;
+  for (auto item : id_info_hash_.items()) {
+    IDInfo *id_info = item.value;
+    if (id_info->id_cow == nullptr) {
+      continue;
+    }
+    if (!use_persistent_cache_ || !id_info->can_persist) {
+      id_cows_to_free.append(id_info->id_cow);
+      continue;
     }
-    MEM_freeN(id_info);
+    /* The ID is not in the graph anymore, keep its evaluated state around in case it comes
+     * back. */
+    PersistentEvalCache::Entry entry;
+    entry.id_orig = item.key;
+    entry.id_cow = id_info->id_cow;
+    entry.visible_components_mask = id_info->previously_visible_components_mask;
+    entry.eval_flags = id_info->previous_eval_flags;
+    entry.customdata_masks = id_info->previous_customdata_masks;
+    entry.dependencies = std::move(id_info->dependencies);
+    entry.depends_on_time = id_info->depends_on_time;
+    entry.ctime = graph_->ctime;
+    BKE_library_foreach_ID_link(nullptr,
+                                id_info->id_cow,
+                                foreach_id_reference_callback,
+                                &entry.references,
+                                IDWALK_READONLY);
+    persistent_cache.add(std::move(entry));
+  }
+  if (use_persistent_cache_) {
+    /* Cached datablocks referencing the ones freed below are not valid anymore. */
+    persistent_cache.remove_invalid(graph_, main_ids_);
+  }
+  else {
+    persistent_cache.clear();
+  }
+  for (ID *id_cow : id_cows_to_free) {
+    deg_free_copy_on_write_datablock(id_cow);
+    MEM_freeN(id_cow);
+  }
+  for (IDInfo *id_info : id_info_hash_.values()) {
+    delete id_info;
   }
 }
 
@@ -166,6 +217,16 @@ IDNode *DepsgraphNodeBuilder::add_id_node(ID *id)
     /* Tag ID info to not free the CoW ID pointer. */
     id_info->id_cow = nullptr;
   }
+  else if (use_persistent_cache_ && graph_->find_id_node(id) == nullptr) {
+    optional<PersistentEvalCache::Entry> entry = graph_->persistent_cache.pop(id);
+    if (entry.has_value()) {
+      id_cow = entry->id_cow;
+      previously_visible_components_mask = entry->visible_components_mask;
+      previous_eval_flags = entry->eval_flags;
+      previous_customdata_masks = entry->customdata_masks;
+      restored_cache_entries_.append({id, std::move(entry->references)});
+    }
+  }
   id_node = graph_->add_id_node(id, id_cow);
   id_node->previously_visible_components_mask = previously_visible_components_mask;
   id_node->previous_eval_flags = previous_eval_flags;
@@ -309,6 +370,12 @@ ID *DepsgraphNodeBuilder::ensure_cow_id(ID *id_orig)
 
 void DepsgraphNodeBuilder::begin_build()
 {
+  use_persistent_cache_ = PersistentEvalCache::is_enabled(graph_);
+  if (use_persistent_cache_) {
+    main_ids_ = PersistentEvalCache::main_ids_get(bmain_);
+    graph_->persistent_cache.remove_invalid(graph_, main_ids_);
+  }
+
   /* Store existing copy-on-write versions of datablock, so we can re-use
    * them for new ID nodes. */
   for (IDNode *id_node : graph_->id_nodes) {
@@ -324,7 +391,7 @@ void DepsgraphNodeBuilder::begin_build()
       continue;
     }
 
-    IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+    IDInfo *id_info = new IDInfo();
     if (deg_copy_on_write_is_expanded(id_node->id_cow) && id_node->id_orig != id_node->id_cow) {
       id_info->id_cow = id_node->id_cow;
     }
@@ -334,6 +401,9 @@ void DepsgraphNodeBuilder::begin_build()
     id_info->previously_visible_components_mask = id_node->visible_components_mask;
     id_info->previous_eval_flags = id_node->eval_flags;
     id_info->previous_customdata_masks = id_node->customdata_masks;
+    if (use_persistent_cache_ && id_info->id_cow != nullptr) {
+      gather_persistent_cache_inputs(id_node, id_info);
+    }
     id_info_hash_.add_new(id_node->id_orig, id_info);
     id_node->id_cow = nullptr;
   }
@@ -357,8 +427,60 @@ void DepsgraphNodeBuilder::begin_build()
   graph_->entry_tags.clear();
 }
 
+void DepsgraphNodeBuilder::gather_persistent_cache_inputs(IDNode *id_node, IDInfo *id_info)
+{
+  /* The original ID might have been deleted, in which case pointer can not be dereferenced. */
+  id_info->can_persist = main_ids_.contains(id_node->id_orig);
+  if (!id_info->can_persist) {
+    return;
+  }
+  for (ComponentNode *comp_node : id_node->components.values()) {
+    for (OperationNode *op_node : comp_node->operations) {
+      for (Relation *rel : op_node->inlinks) {
+        if (rel->from->type == NodeType::TIMESOURCE) {
+          id_info->depends_on_time = true;
+          continue;
+        }
+        if (rel->from->type != NodeType::OPERATION) {
+          continue;
+        }
+        const IDNode *from_id_node = ((OperationNode *)rel->from)->owner->owner;
+        if (from_id_node == id_node) {
+          continue;
+        }
+        if (!main_ids_.contains(from_id_node->id_orig)) {
+          id_info->can_persist = false;
+          return;
+        }
+        id_info->dependencies.append_non_duplicates(from_id_node->id_orig->session_uuid);
+      }
+    }
+  }
+}
+
 void DepsgraphNodeBuilder::end_build()
 {
+  /* Datablocks restored from the persistent cache can only be used as-is when the IDs they point
+   * to are still valid, otherwise they need a copy-on-write update to remap the pointers. */
+  if (!restored_cache_entries_.is_empty()) {
+    Set<const ID *> valid_ids = main_ids_;
+    for (const IDNode *id_node : graph_->id_nodes) {
+      valid_ids.add(id_node->id_cow);
+    }
+    for (const RestoredCacheEntry &restored_entry : restored_cache_entries_) {
+      for (const ID *id : restored_entry.references) {
+        if (!valid_ids.contains(id)) {
+          graph_id_tag_update(bmain_,
+                              graph_,
+                              restored_entry.id_orig,
+                              ID_RECALC_COPY_ON_WRITE | ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY,
+                              DEG_UPDATE_SOURCE_RELATIONS);
+          break;
+        }
+      }
+    }
+  }
+
   for (const SavedEntryTag &entry_tag : saved_entry_tags_) {
     IDNode *id_node = find_id_node(entry_tag.id_orig);
     if (id_node == nullptr) {
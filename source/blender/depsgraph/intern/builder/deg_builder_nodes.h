@@ -244,6 +244,14 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
     uint32_t previous_eval_flags;
     /* Mesh CustomData mask from the previous depsgraph. */
     DEGCustomDataMeshMasks previous_customdata_masks;
+    /* Inputs of the ID in the previous depsgraph, used when the copy-on-write datablock is moved
+     * to the persistent cache. */
+    Vector<uint> dependencies;
+    bool depends_on_time = false;
+    /* False when some of the inputs were deleted from main. */
+    bool can_persist = false;
+
+    MEM_CXX_CLASS_ALLOC_FUNCS("IDInfo");
   };
 
  protected:
@@ -259,6 +267,21 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   };
   Vector<SavedEntryTag> saved_entry_tags_;
 
+  /* Store inputs of the ID in the previous state of the graph, so that its copy-on-write
+   * datablock can be validated if it goes to the persistent cache. */
+  void gather_persistent_cache_inputs(IDNode *id_node, IDInfo *id_info);
+
+  /* Copy-on-write datablocks taken from the persistent cache of the graph, with the ID pointers
+   * they contain. Those pointers are checked once all ID nodes are built. */
+  struct RestoredCacheEntry {
+    ID *id_orig;
+    Vector<const ID *> references;
+  };
+  Vector<RestoredCacheEntry> restored_cache_entries_;
+  /* Original IDs of main, only filled in when the persistent cache is used. */
+  Set<const ID *> main_ids_;
+  bool use_persistent_cache_ = false;
+
   struct BuilderWalkUserData {
     DepsgraphNodeBuilder *builder;
     /* Denotes whether object the walk is invoked from is visible. */
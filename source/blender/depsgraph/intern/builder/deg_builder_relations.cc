@@ -1493,17 +1493,7 @@ void DepsgraphRelationBuilder::build_driver_data(ID *id, FCurve *fcu)
     const bool driver_targets_bbone = STRPREFIX(prop_identifier, "bbone_");
 
     /* Find objects which use this, and make their eval callbacks depend on this. */
-    for (IDNode *to_node : graph_->id_nodes) {
-      if (GS(to_node->id_orig->name) != ID_OB) {
-        continue;
-      }
-
-      /* We only care about objects with pose data which use this. */
-      Object *object = (Object *)to_node->id_orig;
-      if (object->data != id_ptr || object->pose == nullptr) {
-        continue;
-      }
-
+    for (Object *object : get_armature_pose_users(id_ptr)) {
       bPoseChannel *pchan = BKE_pose_channel_find_name(object->pose, bone->name);
       if (pchan == nullptr) {
         continue;
@@ -1530,16 +1520,9 @@ void DepsgraphRelationBuilder::build_driver_data(ID *id, FCurve *fcu)
     /* Similar to the case with f-curves, driver might drive a nested
      * data-block, which means driver execution should wait for that
      * data-block to be copied. */
-    {
-      PointerRNA id_ptr;
-      PointerRNA ptr;
-      RNA_id_pointer_create(id, &id_ptr);
-      if (RNA_path_resolve_full(&id_ptr, fcu->rna_path, &ptr, nullptr, nullptr)) {
-        if (id_ptr.owner_id != ptr.owner_id) {
-          ComponentKey cow_key(ptr.owner_id, NodeType::COPY_ON_WRITE);
-          add_relation(cow_key, driver_key, "Driven CoW -> Driver", RELATION_CHECK_BEFORE_ADD);
-        }
-      }
+    if (property_entry_key.ptr.owner_id != id) {
+      ComponentKey cow_key(property_entry_key.ptr.owner_id, NodeType::COPY_ON_WRITE);
+      add_relation(cow_key, driver_key, "Driven CoW -> Driver", RELATION_CHECK_BEFORE_ADD);
     }
     if (property_entry_key.prop != nullptr && RNA_property_is_idprop(property_entry_key.prop)) {
       RNAPathKey property_exit_key(property_entry_key.id,
@@ -1552,6 +1535,27 @@ void DepsgraphRelationBuilder::build_driver_data(ID *id, FCurve *fcu)
   }
 }
 
+Span<Object *> DepsgraphRelationBuilder::get_armature_pose_users(const ID *armature)
+{
+  if (!armature_pose_users_map_filled_) {
+    for (IDNode *id_node : graph_->id_nodes) {
+      if (GS(id_node->id_orig->name) != ID_OB) {
+        continue;
+      }
+      Object *object = (Object *)id_node->id_orig;
+      if (object->type == OB_ARMATURE && object->pose != nullptr) {
+        armature_pose_users_map_.lookup_or_add_default((ID *)object->data).append(object);
+      }
+    }
+    armature_pose_users_map_filled_ = true;
+  }
+  const Vector<Object *> *objects = armature_pose_users_map_.lookup_ptr(armature);
+  if (objects == nullptr) {
+    return {};
+  }
+  return *objects;
+}
+
 void DepsgraphRelationBuilder::build_driver_variables(ID *id, FCurve *fcu)
 {
   ChannelDriver *driver = fcu->driver;
@@ -356,6 +356,9 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   template<typename KeyFrom, typename KeyTo>
   bool is_same_nodetree_node_dependency(const KeyFrom &key_from, const KeyTo &key_to);
 
+  /* Objects in the graph which have a pose and use the given armature as their data. */
+  Span<Object *> get_armature_pose_users(const ID *armature);
+
  private:
   struct BuilderWalkUserData {
     DepsgraphRelationBuilder *builder;
@@ -373,6 +376,11 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
+
+  /* Lazily filled from all ID nodes on the first lookup, which avoids looping over all IDs for
+   * every driver on bone properties. */
+  Map<const ID *, Vector<Object *>> armature_pose_users_map_;
+  bool armature_pose_users_map_filled_ = false;
 };
 
 struct DepsNodeHandle {
@@ -22,6 +22,7 @@
  */
 
 #include "intern/debug/deg_debug.h"
+#include "intern/debug/deg_debug_trace.h"
 
 #include "BLI_console.h"
 #include "BLI_hash.h"
@@ -39,6 +40,8 @@ DepsgraphDebug::DepsgraphDebug()
 {
 }
 
+DepsgraphDebug::~DepsgraphDebug() = default;
+
 bool DepsgraphDebug::do_time_debug() const
 {
   return ((G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0);
@@ -33,9 +33,12 @@
 namespace blender {
 namespace deg {
 
+class EvaluationTrace;
+
 class DepsgraphDebug {
  public:
   DepsgraphDebug();
+  ~DepsgraphDebug();
 
   bool do_time_debug() const;
 
@@ -53,6 +56,10 @@ class DepsgraphDebug {
    * This is NOT an indication that depsgraph is at its evaluated state. */
   bool is_ever_evaluated;
 
+  /* Timeline of evaluated operations, recorded between #DEG_debug_trace_begin and
+   * #DEG_debug_trace_end. Is null when no trace is being recorded. */
+  unique_ptr<EvaluationTrace> trace;
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
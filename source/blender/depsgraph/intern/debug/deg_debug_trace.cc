@@ -0,0 +1,132 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "intern/depsgraph.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+
+namespace {
+
+string json_escape(const string &str)
+{
+  string result;
+  result.reserve(str.size());
+  for (const char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      result += '\\';
+      result += ch;
+    }
+    else if ((unsigned char)ch < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+      result += buffer;
+    }
+    else {
+      result += ch;
+    }
+  }
+  return result;
+}
+
+double microseconds_between(EvaluationTrace::TimePoint start, EvaluationTrace::TimePoint end)
+{
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+}  // namespace
+
+EvaluationTrace::EvaluationTrace() : begin_time_(Clock::now())
+{
+}
+
+void EvaluationTrace::add_event(string name, string category, TimePoint start, TimePoint end)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int thread_index = thread_index_get();
+  events_.append({std::move(name), std::move(category), start, end, thread_index});
+}
+
+int EvaluationTrace::thread_index_get()
+{
+  const std::thread::id thread_id = std::this_thread::get_id();
+  const int64_t index = thread_ids_.first_index_of_try(thread_id);
+  if (index != -1) {
+    return (int)index;
+  }
+  thread_ids_.append(thread_id);
+  return (int)thread_ids_.size() - 1;
+}
+
+void EvaluationTrace::write_chrome_json(FILE *file) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool is_first = true;
+  for (const int64_t thread_index : thread_ids_.index_range()) {
+    fprintf(file,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"Thread %d\"}}",
+            is_first ? "" : ",\n",
+            (int)thread_index,
+            (int)thread_index);
+    is_first = false;
+  }
+  for (const Event &event : events_) {
+    fprintf(file,
+            "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+            "\"ts\":%.3f,\"dur\":%.3f}",
+            is_first ? "" : ",\n",
+            json_escape(event.name).c_str(),
+            json_escape(event.category).c_str(),
+            event.thread_index,
+            microseconds_between(begin_time_, event.start),
+            microseconds_between(event.start, event.end));
+    is_first = false;
+  }
+  fprintf(file, "\n]}\n");
+}
+
+}  // namespace blender::deg
+
+void DEG_debug_trace_begin(Depsgraph *depsgraph)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  deg_graph->debug.trace = std::make_unique<deg::EvaluationTrace>();
+}
+
+void DEG_debug_trace_end(Depsgraph *depsgraph, FILE *fp)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  if (!deg_graph->debug.trace) {
+    return;
+  }
+  if (fp != nullptr) {
+    deg_graph->debug.trace->write_chrome_json(fp);
+  }
+  deg_graph->debug.trace.reset();
+}
@@ -0,0 +1,74 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recorder of a timeline of evaluated operations, which shows how the evaluation is spread over
+ * threads. Unlike the aggregated timing statistics this makes idle threads and serialization
+ * points visible.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "BLI_timeit.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "intern/depsgraph_type.h"
+
+namespace blender::deg {
+
+class EvaluationTrace : NonCopyable, NonMovable {
+ public:
+  using Clock = timeit::Clock;
+  using TimePoint = timeit::TimePoint;
+
+  EvaluationTrace();
+
+  /* Record an event which happened on the calling thread. Is safe to be called from multiple
+   * threads at the same time. */
+  void add_event(string name, string category, TimePoint start, TimePoint end);
+
+  /* Write all recorded events in the Chrome trace event format, which can be opened in
+   * `chrome://tracing` or the Perfetto UI. */
+  void write_chrome_json(FILE *file) const;
+
+ private:
+  struct Event {
+    string name;
+    string category;
+    TimePoint start;
+    TimePoint end;
+    int thread_index;
+  };
+
+  /* Small and stable index of the calling thread. Must be called with the mutex locked. */
+  int thread_index_get();
+
+  TimePoint begin_time_;
+  mutable std::mutex mutex_;
+  Vector<Event> events_;
+  Vector<std::thread::id> thread_ids_;
+};
+
+}  // namespace blender::deg
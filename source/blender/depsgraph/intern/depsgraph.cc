@@ -82,6 +82,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
 
 Depsgraph::~Depsgraph()
 {
+  persistent_cache.clear();
   clear_id_nodes();
   delete time_source;
   BLI_spin_end(&lock);
@@ -44,6 +44,7 @@
 
 #include "intern/debug/deg_debug.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_persistent_cache.h"
 
 struct ID;
 struct Scene;
@@ -167,6 +168,9 @@ struct Depsgraph {
    * created along with relations, for fast lookup during evaluation. */
   Map<const ID *, ListBase *> *physics_relations[DEG_PHYSICS_RELATIONS_NUM];
 
+  /* Evaluated datablocks of IDs removed from the graph by relations updates. */
+  PersistentEvalCache persistent_cache;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Depsgraph");
 };
 
@@ -639,6 +639,10 @@ void graph_id_tag_update(
   IDNode *id_node = (graph != nullptr) ? graph->find_id_node(id) : nullptr;
   if (graph != nullptr) {
     DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id->name));
+    /* Evaluated data of IDs which are not in the graph anymore is kept as long as nothing it
+     * depends on changes. Stamp unconditionally, so the stamps are reliable when the cache gets
+     * enabled. */
+    graph->persistent_cache.tag_id_update(id);
   }
   if (flag == 0) {
     deg_graph_node_tag_zero(bmain, graph, id_node, update_source);
@@ -25,12 +25,15 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.h"
 
@@ -43,6 +46,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
@@ -68,9 +72,22 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args);
 
-void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), TaskPool *pool)
+/* Operations which became ready for evaluation. */
+using ReadyOperations = Vector<OperationNode *, 16>;
+
+void schedule_node_to_vector(OperationNode *node,
+                             const int UNUSED(thread_id),
+                             ReadyOperations *ready_operations)
+{
+  ready_operations->append(node);
+}
+
+/* Sort operations so that the ones with the longest chain of dependent operations come first. */
+void sort_by_critical_path(MutableSpan<OperationNode *> operations)
 {
-  BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  std::sort(operations.begin(), operations.end(), [](OperationNode *a, OperationNode *b) {
+    return a->critical_path_cost > b->critical_path_cost;
+  });
 }
 
 /* Denotes which part of dependency graph is being evaluated. */
@@ -93,6 +110,8 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Timeline recorder, null when no trace is requested. */
+  EvaluationTrace *trace;
   EvaluationStage stage;
   bool need_single_thread_pass;
 };
@@ -103,14 +122,34 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. The time is always measured, it is used as cost estimate for
+   * scheduling of the next evaluation. */
+  const double start_time = PIL_check_seconds_timer();
+  const EvaluationTrace::TimePoint trace_start_time = (state->trace != nullptr) ?
+                                                          EvaluationTrace::Clock::now() :
+                                                          EvaluationTrace::TimePoint();
+  operation_node->evaluate(depsgraph);
+  const double time = PIL_check_seconds_timer() - start_time;
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (state->trace != nullptr) {
+    state->trace->add_event(operation_node->full_identifier(),
+                            nodeTypeAsString(operation_node->owner->type),
+                            trace_start_time,
+                            EvaluationTrace::Clock::now());
+  }
+  deg_eval_stats_operation_cost_update(operation_node, time);
+}
+
+/* Record the evaluation stage which started at the given time, so that the synchronization
+ * between stages is visible in the trace. */
+void trace_stage(const DepsgraphEvalState *state,
+                 const char *name,
+                 const EvaluationTrace::TimePoint start_time)
+{
+  if (state->trace != nullptr) {
+    state->trace->add_event(name, "Stage", start_time, EvaluationTrace::Clock::now());
   }
 }
 
@@ -119,15 +158,28 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  ReadyOperations ready_operations;
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    /* Schedule children. The most expensive one is evaluated right away in this thread, so the
+     * critical path continues without waiting for the pool. */
+    ready_operations.clear();
+    schedule_children(state, operation_node, schedule_node_to_vector, &ready_operations);
+    if (ready_operations.is_empty()) {
+      break;
+    }
+    sort_by_critical_path(ready_operations);
+    operation_node = ready_operations[0];
+    for (OperationNode *node : ready_operations.as_span().drop_front(1)) {
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    }
+  }
 }
 
-bool check_operation_node_visible(OperationNode *op_node)
+bool check_operation_node_visible(const OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
   /* Special exception, copy on write component is to be always evaluated,
@@ -177,10 +229,72 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+bool need_evaluate_operation(const OperationNode *node)
+{
+  return check_operation_node_visible(node) &&
+         (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) != 0;
+}
+
+/* Calculate the critical path cost of all operations which are to be evaluated: their own cost
+ * and the most expensive chain of operations depending on them. Uses an explicit stack instead
+ * of recursion, dependency chains can be long. */
+void calculate_critical_path_costs(Depsgraph *graph)
+{
+  const float unknown_cost = -1.0f;
+  for (OperationNode *node : graph->operations) {
+    node->critical_path_cost = unknown_cost;
+  }
+
+  struct StackItem {
+    OperationNode *node;
+    int64_t next_outlink;
+  };
+  Vector<StackItem, 64> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->critical_path_cost != unknown_cost || !need_evaluate_operation(root)) {
+      continue;
+    }
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      StackItem &item = stack.last();
+      const Span<Relation *> outlinks = item.node->outlinks;
+      OperationNode *child_to_visit = nullptr;
+      while (item.next_outlink < outlinks.size()) {
+        Relation *rel = outlinks[item.next_outlink++];
+        OperationNode *child = (OperationNode *)rel->to;
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 &&
+            child->critical_path_cost == unknown_cost && need_evaluate_operation(child)) {
+          child_to_visit = child;
+          break;
+        }
+      }
+      if (child_to_visit != nullptr) {
+        /* Mark as being visited, so it is not entered again. */
+        child_to_visit->critical_path_cost = 0.0f;
+        stack.append({child_to_visit, 0});
+        continue;
+      }
+      /* All children are calculated. */
+      OperationNode *node = item.node;
+      float children_cost = 0.0f;
+      for (Relation *rel : outlinks) {
+        const OperationNode *child = (OperationNode *)rel->to;
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+          children_cost = std::max(children_cost, child->critical_path_cost);
+        }
+      }
+      node->critical_path_cost = (node->is_noop() ? 0.0f : node->evaluation_cost) +
+                                 children_cost;
+      stack.remove_last();
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  calculate_critical_path_costs(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -285,6 +399,17 @@ void schedule_graph(DepsgraphEvalState *state,
   }
 }
 
+/* Push all initially ready operations to the pool, the ones starting the longest chains first. */
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  ReadyOperations ready_operations;
+  schedule_graph(state, schedule_node_to_vector, &ready_operations);
+  sort_by_critical_path(ready_operations);
+  for (OperationNode *node : ready_operations) {
+    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  }
+}
+
 template<typename ScheduleFunction, typename... ScheduleFunctionArgs>
 void schedule_children(DepsgraphEvalState *state,
                        OperationNode *node,
@@ -378,28 +503,37 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.trace = graph->debug.trace.get();
   state.need_single_thread_pass = false;
+  EvaluationTrace::TimePoint stage_start_time = EvaluationTrace::Clock::now();
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
+  trace_stage(&state, "Initialize", stage_start_time);
 
   /* Do actual evaluation now. */
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
+  stage_start_time = EvaluationTrace::Clock::now();
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
+  trace_stage(&state, "Copy-on-Write", stage_start_time);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
+  stage_start_time = EvaluationTrace::Clock::now();
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
+  trace_stage(&state, "Threaded Evaluation", stage_start_time);
 
   if (state.need_single_thread_pass) {
     state.stage = EvaluationStage::SINGLE_THREADED_WORKAROUND;
+    stage_start_time = EvaluationTrace::Clock::now();
     evaluate_graph_single_threaded(&state);
+    trace_stage(&state, "Single Threaded Workaround", stage_start_time);
   }
 
   /* Finalize statistics gathering. This is because we only gather single
@@ -410,6 +544,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
+  graph->persistent_cache.tag_evaluated();
   graph->is_evaluating = false;
 
   graph->debug.end_graph_evaluation();
@@ -65,6 +65,7 @@
 #include "DNA_sequence_types.h"
 #include "DNA_simulation_types.h"
 #include "DNA_sound_types.h"
+#include "DNA_userdef_types.h"
 
 #include "DRW_engine.h"
 
@@ -284,6 +285,29 @@ struct ValidateData {
 
 /* Similar to generic BKE_id_copy() but does not require main and assumes pointer
  * is already allocated. */
+/* Whether the copy-on-write datablock can reference the custom data layers of the original
+ * instead of duplicating them.
+ *
+ * Referenced layers are not freed with the copy, and evaluation code already treats them as
+ * copy-on-first-write: it duplicates a referenced layer before modifying it (see
+ * #CustomData_duplicate_referenced_layer), the same as for meshes copied for evaluation with
+ * #BKE_mesh_copy_for_eval. Every change to the original geometry is tagged for update, which
+ * makes the copy reference the new layers. */
+bool id_copy_can_reference_custom_data(const ID *id)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_cow_reference_custom_data)) {
+    return false;
+  }
+  switch (GS(id->name)) {
+    case ID_ME:
+    case ID_HA:
+    case ID_PT:
+      return true;
+    default:
+      return false;
+  }
+}
+
 bool id_copy_inplace_no_main(const ID *id, ID *newid)
 {
   const ID *id_for_copy = id;
@@ -301,10 +325,12 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   id_for_copy = nested_id_hack_get_discarded_pointers(&id_hack_storage, id);
 #endif
 
-  bool result = (BKE_id_copy_ex(nullptr,
-                                (ID *)id_for_copy,
-                                &newid,
-                                LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE) != nullptr);
+  int flag = LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE;
+  if (id_copy_can_reference_custom_data(id)) {
+    flag |= LIB_ID_COPY_CD_REFERENCE;
+  }
+
+  bool result = (BKE_id_copy_ex(nullptr, (ID *)id_for_copy, &newid, flag) != nullptr);
 
 #ifdef NESTED_ID_NASTY_WORKAROUND
   if (result) {
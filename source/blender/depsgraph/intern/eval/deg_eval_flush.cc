@@ -224,6 +224,7 @@ void flush_editors_id_update(Depsgraph *graph, const DEGEditorUpdateContext *upd
       continue;
     }
     DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id_node->id_orig->name));
+    graph->persistent_cache.tag_id_update(id_node->id_orig);
     /* TODO(sergey): Do we need to pass original or evaluated ID here? */
     ID *id_orig = id_node->id_orig;
     ID *id_cow = id_node->id_cow;
@@ -0,0 +1,195 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_persistent_cache.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+
+#include "BKE_main.h"
+
+#include "DNA_ID.h"
+#include "DNA_userdef_types.h"
+
+#include "intern/depsgraph.h"
+#include "intern/eval/deg_eval_copy_on_write.h"
+
+namespace blender::deg {
+
+PersistentEvalCache::~PersistentEvalCache()
+{
+  clear();
+}
+
+bool PersistentEvalCache::is_enabled(const Depsgraph *graph)
+{
+  return graph->is_active && USER_EXPERIMENTAL_TEST(&U, use_persistent_evaluated_data);
+}
+
+void PersistentEvalCache::tag_id_update(const ID *id_orig)
+{
+  update_stamps_.add_overwrite(id_orig->session_uuid, ++stamp_);
+}
+
+void PersistentEvalCache::tag_evaluated()
+{
+  evaluated_stamp_ = stamp_;
+}
+
+void PersistentEvalCache::add(Entry &&entry)
+{
+  const uint session_uuid = entry.id_orig->session_uuid;
+  optional<Entry> previous_entry = entries_.pop_try(session_uuid);
+  if (previous_entry.has_value()) {
+    Entry *entry_ptr = &*previous_entry;
+    free_entries({&entry_ptr, 1});
+  }
+  entry.stamp = evaluated_stamp_;
+  entries_.add_new(session_uuid, std::move(entry));
+}
+
+optional<PersistentEvalCache::Entry> PersistentEvalCache::pop(const ID *id_orig)
+{
+  if (entries_.is_empty()) {
+    return {};
+  }
+  const Entry *entry = entries_.lookup_ptr(id_orig->session_uuid);
+  if (entry == nullptr || entry->id_orig != id_orig) {
+    return {};
+  }
+  return entries_.pop(id_orig->session_uuid);
+}
+
+bool PersistentEvalCache::is_valid(const Entry &entry, const Depsgraph *graph) const
+{
+  if (entry.depends_on_time && entry.ctime != graph->ctime) {
+    return false;
+  }
+  if (update_stamps_.lookup_default(entry.id_orig->session_uuid, 0) > entry.stamp) {
+    return false;
+  }
+  for (const uint session_uuid : entry.dependencies) {
+    if (update_stamps_.lookup_default(session_uuid, 0) > entry.stamp) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Set<const ID *> PersistentEvalCache::main_ids_get(Main *bmain)
+{
+  Set<const ID *> main_ids;
+  ListBase *lbarray[MAX_LIBARRAY];
+  int a = set_listbasepointers(bmain, lbarray);
+  while (a--) {
+    LISTBASE_FOREACH (const ID *, id, lbarray[a]) {
+      main_ids.add(id);
+    }
+  }
+  return main_ids;
+}
+
+void PersistentEvalCache::remove_invalid(const Depsgraph *graph, const Set<const ID *> &main_ids)
+{
+  if (entries_.is_empty()) {
+    return;
+  }
+
+  /* Original IDs of entries might have been deleted, their pointers are only dereferenced after
+   * they are found in main. */
+  Set<uint> invalid_keys;
+  for (auto item : entries_.items()) {
+    const Entry &entry = item.value;
+    if (!main_ids.contains(entry.id_orig) || entry.id_orig->session_uuid != item.key ||
+        !is_valid(entry, graph)) {
+      invalid_keys.add(item.key);
+    }
+  }
+
+  /* Datablocks must only reference IDs which are alive, so that they can be freed safely. Removing
+   * an entry frees its datablock, so repeat until no more entries reference removed ones. */
+  Set<const ID *> alive_ids = main_ids;
+  for (const IDNode *id_node : graph->id_nodes) {
+    alive_ids.add(id_node->id_cow);
+  }
+  bool has_removed_entries = true;
+  while (has_removed_entries) {
+    has_removed_entries = false;
+    Set<const ID *> cached_ids = alive_ids;
+    for (auto item : entries_.items()) {
+      if (!invalid_keys.contains(item.key)) {
+        cached_ids.add(item.value.id_cow);
+      }
+    }
+    for (auto item : entries_.items()) {
+      if (invalid_keys.contains(item.key)) {
+        continue;
+      }
+      for (const ID *id : item.value.references) {
+        if (!cached_ids.contains(id)) {
+          invalid_keys.add(item.key);
+          has_removed_entries = true;
+          break;
+        }
+      }
+    }
+  }
+
+  Vector<Entry> invalid_entries;
+  for (const uint key : invalid_keys) {
+    invalid_entries.append(entries_.pop(key));
+  }
+  Vector<Entry *> entries_to_free;
+  for (Entry &entry : invalid_entries) {
+    entries_to_free.append(&entry);
+  }
+  free_entries(entries_to_free);
+}
+
+void PersistentEvalCache::clear()
+{
+  Vector<Entry *> entries_to_free;
+  for (Entry &entry : entries_.values()) {
+    entries_to_free.append(&entry);
+  }
+  free_entries(entries_to_free);
+  entries_.clear();
+}
+
+void PersistentEvalCache::free_entries(Span<Entry *> entries)
+{
+  /* Same order as #Depsgraph::clear_id_nodes: particle settings are accessed when freeing
+   * objects, so free them last. */
+  for (const bool free_particle_settings : {false, true}) {
+    for (Entry *entry : entries) {
+      if ((GS(entry->id_cow->name) == ID_PA) != free_particle_settings) {
+        continue;
+      }
+      deg_free_copy_on_write_datablock(entry->id_cow);
+      MEM_freeN(entry->id_cow);
+    }
+  }
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,108 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "intern/depsgraph_type.h"
+#include "intern/node/deg_node_id.h"
+
+struct ID;
+struct Main;
+
+namespace blender {
+namespace deg {
+
+struct Depsgraph;
+
+/* Copy-on-write datablocks of IDs which were removed from the dependency graph by a relations
+ * update (for example when hiding a collection), kept together with their evaluated state. When
+ * such ID is added back to the graph and none of its inputs changed in the meantime, the cached
+ * datablock is used as-is and does not need to be evaluated again.
+ *
+ * Inputs are tracked with update stamps: every time an ID is tagged for update or is modified by
+ * an evaluation, it gets a new stamp. A cached datablock gets the stamp of the last finished
+ * evaluation of the graph, and is valid as long as neither its ID nor any of the IDs it depends on
+ * got a newer stamp. */
+class PersistentEvalCache {
+ public:
+  struct Entry {
+    const ID *id_orig;
+    ID *id_cow;
+    /* State of the ID node the datablock was taken from. */
+    IDComponentsMask visible_components_mask;
+    uint32_t eval_flags;
+    DEGCustomDataMeshMasks customdata_masks;
+    /* Session UUIDs of the IDs this one depends on. */
+    Vector<uint> dependencies;
+    /* ID pointers stored in the datablock. They must still point to copy-on-write datablocks of
+     * the graph (or to original IDs) for the datablock to be used without copy-on-write update.
+     * Only compared, never dereferenced, since they might be dangling. */
+    Vector<const ID *> references;
+    bool depends_on_time;
+    float ctime;
+    uint64_t stamp;
+  };
+
+  ~PersistentEvalCache();
+
+  /* Only active dependency graphs keep evaluated data of hidden IDs. Update stamps are tracked
+   * for all graphs. */
+  static bool is_enabled(const Depsgraph *graph);
+
+  /* Mark the ID as changed, invalidating cached datablocks depending on it. */
+  void tag_id_update(const ID *id_orig);
+
+  /* All tagged IDs of the graph are evaluated, datablocks cached from now on are up to date with
+   * changes tagged so far. */
+  void tag_evaluated();
+
+  /* Store the entry, the cache takes ownership of its copy-on-write datablock.
+   * The stamp of the entry is set by the cache. */
+  void add(Entry &&entry);
+
+  /* Take the entry of the ID out of the cache, caller takes ownership of the copy-on-write
+   * datablock. */
+  optional<Entry> pop(const ID *id_orig);
+
+  /* Free datablocks which can not be used anymore: their ID was deleted, their inputs changed or
+   * they reference datablocks which are neither in main, nor in the graph, nor cached. */
+  void remove_invalid(const Depsgraph *graph, const Set<const ID *> &main_ids);
+
+  /* Original IDs of the main database of the graph. */
+  static Set<const ID *> main_ids_get(Main *bmain);
+
+  /* Free all cached datablocks. */
+  void clear();
+
+ private:
+  bool is_valid(const Entry &entry, const Depsgraph *graph) const;
+  static void free_entries(Span<Entry *> entries);
+
+  Map<uint, uint64_t> update_stamps_;
+  uint64_t stamp_ = 0;
+  uint64_t evaluated_stamp_ = 0;
+  Map<uint, Entry> entries_;
+};
+
+}  // namespace deg
+}  // namespace blender
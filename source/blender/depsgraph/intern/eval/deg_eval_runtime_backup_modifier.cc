@@ -28,7 +28,9 @@
 namespace blender::deg {
 
 ModifierDataBackup::ModifierDataBackup(ModifierData *modifier_data)
-    : type(static_cast<ModifierType>(modifier_data->type)), runtime(modifier_data->runtime)
+    : type(static_cast<ModifierType>(modifier_data->type)),
+      runtime(modifier_data->runtime),
+      result_cache(modifier_data->result_cache)
 {
 }
 
@@ -26,6 +26,7 @@
 #include "BKE_modifier.h"
 
 struct ModifierData;
+struct ModifierResultCache;
 
 namespace blender {
 namespace deg {
@@ -36,6 +37,7 @@ class ModifierDataBackup {
 
   ModifierType type;
   void *runtime;
+  ModifierResultCache *result_cache;
 };
 
 }  // namespace deg
@@ -64,7 +64,7 @@ void ObjectRuntimeBackup::init_from_object(Object *object)
 void ObjectRuntimeBackup::backup_modifier_runtime_data(Object *object)
 {
   LISTBASE_FOREACH (ModifierData *, modifier_data, &object->modifiers) {
-    if (modifier_data->runtime == nullptr) {
+    if (modifier_data->runtime == nullptr && modifier_data->result_cache == nullptr) {
       continue;
     }
 
@@ -74,6 +74,7 @@ void ObjectRuntimeBackup::backup_modifier_runtime_data(Object *object)
     BLI_assert(modifier_data->orig_modifier_data != nullptr);
     modifier_runtime_data.add(session_uuid, ModifierDataBackup(modifier_data));
     modifier_data->runtime = nullptr;
+    modifier_data->result_cache = nullptr;
   }
 }
 
@@ -153,13 +154,19 @@ void ObjectRuntimeBackup::restore_modifier_runtime_data(Object *object)
     optional<ModifierDataBackup> backup = modifier_runtime_data.pop_try(session_uuid);
     if (backup.has_value()) {
       modifier_data->runtime = backup->runtime;
+      modifier_data->result_cache = backup->result_cache;
     }
   }
 
   for (ModifierDataBackup &backup : modifier_runtime_data.values()) {
-    const ModifierTypeInfo *modifier_type_info = BKE_modifier_get_info(backup.type);
-    BLI_assert(modifier_type_info != nullptr);
-    modifier_type_info->freeRuntimeData(backup.runtime);
+    if (backup.runtime != nullptr) {
+      const ModifierTypeInfo *modifier_type_info = BKE_modifier_get_info(backup.type);
+      BLI_assert(modifier_type_info != nullptr);
+      modifier_type_info->freeRuntimeData(backup.runtime);
+    }
+    if (backup.result_cache != nullptr) {
+      BKE_modifier_result_cache_free_data(backup.result_cache);
+    }
   }
 }
 
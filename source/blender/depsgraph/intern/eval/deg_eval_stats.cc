@@ -54,4 +54,12 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_operation_cost_update(OperationNode *op_node, double time)
+{
+  /* Exponential moving average, recent evaluations matter most but a single slow evaluation
+   * (caches being rebuilt for example) should not dominate. */
+  const float factor = 0.3f;
+  op_node->evaluation_cost = op_node->evaluation_cost * (1.0f - factor) + (float)time * factor;
+}
+
 }  // namespace blender::deg
@@ -27,9 +27,16 @@ namespace blender {
 namespace deg {
 
 struct Depsgraph;
+struct OperationNode;
+
+/* Evaluation cost of operations which were never evaluated yet, in seconds. */
+#define DEG_EVAL_COST_DEFAULT 1e-5f
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Feed the measured evaluation time of the operation back into its cost estimate. */
+void deg_eval_stats_operation_cost_update(OperationNode *op_node, double time);
+
 }  // namespace deg
 }  // namespace blender
@@ -28,6 +28,7 @@
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.h"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_factory.h"
 #include "intern/node/deg_node_id.h"
@@ -209,7 +210,8 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0)
+OperationNode::OperationNode()
+    : evaluation_cost(DEG_EVAL_COST_DEFAULT), critical_path_cost(0.0f), name_tag(-1), flag(0)
 {
 }
 
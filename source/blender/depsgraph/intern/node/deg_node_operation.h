@@ -266,6 +266,12 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated evaluation time in seconds, averaged over previous evaluations. */
+  float evaluation_cost;
+  /* Estimated time from the start of this operation until all operations depending on it are
+   * evaluated. Operations on the longest chain are scheduled first. */
+  float critical_path_cost;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -176,6 +176,32 @@ void DRW_deferred_shader_remove(struct GPUMaterial *mat);
 struct DrawDataList *DRW_drawdatalist_from_id(struct ID *id);
 void DRW_drawdata_free(struct ID *id);
 
+/* draw_manager_profiling.c */
+typedef struct DRWStatsTimerInfo {
+  const char *name;
+  /** Nesting level, passes are inside the group of the engine drawing them. */
+  int level;
+  bool is_pass;
+  /** CPU start (relative to the beginning of the redraw) and duration in milliseconds. */
+  double cpu_start, cpu_time;
+  /** GPU duration in milliseconds, from the previous redraw. */
+  double gpu_time;
+  uint draw_call_len, state_change_len;
+} DRWStatsTimerInfo;
+
+typedef struct DRWStatsEngineInfo {
+  const char *name;
+  /** Averaged over several redraws, in milliseconds. */
+  double init_time, background_time, render_time;
+} DRWStatsEngineInfo;
+
+void DRW_stats_enable(bool enable);
+int DRW_stats_timer_len(void);
+void DRW_stats_timer_info_get(int index, DRWStatsTimerInfo *r_info);
+int DRW_stats_engine_len(void);
+void DRW_stats_engine_info_get(int index, DRWStatsEngineInfo *r_info);
+bool DRW_stats_trace_write(const char *filepath);
+
 #ifdef __cplusplus
 }
 #endif
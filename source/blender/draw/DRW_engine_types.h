@@ -35,6 +35,7 @@ typedef struct DefaultFramebufferList {
   struct GPUFrameBuffer *depth_only_fb;
   struct GPUFrameBuffer *overlay_only_fb;
   struct GPUFrameBuffer *stereo_comp_fb;
+  struct GPUFrameBuffer *overlay_cache_fb;
 } DefaultFramebufferList;
 
 typedef struct DefaultTextureList {
@@ -44,6 +45,10 @@ typedef struct DefaultTextureList {
   struct GPUTexture *color_overlay_stereo;
   struct GPUTexture *depth;
   struct GPUTexture *depth_in_front;
+  /* Copy of `color_overlay` and `depth` before editor overlays are drawn, see
+   * #GPU_viewport_overlay_cache_store. */
+  struct GPUTexture *color_overlay_cache;
+  struct GPUTexture *depth_cache;
 } DefaultTextureList;
 
 #ifdef __cplusplus
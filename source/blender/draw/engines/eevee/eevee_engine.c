@@ -26,6 +26,7 @@
 
 #include "BLI_rand.h"
 
+#include "BKE_image.h"
 #include "BKE_object.h"
 
 #include "DEG_depsgraph_query.h"
@@ -183,6 +184,13 @@ static void eevee_cache_finish(void *vedata)
     g_data->queued_shaders_count_prev = g_data->queued_shaders_count;
     EEVEE_temporal_sampling_reset(vedata);
   }
+
+  /* Same for the images loaded in the background. */
+  const int loading_images_count = BKE_image_gpu_load_pending_len();
+  if (loading_images_count != g_data->loading_images_count_prev) {
+    g_data->loading_images_count_prev = loading_images_count;
+    EEVEE_temporal_sampling_reset(vedata);
+  }
 }
 
 /* As renders in an HDR offscreen buffer, we need draw everything once
@@ -27,15 +27,26 @@
 #include "BKE_global.h"
 
 #include "BLI_endian_switch.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_threads.h"
 
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
+#include "BKE_customdata.h"
+#include "BKE_material.h"
+#include "BKE_node.h"
 #include "BKE_object.h"
 
 #include "DNA_collection_types.h"
+#include "DNA_genfile.h"
+#include "DNA_light_types.h"
 #include "DNA_lightprobe_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+#include "DNA_sdna_types.h"
+#include "DNA_world_types.h"
 
 #include "PIL_time.h"
 
@@ -151,6 +162,8 @@ typedef struct EEVEE_LightBake {
   int cube_offset;
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
+  /** Hash of the scene data each cube-map depends on, zero when it can't be known. */
+  uint32_t *cube_hash;
 
   /* Dummy Textures */
   struct GPUTexture *dummy_color, *dummy_depth;
@@ -509,6 +522,7 @@ void EEVEE_lightcache_free(LightCache *lcache)
 
   MEM_SAFE_FREE(lcache->cube_data);
   MEM_SAFE_FREE(lcache->grid_data);
+  MEM_SAFE_FREE(lcache->cube_hash);
   MEM_freeN(lcache);
 }
 
@@ -545,6 +559,9 @@ void EEVEE_lightcache_blend_write(BlendWriter *writer, LightCache *cache)
 
   BLO_write_struct_array(writer, LightGridCache, cache->grid_len, cache->grid_data);
   BLO_write_struct_array(writer, LightProbeCache, cache->cube_len, cache->cube_data);
+  if (cache->cube_hash) {
+    BLO_write_uint32_array(writer, cache->cube_len, cache->cube_hash);
+  }
 }
 
 static void direct_link_lightcache_texture(BlendDataReader *reader, LightCacheTexture *lctex)
@@ -586,6 +603,9 @@ void EEVEE_lightcache_blend_read_data(BlendDataReader *reader, LightCache *cache
 
   BLO_read_data_address(reader, &cache->cube_data);
   BLO_read_data_address(reader, &cache->grid_data);
+  if (cache->cube_hash) {
+    BLO_read_uint32_array(reader, cache->cube_len, &cache->cube_hash);
+  }
 }
 
 /** \} */
@@ -838,6 +858,7 @@ void EEVEE_lightbake_job_data_free(void *custom_data)
 
   MEM_SAFE_FREE(lbake->cube_prb);
   MEM_SAFE_FREE(lbake->grid_prb);
+  MEM_SAFE_FREE(lbake->cube_hash);
 
   BLI_mutex_free(lbake->mutex);
 
@@ -1325,6 +1346,330 @@ static void eevee_lightbake_gather_probes(EEVEE_LightBake *lbake)
   lbake->done = 0;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Incremental Cube-map Baking
+ *
+ * Each cube-map stores a hash of the data it was rendered from: the probe itself, the world,
+ * the lights and the objects that can be seen from the probe or that can shadow what it sees.
+ * Baking only the cube-maps skips the ones whose hash did not change since the last bake.
+ * Objects for which no reliable hash can be computed (non mesh geometry, hair, ...) make
+ * every probe they can influence render again.
+ * \{ */
+
+#define LIGHTBAKE_HASH_RANGE(mm2, ptr, first, last) \
+  BLI_hash_mm2a_add(mm2, \
+                    (const uchar *)&(ptr)->first, \
+                    (size_t)((const char *)&(ptr)->last - (const char *)&(ptr)->first) + \
+                        sizeof((ptr)->last))
+
+typedef struct LightBakeObjectKey {
+  uint32_t hash;
+  bool is_valid;
+  float min[3], max[3];
+} LightBakeObjectKey;
+
+typedef struct LightBakeShadowKey {
+  float co[3];
+  bool is_sun;
+} LightBakeShadowKey;
+
+static void lightbake_hash_str(BLI_HashMurmur2A *mm2, const char *str)
+{
+  const int len = (int)strlen(str);
+  BLI_hash_mm2a_add_int(mm2, len);
+  BLI_hash_mm2a_add(mm2, (const uchar *)str, (size_t)len);
+}
+
+static void lightbake_hash_id(BLI_HashMurmur2A *mm2, const ID *id)
+{
+  lightbake_hash_str(mm2, (id) ? id->name : "");
+}
+
+static void lightbake_hash_socket(BLI_HashMurmur2A *mm2, const bNodeSocket *sock)
+{
+  lightbake_hash_str(mm2, sock->identifier);
+  BLI_hash_mm2a_add_int(mm2, sock->flag & SOCK_UNAVAIL);
+
+  if (sock->default_value == NULL) {
+    return;
+  }
+  size_t size = 0;
+  switch (sock->type) {
+    case SOCK_FLOAT:
+      size = sizeof(bNodeSocketValueFloat);
+      break;
+    case SOCK_INT:
+      size = sizeof(bNodeSocketValueInt);
+      break;
+    case SOCK_BOOLEAN:
+      size = sizeof(bNodeSocketValueBoolean);
+      break;
+    case SOCK_VECTOR:
+      size = sizeof(bNodeSocketValueVector);
+      break;
+    case SOCK_RGBA:
+      size = sizeof(bNodeSocketValueRGBA);
+      break;
+    case SOCK_STRING:
+      size = sizeof(bNodeSocketValueString);
+      break;
+  }
+  BLI_hash_mm2a_add(mm2, (const uchar *)sock->default_value, size);
+}
+
+static void lightbake_hash_ntree(BLI_HashMurmur2A *mm2, const bNodeTree *ntree)
+{
+  const SDNA *sdna = DNA_sdna_current_get();
+
+  LISTBASE_FOREACH (const bNode *, node, &ntree->nodes) {
+    lightbake_hash_str(mm2, node->idname);
+    lightbake_hash_str(mm2, node->name);
+    BLI_hash_mm2a_add_int(mm2, node->flag & NODE_MUTED);
+    BLI_hash_mm2a_add_int(mm2, node->custom1);
+    BLI_hash_mm2a_add_int(mm2, node->custom2);
+    BLI_hash_mm2a_add(mm2, (const uchar *)&node->custom3, sizeof(node->custom3));
+    BLI_hash_mm2a_add(mm2, (const uchar *)&node->custom4, sizeof(node->custom4));
+
+    if (node->storage && node->typeinfo && node->typeinfo->storagename[0]) {
+      const int struct_nr = DNA_struct_find_nr(sdna, node->typeinfo->storagename);
+      if (struct_nr != -1) {
+        const int type = sdna->structs[struct_nr]->type;
+        BLI_hash_mm2a_add(mm2, (const uchar *)node->storage, (size_t)sdna->types_size[type]);
+      }
+    }
+
+    lightbake_hash_id(mm2, node->id);
+    if (node->id && GS(node->id->name) == ID_NT) {
+      lightbake_hash_ntree(mm2, (const bNodeTree *)node->id);
+    }
+
+    LISTBASE_FOREACH (const bNodeSocket *, sock, &node->inputs) {
+      lightbake_hash_socket(mm2, sock);
+    }
+  }
+
+  LISTBASE_FOREACH (const bNodeLink *, link, &ntree->links) {
+    lightbake_hash_str(mm2, link->fromnode->name);
+    lightbake_hash_str(mm2, link->fromsock->identifier);
+    lightbake_hash_str(mm2, link->tonode->name);
+    lightbake_hash_str(mm2, link->tosock->identifier);
+  }
+}
+
+static void lightbake_hash_material(BLI_HashMurmur2A *mm2, const Material *ma)
+{
+  lightbake_hash_id(mm2, (const ID *)ma);
+  if (ma == NULL) {
+    return;
+  }
+  LIGHTBAKE_HASH_RANGE(mm2, ma, r, metallic);
+  LIGHTBAKE_HASH_RANGE(mm2, ma, alpha_threshold, blend_flag);
+  BLI_hash_mm2a_add_int(mm2, ma->use_nodes);
+  if (ma->use_nodes && ma->nodetree) {
+    lightbake_hash_ntree(mm2, ma->nodetree);
+  }
+}
+
+static void lightbake_hash_world(BLI_HashMurmur2A *mm2, const World *wo)
+{
+  lightbake_hash_id(mm2, (const ID *)wo);
+  if (wo == NULL) {
+    return;
+  }
+  LIGHTBAKE_HASH_RANGE(mm2, wo, horr, horb);
+  BLI_hash_mm2a_add_int(mm2, wo->use_nodes);
+  if (wo->use_nodes && wo->nodetree) {
+    lightbake_hash_ntree(mm2, wo->nodetree);
+  }
+}
+
+static void lightbake_hash_light(BLI_HashMurmur2A *mm2, Object *ob)
+{
+  const Light *la = (const Light *)ob->data;
+  BLI_hash_mm2a_add(mm2, (const uchar *)ob->obmat, sizeof(ob->obmat));
+  BLI_hash_mm2a_add(mm2, (const uchar *)ob->scale, sizeof(ob->scale));
+  LIGHTBAKE_HASH_RANGE(mm2, la, type, coeff_quad);
+  LIGHTBAKE_HASH_RANGE(mm2, la, clipsta, sun_angle);
+  LIGHTBAKE_HASH_RANGE(mm2, la, cascade_max_dist, att_dist);
+}
+
+static bool lightbake_hash_mesh(BLI_HashMurmur2A *mm2, const Mesh *me)
+{
+  BLI_hash_mm2a_add_int(mm2, me->totvert);
+  BLI_hash_mm2a_add_int(mm2, me->totedge);
+  BLI_hash_mm2a_add_int(mm2, me->totloop);
+  BLI_hash_mm2a_add_int(mm2, me->totpoly);
+  BLI_hash_mm2a_add_int(mm2, me->flag);
+  BLI_hash_mm2a_add(mm2, (const uchar *)&me->smoothresh, sizeof(me->smoothresh));
+
+  return CustomData_hash_mm2a(&me->vdata, me->totvert, mm2) &&
+         CustomData_hash_mm2a(&me->edata, me->totedge, mm2) &&
+         CustomData_hash_mm2a(&me->ldata, me->totloop, mm2) &&
+         CustomData_hash_mm2a(&me->pdata, me->totpoly, mm2);
+}
+
+static void lightbake_object_key_compute(Object *ob, LightBakeObjectKey *key)
+{
+  BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb != NULL) {
+    INIT_MINMAX(key->min, key->max);
+    for (int i = 0; i < 8; i++) {
+      float co[3];
+      mul_v3_m4v3(co, ob->obmat, bb->vec[i]);
+      minmax_v3v3_v3(key->min, key->max, co);
+    }
+  }
+  else {
+    copy_v3_fl(key->min, -FLT_MAX);
+    copy_v3_fl(key->max, FLT_MAX);
+  }
+
+  const Mesh *me = (ob->type == OB_MESH) ? BKE_object_get_evaluated_mesh(ob) : NULL;
+  if (me == NULL || bb == NULL || !BLI_listbase_is_empty(&ob->particlesystem)) {
+    key->is_valid = false;
+    return;
+  }
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  lightbake_hash_id(&mm2, &ob->id);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)ob->obmat, sizeof(ob->obmat));
+  BLI_hash_mm2a_add(&mm2, (const uchar *)ob->color, sizeof(ob->color));
+  BLI_hash_mm2a_add_int(&mm2, ob->base_flag & (BASE_HOLDOUT | BASE_INDIRECT_ONLY));
+  BLI_hash_mm2a_add_int(&mm2, ob->dt);
+  BLI_hash_mm2a_add_int(&mm2, ob->totcol);
+  for (int i = 0; i < ob->totcol; i++) {
+    lightbake_hash_material(&mm2, BKE_object_material_get(ob, i + 1));
+  }
+
+  key->is_valid = lightbake_hash_mesh(&mm2, me);
+  key->hash = BLI_hash_mm2a_end(&mm2);
+}
+
+static bool lightbake_object_affects_cube(const LightBakeObjectKey *key,
+                                          const LightBakeShadowKey *shadows,
+                                          const int shadows_len,
+                                          const float cube_min[3],
+                                          const float cube_max[3])
+{
+  if (isect_aabb_aabb_v3(key->min, key->max, cube_min, cube_max)) {
+    return true;
+  }
+  /* Objects out of the probe range can still shadow what the probe sees. */
+  for (int i = 0; i < shadows_len; i++) {
+    if (shadows[i].is_sun) {
+      return true;
+    }
+    float shadow_min[3], shadow_max[3];
+    copy_v3_v3(shadow_min, cube_min);
+    copy_v3_v3(shadow_max, cube_max);
+    minmax_v3v3_v3(shadow_min, shadow_max, shadows[i].co);
+    if (isect_aabb_aabb_v3(key->min, key->max, shadow_min, shadow_max)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Must be called after #eevee_lightbake_gather_probes and before any rendering, as baking
+ * modifies the evaluated scene settings. */
+static void eevee_lightbake_cube_hashes_compute(EEVEE_LightBake *lbake)
+{
+  Depsgraph *depsgraph = lbake->depsgraph;
+  Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
+  LightCache *lcache = scene_eval->eevee.light_cache_data;
+
+  lbake->cube_hash = MEM_callocN(sizeof(*lbake->cube_hash) * lbake->cube_len, __func__);
+
+  int objects_len = 0, objects_alloc = 64;
+  int shadows_len = 0, shadows_alloc = 8;
+  LightBakeObjectKey *objects = MEM_mallocN(sizeof(*objects) * objects_alloc, __func__);
+  LightBakeShadowKey *shadows = MEM_mallocN(sizeof(*shadows) * shadows_alloc, __func__);
+
+  /* Data every cube-map depends on. */
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  SceneEEVEE eevee = scene_eval->eevee;
+  eevee.light_cache_data = NULL;
+  eevee.light_cache_info[0] = '\0';
+  eevee.gi_cubemap_draw_size = eevee.gi_irradiance_draw_size = 0.0f;
+  BLI_hash_mm2a_add(&mm2, (const uchar *)&eevee, sizeof(eevee));
+  lightbake_hash_world(&mm2, scene_eval->world);
+
+  DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
+    const int ob_visibility = BKE_object_visibility(ob, DAG_EVAL_RENDER);
+    if ((ob_visibility & OB_VISIBLE_SELF) == 0) {
+      continue;
+    }
+
+    switch (ob->type) {
+      case OB_LAMP: {
+        const Light *la = (const Light *)ob->data;
+        lightbake_hash_light(&mm2, ob);
+        if (la->mode & LA_SHADOW) {
+          if (shadows_len == shadows_alloc) {
+            shadows_alloc *= 2;
+            shadows = MEM_reallocN(shadows, sizeof(*shadows) * shadows_alloc);
+          }
+          copy_v3_v3(shadows[shadows_len].co, ob->obmat[3]);
+          shadows[shadows_len++].is_sun = (la->type == LA_SUN);
+        }
+        break;
+      }
+      case OB_LIGHTPROBE:
+      case OB_EMPTY:
+      case OB_CAMERA:
+      case OB_ARMATURE:
+      case OB_LATTICE:
+      case OB_SPEAKER:
+        break;
+      default:
+        if (objects_len == objects_alloc) {
+          objects_alloc *= 2;
+          objects = MEM_reallocN(objects, sizeof(*objects) * objects_alloc);
+        }
+        lightbake_object_key_compute(ob, &objects[objects_len++]);
+        break;
+    }
+  }
+  DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+
+  const uint32_t scene_hash = BLI_hash_mm2a_end(&mm2);
+
+  /* Bypass world, start at 1. */
+  for (int i = 1; i < lbake->cube_len; i++) {
+    const EEVEE_LightProbe *eprobe = &lcache->cube_data[i];
+    const LightProbe *prb = lbake->cube_prb[i];
+    float cube_min[3], cube_max[3];
+    copy_v3_v3(cube_min, eprobe->position);
+    copy_v3_v3(cube_max, eprobe->position);
+    add_v3_fl(cube_min, -prb->clipend);
+    add_v3_fl(cube_max, prb->clipend);
+
+    BLI_hash_mm2a_init(&mm2, scene_hash);
+    BLI_hash_mm2a_add(&mm2, (const uchar *)eprobe, sizeof(*eprobe));
+    LIGHTBAKE_HASH_RANGE(&mm2, prb, distinf, clipend);
+    BLI_hash_mm2a_add(&mm2, (const uchar *)&prb->intensity, sizeof(prb->intensity));
+    BLI_hash_mm2a_add_int(&mm2, prb->flag & LIGHTPROBE_FLAG_INVERT_GROUP);
+    lightbake_hash_id(&mm2, (const ID *)prb->visibility_grp);
+
+    bool is_valid = true;
+    for (int j = 0; j < objects_len && is_valid; j++) {
+      const LightBakeObjectKey *key = &objects[j];
+      if (lightbake_object_affects_cube(key, shadows, shadows_len, cube_min, cube_max)) {
+        BLI_hash_mm2a_add_int(&mm2, (int)key->hash);
+        is_valid = key->is_valid;
+      }
+    }
+    lbake->cube_hash[i] = (is_valid) ? BLI_hash_mm2a_end(&mm2) : 0;
+  }
+
+  MEM_freeN(objects);
+  MEM_freeN(shadows);
+}
+
+/** \} */
+
 void EEVEE_lightbake_update(void *custom_data)
 {
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)custom_data;
@@ -1406,9 +1751,18 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
 
   /* Gather all probes data */
   eevee_lightbake_gather_probes(lbake);
+  eevee_lightbake_cube_hashes_compute(lbake);
 
   LightCache *lcache = lbake->lcache;
 
+  /* Cube-maps capture the world and the irradiance grids, none can be kept if those change. */
+  const bool cube_incremental = (lcache->cube_hash != NULL) &&
+                                (lcache->flag &
+                                 (LIGHTCACHE_UPDATE_WORLD | LIGHTCACHE_UPDATE_GRID)) == 0;
+  if (lcache->cube_hash == NULL) {
+    lcache->cube_hash = MEM_callocN(sizeof(*lcache->cube_hash) * lbake->cube_len, __func__);
+  }
+
   /* HACK: Sleep to delay the first rendering operation
    * that causes a small freeze (caused by VBO generation)
    * because this step is locking at this moment. */
@@ -1449,7 +1803,20 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      const uint32_t hash = lbake->cube_hash[lbake->cube_offset];
+      if (cube_incremental && hash != 0 && hash == lcache->cube_hash[lbake->cube_offset]) {
+        /* The cube-map layer still contains the result of a previous bake. */
+        lcache->cube_len += 1;
+        if (lbake->cube_offset == lbake->cube_len - 1) {
+          lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+        }
+        lbake->done += 1;
+        *lbake->progress = lbake->done / (float)lbake->total;
+        continue;
+      }
+      if (lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample)) {
+        lcache->cube_hash[lbake->cube_offset] = hash;
+      }
     }
   }
 
@@ -60,12 +60,15 @@ typedef struct EeveeMaterialCache {
   struct DRWShadingGroup *depth_grp;
   struct DRWShadingGroup *shading_grp;
   struct DRWShadingGroup *shadow_grp;
+  /* Same as shadow_grp but in the dynamic shadow pass, only created on demand. */
+  struct DRWShadingGroup *shadow_dynamic_grp;
   struct GPUMaterial *shading_gpumat;
   /* Meh, Used by hair to ensure draw order when calling DRW_shgroup_create_sub.
    * Pointers to ghash values. */
   struct DRWShadingGroup **depth_grp_p;
   struct DRWShadingGroup **shading_grp_p;
   struct DRWShadingGroup **shadow_grp_p;
+  struct DRWShadingGroup **shadow_dynamic_grp_p;
 } EeveeMaterialCache;
 
 /* *********** FUNCTIONS *********** */
@@ -411,6 +414,7 @@ BLI_INLINE void material_shadow(EEVEE_Data *vedata,
                                 EEVEE_ViewLayerData *sldata,
                                 Material *ma,
                                 bool is_hair,
+                                bool is_dynamic,
                                 EeveeMaterialCache *emc)
 {
   EEVEE_PrivateData *pd = vedata->stl->g_data;
@@ -432,6 +436,8 @@ BLI_INLINE void material_shadow(EEVEE_Data *vedata,
     /* Avoid possible confusion with depth pre-pass options. */
     int option = KEY_SHADOW;
     SET_FLAG_FROM_TEST(option, is_hair, KEY_HAIR);
+    SET_FLAG_FROM_TEST(option, is_dynamic, KEY_SHADOW_DYNAMIC);
+    DRWPass *pass = (is_dynamic) ? psl->shadow_dynamic_pass : psl->shadow_pass;
 
     /* Search for the same shaders usage in the pass. */
     struct GPUShader *sh = GPU_material_get_shader(gpumat);
@@ -444,25 +450,47 @@ BLI_INLINE void material_shadow(EEVEE_Data *vedata,
       grp = DRW_shgroup_create_sub(*grp_p);
     }
     else {
-      *grp_p = grp = DRW_shgroup_create(sh, psl->shadow_pass);
+      *grp_p = grp = DRW_shgroup_create(sh, pass);
       EEVEE_material_bind_resources(grp, gpumat, sldata, vedata, NULL, NULL, false, false);
     }
 
     DRW_shgroup_add_material_resources(grp, gpumat);
 
-    emc->shadow_grp = grp;
-    emc->shadow_grp_p = grp_p;
+    if (is_dynamic) {
+      emc->shadow_dynamic_grp = grp;
+      emc->shadow_dynamic_grp_p = grp_p;
+    }
+    else {
+      emc->shadow_grp = grp;
+      emc->shadow_grp_p = grp_p;
+    }
   }
-  else {
-    emc->shadow_grp = NULL;
-    emc->shadow_grp_p = NULL;
+}
+
+/* Use the shadow shading group of the pass the object is drawn in. */
+BLI_INLINE EeveeMaterialCache material_shadow_select(EEVEE_Data *vedata,
+                                                     EEVEE_ViewLayerData *sldata,
+                                                     Material *ma,
+                                                     bool is_hair,
+                                                     bool is_dynamic,
+                                                     EeveeMaterialCache *emc)
+{
+  if (is_dynamic && emc->shadow_dynamic_grp == NULL) {
+    material_shadow(vedata, sldata, ma, is_hair, true, emc);
+  }
+  EeveeMaterialCache matcache = *emc;
+  if (is_dynamic) {
+    matcache.shadow_grp = emc->shadow_dynamic_grp;
+    matcache.shadow_grp_p = emc->shadow_dynamic_grp_p;
   }
+  return matcache;
 }
 
 static EeveeMaterialCache material_opaque(EEVEE_Data *vedata,
                                           EEVEE_ViewLayerData *sldata,
                                           Material *ma,
-                                          const bool is_hair)
+                                          const bool is_hair,
+                                          const bool is_dynamic_shadow)
 {
   EEVEE_EffectsInfo *effects = vedata->stl->effects;
   EEVEE_PrivateData *pd = vedata->stl->g_data;
@@ -482,12 +510,13 @@ static EeveeMaterialCache material_opaque(EEVEE_Data *vedata,
   /* Search for other material instances (sharing the same Material data-block). */
   EeveeMaterialCache **emc_p, *emc;
   if (BLI_ghash_ensure_p(pd->material_hash, key, (void ***)&emc_p)) {
-    return **emc_p;
+    return material_shadow_select(vedata, sldata, ma, is_hair, is_dynamic_shadow, *emc_p);
   }
 
   *emc_p = emc = BLI_memblock_alloc(sldata->material_cache);
+  memset(emc, 0, sizeof(*emc));
 
-  material_shadow(vedata, sldata, ma, is_hair, emc);
+  material_shadow(vedata, sldata, ma, is_hair, false, emc);
 
   {
     /* Depth Pass */
@@ -580,12 +609,13 @@ static EeveeMaterialCache material_opaque(EEVEE_Data *vedata,
     emc->shading_grp_p = grp_p;
     emc->shading_gpumat = gpumat;
   }
-  return *emc;
+  return material_shadow_select(vedata, sldata, ma, is_hair, is_dynamic_shadow, emc);
 }
 
 static EeveeMaterialCache material_transparent(EEVEE_Data *vedata,
                                                EEVEE_ViewLayerData *sldata,
-                                               Material *ma)
+                                               Material *ma,
+                                               const bool is_dynamic_shadow)
 {
   const DRWContextState *draw_ctx = DRW_context_state_get();
   Scene *scene = draw_ctx->scene;
@@ -604,7 +634,11 @@ static EeveeMaterialCache material_transparent(EEVEE_Data *vedata,
                         DRW_STATE_DEPTH_LESS_EQUAL | DRW_STATE_DEPTH_EQUAL |
                         DRW_STATE_BLEND_CUSTOM);
 
-  material_shadow(vedata, sldata, ma, false, &emc);
+  material_shadow(vedata, sldata, ma, false, is_dynamic_shadow, &emc);
+  if (is_dynamic_shadow) {
+    emc.shadow_grp = emc.shadow_dynamic_grp;
+    emc.shadow_grp_p = emc.shadow_dynamic_grp_p;
+  }
 
   if (use_prepass) {
     /* Depth prepass */
@@ -675,12 +709,13 @@ BLI_INLINE EeveeMaterialCache eevee_material_cache_get(
     EEVEE_Data *vedata, EEVEE_ViewLayerData *sldata, Object *ob, int slot, bool is_hair)
 {
   const bool holdout = (ob->base_flag & BASE_HOLDOUT) != 0;
+  const bool is_dynamic_shadow = EEVEE_shadows_caster_is_dynamic(ob);
   EeveeMaterialCache matcache;
   Material *ma = eevee_object_material_get(ob, slot, holdout);
   switch (ma->blend_method) {
     case MA_BM_BLEND:
       if (!is_hair) {
-        matcache = material_transparent(vedata, sldata, ma);
+        matcache = material_transparent(vedata, sldata, ma, is_dynamic_shadow);
         break;
       }
       ATTR_FALLTHROUGH;
@@ -688,7 +723,7 @@ BLI_INLINE EeveeMaterialCache eevee_material_cache_get(
     case MA_BM_CLIP:
     case MA_BM_HASHED:
     default:
-      matcache = material_opaque(vedata, sldata, ma, is_hair);
+      matcache = material_opaque(vedata, sldata, ma, is_hair, is_dynamic_shadow);
       break;
   }
   return matcache;
@@ -192,6 +192,7 @@ enum {
   KEY_REFRACT = (1 << 1),
   KEY_HAIR = (1 << 2),
   KEY_SHADOW = (1 << 3),
+  KEY_SHADOW_DYNAMIC = (1 << 4),
 };
 
 /* SSR shader variations */
@@ -230,6 +231,8 @@ typedef struct EEVEE_BoundBox {
 typedef struct EEVEE_PassList {
   /* Shadows */
   struct DRWPass *shadow_pass;
+  /* Shadow casters that changed since last redraw, drawn on top of the static ones. */
+  struct DRWPass *shadow_dynamic_pass;
   struct DRWPass *shadow_accum_pass;
 
   /* Probes */
@@ -491,6 +494,8 @@ BLI_STATIC_ASSERT(sizeof(EEVEE_Shadow) * MAX_SHADOW +
 typedef struct EEVEE_ShadowCasterBuffer {
   struct EEVEE_BoundBox *bbox;
   BLI_bitmap *update;
+  /* Caster was added, removed or moved in/out of the cached static shadow maps. */
+  BLI_bitmap *static_update;
   uint alloc_count;
   uint count;
 } EEVEE_ShadowCasterBuffer;
@@ -515,6 +520,7 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  BLI_bitmap sh_cube_static_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds  */
   /* List of bbox and update bitmap. Double buffered. */
@@ -838,8 +844,11 @@ typedef struct EEVEE_ViewLayerData {
   struct GPUUniformBuf *shadow_samples_ubo;
 
   struct GPUFrameBuffer *shadow_fb;
+  struct GPUFrameBuffer *shadow_static_fb;
 
   struct GPUTexture *shadow_cube_pool;
+  /* Depth of the static shadow casters only, copied to the pool before drawing dynamic ones. */
+  struct GPUTexture *shadow_cube_static_pool;
   struct GPUTexture *shadow_cascade_pool;
 
   struct EEVEE_ShadowCasterBuffer shcasters_buffers[2];
@@ -897,6 +906,8 @@ typedef struct EEVEE_ObjectEngineData {
 
   bool need_update;
   bool geom_update;
+  /* Was drawn in the dynamic shadow pass during the last redraw. */
+  bool shadow_dynamic;
   uint shadow_caster_id;
 } EEVEE_ObjectEngineData;
 
@@ -947,6 +958,7 @@ typedef struct EEVEE_PrivateData {
   /* Compiling shaders count. This is to track if a shader has finished compiling. */
   int queued_shaders_count;
   int queued_shaders_count_prev;
+  int loading_images_count_prev;
 
   /* LookDev Settings */
   int studiolight_index;
@@ -1049,6 +1061,7 @@ void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh);
 void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata);
 void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, struct Object *ob);
+bool EEVEE_shadows_caster_is_dynamic(struct Object *ob);
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli, int sample_ofs);
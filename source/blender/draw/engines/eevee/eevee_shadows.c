@@ -56,6 +56,8 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       sldata->shcasters_buffers[i].bbox = MEM_callocN(
           sizeof(EEVEE_BoundBox) * SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
+      sldata->shcasters_buffers[i].static_update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK,
+                                                                  __func__);
       sldata->shcasters_buffers[i].alloc_count = SH_CASTER_ALLOC_CHUNK;
       sldata->shcasters_buffers[i].count = 0;
     }
@@ -78,6 +80,7 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       (linfo->shadow_high_bitdepth != sh_high_bitdepth)) {
     BLI_assert((sh_cube_size > 0) && (sh_cube_size <= 4096));
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     CLAMP(sh_cube_size, 1, 4096);
   }
 
@@ -107,10 +110,16 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   linfo->num_cascade_layer = 0;
   linfo->cube_len = linfo->cascade_len = linfo->shadow_len = 0;
 
-  /* Shadow Casters: Reset flags. */
+  /* Shadow Casters: Reset flags.
+   * The update bits of the backbuffer still tell which casters were dynamic.
+   * Removed static casters are in the cached static shadow maps. */
+  for (int i = 0; i < backbuffer->count; i++) {
+    BLI_BITMAP_SET(backbuffer->static_update, i, !BLI_BITMAP_TEST(backbuffer->update, i));
+  }
   BLI_bitmap_set_all(backbuffer->update, true, backbuffer->alloc_count);
   /* Is this one needed? */
   BLI_bitmap_set_all(frontbuffer->update, false, frontbuffer->alloc_count);
+  BLI_bitmap_set_all(frontbuffer->static_update, false, frontbuffer->alloc_count);
 
   INIT_MINMAX(linfo->shcaster_aabb.min, linfo->shcaster_aabb.max);
 
@@ -120,7 +129,23 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
     stl->g_data->shadow_shgrp = DRW_shgroup_create(EEVEE_shaders_shadow_sh_get(),
                                                    psl->shadow_pass);
+
+    DRW_PASS_CREATE(psl->shadow_dynamic_pass, state);
+  }
+}
+
+/**
+ * Casters updated since the last redraw are drawn in #EEVEE_PassList.shadow_dynamic_pass,
+ * so that moving a few objects does not redraw every other caster in the cube shadow maps.
+ */
+bool EEVEE_shadows_caster_is_dynamic(Object *ob)
+{
+  if (ob->base_flag & BASE_FROM_DUPLI) {
+    /* Duplis always refresh the shadow-maps, see #EEVEE_shadows_caster_register. */
+    return true;
   }
+  EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
+  return oedata->need_update;
 }
 
 /* Make that object update shadow casting lights inside its influence bounding box. */
@@ -138,6 +163,7 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->static_update, frontbuffer->alloc_count);
   }
 
   if (ob->base_flag & BASE_FROM_DUPLI) {
@@ -149,12 +175,24 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
     int past_id = oedata->shadow_caster_id;
     oedata->shadow_caster_id = id;
+    const bool was_dynamic = oedata->shadow_dynamic;
     /* Update flags in backbuffer. */
     if (past_id > -1 && past_id < backbuffer->count) {
       BLI_BITMAP_SET(backbuffer->update, past_id, oedata->need_update);
+      /* Remove the caster from the static shadow-maps at its previous location. */
+      BLI_BITMAP_SET(backbuffer->static_update, past_id, oedata->need_update && !was_dynamic);
+    }
+    else {
+      BLI_BITMAP_ENABLE(frontbuffer->static_update, id);
     }
     update = oedata->need_update;
     oedata->need_update = false;
+    oedata->shadow_dynamic = update;
+
+    if (!update && was_dynamic) {
+      /* Stopped moving, draw it in the static shadow-maps again. */
+      BLI_BITMAP_ENABLE(frontbuffer->static_update, id);
+    }
   }
 
   if (update) {
@@ -199,6 +237,30 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+/* Tag the cube shadows inside the radius of the updated casters. */
+static void shadow_cube_casters_tag_update(EEVEE_LightsInfo *linfo,
+                                           const EEVEE_ShadowCasterBuffer *buffer)
+{
+  const BoundSphere *bsphere = linfo->shadow_bounds;
+  for (int i = 0; i < buffer->count; i++) {
+    /* If the shadowcaster has been deleted or updated. */
+    const bool update_static = BLI_BITMAP_TEST(buffer->static_update, i);
+    if (!update_static && !BLI_BITMAP_TEST(buffer->update, i)) {
+      continue;
+    }
+    for (int j = 0; j < linfo->cube_len; j++) {
+      const bool tagged = BLI_BITMAP_TEST(linfo->sh_cube_update, j) &&
+                          (!update_static || BLI_BITMAP_TEST(linfo->sh_cube_static_update, j));
+      if (!tagged && sphere_bbox_intersect(&bsphere[j], &buffer->bbox[i])) {
+        BLI_BITMAP_ENABLE(linfo->sh_cube_update, j);
+        if (update_static) {
+          BLI_BITMAP_ENABLE(linfo->sh_cube_static_update, j);
+        }
+      }
+    }
+  }
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
@@ -213,6 +275,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* Free textures if number mismatch. */
   if (linfo->num_cube_layer != linfo->cache_num_cube_layer) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
     /* Update all lights. */
     BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
@@ -232,6 +295,18 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                            NULL);
   }
 
+  if (!sldata->shadow_cube_static_pool) {
+    sldata->shadow_cube_static_pool = DRW_texture_create_2d_array(
+        linfo->shadow_cube_size,
+        linfo->shadow_cube_size,
+        max_ii(1, linfo->num_cube_layer * 6),
+        shadow_pool_format,
+        0,
+        NULL);
+    BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_SHADOW_CUBE);
+    BLI_bitmap_set_all(&linfo->sh_cube_static_update[0], true, MAX_SHADOW_CUBE);
+  }
+
   if (!sldata->shadow_cascade_pool) {
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
@@ -244,6 +319,9 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   if (sldata->shadow_fb == NULL) {
     sldata->shadow_fb = GPU_framebuffer_create("shadow_fb");
   }
+  if (sldata->shadow_static_fb == NULL) {
+    sldata->shadow_static_fb = GPU_framebuffer_create("shadow_static_fb");
+  }
 
   /* Gather all light own update bits. to avoid costly intersection check.  */
   for (int j = 0; j < linfo->cube_len; j++) {
@@ -251,39 +329,15 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     /* Setup shadow cube in UBO and tag for update if necessary. */
     if (EEVEE_shadows_cube_setup(linfo, evli, effects->taa_current_sample - 1)) {
       BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], j);
     }
   }
 
   /* TODO(fclem): This part can be slow, optimize it. */
-  EEVEE_BoundBox *bbox = backbuffer->bbox;
-  BoundSphere *bsphere = linfo->shadow_bounds;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
-  for (int i = 0; i < backbuffer->count; i++) {
-    /* If the shadowcaster has been deleted or updated. */
-    if (BLI_BITMAP_TEST(backbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
-    }
-  }
+  shadow_cube_casters_tag_update(linfo, backbuffer);
   /* Search for updates in current shadow casters. */
-  bbox = frontbuffer->bbox;
-  for (int i = 0; i < frontbuffer->count; i++) {
-    /* If the shadowcaster has been updated. */
-    if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
-    }
-  }
+  shadow_cube_casters_tag_update(linfo, frontbuffer);
 
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
@@ -295,6 +349,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->static_update, frontbuffer->alloc_count);
   }
 }
 
@@ -433,5 +433,6 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
     GPU_framebuffer_bind(sldata->shadow_fb);
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
+    DRW_draw_pass(psl->shadow_dynamic_pass);
   }
 }
@@ -44,6 +44,7 @@ void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, Object *
 
   if (update) {
     BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], linfo->cube_len);
+    BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], linfo->cube_len);
   }
 
   sh_data->near = max_ff(la->clipsta, 1e-8f);
@@ -188,6 +189,7 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[cube_index];
   EEVEE_Shadow *shdw_data = linfo->shadow_data + (int)evli->shadow_id;
   EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + (int)shdw_data->type_data_id;
+  const bool update_static = BLI_BITMAP_TEST(linfo->sh_cube_static_update, cube_index);
 
   eevee_ensure_cube_views(shdw_data->near,
                           shdw_data->far,
@@ -215,11 +217,20 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
 
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = cube_index * 6 + j;
+    GPU_framebuffer_texture_layer_attach(
+        sldata->shadow_static_fb, sldata->shadow_cube_static_pool, 0, layer, 0);
+    if (update_static) {
+      GPU_framebuffer_bind(sldata->shadow_static_fb);
+      GPU_framebuffer_clear_depth(sldata->shadow_static_fb, 1.0f);
+      DRW_draw_pass(psl->shadow_pass);
+    }
+    /* Start from the cached static casters and only draw the dynamic ones on top. */
     GPU_framebuffer_texture_layer_attach(sldata->shadow_fb, sldata->shadow_cube_pool, 0, layer, 0);
+    GPU_framebuffer_blit(sldata->shadow_static_fb, 0, sldata->shadow_fb, 0, GPU_DEPTH_BIT);
     GPU_framebuffer_bind(sldata->shadow_fb);
-    GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
-    DRW_draw_pass(psl->shadow_pass);
+    DRW_draw_pass(psl->shadow_dynamic_pass);
   }
 
   BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  BLI_BITMAP_SET(&linfo->sh_cube_static_update[0], cube_index, false);
 }
@@ -31,6 +31,8 @@
  * to the scene buffer. We softly blend between SMAA and TAA to avoid really harsh transitions.
  */
 
+#include "BKE_image.h"
+
 #include "ED_screen.h"
 
 #include "BLI_jitter_2d.h"
@@ -182,6 +184,12 @@ void workbench_antialiasing_engine_init(WORKBENCH_Data *vedata)
     wpd->taa_sample_len_previous = wpd->taa_sample_len;
   }
 
+  const int loading_images_len = BKE_image_gpu_load_pending_len();
+  if (loading_images_len != wpd->loading_images_len_previous) {
+    wpd->taa_sample = 0;
+    wpd->loading_images_len_previous = loading_images_len;
+  }
+
   if (wpd->view_updated) {
     wpd->taa_sample = 0;
     wpd->view_updated = false;
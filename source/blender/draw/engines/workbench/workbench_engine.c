@@ -420,6 +420,7 @@ void workbench_cache_finish(void *ved)
   WORKBENCH_Data *vedata = ved;
   WORKBENCH_StorageList *stl = vedata->stl;
   WORKBENCH_FramebufferList *fbl = vedata->fbl;
+  WORKBENCH_PassList *psl = vedata->psl;
   WORKBENCH_PrivateData *wpd = stl->wpd;
 
   /* TODO(fclem): Only do this when really needed. */
@@ -465,6 +466,13 @@ void workbench_cache_finish(void *ved)
 
   workbench_update_material_ubos(wpd);
 
+  /* Objects sharing the same mesh (linked duplicates) can then be drawn using instancing. These
+   * passes are order independent, with depth test or weighted blended transparency. */
+  DRW_pass_sort_calls_by_batch(psl->opaque_ps);
+  DRW_pass_sort_calls_by_batch(psl->opaque_infront_ps);
+  DRW_pass_sort_calls_by_batch(psl->transp_accum_ps);
+  DRW_pass_sort_calls_by_batch(psl->transp_accum_infront_ps);
+
   /* TODO don't free reuse next redraw. */
   for (int i = 0; i < 2; i++) {
     for (int j = 0; j < 2; j++) {
@@ -265,7 +265,7 @@ DRWShadingGroup *workbench_image_setup_ex(WORKBENCH_PrivateData *wpd,
       tex_tile_data = BKE_image_get_gpu_tilemap(ima, iuser, NULL);
     }
     else {
-      tex = BKE_image_get_gpu_texture(ima, iuser, NULL);
+      tex = DRW_image_gpu_texture_get(ima, iuser);
     }
   }
 
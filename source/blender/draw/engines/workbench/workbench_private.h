@@ -283,6 +283,8 @@ typedef struct WORKBENCH_PrivateData {
   int taa_sample_len;
   /** Total number of samples of the previous TAA. When changed TAA will be reset. */
   int taa_sample_len_previous;
+  /** Restart the TAA when images finished loading in the background. */
+  int loading_images_len_previous;
   /** Current TAA sample index in [0..taa_sample_len[ range. */
   int taa_sample;
   /** Inverse of taa_sample to divide the accumulation buffer. */
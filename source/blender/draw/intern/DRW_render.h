@@ -69,6 +69,8 @@ struct GPUMaterial;
 struct GPUShader;
 struct GPUTexture;
 struct GPUUniformBuf;
+struct Image;
+struct ImageUser;
 struct Object;
 struct ParticleSystem;
 struct RenderEngineType;
@@ -404,6 +406,7 @@ DRWShadingGroup *DRW_shgroup_transform_feedback_create(struct GPUShader *shader,
                                                        DRWPass *pass,
                                                        struct GPUVertBuf *tf_target);
 
+struct GPUTexture *DRW_image_gpu_texture_get(struct Image *ima, struct ImageUser *iuser);
 void DRW_shgroup_add_material_resources(DRWShadingGroup *grp, struct GPUMaterial *material);
 
 /* return final visibility */
@@ -433,8 +436,20 @@ void DRW_shgroup_call_ex(DRWShadingGroup *shgroup,
 #define DRW_shgroup_call_no_cull(shgroup, geom, ob) \
   DRW_shgroup_call_ex(shgroup, ob, NULL, geom, true, NULL)
 
-void DRW_shgroup_call_range(
-    DRWShadingGroup *shgroup, Object *ob, struct GPUBatch *geom, uint v_sta, uint v_ct);
+void DRW_shgroup_call_range_ex(DRWShadingGroup *shgroup,
+                               Object *ob,
+                               struct GPUBatch *geom,
+                               uint v_sta,
+                               uint v_ct,
+                               bool bypass_culling);
+
+#define DRW_shgroup_call_range(shgroup, ob, geom, v_sta, v_ct) \
+  DRW_shgroup_call_range_ex(shgroup, ob, geom, v_sta, v_ct, false)
+
+/* Same as DRW_shgroup_call_range but bypass culling even if ob is not NULL. */
+#define DRW_shgroup_call_range_no_cull(shgroup, ob, geom, v_sta, v_ct) \
+  DRW_shgroup_call_range_ex(shgroup, ob, geom, v_sta, v_ct, true)
+
 void DRW_shgroup_call_instance_range(
     DRWShadingGroup *shgroup, Object *ob, struct GPUBatch *geom, uint i_sta, uint i_ct);
 
@@ -587,6 +602,7 @@ void DRW_pass_foreach_shgroup(DRWPass *pass,
                               void *userData);
 void DRW_pass_sort_shgroup_z(DRWPass *pass);
 void DRW_pass_sort_shgroup_reverse(DRWPass *pass);
+void DRW_pass_sort_calls_by_batch(DRWPass *pass);
 
 bool DRW_pass_is_empty(DRWPass *pass);
 
@@ -804,6 +804,11 @@ typedef struct MeshExtract_Tri_Data {
   GPUIndexBufBuilder elb;
   int *tri_mat_start;
   int *tri_mat_end;
+  /**
+   * Offset to add to the index of a looptri to get its triangle index in the IBO, per polygon.
+   * Computed up-front so the looptri ranges can be extracted in parallel.
+   */
+  int *poly_tri_ofs;
 } MeshExtract_Tri_Data;
 
 static void *extract_tris_init(const MeshRenderData *mr,
@@ -848,25 +853,52 @@ static void *extract_tris_init(const MeshRenderData *mr,
 
   memcpy(data->tri_mat_end, mat_tri_len, mat_tri_idx_size);
 
+  /* Triangles of a polygon are contiguous in both the looptri array and the IBO. The first
+   * looptri of a polygon is at `loopstart - 2 * poly_index`. */
+  int *mat_tri_ofs = data->tri_mat_end;
+  data->poly_tri_ofs = MEM_mallocN(sizeof(int) * mr->poly_len, __func__);
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMFace *efa;
+    int f_index;
+    BM_ITER_MESH_INDEX (efa, &iter, mr->bm, BM_FACES_OF_MESH, f_index) {
+      if (!BM_elem_flag_test(efa, BM_ELEM_HIDDEN)) {
+        const int mat = min_ii(efa->mat_nr, mr->mat_len - 1);
+        const int looptri_first = BM_elem_index_get(BM_FACE_FIRST_LOOP(efa)) - 2 * f_index;
+        data->poly_tri_ofs[f_index] = mat_tri_ofs[mat] - looptri_first;
+        mat_tri_ofs[mat] += efa->len - 2;
+      }
+    }
+  }
+  else {
+    const MPoly *mp = mr->mpoly;
+    for (int mp_index = 0; mp_index < mr->poly_len; mp_index++, mp++) {
+      if (!(mr->use_hide && (mp->flag & ME_HIDE))) {
+        const int mat = min_ii(mp->mat_nr, mr->mat_len - 1);
+        const int looptri_first = mp->loopstart - 2 * mp_index;
+        data->poly_tri_ofs[mp_index] = mat_tri_ofs[mat] - looptri_first;
+        mat_tri_ofs[mat] += mp->totloop - 2;
+      }
+    }
+  }
+
   int visible_tri_tot = ofs;
   GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, visible_tri_tot, mr->loop_len);
 
   return data;
 }
 
-static void extract_tris_iter_looptri_bm(const MeshRenderData *mr,
+static void extract_tris_iter_looptri_bm(const MeshRenderData *UNUSED(mr),
                                          const struct ExtractTriBMesh_Params *params,
                                          void *_data)
 {
   MeshExtract_Tri_Data *data = _data;
-  const int mat_last = mr->mat_len - 1;
-  EXTRACT_TRIS_LOOPTRI_FOREACH_BM_BEGIN(elt, _elt_index, params)
+  EXTRACT_TRIS_LOOPTRI_FOREACH_BM_BEGIN(elt, elt_index, params)
   {
     if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
-      int *mat_tri_ofs = data->tri_mat_end;
-      const int mat = min_ii(elt[0]->f->mat_nr, mat_last);
+      const int f_index = BM_elem_index_get(elt[0]->f);
       GPU_indexbuf_set_tri_verts(&data->elb,
-                                 mat_tri_ofs[mat]++,
+                                 data->poly_tri_ofs[f_index] + elt_index,
                                  BM_elem_index_get(elt[0]),
                                  BM_elem_index_get(elt[1]),
                                  BM_elem_index_get(elt[2]));
@@ -880,15 +912,15 @@ static void extract_tris_iter_looptri_mesh(const MeshRenderData *mr,
                                            void *_data)
 {
   MeshExtract_Tri_Data *data = _data;
-  const int mat_last = mr->mat_len - 1;
-  EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_BEGIN(mlt, _mlt_index, params)
+  EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_BEGIN(mlt, mlt_index, params)
   {
     const MPoly *mp = &mr->mpoly[mlt->poly];
     if (!(mr->use_hide && (mp->flag & ME_HIDE))) {
-      int *mat_tri_ofs = data->tri_mat_end;
-      const int mat = min_ii(mp->mat_nr, mat_last);
-      GPU_indexbuf_set_tri_verts(
-          &data->elb, mat_tri_ofs[mat]++, mlt->tri[0], mlt->tri[1], mlt->tri[2]);
+      GPU_indexbuf_set_tri_verts(&data->elb,
+                                 data->poly_tri_ofs[mlt->poly] + mlt_index,
+                                 mlt->tri[0],
+                                 mlt->tri[1],
+                                 mlt->tri[2]);
     }
   }
   EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_END;
@@ -900,6 +932,9 @@ static void extract_tris_finish(const MeshRenderData *mr,
                                 void *_data)
 {
   MeshExtract_Tri_Data *data = _data;
+  /* The length tracked by the builder isn't reliable when the ranges are extracted in
+   * parallel, all visible triangles have been written. */
+  data->elb.index_len = data->elb.max_index_len;
   GPU_indexbuf_build_in_place(&data->elb, ibo);
 
   /* Create ibo sub-ranges. Always do this to avoid error when the standard surface batch
@@ -922,6 +957,7 @@ static void extract_tris_finish(const MeshRenderData *mr,
   }
   MEM_freeN(data->tri_mat_start);
   MEM_freeN(data->tri_mat_end);
+  MEM_freeN(data->poly_tri_ofs);
   MEM_freeN(data);
 }
 
@@ -931,7 +967,7 @@ static const MeshExtract extract_tris = {
     .iter_looptri_mesh = extract_tris_iter_looptri_mesh,
     .finish = extract_tris_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 
 /** \} */
@@ -940,21 +976,35 @@ static const MeshExtract extract_tris = {
 /** \name Extract Edges Indices
  * \{ */
 
+typedef struct MeshExtract_Lines_Data {
+  GPUIndexBufBuilder elb;
+  /**
+   * Edges are shared by several polygons which can be extracted by different threads,
+   * only the first polygon claiming an edge writes it.
+   */
+  BLI_bitmap *edge_claimed;
+} MeshExtract_Lines_Data;
+
 static void *extract_lines_init(const MeshRenderData *mr,
                                 struct MeshBatchCache *UNUSED(cache),
                                 void *UNUSED(buf))
 {
-  GPUIndexBufBuilder *elb = MEM_mallocN(sizeof(*elb), __func__);
+  MeshExtract_Lines_Data *data = MEM_mallocN(sizeof(*data), __func__);
   /* Put loose edges at the end. */
-  GPU_indexbuf_init(
-      elb, GPU_PRIM_LINES, mr->edge_len + mr->edge_loose_len, mr->loop_len + mr->loop_loose_len);
-  return elb;
+  GPU_indexbuf_init(&data->elb,
+                    GPU_PRIM_LINES,
+                    mr->edge_len + mr->edge_loose_len,
+                    mr->loop_len + mr->loop_loose_len);
+  data->edge_claimed = BLI_BITMAP_NEW(mr->edge_len, __func__);
+  return data;
 }
 
 static void extract_lines_iter_poly_bm(const MeshRenderData *mr,
                                        const ExtractPolyBMesh_Params *params,
-                                       void *elb)
+                                       void *_data)
 {
+  MeshExtract_Lines_Data *data = _data;
+  GPUIndexBufBuilder *elb = &data->elb;
   /* Using poly & loop iterator would complicate accessing the adjacent loop. */
   EXTRACT_POLY_FOREACH_BM_BEGIN(f, f_index, params, mr)
   {
@@ -962,14 +1012,18 @@ static void extract_lines_iter_poly_bm(const MeshRenderData *mr,
     /* Use #BMLoop.prev to match mesh order (to avoid minor differences in data extraction). */
     l_iter = l_first = BM_FACE_FIRST_LOOP(f)->prev;
     do {
+      const int e_index = BM_elem_index_get(l_iter->e);
+      if (BLI_BITMAP_TEST_AND_SET_ATOMIC(data->edge_claimed, e_index)) {
+        continue;
+      }
       if (!BM_elem_flag_test(l_iter->e, BM_ELEM_HIDDEN)) {
         GPU_indexbuf_set_line_verts(elb,
-                                    BM_elem_index_get(l_iter->e),
+                                    e_index,
                                     BM_elem_index_get(l_iter),
                                     BM_elem_index_get(l_iter->next));
       }
       else {
-        GPU_indexbuf_set_line_restart(elb, BM_elem_index_get(l_iter->e));
+        GPU_indexbuf_set_line_restart(elb, e_index);
       }
     } while ((l_iter = l_iter->next) != l_first);
   }
@@ -978,8 +1032,10 @@ static void extract_lines_iter_poly_bm(const MeshRenderData *mr,
 
 static void extract_lines_iter_poly_mesh(const MeshRenderData *mr,
                                          const ExtractPolyMesh_Params *params,
-                                         void *elb)
+                                         void *_data)
 {
+  MeshExtract_Lines_Data *data = _data;
+  GPUIndexBufBuilder *elb = &data->elb;
   /* Using poly & loop iterator would complicate accessing the adjacent loop. */
   const MLoop *mloop = mr->mloop;
   const MEdge *medge = mr->medge;
@@ -990,6 +1046,9 @@ static void extract_lines_iter_poly_mesh(const MeshRenderData *mr,
       int ml_index = ml_index_last, ml_index_next = mp->loopstart;
       do {
         const MLoop *ml = &mloop[ml_index];
+        if (BLI_BITMAP_TEST_AND_SET_ATOMIC(data->edge_claimed, ml->e)) {
+          continue;
+        }
         const MEdge *med = &medge[ml->e];
         if (!((mr->use_hide && (med->flag & ME_HIDE)) ||
               ((mr->extract_type == MR_EXTRACT_MAPPED) && (mr->e_origindex) &&
@@ -1010,7 +1069,9 @@ static void extract_lines_iter_poly_mesh(const MeshRenderData *mr,
       int ml_index = ml_index_last, ml_index_next = mp->loopstart;
       do {
         const MLoop *ml = &mloop[ml_index];
-        GPU_indexbuf_set_line_verts(elb, ml->e, ml_index, ml_index_next);
+        if (!BLI_BITMAP_TEST_AND_SET_ATOMIC(data->edge_claimed, ml->e)) {
+          GPU_indexbuf_set_line_verts(elb, ml->e, ml_index, ml_index_next);
+        }
       } while ((ml_index = ml_index_next++) != ml_index_last);
     }
     EXTRACT_POLY_FOREACH_MESH_END;
@@ -1019,8 +1080,9 @@ static void extract_lines_iter_poly_mesh(const MeshRenderData *mr,
 
 static void extract_lines_iter_ledge_bm(const MeshRenderData *mr,
                                         const ExtractLEdgeBMesh_Params *params,
-                                        void *elb)
+                                        void *_data)
 {
+  GPUIndexBufBuilder *elb = &((MeshExtract_Lines_Data *)_data)->elb;
   EXTRACT_LEDGE_FOREACH_BM_BEGIN(eed, ledge_index, params)
   {
     const int l_index_offset = mr->edge_len + ledge_index;
@@ -1039,8 +1101,9 @@ static void extract_lines_iter_ledge_bm(const MeshRenderData *mr,
 
 static void extract_lines_iter_ledge_mesh(const MeshRenderData *mr,
                                           const ExtractLEdgeMesh_Params *params,
-                                          void *elb)
+                                          void *_data)
 {
+  GPUIndexBufBuilder *elb = &((MeshExtract_Lines_Data *)_data)->elb;
   EXTRACT_LEDGE_FOREACH_MESH_BEGIN(med, ledge_index, params, mr)
   {
     const int l_index_offset = mr->edge_len + ledge_index;
@@ -1060,13 +1123,22 @@ static void extract_lines_iter_ledge_mesh(const MeshRenderData *mr,
   EXTRACT_LEDGE_FOREACH_MESH_END;
 }
 
+static void extract_lines_data_build_and_free(MeshExtract_Lines_Data *data, GPUIndexBuf *ibo)
+{
+  /* The length tracked by the builder isn't reliable when the ranges are extracted in
+   * parallel, all the edges have been written. */
+  data->elb.index_len = data->elb.max_index_len;
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_freeN(data->edge_claimed);
+  MEM_freeN(data);
+}
+
 static void extract_lines_finish(const MeshRenderData *UNUSED(mr),
                                  struct MeshBatchCache *UNUSED(cache),
                                  void *ibo,
-                                 void *elb)
+                                 void *data)
 {
-  GPU_indexbuf_build_in_place(elb, ibo);
-  MEM_freeN(elb);
+  extract_lines_data_build_and_free(data, ibo);
 }
 
 static const MeshExtract extract_lines = {
@@ -1077,7 +1149,7 @@ static const MeshExtract extract_lines = {
     .iter_ledge_mesh = extract_lines_iter_ledge_mesh,
     .finish = extract_lines_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 /** \} */
 
@@ -1099,11 +1171,10 @@ static void extract_lines_loose_subbuffer(const MeshRenderData *mr, struct MeshB
 static void extract_lines_with_lines_loose_finish(const MeshRenderData *mr,
                                                   struct MeshBatchCache *cache,
                                                   void *ibo,
-                                                  void *elb)
+                                                  void *data)
 {
-  GPU_indexbuf_build_in_place(elb, ibo);
+  extract_lines_data_build_and_free(data, ibo);
   extract_lines_loose_subbuffer(mr, cache);
-  MEM_freeN(elb);
 }
 
 static const MeshExtract extract_lines_with_lines_loose = {
@@ -1114,7 +1185,7 @@ static const MeshExtract extract_lines_with_lines_loose = {
     .iter_ledge_mesh = extract_lines_iter_ledge_mesh,
     .finish = extract_lines_with_lines_loose_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 
 /** \} */
@@ -1123,18 +1194,30 @@ static const MeshExtract extract_lines_with_lines_loose = {
 /** \name Extract Point Indices
  * \{ */
 
+typedef struct MeshExtract_Points_Data {
+  GPUIndexBufBuilder elb;
+  /** Same as #MeshExtract_Lines_Data.edge_claimed for the vertices shared by loops. */
+  BLI_bitmap *vert_claimed;
+} MeshExtract_Points_Data;
+
 static void *extract_points_init(const MeshRenderData *mr,
                                  struct MeshBatchCache *UNUSED(cache),
                                  void *UNUSED(buf))
 {
-  GPUIndexBufBuilder *elb = MEM_mallocN(sizeof(*elb), __func__);
-  GPU_indexbuf_init(elb, GPU_PRIM_POINTS, mr->vert_len, mr->loop_len + mr->loop_loose_len);
-  return elb;
+  MeshExtract_Points_Data *data = MEM_mallocN(sizeof(*data), __func__);
+  GPU_indexbuf_init(
+      &data->elb, GPU_PRIM_POINTS, mr->vert_len, mr->loop_len + mr->loop_loose_len);
+  data->vert_claimed = BLI_BITMAP_NEW(mr->vert_len, __func__);
+  return data;
 }
 
-BLI_INLINE void vert_set_bm(GPUIndexBufBuilder *elb, BMVert *eve, int l_index)
+BLI_INLINE void vert_set_bm(MeshExtract_Points_Data *data, BMVert *eve, int l_index)
 {
+  GPUIndexBufBuilder *elb = &data->elb;
   const int v_index = BM_elem_index_get(eve);
+  if (BLI_BITMAP_TEST_AND_SET_ATOMIC(data->vert_claimed, v_index)) {
+    return;
+  }
   if (!BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
     GPU_indexbuf_set_point_vert(elb, v_index, l_index);
   }
@@ -1143,11 +1226,15 @@ BLI_INLINE void vert_set_bm(GPUIndexBufBuilder *elb, BMVert *eve, int l_index)
   }
 }
 
-BLI_INLINE void vert_set_mesh(GPUIndexBufBuilder *elb,
+BLI_INLINE void vert_set_mesh(MeshExtract_Points_Data *data,
                               const MeshRenderData *mr,
                               const int v_index,
                               const int l_index)
 {
+  GPUIndexBufBuilder *elb = &data->elb;
+  if (BLI_BITMAP_TEST_AND_SET_ATOMIC(data->vert_claimed, v_index)) {
+    return;
+  }
   const MVert *mv = &mr->mvert[v_index];
   if (!((mr->use_hide && (mv->flag & ME_HIDE)) ||
         ((mr->extract_type == MR_EXTRACT_MAPPED) && (mr->v_origindex) &&
@@ -1161,70 +1248,70 @@ BLI_INLINE void vert_set_mesh(GPUIndexBufBuilder *elb,
 
 static void extract_points_iter_poly_bm(const MeshRenderData *mr,
                                         const ExtractPolyBMesh_Params *params,
-                                        void *elb)
+                                        void *data)
 {
   EXTRACT_POLY_AND_LOOP_FOREACH_BM_BEGIN(l, l_index, params, mr)
   {
-    vert_set_bm(elb, l->v, l_index);
+    vert_set_bm(data, l->v, l_index);
   }
   EXTRACT_POLY_AND_LOOP_FOREACH_BM_END(l);
 }
 
 static void extract_points_iter_poly_mesh(const MeshRenderData *mr,
                                           const ExtractPolyMesh_Params *params,
-                                          void *elb)
+                                          void *data)
 {
   EXTRACT_POLY_AND_LOOP_FOREACH_MESH_BEGIN(mp, mp_index, ml, ml_index, params, mr)
   {
-    vert_set_mesh(elb, mr, ml->v, ml_index);
+    vert_set_mesh(data, mr, ml->v, ml_index);
   }
   EXTRACT_POLY_AND_LOOP_FOREACH_MESH_END;
 }
 
 static void extract_points_iter_ledge_bm(const MeshRenderData *mr,
                                          const ExtractLEdgeBMesh_Params *params,
-                                         void *elb)
+                                         void *data)
 {
   EXTRACT_LEDGE_FOREACH_BM_BEGIN(eed, ledge_index, params)
   {
-    vert_set_bm(elb, eed->v1, mr->loop_len + (ledge_index * 2));
-    vert_set_bm(elb, eed->v2, mr->loop_len + (ledge_index * 2) + 1);
+    vert_set_bm(data, eed->v1, mr->loop_len + (ledge_index * 2));
+    vert_set_bm(data, eed->v2, mr->loop_len + (ledge_index * 2) + 1);
   }
   EXTRACT_LEDGE_FOREACH_BM_END;
 }
 
 static void extract_points_iter_ledge_mesh(const MeshRenderData *mr,
                                            const ExtractLEdgeMesh_Params *params,
-                                           void *elb)
+                                           void *data)
 {
   EXTRACT_LEDGE_FOREACH_MESH_BEGIN(med, ledge_index, params, mr)
   {
-    vert_set_mesh(elb, mr, med->v1, mr->loop_len + (ledge_index * 2));
-    vert_set_mesh(elb, mr, med->v2, mr->loop_len + (ledge_index * 2) + 1);
+    vert_set_mesh(data, mr, med->v1, mr->loop_len + (ledge_index * 2));
+    vert_set_mesh(data, mr, med->v2, mr->loop_len + (ledge_index * 2) + 1);
   }
   EXTRACT_LEDGE_FOREACH_MESH_END;
 }
 
 static void extract_points_iter_lvert_bm(const MeshRenderData *mr,
                                          const ExtractLVertBMesh_Params *params,
-                                         void *elb)
+                                         void *data)
 {
   const int offset = mr->loop_len + (mr->edge_loose_len * 2);
   EXTRACT_LVERT_FOREACH_BM_BEGIN(eve, lvert_index, params)
   {
-    vert_set_bm(elb, eve, offset + lvert_index);
+    vert_set_bm(data, eve, offset + lvert_index);
   }
   EXTRACT_LVERT_FOREACH_BM_END;
 }
 
 static void extract_points_iter_lvert_mesh(const MeshRenderData *mr,
                                            const ExtractLVertMesh_Params *params,
-                                           void *elb)
+                                           void *data)
 {
   const int offset = mr->loop_len + (mr->edge_loose_len * 2);
   EXTRACT_LVERT_FOREACH_MESH_BEGIN(mv, lvert_index, params, mr)
   {
-    vert_set_mesh(elb, mr, mr->lverts[lvert_index], offset + lvert_index);
+    vert_set_mesh(data, mr, mr->lverts[lvert_index], offset + lvert_index);
   }
   EXTRACT_LVERT_FOREACH_MESH_END;
 }
@@ -1232,10 +1319,14 @@ static void extract_points_iter_lvert_mesh(const MeshRenderData *mr,
 static void extract_points_finish(const MeshRenderData *UNUSED(mr),
                                   struct MeshBatchCache *UNUSED(cache),
                                   void *ibo,
-                                  void *elb)
+                                  void *_data)
 {
-  GPU_indexbuf_build_in_place(elb, ibo);
-  MEM_freeN(elb);
+  MeshExtract_Points_Data *data = _data;
+  /* See #extract_lines_data_build_and_free. */
+  data->elb.index_len = data->elb.max_index_len;
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_freeN(data->vert_claimed);
+  MEM_freeN(data);
 }
 
 static const MeshExtract extract_points = {
@@ -1248,7 +1339,7 @@ static const MeshExtract extract_points = {
     .iter_lvert_mesh = extract_points_iter_lvert_mesh,
     .finish = extract_points_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 
 /** \} */
@@ -1418,10 +1509,26 @@ static const MeshExtract extract_lines_paint_mask = {
  * \{ */
 
 #define NO_EDGE INT_MAX
+#define NO_LINK UINT_MAX
+
+/**
+ * Edge of the triangulated mesh, chained with the other edges using the same lowest vertex.
+ * Vertices have few edges so searching the chain is much cheaper than hashing both indices.
+ */
+typedef struct LineAdjacencyEdge {
+  uint v_low, v_high;
+  /* First loop index + 1, negative when the triangle winding goes from high to low.
+   * #NO_EDGE once the opposite triangle has been found. */
+  int value;
+  uint next;
+} LineAdjacencyEdge;
 
 typedef struct MeshExtract_LineAdjacency_Data {
   GPUIndexBufBuilder elb;
-  EdgeHash *eh;
+  LineAdjacencyEdge *edges;
+  uint edges_len, edges_len_max;
+  /* Array to convert vert index to first edge using this vert as lowest index. */
+  uint *vert_to_edge;
   bool is_manifold;
   /* Array to convert vert index to any loop index of this vert. */
   uint vert_to_loop[0];
@@ -1440,11 +1547,43 @@ static void *extract_lines_adjacency_init(const MeshRenderData *mr,
 
   MeshExtract_LineAdjacency_Data *data = MEM_callocN(sizeof(*data) + vert_to_loop_size, __func__);
   GPU_indexbuf_init(&data->elb, GPU_PRIM_LINES_ADJ, tess_edge_len, mr->loop_len);
-  data->eh = BLI_edgehash_new_ex(__func__, tess_edge_len);
+  data->edges = MEM_mallocN(sizeof(*data->edges) * MAX2(tess_edge_len, 1), __func__);
+  data->edges_len_max = tess_edge_len;
+  data->vert_to_edge = MEM_mallocN(sizeof(uint) * MAX2(mr->vert_len, 1), __func__);
+  /* Fills with #NO_LINK. */
+  memset(data->vert_to_edge, 0xFF, sizeof(uint) * mr->vert_len);
   data->is_manifold = true;
   return data;
 }
 
+/**
+ * \return The edge between \a v_low and \a v_high, a new one when it wasn't added before
+ * (\a r_is_new is then set to true).
+ */
+BLI_INLINE LineAdjacencyEdge *lines_adjacency_edge_ensure(MeshExtract_LineAdjacency_Data *data,
+                                                          uint v_low,
+                                                          uint v_high,
+                                                          bool *r_is_new)
+{
+  uint *link = &data->vert_to_edge[v_low];
+  while (*link != NO_LINK) {
+    LineAdjacencyEdge *edge = &data->edges[*link];
+    if (edge->v_high == v_high) {
+      *r_is_new = false;
+      return edge;
+    }
+    link = &edge->next;
+  }
+  BLI_assert(data->edges_len < data->edges_len_max);
+  *link = data->edges_len++;
+  LineAdjacencyEdge *edge = &data->edges[*link];
+  edge->v_low = v_low;
+  edge->v_high = v_high;
+  edge->next = NO_LINK;
+  *r_is_new = true;
+  return edge;
+}
+
 BLI_INLINE void lines_adjacency_triangle(
     uint v1, uint v2, uint v3, uint l1, uint l2, uint l3, MeshExtract_LineAdjacency_Data *data)
 {
@@ -1455,21 +1594,22 @@ BLI_INLINE void lines_adjacency_triangle(
     SHIFT3(uint, l3, l2, l1);
 
     bool inv_indices = (v2 > v3);
-    void **pval;
-    bool value_is_init = BLI_edgehash_ensure_p(data->eh, v2, v3, &pval);
-    int v_data = POINTER_AS_INT(*pval);
-    if (!value_is_init || v_data == NO_EDGE) {
+    bool is_new;
+    LineAdjacencyEdge *edge = lines_adjacency_edge_ensure(
+        data, MIN2(v2, v3), MAX2(v2, v3), &is_new);
+    int v_data = edge->value;
+    if (is_new || v_data == NO_EDGE) {
       /* Save the winding order inside the sign bit. Because the
-       * Edge-hash sort the keys and we need to compare winding later. */
+       * edges are stored with sorted vertices and we need to compare winding later. */
       int value = (int)l1 + 1; /* 0 cannot be signed so add one. */
-      *pval = POINTER_FROM_INT((inv_indices) ? -value : value);
+      edge->value = (inv_indices) ? -value : value;
       /* Store loop indices for remaining non-manifold edges. */
       data->vert_to_loop[v2] = l2;
       data->vert_to_loop[v3] = l3;
     }
     else {
-      /* HACK Tag as not used. Prevent overhead of BLI_edgehash_remove. */
-      *pval = POINTER_FROM_INT(NO_EDGE);
+      /* Tag as not used, a third triangle using this edge starts a new pair. */
+      edge->value = NO_EDGE;
       bool inv_opposite = (v_data < 0);
       uint l_opposite = (uint)abs(v_data) - 1;
       /* TODO Make this part thread-safe. */
@@ -1532,24 +1672,23 @@ static void extract_lines_adjacency_finish(const MeshRenderData *UNUSED(mr),
 {
   MeshExtract_LineAdjacency_Data *data = _data;
   /* Create edges for remaining non manifold edges. */
-  EdgeHashIterator *ehi = BLI_edgehashIterator_new(data->eh);
-  for (; !BLI_edgehashIterator_isDone(ehi); BLI_edgehashIterator_step(ehi)) {
-    uint v2, v3, l1, l2, l3;
-    int v_data = POINTER_AS_INT(BLI_edgehashIterator_getValue(ehi));
+  for (uint i = 0; i < data->edges_len; i++) {
+    const LineAdjacencyEdge *edge = &data->edges[i];
+    int v_data = edge->value;
     if (v_data != NO_EDGE) {
-      BLI_edgehashIterator_getKey(ehi, &v2, &v3);
-      l1 = (uint)abs(v_data) - 1;
+      uint v2 = edge->v_low, v3 = edge->v_high;
+      uint l1 = (uint)abs(v_data) - 1;
       if (v_data < 0) { /* inv_opposite  */
         SWAP(uint, v2, v3);
       }
-      l2 = data->vert_to_loop[v2];
-      l3 = data->vert_to_loop[v3];
+      uint l2 = data->vert_to_loop[v2];
+      uint l3 = data->vert_to_loop[v3];
       GPU_indexbuf_add_line_adj_verts(&data->elb, l1, l2, l3, l1);
       data->is_manifold = false;
     }
   }
-  BLI_edgehashIterator_free(ehi);
-  BLI_edgehash_free(data->eh, NULL);
+  MEM_freeN(data->edges);
+  MEM_freeN(data->vert_to_edge);
 
   cache->is_manifold = data->is_manifold;
 
@@ -1558,6 +1697,7 @@ static void extract_lines_adjacency_finish(const MeshRenderData *UNUSED(mr),
 }
 
 #undef NO_EDGE
+#undef NO_LINK
 
 static const MeshExtract extract_lines_adjacency = {
     .init = extract_lines_adjacency_init,
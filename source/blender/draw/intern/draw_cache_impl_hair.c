@@ -257,23 +257,7 @@ static void hair_batch_cache_ensure_procedural_final_points(ParticleHairCache *c
                                                                   cache->final[subdiv].proc_buf);
 }
 
-static void hair_batch_cache_fill_segments_indices(Hair *hair,
-                                                   const int res,
-                                                   GPUIndexBufBuilder *elb)
-{
-  HairCurve *curve = hair->curves;
-  int num_curves = hair->totcurve;
-  uint curr_point = 0;
-  for (int i = 0; i < num_curves; i++, curve++) {
-    for (int k = 0; k < res; k++) {
-      GPU_indexbuf_add_generic_vert(elb, curr_point++);
-    }
-    GPU_indexbuf_add_primitive_restart(elb);
-  }
-}
-
-static void hair_batch_cache_ensure_procedural_indices(Hair *hair,
-                                                       ParticleHairCache *cache,
+static void hair_batch_cache_ensure_procedural_indices(ParticleHairCache *cache,
                                                        int thickness_res,
                                                        int subdiv)
 {
@@ -300,7 +284,7 @@ static void hair_batch_cache_ensure_procedural_indices(Hair *hair,
   GPUIndexBufBuilder elb;
   GPU_indexbuf_init_ex(&elb, prim_type, element_count, element_count);
 
-  hair_batch_cache_fill_segments_indices(hair, verts_per_hair, &elb);
+  hair_batch_cache_fill_strands_indices(cache->strands_len, verts_per_hair, &elb);
 
   cache->final[subdiv].proc_hairs[thickness_res - 1] = GPU_batch_create_ex(
       prim_type, vbo, GPU_indexbuf_build(&elb), GPU_BATCH_OWNS_VBO | GPU_BATCH_OWNS_INDEX);
@@ -339,7 +323,7 @@ bool hair_ensure_procedural_data(Object *object,
     need_ft_update = true;
   }
   if ((*r_hair_cache)->final[subdiv].proc_hairs[thickness_res - 1] == NULL) {
-    hair_batch_cache_ensure_procedural_indices(hair, &cache->hair, thickness_res, subdiv);
+    hair_batch_cache_ensure_procedural_indices(&cache->hair, thickness_res, subdiv);
   }
 
   return need_ft_update;
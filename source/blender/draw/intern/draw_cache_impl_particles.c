@@ -692,26 +692,6 @@ static int particle_batch_cache_fill_segments_edit(
   return curr_point;
 }
 
-static int particle_batch_cache_fill_segments_indices(ParticleCacheKey **path_cache,
-                                                      const int start_index,
-                                                      const int num_path_keys,
-                                                      const int res,
-                                                      GPUIndexBufBuilder *elb)
-{
-  int curr_point = start_index;
-  for (int i = 0; i < num_path_keys; i++) {
-    ParticleCacheKey *path = path_cache[i];
-    if (path->segments <= 0) {
-      continue;
-    }
-    for (int k = 0; k < res; k++) {
-      GPU_indexbuf_add_generic_vert(elb, curr_point++);
-    }
-    GPU_indexbuf_add_primitive_restart(elb);
-  }
-  return curr_point;
-}
-
 static int particle_batch_cache_fill_strands_data(ParticleSystem *psys,
                                                   ParticleSystemModifierData *psmd,
                                                   ParticleCacheKey **path_cache,
@@ -1025,9 +1005,7 @@ static void particle_batch_cache_ensure_procedural_strand_data(PTCacheEdit *edit
   }
 }
 
-static void particle_batch_cache_ensure_procedural_indices(PTCacheEdit *edit,
-                                                           ParticleSystem *psys,
-                                                           ParticleHairCache *cache,
+static void particle_batch_cache_ensure_procedural_indices(ParticleHairCache *cache,
                                                            int thickness_res,
                                                            int subdiv)
 {
@@ -1054,23 +1032,7 @@ static void particle_batch_cache_ensure_procedural_indices(PTCacheEdit *edit,
   GPUIndexBufBuilder elb;
   GPU_indexbuf_init_ex(&elb, prim_type, element_count, element_count);
 
-  if (edit != NULL && edit->pathcache != NULL) {
-    particle_batch_cache_fill_segments_indices(
-        edit->pathcache, 0, edit->totcached, verts_per_hair, &elb);
-  }
-  else {
-    int curr_point = 0;
-    if ((psys->pathcache != NULL) &&
-        (!psys->childcache || (psys->part->draw & PART_DRAW_PARENT))) {
-      curr_point = particle_batch_cache_fill_segments_indices(
-          psys->pathcache, 0, psys->totpart, verts_per_hair, &elb);
-    }
-    if (psys->childcache) {
-      const int child_count = psys->totchild * psys->part->disp / 100;
-      curr_point = particle_batch_cache_fill_segments_indices(
-          psys->childcache, curr_point, child_count, verts_per_hair, &elb);
-    }
-  }
+  hair_batch_cache_fill_strands_indices(cache->strands_len, verts_per_hair, &elb);
 
   cache->final[subdiv].proc_hairs[thickness_res - 1] = GPU_batch_create_ex(
       prim_type, vbo, GPU_indexbuf_build(&elb), GPU_BATCH_OWNS_VBO | GPU_BATCH_OWNS_INDEX);
@@ -1683,8 +1645,7 @@ bool particles_ensure_procedural_data(Object *object,
     need_ft_update = true;
   }
   if ((*r_hair_cache)->final[subdiv].proc_hairs[thickness_res - 1] == NULL) {
-    particle_batch_cache_ensure_procedural_indices(
-        source.edit, source.psys, &cache->hair, thickness_res, subdiv);
+    particle_batch_cache_ensure_procedural_indices(&cache->hair, thickness_res, subdiv);
   }
 
   return need_ft_update;
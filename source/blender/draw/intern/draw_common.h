@@ -213,6 +213,8 @@ struct DRW_Global {
 
   struct GPUTexture *ramp;
   struct GPUTexture *weight_ramp;
+  /** Bound instead of the images being loaded in the background. */
+  struct GPUTexture *image_placeholder;
 
   struct GPUUniformBuf *view_ubo;
 };
@@ -25,16 +25,22 @@
 
 #include "DRW_render.h"
 
+#include "BLI_math_base.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_customdata_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_particle_types.h"
+#include "DNA_scene_types.h"
 
 #include "BKE_duplilist.h"
+#include "BKE_object.h"
 
 #include "GPU_batch.h"
+#include "GPU_index_buffer.h"
 #include "GPU_shader.h"
 #include "GPU_vertex_buffer.h"
 
@@ -44,6 +50,12 @@
 #  define USE_TRANSFORM_FEEDBACK
 #endif
 
+/* Level of detail (see SCE_PERF_HAIR_LOD). */
+/** Size on screen (relative to the viewport height) of the hair drawn at full detail. */
+#define HAIR_LOD_FULL_SIZE 0.5f
+/** Fraction of the strands drawn whatever the size on screen. */
+#define HAIR_LOD_STRANDS_MIN 0.05f
+
 typedef enum ParticleRefineShader {
   PART_REFINE_CATMULL_ROM = 0,
   PART_REFINE_MAX_SHADER,
@@ -124,6 +136,94 @@ void DRW_hair_init(void)
   }
 }
 
+static uint hair_bit_reverse_uint(uint n)
+{
+  n = ((n >> 1) & 0x55555555u) | ((n & 0x55555555u) << 1);
+  n = ((n >> 2) & 0x33333333u) | ((n & 0x33333333u) << 2);
+  n = ((n >> 4) & 0x0F0F0F0Fu) | ((n & 0x0F0F0F0Fu) << 4);
+  n = ((n >> 8) & 0x00FF00FFu) | ((n & 0x00FF00FFu) << 8);
+  return (n >> 16) | (n << 16);
+}
+
+/**
+ * Fill the index buffer of the final hair drawing. The strands are added in bit reversed
+ * order so that the first part of the buffer always contains strands spread over the whole
+ * hair system, allowing to draw fewer strands by only drawing a range of the buffer.
+ */
+void hair_batch_cache_fill_strands_indices(int strands_len,
+                                           int verts_per_hair,
+                                           GPUIndexBufBuilder *elb)
+{
+  uint bits = 0;
+  while ((1u << bits) < (uint)strands_len) {
+    bits++;
+  }
+  for (uint i = 0; i < (1u << bits); i++) {
+    const uint strand = (bits > 0) ? hair_bit_reverse_uint(i) >> (32 - bits) : 0;
+    if (strand >= (uint)strands_len) {
+      continue;
+    }
+    const uint first_vert = strand * (uint)verts_per_hair;
+    for (int k = 0; k < verts_per_hair; k++) {
+      GPU_indexbuf_add_generic_vert(elb, first_vert + k);
+    }
+    GPU_indexbuf_add_primitive_restart(elb);
+  }
+}
+
+/**
+ * \return The level of detail of the hair of \a object. 1.0 for full detail, lower when the
+ * object gets smaller on screen.
+ */
+static float drw_hair_lod_get(Object *object)
+{
+  const DRWContextState *draw_ctx = DRW_context_state_get();
+  const Scene *scene = draw_ctx->scene;
+
+  if ((scene->r.perf_flag & SCE_PERF_HAIR_LOD) == 0 || DRW_state_is_image_render()) {
+    return 1.0f;
+  }
+
+  BoundBox *bb = BKE_object_boundbox_get(object);
+  if (bb == NULL) {
+    return 1.0f;
+  }
+
+  float center[3];
+  mid_v3_v3v3(center, bb->vec[0], bb->vec[6]);
+  mul_m4_v3(object->obmat, center);
+  const float radius = len_v3v3(bb->vec[0], bb->vec[6]) * 0.5f * mat4_to_scale(object->obmat);
+
+  const DRWView *view = DRW_view_default_get();
+  float winmat[4][4];
+  DRW_view_winmat_get(view, winmat, false);
+
+  float size = radius * winmat[1][1];
+  if (DRW_view_is_persp_get(view)) {
+    float viewmat[4][4];
+    DRW_view_viewmat_get(view, viewmat, false);
+    mul_m4_v3(viewmat, center);
+    const float depth = -center[2];
+    if (depth <= radius) {
+      /* The view is inside the bounds. */
+      return 1.0f;
+    }
+    size /= depth;
+  }
+  return clamp_f(size / HAIR_LOD_FULL_SIZE, 0.0f, 1.0f);
+}
+
+/** Remove one subdivision level each time the size on screen is halved. */
+static int drw_hair_lod_subdiv_get(const Scene *scene, float lod)
+{
+  int subdiv = scene->r.hair_subdiv;
+  while (subdiv > 0 && lod < 0.5f) {
+    subdiv--;
+    lod *= 2.0f;
+  }
+  return subdiv;
+}
+
 static ParticleHairCache *drw_hair_particle_cache_get(
     Object *object, ParticleSystem *psys, ModifierData *md, int subdiv, int thickness_res)
 {
@@ -176,7 +276,7 @@ GPUVertBuf *DRW_hair_pos_buffer_get(Object *object, ParticleSystem *psys, Modifi
   const DRWContextState *draw_ctx = DRW_context_state_get();
   Scene *scene = draw_ctx->scene;
 
-  int subdiv = scene->r.hair_subdiv;
+  int subdiv = drw_hair_lod_subdiv_get(scene, drw_hair_lod_get(object));
   int thickness_res = (scene->r.hair_type == SCE_HAIR_SHAPE_STRAND) ? 1 : 2;
 
   ParticleHairCache *cache = drw_hair_particle_cache_get(object, psys, md, subdiv, thickness_res);
@@ -222,7 +322,8 @@ DRWShadingGroup *DRW_shgroup_hair_create_sub(Object *object,
   Scene *scene = draw_ctx->scene;
   float dupli_mat[4][4];
 
-  int subdiv = scene->r.hair_subdiv;
+  const float lod = drw_hair_lod_get(object);
+  int subdiv = drw_hair_lod_subdiv_get(scene, lod);
   int thickness_res = (scene->r.hair_type == SCE_HAIR_SHAPE_STRAND) ? 1 : 2;
 
   ParticleHairCache *hair_cache = drw_hair_particle_cache_get(
@@ -286,7 +387,17 @@ DRWShadingGroup *DRW_shgroup_hair_create_sub(Object *object,
   /* TODO(fclem): Until we have a better way to cull the hair and render with orco, bypass
    * culling test. */
   GPUBatch *geom = hair_cache->final[subdiv].proc_hairs[thickness_res - 1];
-  DRW_shgroup_call_no_cull(shgrp, geom, object);
+  if (lod < 1.0f) {
+    /* The strands are sorted so that any first part of the index buffer covers the whole
+     * hair system (see #hair_batch_cache_fill_strands_indices). */
+    const int verts_per_hair = hair_cache->final[subdiv].strands_res * thickness_res;
+    const int strands_len = max_ii(1, (int)ceilf(hair_cache->strands_len *
+                                                 max_ff(lod, HAIR_LOD_STRANDS_MIN)));
+    DRW_shgroup_call_range_no_cull(shgrp, object, geom, 0, strands_len * (verts_per_hair + 1));
+  }
+  else {
+    DRW_shgroup_call_no_cull(shgrp, geom, object);
+  }
 
   return shgrp;
 }
@@ -28,6 +28,7 @@
 #define MAX_THICKRES 2    /* see eHairType */
 #define MAX_HAIR_SUBDIV 4 /* see hair_subdiv rna */
 
+struct GPUIndexBufBuilder;
 struct ModifierData;
 struct Object;
 struct ParticleHairCache;
@@ -80,6 +81,10 @@ typedef struct ParticleHairCache {
 
 void particle_batch_cache_clear_hair(struct ParticleHairCache *hair_cache);
 
+void hair_batch_cache_fill_strands_indices(int strands_len,
+                                           int verts_per_hair,
+                                           struct GPUIndexBufBuilder *elb);
+
 bool particles_ensure_procedural_data(struct Object *object,
                                       struct ParticleSystem *psys,
                                       struct ModifierData *md,
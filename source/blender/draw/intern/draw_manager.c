@@ -758,6 +758,8 @@ static void drw_duplidata_free(void)
                    (void (*)(void *key))drw_batch_cache_generate_requested,
                    duplidata_value_free);
     DST.dupli_ghash = NULL;
+    /* Engines can still request batches of the dupli sources when finishing their caches. */
+    BLI_task_graph_work_and_wait(DST.task_graph);
   }
 }
 
@@ -1100,7 +1102,10 @@ static void drw_engines_cache_populate(Object *ob)
   /* TODO: in the future it would be nice to generate once for all viewports.
    * But we need threaded DRW manager first. */
   if (!DST.dupli_source) {
-    drw_batch_cache_generate_requested(ob);
+    /* Generated once all objects are populated, so the extraction of all objects runs in
+     * parallel and the batch caches of data shared by several objects are never requested
+     * while their extraction is running. */
+    drw_batch_cache_generate_requested_delayed(ob);
   }
 
   /* ... and clearing it here too because this draw data is
@@ -1488,6 +1493,64 @@ struct DRWTextStore *DRW_text_cache_ensure(void)
 /** \name Main Draw Loops (DRW_draw)
  * \{ */
 
+/* Only editor overlays (gizmos) of the region are tagged for redraw, the scene did not change. */
+static bool drw_region_editor_overlays_only(const ARegion *region)
+{
+  return (region->do_draw & RGN_DRAW_EDITOR_OVERLAYS) &&
+         !(region->do_draw & (RGN_DRAW | RGN_DRAW_PARTIAL | RGN_DRAW_NO_REBUILD));
+}
+
+/**
+ * Redraw only the editor overlays on top of the overlay layer cached by the last full draw,
+ * see #GPU_viewport_overlay_cache_store. The engines are enabled but not initialized nor
+ * populated, the scene color buffer of the viewport is left as it is.
+ */
+static void drw_draw_editor_overlays_loop(struct Depsgraph *depsgraph,
+                                          RenderEngineType *engine_type,
+                                          ARegion *region,
+                                          View3D *v3d,
+                                          GPUViewport *viewport,
+                                          const bContext *evil_C)
+{
+  Scene *scene = DEG_get_evaluated_scene(depsgraph);
+  ViewLayer *view_layer = DEG_get_evaluated_view_layer(depsgraph);
+
+  DST.viewport = viewport;
+  DST.draw_ctx = (DRWContextState){
+      .region = region,
+      .rv3d = region->regiondata,
+      .v3d = v3d,
+      .scene = scene,
+      .view_layer = view_layer,
+      .obact = OBACT(view_layer),
+      .engine_type = engine_type,
+      .depsgraph = depsgraph,
+      .evil_C = evil_C,
+  };
+  drw_context_state_init();
+
+  drw_viewport_var_init();
+  drw_viewport_colormanagement_set();
+
+  /* Engines are only needed for their text caches and info. */
+  drw_engines_enable(view_layer, engine_type, drw_gpencil_engine_needed(depsgraph, v3d));
+  drw_engines_data_validate();
+
+  DRW_draw_callbacks_post_scene();
+
+  if (WM_draw_region_get_bound_viewport(region) == NULL) {
+    GPU_framebuffer_restore();
+  }
+
+  DRW_state_reset();
+  drw_engines_disable();
+
+#ifdef DEBUG
+  /* Avoid accidental reuse. */
+  drw_state_ensure_not_reused(&DST);
+#endif
+}
+
 /* Everything starts here.
  * This function takes care of calling all cache and rendering functions
  * for each relevant engine / mode engine. */
@@ -1508,7 +1571,14 @@ void DRW_draw_view(const bContext *C)
     DST.options.draw_background = (scene->r.alphamode == R_ADDSKY) ||
                                   (v3d->shading.type != OB_RENDER);
     DST.options.do_color_management = true;
-    DRW_draw_render_loop_ex(depsgraph, engine_type, region, v3d, viewport, C);
+    DST.options.cache_editor_overlays = true;
+
+    if (drw_region_editor_overlays_only(region) && GPU_viewport_overlay_cache_restore(viewport)) {
+      drw_draw_editor_overlays_loop(depsgraph, engine_type, region, v3d, viewport, C);
+    }
+    else {
+      DRW_draw_render_loop_ex(depsgraph, engine_type, region, v3d, viewport, C);
+    }
   }
   else {
     Depsgraph *depsgraph = CTX_data_expect_evaluated_depsgraph(C);
@@ -1639,6 +1709,10 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   DRW_stats_reset();
 
+  if (DST.options.cache_editor_overlays) {
+    GPU_viewport_overlay_cache_store(DST.viewport);
+  }
+
   DRW_draw_callbacks_post_scene();
 
   if (WM_draw_region_get_bound_viewport(region)) {
@@ -1953,7 +2027,7 @@ void DRW_render_object_iter(
       }
       callback(vedata, ob, engine, depsgraph);
       if (!DST.dupli_source) {
-        drw_batch_cache_generate_requested(ob);
+        drw_batch_cache_generate_requested_delayed(ob);
       }
     }
   }
@@ -2993,6 +3067,7 @@ void DRW_engines_free(void)
   DRW_UBO_FREE_SAFE(G_draw.view_ubo);
   DRW_TEXTURE_FREE_SAFE(G_draw.ramp);
   DRW_TEXTURE_FREE_SAFE(G_draw.weight_ramp);
+  DRW_TEXTURE_FREE_SAFE(G_draw.image_placeholder);
 
   if (DST.draw_list) {
     GPU_draw_list_discard(DST.draw_list);
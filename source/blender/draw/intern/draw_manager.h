@@ -533,6 +533,8 @@ typedef struct DRWManager {
     uint do_color_management : 1;
     uint draw_background : 1;
     uint draw_text : 1;
+    /* Keep a copy of the overlay layer for #drw_draw_editor_overlays_loop. */
+    uint cache_editor_overlays : 1;
   } options;
 
   /* Current rendering context */
@@ -559,6 +561,10 @@ typedef struct DRWManager {
   uint select_id;
 #endif
 
+  /** Number of draw calls and state changes of this redraw, sampled by the profiler. */
+  uint stats_draw_call_len;
+  uint stats_state_change_len;
+
   struct TaskGraph *task_graph;
   /* Contains list of objects that needs to be extracted from other objects. */
   struct GSet *delayed_extraction;
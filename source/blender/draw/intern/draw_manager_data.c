@@ -86,6 +86,70 @@ static void draw_call_sort(DRWCommand *array, DRWCommand *array_tmp, int array_l
   memcpy(array, array_tmp, sizeof(*array) * array_len);
 }
 
+static int draw_call_cmp(const void *a_, const void *b_)
+{
+  const DRWCommandDraw *a = a_, *b = b_;
+  /* Keep calls using the same resource chunk and front face together, changing them
+   * interrupts the batching like changing the batch. */
+  const uint32_t state_a = a->handle & ~0x1FFu, state_b = b->handle & ~0x1FFu;
+  if (state_a != state_b) {
+    return (state_a < state_b) ? -1 : 1;
+  }
+  if (a->batch != b->batch) {
+    return ((uintptr_t)a->batch < (uintptr_t)b->batch) ? -1 : 1;
+  }
+  /* Ascending resource ID's are merged into one instanced draw. */
+  if (a->handle != b->handle) {
+    return (a->handle < b->handle) ? -1 : 1;
+  }
+  return 0;
+}
+
+/**
+ * Sort the draw calls of a shading group spanning several chunks by batch, so that all the
+ * calls of a batch (e.g. linked duplicates scattered in the scene) are submitted together
+ * using a single multi-draw indirect command list.
+ */
+static void draw_call_sort_shgroup(DRWShadingGroup *shgroup,
+                                   DRWCommand **array_tmp,
+                                   int *array_tmp_len)
+{
+  int array_len = 0;
+  for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+    array_len += chunk->command_used;
+  }
+  if (array_len > *array_tmp_len) {
+    MEM_SAFE_FREE(*array_tmp);
+    *array_tmp = MEM_mallocN(sizeof(DRWCommand) * array_len, __func__);
+    *array_tmp_len = array_len;
+  }
+
+  DRWCommand *cmd = *array_tmp;
+  for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+    memcpy(cmd, chunk->commands, sizeof(*cmd) * chunk->command_used);
+    cmd += chunk->command_used;
+  }
+
+  qsort(*array_tmp, array_len, sizeof(DRWCommand), draw_call_cmp);
+
+  cmd = *array_tmp;
+  for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+    memcpy(chunk->commands, cmd, sizeof(*cmd) * chunk->command_used);
+    cmd += chunk->command_used;
+  }
+}
+
+static bool draw_call_chunk_is_sortable(const DRWCommandChunk *chunk)
+{
+  /* We can only sort chunks that contain #DRWCommandDraw only. */
+  for (int i = 0; i < ARRAY_SIZE(chunk->command_type); i++) {
+    if (chunk->command_type[i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void drw_resource_buffer_finish(ViewportMemoryPool *vmempool)
 {
   int chunk_id = DRW_handle_chunk_get(&DST.resource_handle);
@@ -132,21 +196,39 @@ void drw_resource_buffer_finish(ViewportMemoryPool *vmempool)
 
   /* Aligned alloc to avoid unaligned memcpy. */
   DRWCommandChunk *chunk_tmp = MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, "tmp call chunk");
-  DRWCommandChunk *chunk;
+  DRWCommand *shgroup_cmd_tmp = NULL;
+  int shgroup_cmd_tmp_len = 0;
+  DRWShadingGroup *shgroup;
   BLI_memblock_iter iter;
-  BLI_memblock_iternew(vmempool->commands, &iter);
-  while ((chunk = BLI_memblock_iterstep(&iter))) {
-    bool sortable = true;
-    /* We can only sort chunks that contain #DRWCommandDraw only. */
-    for (int i = 0; i < ARRAY_SIZE(chunk->command_type) && sortable; i++) {
-      if (chunk->command_type[i] != 0) {
-        sortable = false;
+  BLI_memblock_iternew(vmempool->shgroups, &iter);
+  while ((shgroup = BLI_memblock_iterstep(&iter))) {
+    DRWCommandChunk *chunk = shgroup->cmd.first;
+    if (chunk == NULL) {
+      continue;
+    }
+    if (chunk->next == NULL) {
+      if (draw_call_chunk_is_sortable(chunk)) {
+        draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
       }
+      continue;
+    }
+    bool sortable = true;
+    for (; chunk && sortable; chunk = chunk->next) {
+      sortable = draw_call_chunk_is_sortable(chunk);
     }
     if (sortable) {
-      draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
+      draw_call_sort_shgroup(shgroup, &shgroup_cmd_tmp, &shgroup_cmd_tmp_len);
+    }
+    else {
+      /* Sort the chunks containing only draw calls, other commands can depend on the order. */
+      for (chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+        if (draw_call_chunk_is_sortable(chunk)) {
+          draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
+        }
+      }
     }
   }
+  MEM_SAFE_FREE(shgroup_cmd_tmp);
   MEM_freeN(chunk_tmp);
 }
 
@@ -792,8 +874,12 @@ void DRW_shgroup_call_ex(DRWShadingGroup *shgroup,
   }
 }
 
-void DRW_shgroup_call_range(
-    DRWShadingGroup *shgroup, struct Object *ob, GPUBatch *geom, uint v_sta, uint v_ct)
+void DRW_shgroup_call_range_ex(DRWShadingGroup *shgroup,
+                               struct Object *ob,
+                               GPUBatch *geom,
+                               uint v_sta,
+                               uint v_ct,
+                               bool bypass_culling)
 {
   BLI_assert(geom != NULL);
   if (G.f & G_FLAG_PICKSEL) {
@@ -801,6 +887,13 @@ void DRW_shgroup_call_range(
   }
   DRWResourceHandle handle = drw_resource_handle(shgroup, ob ? ob->obmat : NULL, ob);
   drw_command_draw_range(shgroup, geom, handle, v_sta, v_ct);
+
+  if (bypass_culling) {
+    DRWCullingState *culling = DRW_memblock_elem_from_handle(DST.vmempool->cullstates,
+                                                             &DST.ob_handle);
+    /* NOTE this will disable culling for the whole object. */
+    culling->bsphere.radius = -1.0f;
+  }
 }
 
 /* A count of 0 instance will use the default number of instance in the batch. */
@@ -1314,6 +1407,31 @@ static void drw_shgroup_material_texture(DRWShadingGroup *grp,
   GPU_texture_ref(gputex);
 }
 
+/**
+ * Same as #BKE_image_get_gpu_texture but returns NULL instead of blocking while the image file
+ * is loaded in the background, in which case the viewport keeps redrawing until it is ready.
+ * Final renders always wait for the image.
+ */
+GPUTexture *DRW_image_gpu_texture_get(Image *ima, ImageUser *iuser)
+{
+  const bool use_async = (DST.draw_ctx.evil_C != NULL) && (DST.viewport != NULL) &&
+                         !DRW_state_is_image_render();
+  if (use_async && BKE_image_gpu_texture_load_async(ima, iuser)) {
+    DRW_viewport_request_redraw();
+    return NULL;
+  }
+  return BKE_image_get_gpu_texture(ima, iuser, NULL);
+}
+
+static GPUTexture *drw_image_placeholder_get(void)
+{
+  if (G_draw.image_placeholder == NULL) {
+    const float pixel[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+    G_draw.image_placeholder = DRW_texture_create_2d(1, 1, GPU_RGBA8, 0, pixel);
+  }
+  return G_draw.image_placeholder;
+}
+
 void DRW_shgroup_add_material_resources(DRWShadingGroup *grp, struct GPUMaterial *material)
 {
   ListBase textures = GPU_material_textures(material);
@@ -1330,7 +1448,10 @@ void DRW_shgroup_add_material_resources(DRWShadingGroup *grp, struct GPUMaterial
         drw_shgroup_material_texture(grp, gputex, tex->tiled_mapping_name, tex->sampler_state);
       }
       else {
-        gputex = BKE_image_get_gpu_texture(tex->ima, tex->iuser, NULL);
+        gputex = DRW_image_gpu_texture_get(tex->ima, tex->iuser);
+        if (gputex == NULL) {
+          gputex = drw_image_placeholder_get();
+        }
         drw_shgroup_material_texture(grp, gputex, tex->sampler_name, tex->sampler_state);
       }
     }
@@ -2109,6 +2230,96 @@ void DRW_pass_sort_shgroup_z(DRWPass *pass)
   pass->shgroups.last = last;
 }
 
+typedef struct DRWCallSortElem {
+  /** Chunk and negative scale bits of the resource handle. */
+  uint32_t handle_chunk;
+  uint32_t handle_id;
+  GPUBatch *batch;
+} DRWCallSortElem;
+
+static int drw_call_sort_cmp(const void *a_, const void *b_)
+{
+  const DRWCallSortElem *a = a_, *b = b_;
+  if (a->handle_chunk != b->handle_chunk) {
+    return (a->handle_chunk < b->handle_chunk) ? -1 : 1;
+  }
+  if (a->batch != b->batch) {
+    return ((uintptr_t)a->batch < (uintptr_t)b->batch) ? -1 : 1;
+  }
+  if (a->handle_id != b->handle_id) {
+    return (a->handle_id < b->handle_id) ? -1 : 1;
+  }
+  return 0;
+}
+
+static void drw_shgroup_sort_calls_by_batch(DRWShadingGroup *shgroup)
+{
+  /* Only the draw calls at the end of the commands can be reordered. */
+  int draw_len = 0, batch_runs = 0;
+  GPUBatch *batch_prev = NULL;
+  LISTBASE_FOREACH (DRWCommandChunk *, chunk, &shgroup->cmd) {
+    for (int i = 0; i < chunk->command_used; i++) {
+      if (command_type_get(chunk->command_type, i) != DRW_CMD_DRAW) {
+        if (draw_len > 0) {
+          return;
+        }
+        continue;
+      }
+      GPUBatch *batch = chunk->commands[i].draw.batch;
+      batch_runs += (batch != batch_prev);
+      batch_prev = batch;
+      draw_len++;
+    }
+  }
+
+  /* Skip when the calls are already mostly grouped (e.g. instances from the same dupli-list). */
+  if (batch_runs < 16 || batch_runs * 8 < draw_len) {
+    return;
+  }
+
+  DRWCallSortElem *elems = MEM_mallocN(sizeof(*elems) * draw_len, __func__);
+  int elem_index = 0;
+  LISTBASE_FOREACH (DRWCommandChunk *, chunk, &shgroup->cmd) {
+    for (int i = 0; i < chunk->command_used; i++) {
+      if (command_type_get(chunk->command_type, i) == DRW_CMD_DRAW) {
+        const DRWCommandDraw *draw = &chunk->commands[i].draw;
+        elems[elem_index].handle_chunk = draw->handle & ~0x1FFu;
+        elems[elem_index].handle_id = DRW_handle_id_get(&draw->handle);
+        elems[elem_index].batch = draw->batch;
+        elem_index++;
+      }
+    }
+  }
+
+  qsort(elems, draw_len, sizeof(*elems), drw_call_sort_cmp);
+
+  elem_index = 0;
+  LISTBASE_FOREACH (DRWCommandChunk *, chunk, &shgroup->cmd) {
+    for (int i = 0; i < chunk->command_used; i++) {
+      if (command_type_get(chunk->command_type, i) == DRW_CMD_DRAW) {
+        DRWCommandDraw *draw = &chunk->commands[i].draw;
+        draw->handle = elems[elem_index].handle_chunk | elems[elem_index].handle_id;
+        draw->batch = elems[elem_index].batch;
+        elem_index++;
+      }
+    }
+  }
+
+  MEM_freeN(elems);
+}
+
+/**
+ * Reorder the draw calls inside each shading group of the pass so that the calls using the same
+ * batch are consecutive, which lets them be merged into instanced draws. Only use it for passes
+ * where the draw order doesn't change the result (e.g. opaque geometry with depth test).
+ */
+void DRW_pass_sort_calls_by_batch(DRWPass *pass)
+{
+  for (DRWShadingGroup *shgroup = pass->shgroups.first; shgroup; shgroup = shgroup->next) {
+    drw_shgroup_sort_calls_by_batch(shgroup);
+  }
+}
+
 /**
  * Reverse Shading group submission order.
  */
@@ -26,6 +26,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -87,6 +88,8 @@ void drw_state_set(DRWState state)
     return;
   }
 
+  DST.stats_state_change_len++;
+
   eGPUWriteMask write_mask = 0;
   eGPUBlend blend = 0;
   eGPUFaceCullTest culling_test = 0;
@@ -485,45 +488,91 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+static void draw_compute_culling_state(const DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+typedef struct DRWCullingTaskData {
+  const DRWView *view;
+  int chunk_last;
+  int chunk_last_elem_len;
+} DRWCullingTaskData;
+
+static void draw_compute_culling_task(void *__restrict userdata,
+                                      const int chunk,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWCullingTaskData *data = userdata;
+  const int elem_len = (chunk == data->chunk_last) ? data->chunk_last_elem_len :
+                                                     DRW_RESOURCE_CHUNK_LEN;
+  for (int elem = 0; elem < elem_len; elem++) {
+    DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, elem);
+    draw_compute_culling_state(data->view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem): multi-thread this. */
   /* TODO(fclem): compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
-
+  /* Visibility callbacks are not thread safe (they can write to the engine data of objects
+   * shared by several resources), nor is drawing debug spheres. */
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  const bool use_threading = false;
+#else
+  const bool use_threading = (view->visibility_fn == NULL);
 #endif
 
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  if (use_threading) {
+    /* One culling state per resource handle, stored in chunks of #DRW_RESOURCE_CHUNK_LEN. */
+    DRWCullingTaskData data = {
+        .view = view,
+        .chunk_last = DRW_handle_chunk_get(&DST.resource_handle),
+        .chunk_last_elem_len = DRW_handle_id_get(&DST.resource_handle),
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(
+        0, data.chunk_last + 1, &data, draw_compute_culling_task, &settings);
+  }
+  else {
+    BLI_memblock_iter iter;
+    BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
+    DRWCullingState *cull;
+    while ((cull = BLI_memblock_iterstep(&iter))) {
+      draw_compute_culling_state(view, cull);
     }
   }
 
@@ -582,6 +631,7 @@ BLI_INLINE void draw_geometry_execute(DRWShadingGroup *shgroup,
   }
 
   GPU_batch_draw_advanced(geom, vert_first, vert_count, inst_first, inst_count);
+  DST.stats_draw_call_len++;
 }
 
 BLI_INLINE void draw_indirect_call(DRWShadingGroup *shgroup, DRWCommandsState *state)
@@ -596,6 +646,7 @@ BLI_INLINE void draw_indirect_call(DRWShadingGroup *shgroup, DRWCommandsState *s
       draw_geometry_bind(shgroup, state->batch);
     }
     GPU_draw_list_append(DST.draw_list, state->batch, state->base_inst, state->inst_count);
+    DST.stats_draw_call_len++;
   }
   /* Fallback when unsupported */
   else {
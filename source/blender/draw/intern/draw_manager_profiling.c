@@ -20,6 +20,9 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -30,6 +33,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "PIL_time.h"
+
 #include "draw_manager.h"
 
 #include "GPU_debug.h"
@@ -45,38 +50,76 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 typedef struct DRWTimer {
-  uint32_t query[2];
+  /** Index of the GPU timer inside the pool of the frame, -1 for groups. */
+  int query;
   uint64_t time_average;
+  /** GPU time of the last frame the result was read for, in nanoseconds. */
+  uint64_t time_last;
+  /** CPU time in seconds, the start is relative to the beginning of the frame. */
+  double cpu_start, cpu_time;
+  /** Draw calls and state changes issued between the start and the end of the timer. */
+  uint draw_call_len, state_change_len;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
   bool is_query; /* Does this timer actually perform queries or is it just a group. */
 } DRWTimer;
 
+typedef struct DRWEngineTimer {
+  char name[MAX_TIMER_NAME];
+  double init_time, background_time, render_time;
+} DRWEngineTimer;
+
 static struct DRWTimerPool {
   DRWTimer *timers;
   int chunk_count;     /* Number of chunk allocated. */
   int timer_count;     /* chunk_count * CHUNK_SIZE */
   int timer_increment; /* Keep track of where we are in the stack. */
-  int end_increment;   /* Keep track of bad usage. */
-  bool is_recording;   /* Are we in the render loop? */
-  bool is_querying;    /* Keep track of bad usage. */
+  /** Timers started but not ended yet. */
+  int stack[MAX_NESTED_TIMER];
+  int stack_len;
+  /** GPU timers of the current and previous frame. Reading the results is a sync point so
+   * the results of a frame are only read at the end of the next one. */
+  GPUTimerPool *gpu_timers[2];
+  int gpu_timers_len[2];
+  int gpu_timers_current;
+  double frame_start;
+  /** Copy of the engines timings, the engine data isn't accessible after the redraw. */
+  DRWEngineTimer *engines;
+  int engine_count;
+  bool is_enabled;   /* Recording requested by #DRW_stats_enable. */
+  bool is_recording; /* Are we in the render loop? */
+  bool is_querying;  /* Keep track of bad usage. */
 } DTP = {NULL};
 
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
+  for (int i = 0; i < 2; i++) {
+    if (DTP.gpu_timers[i] != NULL) {
+      GPU_timer_pool_free(DTP.gpu_timers[i]);
+      DTP.gpu_timers[i] = NULL;
+    }
+    DTP.gpu_timers_len[i] = 0;
+  }
+  MEM_SAFE_FREE(DTP.engines);
+  DTP.engine_count = 0;
+}
+
+/**
+ * Record the timings of the following redraws, without the debug overlay
+ * enabled by the debug values 21 to 29.
+ */
+void DRW_stats_enable(bool enable)
+{
+  DTP.is_enabled = enable;
 }
 
 void DRW_stats_begin(void)
 {
-  if (G.debug_value > 20 && G.debug_value < 30) {
+  if ((G.debug_value > 20 && G.debug_value < 30) || DTP.is_enabled) {
     DTP.is_recording = true;
   }
 
@@ -89,9 +132,21 @@ void DRW_stats_begin(void)
     DRW_stats_free();
   }
 
+  if (DTP.is_recording) {
+    /* The pool of the frame before the previous one has been read. */
+    DTP.gpu_timers_current = !DTP.gpu_timers_current;
+    GPUTimerPool **pool = &DTP.gpu_timers[DTP.gpu_timers_current];
+    if (*pool != NULL) {
+      GPU_timer_pool_free(*pool);
+    }
+    *pool = GPU_timer_pool_create();
+    DTP.gpu_timers_len[DTP.gpu_timers_current] = 0;
+    DTP.frame_start = PIL_check_seconds_timer();
+  }
+
   DTP.is_querying = false;
   DTP.timer_increment = 0;
-  DTP.end_increment = 0;
+  DTP.stack_len = 0;
 }
 
 static DRWTimer *drw_stats_timer_get(void)
@@ -109,26 +164,36 @@ static DRWTimer *drw_stats_timer_get(void)
 static void drw_stats_timer_start_ex(const char *name, const bool is_query)
 {
   if (DTP.is_recording) {
+    BLI_assert(DTP.stack_len < MAX_NESTED_TIMER);
     DRWTimer *timer = drw_stats_timer_get();
     BLI_strncpy(timer->name, name, MAX_TIMER_NAME);
-    timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
+    timer->lvl = DTP.stack_len;
     timer->is_query = is_query;
+    timer->query = -1;
+    timer->cpu_start = PIL_check_seconds_timer() - DTP.frame_start;
+    timer->draw_call_len = DST.stats_draw_call_len;
+    timer->state_change_len = DST.stats_state_change_len;
+    DTP.stack[DTP.stack_len++] = DTP.timer_increment - 1;
 
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
+      timer->query = DTP.gpu_timers_len[DTP.gpu_timers_current]++;
+      GPU_timer_begin(DTP.gpu_timers[DTP.gpu_timers_current]);
       DTP.is_querying = true;
     }
   }
 }
 
+static void drw_stats_timer_end(void)
+{
+  BLI_assert(DTP.stack_len > 0);
+  DRWTimer *timer = &DTP.timers[DTP.stack[--DTP.stack_len]];
+  timer->cpu_time = PIL_check_seconds_timer() - DTP.frame_start - timer->cpu_start;
+  timer->draw_call_len = DST.stats_draw_call_len - timer->draw_call_len;
+  timer->state_change_len = DST.stats_state_change_len - timer->state_change_len;
+}
+
 /* Use this to group the queries. It does NOT keep track
  * of the time, it only sum what the queries inside it. */
 void DRW_stats_group_start(const char *name)
@@ -143,7 +208,7 @@ void DRW_stats_group_end(void)
   GPU_debug_group_end();
   if (DTP.is_recording) {
     BLI_assert(!DTP.is_querying);
-    DTP.end_increment++;
+    drw_stats_timer_end();
   }
 }
 
@@ -151,7 +216,6 @@ void DRW_stats_group_end(void)
 void DRW_stats_query_start(const char *name)
 {
   GPU_debug_group_begin(name);
-  drw_stats_timer_start_ex(name, false);
   drw_stats_timer_start_ex(name, true);
 }
 
@@ -159,55 +223,173 @@ void DRW_stats_query_end(void)
 {
   GPU_debug_group_end();
   if (DTP.is_recording) {
-    DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    GPU_timer_end(DTP.gpu_timers[DTP.gpu_timers_current]);
     DTP.is_querying = false;
+    drw_stats_timer_end();
+  }
+}
+
+static void drw_stats_engines_store(void)
+{
+  if (DTP.engine_count < DST.enabled_engine_count) {
+    DTP.engines = MEM_recallocN(DTP.engines, sizeof(*DTP.engines) * DST.enabled_engine_count);
+  }
+  DTP.engine_count = 0;
+  LISTBASE_FOREACH (LinkData *, link, &DST.enabled_engines) {
+    DrawEngineType *engine = link->data;
+    ViewportEngineData *data = drw_viewport_engine_data_ensure(engine);
+    DRWEngineTimer *engine_timer = &DTP.engines[DTP.engine_count++];
+    BLI_strncpy(engine_timer->name, engine->idname, sizeof(engine_timer->name));
+    engine_timer->init_time = data->init_time;
+    engine_timer->background_time = data->background_time;
+    engine_timer->render_time = data->render_time;
   }
 }
 
 void DRW_stats_reset(void)
 {
-  BLI_assert((DTP.timer_increment - DTP.end_increment) <= 0 &&
-             "You forgot a DRW_stats_group/query_end somewhere!");
-  BLI_assert((DTP.timer_increment - DTP.end_increment) >= 0 &&
-             "You forgot a DRW_stats_group/query_start somewhere!");
+  BLI_assert(DTP.stack_len <= 0 && "You forgot a DRW_stats_group/query_end somewhere!");
+  BLI_assert(DTP.stack_len >= 0 && "You forgot a DRW_stats_group/query_start somewhere!");
 
   if (DTP.is_recording) {
     uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
+    uint64_t lvl_time_last[MAX_NESTED_TIMER] = {0};
+
+    /* Results of the previous frame, only usable if it issued the same queries. */
+    const int previous = !DTP.gpu_timers_current;
+    const int query_len = DTP.gpu_timers_len[DTP.gpu_timers_current];
+    uint64_t *query_times = NULL;
+    if (DTP.gpu_timers[previous] != NULL && DTP.gpu_timers_len[previous] == query_len &&
+        query_len > 0) {
+      query_times = MEM_mallocN(sizeof(*query_times) * query_len, __func__);
+      GPU_timer_pool_results_get(DTP.gpu_timers[previous], query_times, query_len);
+    }
 
-    /* Swap queries for the next frame and sum up each lvl time. */
+    /* Sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(uint32_t, timer->query[0], timer->query[1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
       if (timer->is_query) {
-        uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
+        if (query_times != NULL) {
+          timer->time_last = query_times[timer->query];
+          timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
+                                timer->time_last * GPU_TIMER_FALLOFF;
+          timer->time_average = MIN2(timer->time_average, 1000000000);
         }
-        else {
-          time = 1000000000; /* 1ms default */
-        }
-
-        timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
-                              time * GPU_TIMER_FALLOFF;
-        timer->time_average = MIN2(timer->time_average, 1000000000);
       }
       else {
         timer->time_average = lvl_time[timer->lvl + 1];
+        timer->time_last = lvl_time_last[timer->lvl + 1];
         lvl_time[timer->lvl + 1] = 0;
+        lvl_time_last[timer->lvl + 1] = 0;
       }
 
       lvl_time[timer->lvl] += timer->time_average;
+      lvl_time_last[timer->lvl] += timer->time_last;
     }
 
+    MEM_SAFE_FREE(query_times);
+
+    drw_stats_engines_store();
+
     DTP.is_recording = false;
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Report
+ *
+ * Timings of the last recorded redraw, for automated performance testing.
+ * \{ */
+
+int DRW_stats_timer_len(void)
+{
+  return (DTP.timers != NULL) ? DTP.timer_increment : 0;
+}
+
+void DRW_stats_timer_info_get(int index, DRWStatsTimerInfo *r_info)
+{
+  BLI_assert(index < DRW_stats_timer_len());
+  const DRWTimer *timer = &DTP.timers[index];
+  r_info->name = timer->name;
+  r_info->level = timer->lvl;
+  r_info->is_pass = timer->is_query;
+  r_info->cpu_start = timer->cpu_start * 1e3;
+  r_info->cpu_time = timer->cpu_time * 1e3;
+  r_info->gpu_time = timer->time_last / 1000000.0;
+  r_info->draw_call_len = timer->draw_call_len;
+  r_info->state_change_len = timer->state_change_len;
+}
+
+int DRW_stats_engine_len(void)
+{
+  return DTP.engine_count;
+}
+
+void DRW_stats_engine_info_get(int index, DRWStatsEngineInfo *r_info)
+{
+  BLI_assert(index < DTP.engine_count);
+  const DRWEngineTimer *engine_timer = &DTP.engines[index];
+  r_info->name = engine_timer->name;
+  r_info->init_time = engine_timer->init_time;
+  r_info->background_time = engine_timer->background_time;
+  r_info->render_time = engine_timer->render_time;
+}
+
+/**
+ * Write the timers of the last recorded redraw in the Chrome trace event format
+ * (readable by `chrome://tracing` or Perfetto). GPU times are stored in the event arguments
+ * since they aren't aligned with the CPU timeline.
+ */
+bool DRW_stats_trace_write(const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file, "{\"traceEvents\": [\n");
+  const int timer_len = DRW_stats_timer_len();
+  for (int i = 0; i < timer_len; i++) {
+    DRWStatsTimerInfo info;
+    DRW_stats_timer_info_get(i, &info);
+    /* Timestamps are in microseconds. */
+    fprintf(file,
+            "{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, "
+            "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"gpu_time_ms\": %.4f, "
+            "\"draw_calls\": %u, \"state_changes\": %u}},\n",
+            info.name,
+            info.is_pass ? "pass" : "group",
+            info.cpu_start * 1e3,
+            info.cpu_time * 1e3,
+            info.gpu_time,
+            info.draw_call_len,
+            info.state_change_len);
+  }
+  /* Engines timings are averaged over several redraws, store them as metadata. */
+  fprintf(file, "{\"name\": \"engines\", \"ph\": \"M\", \"pid\": 0, \"args\": {");
+  for (int i = 0; i < DTP.engine_count; i++) {
+    const DRWEngineTimer *engine_timer = &DTP.engines[i];
+    fprintf(file,
+            "%s\"%s\": {\"init_ms\": %.4f, \"background_ms\": %.4f, \"render_ms\": %.4f}",
+            (i > 0) ? ", " : "",
+            engine_timer->name,
+            engine_timer->init_time,
+            engine_timer->background_time,
+            engine_timer->render_time);
+  }
+  fprintf(file, "}}\n]}\n");
+
+  const bool success = (ferror(file) == 0);
+  fclose(file);
+  return success;
+}
+
+/** \} */
+
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
 {
   BLF_draw_default_ascii(rect->xmin + (1 + u * 5) * U.widget_unit,
@@ -67,21 +67,37 @@ typedef struct DRWDeferredShader {
   GPUMaterial *mat;
 } DRWDeferredShader;
 
-typedef struct DRWShaderCompiler {
-  ListBase queue;          /* DRWDeferredShader */
-  ListBase queue_conclude; /* DRWDeferredShader */
-  SpinLock list_lock;
+/* Maximum number of GL contexts compiling shaders concurrently. */
+#define DRW_SHADER_COMPILER_WORKERS_MAX 8
 
+typedef struct DRWShaderCompilerWorker {
   DRWDeferredShader *mat_compiling;
   ThreadMutex compilation_lock;
 
   void *gl_context;
   GPUContext *gpu_context;
+} DRWShaderCompilerWorker;
+
+typedef struct DRWShaderCompiler {
+  ListBase queue;          /* DRWDeferredShader */
+  ListBase queue_conclude; /* DRWDeferredShader */
+  SpinLock list_lock;
+
+  DRWShaderCompilerWorker workers[DRW_SHADER_COMPILER_WORKERS_MAX];
+  int workers_len;
   bool own_context;
 
   int shaders_done; /* To compute progress. */
 } DRWShaderCompiler;
 
+typedef struct DRWShaderCompilerThreadData {
+  DRWShaderCompiler *comp;
+  DRWShaderCompilerWorker *worker;
+  short *stop;
+  short *do_update;
+  float *progress;
+} DRWShaderCompilerThreadData;
+
 static void drw_deferred_shader_free(DRWDeferredShader *dsh)
 {
   /* Make sure it is not queued before freeing. */
@@ -96,34 +112,29 @@ static void drw_deferred_shader_queue_free(ListBase *queue)
   }
 }
 
-static void drw_deferred_shader_compilation_exec(
-    void *custom_data,
-    /* Cannot be const, this function implements wm_jobs_start_callback.
-     * NOLINTNEXTLINE: readability-non-const-parameter. */
-    short *stop,
-    short *do_update,
-    float *progress)
+static int drw_deferred_shader_workers_len(void)
 {
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
-  GPUContext *gpu_context = comp->gpu_context;
-
-  BLI_assert(gl_context != NULL);
-  BLI_assert(gpu_context != NULL);
-
-  const bool use_main_context_workaround = GPU_use_main_context_workaround();
-  if (use_main_context_workaround) {
-    BLI_assert(gl_context == DST.gl_context);
-    GPU_context_main_lock();
+  if (GPU_use_main_context_workaround()) {
+    /* Everything has to happen in the main context. */
+    return 1;
   }
+  /* Each worker needs its own GL context, leave some threads for the drivers. */
+  return max_ii(1, min_ii(BLI_system_thread_count() / 2, DRW_SHADER_COMPILER_WORKERS_MAX));
+}
 
-  WM_opengl_context_activate(gl_context);
-  GPU_context_active_set(gpu_context);
+/* Compile queued materials until the queue is empty, using the worker's context. */
+static void drw_deferred_shader_compilation_worker_exec(DRWShaderCompilerThreadData *data)
+{
+  DRWShaderCompiler *comp = data->comp;
+  DRWShaderCompilerWorker *worker = data->worker;
+
+  WM_opengl_context_activate(worker->gl_context);
+  GPU_context_active_set(worker->gpu_context);
 
   while (true) {
     BLI_spin_lock(&comp->list_lock);
 
-    if (*stop != 0) {
+    if (*data->stop != 0) {
       /* We don't want user to be able to cancel the compilation
        * but wm can kill the task if we are closing blender. */
       BLI_spin_unlock(&comp->list_lock);
@@ -131,42 +142,98 @@ static void drw_deferred_shader_compilation_exec(
     }
 
     /* Pop tail because it will be less likely to lock the main thread
-     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    comp->mat_compiling = BLI_poptail(&comp->queue);
-    if (comp->mat_compiling == NULL) {
+     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()).
+     * This is also where materials requested by the last redraw are moved to. */
+    worker->mat_compiling = BLI_poptail(&comp->queue);
+    if (worker->mat_compiling == NULL) {
       /* No more Shader to compile. */
       BLI_spin_unlock(&comp->list_lock);
       break;
     }
 
-    comp->shaders_done++;
-    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
-
-    BLI_mutex_lock(&comp->compilation_lock);
+    BLI_mutex_lock(&worker->compilation_lock);
     BLI_spin_unlock(&comp->list_lock);
 
     /* Do the compilation. */
-    GPU_material_compile(comp->mat_compiling->mat);
-
-    *progress = (float)comp->shaders_done / (float)total;
-    *do_update = true;
+    GPU_material_compile(worker->mat_compiling->mat);
 
     GPU_flush();
-    BLI_mutex_unlock(&comp->compilation_lock);
+    BLI_mutex_unlock(&worker->compilation_lock);
 
     BLI_spin_lock(&comp->list_lock);
-    if (GPU_material_status(comp->mat_compiling->mat) == GPU_MAT_QUEUED) {
-      BLI_addtail(&comp->queue_conclude, comp->mat_compiling);
+    comp->shaders_done++;
+    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
+    *data->progress = (float)comp->shaders_done / (float)total;
+    *data->do_update = true;
+
+    if (GPU_material_status(worker->mat_compiling->mat) == GPU_MAT_QUEUED) {
+      BLI_addtail(&comp->queue_conclude, worker->mat_compiling);
     }
     else {
-      drw_deferred_shader_free(comp->mat_compiling);
+      drw_deferred_shader_free(worker->mat_compiling);
     }
-    comp->mat_compiling = NULL;
+    worker->mat_compiling = NULL;
     BLI_spin_unlock(&comp->list_lock);
   }
 
   GPU_context_active_set(NULL);
-  WM_opengl_context_release(gl_context);
+  WM_opengl_context_release(worker->gl_context);
+}
+
+static void *drw_deferred_shader_compilation_thread(void *data_v)
+{
+  drw_deferred_shader_compilation_worker_exec((DRWShaderCompilerThreadData *)data_v);
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(
+    void *custom_data,
+    /* Cannot be const, this function implements wm_jobs_start_callback.
+     * NOLINTNEXTLINE: readability-non-const-parameter. */
+    short *stop,
+    short *do_update,
+    float *progress)
+{
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+
+  BLI_assert(comp->workers_len > 0);
+  BLI_assert(comp->workers[0].gl_context != NULL);
+  BLI_assert(comp->workers[0].gpu_context != NULL);
+
+  const bool use_main_context_workaround = GPU_use_main_context_workaround();
+  if (use_main_context_workaround) {
+    BLI_assert(comp->workers_len == 1);
+    BLI_assert(comp->workers[0].gl_context == DST.gl_context);
+    GPU_context_main_lock();
+  }
+
+  DRWShaderCompilerThreadData thread_data[DRW_SHADER_COMPILER_WORKERS_MAX];
+  for (int i = 0; i < comp->workers_len; i++) {
+    thread_data[i] = (DRWShaderCompilerThreadData){
+        .comp = comp,
+        .worker = &comp->workers[i],
+        .stop = stop,
+        .do_update = do_update,
+        .progress = progress,
+    };
+  }
+
+  /* The job thread runs the first worker, the others get their own thread. */
+  ListBase threads = {NULL, NULL};
+  const int threads_len = comp->workers_len - 1;
+  if (threads_len > 0) {
+    BLI_threadpool_init(&threads, drw_deferred_shader_compilation_thread, threads_len);
+    for (int i = 1; i < comp->workers_len; i++) {
+      BLI_threadpool_insert(&threads, &thread_data[i]);
+    }
+  }
+
+  drw_deferred_shader_compilation_worker_exec(&thread_data[0]);
+
+  if (threads_len > 0) {
+    BLI_threadpool_end(&threads);
+  }
+
   if (use_main_context_workaround) {
     GPU_context_main_unlock();
   }
@@ -190,15 +257,21 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   }
 
   BLI_spin_end(&comp->list_lock);
-  BLI_mutex_end(&comp->compilation_lock);
 
-  if (comp->own_context) {
-    /* Only destroy if the job owns the context. */
-    WM_opengl_context_activate(comp->gl_context);
-    GPU_context_active_set(comp->gpu_context);
-    GPU_context_discard(comp->gpu_context);
-    WM_opengl_context_dispose(comp->gl_context);
+  for (int i = 0; i < comp->workers_len; i++) {
+    DRWShaderCompilerWorker *worker = &comp->workers[i];
+    BLI_mutex_end(&worker->compilation_lock);
 
+    if (comp->own_context) {
+      /* Only destroy if the job owns the context. */
+      WM_opengl_context_activate(worker->gl_context);
+      GPU_context_active_set(worker->gpu_context);
+      GPU_context_discard(worker->gpu_context);
+      WM_opengl_context_dispose(worker->gl_context);
+    }
+  }
+
+  if (comp->own_context) {
     wm_window_reset_drawable();
   }
 
@@ -240,16 +313,18 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   DRWShaderCompiler *comp = MEM_callocN(sizeof(DRWShaderCompiler), "DRWShaderCompiler");
   BLI_spin_init(&comp->list_lock);
-  BLI_mutex_init(&comp->compilation_lock);
 
   if (old_comp) {
     BLI_spin_lock(&old_comp->list_lock);
     BLI_movelisttolist(&comp->queue, &old_comp->queue);
     BLI_spin_unlock(&old_comp->list_lock);
-    /* Do not recreate context, just pass ownership. */
-    if (old_comp->gl_context) {
-      comp->gl_context = old_comp->gl_context;
-      comp->gpu_context = old_comp->gpu_context;
+    /* Do not recreate contexts, just pass ownership. */
+    if (old_comp->workers_len > 0) {
+      comp->workers_len = old_comp->workers_len;
+      for (int i = 0; i < comp->workers_len; i++) {
+        comp->workers[i].gl_context = old_comp->workers[i].gl_context;
+        comp->workers[i].gpu_context = old_comp->workers[i].gpu_context;
+      }
       old_comp->own_context = false;
       comp->own_context = job_own_context;
     }
@@ -257,16 +332,20 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   BLI_addtail(&comp->queue, dsh);
 
-  /* Create only one context. */
-  if (comp->gl_context == NULL) {
+  /* Create the contexts only once, this has to happen in the main thread. */
+  if (comp->workers_len == 0) {
     if (use_main_context) {
-      comp->gl_context = DST.gl_context;
-      comp->gpu_context = DST.gpu_context;
+      comp->workers_len = 1;
+      comp->workers[0].gl_context = DST.gl_context;
+      comp->workers[0].gpu_context = DST.gpu_context;
     }
     else {
-      comp->gl_context = WM_opengl_context_create();
-      comp->gpu_context = GPU_context_create(NULL);
-      GPU_context_active_set(NULL);
+      comp->workers_len = drw_deferred_shader_workers_len();
+      for (int i = 0; i < comp->workers_len; i++) {
+        comp->workers[i].gl_context = WM_opengl_context_create();
+        comp->workers[i].gpu_context = GPU_context_create(NULL);
+        GPU_context_active_set(NULL);
+      }
 
       WM_opengl_context_activate(DST.gl_context);
       GPU_context_active_set(DST.gpu_context);
@@ -274,6 +353,10 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
     comp->own_context = job_own_context;
   }
 
+  for (int i = 0; i < comp->workers_len; i++) {
+    BLI_mutex_init(&comp->workers[i].compilation_lock);
+  }
+
   WM_jobs_customdata_set(wm_job, comp, drw_deferred_shader_compilation_free);
   WM_jobs_timer(wm_job, 0.1, NC_MATERIAL | ND_SHADING_DRAW, 0);
   WM_jobs_delay_start(wm_job, 0.1);
@@ -284,6 +367,33 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
   WM_jobs_start(wm, wm_job);
 }
 
+/**
+ * Move a material that is still waiting for compilation at the end of the queue so it is
+ * compiled next. Called for materials requested by the current redraw, so what is visible
+ * gets shaded first.
+ */
+static void drw_deferred_shader_prioritize(GPUMaterial *mat)
+{
+  if (DST.draw_ctx.evil_C == NULL) {
+    return;
+  }
+  wmWindowManager *wm = CTX_wm_manager(DST.draw_ctx.evil_C);
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)WM_jobs_customdata_from_type(
+      wm, WM_JOB_TYPE_SHADER_COMPILATION);
+  if (comp == NULL) {
+    return;
+  }
+
+  BLI_spin_lock(&comp->list_lock);
+  DRWDeferredShader *dsh = (DRWDeferredShader *)BLI_findptr(
+      &comp->queue, mat, offsetof(DRWDeferredShader, mat));
+  if (dsh != NULL && dsh != comp->queue.last) {
+    BLI_remlink(&comp->queue, dsh);
+    BLI_addtail(&comp->queue, dsh);
+  }
+  BLI_spin_unlock(&comp->list_lock);
+}
+
 void DRW_deferred_shader_remove(GPUMaterial *mat)
 {
   Scene *scene = GPU_material_scene(mat);
@@ -308,9 +418,12 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
         }
 
         /* Wait for compilation to finish */
-        if ((comp->mat_compiling != NULL) && (comp->mat_compiling->mat == mat)) {
-          BLI_mutex_lock(&comp->compilation_lock);
-          BLI_mutex_unlock(&comp->compilation_lock);
+        for (int i = 0; i < comp->workers_len; i++) {
+          DRWShaderCompilerWorker *worker = &comp->workers[i];
+          if ((worker->mat_compiling != NULL) && (worker->mat_compiling->mat == mat)) {
+            BLI_mutex_lock(&worker->compilation_lock);
+            BLI_mutex_unlock(&worker->compilation_lock);
+          }
         }
 
         BLI_spin_unlock(&comp->list_lock);
@@ -438,6 +551,9 @@ GPUMaterial *DRW_shader_find_from_world(World *wo,
       return NULL;
     }
   }
+  else if (mat != NULL && GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_shader_prioritize(mat);
+  }
   return mat;
 }
 
@@ -454,6 +570,9 @@ GPUMaterial *DRW_shader_find_from_material(Material *ma,
       return NULL;
     }
   }
+  else if (mat != NULL && GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_shader_prioritize(mat);
+  }
   return mat;
 }
 
@@ -24,9 +24,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_bitmap.h"
 #include "BLI_bitmap_draw_2d.h"
+#include "BLI_math_base.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 
 #include "DNA_screen_types.h"
 
@@ -121,6 +125,97 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
  *
  * \{ */
 
+/**
+ * Enable the indices found in a span of the ID buffer.
+ * Neighbor pixels mostly contain the same ID, the bitmap is only accessed when it changes.
+ * Atomic so spans can be processed from multiple threads.
+ */
+static void drw_select_bitmap_enable_span(BLI_bitmap *bitmap,
+                                          const uint bitmap_len,
+                                          const uint *buf,
+                                          const int span_len)
+{
+  /* Intentionally wrap to max value if the ID is zero. */
+  uint index_prev = UINT_MAX;
+  for (int i = 0; i < span_len; i++) {
+    const uint index = buf[i] - 1;
+    if (index != index_prev) {
+      index_prev = index;
+      if (index < bitmap_len && !BLI_BITMAP_TEST(bitmap, index)) {
+        atomic_fetch_and_or_uint32(&bitmap[index >> _BITMAP_POWER],
+                                   1u << (index & _BITMAP_MASK));
+      }
+    }
+  }
+}
+
+typedef struct SelectBitmapRowsData {
+  const uint *buf;
+  BLI_bitmap *bitmap;
+  uint bitmap_len;
+  /** Width of the buffer rows. */
+  int width;
+  /** Only read the pixels inside of the circle of this radius. */
+  bool use_circle;
+  int radius;
+} SelectBitmapRowsData;
+
+static void drw_select_bitmap_rows_cb(void *__restrict userdata,
+                                      const int y,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SelectBitmapRowsData *data = userdata;
+  const uint *row = data->buf + (size_t)y * data->width;
+
+  if (!data->use_circle) {
+    drw_select_bitmap_enable_span(data->bitmap, data->bitmap_len, row, data->width);
+    return;
+  }
+
+  /* Span of the pixels inside the circle, where `xc * xc + yc * yc < radius * radius`. */
+  const int yc = y - data->radius;
+  const int rem = data->radius * data->radius - yc * yc;
+  if (rem <= 0) {
+    return;
+  }
+  int xc_max = (int)sqrtf((float)rem);
+  while (xc_max * xc_max >= rem) {
+    xc_max--;
+  }
+  while ((xc_max + 1) * (xc_max + 1) < rem) {
+    xc_max++;
+  }
+  drw_select_bitmap_enable_span(
+      data->bitmap, data->bitmap_len, row + data->radius - xc_max, 2 * xc_max + 1);
+}
+
+static BLI_bitmap *drw_select_bitmap_from_rows(const uint *buf,
+                                               const uint bitmap_len,
+                                               const int width,
+                                               const int height,
+                                               const bool use_circle,
+                                               const int radius)
+{
+  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
+
+  SelectBitmapRowsData data = {
+      .buf = buf,
+      .bitmap = bitmap_buf,
+      .bitmap_len = bitmap_len,
+      .width = width,
+      .use_circle = use_circle,
+      .radius = radius,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)width * height) > 256 * 256;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, height, &data, drw_select_bitmap_rows_cb, &settings);
+
+  return bitmap_buf;
+}
+
 /**
  * \param rect: The rectangle to sample indices from (min/max inclusive).
  * \returns a #BLI_bitmap the length of \a bitmap_len or NULL on failure.
@@ -146,15 +241,8 @@ uint *DRW_select_buffer_bitmap_from_rect(struct Depsgraph *depsgraph,
   BLI_assert(select_ctx->index_drawn_len > 0);
   const uint bitmap_len = select_ctx->index_drawn_len - 1;
 
-  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
-  const uint *buf_iter = buf;
-  while (buf_len--) {
-    const uint index = *buf_iter - 1;
-    if (index < bitmap_len) {
-      BLI_BITMAP_ENABLE(bitmap_buf, index);
-    }
-    buf_iter++;
-  }
+  BLI_bitmap *bitmap_buf = drw_select_bitmap_from_rows(
+      buf, bitmap_len, BLI_rcti_size_x(&rect_px), BLI_rcti_size_y(&rect_px), false, 0);
   MEM_freeN((void *)buf);
 
   if (r_bitmap_len) {
@@ -195,20 +283,8 @@ uint *DRW_select_buffer_bitmap_from_circle(struct Depsgraph *depsgraph,
   BLI_assert(select_ctx->index_drawn_len > 0);
   const uint bitmap_len = select_ctx->index_drawn_len - 1;
 
-  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
-  const uint *buf_iter = buf;
-  const int radius_sq = radius * radius;
-  for (int yc = -radius; yc <= radius; yc++) {
-    for (int xc = -radius; xc <= radius; xc++, buf_iter++) {
-      if (xc * xc + yc * yc < radius_sq) {
-        /* Intentionally wrap to max value if this is zero. */
-        const uint index = *buf_iter - 1;
-        if (index < bitmap_len) {
-          BLI_BITMAP_ENABLE(bitmap_buf, index);
-        }
-      }
-    }
-  }
+  BLI_bitmap *bitmap_buf = drw_select_bitmap_from_rows(
+      buf, bitmap_len, 2 * radius + 1, 2 * radius + 1, true, radius);
   MEM_freeN((void *)buf);
 
   if (r_bitmap_len) {
@@ -219,19 +295,17 @@ uint *DRW_select_buffer_bitmap_from_circle(struct Depsgraph *depsgraph,
 }
 
 struct PolyMaskData {
-  BLI_bitmap *px;
+  const uint *buf;
+  BLI_bitmap *bitmap;
+  uint bitmap_len;
   int width;
 };
 
 static void drw_select_mask_px_cb(int x, int x_end, int y, void *user_data)
 {
   struct PolyMaskData *data = user_data;
-  BLI_bitmap *px = data->px;
-  int i = (y * data->width) + x;
-  do {
-    BLI_BITMAP_ENABLE(px, i);
-    i++;
-  } while (++x != x_end);
+  drw_select_bitmap_enable_span(
+      data->bitmap, data->bitmap_len, data->buf + (y * data->width) + x, x_end - x);
 }
 
 /**
@@ -260,10 +334,16 @@ uint *DRW_select_buffer_bitmap_from_poly(struct Depsgraph *depsgraph,
     return NULL;
   }
 
-  BLI_bitmap *buf_mask = BLI_BITMAP_NEW(buf_len, __func__);
+  BLI_assert(select_ctx->index_drawn_len > 0);
+  const uint bitmap_len = select_ctx->index_drawn_len - 1;
+
+  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
 
+  /* Read the ID's directly from the spans inside of the polygon. */
   struct PolyMaskData poly_mask_data;
-  poly_mask_data.px = buf_mask;
+  poly_mask_data.buf = buf;
+  poly_mask_data.bitmap = bitmap_buf;
+  poly_mask_data.bitmap_len = bitmap_len;
   poly_mask_data.width = (rect->xmax - rect->xmin) + 1;
 
   BLI_bitmap_draw_2d_poly_v2i_n(rect_px.xmin,
@@ -275,22 +355,7 @@ uint *DRW_select_buffer_bitmap_from_poly(struct Depsgraph *depsgraph,
                                 drw_select_mask_px_cb,
                                 &poly_mask_data);
 
-  BLI_assert(select_ctx->index_drawn_len > 0);
-  const uint bitmap_len = select_ctx->index_drawn_len - 1;
-
-  BLI_bitmap *bitmap_buf = BLI_BITMAP_NEW(bitmap_len, __func__);
-  const uint *buf_iter = buf;
-  int i = 0;
-  while (buf_len--) {
-    const uint index = *buf_iter - 1;
-    if (index < bitmap_len && BLI_BITMAP_TEST(buf_mask, i)) {
-      BLI_BITMAP_ENABLE(bitmap_buf, index);
-    }
-    buf_iter++;
-    i++;
-  }
   MEM_freeN((void *)buf);
-  MEM_freeN(buf_mask);
 
   if (r_bitmap_len) {
     *r_bitmap_len = bitmap_len;
@@ -25,6 +25,7 @@
 #include "BLI_dlrbTree.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_threads.h"
 
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
@@ -74,14 +75,9 @@ static void motionpaths_calc_update_scene(struct Depsgraph *depsgraph)
   BKE_scene_graph_update_for_newframe(depsgraph);
 }
 
-Depsgraph *animviz_depsgraph_build(Main *bmain,
-                                   Scene *scene,
-                                   ViewLayer *view_layer,
-                                   ListBase *targets)
+/* Build relations for the objects of the targets only. */
+static void motionpaths_graph_build(Depsgraph *depsgraph, ListBase *targets)
 {
-  /* Allocate dependency graph. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
-
   /* Make a flat array of IDs for the DEG API. */
   const int num_ids = BLI_listbase_count(targets);
   ID **ids = MEM_malloc_arrayN(sizeof(ID *), num_ids, "animviz IDS");
@@ -93,6 +89,16 @@ Depsgraph *animviz_depsgraph_build(Main *bmain,
   /* Build graph from all requested IDs. */
   DEG_graph_build_from_ids(depsgraph, ids, num_ids);
   MEM_freeN(ids);
+}
+
+Depsgraph *animviz_depsgraph_build(Main *bmain,
+                                   Scene *scene,
+                                   ViewLayer *view_layer,
+                                   ListBase *targets)
+{
+  /* Allocate dependency graph. */
+  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+  motionpaths_graph_build(depsgraph, targets);
 
   /* Update once so we can access pointers of evaluated animation data. */
   motionpaths_calc_update_scene(depsgraph);
@@ -138,8 +144,29 @@ void animviz_get_object_motionpaths(Object *ob, ListBase *targets)
 
 /* ........ */
 
-/* perform baking for the targets on the current frame */
-static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
+static void motionpath_batches_discard(bMotionPath *mpath)
+{
+  GPU_VERTBUF_DISCARD_SAFE(mpath->points_vbo);
+  GPU_BATCH_DISCARD_SAFE(mpath->batch_line);
+  GPU_BATCH_DISCARD_SAFE(mpath->batch_points);
+}
+
+/* Motion path of the evaluated target, which is updated incrementally. */
+static bMotionPath *motionpath_target_mpath_eval_get(MPathTarget *mpt)
+{
+  if (mpt->pchan) {
+    bPoseChannel *pchan_eval = BKE_pose_channel_find_name(mpt->ob_eval->pose, mpt->pchan->name);
+    return (pchan_eval) ? pchan_eval->mpath : NULL;
+  }
+  return mpt->ob_eval->mpath;
+}
+
+/* perform baking for the targets on the current frame
+ * - depsgraph_frame: when not NULL, the positions are taken from this dependency graph instead of
+ *   the one the targets were set up with, and GPU batches are not freed (see
+ *   #motionpaths_calc_frame_range_parallel)
+ */
+static void motionpaths_calc_bake_targets(ListBase *targets, int cframe, Depsgraph *depsgraph_frame)
 {
   MPathTarget *mpt;
 
@@ -158,6 +185,9 @@ static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
     bMotionPathVert *mpv = mpath->points + (cframe - mpath->start_frame);
 
     Object *ob_eval = mpt->ob_eval;
+    if (depsgraph_frame != NULL) {
+      ob_eval = DEG_get_evaluated_object(depsgraph_frame, mpt->ob);
+    }
 
     /* Lookup evaluated pose channel, here because the depsgraph
      * evaluation can change them so they are not cached in mpt. */
@@ -196,21 +226,14 @@ static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
 
     /* Incremental update on evaluated object if possible, for fast updating
      * while dragging in transform. */
-    bMotionPath *mpath_eval = NULL;
-    if (mpt->pchan) {
-      mpath_eval = (pchan_eval) ? pchan_eval->mpath : NULL;
-    }
-    else {
-      mpath_eval = ob_eval->mpath;
-    }
-
+    bMotionPath *mpath_eval = motionpath_target_mpath_eval_get(mpt);
     if (mpath_eval && mpath_eval->length == mpath->length) {
       bMotionPathVert *mpv_eval = mpath_eval->points + (cframe - mpath_eval->start_frame);
       *mpv_eval = *mpv;
 
-      GPU_VERTBUF_DISCARD_SAFE(mpath_eval->points_vbo);
-      GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_line);
-      GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_points);
+      if (depsgraph_frame == NULL) {
+        motionpath_batches_discard(mpath_eval);
+      }
     }
   }
 }
@@ -346,6 +369,58 @@ static void motionpath_calculate_update_range(MPathTarget *mpt,
   }
 }
 
+/* Frames evaluated by each dependency graph of parallel calculation at least, so that the cost of
+ * building the graphs is amortized. */
+#define MOTIONPATH_PARALLEL_MIN_FRAMES_PER_DEPSGRAPH 8
+
+static void motionpaths_frame_range_build(Depsgraph *depsgraph, void *targets_v)
+{
+  motionpaths_graph_build(depsgraph, targets_v);
+}
+
+static bool motionpaths_frame_range_evaluated(Depsgraph *depsgraph, int frame, void *targets_v)
+{
+  motionpaths_calc_bake_targets(targets_v, frame, depsgraph);
+  return true;
+}
+
+/* Calculate paths using dependency graphs evaluating batches of frames in parallel, which only
+ * contain the targets. The dependency graph of the targets is not changed, so there is nothing to
+ * restore afterwards. Returns false when there are not enough frames to benefit from it. */
+static bool motionpaths_calc_frame_range_parallel(Depsgraph *depsgraph,
+                                                  Main *bmain,
+                                                  ListBase *targets,
+                                                  int sfra,
+                                                  int efra)
+{
+  const int num_frames = efra - sfra + 1;
+  const int num_depsgraphs = min_ii(BLI_system_thread_count(),
+                                    num_frames / MOTIONPATH_PARALLEL_MIN_FRAMES_PER_DEPSGRAPH);
+  if (num_depsgraphs < 2) {
+    return false;
+  }
+
+  SceneFrameRangeSettings settings = {0};
+  settings.frame_start = sfra;
+  settings.frame_end = efra;
+  settings.frame_step = 1;
+  settings.num_depsgraphs = num_depsgraphs;
+  settings.build_fn = motionpaths_frame_range_build;
+  settings.evaluated_fn = motionpaths_frame_range_evaluated;
+  settings.user_data = targets;
+  BKE_scene_graph_evaluate_frame_range(
+      bmain, DEG_get_input_scene(depsgraph), DEG_get_input_view_layer(depsgraph), &settings);
+
+  /* Batches of the evaluated paths are shared between the threads, free them once at the end. */
+  LISTBASE_FOREACH (MPathTarget *, mpt, targets) {
+    bMotionPath *mpath_eval = motionpath_target_mpath_eval_get(mpt);
+    if (mpath_eval != NULL) {
+      motionpath_batches_discard(mpath_eval);
+    }
+  }
+  return true;
+}
+
 static void motionpath_free_free_tree_data(ListBase *targets)
 {
   LISTBASE_FOREACH (MPathTarget *, mpt, targets) {
@@ -464,27 +539,30 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
             sfra,
             efra,
             efra - sfra + 1);
-  for (CFRA = sfra; CFRA <= efra; CFRA++) {
-    if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
-      /* For current frame, only update tagged. */
-      BKE_scene_graph_update_tagged(depsgraph, bmain);
+  if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME ||
+      !motionpaths_calc_frame_range_parallel(depsgraph, bmain, targets, sfra, efra)) {
+    for (CFRA = sfra; CFRA <= efra; CFRA++) {
+      if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
+        /* For current frame, only update tagged. */
+        BKE_scene_graph_update_tagged(depsgraph, bmain);
+      }
+      else {
+        /* Update relevant data for new frame. */
+        motionpaths_calc_update_scene(depsgraph);
+      }
+
+      /* perform baking for targets */
+      motionpaths_calc_bake_targets(targets, CFRA, NULL);
     }
-    else {
-      /* Update relevant data for new frame. */
+
+    /* reset original environment */
+    /* NOTE: We don't always need to reevaluate the main scene, as the depsgraph
+     * may be a temporary one that works on a subset of the data.
+     * We always have to restore the current frame though. */
+    CFRA = cfra;
+    if (range != ANIMVIZ_CALC_RANGE_CURRENT_FRAME && restore) {
       motionpaths_calc_update_scene(depsgraph);
     }
-
-    /* perform baking for targets */
-    motionpaths_calc_bake_targets(targets, CFRA);
-  }
-
-  /* reset original environment */
-  /* NOTE: We don't always need to reevaluate the main scene, as the depsgraph
-   * may be a temporary one that works on a subset of the data.
-   * We always have to restore the current frame though. */
-  CFRA = cfra;
-  if (range != ANIMVIZ_CALC_RANGE_CURRENT_FRAME && restore) {
-    motionpaths_calc_update_scene(depsgraph);
   }
 
   if (is_active_depsgraph) {
@@ -505,8 +583,6 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
     BLI_dlrbTree_free(&mpt->keys);
 
     /* Free previous batches to force update. */
-    GPU_VERTBUF_DISCARD_SAFE(mpath->points_vbo);
-    GPU_BATCH_DISCARD_SAFE(mpath->batch_line);
-    GPU_BATCH_DISCARD_SAFE(mpath->batch_points);
+    motionpath_batches_discard(mpath);
   }
 }
@@ -31,6 +31,8 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "BLT_translation.h"
 
@@ -910,7 +912,7 @@ typedef struct MeshDeformBind {
   MDefBoundIsect *(*boundisect)[6];
   int *semibound;
   int *tag;
-  float *phi, *totalphi;
+  float *totalphi;
 
   /* mesh stuff */
   int *inside;
@@ -1235,6 +1237,7 @@ static float meshdeform_boundary_phi(const MeshDeformBind *mdb,
 }
 
 static float meshdeform_interp_w(MeshDeformBind *mdb,
+                                 const float *phi,
                                  const float *gridvec,
                                  float *UNUSED(vec),
                                  int UNUSED(cagevert))
@@ -1284,7 +1287,7 @@ static float meshdeform_interp_w(MeshDeformBind *mdb,
 
     int a = meshdeform_index(mdb, x, y, z, 0);
     float weight = wx * wy * wz;
-    result += weight * mdb->phi[a];
+    result += weight * phi[a];
     totweight += weight;
   }
 
@@ -1370,7 +1373,7 @@ static void meshdeform_matrix_add_cell(
 }
 
 static void meshdeform_matrix_add_rhs(
-    MeshDeformBind *mdb, LinearSolver *context, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, double *rhs_vec, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1393,13 +1396,13 @@ static void meshdeform_matrix_add_rhs(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      EIG_linear_solver_right_hand_side_add(context, 0, mdb->varidx[acenter], rhs);
+      rhs_vec[mdb->varidx[acenter]] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_semibound_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1410,7 +1413,7 @@ static void meshdeform_matrix_add_semibound_phi(
     return;
   }
 
-  mdb->phi[a] = 0.0f;
+  phi[a] = 0.0f;
 
   totweight = meshdeform_boundary_total_weight(mdb, x, y, z);
   for (i = 1; i <= 6; i++) {
@@ -1419,15 +1422,15 @@ static void meshdeform_matrix_add_semibound_phi(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      mdb->phi[a] += rhs;
+      phi[a] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_exterior_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int UNUSED(cagevert))
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int UNUSED(cagevert))
 {
-  float phi, totweight;
+  float phi_sum, totweight;
   int i, a, acenter;
 
   acenter = meshdeform_index(mdb, x, y, z, 0);
@@ -1435,27 +1438,109 @@ static void meshdeform_matrix_add_exterior_phi(
     return;
   }
 
-  phi = 0.0f;
+  phi_sum = 0.0f;
   totweight = 0.0f;
   for (i = 1; i <= 6; i++) {
     a = meshdeform_index(mdb, x, y, z, i);
 
     if (a != -1 && mdb->semibound[a]) {
-      phi += mdb->phi[a];
+      phi_sum += phi[a];
       totweight += 1.0f;
     }
   }
 
   if (totweight != 0.0f) {
-    mdb->phi[acenter] = phi / totweight;
+    phi[acenter] = phi_sum / totweight;
   }
 }
 
+typedef struct MeshDeformSolveData {
+  MeshDeformBind *mdb;
+  LinearSolver *context;
+  int totvar;
+
+  /* The cage vertices solved in one block, and their resulting phi, of #MeshDeformBind.size3
+   * each. */
+  int cagevert_start;
+  float *phi_block;
+  bool *phi_block_solved;
+} MeshDeformSolveData;
+
+static void meshdeform_matrix_solve_cagevert_cb(void *__restrict userdata,
+                                                const int i,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshDeformSolveData *data = userdata;
+  MeshDeformBind *mdb = data->mdb;
+  const int a = data->cagevert_start + i;
+  float *phi = &data->phi_block[(size_t)i * (size_t)mdb->size3];
+  float vec[3], gridvec[3];
+  int b, x, y, z;
+
+  double *rhs_vec = MEM_calloc_arrayN((size_t)data->totvar, sizeof(double), __func__);
+  double *x_vec = MEM_malloc_arrayN((size_t)data->totvar, sizeof(double), __func__);
+
+  /* fill in right hand side and solve */
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_rhs(mdb, rhs_vec, x, y, z, a);
+      }
+    }
+  }
+
+  data->phi_block_solved[i] = EIG_linear_solver_solve_vector(data->context, rhs_vec, x_vec);
+
+  if (data->phi_block_solved[i]) {
+    /* Exterior cells without semi-boundary neighbors are not written, don't let them keep the
+     * values of another cage vertex. */
+    memset(phi, 0, sizeof(*phi) * (size_t)mdb->size3);
+
+    for (z = 0; z < mdb->size; z++) {
+      for (y = 0; y < mdb->size; y++) {
+        for (x = 0; x < mdb->size; x++) {
+          meshdeform_matrix_add_semibound_phi(mdb, phi, x, y, z, a);
+        }
+      }
+    }
+
+    for (z = 0; z < mdb->size; z++) {
+      for (y = 0; y < mdb->size; y++) {
+        for (x = 0; x < mdb->size; x++) {
+          meshdeform_matrix_add_exterior_phi(mdb, phi, x, y, z, a);
+        }
+      }
+    }
+
+    for (b = 0; b < mdb->size3; b++) {
+      if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
+        phi[b] = (float)x_vec[mdb->varidx[b]];
+      }
+    }
+
+    if (mdb->weights) {
+      /* static bind : compute weights for each vertex */
+      for (b = 0; b < mdb->totvert; b++) {
+        if (mdb->inside[b]) {
+          copy_v3_v3(vec, mdb->vertexcos[b]);
+          gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
+          gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
+          gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
+
+          mdb->weights[b * mdb->totcagevert + a] = meshdeform_interp_w(mdb, phi, gridvec, vec, a);
+        }
+      }
+    }
+  }
+
+  MEM_freeN(rhs_vec);
+  MEM_freeN(x_vec);
+}
+
 static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
 {
   LinearSolver *context;
-  float vec[3], gridvec[3];
-  int a, b, x, y, z, totvar;
+  int a, b, i, x, y, z, totvar;
   char message[256];
 
   /* setup variable indices */
@@ -1483,81 +1568,82 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
     }
   }
 
+  /* The matrix is the same for all cage verts, factorize it once and solve for the cage verts
+   * in parallel. This is done in blocks, so the results are gathered in cage vertex order and
+   * progress is reported from this thread. */
+  const bool solved = EIG_linear_solver_factorize(context);
+  const int block_size = solved ? min_ii(BLI_system_thread_count(), mdb->totcagevert) : 0;
+
+  MeshDeformSolveData data = {
+      .mdb = mdb,
+      .context = context,
+      .totvar = totvar,
+      .phi_block = MEM_malloc_arrayN(
+          (size_t)max_ii(block_size, 1) * (size_t)mdb->size3, sizeof(float), __func__),
+      .phi_block_solved = MEM_calloc_arrayN((size_t)max_ii(block_size, 1), sizeof(bool), __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
   /* solve for each cage vert */
-  for (a = 0; a < mdb->totcagevert; a++) {
-    /* fill in right hand side and solve */
-    for (z = 0; z < mdb->size; z++) {
-      for (y = 0; y < mdb->size; y++) {
-        for (x = 0; x < mdb->size; x++) {
-          meshdeform_matrix_add_rhs(mdb, context, x, y, z, a);
-        }
-      }
-    }
+  for (a = 0; solved && a < mdb->totcagevert; a += block_size) {
+    const int block_len = min_ii(block_size, mdb->totcagevert - a);
+    bool block_solved = true;
 
-    if (EIG_linear_solver_solve(context)) {
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_semibound_phi(mdb, x, y, z, a);
-          }
-        }
-      }
+    data.cagevert_start = a;
+    BLI_task_parallel_range(0, block_len, &data, meshdeform_matrix_solve_cagevert_cb, &settings);
 
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_exterior_phi(mdb, x, y, z, a);
-          }
-        }
+    for (i = 0; i < block_len; i++) {
+      const float *phi = &data.phi_block[(size_t)i * (size_t)mdb->size3];
+
+      if (!data.phi_block_solved[i]) {
+        block_solved = false;
+        break;
       }
 
       for (b = 0; b < mdb->size3; b++) {
-        if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
-          mdb->phi[b] = EIG_linear_solver_variable_get(context, 0, mdb->varidx[b]);
-        }
-        mdb->totalphi[b] += mdb->phi[b];
+        mdb->totalphi[b] += phi[b];
       }
 
-      if (mdb->weights) {
-        /* static bind : compute weights for each vertex */
-        for (b = 0; b < mdb->totvert; b++) {
-          if (mdb->inside[b]) {
-            copy_v3_v3(vec, mdb->vertexcos[b]);
-            gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
-            gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
-            gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
-
-            mdb->weights[b * mdb->totcagevert + a] = meshdeform_interp_w(mdb, gridvec, vec, a);
-          }
-        }
-      }
-      else {
+      if (mdb->weights == NULL) {
         MDefBindInfluence *inf;
 
         /* dynamic bind */
         for (b = 0; b < mdb->size3; b++) {
-          if (mdb->phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
+          if (phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
             inf = BLI_memarena_alloc(mdb->memarena, sizeof(*inf));
-            inf->vertex = a;
-            inf->weight = mdb->phi[b];
+            inf->vertex = a + i;
+            inf->weight = phi[b];
             inf->next = mdb->dyngrid[b];
             mdb->dyngrid[b] = inf;
           }
         }
       }
     }
-    else {
-      BKE_modifier_set_error(
-          mmd->object, &mmd->modifier, "Failed to find bind solution (increase precision?)");
-      error("Mesh Deform: failed to find bind solution.");
+
+    if (!block_solved) {
       break;
     }
 
-    BLI_snprintf(
-        message, sizeof(message), "Mesh deform solve %d / %d       |||", a + 1, mdb->totcagevert);
-    progress_bar((float)(a + 1) / (float)(mdb->totcagevert), message);
+    BLI_snprintf(message,
+                 sizeof(message),
+                 "Mesh deform solve %d / %d       |||",
+                 a + block_len,
+                 mdb->totcagevert);
+    progress_bar((float)(a + block_len) / (float)(mdb->totcagevert), message);
+  }
+
+  if (!solved || a < mdb->totcagevert) {
+    BKE_modifier_set_error(
+        mmd->object, &mmd->modifier, "Failed to find bind solution (increase precision?)");
+    error("Mesh Deform: failed to find bind solution.");
   }
 
+  MEM_freeN(data.phi_block);
+  MEM_freeN(data.phi_block_solved);
+
 #if 0
   /* sanity check */
   for (b = 0; b < mdb->size3; b++) {
@@ -1598,7 +1684,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   mdb->size = (2 << (mmd->gridsize - 1)) + 2;
   mdb->size3 = mdb->size * mdb->size * mdb->size;
   mdb->tag = MEM_callocN(sizeof(int) * mdb->size3, "MeshDeformBindTag");
-  mdb->phi = MEM_callocN(sizeof(float) * mdb->size3, "MeshDeformBindPhi");
   mdb->totalphi = MEM_callocN(sizeof(float) * mdb->size3, "MeshDeformBindTotalPhi");
   mdb->boundisect = MEM_callocN(sizeof(*mdb->boundisect) * mdb->size3, "MDefBoundIsect");
   mdb->semibound = MEM_callocN(sizeof(int) * mdb->size3, "MDefSemiBound");
@@ -1738,7 +1823,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   }
 
   MEM_freeN(mdb->tag);
-  MEM_freeN(mdb->phi);
   MEM_freeN(mdb->totalphi);
   MEM_freeN(mdb->boundisect);
   MEM_freeN(mdb->semibound);
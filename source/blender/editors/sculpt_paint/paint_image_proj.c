@@ -4691,18 +4691,31 @@ static bool project_image_refresh_tagged(ProjPaintState *ps)
 
   for (a = 0, projIma = ps->projImages; a < ps->image_tot; a++, projIma++) {
     if (projIma->touch) {
+      rcti regions[PROJ_BOUNDBOX_SQUARED];
+      int regions_len = 0;
+
       /* look over each bound cell */
       for (i = 0; i < PROJ_BOUNDBOX_SQUARED; i++) {
         pr = &(projIma->partRedrawRect[i]);
         if (pr->x2 != -1) { /* TODO - use 'enabled' ? */
+          /* Only update the display buffer here, the GPU texture is updated for all cells at
+           * once, so its mipmaps are generated only once. */
           set_imapaintpartial(pr);
-          imapaint_image_update(NULL, projIma->ima, projIma->ibuf, &projIma->iuser, true);
+          imapaint_image_update(NULL, projIma->ima, projIma->ibuf, &projIma->iuser, false);
+          if (pr->x1 != pr->x2 && pr->y1 != pr->y2) {
+            BLI_rcti_init(&regions[regions_len++], pr->x1, pr->x2, pr->y1, pr->y2);
+          }
           redraw = 1;
         }
 
         partial_redraw_single_init(pr);
       }
 
+      if (regions_len != 0) {
+        BKE_image_update_gputexture_regions(
+            projIma->ima, &projIma->iuser, regions, regions_len);
+      }
+
       /* clear for reuse */
       projIma->touch = 0;
     }
@@ -2403,9 +2403,10 @@ static void wpaint_stroke_update_step(bContext *C, struct PaintStroke *stroke, P
   mul_v3_m4v3(loc_world, ob->obmat, ss->cache->true_location);
   paint_last_stroke_update(scene, loc_world);
 
-  BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
-
-  DEG_id_tag_update(ob->data, 0);
+  /* Only the weights changed: tag geometry so the evaluated mesh (which is what gets drawn) is
+   * updated, there is no need to dirty the batch cache of the original mesh or to tag shading and
+   * parameters on every dab. */
+  DEG_id_tag_update(ob->data, ID_RECALC_GEOMETRY);
   WM_event_add_notifier(C, NC_OBJECT | ND_DRAW, ob);
   swap_m4m4(wpd->vc.rv3d->persmat, mat);
 
@@ -3378,8 +3379,6 @@ static void vpaint_stroke_update_step(bContext *C, struct PaintStroke *stroke, P
 
   swap_m4m4(vc->rv3d->persmat, mat);
 
-  BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
-
   if (vp->paint.brush->vertexpaint_tool == VPAINT_TOOL_SMEAR) {
     memcpy(
         vpd->smear.color_prev, vpd->smear.color_curr, sizeof(uint) * ((Mesh *)ob->data)->totloop);
@@ -3396,7 +3395,7 @@ static void vpaint_stroke_update_step(bContext *C, struct PaintStroke *stroke, P
   if (vpd->use_fast_update == false) {
     /* recalculate modifier stack to get new colors, slow,
      * avoid this if we can! */
-    DEG_id_tag_update(ob->data, 0);
+    DEG_id_tag_update(ob->data, ID_RECALC_GEOMETRY);
   }
   else {
     /* Flush changes through DEG. */
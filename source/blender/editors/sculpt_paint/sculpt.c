@@ -774,9 +774,9 @@ static void sculpt_vertex_neighbors_get_bmesh(SculptSession *ss,
   }
 }
 
-static void sculpt_vertex_neighbors_get_faces(SculptSession *ss,
-                                              int index,
-                                              SculptVertexNeighborIter *iter)
+static void sculpt_vertex_neighbors_get_faces_from_pmap(SculptSession *ss,
+                                                        int index,
+                                                        SculptVertexNeighborIter *iter)
 {
   MeshElemMap *vert_map = &ss->pmap[index];
   iter->size = 0;
@@ -795,6 +795,29 @@ static void sculpt_vertex_neighbors_get_faces(SculptSession *ss,
       }
     }
   }
+}
+
+static void sculpt_vertex_neighbors_get_faces(SculptSession *ss,
+                                              int index,
+                                              SculptVertexNeighborIter *iter)
+{
+  if (ss->vert_neighbors_offset) {
+    /* Copy the precomputed neighbors, see #SCULPT_vertex_neighbors_ensure. */
+    const int start = ss->vert_neighbors_offset[index];
+    const int size = ss->vert_neighbors_offset[index + 1] - start;
+    iter->size = size;
+    iter->num_duplicates = 0;
+    iter->capacity = SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
+    iter->neighbors = iter->neighbors_fixed;
+    if (size > iter->capacity) {
+      iter->capacity = size + SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
+      iter->neighbors = MEM_mallocN(iter->capacity * sizeof(int), "neighbor array");
+    }
+    memcpy(iter->neighbors, &ss->vert_neighbors[start], sizeof(int) * size);
+  }
+  else {
+    sculpt_vertex_neighbors_get_faces_from_pmap(ss, index, iter);
+  }
 
   if (ss->fake_neighbors.use_fake_neighbors) {
     BLI_assert(ss->fake_neighbors.fake_neighbor_index != NULL);
@@ -864,6 +887,78 @@ void SCULPT_vertex_neighbors_get(SculptSession *ss,
   }
 }
 
+typedef struct VertexNeighborsData {
+  SculptSession *ss;
+  int *counts;
+} VertexNeighborsData;
+
+static void sculpt_vertex_neighbors_count_cb(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VertexNeighborsData *data = userdata;
+  SculptVertexNeighborIter iter;
+  sculpt_vertex_neighbors_get_faces_from_pmap(data->ss, i, &iter);
+  data->counts[i] = iter.size;
+  if (iter.neighbors != iter.neighbors_fixed) {
+    MEM_freeN(iter.neighbors);
+  }
+}
+
+static void sculpt_vertex_neighbors_fill_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VertexNeighborsData *data = userdata;
+  SculptSession *ss = data->ss;
+  SculptVertexNeighborIter iter;
+  sculpt_vertex_neighbors_get_faces_from_pmap(ss, i, &iter);
+  BLI_assert(iter.size == ss->vert_neighbors_offset[i + 1] - ss->vert_neighbors_offset[i]);
+  memcpy(&ss->vert_neighbors[ss->vert_neighbors_offset[i]],
+         iter.neighbors,
+         sizeof(int) * iter.size);
+  if (iter.neighbors != iter.neighbors_fixed) {
+    MEM_freeN(iter.neighbors);
+  }
+}
+
+/**
+ * Store the neighbors of all vertices of the base mesh in a compressed sparse row layout, so
+ * #SCULPT_vertex_neighbors_get doesn't have to gather them from the faces of each vertex again.
+ * Worth it for operations which loop over the neighbors of all vertices many times, like the
+ * filters. Only used for #PBVH_FACES, the neighbors are freed together with `ss->pmap`.
+ */
+void SCULPT_vertex_neighbors_ensure(SculptSession *ss)
+{
+  if (BKE_pbvh_type(ss->pbvh) != PBVH_FACES || ss->pmap == NULL || ss->vert_neighbors_offset) {
+    return;
+  }
+
+  const int totvert = ss->totvert;
+  int *offsets = MEM_malloc_arrayN(totvert + 1, sizeof(int), "vertex neighbors offset");
+
+  VertexNeighborsData data = {
+      .ss = ss,
+      .counts = offsets + 1,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, totvert, &data, sculpt_vertex_neighbors_count_cb, &settings);
+
+  offsets[0] = 0;
+  for (int i = 0; i < totvert; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  ss->vert_neighbors = MEM_malloc_arrayN(
+      max_ii(offsets[totvert], 1), sizeof(int), "vertex neighbors");
+  ss->vert_neighbors_offset = offsets;
+
+  BLI_task_parallel_range(0, totvert, &data, sculpt_vertex_neighbors_fill_cb, &settings);
+}
+
 static bool sculpt_check_boundary_vertex_in_base_mesh(const SculptSession *ss, const int index)
 {
   BLI_assert(ss->vertex_info.boundary);
@@ -1780,6 +1875,95 @@ SculptBrushTestFn SCULPT_brush_test_init_with_falloff_shape(SculptSession *ss,
   return sculpt_brush_test_sq_fn;
 }
 
+/**
+ * Batched version of the test returned by #SCULPT_brush_test_init_with_falloff_shape, which
+ * tests all vertices of \a node at once. The coordinates are gathered into one array per
+ * component first, so the distance computation can use vector instructions instead of
+ * testing one vertex at a time inside of the vertex iterator.
+ *
+ * \param orig_data: Test the original coordinates instead of the current ones when not NULL.
+ * \return The squared distance to the brush of each vertex indexed by #PBVHVertexIter.i, or
+ * FLT_MAX for vertices that are outside of the brush or clipped. Free with #MEM_freeN.
+ */
+float *SCULPT_brush_test_sq_batch(SculptSession *ss,
+                                  const SculptBrushTest *test,
+                                  char falloff_shape,
+                                  PBVHNode *node,
+                                  SculptOrigVertData *orig_data)
+{
+  int totvert;
+  BKE_pbvh_node_num_verts(ss->pbvh, node, &totvert, NULL);
+
+  float *dist_sq = MEM_mallocN(sizeof(float) * 4 * (size_t)max_ii(totvert, 1), __func__);
+  float *co_x = dist_sq + totvert;
+  float *co_y = co_x + totvert;
+  float *co_z = co_y + totvert;
+
+  /* Hidden vertices are skipped by the iterator and never looked up, only avoid computing with
+   * uninitialized values for them. */
+  copy_vn_fl(co_x, totvert, FLT_MAX);
+  copy_vn_fl(co_y, totvert, FLT_MAX);
+  copy_vn_fl(co_z, totvert, FLT_MAX);
+
+  PBVHVertexIter vd;
+  BKE_pbvh_vertex_iter_begin(ss->pbvh, node, vd, PBVH_ITER_UNIQUE)
+  {
+    const float *co = vd.co;
+    if (orig_data) {
+      SCULPT_orig_vert_data_update(orig_data, &vd);
+      co = orig_data->co;
+    }
+    co_x[vd.i] = co[0];
+    co_y[vd.i] = co[1];
+    co_z[vd.i] = co[2];
+  }
+  BKE_pbvh_vertex_iter_end;
+
+  const float loc_x = test->location[0];
+  const float loc_y = test->location[1];
+  const float loc_z = test->location[2];
+  const float radius_squared = test->radius_squared;
+
+  if (falloff_shape == PAINT_FALLOFF_SHAPE_SPHERE) {
+    for (int i = 0; i < totvert; i++) {
+      const float dx = co_x[i] - loc_x;
+      const float dy = co_y[i] - loc_y;
+      const float dz = co_z[i] - loc_z;
+      const float distsq = dx * dx + dy * dy + dz * dz;
+      dist_sq[i] = (distsq <= radius_squared) ? distsq : FLT_MAX;
+    }
+  }
+  else {
+    /* PAINT_FALLOFF_SHAPE_TUBE, the distance to the location after projecting onto the view
+     * plane, which goes through the location. */
+    const float no_x = test->plane_view[0];
+    const float no_y = test->plane_view[1];
+    const float no_z = test->plane_view[2];
+    for (int i = 0; i < totvert; i++) {
+      const float dx = co_x[i] - loc_x;
+      const float dy = co_y[i] - loc_y;
+      const float dz = co_z[i] - loc_z;
+      const float dot = dx * no_x + dy * no_y + dz * no_z;
+      const float distsq = max_ff(dx * dx + dy * dy + dz * dz - dot * dot, 0.0f);
+      dist_sq[i] = (distsq <= radius_squared) ? distsq : FLT_MAX;
+    }
+  }
+
+  /* Clipping is rare, only test the vertices that are inside of the brush. */
+  if (test->clip_rv3d) {
+    for (int i = 0; i < totvert; i++) {
+      if (dist_sq[i] != FLT_MAX) {
+        const float co[3] = {co_x[i], co_y[i], co_z[i]};
+        if (sculpt_brush_test_clipping(test, co)) {
+          dist_sq[i] = FLT_MAX;
+        }
+      }
+    }
+  }
+
+  return dist_sq;
+}
+
 const float *SCULPT_brush_frontface_normal_from_falloff_shape(SculptSession *ss,
                                                               char falloff_shape)
 {
@@ -3118,32 +3302,36 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
   proxy = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
 
   SculptBrushTest test;
-  SculptBrushTestFn sculpt_brush_test_sq_fn = SCULPT_brush_test_init_with_falloff_shape(
-      ss, &test, data->brush->falloff_shape);
+  SCULPT_brush_test_init_with_falloff_shape(ss, &test, data->brush->falloff_shape);
+  float *dist_sq = SCULPT_brush_test_sq_batch(
+      ss, &test, data->brush->falloff_shape, data->nodes[n], NULL);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
-    if (sculpt_brush_test_sq_fn(&test, vd.co)) {
-      /* Offset vertex. */
-      const float fade = SCULPT_brush_strength_factor(ss,
-                                                      brush,
-                                                      vd.co,
-                                                      sqrtf(test.dist),
-                                                      vd.no,
-                                                      vd.fno,
-                                                      vd.mask ? *vd.mask : 0.0f,
-                                                      vd.index,
-                                                      thread_id);
+    if (dist_sq[vd.i] == FLT_MAX) {
+      continue;
+    }
+    /* Offset vertex. */
+    const float fade = SCULPT_brush_strength_factor(ss,
+                                                    brush,
+                                                    vd.co,
+                                                    sqrtf(dist_sq[vd.i]),
+                                                    vd.no,
+                                                    vd.fno,
+                                                    vd.mask ? *vd.mask : 0.0f,
+                                                    vd.index,
+                                                    thread_id);
 
-      mul_v3_v3fl(proxy[vd.i], offset, fade);
+    mul_v3_v3fl(proxy[vd.i], offset, fade);
 
-      if (vd.mvert) {
-        vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
-      }
+    if (vd.mvert) {
+      vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  MEM_freeN(dist_sq);
 }
 
 static void do_draw_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
@@ -3829,46 +4017,50 @@ static void do_grab_brush_task_cb_ex(void *__restrict userdata,
   proxy = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
 
   SculptBrushTest test;
-  SculptBrushTestFn sculpt_brush_test_sq_fn = SCULPT_brush_test_init_with_falloff_shape(
-      ss, &test, data->brush->falloff_shape);
+  SCULPT_brush_test_init_with_falloff_shape(ss, &test, data->brush->falloff_shape);
+  float *dist_sq = SCULPT_brush_test_sq_batch(
+      ss, &test, data->brush->falloff_shape, data->nodes[n], &orig_data);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
   const bool grab_silhouette = brush->flag2 & BRUSH_GRAB_SILHOUETTE;
 
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
+    if (dist_sq[vd.i] == FLT_MAX) {
+      continue;
+    }
     SCULPT_orig_vert_data_update(&orig_data, &vd);
 
-    if (sculpt_brush_test_sq_fn(&test, orig_data.co)) {
-      float fade = bstrength * SCULPT_brush_strength_factor(ss,
-                                                            brush,
-                                                            orig_data.co,
-                                                            sqrtf(test.dist),
-                                                            orig_data.no,
-                                                            NULL,
-                                                            vd.mask ? *vd.mask : 0.0f,
-                                                            vd.index,
-                                                            thread_id);
-
-      if (grab_silhouette) {
-        float silhouette_test_dir[3];
-        normalize_v3_v3(silhouette_test_dir, grab_delta);
-        if (dot_v3v3(ss->cache->initial_normal, ss->cache->grab_delta_symmetry) < 0.0f) {
-          mul_v3_fl(silhouette_test_dir, -1.0f);
-        }
-        float vno[3];
-        normal_short_to_float_v3(vno, orig_data.no);
-        fade *= max_ff(dot_v3v3(vno, silhouette_test_dir), 0.0f);
+    float fade = bstrength * SCULPT_brush_strength_factor(ss,
+                                                          brush,
+                                                          orig_data.co,
+                                                          sqrtf(dist_sq[vd.i]),
+                                                          orig_data.no,
+                                                          NULL,
+                                                          vd.mask ? *vd.mask : 0.0f,
+                                                          vd.index,
+                                                          thread_id);
+
+    if (grab_silhouette) {
+      float silhouette_test_dir[3];
+      normalize_v3_v3(silhouette_test_dir, grab_delta);
+      if (dot_v3v3(ss->cache->initial_normal, ss->cache->grab_delta_symmetry) < 0.0f) {
+        mul_v3_fl(silhouette_test_dir, -1.0f);
       }
+      float vno[3];
+      normal_short_to_float_v3(vno, orig_data.no);
+      fade *= max_ff(dot_v3v3(vno, silhouette_test_dir), 0.0f);
+    }
 
-      mul_v3_v3fl(proxy[vd.i], grab_delta, fade);
+    mul_v3_v3fl(proxy[vd.i], grab_delta, fade);
 
-      if (vd.mvert) {
-        vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
-      }
+    if (vd.mvert) {
+      vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  MEM_freeN(dist_sq);
 }
 
 static void do_grab_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
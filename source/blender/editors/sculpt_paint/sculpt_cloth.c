@@ -29,6 +29,7 @@
 #include "BLI_gsqueue.h"
 #include "BLI_hash.h"
 #include "BLI_math.h"
+#include "BLI_math_bits.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
@@ -787,96 +788,205 @@ static void do_cloth_brush_solve_simulation_task_cb_ex(
   cloth_sim->node_state[node_index] = SCULPT_CLOTH_NODE_INACTIVE;
 }
 
-static void cloth_brush_satisfy_constraints(SculptSession *ss,
-                                            Brush *brush,
-                                            SculptClothSimulation *cloth_sim)
+/* Constraints are solved in parallel in groups that don't share any vertex. Constraints which
+ * can't get any of the first #CLOTH_CONSTRAINT_GROUPS_MAX groups are solved serially at the end
+ * of each iteration. */
+#define CLOTH_CONSTRAINT_GROUPS_MAX 64
+
+/* Sort the constraints into groups with greedy graph coloring, each constraint takes the first
+ * group which isn't used by any other constraint of its vertices yet. The constraints keep their
+ * order within a group, so the result is always the same for the same constraints. */
+static void cloth_brush_constraint_groups_ensure(SculptSession *ss,
+                                                 SculptClothSimulation *cloth_sim)
 {
+  const int tot_constraints = cloth_sim->tot_length_constraints;
+  if (cloth_sim->constraint_groups != NULL &&
+      cloth_sim->constraint_groups_len == tot_constraints) {
+    return;
+  }
 
-  AutomaskingCache *automasking = SCULPT_automasking_active_cache_get(ss);
+  const int totvert = SCULPT_vertex_count_get(ss);
+  uint64_t *vert_used_groups = MEM_calloc_arrayN(totvert, sizeof(uint64_t), __func__);
+  int *constraint_group = MEM_malloc_arrayN(max_ii(tot_constraints, 1), sizeof(int), __func__);
+  int group_counts[CLOTH_CONSTRAINT_GROUPS_MAX + 1] = {0};
+
+  for (int i = 0; i < tot_constraints; i++) {
+    const SculptClothLengthConstraint *constraint = &cloth_sim->length_constraints[i];
+    const int v1 = constraint->elem_index_a;
+    const int v2 = constraint->elem_index_b;
+    const uint64_t used_groups = vert_used_groups[v1] | vert_used_groups[v2];
+    int group = CLOTH_CONSTRAINT_GROUPS_MAX;
+    if (used_groups != UINT64_MAX) {
+      group = (int)bitscan_forward_uint64(~used_groups);
+      vert_used_groups[v1] |= (uint64_t)1 << group;
+      vert_used_groups[v2] |= (uint64_t)1 << group;
+    }
+    constraint_group[i] = group;
+    group_counts[group]++;
+  }
 
-  for (int constraint_it = 0; constraint_it < CLOTH_SIMULATION_ITERATIONS; constraint_it++) {
-    for (int i = 0; i < cloth_sim->tot_length_constraints; i++) {
-      const SculptClothLengthConstraint *constraint = &cloth_sim->length_constraints[i];
+  MEM_SAFE_FREE(cloth_sim->constraint_groups);
+  cloth_sim->constraint_groups = MEM_malloc_arrayN(
+      max_ii(tot_constraints, 1), sizeof(int), "cloth constraint groups");
+  if (cloth_sim->constraint_group_offsets == NULL) {
+    cloth_sim->constraint_group_offsets = MEM_malloc_arrayN(
+        CLOTH_CONSTRAINT_GROUPS_MAX + 2, sizeof(int), "cloth constraint group offsets");
+  }
 
-      if (cloth_sim->node_state[constraint->node] != SCULPT_CLOTH_NODE_ACTIVE) {
-        /* Skip all constraints that were created for inactive nodes. */
-        continue;
-      }
+  int offset = 0;
+  for (int group = 0; group <= CLOTH_CONSTRAINT_GROUPS_MAX; group++) {
+    cloth_sim->constraint_group_offsets[group] = offset;
+    offset += group_counts[group];
+  }
+  cloth_sim->constraint_group_offsets[CLOTH_CONSTRAINT_GROUPS_MAX + 1] = offset;
 
-      const int v1 = constraint->elem_index_a;
-      const int v2 = constraint->elem_index_b;
+  for (int group = 0; group <= CLOTH_CONSTRAINT_GROUPS_MAX; group++) {
+    group_counts[group] = cloth_sim->constraint_group_offsets[group];
+  }
+  for (int i = 0; i < tot_constraints; i++) {
+    cloth_sim->constraint_groups[group_counts[constraint_group[i]]++] = i;
+  }
 
-      float v1_to_v2[3];
-      sub_v3_v3v3(v1_to_v2, constraint->elem_position_b, constraint->elem_position_a);
-      const float current_distance = len_v3(v1_to_v2);
-      float correction_vector[3];
-      float correction_vector_half[3];
+  cloth_sim->constraint_groups_len = tot_constraints;
 
-      const float constraint_distance = constraint->length +
-                                        (cloth_sim->length_constraint_tweak[v1] * 0.5f) +
-                                        (cloth_sim->length_constraint_tweak[v2] * 0.5f);
+  MEM_freeN(vert_used_groups);
+  MEM_freeN(constraint_group);
+}
 
-      if (current_distance > 0.0f) {
-        mul_v3_v3fl(correction_vector,
-                    v1_to_v2,
-                    CLOTH_SOLVER_DISPLACEMENT_FACTOR *
-                        (1.0f - (constraint_distance / current_distance)));
-      }
-      else {
-        mul_v3_v3fl(correction_vector, v1_to_v2, CLOTH_SOLVER_DISPLACEMENT_FACTOR);
-      }
+typedef struct ClothSolveConstraintsData {
+  SculptSession *ss;
+  Brush *brush;
+  SculptClothSimulation *cloth_sim;
+  AutomaskingCache *automasking;
+  float sim_location[3];
+  /* Indices of the constraints to solve. */
+  const int *constraints;
+} ClothSolveConstraintsData;
 
-      mul_v3_v3fl(correction_vector_half, correction_vector, 0.5f);
-
-      const float mask_v1 = (1.0f - SCULPT_vertex_mask_get(ss, v1)) *
-                            SCULPT_automasking_factor_get(automasking, ss, v1);
-      const float mask_v2 = (1.0f - SCULPT_vertex_mask_get(ss, v2)) *
-                            SCULPT_automasking_factor_get(automasking, ss, v2);
-
-      float sim_location[3];
-      cloth_brush_simulation_location_get(ss, brush, sim_location);
-
-      const float sim_factor_v1 = ss->cache ?
-                                      cloth_brush_simulation_falloff_get(brush,
-                                                                         ss->cache->radius,
-                                                                         sim_location,
-                                                                         cloth_sim->init_pos[v1]) :
-                                      1.0f;
-      const float sim_factor_v2 = ss->cache ?
-                                      cloth_brush_simulation_falloff_get(brush,
-                                                                         ss->cache->radius,
-                                                                         sim_location,
-                                                                         cloth_sim->init_pos[v2]) :
-                                      1.0f;
-
-      float deformation_strength = 1.0f;
-      if (constraint->type == SCULPT_CLOTH_CONSTRAINT_DEFORMATION) {
-        deformation_strength = (cloth_sim->deformation_strength[v1] +
-                                cloth_sim->deformation_strength[v2]) *
-                               0.5f;
-      }
+static void cloth_brush_solve_constraint(const ClothSolveConstraintsData *data,
+                                         const SculptClothLengthConstraint *constraint)
+{
+  SculptSession *ss = data->ss;
+  Brush *brush = data->brush;
+  SculptClothSimulation *cloth_sim = data->cloth_sim;
+  AutomaskingCache *automasking = data->automasking;
 
-      if (constraint->type == SCULPT_CLOTH_CONSTRAINT_SOFTBODY) {
-        const float softbody_plasticity = brush ? brush->cloth_constraint_softbody_strength : 0.0f;
-        madd_v3_v3fl(cloth_sim->pos[v1],
-                     correction_vector_half,
-                     1.0f * mask_v1 * sim_factor_v1 * constraint->strength * softbody_plasticity);
-        madd_v3_v3fl(cloth_sim->softbody_pos[v1],
-                     correction_vector_half,
-                     -1.0f * mask_v1 * sim_factor_v1 * constraint->strength *
-                         (1.0f - softbody_plasticity));
-      }
-      else {
-        madd_v3_v3fl(cloth_sim->pos[v1],
-                     correction_vector_half,
-                     1.0f * mask_v1 * sim_factor_v1 * constraint->strength * deformation_strength);
-        if (v1 != v2) {
-          madd_v3_v3fl(cloth_sim->pos[v2],
-                       correction_vector_half,
-                       -1.0f * mask_v2 * sim_factor_v2 * constraint->strength *
-                           deformation_strength);
-        }
+  if (cloth_sim->node_state[constraint->node] != SCULPT_CLOTH_NODE_ACTIVE) {
+    /* Skip all constraints that were created for inactive nodes. */
+    return;
+  }
+
+  const int v1 = constraint->elem_index_a;
+  const int v2 = constraint->elem_index_b;
+
+  float v1_to_v2[3];
+  sub_v3_v3v3(v1_to_v2, constraint->elem_position_b, constraint->elem_position_a);
+  const float current_distance = len_v3(v1_to_v2);
+  float correction_vector[3];
+  float correction_vector_half[3];
+
+  const float constraint_distance = constraint->length +
+                                    (cloth_sim->length_constraint_tweak[v1] * 0.5f) +
+                                    (cloth_sim->length_constraint_tweak[v2] * 0.5f);
+
+  if (current_distance > 0.0f) {
+    mul_v3_v3fl(correction_vector,
+                v1_to_v2,
+                CLOTH_SOLVER_DISPLACEMENT_FACTOR *
+                    (1.0f - (constraint_distance / current_distance)));
+  }
+  else {
+    mul_v3_v3fl(correction_vector, v1_to_v2, CLOTH_SOLVER_DISPLACEMENT_FACTOR);
+  }
+
+  mul_v3_v3fl(correction_vector_half, correction_vector, 0.5f);
+
+  const float mask_v1 = (1.0f - SCULPT_vertex_mask_get(ss, v1)) *
+                        SCULPT_automasking_factor_get(automasking, ss, v1);
+  const float mask_v2 = (1.0f - SCULPT_vertex_mask_get(ss, v2)) *
+                        SCULPT_automasking_factor_get(automasking, ss, v2);
+
+  const float sim_factor_v1 = ss->cache ?
+                                  cloth_brush_simulation_falloff_get(brush,
+                                                                     ss->cache->radius,
+                                                                     data->sim_location,
+                                                                     cloth_sim->init_pos[v1]) :
+                                  1.0f;
+  const float sim_factor_v2 = ss->cache ?
+                                  cloth_brush_simulation_falloff_get(brush,
+                                                                     ss->cache->radius,
+                                                                     data->sim_location,
+                                                                     cloth_sim->init_pos[v2]) :
+                                  1.0f;
+
+  float deformation_strength = 1.0f;
+  if (constraint->type == SCULPT_CLOTH_CONSTRAINT_DEFORMATION) {
+    deformation_strength = (cloth_sim->deformation_strength[v1] +
+                            cloth_sim->deformation_strength[v2]) *
+                           0.5f;
+  }
+
+  if (constraint->type == SCULPT_CLOTH_CONSTRAINT_SOFTBODY) {
+    const float softbody_plasticity = brush ? brush->cloth_constraint_softbody_strength : 0.0f;
+    madd_v3_v3fl(cloth_sim->pos[v1],
+                 correction_vector_half,
+                 1.0f * mask_v1 * sim_factor_v1 * constraint->strength * softbody_plasticity);
+    madd_v3_v3fl(cloth_sim->softbody_pos[v1],
+                 correction_vector_half,
+                 -1.0f * mask_v1 * sim_factor_v1 * constraint->strength *
+                     (1.0f - softbody_plasticity));
+  }
+  else {
+    madd_v3_v3fl(cloth_sim->pos[v1],
+                 correction_vector_half,
+                 1.0f * mask_v1 * sim_factor_v1 * constraint->strength * deformation_strength);
+    if (v1 != v2) {
+      madd_v3_v3fl(cloth_sim->pos[v2],
+                   correction_vector_half,
+                   -1.0f * mask_v2 * sim_factor_v2 * constraint->strength *
+                       deformation_strength);
+    }
+  }
+}
+
+static void cloth_brush_solve_constraints_task_cb(void *__restrict userdata,
+                                                  const int i,
+                                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ClothSolveConstraintsData *data = userdata;
+  const int constraint_index = data->constraints[i];
+  cloth_brush_solve_constraint(data, &data->cloth_sim->length_constraints[constraint_index]);
+}
+
+static void cloth_brush_satisfy_constraints(SculptSession *ss,
+                                            Brush *brush,
+                                            SculptClothSimulation *cloth_sim)
+{
+  cloth_brush_constraint_groups_ensure(ss, cloth_sim);
+
+  ClothSolveConstraintsData data = {
+      .ss = ss,
+      .brush = brush,
+      .cloth_sim = cloth_sim,
+      .automasking = SCULPT_automasking_active_cache_get(ss),
+  };
+  cloth_brush_simulation_location_get(ss, brush, data.sim_location);
+
+  for (int constraint_it = 0; constraint_it < CLOTH_SIMULATION_ITERATIONS; constraint_it++) {
+    for (int group = 0; group <= CLOTH_CONSTRAINT_GROUPS_MAX; group++) {
+      const int start = cloth_sim->constraint_group_offsets[group];
+      const int tot = cloth_sim->constraint_group_offsets[group + 1] - start;
+      if (tot == 0) {
+        continue;
       }
+      data.constraints = &cloth_sim->constraint_groups[start];
+
+      /* Constraints of the last group can share vertices. */
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = group < CLOTH_CONSTRAINT_GROUPS_MAX;
+      settings.min_iter_per_thread = 1024;
+      BLI_task_parallel_range(0, tot, &data, cloth_brush_solve_constraints_task_cb, &settings);
     }
   }
 }
@@ -1215,6 +1325,8 @@ void SCULPT_cloth_simulation_free(struct SculptClothSimulation *cloth_sim)
   MEM_SAFE_FREE(cloth_sim->prev_pos);
   MEM_SAFE_FREE(cloth_sim->acceleration);
   MEM_SAFE_FREE(cloth_sim->length_constraints);
+  MEM_SAFE_FREE(cloth_sim->constraint_groups);
+  MEM_SAFE_FREE(cloth_sim->constraint_group_offsets);
   MEM_SAFE_FREE(cloth_sim->length_constraint_tweak);
   MEM_SAFE_FREE(cloth_sim->deformation_pos);
   MEM_SAFE_FREE(cloth_sim->softbody_pos);
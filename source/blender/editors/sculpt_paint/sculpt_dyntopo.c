@@ -104,6 +104,9 @@ void SCULPT_pbvh_clear(Object *ob)
     ss->pmap_mem = NULL;
   }
 
+  MEM_SAFE_FREE(ss->vert_neighbors_offset);
+  MEM_SAFE_FREE(ss->vert_neighbors);
+
   BKE_object_free_derived_caches(ob);
 
   /* Tag to rebuild PBVH in depsgraph. */
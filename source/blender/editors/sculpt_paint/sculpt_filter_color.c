@@ -304,6 +304,10 @@ static int sculpt_color_filter_invoke(bContext *C, wmOperator *op, const wmEvent
     return OPERATOR_CANCELLED;
   }
 
+  if (needs_topology_info) {
+    SCULPT_vertex_neighbors_ensure(ss);
+  }
+
   SCULPT_filter_cache_init(C, ob, sd, SCULPT_UNDO_COLOR);
   FilterCache *filter_cache = ss->filter_cache;
   filter_cache->active_face_set = SCULPT_FACE_SET_NONE;
@@ -209,6 +209,8 @@ static int sculpt_mask_filter_exec(bContext *C, wmOperator *op)
     return OPERATOR_CANCELLED;
   }
 
+  SCULPT_vertex_neighbors_ensure(ss);
+
   int num_verts = SCULPT_vertex_count_get(ss);
 
   BKE_pbvh_search_gather(pbvh, NULL, NULL, &nodes, &totnode);
@@ -439,6 +441,8 @@ static int sculpt_dirty_mask_exec(bContext *C, wmOperator *op)
     return OPERATOR_CANCELLED;
   }
 
+  SCULPT_vertex_neighbors_ensure(ss);
+
   BKE_pbvh_search_gather(pbvh, NULL, NULL, &nodes, &totnode);
   SCULPT_undo_push_begin(ob, "Dirty Mask");
 
@@ -701,6 +701,7 @@ static int sculpt_mesh_filter_invoke(bContext *C, wmOperator *op, const wmEvent
   BKE_sculpt_update_object_for_edit(depsgraph, ob, needs_topology_info, false, false);
   if (needs_topology_info) {
     SCULPT_boundary_info_ensure(ob);
+    SCULPT_vertex_neighbors_ensure(ss);
   }
 
   SCULPT_undo_push_begin(ob, "Mesh Filter");
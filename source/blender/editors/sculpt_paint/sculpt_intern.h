@@ -37,6 +37,7 @@
 #include "BKE_pbvh.h"
 
 struct AutomaskingCache;
+struct BArrayState;
 struct KeyBlock;
 struct Object;
 struct SculptPoseIKChainSegment;
@@ -141,6 +142,7 @@ void SCULPT_vertex_neighbors_get(struct SculptSession *ss,
                                  const int index,
                                  const bool include_duplicates,
                                  SculptVertexNeighborIter *iter);
+void SCULPT_vertex_neighbors_ensure(struct SculptSession *ss);
 
 /* Iterator over neighboring vertices. */
 #define SCULPT_VERTEX_NEIGHBORS_ITER_BEGIN(ss, v_index, neighbor_iterator) \
@@ -619,6 +621,11 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* De-duplicated copies of the arrays above, these are NULL while they are stored here. */
+  struct {
+    struct BArrayState *co, *orig_co, *mask, *col, *index, *grids;
+  } store;
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -800,6 +807,11 @@ bool SCULPT_search_circle_cb(PBVHNode *node, void *data_v);
 SculptBrushTestFn SCULPT_brush_test_init_with_falloff_shape(SculptSession *ss,
                                                             SculptBrushTest *test,
                                                             char falloff_shape);
+float *SCULPT_brush_test_sq_batch(SculptSession *ss,
+                                  const SculptBrushTest *test,
+                                  char falloff_shape,
+                                  PBVHNode *node,
+                                  SculptOrigVertData *orig_data);
 const float *SCULPT_brush_frontface_normal_from_falloff_shape(SculptSession *ss,
                                                               char falloff_shape);
 
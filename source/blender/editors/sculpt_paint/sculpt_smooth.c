@@ -305,43 +305,49 @@ static void do_smooth_brush_task_cb_ex(void *__restrict userdata,
   CLAMP(bstrength, 0.0f, 1.0f);
 
   SculptBrushTest test;
-  SculptBrushTestFn sculpt_brush_test_sq_fn = SCULPT_brush_test_init_with_falloff_shape(
-      ss, &test, data->brush->falloff_shape);
+  SCULPT_brush_test_init_with_falloff_shape(ss, &test, data->brush->falloff_shape);
+  /* Vertices are only moved after their own test, so testing them all up front gives the same
+   * result. */
+  float *dist_sq = SCULPT_brush_test_sq_batch(
+      ss, &test, data->brush->falloff_shape, data->nodes[n], NULL);
 
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
-    if (sculpt_brush_test_sq_fn(&test, vd.co)) {
-      const float fade = bstrength * SCULPT_brush_strength_factor(
-                                         ss,
-                                         brush,
-                                         vd.co,
-                                         sqrtf(test.dist),
-                                         vd.no,
-                                         vd.fno,
-                                         smooth_mask ? 0.0f : (vd.mask ? *vd.mask : 0.0f),
-                                         vd.index,
-                                         thread_id);
-      if (smooth_mask) {
-        float val = SCULPT_neighbor_mask_average(ss, vd.index) - *vd.mask;
-        val *= fade * bstrength;
-        *vd.mask += val;
-        CLAMP(*vd.mask, 0.0f, 1.0f);
-      }
-      else {
-        float avg[3], val[3];
-        SCULPT_neighbor_coords_average_interior(ss, avg, vd.index);
-        sub_v3_v3v3(val, avg, vd.co);
-        madd_v3_v3v3fl(val, vd.co, val, fade);
-        SCULPT_clip(sd, ss, vd.co, val);
-      }
-      if (vd.mvert) {
-        vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
-      }
+    if (dist_sq[vd.i] == FLT_MAX) {
+      continue;
+    }
+    const float fade = bstrength * SCULPT_brush_strength_factor(
+                                       ss,
+                                       brush,
+                                       vd.co,
+                                       sqrtf(dist_sq[vd.i]),
+                                       vd.no,
+                                       vd.fno,
+                                       smooth_mask ? 0.0f : (vd.mask ? *vd.mask : 0.0f),
+                                       vd.index,
+                                       thread_id);
+    if (smooth_mask) {
+      float val = SCULPT_neighbor_mask_average(ss, vd.index) - *vd.mask;
+      val *= fade * bstrength;
+      *vd.mask += val;
+      CLAMP(*vd.mask, 0.0f, 1.0f);
+    }
+    else {
+      float avg[3], val[3];
+      SCULPT_neighbor_coords_average_interior(ss, avg, vd.index);
+      sub_v3_v3v3(val, avg, vd.co);
+      madd_v3_v3v3fl(val, vd.co, val, fade);
+      SCULPT_clip(sd, ss, vd.co, val);
+    }
+    if (vd.mvert) {
+      vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  MEM_freeN(dist_sq);
 }
 
 void SCULPT_smooth(Sculpt *sd,
@@ -70,6 +70,17 @@
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
+/* De-duplicate the arrays of undo steps, consecutive strokes over the same area store mostly
+ * the same data for each node. */
+#define USE_ARRAY_STORE
+
+#ifdef USE_ARRAY_STORE
+#  include "BLI_array_store.h"
+#  include "BLI_array_store_utils.h"
+/* check on best size later... */
+#  define ARRAY_CHUNK_SIZE 256
+#endif
+
 /* Implementation of undo system for objects in sculpt mode.
  *
  * Each undo step in sculpt mode consists of list of nodes, each node contains:
@@ -1381,6 +1392,219 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   }
 }
 
+#ifdef USE_ARRAY_STORE
+
+/* -------------------------------------------------------------------- */
+/** \name Array Store
+ *
+ * Once a step is pushed its arrays are moved into a #BArrayStore in a background task,
+ * sharing chunks with the same PBVH node of the previous step. The arrays are expanded
+ * temporarily while the step is restored.
+ * \{ */
+
+static struct {
+  struct BArrayStore_AtSize bs_stride;
+
+  /* We could have the undo API pass in the previous state, for now store a local list */
+  ListBase local_links;
+
+  TaskPool *task_pool;
+} sculpt_arraystore = {{NULL}};
+
+typedef struct SculptUndoNodeArray {
+  void **data;
+  BArrayState **state;
+  int stride;
+  int len;
+} SculptUndoNodeArray;
+
+#  define SCULPT_UNDO_NODE_ARRAYS_NUM 6
+
+/* Per vertex arrays are only restored for unique vertices, the rest is not stored. */
+static void sculpt_arraystore_node_arrays(
+    SculptUndoNode *unode, SculptUndoNodeArray r_arrays[SCULPT_UNDO_NODE_ARRAYS_NUM])
+{
+  const SculptUndoNodeArray arrays[SCULPT_UNDO_NODE_ARRAYS_NUM] = {
+      {(void **)&unode->co, &unode->store.co, sizeof(*unode->co), unode->totvert},
+      {(void **)&unode->orig_co, &unode->store.orig_co, sizeof(*unode->orig_co), unode->totvert},
+      {(void **)&unode->mask, &unode->store.mask, sizeof(*unode->mask), unode->totvert},
+      {(void **)&unode->col, &unode->store.col, sizeof(*unode->col), unode->totvert},
+      {(void **)&unode->index, &unode->store.index, sizeof(*unode->index), unode->totvert},
+      {(void **)&unode->grids, &unode->store.grids, sizeof(*unode->grids), unode->totgrid},
+  };
+  memcpy(r_arrays, arrays, sizeof(arrays));
+}
+
+static void sculpt_arraystore_compact_node(SculptUndoNode *unode, SculptUndoNode *unode_ref)
+{
+  SculptUndoNodeArray arrays[SCULPT_UNDO_NODE_ARRAYS_NUM];
+  SculptUndoNodeArray arrays_ref[SCULPT_UNDO_NODE_ARRAYS_NUM];
+  sculpt_arraystore_node_arrays(unode, arrays);
+  if (unode_ref) {
+    sculpt_arraystore_node_arrays(unode_ref, arrays_ref);
+  }
+
+  for (int i = 0; i < SCULPT_UNDO_NODE_ARRAYS_NUM; i++) {
+    SculptUndoNodeArray *array = &arrays[i];
+    if (*array->data == NULL || array->len == 0) {
+      continue;
+    }
+
+    BArrayStore *bs = BLI_array_store_at_size_ensure(
+        &sculpt_arraystore.bs_stride, array->stride, ARRAY_CHUNK_SIZE);
+
+    /* When compacting again after a restore, the previous state is the closest match. */
+    BArrayState *state_prev = *array->state;
+    const BArrayState *state_reference = state_prev ? state_prev :
+                                         unode_ref ? *arrays_ref[i].state :
+                                                     NULL;
+    *array->state = BLI_array_store_state_add(
+        bs, *array->data, (size_t)array->len * (size_t)array->stride, state_reference);
+    if (state_prev) {
+      BLI_array_store_state_remove(bs, state_prev);
+    }
+
+    MEM_freeN(*array->data);
+    *array->data = NULL;
+  }
+}
+
+/**
+ * Move the arrays of \a usculpt into the array store.
+ *
+ * \param usculpt_ref: The previous step, nodes are matched by their PBVH node
+ * (only used as a hint for de-duplication, the pointer isn't accessed).
+ */
+static void sculpt_arraystore_compact(UndoSculpt *usculpt, UndoSculpt *usculpt_ref)
+{
+  GHash *ref_map = NULL;
+  if (usculpt_ref) {
+    ref_map = BLI_ghash_ptr_new_ex(__func__, (uint)BLI_listbase_count(&usculpt_ref->nodes));
+    LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt_ref->nodes) {
+      if (unode->node) {
+        void **val_p;
+        if (!BLI_ghash_ensure_p(ref_map, unode->node, &val_p)) {
+          *val_p = unode;
+        }
+      }
+    }
+  }
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    SculptUndoNode *unode_ref = (ref_map && unode->node) ? BLI_ghash_lookup(ref_map, unode->node) :
+                                                           NULL;
+    if (unode_ref && (unode_ref->type != unode->type || unode_ref->maxgrid != unode->maxgrid)) {
+      unode_ref = NULL;
+    }
+    sculpt_arraystore_compact_node(unode, unode_ref);
+  }
+
+  if (ref_map) {
+    BLI_ghash_free(ref_map, NULL, NULL);
+  }
+}
+
+struct SculptArrayData {
+  UndoSculpt *usculpt;
+  UndoSculpt *usculpt_ref; /* can be NULL */
+};
+
+static void sculpt_arraystore_compact_cb(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  struct SculptArrayData *sculpt_data = taskdata;
+  sculpt_arraystore_compact(sculpt_data->usculpt, sculpt_data->usculpt_ref);
+}
+
+/* Compact in a background task, all access to the store happens in this task
+ * or after #sculpt_arraystore_wait. */
+static void sculpt_arraystore_compact_push(UndoSculpt *usculpt, UndoSculpt *usculpt_ref)
+{
+  if (sculpt_arraystore.task_pool == NULL) {
+    sculpt_arraystore.task_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  }
+
+  struct SculptArrayData *sculpt_data = MEM_mallocN(sizeof(*sculpt_data), __func__);
+  sculpt_data->usculpt = usculpt;
+  sculpt_data->usculpt_ref = usculpt_ref;
+
+  BLI_task_pool_push(
+      sculpt_arraystore.task_pool, sculpt_arraystore_compact_cb, sculpt_data, true, NULL);
+}
+
+static void sculpt_arraystore_wait(void)
+{
+  if (sculpt_arraystore.task_pool) {
+    BLI_task_pool_work_and_wait(sculpt_arraystore.task_pool);
+  }
+}
+
+/* Add a step which was just pushed, compacting it against the previous one. */
+static void sculpt_arraystore_add(UndoSculpt *usculpt)
+{
+  UndoSculpt *usculpt_ref = sculpt_arraystore.local_links.last ?
+                                ((LinkData *)sculpt_arraystore.local_links.last)->data :
+                                NULL;
+  BLI_addtail(&sculpt_arraystore.local_links, BLI_genericNodeN(usculpt));
+
+  sculpt_arraystore_compact_push(usculpt, usculpt_ref);
+}
+
+static void sculpt_arraystore_expand(UndoSculpt *usculpt)
+{
+  sculpt_arraystore_wait();
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    SculptUndoNodeArray arrays[SCULPT_UNDO_NODE_ARRAYS_NUM];
+    sculpt_arraystore_node_arrays(unode, arrays);
+    for (int i = 0; i < SCULPT_UNDO_NODE_ARRAYS_NUM; i++) {
+      SculptUndoNodeArray *array = &arrays[i];
+      if (*array->state && *array->data == NULL) {
+        size_t state_len;
+        *array->data = BLI_array_store_state_data_get_alloc(*array->state, &state_len);
+        BLI_assert(state_len == (size_t)array->len * (size_t)array->stride);
+        UNUSED_VARS_NDEBUG(state_len);
+      }
+    }
+  }
+}
+
+static void sculpt_arraystore_free(UndoSculpt *usculpt)
+{
+  sculpt_arraystore_wait();
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    SculptUndoNodeArray arrays[SCULPT_UNDO_NODE_ARRAYS_NUM];
+    sculpt_arraystore_node_arrays(unode, arrays);
+    for (int i = 0; i < SCULPT_UNDO_NODE_ARRAYS_NUM; i++) {
+      SculptUndoNodeArray *array = &arrays[i];
+      if (*array->state) {
+        BArrayStore *bs = BLI_array_store_at_size_get(&sculpt_arraystore.bs_stride,
+                                                      array->stride);
+        BLI_array_store_state_remove(bs, *array->state);
+        *array->state = NULL;
+      }
+    }
+  }
+
+  LinkData *link = BLI_findptr(&sculpt_arraystore.local_links, usculpt, offsetof(LinkData, data));
+  if (link) {
+    BLI_freelinkN(&sculpt_arraystore.local_links, link);
+  }
+
+  if (BLI_listbase_is_empty(&sculpt_arraystore.local_links)) {
+    BLI_array_store_at_size_clear(&sculpt_arraystore.bs_stride);
+
+    if (sculpt_arraystore.task_pool) {
+      BLI_task_pool_free(sculpt_arraystore.task_pool);
+      sculpt_arraystore.task_pool = NULL;
+    }
+  }
+}
+
+/** \} */
+
+#endif /* USE_ARRAY_STORE */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1407,6 +1631,10 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   us->step.data_size = us->data.undo_size;
 
+#ifdef USE_ARRAY_STORE
+  sculpt_arraystore_add(&us->data);
+#endif
+
   SculptUndoNode *unode = us->data.nodes.last;
   if (unode && unode->type == SCULPT_UNDO_DYNTOPO_END) {
     us->step.use_memfile_step = true;
@@ -1420,12 +1648,28 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   return true;
 }
 
+static void sculpt_undosys_step_restore(struct bContext *C,
+                                        Depsgraph *depsgraph,
+                                        SculptUndoStep *us)
+{
+#ifdef USE_ARRAY_STORE
+  sculpt_arraystore_expand(&us->data);
+#endif
+
+  sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+
+#ifdef USE_ARRAY_STORE
+  /* Restoring swaps the stored data with the current state, so this also changes the step. */
+  sculpt_arraystore_compact_push(&us->data, NULL);
+#endif
+}
+
 static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  Depsgraph *depsgraph,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
-  sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undosys_step_restore(C, depsgraph, us);
   us->step.is_applied = false;
 }
 
@@ -1434,7 +1678,7 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
-  sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undosys_step_restore(C, depsgraph, us);
   us->step.is_applied = true;
 }
 
@@ -1527,6 +1771,9 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+#ifdef USE_ARRAY_STORE
+  sculpt_arraystore_free(&us->data);
+#endif
   sculpt_undo_free_list(&us->data.nodes);
 }
 
@@ -1272,6 +1272,12 @@ static void filelist_cache_preview_runf(TaskPool *__restrict pool, void *taskdat
 
   ThumbSource source = 0;
 
+  /* The view moved on since this task was queued, leave the preview to the free function rather
+   * than reading or generating a thumbnail nobody will see. */
+  if (BLI_task_pool_canceled(pool)) {
+    return;
+  }
+
   //  printf("%s: Start (%d)...\n", __func__, threadid);
 
   //  printf("%s: %d - %s - %p\n", __func__, preview->index, preview->path, preview->img);
@@ -2074,14 +2080,15 @@ bool filelist_file_cache_block(struct FileList *filelist, const int index)
 
   //  printf("Re-queueing previews...\n");
 
-  /* Note we try to preview first images around given index - i.e. assumed visible ones. */
+  /* Note we try to preview first images around given index - i.e. assumed visible ones.
+   * The center entry is only pushed once, so it is not generated twice in parallel. */
   if (cache->flags & FLC_PREVIEWS_ACTIVE) {
     for (i = 0; ((index + i) < end_index) || ((index - i) >= start_index); i++) {
       if ((index - i) >= start_index) {
         const int idx = (cache->block_cursor + (index - start_index) - i) % cache_size;
         filelist_cache_previews_push(filelist, cache->block_entries[idx], index - i);
       }
-      if ((index + i) < end_index) {
+      if (i != 0 && (index + i) < end_index) {
         const int idx = (cache->block_cursor + (index - start_index) + i) % cache_size;
         filelist_cache_previews_push(filelist, cache->block_entries[idx], index + i);
       }
@@ -247,6 +247,20 @@ bool outliner_requires_rebuild_on_select_or_active_change(const SpaceOutliner *s
   return exclude_flags & (SO_FILTER_OB_STATE_SELECTED | SO_FILTER_OB_STATE_ACTIVE);
 }
 
+/**
+ * Check if the tree needs a full rebuild when the current frame changes. Only the View Layer mode
+ * stores visibility in the tree (to gray out hidden elements), which may be animated. Filtering
+ * on visibility depends on it too. The Data API mode shows arbitrary RNA data.
+ */
+bool outliner_requires_rebuild_on_frame_change(const SpaceOutliner *space_outliner)
+{
+  if (ELEM(space_outliner->outlinevis, SO_VIEW_LAYER, SO_DATA_API)) {
+    return true;
+  }
+  int exclude_flags = outliner_exclude_filter_get(space_outliner);
+  return exclude_flags & (SO_FILTER_OB_STATE_VISIBLE | SO_FILTER_OB_STATE_SELECTABLE);
+}
+
 /**
  * Check if a display mode needs a full rebuild if the open/collapsed state changes.
  * Element types in these modes don't actually add children if collapsed, so the rebuild is needed.
@@ -25,8 +25,13 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_task.h"
 #include "BLI_timecode.h"
 
+#include "PIL_time.h"
+
+#include "atomic_ops.h"
+
 #include "DNA_scene_types.h"
 
 #include "BKE_context.h"
@@ -68,15 +73,96 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+typedef struct ProxyBuildTask {
+  struct SeqIndexBuildContext *context;
+  short *stop;
+  short do_update;
+  float progress;
+  int32_t *num_finished;
+} ProxyBuildTask;
+
+static void proxy_build_task_run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ProxyBuildTask *task = taskdata;
+
+  SEQ_proxy_rebuild(task->context, task->stop, &task->do_update, &task->progress);
+  atomic_add_and_fetch_int32(task->num_finished, 1);
+}
+
+/* Build the movie strips in the queue in parallel, each of them decodes and encodes on its own.
+ * Strips may be added to the queue while the job runs, returns how many of the queued strips
+ * were considered, or 0 when nothing was built. */
+static int proxy_build_parallel(ProxyJob *pj, short *stop, short *do_update, float *progress)
+{
+  const int num_queued = BLI_listbase_count(&pj->queue);
+  int num_tasks = 0;
+  LinkData *link = pj->queue.first;
+  for (int i = 0; i < num_queued; i++, link = link->next) {
+    if (SEQ_proxy_rebuild_is_threadsafe(link->data)) {
+      num_tasks++;
+    }
+  }
+
+  if (num_tasks < 2) {
+    return 0;
+  }
+
+  ProxyBuildTask *tasks = MEM_callocN(sizeof(ProxyBuildTask) * num_tasks, "proxy build tasks");
+  int32_t num_finished = 0;
+  int i = 0;
+
+  TaskPool *task_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  link = pj->queue.first;
+  for (int j = 0; j < num_queued; j++, link = link->next) {
+    if (SEQ_proxy_rebuild_is_threadsafe(link->data)) {
+      tasks[i].context = link->data;
+      tasks[i].stop = stop;
+      tasks[i].num_finished = &num_finished;
+      BLI_task_pool_push(task_pool, proxy_build_task_run, &tasks[i], false, NULL);
+      i++;
+    }
+  }
+
+  /* Report the combined progress while the strips are being built. */
+  while (atomic_add_and_fetch_int32(&num_finished, 0) < num_tasks) {
+    PIL_sleep_ms(50);
+
+    float total_progress = 0.0f;
+    for (i = 0; i < num_tasks; i++) {
+      total_progress += tasks[i].progress;
+    }
+    *progress = total_progress / num_tasks;
+    *do_update = true;
+  }
+
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+  MEM_freeN(tasks);
+
+  return num_queued;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
   LinkData *link;
 
-  for (link = pj->queue.first; link; link = link->next) {
+  const int num_built_parallel = proxy_build_parallel(pj, stop, do_update, progress);
+  if (*stop) {
+    pj->stop = 1;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
+    return;
+  }
+
+  int index = 0;
+  for (link = pj->queue.first; link; link = link->next, index++) {
     struct SeqIndexBuildContext *context = link->data;
 
+    if (index < num_built_parallel && SEQ_proxy_rebuild_is_threadsafe(context)) {
+      continue;
+    }
+
     SEQ_proxy_rebuild(context, stop, do_update, progress);
 
     if (*stop) {
@@ -29,7 +29,7 @@
 #include "BLI_alloca.h"
 #include "BLI_bitmap.h"
 #include "BLI_ghash.h"
-#include "BLI_linklist_stack.h"
+#include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 
@@ -252,10 +252,8 @@ static void editmesh_islands_info_calc(BMEditMesh *em,
 static bool bmesh_test_dist_add(BMVert *v,
                                 BMVert *v_other,
                                 float *dists,
-                                const float *dists_prev,
                                 /* optionally track original index */
                                 int *index,
-                                const int *index_prev,
                                 const float mtx[3][3])
 {
   if ((BM_elem_flag_test(v_other, BM_ELEM_SELECT) == 0) &&
@@ -267,11 +265,11 @@ static bool bmesh_test_dist_add(BMVert *v,
     sub_v3_v3v3(vec, v->co, v_other->co);
     mul_m3_v3(mtx, vec);
 
-    dist_other = dists_prev[i] + len_v3(vec);
+    dist_other = dists[i] + len_v3(vec);
     if (dist_other < dists[i_other]) {
       dists[i_other] = dist_other;
       if (index != NULL) {
-        index[i_other] = index_prev[i];
+        index[i_other] = index[i];
       }
       return true;
     }
@@ -281,6 +279,9 @@ static bool bmesh_test_dist_add(BMVert *v,
 }
 
 /**
+ * Multi-source Dijkstra, starting from all selected vertices. Every vertex is expanded once, when
+ * its distance is final, instead of being revisited each time a shorter path to it is found.
+ *
  * \param mtx: Measure distance in this space.
  * \param dists: Store the closest connected distance to selected vertices.
  * \param index: Optionally store the original index we're measuring the distance to (can be NULL).
@@ -290,13 +291,7 @@ static void editmesh_set_connectivity_distance(BMesh *bm,
                                                float *dists,
                                                int *index)
 {
-  BLI_LINKSTACK_DECLARE(queue, BMVert *);
-
-  /* any BM_ELEM_TAG'd vertex is in 'queue_next', so we don't add in twice */
-  BLI_LINKSTACK_DECLARE(queue_next, BMVert *);
-
-  BLI_LINKSTACK_INIT(queue);
-  BLI_LINKSTACK_INIT(queue_next);
+  HeapSimple *heap = BLI_heapsimple_new();
 
   {
     BMIter viter;
@@ -310,16 +305,13 @@ static void editmesh_set_connectivity_distance(BMesh *bm,
 
       if (BM_elem_flag_test(v, BM_ELEM_SELECT) == 0 || BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
         dist = FLT_MAX;
-        if (index != NULL) {
-          index[i] = i;
-        }
       }
       else {
-        BLI_LINKSTACK_PUSH(queue, v);
+        BLI_heapsimple_insert(heap, 0.0f, v);
         dist = 0.0f;
-        if (index != NULL) {
-          index[i] = i;
-        }
+      }
+      if (index != NULL) {
+        index[i] = i;
       }
 
       dists[i] = dist;
@@ -327,103 +319,62 @@ static void editmesh_set_connectivity_distance(BMesh *bm,
     bm->elem_index_dirty &= ~BM_VERT;
   }
 
-  /* need to be very careful of feedback loops here, store previous dist's to avoid feedback */
-  float *dists_prev = MEM_dupallocN(dists);
-  int *index_prev = MEM_dupallocN(index); /* may be NULL */
+  while (!BLI_heapsimple_is_empty(heap)) {
+    const float dist = BLI_heapsimple_top_value(heap);
+    BMVert *v = BLI_heapsimple_pop_min(heap);
 
-  do {
-    BMVert *v;
-    LinkNode *lnk;
-
-    /* this is correct but slow to do each iteration,
-     * instead sync the dist's while clearing BM_ELEM_TAG (below) */
-#if 0
-    memcpy(dists_prev, dists, sizeof(float) * bm->totvert);
-#endif
-
-    while ((v = BLI_LINKSTACK_POP(queue))) {
-      BLI_assert(dists[BM_elem_index_get(v)] != FLT_MAX);
+    /* A shorter path to this vertex was found after it was added, it has been expanded already. */
+    if (dist > dists[BM_elem_index_get(v)]) {
+      continue;
+    }
 
-      /* connected edge-verts */
-      if (v->e != NULL) {
-        BMEdge *e_iter, *e_first;
+    /* connected edge-verts */
+    if (v->e != NULL) {
+      BMEdge *e_iter, *e_first;
 
-        e_iter = e_first = v->e;
+      e_iter = e_first = v->e;
 
-        /* would normally use BM_EDGES_OF_VERT, but this runs so often,
-         * its faster to iterate on the data directly */
-        do {
+      /* would normally use BM_EDGES_OF_VERT, but this runs so often,
+       * its faster to iterate on the data directly */
+      do {
 
-          if (BM_elem_flag_test(e_iter, BM_ELEM_HIDDEN) == 0) {
+        if (BM_elem_flag_test(e_iter, BM_ELEM_HIDDEN) == 0) {
 
-            /* edge distance */
-            {
-              BMVert *v_other = BM_edge_other_vert(e_iter, v);
-              if (bmesh_test_dist_add(v, v_other, dists, dists_prev, index, index_prev, mtx)) {
-                if (BM_elem_flag_test(v_other, BM_ELEM_TAG) == 0) {
-                  BM_elem_flag_enable(v_other, BM_ELEM_TAG);
-                  BLI_LINKSTACK_PUSH(queue_next, v_other);
-                }
-              }
+          /* edge distance */
+          {
+            BMVert *v_other = BM_edge_other_vert(e_iter, v);
+            if (bmesh_test_dist_add(v, v_other, dists, index, mtx)) {
+              BLI_heapsimple_insert(heap, dists[BM_elem_index_get(v_other)], v_other);
             }
+          }
 
-            /* face distance */
-            if (e_iter->l) {
-              BMLoop *l_iter_radial, *l_first_radial;
-              /**
-               * imaginary edge diagonally across quad.
-               * \note This takes advantage of the rules of winding that we
-               * know 2 or more of a verts edges wont reference the same face twice.
-               * Also, if the edge is hidden, the face will be hidden too.
-               */
-              l_iter_radial = l_first_radial = e_iter->l;
-
-              do {
-                if ((l_iter_radial->v == v) && (l_iter_radial->f->len == 4) &&
-                    (BM_elem_flag_test(l_iter_radial->f, BM_ELEM_HIDDEN) == 0)) {
-                  BMVert *v_other = l_iter_radial->next->next->v;
-                  if (bmesh_test_dist_add(v, v_other, dists, dists_prev, index, index_prev, mtx)) {
-                    if (BM_elem_flag_test(v_other, BM_ELEM_TAG) == 0) {
-                      BM_elem_flag_enable(v_other, BM_ELEM_TAG);
-                      BLI_LINKSTACK_PUSH(queue_next, v_other);
-                    }
-                  }
+          /* face distance */
+          if (e_iter->l) {
+            BMLoop *l_iter_radial, *l_first_radial;
+            /**
+             * imaginary edge diagonally across quad.
+             * \note This takes advantage of the rules of winding that we
+             * know 2 or more of a verts edges wont reference the same face twice.
+             * Also, if the edge is hidden, the face will be hidden too.
+             */
+            l_iter_radial = l_first_radial = e_iter->l;
+
+            do {
+              if ((l_iter_radial->v == v) && (l_iter_radial->f->len == 4) &&
+                  (BM_elem_flag_test(l_iter_radial->f, BM_ELEM_HIDDEN) == 0)) {
+                BMVert *v_other = l_iter_radial->next->next->v;
+                if (bmesh_test_dist_add(v, v_other, dists, index, mtx)) {
+                  BLI_heapsimple_insert(heap, dists[BM_elem_index_get(v_other)], v_other);
                 }
-              } while ((l_iter_radial = l_iter_radial->radial_next) != l_first_radial);
-            }
+              }
+            } while ((l_iter_radial = l_iter_radial->radial_next) != l_first_radial);
           }
-        } while ((e_iter = BM_DISK_EDGE_NEXT(e_iter, v)) != e_first);
-      }
-    }
-
-    /* clear for the next loop */
-    for (lnk = queue_next; lnk; lnk = lnk->next) {
-      BMVert *v_link = lnk->link;
-      const int i = BM_elem_index_get(v_link);
-
-      BM_elem_flag_disable(v_link, BM_ELEM_TAG);
-
-      /* keep in sync, avoid having to do full memcpy each iteration */
-      dists_prev[i] = dists[i];
-      if (index != NULL) {
-        index_prev[i] = index[i];
-      }
+        }
+      } while ((e_iter = BM_DISK_EDGE_NEXT(e_iter, v)) != e_first);
     }
-
-    BLI_LINKSTACK_SWAP(queue, queue_next);
-
-    /* none should be tagged now since 'queue_next' is empty */
-    BLI_assert(BM_iter_mesh_count_flag(BM_VERTS_OF_MESH, bm, BM_ELEM_TAG, true) == 0);
-
-  } while (BLI_LINKSTACK_SIZE(queue));
-
-  BLI_LINKSTACK_FREE(queue);
-  BLI_LINKSTACK_FREE(queue_next);
-
-  MEM_freeN(dists_prev);
-  if (index_prev != NULL) {
-    MEM_freeN(index_prev);
   }
+
+  BLI_heapsimple_free(heap, NULL);
 }
 
 /** \} */
@@ -1584,6 +1535,13 @@ void recalcData_mesh(TransInfo *t)
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
     EDBM_mesh_normals_update(em);
     BKE_editmesh_looptri_calc(em);
+
+    /* Transforming custom-data (bevel weight, skin radius, crease) or correcting it changes
+     * more than the vertex coordinates. */
+    const bool coords_only = !is_canceling && (t->data_type == TC_MESH_VERTS) &&
+                             !ELEM(t->mode, TFM_BWEIGHT, TFM_SKIN_RESIZE) &&
+                             (tc->custom.type.data == NULL);
+    BKE_editmesh_tag_coords_only_update(em, coords_only);
   }
 }
 /** \} */
@@ -1603,6 +1561,12 @@ void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
     mesh_customdatacorrect_apply(t, true);
   }
 
+  /* Don't keep the modifier stack input of the transform updates around. */
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+    BKE_editmesh_tag_coords_only_update(em, false);
+  }
+
   if (use_automerge) {
     FOREACH_TRANS_DATA_CONTAINER (t, tc) {
       BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
@@ -645,6 +645,11 @@ static bool raycastMesh(SnapObjectContext *sctx,
             ray_start_local, ray_normal_local, bb->vec[0], bb->vec[6], &len_diff, NULL)) {
       return retval;
     }
+    /* The bounding box is behind the nearest hit found so far, so nothing in it can be closer.
+     * This skips the tree lookup and the ray-cast for most objects in large scenes. */
+    if (r_hit_list == NULL && len_diff > local_depth) {
+      return retval;
+    }
   }
   /* We pass a temp ray_start, set from object's boundbox, to avoid precision issues with
    * very far away ray_start values (as returned in case of ortho view3d), see T50486, T38358.
@@ -819,6 +824,10 @@ static bool raycastEditMesh(SnapObjectContext *sctx,
           ray_start_local, ray_normal_local, sod->min, sod->max, &len_diff, NULL)) {
     return retval;
   }
+  /* The bounding box is behind the nearest hit found so far. */
+  if (r_hit_list == NULL && len_diff > local_depth) {
+    return retval;
+  }
 
   /* We pass a temp ray_start, set from object's boundbox, to avoid precision issues with
    * very far away ray_start values (as returned in case of ortho view3d), see T50486, T38358.
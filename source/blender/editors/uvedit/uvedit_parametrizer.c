@@ -28,6 +28,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "uvedit_parametrizer.h"
@@ -4594,51 +4595,77 @@ void param_construct_end(ParamHandle *handle, ParamBool fill, ParamBool topology
   phandle->state = PHANDLE_STATE_CONSTRUCTED;
 }
 
-void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
+/* Charts are independent once constructed, so they are solved in parallel. */
+
+typedef struct PLscmData {
+  PHandle *phandle;
+  PBool live, abf;
+} PLscmData;
+
+static void p_lscm_begin_cb(void *__restrict userdata,
+                            const int i,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  PHandle *phandle = (PHandle *)handle;
+  PLscmData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
   PFace *f;
-  int i;
 
-  param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
-  phandle->state = PHANDLE_STATE_LSCM;
+  for (f = chart->faces; f; f = f->nextlink) {
+    p_face_backup_uvs(f);
+  }
+  p_chart_lscm_begin(chart, data->live, data->abf);
+}
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    for (f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
+static void p_lscm_solve_cb(void *__restrict userdata,
+                            const int i,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PLscmData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
+  PBool result;
+
+  if (chart->u.lscm.context) {
+    result = p_chart_lscm_solve(data->phandle, chart);
+
+    if (result && !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_rotate_minimum_area(chart);
+    }
+    else if (result && chart->u.lscm.single_pin) {
+      p_chart_rotate_fit_aabb(chart);
+      p_chart_lscm_transform_single_pin(chart);
+    }
+
+    if (!result || !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_lscm_end(chart);
     }
-    p_chart_lscm_begin(phandle->charts[i], (PBool)live, (PBool)abf);
   }
 }
 
-void param_lscm_solve(ParamHandle *handle)
+void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
 {
   PHandle *phandle = (PHandle *)handle;
-  PChart *chart;
-  int i;
-  PBool result;
 
-  param_assert(phandle->state == PHANDLE_STATE_LSCM);
+  param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
+  phandle->state = PHANDLE_STATE_LSCM;
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
+  PLscmData data = {.phandle = phandle, .live = (PBool)live, .abf = (PBool)abf};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_lscm_begin_cb, &settings);
+}
 
-    if (chart->u.lscm.context) {
-      result = p_chart_lscm_solve(phandle, chart);
+void param_lscm_solve(ParamHandle *handle)
+{
+  PHandle *phandle = (PHandle *)handle;
 
-      if (result && !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_rotate_minimum_area(chart);
-      }
-      else if (result && chart->u.lscm.single_pin) {
-        p_chart_rotate_fit_aabb(chart);
-        p_chart_lscm_transform_single_pin(chart);
-      }
+  param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-      if (!result || !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_lscm_end(chart);
-      }
-    }
-  }
+  PLscmData data = {.phandle = phandle};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_lscm_solve_cb, &settings);
 }
 
 void param_lscm_end(ParamHandle *handle)
@@ -28,8 +28,44 @@
 
 #include "BKE_global.h"
 
+#include "BLI_task.h"
+
 namespace Freestyle {
 
+// Faces and edges are independent of each other in the view dependent and silhouette passes,
+// shapes with more elements than this are processed in parallel.
+static const size_t FEDGEX_PARALLEL_THRESHOLD = 1024;
+
+struct FEdgeXTaskData {
+  FEdgeXDetector *detector;
+  vector<WFace *> *faces;
+  vector<WEdge *> *edges;
+};
+
+static void fedgex_preprocess_face_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict /*tls*/)
+{
+  FEdgeXTaskData *data = (FEdgeXTaskData *)userdata;
+  data->detector->preProcessFace((WXFace *)(*data->faces)[i]);
+}
+
+static void fedgex_silhouette_face_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict /*tls*/)
+{
+  FEdgeXTaskData *data = (FEdgeXTaskData *)userdata;
+  data->detector->ProcessSilhouetteFace((WXFace *)(*data->faces)[i]);
+}
+
+static void fedgex_silhouette_edge_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict /*tls*/)
+{
+  FEdgeXTaskData *data = (FEdgeXTaskData *)userdata;
+  data->detector->ProcessSilhouetteEdge((WXEdge *)(*data->edges)[i]);
+}
+
 void FEdgeXDetector::processShapes(WingedEdge &we)
 {
   bool progressBarDisplay = false;
@@ -131,11 +167,12 @@ void FEdgeXDetector::preProcessShape(WXShape *iWShape)
 #endif
 
   vector<WFace *> &wfaces = iWShape->GetFaceList();
-  vector<WFace *>::iterator f, fend;
   // view dependent stuff
-  for (f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    preProcessFace((WXFace *)(*f));
-  }
+  FEdgeXTaskData data = {this, &wfaces, nullptr};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (wfaces.size() > FEDGEX_PARALLEL_THRESHOLD);
+  BLI_task_parallel_range(0, wfaces.size(), &data, fedgex_preprocess_face_cb, &settings);
 
   if (_computeRidgesAndValleys || _computeSuggestiveContours) {
     vector<WVertex *> &wvertices = iWShape->getVertexList();
@@ -266,17 +303,16 @@ void FEdgeXDetector::processSilhouetteShape(WXShape *iWShape)
 {
   // Make a first pass on every polygons in order to compute all their silhouette relative values:
   vector<WFace *> &wfaces = iWShape->GetFaceList();
-  vector<WFace *>::iterator f, fend;
-  for (f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    ProcessSilhouetteFace((WXFace *)(*f));
-  }
+  vector<WEdge *> &wedges = iWShape->getEdgeList();
+  FEdgeXTaskData data = {this, &wfaces, &wedges};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (wfaces.size() > FEDGEX_PARALLEL_THRESHOLD);
+  BLI_task_parallel_range(0, wfaces.size(), &data, fedgex_silhouette_face_cb, &settings);
 
   // Make a pass on the edges to detect the silhouette edges that are not smooth
-  vector<WEdge *>::iterator we, weend;
-  vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessSilhouetteEdge((WXEdge *)(*we));
-  }
+  settings.use_threading = (wedges.size() > FEDGEX_PARALLEL_THRESHOLD);
+  BLI_task_parallel_range(0, wedges.size(), &data, fedgex_silhouette_edge_cb, &settings);
 }
 
 void FEdgeXDetector::ProcessSilhouetteFace(WXFace *iFace)
@@ -28,6 +28,41 @@
 
 namespace blender::fn {
 
+namespace detail {
+
+/**
+ * Gives access to a single value through the same interface as an array.
+ */
+template<typename T> struct SingleElementAccessor {
+  const T *value;
+
+  const T &operator[](int64_t UNUSED(index)) const
+  {
+    return *value;
+  }
+};
+
+/**
+ * Calls the given function with an accessor for the elements of the virtual span. When the span
+ * is backed by a single value or by a full array, the accessor is a non-virtual type, so that
+ * element functions inlined into the loop over the mask can be vectorized by the compiler.
+ */
+template<typename T, typename FuncT>
+inline void devirtualize_vspan(const VSpan<T> &span, const FuncT &func)
+{
+  if (span.is_single_element()) {
+    func(SingleElementAccessor<T>{&span.as_single_element()});
+  }
+  else if (span.is_full_array()) {
+    func(span.as_full_array().data());
+  }
+  else {
+    func(span);
+  }
+}
+
+}  // namespace detail
+
 /**
  * Generates a multi-function with the following parameters:
  * 1. single input (SI) of type In1
@@ -58,8 +93,12 @@ template<typename In1, typename Out1> class CustomMF_SI_SO : public MultiFunctio
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, VSpan<In1> in1, MutableSpan<Out1> out1) {
-      mask.foreach_index(
-          [&](int i) { new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i])); });
+      Out1 *out1_data = out1.data();
+      detail::devirtualize_vspan(in1, [&](const auto &in1_data) {
+        mask.foreach_index([&](int64_t i) {
+          new (static_cast<void *>(out1_data + i)) Out1(element_fn(in1_data[i]));
+        });
+      });
     };
   }
 
@@ -101,8 +140,14 @@ class CustomMF_SI_SI_SO : public MultiFunction {
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, VSpan<In1> in1, VSpan<In2> in2, MutableSpan<Out1> out1) {
-      mask.foreach_index(
-          [&](int i) { new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i])); });
+      Out1 *out1_data = out1.data();
+      detail::devirtualize_vspan(in1, [&](const auto &in1_data) {
+        detail::devirtualize_vspan(in2, [&](const auto &in2_data) {
+          mask.foreach_index([&](int64_t i) {
+            new (static_cast<void *>(out1_data + i)) Out1(element_fn(in1_data[i], in2_data[i]));
+          });
+        });
+      });
     };
   }
 
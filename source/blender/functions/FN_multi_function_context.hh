@@ -28,6 +28,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_arena_allocator.hh"
 #include "BLI_map.hh"
 
 namespace blender::fn {
@@ -37,6 +38,7 @@ class MFContext;
 class MFContextBuilder {
  private:
   Map<std::string, const void *> global_contexts_;
+  LinearAllocator<> *arena_ = nullptr;
 
   friend MFContext;
 
@@ -45,6 +47,15 @@ class MFContextBuilder {
   {
     global_contexts_.add_new(std::move(name), static_cast<const void *>(context));
   }
+
+  /**
+   * Memory for temporary allocations of called functions, that is valid for the whole
+   * evaluation. The caller owns the arena and may reset it after the evaluation.
+   */
+  void set_arena(LinearAllocator<> &arena)
+  {
+    arena_ = &arena;
+  }
 };
 
 class MFContext {
@@ -62,6 +73,15 @@ class MFContext {
     /* TODO: Implement type checking. */
     return static_cast<const T *>(context);
   }
+
+  /**
+   * \return The arena passed to #MFContextBuilder::set_arena or null. It is not thread-safe,
+   * functions that evaluate in parallel have to use their own arena per thread.
+   */
+  LinearAllocator<> *arena() const
+  {
+    return builder_.arena_;
+  }
 };
 
 }  // namespace blender::fn
@@ -449,6 +449,28 @@ class GVSpan : public VSpanBase<void> {
       type_->copy_to_uninitialized((*this)[i], POINTER_OFFSET(dst, element_size * i));
     }
   }
+
+  /**
+   * Get a virtual span that starts at the given index. A single value stays a single value.
+   */
+  GVSpan slice(int64_t start, int64_t size) const
+  {
+    BLI_assert(start >= 0);
+    BLI_assert(size >= 0);
+    BLI_assert(start + size <= virtual_size_);
+    switch (this->category_) {
+      case VSpanCategory::Single:
+        return GVSpan::FromSingle(*type_, this->data_.single.data, size);
+      case VSpanCategory::FullArray:
+        return GVSpan(GSpan(
+            *type_, POINTER_OFFSET(this->data_.full_array.data, start * type_->size()), size));
+      case VSpanCategory::FullPointerArray:
+        return GVSpan::FromFullPointerArray(
+            *type_, this->data_.full_pointer_array.data + start, size);
+    }
+    BLI_assert(false);
+    return GVSpan(*type_);
+  }
 };
 
 }  // namespace blender::fn
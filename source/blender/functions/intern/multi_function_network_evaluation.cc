@@ -28,6 +28,9 @@
  * - Avoids data copies in many cases.
  * - Every node is executed at most once.
  * - Can compute sub-functions on a single element, when the result is the same for all elements.
+ *   The result is broadcast when it has to be written to an output array of the caller.
+ * - Splits large masks into chunks that are evaluated in parallel, when all parameters are
+ *   single values.
  *
  * Possible improvements:
  * - Cache and reuse buffers.
@@ -38,6 +41,7 @@
 #include "FN_multi_function_network_evaluation.hh"
 
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 
 namespace blender::fn {
 
@@ -91,6 +95,7 @@ class MFNetworkEvaluationStorage {
    * longer needed. */
   void finish_node(const MFFunctionNode &node);
   void finish_output_socket(const MFOutputSocket &socket);
+  void broadcast_single_output(const MFOutputSocket &socket);
   void finish_input_socket(const MFInputSocket &socket);
 
   IndexMask mask() const;
@@ -135,12 +140,23 @@ MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
   }
 }
 
+/**
+ * Masks with more indices than this are split into chunks. Every chunk gets its own storage, so
+ * intermediate buffers only have the size of a chunk and chunks can be evaluated in parallel.
+ */
+static constexpr int64_t evaluation_chunk_size = 4096;
+
 void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context) const
 {
   if (mask.size() == 0) {
     return;
   }
 
+  if (mask.size() > evaluation_chunk_size && this->can_evaluate_in_chunks()) {
+    this->call_in_chunks(mask, params, context);
+    return;
+  }
+
   const MFNetwork &network = outputs_[0]->node().network();
   Storage storage(mask, network.socket_id_amount());
 
@@ -152,6 +168,97 @@ void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context
   this->initialize_remaining_outputs(params, storage, outputs_to_initialize_in_the_end);
 }
 
+/**
+ * Vector arrays cannot be sliced, so only networks with single value parameters are chunked.
+ */
+bool MFNetworkEvaluator::can_evaluate_in_chunks() const
+{
+  for (int param_index : this->param_indices()) {
+    switch (this->param_type(param_index).category()) {
+      case MFParamType::SingleInput:
+      case MFParamType::SingleOutput:
+      case MFParamType::SingleMutable:
+        break;
+      case MFParamType::VectorInput:
+      case MFParamType::VectorOutput:
+      case MFParamType::VectorMutable:
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Evaluate the network separately for consecutive parts of the mask. The indices of each chunk
+ * are shifted to start at zero and the parameter spans are sliced accordingly, so that storage for
+ * a chunk does not have to cover the full array size.
+ */
+BLI_NOINLINE void MFNetworkEvaluator::call_in_chunks(IndexMask mask,
+                                                     MFParams params,
+                                                     MFContext context) const
+{
+  const int64_t chunk_amount = (mask.size() + evaluation_chunk_size - 1) / evaluation_chunk_size;
+
+  parallel_for(IndexRange(chunk_amount), 1, [&](IndexRange chunk_range) {
+    Vector<int64_t> chunk_indices;
+
+    for (int64_t chunk_index : chunk_range) {
+      const int64_t mask_start = chunk_index * evaluation_chunk_size;
+      const int64_t mask_size = std::min(evaluation_chunk_size, mask.size() - mask_start);
+      const Span<int64_t> indices = mask.indices().slice(mask_start, mask_size);
+      const int64_t offset = indices.first();
+      const int64_t array_size = indices.last() - offset + 1;
+
+      IndexMask chunk_mask;
+      if (array_size == mask_size) {
+        chunk_mask = IndexRange(mask_size);
+      }
+      else {
+        chunk_indices.clear();
+        for (int64_t i : indices) {
+          chunk_indices.append(i - offset);
+        }
+        chunk_mask = chunk_indices.as_span();
+      }
+
+      MFParamsBuilder chunk_params(*this, array_size);
+      for (int param_index : this->param_indices()) {
+        MFParamType param_type = this->param_type(param_index);
+        switch (param_type.category()) {
+          case MFParamType::SingleInput: {
+            GVSpan span = params.readonly_single_input(param_index);
+            chunk_params.add_readonly_single_input(span.slice(offset, array_size));
+            break;
+          }
+          case MFParamType::SingleOutput: {
+            GMutableSpan span = params.uninitialized_single_output(param_index);
+            chunk_params.add_uninitialized_single_output(
+                GMutableSpan(span.type(),
+                             POINTER_OFFSET(span.data(), offset * span.type().size()),
+                             array_size));
+            break;
+          }
+          case MFParamType::SingleMutable: {
+            GMutableSpan span = params.single_mutable(param_index);
+            chunk_params.add_single_mutable(
+                GMutableSpan(span.type(),
+                             POINTER_OFFSET(span.data(), offset * span.type().size()),
+                             array_size));
+            break;
+          }
+          case MFParamType::VectorInput:
+          case MFParamType::VectorOutput:
+          case MFParamType::VectorMutable:
+            BLI_assert(false);
+            break;
+        }
+      }
+
+      this->call(chunk_mask, chunk_params, context);
+    }
+  });
+}
+
 BLI_NOINLINE void MFNetworkEvaluator::copy_inputs_to_storage(MFParams params,
                                                              Storage &storage) const
 {
@@ -308,6 +415,10 @@ BLI_NOINLINE void MFNetworkEvaluator::evaluate_function(MFContext &global_contex
     }
 
     function.call(IndexRange(1), params, global_context);
+
+    for (const MFOutputSocket *socket : function_node.outputs()) {
+      storage.broadcast_single_output(*socket);
+    }
   }
   else {
     MFParamsBuilder params{function, storage.mask().min_array_size()};
@@ -370,11 +481,19 @@ bool MFNetworkEvaluator::can_do_single_value_evaluation(const MFFunctionNode &fu
       return false;
     }
   }
-  if (storage.mask().min_array_size() >= 1) {
-    for (const MFOutputSocket *socket : function_node.outputs()) {
-      if (storage.socket_has_buffer_for_output(*socket)) {
-        return false;
-      }
+  const MultiFunction &function = function_node.function();
+  for (int param_index : function.param_indices()) {
+    MFParamType param_type = function.param_type(param_index);
+    if (!param_type.is_output_or_mutable()) {
+      continue;
+    }
+    /* Single outputs are computed once and broadcast to the array of the caller afterwards. */
+    if (param_type.category() == MFParamType::SingleOutput) {
+      continue;
+    }
+    const MFOutputSocket &socket = function_node.output_for_param(param_index);
+    if (storage.socket_has_buffer_for_output(socket)) {
+      return false;
     }
   }
   return true;
@@ -609,6 +728,26 @@ void MFNetworkEvaluationStorage::finish_output_socket(const MFOutputSocket &sock
   }
 }
 
+/**
+ * Copies the value that was computed for the first index of the mask to all other indices, when
+ * a function was evaluated on a single element but writes to an output array of the caller.
+ */
+void MFNetworkEvaluationStorage::broadcast_single_output(const MFOutputSocket &socket)
+{
+  Value *any_value = value_per_output_id_[socket.id()];
+  if (any_value == nullptr || any_value->type != ValueType::OutputSingle) {
+    return;
+  }
+
+  GMutableSpan span = static_cast<OutputSingleValue *>(any_value)->span;
+  if (span.size() == 1) {
+    return;
+  }
+
+  const void *value = span[mask_[0]];
+  span.type().fill_uninitialized_indices(value, span.data(), mask_.indices().drop_front(1));
+}
+
 void MFNetworkEvaluationStorage::finish_input_socket(const MFInputSocket &socket)
 {
   const MFOutputSocket &origin = *socket.origin();
@@ -731,7 +870,10 @@ GMutableSpan MFNetworkEvaluationStorage::get_single_output__single(const MFOutpu
 
   BLI_assert(any_value->type == ValueType::OutputSingle);
   GMutableSpan span = static_cast<OutputSingleValue *>(any_value)->span;
-  BLI_assert(span.size() == 1);
+  if (span.size() > 1) {
+    /* Compute the value in place for the first index, it is broadcast to the others later. */
+    return GMutableSpan(span.type(), span[mask_[0]], 1);
+  }
   return span;
 }
 
@@ -251,5 +251,43 @@ TEST(multi_function_network, Test2)
   }
 }
 
+TEST(multi_function_network, LargeMask)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+
+  MFNetwork network;
+
+  MFNode &node = network.add_function(add_10_fn);
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_socket, node.input(0));
+  network.add_link(node.output(0), output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket}};
+
+  const int size = 20000;
+  Array<int> values(size);
+  for (int i : values.index_range()) {
+    values[i] = i;
+  }
+  Vector<int64_t> indices;
+  for (int i = 0; i < size; i += 3) {
+    indices.append(i);
+  }
+  Array<int> results(size, -1);
+
+  MFParamsBuilder params(network_fn, size);
+  params.add_readonly_single_input(values.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+
+  network_fn.call(indices.as_span(), params, context);
+
+  for (int i : results.index_range()) {
+    EXPECT_EQ(results[i], (i % 3 == 0) ? i + 10 : -1);
+  }
+}
+
 }  // namespace
 }  // namespace blender::fn::tests
@@ -257,8 +257,10 @@ static void deformStroke(GpencilModifierData *md,
     /* just object target */
     copy_m4_m4(dmat, mmd->object->obmat);
   }
-  invert_m4_m4(ob->imat, ob->obmat);
-  mul_m4_series(tData.mat, ob->imat, dmat, mmd->parentinv);
+  /* Strokes are deformed in parallel, so don't write to ob->imat here. */
+  float imat[4][4];
+  invert_m4_m4(imat, ob->obmat);
+  mul_m4_series(tData.mat, imat, dmat, mmd->parentinv);
 
   /* loop points and apply deform */
   for (int i = 0; i < gps->totpoints; i++) {
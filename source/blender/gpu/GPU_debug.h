@@ -36,6 +36,15 @@ void GPU_debug_group_end(void);
 void GPU_debug_get_groups_names(int name_buf_len, char *r_name_buf);
 bool GPU_debug_group_match(const char *ref);
 
+/** Opaque type hiding blender::gpu::QueryPool of time elapsed queries. */
+typedef struct GPUTimerPool GPUTimerPool;
+
+GPUTimerPool *GPU_timer_pool_create(void);
+void GPU_timer_pool_free(GPUTimerPool *pool);
+void GPU_timer_begin(GPUTimerPool *pool);
+void GPU_timer_end(GPUTimerPool *pool);
+void GPU_timer_pool_results_get(GPUTimerPool *pool, uint64_t *r_times, int times_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -145,6 +145,9 @@ double *GPU_viewport_cache_time_get(GPUViewport *viewport);
 void GPU_viewport_tag_update(GPUViewport *viewport);
 bool GPU_viewport_do_update(GPUViewport *viewport);
 
+void GPU_viewport_overlay_cache_store(GPUViewport *viewport);
+bool GPU_viewport_overlay_cache_restore(GPUViewport *viewport);
+
 GPUTexture *GPU_viewport_color_texture(GPUViewport *viewport, int view);
 
 /* Texture pool */
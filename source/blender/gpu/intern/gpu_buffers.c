@@ -163,6 +163,28 @@ static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
   return GPU_vertbuf_get_data(buffers->vert_buf) != NULL;
 }
 
+/* Only upload the vertices that differ from the data of the previous update. */
+static void gpu_pbvh_vert_buf_tag_changed(GPUVertBuf *vert_buf, const uchar *vert_data_prev)
+{
+  const uchar *vert_data = GPU_vertbuf_get_data(vert_buf);
+  const uint stride = GPU_vertbuf_get_format(vert_buf)->stride;
+  const uint vert_len = GPU_vertbuf_get_vertex_len(vert_buf);
+
+  uint first = 0, last = vert_len;
+  while (first < last && memcmp(vert_data + first * stride,
+                                vert_data_prev + first * stride,
+                                stride) == 0) {
+    first++;
+  }
+  while (last > first && memcmp(vert_data + (last - 1) * stride,
+                                vert_data_prev + (last - 1) * stride,
+                                stride) == 0) {
+    last--;
+  }
+
+  GPU_vertbuf_tag_dirty_range(vert_buf, first, last - first);
+}
+
 static void gpu_pbvh_batch_init(GPU_PBVH_Buffers *buffers, GPUPrimType prim)
 {
   if (buffers->triangles == NULL) {
@@ -226,6 +248,18 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
   {
     const int totelem = buffers->tot_tri * 3;
 
+    /* Keep the data of the vertex buffer after upload, so only the vertices that changed since
+     * the last update have to be uploaded again. Brush strokes usually change a small part. */
+    if (buffers->vert_buf == NULL) {
+      buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_DYNAMIC);
+    }
+    uchar *vert_data_prev = NULL;
+    if (GPU_vertbuf_get_data(buffers->vert_buf) != NULL &&
+        GPU_vertbuf_get_vertex_len(buffers->vert_buf) == totelem &&
+        (GPU_vertbuf_get_status(buffers->vert_buf) & GPU_VERTBUF_DATA_UPLOADED)) {
+      vert_data_prev = MEM_dupallocN(GPU_vertbuf_get_data(buffers->vert_buf));
+    }
+
     /* Build VBO */
     if (gpu_pbvh_vert_buf_data_set(buffers, totelem)) {
       GPUVertBufRaw pos_step = {0};
@@ -323,8 +357,14 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           memcpy(GPU_vertbuf_raw_step(&fset_step), face_set_color, sizeof(uchar[3]));
         }
       }
+
+      if (vert_data_prev) {
+        gpu_pbvh_vert_buf_tag_changed(buffers->vert_buf, vert_data_prev);
+      }
     }
 
+    MEM_SAFE_FREE(vert_data_prev);
+
     gpu_pbvh_batch_init(buffers, GPU_PRIM_TRIS);
   }
 
@@ -69,6 +69,10 @@ extern char datatoc_gpu_shader_common_obinfos_lib_glsl[];
 static GPUPass *pass_cache = NULL;
 static SpinLock pass_cache_spin;
 
+/* Materials sharing a GPUPass can be compiled from different threads at the same time. */
+static ThreadMutex pass_compile_lock;
+static ThreadCondition pass_compile_cond;
+
 static uint32_t gpu_pass_hash(const char *frag_gen, const char *defs, ListBase *attributes)
 {
   BLI_HashMurmur2A hm2a;
@@ -994,8 +998,16 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
+
+  BLI_mutex_lock(&pass_compile_lock);
+  while (pass->compiling) {
+    BLI_condition_wait(&pass_compile_cond, &pass_compile_lock);
+  }
   if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
+    pass->compiling = true;
+    BLI_mutex_unlock(&pass_compile_lock);
+
+    GPUShader *shader = GPU_shader_create_cached(
         pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
 
     /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
@@ -1008,9 +1020,14 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
         shader = NULL;
       }
     }
+
+    BLI_mutex_lock(&pass_compile_lock);
     pass->shader = shader;
     pass->compiled = true;
+    pass->compiling = false;
+    BLI_condition_notify_all(&pass_compile_cond);
   }
+  BLI_mutex_unlock(&pass_compile_lock);
 
   return success;
 }
@@ -1084,10 +1101,14 @@ void GPU_pass_cache_free(void)
 
 void gpu_codegen_init(void)
 {
+  BLI_mutex_init(&pass_compile_lock);
+  BLI_condition_init(&pass_compile_cond);
 }
 
 void gpu_codegen_exit(void)
 {
+  BLI_condition_end(&pass_compile_cond);
+  BLI_mutex_end(&pass_compile_lock);
   BKE_material_defaults_free_gpu();
   GPU_shader_free_builtin_shaders();
 }
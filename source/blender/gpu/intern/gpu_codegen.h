@@ -47,6 +47,7 @@ typedef struct GPUPass {
   uint refcount; /* Orphaned GPUPasses gets freed by the garbage collector. */
   uint32_t hash; /* Identity hash generated from all GLSL code. */
   bool compiled; /* Did we already tried to compile the attached GPUShader. */
+  bool compiling; /* Another thread is compiling the shader, see #GPU_pass_compile. */
 } GPUPass;
 
 /* Pass */
@@ -163,6 +163,7 @@ void GPU_context_main_unlock(void)
  * \{ */
 
 static GPUBackend *g_backend;
+static eGPUBackendType g_backend_type = GPU_BACKEND_NONE;
 
 void GPU_backend_init(eGPUBackendType backend_type)
 {
@@ -176,8 +177,9 @@ void GPU_backend_init(eGPUBackendType backend_type)
 #endif
     default:
       BLI_assert(0);
-      break;
+      return;
   }
+  g_backend_type = backend_type;
 }
 
 void GPU_backend_exit(void)
@@ -186,6 +188,16 @@ void GPU_backend_exit(void)
    * correctly. */
   delete g_backend;
   g_backend = nullptr;
+  g_backend_type = GPU_BACKEND_NONE;
+}
+
+/**
+ * Type of the backend in use, so code that can't go through the #GPUBackend abstraction
+ * (e.g. raw GL calls in add-ons or external engines) can check it is running on OpenGL.
+ */
+eGPUBackendType GPU_backend_get_type(void)
+{
+  return g_backend_type;
 }
 
 GPUBackend *GPUBackend::get()
@@ -27,7 +27,9 @@
 
 #include "BLI_string.h"
 
+#include "gpu_backend.hh"
 #include "gpu_context_private.hh"
+#include "gpu_query.hh"
 
 #include "GPU_debug.h"
 
@@ -94,3 +96,48 @@ bool GPU_debug_group_match(const char *ref)
   }
   return false;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name GPU timers
+ *
+ * Pools of time elapsed queries. Timers can't be nested and reading the results is a sync
+ * point, so query them a frame later to avoid stalling the pipeline.
+ * \{ */
+
+static QueryPool *unwrap(GPUTimerPool *pool)
+{
+  return reinterpret_cast<QueryPool *>(pool);
+}
+
+GPUTimerPool *GPU_timer_pool_create(void)
+{
+  QueryPool *pool = GPUBackend::get()->querypool_alloc();
+  pool->init(GPU_QUERY_TIME_ELAPSED);
+  return reinterpret_cast<GPUTimerPool *>(pool);
+}
+
+void GPU_timer_pool_free(GPUTimerPool *pool)
+{
+  delete unwrap(pool);
+}
+
+void GPU_timer_begin(GPUTimerPool *pool)
+{
+  unwrap(pool)->begin_query();
+}
+
+void GPU_timer_end(GPUTimerPool *pool)
+{
+  unwrap(pool)->end_query();
+}
+
+/**
+ * \param r_times: Time in nanoseconds of each timer, \a times_len must be the number of timers
+ * issued since the creation of the pool.
+ */
+void GPU_timer_pool_results_get(GPUTimerPool *pool, uint64_t *r_times, int times_len)
+{
+  unwrap(pool)->get_time_result(MutableSpan<uint64_t>(r_times, times_len));
+}
+
+/** \} */
@@ -51,6 +51,7 @@ void GPU_init(void)
 
   gpu_codegen_init();
   gpu_material_library_init();
+  gpu_shader_cache_init();
 
   gpu_batch_init();
 
@@ -67,6 +68,7 @@ void GPU_exit(void)
 
   gpu_batch_exit();
 
+  gpu_shader_cache_exit();
   gpu_material_library_exit();
   gpu_codegen_exit();
 
@@ -28,6 +28,10 @@ extern "C" {
 void gpu_pbvh_init(void);
 void gpu_pbvh_exit(void);
 
+/* gpu_shader_cache.cc */
+void gpu_shader_cache_init(void);
+void gpu_shader_cache_exit(void);
+
 #ifdef __cplusplus
 }
 #endif
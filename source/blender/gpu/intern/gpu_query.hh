@@ -29,6 +29,7 @@ namespace blender::gpu {
 
 typedef enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  GPU_QUERY_TIME_ELAPSED,
 } GPUQueryType;
 
 class QueryPool {
@@ -54,6 +55,11 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+  /**
+   * Same as #get_occlusion_result for #GPU_QUERY_TIME_ELAPSED pools.
+   * Result for each query is the GPU time spent between its begin and end in nanoseconds.
+   */
+  virtual void get_time_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
 }  // namespace blender::gpu
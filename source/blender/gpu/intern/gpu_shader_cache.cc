@@ -0,0 +1,271 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * On disk cache of linked shader programs.
+ *
+ * Each program binary is stored in its own file named after a hash of the shader sources, the
+ * GPU / driver identification and the Blender version, so the cache can be shared between
+ * sessions and between machines using the same driver (e.g. render farm nodes pointing
+ * `BLENDER_SHADER_CACHE_DIR` to a shared folder). Binaries rejected by the driver are
+ * compiled again from source and replaced.
+ */
+
+#include <mutex>
+#include <stdio.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_path_util.h"
+#include "BLI_set.hh"
+#include "BLI_string.h"
+#include "BLI_system.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_appdir.h"
+#include "BKE_blender_version.h"
+#include "BKE_global.h"
+
+#include "GPU_platform.h"
+#include "GPU_shader.h"
+
+#include "gpu_backend.hh"
+#include "gpu_private.h"
+#include "gpu_shader_private.hh"
+
+#include BLI_SYSTEM_PID_H
+
+using namespace blender;
+using namespace blender::gpu;
+
+#define SHADER_CACHE_EXT ".bin"
+#define SHADER_CACHE_MAGIC "BSH1"
+
+typedef struct ShaderCacheHeader {
+  char magic[4];
+  uint32_t binary_format;
+  uint32_t binary_len;
+} ShaderCacheHeader;
+
+/** Empty when the cache is disabled. */
+static char cache_dir[FILE_MAX] = "";
+/** Keys of the binaries found on disk, avoids trying to open files for new shaders. */
+static Set<uint64_t> *cache_keys = nullptr;
+static std::mutex cache_mutex;
+
+/* -------------------------------------------------------------------- */
+/** \name Initialization
+ * \{ */
+
+void gpu_shader_cache_init(void)
+{
+  const char *env_dir = BLI_getenv("BLENDER_SHADER_CACHE_DIR");
+  if (env_dir != nullptr && env_dir[0] != '\0') {
+    BLI_strncpy(cache_dir, env_dir, sizeof(cache_dir));
+    BLI_dir_create_recursive(cache_dir);
+  }
+  else {
+    const char *user_dir = BKE_appdir_folder_id_create(BLENDER_USER_DATAFILES, "shader_cache");
+    if (user_dir == nullptr) {
+      cache_dir[0] = '\0';
+      return;
+    }
+    BLI_strncpy(cache_dir, user_dir, sizeof(cache_dir));
+  }
+
+  if (!BLI_is_dir(cache_dir)) {
+    cache_dir[0] = '\0';
+    return;
+  }
+
+  cache_keys = new Set<uint64_t>();
+
+  struct direntry *entries;
+  const uint entries_len = BLI_filelist_dir_contents(cache_dir, &entries);
+  for (uint i = 0; i < entries_len; i++) {
+    const char *name = entries[i].relname;
+    if (strlen(name) != 16 + strlen(SHADER_CACHE_EXT) ||
+        !BLI_path_extension_check(name, SHADER_CACHE_EXT)) {
+      continue;
+    }
+    unsigned long long key;
+    if (sscanf(name, "%16llx", &key) == 1) {
+      cache_keys->add((uint64_t)key);
+    }
+  }
+  BLI_filelist_free(entries, entries_len);
+}
+
+void gpu_shader_cache_exit(void)
+{
+  delete cache_keys;
+  cache_keys = nullptr;
+  cache_dir[0] = '\0';
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Cache files
+ * \{ */
+
+static void shader_cache_hash_add_str(BLI_HashMurmur2A *mm2, const char *str)
+{
+  /* Add the length so that moving code between the sources changes the key. */
+  const int len = (str) ? (int)strlen(str) : -1;
+  BLI_hash_mm2a_add_int(mm2, len);
+  if (len > 0) {
+    BLI_hash_mm2a_add(mm2, (const uchar *)str, (size_t)len);
+  }
+}
+
+static uint32_t shader_cache_hash(const char *sources[], const int sources_len, uint32_t seed)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, seed);
+  BLI_hash_mm2a_add_int(&mm2, BLENDER_VERSION);
+  BLI_hash_mm2a_add_int(&mm2, (G.debug & G_DEBUG_GPU_FORCE_WORKAROUNDS) != 0);
+  /* Contains the vendor, renderer and driver version. */
+  shader_cache_hash_add_str(&mm2, GPU_platform_support_level_key());
+  for (int i = 0; i < sources_len; i++) {
+    shader_cache_hash_add_str(&mm2, sources[i]);
+  }
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+static void shader_cache_filepath(uint64_t key, char r_path[FILE_MAX])
+{
+  char name[32];
+  BLI_snprintf(name, sizeof(name), "%016llx" SHADER_CACHE_EXT, (unsigned long long)key);
+  BLI_join_dirfile(r_path, FILE_MAX, cache_dir, name);
+}
+
+static bool shader_cache_load(Shader *shader, uint64_t key)
+{
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (!cache_keys->contains(key)) {
+      return false;
+    }
+  }
+
+  char filepath[FILE_MAX];
+  shader_cache_filepath(key, filepath);
+
+  size_t data_len;
+  uchar *data = (uchar *)BLI_file_read_binary_as_mem(filepath, 0, &data_len);
+  if (data == nullptr) {
+    return false;
+  }
+
+  bool success = false;
+  ShaderCacheHeader header;
+  if (data_len >= sizeof(header)) {
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.binary_len == data_len - sizeof(header)) {
+      Span<uint8_t> binary(data + sizeof(header), header.binary_len);
+      success = shader->binary_load(binary, header.binary_format);
+    }
+  }
+  MEM_freeN(data);
+
+  return success;
+}
+
+static void shader_cache_store(Shader *shader, uint64_t key)
+{
+  Vector<uint8_t> binary;
+  uint32_t binary_format;
+  if (!shader->binary_get(binary, binary_format)) {
+    return;
+  }
+
+  ShaderCacheHeader header;
+  memcpy(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic));
+  header.binary_format = binary_format;
+  header.binary_len = (uint32_t)binary.size();
+
+  char filepath[FILE_MAX], filepath_tmp[FILE_MAX], hostname[64];
+  shader_cache_filepath(key, filepath);
+  /* Write to a file unique to this process and rename it, so that other instances sharing the
+   * cache folder never read a partially written binary. */
+  BLI_hostname_get(hostname, sizeof(hostname));
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%s-%d", filepath, hostname, (int)getpid());
+
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+                       (fwrite(binary.data(), binary.size(), 1, file) == 1);
+  fclose(file);
+
+  /* Replaces any binary rejected by the driver. */
+  if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cache_keys->add(key);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Creation
+ * \{ */
+
+/**
+ * Same as #GPU_shader_create but the linked program is read from (and stored to) the on disk
+ * shader cache when the backend supports it.
+ */
+GPUShader *GPU_shader_create_cached(const char *vertcode,
+                                    const char *fragcode,
+                                    const char *geomcode,
+                                    const char *libcode,
+                                    const char *defines,
+                                    const char *shname)
+{
+  if (cache_keys == nullptr) {
+    return GPU_shader_create(vertcode, fragcode, geomcode, libcode, defines, shname);
+  }
+
+  const char *sources[] = {vertcode, fragcode, geomcode, libcode, defines};
+  const uint64_t key = ((uint64_t)shader_cache_hash(sources, ARRAY_SIZE(sources), 0) << 32) |
+                       shader_cache_hash(sources, ARRAY_SIZE(sources), 0x9747b28c);
+
+  Shader *shader = GPUBackend::get()->shader_alloc(shname);
+  if (shader_cache_load(shader, key)) {
+    return wrap(shader);
+  }
+  delete shader;
+
+  GPUShader *gpu_shader = GPU_shader_create(
+      vertcode, fragcode, geomcode, libcode, defines, shname);
+  if (gpu_shader != nullptr) {
+    shader_cache_store(unwrap(gpu_shader), key);
+  }
+  return gpu_shader;
+}
+
+/** \} */
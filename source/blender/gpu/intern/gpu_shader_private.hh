@@ -21,6 +21,7 @@
 #pragma once
 
 #include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 #include "GPU_shader.h"
 #include "gpu_shader_interface.hh"
@@ -51,6 +52,20 @@ class Shader {
   virtual void fragment_shader_from_glsl(MutableSpan<const char *> sources) = 0;
   virtual bool finalize(void) = 0;
 
+  /**
+   * Program binaries used by the on disk shader cache (see `gpu_shader_cache.cc`).
+   * Backends without support keep the default implementation and always compile from source.
+   * Return true on success.
+   */
+  virtual bool binary_get(Vector<uint8_t> & /*r_binary*/, uint32_t & /*r_format*/)
+  {
+    return false;
+  }
+  virtual bool binary_load(Span<uint8_t> /*binary*/, uint32_t /*format*/)
+  {
+    return false;
+  }
+
   virtual void transform_feedback_names_set(Span<const char *> name_list,
                                             const eGPUShaderTFBType geom_type) = 0;
   virtual bool transform_feedback_enable(GPUVertBuf *) = 0;
@@ -94,6 +94,7 @@ void VertBuf::allocate(uint vert_len)
   this->acquire_data();
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
+  dirty_len = 0;
 }
 
 void VertBuf::resize(uint vert_len)
@@ -105,6 +106,7 @@ void VertBuf::resize(uint vert_len)
   this->resize_data();
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
+  dirty_len = 0;
 }
 
 void VertBuf::upload()
@@ -324,6 +326,27 @@ void GPU_vertbuf_use(GPUVertBuf *verts)
   unwrap(verts)->upload();
 }
 
+/**
+ * Tag that only the vertices in the given range changed since the data was last uploaded,
+ * so only they are uploaded on next use. A zero length range means nothing changed.
+ * Only useful for buffers that keep their data after upload (#GPU_USAGE_DYNAMIC).
+ */
+void GPU_vertbuf_tag_dirty_range(GPUVertBuf *verts_, uint v_start, uint v_len)
+{
+  VertBuf *verts = unwrap(verts_);
+  BLI_assert(verts->data != nullptr);
+  BLI_assert(v_start + v_len <= verts->vertex_len);
+
+  if (v_len == 0) {
+    verts->flag &= ~GPU_VERTBUF_DATA_DIRTY;
+  }
+  else {
+    verts->flag |= GPU_VERTBUF_DATA_DIRTY;
+  }
+  verts->dirty_start = v_start;
+  verts->dirty_len = v_len;
+}
+
 /* XXX this is just a wrapper for the use of the Hair refine workaround.
  * To be used with GPU_vertbuf_use(). */
 void GPU_vertbuf_update_sub(GPUVertBuf *verts, uint start, uint len, void *data)
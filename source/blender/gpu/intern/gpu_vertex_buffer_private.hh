@@ -46,6 +46,10 @@ class VertBuf {
   GPUVertBufStatus flag = GPU_VERTBUF_INVALID;
   /** NULL indicates data in VRAM (unmapped) */
   uchar *data = NULL;
+  /** Range of vertices to upload when only part of the data changed, zero length to upload
+   * all data. See #GPU_vertbuf_tag_dirty_range. */
+  uint dirty_start = 0;
+  uint dirty_len = 0;
 
  protected:
   /** Usage hint for GL optimization. */
@@ -121,6 +121,8 @@ struct GPUViewport {
 enum {
   DO_UPDATE = (1 << 0),
   GPU_VIEWPORT_STEREO = (1 << 1),
+  /* The overlay cache holds the result of the last full draw. */
+  GPU_VIEWPORT_OVERLAY_CACHE = (1 << 2),
 };
 
 static void gpu_viewport_buffers_free(
@@ -141,6 +143,57 @@ bool GPU_viewport_do_update(GPUViewport *viewport)
   return ret;
 }
 
+/**
+ * Copy the overlay color and depth buffers, to be called after the scene and the draw engine
+ * overlays are drawn but before the editor overlays (gizmos, annotations, region info) are.
+ * A redraw of only the editor overlays can then start from this copy instead of running the draw
+ * engines again. The cache is not used for stereo viewports.
+ */
+void GPU_viewport_overlay_cache_store(GPUViewport *viewport)
+{
+  DefaultFramebufferList *dfbl = viewport->fbl;
+  DefaultTextureList *dtxl = viewport->txl;
+
+  if (viewport->flag & GPU_VIEWPORT_STEREO) {
+    return;
+  }
+
+  if (dfbl->overlay_cache_fb == NULL) {
+    dtxl->color_overlay_cache = GPU_texture_create_2d(
+        "dtxl_color_overlay_cache", UNPACK2(viewport->size), 1, GPU_SRGB8_A8, NULL);
+    dtxl->depth_cache = GPU_texture_create_2d(
+        "dtxl_depth_cache", UNPACK2(viewport->size), 1, GPU_DEPTH24_STENCIL8, NULL);
+
+    GPU_framebuffer_ensure_config(&dfbl->overlay_cache_fb,
+                                  {
+                                      GPU_ATTACHMENT_TEXTURE(dtxl->depth_cache),
+                                      GPU_ATTACHMENT_TEXTURE(dtxl->color_overlay_cache),
+                                  });
+  }
+
+  GPU_framebuffer_blit(
+      dfbl->overlay_fb, 0, dfbl->overlay_cache_fb, 0, GPU_COLOR_BIT | GPU_DEPTH_BIT);
+  viewport->flag |= GPU_VIEWPORT_OVERLAY_CACHE;
+}
+
+/**
+ * Copy the overlay cache back into the overlay color and depth buffers.
+ *
+ * \return false when there is no valid cache, the region then needs a full redraw.
+ */
+bool GPU_viewport_overlay_cache_restore(GPUViewport *viewport)
+{
+  DefaultFramebufferList *dfbl = viewport->fbl;
+
+  if ((viewport->flag & GPU_VIEWPORT_OVERLAY_CACHE) == 0 || dfbl->overlay_cache_fb == NULL) {
+    return false;
+  }
+
+  GPU_framebuffer_blit(
+      dfbl->overlay_cache_fb, 0, dfbl->overlay_fb, 0, GPU_COLOR_BIT | GPU_DEPTH_BIT);
+  return true;
+}
+
 GPUViewport *GPU_viewport_create(void)
 {
   GPUViewport *viewport = MEM_callocN(sizeof(GPUViewport), "GPUViewport");
@@ -520,6 +573,7 @@ void GPU_viewport_bind(GPUViewport *viewport, int view, const rcti *rect)
 
       gpu_viewport_texture_pool_free(viewport);
       viewport->active_view = -1;
+      viewport->flag &= ~GPU_VIEWPORT_OVERLAY_CACHE;
     }
   }
 
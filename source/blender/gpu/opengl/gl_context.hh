@@ -62,6 +62,7 @@ class GLContext : public Context {
   static GLint max_ubo_binds;
   /** Extensions. */
   static bool base_instance_support;
+  static bool buffer_storage_support;
   static bool clear_texture_support;
   static bool copy_image_support;
   static bool debug_layer_support;
@@ -69,6 +70,7 @@ class GLContext : public Context {
   static bool fixed_restart_index_support;
   static bool multi_bind_support;
   static bool multi_draw_indirect_support;
+  static bool program_binary_support;
   static bool shader_draw_parameters_support;
   static bool texture_cube_map_array_support;
   static bool texture_filter_anisotropic_support;
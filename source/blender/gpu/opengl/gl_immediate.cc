@@ -47,30 +47,21 @@ GLImmediate::GLImmediate()
   glGenVertexArrays(1, &vao_id_);
   glBindVertexArray(vao_id_); /* Necessary for glObjectLabel. */
 
-  buffer.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer.buffer_size, nullptr, GL_DYNAMIC_DRAW);
-
-  buffer_strict.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer_strict.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer_strict.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer_strict.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+  buffer_create(buffer, DEFAULT_INTERNAL_BUFFER_SIZE);
+  buffer_create(buffer_strict, DEFAULT_INTERNAL_BUFFER_SIZE);
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
 
   debug::object_label(GL_VERTEX_ARRAY, vao_id_, "Immediate");
-  debug::object_label(GL_BUFFER, buffer.vbo_id, "ImmediateVbo");
-  debug::object_label(GL_BUFFER, buffer_strict.vbo_id, "ImmediateVboStrict");
 }
 
 GLImmediate::~GLImmediate()
 {
   glDeleteVertexArrays(1, &vao_id_);
 
-  glDeleteBuffers(1, &buffer.vbo_id);
-  glDeleteBuffers(1, &buffer_strict.vbo_id);
+  buffer_free(buffer);
+  buffer_free(buffer_strict);
 }
 
 /** \} */
@@ -79,6 +70,84 @@ GLImmediate::~GLImmediate()
 /** \name Buffer management
  * \{ */
 
+void GLImmediate::buffer_create(ImmediateBuffer &buf, size_t size)
+{
+  buf.buffer_size = size;
+  buf.buffer_offset = 0;
+
+  glGenBuffers(1, &buf.vbo_id);
+  glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+  if (GLContext::buffer_storage_support) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+    buf.persistent_data = (uchar *)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+    BLI_assert(buf.persistent_data != nullptr);
+    buf.section_current = 0;
+    buf.section_waited = -1;
+  }
+  else {
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+  }
+
+  debug::object_label(
+      GL_BUFFER, buf.vbo_id, (&buf == &buffer_strict) ? "ImmediateVboStrict" : "ImmediateVbo");
+}
+
+void GLImmediate::buffer_free(ImmediateBuffer &buf)
+{
+  for (GLsync &fence : buf.fences) {
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+  /* Deleting the buffer also unmaps it. The storage is kept alive by the driver until pending
+   * draws are done with it. */
+  buf.persistent_data = nullptr;
+  glDeleteBuffers(1, &buf.vbo_id);
+  buf.vbo_id = 0;
+}
+
+/**
+ * Make sure the GPU is done reading the ring buffer sections covering the given range before
+ * writing to it, and fence the sections the drawing moved past.
+ */
+void GLImmediate::ring_sections_acquire(ImmediateBuffer &buf,
+                                        size_t offset,
+                                        size_t len,
+                                        bool wrap)
+{
+  const size_t section_size = (buf.buffer_size + IMMEDIATE_RING_SECTIONS - 1) /
+                              IMMEDIATE_RING_SECTIONS;
+  const size_t end = offset + ((len > 0) ? len : 1);
+  const int first = (int)(offset / section_size);
+  const int last = min_ii((int)((end - 1) / section_size), IMMEDIATE_RING_SECTIONS - 1);
+
+  /* A single fence for all the sections would be enough, but separate ones are simpler to track
+   * and there are only a few of them per lap. */
+  const int fence_end = (wrap) ? buf.section_waited + 1 : first;
+  for (int s = buf.section_current; s < fence_end; s++) {
+    BLI_assert(buf.fences[s] == nullptr);
+    buf.fences[s] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+  if (wrap) {
+    buf.section_waited = -1;
+  }
+
+  for (int s = buf.section_waited + 1; s <= last; s++) {
+    if (buf.fences[s] != nullptr) {
+      while (glClientWaitSync(buf.fences[s], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) ==
+             GL_TIMEOUT_EXPIRED) {
+        /* Wait. */
+      }
+      glDeleteSync(buf.fences[s]);
+      buf.fences[s] = nullptr;
+    }
+  }
+  buf.section_waited = max_ii(buf.section_waited, last);
+  buf.section_current = first;
+}
+
 uchar *GLImmediate::begin()
 {
   /* How many bytes do we need for this draw call? */
@@ -107,6 +176,28 @@ uchar *GLImmediate::begin()
   /* Might waste a little space, but it's safe. */
   const uint pre_padding = padding(buffer_offset(), vertex_format.stride);
 
+  ImmediateBuffer &buf = active_buffer();
+  if (buf.persistent_data != nullptr) {
+    if (recreate_buffer) {
+      /* Immutable storage can't be resized, replace the whole buffer. */
+      buffer_free(buf);
+      buffer_create(buf, buf.buffer_size);
+      ring_sections_acquire(buf, 0, bytes_needed, false);
+    }
+    else if ((bytes_needed + pre_padding) <= available_bytes) {
+      buf.buffer_offset += pre_padding;
+      ring_sections_acquire(buf, buf.buffer_offset, bytes_needed, false);
+    }
+    else {
+      /* Start again from the beginning of the buffer. */
+      buf.buffer_offset = 0;
+      ring_sections_acquire(buf, 0, bytes_needed, true);
+    }
+
+    bytes_mapped_ = bytes_needed;
+    return buf.persistent_data + buf.buffer_offset;
+  }
+
   if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
     buffer_offset() += pre_padding;
   }
@@ -140,16 +231,19 @@ void GLImmediate::end()
   BLI_assert(prim_type != GPU_PRIM_NONE); /* make sure we're between a Begin/End pair */
 
   uint buffer_bytes_used = bytes_mapped_;
-  if (!strict_vertex_len) {
-    if (vertex_idx != vertex_len) {
-      vertex_len = vertex_idx;
-      buffer_bytes_used = vertex_buffer_size(&vertex_format, vertex_len);
-      /* unused buffer bytes are available to the next immBegin */
+  if (!strict_vertex_len && vertex_idx != vertex_len) {
+    vertex_len = vertex_idx;
+    buffer_bytes_used = vertex_buffer_size(&vertex_format, vertex_len);
+    /* unused buffer bytes are available to the next immBegin */
+  }
+  /* Writes to the persistent mapping are coherent and don't need to be flushed. */
+  if (active_buffer().persistent_data == nullptr) {
+    if (!strict_vertex_len) {
+      /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
     }
-    /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
   }
-  glUnmapBuffer(GL_ARRAY_BUFFER);
 
   if (vertex_len > 0) {
     GLContext::get()->state_manager->apply_state();
@@ -157,8 +251,37 @@ void GLImmediate::end()
     /* We convert the offset in vertex offset from the buffer's start.
      * This works because we added some padding to align the first vertex vertex.  */
     uint v_first = buffer_offset() / vertex_format.stride;
-    GLVertArray::update_bindings(
-        vao_id_, v_first, &vertex_format, reinterpret_cast<Shader *>(shader)->interface);
+    const ShaderInterface *interface = reinterpret_cast<Shader *>(shader)->interface;
+
+    /* Consecutive draws using the same vertex layout (e.g. the UI widgets & text) only need
+     * to offset the first vertex, rebinding attributes is much more expensive. */
+    BindingKey key = {};
+    key.vbo_id = vbo_id();
+    key.stride = vertex_format.stride;
+    key.attr_len = vertex_format.attr_len;
+    for (uint a_idx = 0; a_idx < vertex_format.attr_len; a_idx++) {
+      const GPUVertAttr *a = &vertex_format.attrs[a_idx];
+      key.attrs[a_idx] = a->fetch_mode | (a->comp_type << 2) | (a->comp_len << 5) |
+                         (a->offset << 10);
+      for (uint n_idx = 0; n_idx < GPU_VERT_ATTR_MAX_NAMES; n_idx++) {
+        const ShaderInput *input = nullptr;
+        if (n_idx < a->name_len) {
+          input = interface->attr_get(GPU_vertformat_attr_name_get(&vertex_format, a, n_idx));
+        }
+        key.locations[a_idx][n_idx] = (input != nullptr) ? input->location : -1;
+      }
+    }
+
+    if (binding_valid_ && v_first >= binding_v_first_ &&
+        memcmp(&key, &binding_, sizeof(key)) == 0) {
+      glBindVertexArray(vao_id_);
+    }
+    else {
+      GLVertArray::update_bindings(vao_id_, v_first, &vertex_format, interface);
+      binding_ = key;
+      binding_v_first_ = v_first;
+      binding_valid_ = !vertex_format.deinterleaved;
+    }
 
     /* Update matrices. */
     GPU_shader_bind(shader);
@@ -166,7 +289,7 @@ void GLImmediate::end()
 #ifdef __APPLE__
     glDisable(GL_PRIMITIVE_RESTART);
 #endif
-    glDrawArrays(to_gl(prim_type), 0, vertex_len);
+    glDrawArrays(to_gl(prim_type), v_first - binding_v_first_, vertex_len);
 #ifdef __APPLE__
     glEnable(GL_PRIMITIVE_RESTART);
 #endif
@@ -35,25 +35,50 @@ namespace blender::gpu {
 
 /* size of internal buffer */
 #define DEFAULT_INTERNAL_BUFFER_SIZE (4 * 1024 * 1024)
+/* Number of fenced sections of the persistently mapped buffers. */
+#define IMMEDIATE_RING_SECTIONS 4
 
 class GLImmediate : public Immediate {
  private:
   /* Use two buffers for strict and unstrict vertex count to
    * avoid some huge driver slowdown (see T70922).
    * Use accessor functions to get / modify. */
-  struct {
+  struct ImmediateBuffer {
     /** Opengl Handle for this buffer. */
     GLuint vbo_id = 0;
     /** Offset of the mapped data in data. */
     size_t buffer_offset = 0;
     /** Size of the whole buffer in bytes. */
     size_t buffer_size = 0;
+    /**
+     * Persistent mapping of the whole buffer when buffer storage is supported. The buffer is
+     * then used as a ring buffer, each section being fenced once the drawing moved past it so
+     * it is only written again once the GPU is done reading it.
+     */
+    uchar *persistent_data = nullptr;
+    GLsync fences[IMMEDIATE_RING_SECTIONS] = {};
+    /** Section of the first vertex written by the last draw. */
+    int section_current = 0;
+    /** Last section that is safe to write to in the current lap. */
+    int section_waited = -1;
   } buffer, buffer_strict;
   /** Size in bytes of the mapped region. */
   size_t bytes_mapped_ = 0;
   /** Vertex array for this immediate mode instance. */
   GLuint vao_id_ = 0;
 
+  /** Vertex attributes layout bound to the vertex array, to skip rebinding identical ones. */
+  struct BindingKey {
+    GLuint vbo_id;
+    uint stride;
+    uint attr_len;
+    uint attrs[GPU_VERT_ATTR_MAX_LEN];
+    int locations[GPU_VERT_ATTR_MAX_LEN][GPU_VERT_ATTR_MAX_NAMES];
+  } binding_ = {};
+  /** First vertex the attribute pointers of #binding_ are relative to. */
+  uint binding_v_first_ = 0;
+  bool binding_valid_ = false;
+
  public:
   GLImmediate();
   ~GLImmediate();
@@ -62,20 +87,29 @@ class GLImmediate : public Immediate {
   void end(void) override;
 
  private:
+  ImmediateBuffer &active_buffer(void)
+  {
+    return strict_vertex_len ? buffer_strict : buffer;
+  };
+
   GLuint &vbo_id(void)
   {
-    return strict_vertex_len ? buffer_strict.vbo_id : buffer.vbo_id;
+    return active_buffer().vbo_id;
   };
 
   size_t &buffer_offset(void)
   {
-    return strict_vertex_len ? buffer_strict.buffer_offset : buffer.buffer_offset;
+    return active_buffer().buffer_offset;
   };
 
   size_t &buffer_size(void)
   {
-    return strict_vertex_len ? buffer_strict.buffer_size : buffer.buffer_size;
+    return active_buffer().buffer_size;
   };
+
+  void buffer_create(ImmediateBuffer &buf, size_t size);
+  void buffer_free(ImmediateBuffer &buf);
+  void ring_sections_acquire(ImmediateBuffer &buf, size_t offset, size_t len, bool wrap);
 };
 
 }  // namespace blender::gpu
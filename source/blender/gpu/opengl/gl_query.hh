@@ -54,6 +54,7 @@ class GLQueryPool : public QueryPool {
   void end_query(void) override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  void get_time_result(MutableSpan<uint64_t> r_values) override;
 };
 
 static inline GLenum to_gl(GPUQueryType type)
@@ -62,6 +63,9 @@ static inline GLenum to_gl(GPUQueryType type)
     /* TODO(fclem): try with GL_ANY_SAMPLES_PASSED​. */
     return GL_SAMPLES_PASSED;
   }
+  if (type == GPU_QUERY_TIME_ELAPSED) {
+    return GL_TIME_ELAPSED;
+  }
   BLI_assert(0);
   return GL_SAMPLES_PASSED;
 }
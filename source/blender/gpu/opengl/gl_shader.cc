@@ -178,6 +178,11 @@ bool GLShader::finalize()
     return false;
   }
 
+  if (GLContext::program_binary_support) {
+    /* Needed by some drivers to be able to store the program in the shader cache. */
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -197,6 +202,56 @@ bool GLShader::finalize()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program binary
+ * \{ */
+
+bool GLShader::binary_get(Vector<uint8_t> &r_binary, uint32_t &r_format)
+{
+  if (!GLContext::program_binary_support) {
+    return false;
+  }
+
+  GLint binary_len = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return false;
+  }
+
+  r_binary.resize(binary_len);
+  GLsizei written_len = 0;
+  GLenum format = 0;
+  glGetProgramBinary(shader_program_, binary_len, &written_len, &format, r_binary.data());
+  if (written_len <= 0) {
+    return false;
+  }
+  r_binary.resize(written_len);
+  r_format = format;
+  return true;
+}
+
+bool GLShader::binary_load(Span<uint8_t> binary, uint32_t format)
+{
+  if (!GLContext::program_binary_support) {
+    return false;
+  }
+
+  glProgramBinary(shader_program_, format, binary.data(), binary.size());
+
+  /* Binaries are rejected when they were created by another driver or GPU. */
+  GLint status;
+  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+  if (!status) {
+    return false;
+  }
+
+  interface = new GLShaderInterface(shader_program_);
+
+  return true;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
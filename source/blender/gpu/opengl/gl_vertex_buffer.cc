@@ -84,19 +84,28 @@ void GLVertBuf::bind()
 {
   BLI_assert(GLContext::get() != nullptr);
 
-  if (vbo_id_ == 0) {
+  const bool vbo_exists = (vbo_id_ != 0);
+  if (!vbo_exists) {
     glGenBuffers(1, &vbo_id_);
   }
 
   glBindBuffer(GL_ARRAY_BUFFER, vbo_id_);
 
   if (flag & GPU_VERTBUF_DATA_DIRTY) {
-    vbo_size_ = this->size_used_get();
-    /* Orphan the vbo to avoid sync then upload data. */
-    glBufferData(GL_ARRAY_BUFFER, vbo_size_, nullptr, to_gl(usage_));
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
+    if (dirty_len != 0 && vbo_exists && vbo_size_ == this->size_used_get()) {
+      /* Only part of the data changed, update it in place. */
+      const size_t offset = (size_t)dirty_start * format.stride;
+      glBufferSubData(GL_ARRAY_BUFFER, offset, (size_t)dirty_len * format.stride, data + offset);
+    }
+    else {
+      vbo_size_ = this->size_used_get();
+      /* Orphan the vbo to avoid sync then upload data. */
+      glBufferData(GL_ARRAY_BUFFER, vbo_size_, nullptr, to_gl(usage_));
+      glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
 
-    memory_usage += vbo_size_;
+      memory_usage += vbo_size_;
+    }
+    dirty_len = 0;
 
     if (usage_ == GPU_USAGE_STATIC) {
       MEM_SAFE_FREE(data);
@@ -744,6 +744,9 @@ struct GPUTexture *IMB_create_gpu_texture(const char *name,
                                           struct ImBuf *ibuf,
                                           bool use_high_bitdepth,
                                           bool use_premult);
+struct GPUTexture *IMB_create_gpu_texture_compressed(const char *name,
+                                                     struct ImBuf *ibuf,
+                                                     bool use_premult);
 struct GPUTexture *IMB_touch_gpu_texture(
     const char *name, struct ImBuf *ibuf, int w, int h, int layers, bool use_high_bitdepth);
 void IMB_update_gpu_texture_sub(struct GPUTexture *tex,
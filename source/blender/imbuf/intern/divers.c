@@ -102,6 +102,59 @@ MINLINE void float_to_byte_dither_v4(
   b[3] = unit_float_to_uchar_clamp(f[3]);
 }
 
+/* Convert a row of RGBA floats to bytes without color space conversion or dithering,
+ * rounding the same way as unit_float_to_uchar_clamp. */
+static void float_to_byte_row_v4(uchar *to, const float *from, int width, bool predivide)
+{
+  int x = 0;
+
+#ifdef __SSE2__
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 scale = _mm_set1_ps(255.0f);
+
+  for (; x + 4 <= width; x += 4, from += 16, to += 16) {
+    __m128i pixels[4];
+
+    for (int i = 0; i < 4; i++) {
+      __m128 color = _mm_loadu_ps(from + i * 4);
+
+      if (predivide) {
+        /* Same as premul_to_straight_v4_v4, alpha of zero or one leaves the color as is. */
+        const __m128 alpha = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 keep = _mm_or_ps(_mm_cmpeq_ps(alpha, zero), _mm_cmpeq_ps(alpha, one));
+        __m128 straight = _mm_mul_ps(color, _mm_div_ps(one, alpha));
+        /* Keep the original alpha in the last lane. */
+        straight = _mm_shuffle_ps(
+            straight, _mm_unpackhi_ps(straight, color), _MM_SHUFFLE(3, 0, 1, 0));
+        color = _mm_or_ps(_mm_and_ps(keep, color), _mm_andnot_ps(keep, straight));
+      }
+
+      /* Clamp before the conversion, the order of operands maps NaN to zero. */
+      __m128 value = _mm_add_ps(_mm_mul_ps(color, scale), half);
+      value = _mm_min_ps(_mm_max_ps(value, zero), scale);
+      pixels[i] = _mm_cvttps_epi32(value);
+    }
+
+    const __m128i lo = _mm_packs_epi32(pixels[0], pixels[1]);
+    const __m128i hi = _mm_packs_epi32(pixels[2], pixels[3]);
+    _mm_storeu_si128((__m128i *)to, _mm_packus_epi16(lo, hi));
+  }
+#endif
+
+  for (; x < width; x++, from += 4, to += 4) {
+    if (predivide) {
+      float straight[4];
+      premul_to_straight_v4_v4(straight, from);
+      rgba_float_to_uchar(to, straight);
+    }
+    else {
+      rgba_float_to_uchar(to, from);
+    }
+  }
+}
+
 /* Test if colorspace conversions of pixels in buffer need to take into account alpha. */
 bool IMB_alpha_affects_rgb(const ImBuf *ibuf)
 {
@@ -196,16 +249,8 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
             float_to_byte_dither_v4(to, from, di, (float)x * inv_width, t);
           }
         }
-        else if (predivide) {
-          for (x = 0; x < width; x++, from += 4, to += 4) {
-            premul_to_straight_v4_v4(straight, from);
-            rgba_float_to_uchar(to, straight);
-          }
-        }
         else {
-          for (x = 0; x < width; x++, from += 4, to += 4) {
-            rgba_float_to_uchar(to, from);
-          }
+          float_to_byte_row_v4(to, from, width, predivide);
         }
       }
       else if (profile_to == IB_PROFILE_SRGB) {
@@ -29,6 +29,7 @@
 #include "BLI_ghash.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #ifdef _WIN32
 #  include "BLI_winstuff.h"
@@ -528,6 +529,9 @@ static struct proxy_output_ctx *alloc_proxy_output_ffmpeg(
     rv->c->flags |= CODEC_FLAG_GLOBAL_HEADER;
   }
 
+  rv->c->thread_count = BLI_system_thread_count();
+  rv->c->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
   if (avio_open(&rv->of->pb, fname, AVIO_FLAG_WRITE) < 0) {
     fprintf(stderr,
             "Couldn't open outputfile! "
@@ -774,6 +778,9 @@ static IndexBuildContext *index_ffmpeg_create_context(struct anim *anim,
 
   context->iCodecCtx->workaround_bugs = 1;
 
+  context->iCodecCtx->thread_count = BLI_system_thread_count();
+  context->iCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
   if (avcodec_open2(context->iCodecCtx, context->iCodec, NULL) < 0) {
     avformat_close_input(&context->iFormatCtx);
     MEM_freeN(context);
@@ -1102,47 +1102,57 @@ void IMB_exr_clear_channels(void *handle)
 void IMB_exr_write_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
-  FrameBuffer frameBuffer;
   ExrChannel *echan;
 
   if (data->channels.first) {
-    const size_t num_pixels = ((size_t)data->width) * data->height;
-    half *rect_half = nullptr, *current_rect_half = nullptr;
+    const int width = data->width;
+    const int height = data->height;
+    /* Half float channels are converted and written in chunks of scanlines, so the temporary
+     * storage stays small for large images with many channels. */
+    const int chunk_height = (data->num_half_channels != 0) ? std::min(height, 64) : height;
+    half *rect_half = nullptr;
 
-    /* We allocate teporary storage for half pixels for all the channels at once. */
     if (data->num_half_channels != 0) {
-      rect_half = (half *)MEM_mallocN(sizeof(half) * data->num_half_channels * num_pixels,
-                                      __func__);
-      current_rect_half = rect_half;
+      rect_half = (half *)MEM_mallocN(
+          sizeof(half) * data->num_half_channels * width * chunk_height, __func__);
     }
 
-    for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
-      /* Writing starts from last scanline, stride negative. */
-      if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = rect[i * echan->xstride];
+    try {
+      for (int y_start = 0; y_start < height; y_start += chunk_height) {
+        const int y_end = std::min(y_start + chunk_height, height);
+        FrameBuffer frameBuffer;
+        half *current_rect_half = rect_half;
+
+        for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
+          /* Writing starts from last scanline, stride negative. */
+          if (echan->use_half_float) {
+            for (int y = y_start; y < y_end; y++) {
+              const float *rect = echan->rect + echan->ystride * (height - 1L - y);
+              half *cur = current_rect_half + (size_t)(y - y_start) * width;
+              for (int x = 0; x < width; x++) {
+                cur[x] = rect[(size_t)x * echan->xstride];
+              }
+            }
+            /* Slices are addressed with scanline coordinates of the whole image. */
+            half *rect_to_write = current_rect_half - (size_t)y_start * width;
+            frameBuffer.insert(
+                echan->name,
+                Slice(Imf::HALF, (char *)rect_to_write, sizeof(half), width * sizeof(half)));
+            current_rect_half += (size_t)width * chunk_height;
+          }
+          else {
+            float *rect = echan->rect + echan->xstride * (height - 1L) * width;
+            frameBuffer.insert(echan->name,
+                               Slice(Imf::FLOAT,
+                                     (char *)rect,
+                                     echan->xstride * sizeof(float),
+                                     -echan->ystride * sizeof(float)));
+          }
         }
-        half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
-        frameBuffer.insert(
-            echan->name,
-            Slice(Imf::HALF, (char *)rect_to_write, sizeof(half), -data->width * sizeof(half)));
-        current_rect_half += num_pixels;
-      }
-      else {
-        float *rect = echan->rect + echan->xstride * (data->height - 1L) * data->width;
-        frameBuffer.insert(echan->name,
-                           Slice(Imf::FLOAT,
-                                 (char *)rect,
-                                 echan->xstride * sizeof(float),
-                                 -echan->ystride * sizeof(float)));
-      }
-    }
 
-    data->ofile->setFrameBuffer(frameBuffer);
-    try {
-      data->ofile->writePixels(data->height);
+        data->ofile->setFrameBuffer(frameBuffer);
+        data->ofile->writePixels(y_end - y_start);
+      }
     }
     catch (const std::exception &exc) {
       std::cerr << "OpenEXR-writePixels: ERROR: " << exc.what() << std::endl;
@@ -1239,6 +1249,7 @@ void IMB_exr_read_channels(void *handle)
     /* Insert all matching channel into framebuffer. */
     FrameBuffer frameBuffer;
     ExrChannel *echan;
+    int num_channels = 0;
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       if (echan->m->part_number != i) {
@@ -1270,12 +1281,19 @@ void IMB_exr_read_channels(void *handle)
 
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+        num_channels++;
       }
       else {
-        printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
+        /* Channels without a rect were not requested by the caller, don't decode them. */
+        exr_printf("skipping channel with no rect set %s\n", echan->m->internal_name.c_str());
       }
     }
 
+    /* Don't decode parts none of the requested channels are stored in. */
+    if (num_channels == 0) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
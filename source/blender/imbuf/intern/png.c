@@ -27,6 +27,7 @@
 
 #include "BLI_fileops.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -121,143 +122,61 @@ BLI_INLINE unsigned short ftoshort(float val)
   return unit_float_to_ushort_clamp(val);
 }
 
-bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
-{
-  png_structp png_ptr;
-  png_infop info_ptr;
-
-  unsigned char *pixels = NULL;
-  unsigned char *from, *to;
-  unsigned short *pixels16 = NULL, *to16;
-  float *from_float, from_straight[4];
-  png_bytepp row_pointers = NULL;
-  int i, bytesperpixel, color_type = PNG_COLOR_TYPE_GRAY;
-  FILE *fp = NULL;
-
-  bool is_16bit = (ibuf->foptions.flag & PNG_16BIT) != 0;
-  bool has_float = (ibuf->rect_float != NULL);
-  int channels_in_float = ibuf->channels ? ibuf->channels : 4;
-
+typedef struct PNGConvertRowsData {
+  const ImBuf *ibuf;
+  unsigned char *pixels;
+  unsigned short *pixels16;
   float (*chanel_colormanage_cb)(float);
-  size_t num_bytes;
-
-  /* use the jpeg quality setting for compression */
-  int compression;
-  compression = (int)(((float)(ibuf->foptions.quality) / 11.1111f));
-  compression = compression < 0 ? 0 : (compression > 9 ? 9 : compression);
-
-  if (ibuf->float_colorspace || (ibuf->colormanage_flag & IMB_COLORMANAGE_IS_DATA)) {
-    /* float buffer was managed already, no need in color space conversion */
-    chanel_colormanage_cb = channel_colormanage_noop;
-  }
-  else {
-    /* standard linear-to-srgb conversion if float buffer wasn't managed */
-    chanel_colormanage_cb = linearrgb_to_srgb;
-  }
-
-  /* for prints */
-  if (flags & IB_mem) {
-    filepath = "<memory>";
-  }
-
-  bytesperpixel = (ibuf->planes + 7) >> 3;
-  if ((bytesperpixel > 4) || (bytesperpixel == 2)) {
-    printf(
-        "imb_savepng: Unsupported bytes per pixel: %d for file: '%s'\n", bytesperpixel, filepath);
-    return 0;
-  }
-
-  png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-  if (png_ptr == NULL) {
-    printf("imb_savepng: Cannot png_create_write_struct for file: '%s'\n", filepath);
-    return 0;
-  }
-
-  info_ptr = png_create_info_struct(png_ptr);
-  if (info_ptr == NULL) {
-    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
-    printf("imb_savepng: Cannot png_create_info_struct for file: '%s'\n", filepath);
-    return 0;
-  }
-
-  /* copy image data */
-  num_bytes = ((size_t)ibuf->x) * ibuf->y * bytesperpixel;
-  if (is_16bit) {
-    pixels16 = MEM_mallocN(num_bytes * sizeof(unsigned short), "png 16bit pixels");
-  }
-  else {
-    pixels = MEM_mallocN(num_bytes * sizeof(unsigned char), "png 8bit pixels");
-  }
-  if (pixels == NULL && pixels16 == NULL) {
-    printf(
-        "imb_savepng: Cannot allocate pixels array of %dx%d, %d bytes per pixel for file: "
-        "'%s'\n",
-        ibuf->x,
-        ibuf->y,
-        bytesperpixel,
-        filepath);
-  }
-
-  /* allocate memory for an array of row-pointers */
-  row_pointers = (png_bytepp)MEM_mallocN(ibuf->y * sizeof(png_bytep), "row_pointers");
-  if (row_pointers == NULL) {
-    printf("imb_savepng: Cannot allocate row-pointers array for file '%s'\n", filepath);
-  }
-
-  if ((pixels == NULL && pixels16 == NULL) || (row_pointers == NULL) ||
-      setjmp(png_jmpbuf(png_ptr))) {
-    /* On error jump here, and free any resources. */
-    png_destroy_write_struct(&png_ptr, &info_ptr);
-    if (pixels) {
-      MEM_freeN(pixels);
-    }
-    if (pixels16) {
-      MEM_freeN(pixels16);
-    }
-    if (row_pointers) {
-      MEM_freeN(row_pointers);
-    }
-    if (fp) {
-      fflush(fp);
-      fclose(fp);
-    }
-    return 0;
-  }
-
-  from = (unsigned char *)ibuf->rect;
-  to = pixels;
-  from_float = ibuf->rect_float;
-  to16 = pixels16;
-
-  switch (bytesperpixel) {
+  int bytesperpixel;
+  bool is_16bit;
+} PNGConvertRowsData;
+
+/* Copy one row of the image into the PNG pixel layout. Color managing floats for 16 bit output
+ * is expensive, so rows are converted in parallel. */
+static void imb_savepng_convert_row(void *__restrict userdata,
+                                    const int y,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PNGConvertRowsData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int channels_in_float = ibuf->channels ? ibuf->channels : 4;
+  const size_t offset = (size_t)y * ibuf->x;
+
+  const unsigned char *from = ibuf->rect ? (unsigned char *)ibuf->rect + offset * 4 : NULL;
+  const float *from_float = ibuf->rect_float ? ibuf->rect_float + offset * channels_in_float :
+                                               NULL;
+  unsigned char *to = data->pixels ? data->pixels + offset * data->bytesperpixel : NULL;
+  unsigned short *to16 = data->pixels16 ? data->pixels16 + offset * data->bytesperpixel : NULL;
+  float from_straight[4];
+
+  switch (data->bytesperpixel) {
     case 4:
-      color_type = PNG_COLOR_TYPE_RGBA;
-      if (is_16bit) {
-        if (has_float) {
+      if (data->is_16bit) {
+        if (from_float) {
           if (channels_in_float == 4) {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
+            for (int i = ibuf->x; i > 0; i--) {
               premul_to_straight_v4_v4(from_straight, from_float);
-              to16[0] = ftoshort(chanel_colormanage_cb(from_straight[0]));
-              to16[1] = ftoshort(chanel_colormanage_cb(from_straight[1]));
-              to16[2] = ftoshort(chanel_colormanage_cb(from_straight[2]));
-              to16[3] = ftoshort(chanel_colormanage_cb(from_straight[3]));
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_straight[0]));
+              to16[1] = ftoshort(data->chanel_colormanage_cb(from_straight[1]));
+              to16[2] = ftoshort(data->chanel_colormanage_cb(from_straight[2]));
+              to16[3] = ftoshort(data->chanel_colormanage_cb(from_straight[3]));
               to16 += 4;
               from_float += 4;
             }
           }
           else if (channels_in_float == 3) {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
-              to16[0] = ftoshort(chanel_colormanage_cb(from_float[0]));
-              to16[1] = ftoshort(chanel_colormanage_cb(from_float[1]));
-              to16[2] = ftoshort(chanel_colormanage_cb(from_float[2]));
+            for (int i = ibuf->x; i > 0; i--) {
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_float[0]));
+              to16[1] = ftoshort(data->chanel_colormanage_cb(from_float[1]));
+              to16[2] = ftoshort(data->chanel_colormanage_cb(from_float[2]));
               to16[3] = 65535;
               to16 += 4;
               from_float += 3;
             }
           }
           else {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
-              to16[0] = ftoshort(chanel_colormanage_cb(from_float[0]));
+            for (int i = ibuf->x; i > 0; i--) {
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_float[0]));
               to16[2] = to16[1] = to16[0];
               to16[3] = 65535;
               to16 += 4;
@@ -266,7 +185,7 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
           }
         }
         else {
-          for (i = ibuf->x * ibuf->y; i > 0; i--) {
+          for (int i = ibuf->x; i > 0; i--) {
             to16[0] = UPSAMPLE_8_TO_16(from[0]);
             to16[1] = UPSAMPLE_8_TO_16(from[1]);
             to16[2] = UPSAMPLE_8_TO_16(from[2]);
@@ -277,7 +196,7 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
         }
       }
       else {
-        for (i = ibuf->x * ibuf->y; i > 0; i--) {
+        for (int i = ibuf->x; i > 0; i--) {
           to[0] = from[0];
           to[1] = from[1];
           to[2] = from[2];
@@ -288,31 +207,30 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
       }
       break;
     case 3:
-      color_type = PNG_COLOR_TYPE_RGB;
-      if (is_16bit) {
-        if (has_float) {
+      if (data->is_16bit) {
+        if (from_float) {
           if (channels_in_float == 4) {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
+            for (int i = ibuf->x; i > 0; i--) {
               premul_to_straight_v4_v4(from_straight, from_float);
-              to16[0] = ftoshort(chanel_colormanage_cb(from_straight[0]));
-              to16[1] = ftoshort(chanel_colormanage_cb(from_straight[1]));
-              to16[2] = ftoshort(chanel_colormanage_cb(from_straight[2]));
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_straight[0]));
+              to16[1] = ftoshort(data->chanel_colormanage_cb(from_straight[1]));
+              to16[2] = ftoshort(data->chanel_colormanage_cb(from_straight[2]));
               to16 += 3;
               from_float += 4;
             }
           }
           else if (channels_in_float == 3) {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
-              to16[0] = ftoshort(chanel_colormanage_cb(from_float[0]));
-              to16[1] = ftoshort(chanel_colormanage_cb(from_float[1]));
-              to16[2] = ftoshort(chanel_colormanage_cb(from_float[2]));
+            for (int i = ibuf->x; i > 0; i--) {
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_float[0]));
+              to16[1] = ftoshort(data->chanel_colormanage_cb(from_float[1]));
+              to16[2] = ftoshort(data->chanel_colormanage_cb(from_float[2]));
               to16 += 3;
               from_float += 3;
             }
           }
           else {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
-              to16[0] = ftoshort(chanel_colormanage_cb(from_float[0]));
+            for (int i = ibuf->x; i > 0; i--) {
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_float[0]));
               to16[2] = to16[1] = to16[0];
               to16 += 3;
               from_float++;
@@ -320,7 +238,7 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
           }
         }
         else {
-          for (i = ibuf->x * ibuf->y; i > 0; i--) {
+          for (int i = ibuf->x; i > 0; i--) {
             to16[0] = UPSAMPLE_8_TO_16(from[0]);
             to16[1] = UPSAMPLE_8_TO_16(from[1]);
             to16[2] = UPSAMPLE_8_TO_16(from[2]);
@@ -330,7 +248,7 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
         }
       }
       else {
-        for (i = ibuf->x * ibuf->y; i > 0; i--) {
+        for (int i = ibuf->x; i > 0; i--) {
           to[0] = from[0];
           to[1] = from[1];
           to[2] = from[2];
@@ -340,41 +258,40 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
       }
       break;
     case 1:
-      color_type = PNG_COLOR_TYPE_GRAY;
-      if (is_16bit) {
-        if (has_float) {
+      if (data->is_16bit) {
+        if (from_float) {
           float rgb[3];
           if (channels_in_float == 4) {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
+            for (int i = ibuf->x; i > 0; i--) {
               premul_to_straight_v4_v4(from_straight, from_float);
-              rgb[0] = chanel_colormanage_cb(from_straight[0]);
-              rgb[1] = chanel_colormanage_cb(from_straight[1]);
-              rgb[2] = chanel_colormanage_cb(from_straight[2]);
+              rgb[0] = data->chanel_colormanage_cb(from_straight[0]);
+              rgb[1] = data->chanel_colormanage_cb(from_straight[1]);
+              rgb[2] = data->chanel_colormanage_cb(from_straight[2]);
               to16[0] = ftoshort(IMB_colormanagement_get_luminance(rgb));
               to16++;
               from_float += 4;
             }
           }
           else if (channels_in_float == 3) {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
-              rgb[0] = chanel_colormanage_cb(from_float[0]);
-              rgb[1] = chanel_colormanage_cb(from_float[1]);
-              rgb[2] = chanel_colormanage_cb(from_float[2]);
+            for (int i = ibuf->x; i > 0; i--) {
+              rgb[0] = data->chanel_colormanage_cb(from_float[0]);
+              rgb[1] = data->chanel_colormanage_cb(from_float[1]);
+              rgb[2] = data->chanel_colormanage_cb(from_float[2]);
               to16[0] = ftoshort(IMB_colormanagement_get_luminance(rgb));
               to16++;
               from_float += 3;
             }
           }
           else {
-            for (i = ibuf->x * ibuf->y; i > 0; i--) {
-              to16[0] = ftoshort(chanel_colormanage_cb(from_float[0]));
+            for (int i = ibuf->x; i > 0; i--) {
+              to16[0] = ftoshort(data->chanel_colormanage_cb(from_float[0]));
               to16++;
               from_float++;
             }
           }
         }
         else {
-          for (i = ibuf->x * ibuf->y; i > 0; i--) {
+          for (int i = ibuf->x; i > 0; i--) {
             to16[0] = UPSAMPLE_8_TO_16(from[0]);
             to16++;
             from += 4;
@@ -382,7 +299,7 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
         }
       }
       else {
-        for (i = ibuf->x * ibuf->y; i > 0; i--) {
+        for (int i = ibuf->x; i > 0; i--) {
           to[0] = from[0];
           to++;
           from += 4;
@@ -390,6 +307,132 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
       }
       break;
   }
+}
+
+bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
+{
+  png_structp png_ptr;
+  png_infop info_ptr;
+
+  unsigned char *pixels = NULL;
+  unsigned short *pixels16 = NULL;
+  png_bytepp row_pointers = NULL;
+  int i, bytesperpixel, color_type = PNG_COLOR_TYPE_GRAY;
+  FILE *fp = NULL;
+
+  bool is_16bit = (ibuf->foptions.flag & PNG_16BIT) != 0;
+
+  float (*chanel_colormanage_cb)(float);
+  size_t num_bytes;
+
+  /* use the jpeg quality setting for compression */
+  int compression;
+  compression = (int)(((float)(ibuf->foptions.quality) / 11.1111f));
+  compression = compression < 0 ? 0 : (compression > 9 ? 9 : compression);
+
+  if (ibuf->float_colorspace || (ibuf->colormanage_flag & IMB_COLORMANAGE_IS_DATA)) {
+    /* float buffer was managed already, no need in color space conversion */
+    chanel_colormanage_cb = channel_colormanage_noop;
+  }
+  else {
+    /* standard linear-to-srgb conversion if float buffer wasn't managed */
+    chanel_colormanage_cb = linearrgb_to_srgb;
+  }
+
+  /* for prints */
+  if (flags & IB_mem) {
+    filepath = "<memory>";
+  }
+
+  bytesperpixel = (ibuf->planes + 7) >> 3;
+  if ((bytesperpixel > 4) || (bytesperpixel == 2)) {
+    printf(
+        "imb_savepng: Unsupported bytes per pixel: %d for file: '%s'\n", bytesperpixel, filepath);
+    return 0;
+  }
+
+  png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  if (png_ptr == NULL) {
+    printf("imb_savepng: Cannot png_create_write_struct for file: '%s'\n", filepath);
+    return 0;
+  }
+
+  info_ptr = png_create_info_struct(png_ptr);
+  if (info_ptr == NULL) {
+    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+    printf("imb_savepng: Cannot png_create_info_struct for file: '%s'\n", filepath);
+    return 0;
+  }
+
+  /* copy image data */
+  num_bytes = ((size_t)ibuf->x) * ibuf->y * bytesperpixel;
+  if (is_16bit) {
+    pixels16 = MEM_mallocN(num_bytes * sizeof(unsigned short), "png 16bit pixels");
+  }
+  else {
+    pixels = MEM_mallocN(num_bytes * sizeof(unsigned char), "png 8bit pixels");
+  }
+  if (pixels == NULL && pixels16 == NULL) {
+    printf(
+        "imb_savepng: Cannot allocate pixels array of %dx%d, %d bytes per pixel for file: "
+        "'%s'\n",
+        ibuf->x,
+        ibuf->y,
+        bytesperpixel,
+        filepath);
+  }
+
+  /* allocate memory for an array of row-pointers */
+  row_pointers = (png_bytepp)MEM_mallocN(ibuf->y * sizeof(png_bytep), "row_pointers");
+  if (row_pointers == NULL) {
+    printf("imb_savepng: Cannot allocate row-pointers array for file '%s'\n", filepath);
+  }
+
+  if ((pixels == NULL && pixels16 == NULL) || (row_pointers == NULL) ||
+      setjmp(png_jmpbuf(png_ptr))) {
+    /* On error jump here, and free any resources. */
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+    if (pixels) {
+      MEM_freeN(pixels);
+    }
+    if (pixels16) {
+      MEM_freeN(pixels16);
+    }
+    if (row_pointers) {
+      MEM_freeN(row_pointers);
+    }
+    if (fp) {
+      fflush(fp);
+      fclose(fp);
+    }
+    return 0;
+  }
+
+  switch (bytesperpixel) {
+    case 4:
+      color_type = PNG_COLOR_TYPE_RGBA;
+      break;
+    case 3:
+      color_type = PNG_COLOR_TYPE_RGB;
+      break;
+    case 1:
+      color_type = PNG_COLOR_TYPE_GRAY;
+      break;
+  }
+
+  PNGConvertRowsData convert_data = {
+      .ibuf = ibuf,
+      .pixels = pixels,
+      .pixels16 = pixels16,
+      .chanel_colormanage_cb = chanel_colormanage_cb,
+      .bytesperpixel = bytesperpixel,
+      .is_16bit = is_16bit,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)ibuf->x * ibuf->y > 256 * 256);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, ibuf->y, &convert_data, imb_savepng_convert_row, &settings);
 
   if (flags & IB_mem) {
     /* create image in memory */
@@ -425,6 +468,16 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
 
   png_set_compression_level(png_ptr, compression);
 
+  /* libpng tries all filters on every row by default, which dominates the encoding time at low
+   * compression levels where the choice barely affects the file size. Stored output doesn't
+   * benefit from filtering at all. */
+  if (compression == 0) {
+    png_set_filter(png_ptr, 0, PNG_FILTER_NONE);
+  }
+  else if (compression <= 3) {
+    png_set_filter(png_ptr, 0, PNG_FILTER_SUB | PNG_FILTER_UP);
+  }
+
   /* png image settings */
   png_set_IHDR(png_ptr,
                info_ptr,
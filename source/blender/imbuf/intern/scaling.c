@@ -26,6 +26,7 @@
 
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -908,284 +909,337 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+typedef struct ScaleDownData {
+  ImBuf *ibuf;
+  /* New width for scaledownx, new height for scaledowny. */
+  int newsize;
+  float add;
+
+  uchar *newrect;
+  float *newrectf;
+} ScaleDownData;
+
+static void scaledownx_row(void *__restrict userdata,
+                           const int y,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  const ScaleDownData *data = userdata;
+  ImBuf *ibuf = data->ibuf;
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
+  const int newx = data->newsize;
+  const float add = data->add;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
+  uchar *rect = NULL, *newrect = NULL;
+  float *rectf = NULL, *newrectf = NULL;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int x;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
-
   if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
+    rect = (uchar *)ibuf->rect + (size_t)y * ibuf->x * 4;
+    newrect = data->newrect + (size_t)y * newx * 4;
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
+    rectf = ibuf->rect_float + (size_t)y * ibuf->x * 4;
+    newrectf = data->newrectf + (size_t)y * newx * 4;
   }
 
-  add = (ibuf->x - 0.01) / newx;
+  sample = 0.0f;
+  val[0] = val[1] = val[2] = val[3] = 0.0f;
+  valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
 
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
-  }
+  for (x = newx; x > 0; x--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
 
-    for (x = newx; x > 0; x--) {
       if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += 4;
       }
       if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += 4;
       }
+    }
 
-      sample += add;
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += 4;
+
+      newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+      newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+      newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+      newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+
+      newrect += 4;
+    }
+    if (do_float) {
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += 4;
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
+      newrectf += 4;
+    }
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+    sample -= 1.0f;
+  }
 
-        newrect += 4;
-      }
-      if (do_float) {
+  /* Every row has to consume exactly one row of the source, see bug T26502. */
+  BLI_assert(!do_rect || (rect - (uchar *)ibuf->rect) == (size_t)(y + 1) * ibuf->x * 4);
+  BLI_assert(!do_float || (rectf - ibuf->rect_float) == (size_t)(y + 1) * ibuf->x * 4);
+}
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
-        newrectf += 4;
-      }
+  if (!do_rect && !do_float) {
+    return ibuf;
+  }
 
-      sample -= 1.0f;
+  if (do_rect) {
+    _newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
+    if (_newrect == NULL) {
+      return ibuf;
     }
   }
+  if (do_float) {
+    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
+    if (_newrectf == NULL) {
+      if (_newrect) {
+        MEM_freeN(_newrect);
+      }
+      return ibuf;
+    }
+  }
+
+  ScaleDownData data = {
+      .ibuf = ibuf,
+      .newsize = newx,
+      .add = (ibuf->x - 0.01) / newx,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+  };
+
+  /* Rows are independent. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)ibuf->x * ibuf->y > 256 * 256);
+  BLI_task_parallel_range(0, ibuf->y, &data, scaledownx_row, &settings);
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
     ibuf->rect = (unsigned int *)_newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
     ibuf->rect_float = _newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->x = newx;
   return ibuf;
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+static void scaledowny_column(void *__restrict userdata,
+                              const int column,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  const ScaleDownData *data = userdata;
+  ImBuf *ibuf = data->ibuf;
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
+  const int newy = data->newsize;
+  const float add = data->add;
+  const int skipx = 4 * ibuf->x;
+  const int x = 4 * column;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
+  uchar *rect = NULL, *newrect = NULL;
+  float *rectf = NULL, *newrectf = NULL;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int y;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
-
   if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
+    rect = ((uchar *)ibuf->rect) + x;
+    newrect = data->newrect + x;
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
+    rectf = ibuf->rect_float + x;
+    newrectf = data->newrectf + x;
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
+  sample = 0.0f;
+  val[0] = val[1] = val[2] = val[3] = 0.0f;
+  valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
 
-  for (x = skipx - 4; x >= 0; x -= 4) {
+  for (y = newy; y > 0; y--) {
     if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
     }
     if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
     }
 
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
 
-    for (y = newy; y > 0; y--) {
       if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += skipx;
       }
       if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += skipx;
       }
+    }
 
-      sample += add;
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += skipx;
+
+      newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+      newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+      newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+      newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+
+      newrect += skipx;
+    }
+    if (do_float) {
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += skipx;
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
+      newrectf += skipx;
+    }
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+    sample -= 1.0f;
+  }
 
-        newrect += skipx;
-      }
-      if (do_float) {
+  /* Every column has to consume exactly one column of the source, see bug T26502. */
+  BLI_assert(!do_rect || (rect - (uchar *)ibuf->rect) == (size_t)ibuf->y * skipx + x);
+  BLI_assert(!do_float || (rectf - ibuf->rect_float) == (size_t)ibuf->y * skipx + x);
+}
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
-        newrectf += skipx;
-      }
+  if (!do_rect && !do_float) {
+    return ibuf;
+  }
 
-      sample -= 1.0f;
+  if (do_rect) {
+    _newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
+    if (_newrect == NULL) {
+      return ibuf;
     }
   }
+  if (do_float) {
+    _newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
+    if (_newrectf == NULL) {
+      if (_newrect) {
+        MEM_freeN(_newrect);
+      }
+      return ibuf;
+    }
+  }
+
+  ScaleDownData data = {
+      .ibuf = ibuf,
+      .newsize = newy,
+      .add = (ibuf->y - 0.01) / newy,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+  };
+
+  /* Columns are independent. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)ibuf->x * ibuf->y > 256 * 256);
+  BLI_task_parallel_range(0, ibuf->x, &data, scaledowny_column, &settings);
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
     ibuf->rect = (unsigned int *)_newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
     ibuf->rect_float = (float *)_newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->y = newy;
   return ibuf;
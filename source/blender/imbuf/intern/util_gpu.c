@@ -25,6 +25,7 @@
 #include "imbuf.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -84,6 +85,54 @@ static bool IMB_gpu_get_compressed_format(const ImBuf *ibuf, eGPUTextureFormat *
 }
 #endif
 
+/* Number of pixels converted at once when uploading in bands of rows. */
+#define IMB_GPU_UPLOAD_BAND_PIXELS (1024 * 1024)
+
+/* Test if the pixels need a conversion before they can be used as texture data. */
+static bool imb_gpu_data_needs_conversion(const ImBuf *ibuf, const bool store_premultiplied)
+{
+  if (ibuf->rect_float != NULL) {
+    return ibuf->channels != 4 || !store_premultiplied;
+  }
+  return !IMB_colormanagement_space_is_data(ibuf->rect_colorspace);
+}
+
+/**
+ * Convert and upload the full resolution image in bands of rows, so no converted copy of the
+ * whole image has to be allocated. Large images can otherwise need gigabytes of temporary memory.
+ */
+static bool imb_gpu_texture_update_in_bands(GPUTexture *tex,
+                                            eGPUDataFormat data_format,
+                                            const ImBuf *ibuf,
+                                            const bool compress_as_srgb,
+                                            const bool store_premultiplied)
+{
+  const bool is_float_rect = (ibuf->rect_float != NULL);
+  const size_t pixel_size = (is_float_rect) ? sizeof(float[4]) : sizeof(uchar[4]);
+  const int band_height = min_ii(max_ii(1, IMB_GPU_UPLOAD_BAND_PIXELS / ibuf->x), ibuf->y);
+
+  void *band = MEM_mallocN(pixel_size * ibuf->x * band_height, __func__);
+  if (band == NULL) {
+    return false;
+  }
+
+  for (int y = 0; y < ibuf->y; y += band_height) {
+    const int height = min_ii(band_height, ibuf->y - y);
+    if (is_float_rect) {
+      IMB_colormanagement_imbuf_to_float_texture(
+          (float *)band, 0, y, ibuf->x, height, ibuf, store_premultiplied);
+    }
+    else {
+      IMB_colormanagement_imbuf_to_byte_texture(
+          (uchar *)band, 0, y, ibuf->x, height, ibuf, compress_as_srgb, store_premultiplied);
+    }
+    GPU_texture_update_sub(tex, data_format, band, 0, y, 0, ibuf->x, height, 0);
+  }
+
+  MEM_freeN(band);
+  return true;
+}
+
 /**
  * Apply colormanagement and scale buffer if needed.
  * *r_freedata is set to true if the returned buffer need to be manually freed.
@@ -216,6 +265,277 @@ void IMB_update_gpu_texture_sub(GPUTexture *tex,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Block compression
+ *
+ * Fast S3TC (DXT1 / DXT5) encoder for byte images. The end-points of each 4x4 block are the
+ * corners of the bounding box of its colors, which gives a good enough quality for viewport
+ * display while being quick enough to compress large images at load time.
+ * \{ */
+
+static uint16_t dxt_color_565(const uchar color[3])
+{
+  return (uint16_t)(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 |
+                    ((color[2] * 31 + 127) / 255));
+}
+
+static void dxt_color_from_565(const uint16_t c, int r_color[3])
+{
+  const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+  r_color[0] = (r << 3) | (r >> 2);
+  r_color[1] = (g << 2) | (g >> 4);
+  r_color[2] = (b << 3) | (b >> 2);
+}
+
+static void dxt_encode_color_block(const uchar block[16][4], uchar *r_dst)
+{
+  uchar min[3] = {255, 255, 255}, max[3] = {0, 0, 0};
+  for (int i = 0; i < 16; i++) {
+    for (int c = 0; c < 3; c++) {
+      min[c] = min_ii(min[c], block[i][c]);
+      max[c] = max_ii(max[c], block[i][c]);
+    }
+  }
+  /* Inset the bounding box to reduce the error of the interpolated colors. */
+  for (int c = 0; c < 3; c++) {
+    const int inset = (max[c] - min[c]) >> 4;
+    min[c] += inset;
+    max[c] -= inset;
+  }
+
+  uint16_t c0 = dxt_color_565(max), c1 = dxt_color_565(min);
+  uint32_t indices = 0;
+  if (c0 < c1) {
+    SWAP(uint16_t, c0, c1);
+  }
+  if (c0 != c1) {
+    /* Four color mode, the palette is ordered as c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1. */
+    int palette[4][3];
+    dxt_color_from_565(c0, palette[0]);
+    dxt_color_from_565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    for (int i = 0; i < 16; i++) {
+      int best = 0, best_dist = INT_MAX;
+      for (int p = 0; p < 4; p++) {
+        const int dr = block[i][0] - palette[p][0];
+        const int dg = block[i][1] - palette[p][1];
+        const int db = block[i][2] - palette[p][2];
+        const int dist = dr * dr + dg * dg + db * db;
+        if (dist < best_dist) {
+          best_dist = dist;
+          best = p;
+        }
+      }
+      indices |= (uint32_t)best << (i * 2);
+    }
+  }
+
+  r_dst[0] = c0 & 0xFF;
+  r_dst[1] = c0 >> 8;
+  r_dst[2] = c1 & 0xFF;
+  r_dst[3] = c1 >> 8;
+  for (int i = 0; i < 4; i++) {
+    r_dst[4 + i] = (indices >> (i * 8)) & 0xFF;
+  }
+}
+
+static void dxt_encode_alpha_block(const uchar block[16][4], uchar *r_dst)
+{
+  int a0 = 0, a1 = 255;
+  for (int i = 0; i < 16; i++) {
+    a0 = max_ii(a0, block[i][3]);
+    a1 = min_ii(a1, block[i][3]);
+  }
+
+  uint64_t indices = 0;
+  if (a0 != a1) {
+    /* Eight alpha mode, code 0 is a0, 1 is a1 and 2..7 interpolate from a0 to a1. */
+    int palette[8] = {a0, a1};
+    for (int p = 2; p < 8; p++) {
+      palette[p] = ((8 - p) * a0 + (p - 1) * a1) / 7;
+    }
+    for (int i = 0; i < 16; i++) {
+      int best = 0, best_dist = INT_MAX;
+      for (int p = 0; p < 8; p++) {
+        const int dist = abs(block[i][3] - palette[p]);
+        if (dist < best_dist) {
+          best_dist = dist;
+          best = p;
+        }
+      }
+      indices |= (uint64_t)best << (i * 3);
+    }
+  }
+
+  r_dst[0] = (uchar)a0;
+  r_dst[1] = (uchar)a1;
+  for (int i = 0; i < 6; i++) {
+    r_dst[2 + i] = (indices >> (i * 8)) & 0xFF;
+  }
+}
+
+typedef struct DXTEncodeData {
+  const uchar *src;
+  uchar *dst;
+  int width, height;
+  bool use_alpha;
+} DXTEncodeData;
+
+static void dxt_encode_row_cb(void *__restrict userdata,
+                              const int block_y,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DXTEncodeData *data = userdata;
+  const int blocks_x = (data->width + 3) / 4;
+  const int block_size = (data->use_alpha) ? 16 : 8;
+  uchar *dst = data->dst + (size_t)block_y * blocks_x * block_size;
+
+  for (int block_x = 0; block_x < blocks_x; block_x++, dst += block_size) {
+    /* Pixels outside of the image repeat the last row and column. */
+    uchar block[16][4];
+    for (int y = 0; y < 4; y++) {
+      const int py = min_ii(block_y * 4 + y, data->height - 1);
+      for (int x = 0; x < 4; x++) {
+        const int px = min_ii(block_x * 4 + x, data->width - 1);
+        copy_v4_v4_uchar(block[y * 4 + x], data->src + ((size_t)py * data->width + px) * 4);
+      }
+    }
+
+    if (data->use_alpha) {
+      dxt_encode_alpha_block(block, dst);
+      dxt_encode_color_block(block, dst + 8);
+    }
+    else {
+      dxt_encode_color_block(block, dst);
+    }
+  }
+}
+
+/* Box filter the byte buffer to the next mipmap level. */
+static uchar *dxt_mipmap_downsample(const uchar *src, int w, int h, int *r_w, int *r_h)
+{
+  const int dst_w = max_ii(1, w / 2), dst_h = max_ii(1, h / 2);
+  uchar *dst = MEM_mallocN(sizeof(uchar[4]) * dst_w * dst_h, __func__);
+
+  for (int y = 0; y < dst_h; y++) {
+    const int y0 = min_ii(y * 2, h - 1), y1 = min_ii(y * 2 + 1, h - 1);
+    for (int x = 0; x < dst_w; x++) {
+      const int x0 = min_ii(x * 2, w - 1), x1 = min_ii(x * 2 + 1, w - 1);
+      for (int c = 0; c < 4; c++) {
+        dst[(y * dst_w + x) * 4 + c] = (src[(y0 * w + x0) * 4 + c] + src[(y0 * w + x1) * 4 + c] +
+                                        src[(y1 * w + x0) * 4 + c] + src[(y1 * w + x1) * 4 + c] +
+                                        2) /
+                                       4;
+      }
+    }
+  }
+
+  *r_w = dst_w;
+  *r_h = dst_h;
+  return dst;
+}
+
+/**
+ * Create a block compressed texture with all its mipmap levels from a byte image, using DXT1
+ * for opaque images and DXT5 otherwise. This uses 4 to 8 times less video memory than the
+ * uncompressed texture.
+ *
+ * \return NULL when the image can't be compressed, in that case #IMB_create_gpu_texture should
+ * be used instead.
+ */
+GPUTexture *IMB_create_gpu_texture_compressed(const char *name, ImBuf *ibuf, bool use_premult)
+{
+  if (ibuf->rect == NULL || ibuf->rect_float != NULL) {
+    return NULL;
+  }
+
+  int size[2] = {GPU_texture_size_with_limit(ibuf->x), GPU_texture_size_with_limit(ibuf->y)};
+  const bool do_rescale = (ibuf->x != size[0]) || (ibuf->y != size[1]);
+
+  eGPUDataFormat data_format;
+  eGPUTextureFormat tex_format;
+  imb_gpu_get_format(ibuf, false, &data_format, &tex_format);
+
+  const bool compress_as_srgb = (tex_format == GPU_SRGB8_A8);
+  bool freebuf = false;
+  uchar *rect = imb_gpu_get_data(ibuf, do_rescale, size, compress_as_srgb, use_premult, &freebuf);
+  if (rect == NULL) {
+    return NULL;
+  }
+
+  bool use_alpha = false;
+  for (size_t i = 0; i < (size_t)size[0] * size[1]; i++) {
+    if (rect[i * 4 + 3] != 255) {
+      use_alpha = true;
+      break;
+    }
+  }
+
+  eGPUTextureFormat compressed_format;
+  if (use_alpha) {
+    compressed_format = (compress_as_srgb) ? GPU_SRGB8_A8_DXT5 : GPU_RGBA8_DXT5;
+  }
+  else {
+    compressed_format = (compress_as_srgb) ? GPU_SRGB8_A8_DXT1 : GPU_RGBA8_DXT1;
+  }
+  const int block_size = (use_alpha) ? 16 : 8;
+
+  /* Compute the size of the whole mipmap chain. */
+  const int miplen = 1 + (int)floorf(log2f((float)max_ii(size[0], size[1])));
+  size_t data_len = 0;
+  for (int mip = 0, w = size[0], h = size[1]; mip < miplen; mip++) {
+    data_len += (size_t)((w + 3) / 4) * ((h + 3) / 4) * block_size;
+    w = max_ii(1, w / 2);
+    h = max_ii(1, h / 2);
+  }
+
+  uchar *data = MEM_mallocN(data_len, __func__);
+  if (data == NULL) {
+    if (freebuf) {
+      MEM_freeN(rect);
+    }
+    return NULL;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  uchar *mip_rect = rect;
+  size_t ofs = 0;
+  for (int mip = 0, w = size[0], h = size[1]; mip < miplen; mip++) {
+    DXTEncodeData encode_data = {mip_rect, data + ofs, w, h, use_alpha};
+    const int blocks_y = (h + 3) / 4;
+    settings.use_threading = (w * h > 64 * 64);
+    BLI_task_parallel_range(0, blocks_y, &encode_data, dxt_encode_row_cb, &settings);
+    ofs += (size_t)((w + 3) / 4) * blocks_y * block_size;
+
+    if (mip + 1 < miplen) {
+      uchar *next_rect = dxt_mipmap_downsample(mip_rect, w, h, &w, &h);
+      if (mip_rect != rect || freebuf) {
+        MEM_freeN(mip_rect);
+      }
+      mip_rect = next_rect;
+    }
+  }
+  if (mip_rect != rect || freebuf) {
+    MEM_freeN(mip_rect);
+  }
+
+  GPUTexture *tex = GPU_texture_create_compressed_2d(
+      name, UNPACK2(size), miplen, compressed_format, data);
+  MEM_freeN(data);
+
+  if (tex != NULL) {
+    GPU_texture_anisotropic_filter(tex, true);
+  }
+  return tex;
+}
+
+/** \} */
+
 GPUTexture *IMB_create_gpu_texture(const char *name,
                                    ImBuf *ibuf,
                                    bool use_high_bitdepth,
@@ -272,6 +592,13 @@ GPUTexture *IMB_create_gpu_texture(const char *name,
     do_rescale = true;
   }
   BLI_assert(tex != NULL);
+
+  if (!do_rescale && imb_gpu_data_needs_conversion(ibuf, use_premult) &&
+      imb_gpu_texture_update_in_bands(tex, data_format, ibuf, compress_as_srgb, use_premult)) {
+    GPU_texture_anisotropic_filter(tex, true);
+    return tex;
+  }
+
   void *data = imb_gpu_get_data(ibuf, do_rescale, size, compress_as_srgb, use_premult, &freebuf);
   GPU_texture_update(tex, data_format, data);
 
@@ -24,6 +24,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -456,9 +457,27 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
 
   MVert *verts = mesh->mvert;
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
+  parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
+}
+
+/* Face-varying data is written per polygon, so the start of each polygon in the Alembic arrays
+ * follows the polygon order rather than Blender's loop start. Returns the total loop count. */
+static int get_poly_offsets(struct Mesh *mesh, std::vector<int32_t> &poly_offsets)
+{
+  const MPoly *mpoly = mesh->mpoly;
+  int offset = 0;
+
+  poly_offsets.resize(mesh->totpoly);
+  for (int i = 0, e = mesh->totpoly; i < e; i++) {
+    poly_offsets[i] = offset;
+    offset += mpoly[i].totloop;
   }
+
+  return offset;
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -467,29 +486,35 @@ static void get_topology(struct Mesh *mesh,
                          bool &r_has_flat_shaded_poly)
 {
   const int num_poly = mesh->totpoly;
-  const int num_loops = mesh->totloop;
   MLoop *mloop = mesh->mloop;
   MPoly *mpoly = mesh->mpoly;
   r_has_flat_shaded_poly = false;
 
+  std::vector<int32_t> poly_offsets;
+  const int num_loops = get_poly_offsets(mesh, poly_offsets);
+
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(num_loops);
-  loop_counts.reserve(num_poly);
+  poly_verts.resize(num_loops);
+  loop_counts.resize(num_poly);
 
-  /* NOTE: data needs to be written in the reverse order. */
   for (int i = 0; i < num_poly; i++) {
-    MPoly &poly = mpoly[i];
-    loop_counts.push_back(poly.totloop);
-
-    r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
-
-    MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+    loop_counts[i] = mpoly[i].totloop;
+    r_has_flat_shaded_poly |= (mpoly[i].flag & ME_SMOOTH) == 0;
+  }
 
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
+  /* NOTE: data needs to be written in the reverse order. */
+  parallel_for(IndexRange(num_poly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = mpoly[i];
+      const MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+      int32_t *abc_verts = &poly_verts[poly_offsets[i]];
+
+      for (int j = 0; j < poly.totloop; j++, loop--) {
+        abc_verts[j] = loop->v;
+      }
     }
-  }
+  });
 }
 
 static void get_creases(struct Mesh *mesh,
@@ -535,17 +560,21 @@ static void get_loop_normals(struct Mesh *mesh,
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
   BLI_assert(lnors != nullptr || !"BKE_mesh_calc_normals_split() should have computed CD_NORMAL");
 
-  normals.resize(mesh->totloop);
+  std::vector<int32_t> poly_offsets;
+  normals.resize(get_poly_offsets(mesh, poly_offsets));
 
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  const MPoly *mpoly = mesh->mpoly;
+  parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &mpoly[i];
+      int abc_index = poly_offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
@@ -595,9 +595,12 @@ bool AbcMeshReader::accepts_object_type(
 
 bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector &sample_sel)
 {
-  IPolyMeshSchema::Sample sample;
+  /* Only the array sizes are needed, which can be read without reading the arrays. */
+  Alembic::Util::Dimensions positions_dims, face_indices_dims, face_counts_dims;
   try {
-    sample = m_schema.getValue(sample_sel);
+    m_schema.getPositionsProperty().getDimensions(positions_dims, sample_sel);
+    m_schema.getFaceIndicesProperty().getDimensions(face_indices_dims, sample_sel);
+    m_schema.getFaceCountsProperty().getDimensions(face_counts_dims, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -609,13 +612,40 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
     return false;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
+  return positions_dims.numPoints() != existing_mesh->totvert ||
+         face_counts_dims.numPoints() != existing_mesh->totpoly ||
+         face_indices_dims.numPoints() != existing_mesh->totloop;
+}
+
+bool AbcMeshReader::read_positions_only(Mesh *existing_mesh,
+                                        const ISampleSelector &sample_sel,
+                                        int read_flag)
+{
+  if (topology_changed(existing_mesh, sample_sel)) {
+    return false;
+  }
+
+  const bool use_vertex_interpolation = read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
+  CDStreamConfig config = get_config(existing_mesh, use_vertex_interpolation);
+  config.time = sample_sel.getRequestedTime();
+  get_weight_and_index(config, m_schema.getTimeSampling(), m_schema.getNumSamples());
 
-  return positions->size() != existing_mesh->totvert ||
-         face_counts->size() != existing_mesh->totpoly ||
-         face_indices->size() != existing_mesh->totloop;
+  AbcMeshData abc_mesh_data;
+  try {
+    abc_mesh_data.positions = m_schema.getPositionsProperty().getValue(sample_sel);
+    if (config.weight != 0.0f) {
+      abc_mesh_data.ceil_positions = m_schema.getPositionsProperty().getValue(
+          Alembic::Abc::ISampleSelector(config.ceil_index));
+    }
+  }
+  catch (Alembic::Util::Exception &) {
+    /* Let the regular path report the error. */
+    return false;
+  }
+
+  read_mverts(config, abc_mesh_data);
+
+  return true;
 }
 
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
@@ -623,6 +653,13 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
                                int read_flag,
                                const char **err_str)
 {
+  /* When streaming only vertices and the topology didn't change, there is no need to read the
+   * face data of the sample. */
+  if ((read_flag & MOD_MESHSEQ_READ_ALL) == MOD_MESHSEQ_READ_VERT &&
+      read_positions_only(existing_mesh, sample_sel, read_flag)) {
+    return existing_mesh;
+  }
+
   IPolyMeshSchema::Sample sample;
   try {
     sample = m_schema.getValue(sample_sel);
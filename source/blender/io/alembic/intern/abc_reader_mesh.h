@@ -48,6 +48,12 @@ class AbcMeshReader : public AbcObjectReader {
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
  private:
+  /* Read only the vertex positions of the sample into the existing mesh, when its topology
+   * matches. Returns false when the sample has to be read completely. */
+  bool read_positions_only(Mesh *existing_mesh,
+                           const Alembic::Abc::ISampleSelector &sample_sel,
+                           int read_flag);
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
@@ -25,6 +25,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -111,6 +112,8 @@ struct USDMeshData {
   pxr::VtFloatArray crease_sharpnesses;
 };
 
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data);
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -130,11 +133,14 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
     pxr::UsdGeomPrimvar uv_coords_primvar = usd_mesh.CreatePrimvar(
         primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
-    MLoopUV *mloopuv = static_cast<MLoopUV *>(layer->data);
-    pxr::VtArray<pxr::GfVec2f> uv_coords;
-    for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
-      uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].uv));
-    }
+    const MLoopUV *mloopuv = static_cast<const MLoopUV *>(layer->data);
+    pxr::VtArray<pxr::GfVec2f> uv_coords(mesh->totloop);
+    pxr::GfVec2f *usd_uvs = uv_coords.data();
+    parallel_for(IndexRange(mesh->totloop), 4096, [&](IndexRange range) {
+      for (const int loop_idx : range) {
+        usd_uvs[loop_idx] = pxr::GfVec2f(mloopuv[loop_idx].uv);
+      }
+    });
 
     if (!uv_coords_primvar.HasValue()) {
       uv_coords_primvar.Set(uv_coords, pxr::UsdTimeCode::Default());
@@ -155,7 +161,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_visibility(context, timecode, usd_mesh);
 
   USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
@@ -167,12 +172,16 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
      * out of its own sub-tree. It does work when we override the material with exactly the same
      * path, though.*/
     if (usd_export_context_.export_params.export_materials) {
+      /* The geometry itself comes from the reference, only the face groups are needed. */
+      get_face_groups(mesh, usd_mesh_data);
       assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
     }
 
     return;
   }
 
+  get_geometry_data(mesh, usd_mesh_data);
+
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -235,35 +244,68 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
+  usd_mesh_data.points.resize(mesh->totvert);
+  pxr::GfVec3f *points = usd_mesh_data.points.data();
 
   const MVert *verts = mesh->mvert;
-  for (int i = 0; i < mesh->totvert; ++i) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
+  parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      points[i] = pxr::GfVec3f(verts[i].co);
+    }
+  });
+}
+
+/* Face-varying data is written polygon after polygon, so the start of each polygon in the USD
+ * arrays follows the polygon order rather than its loop start. Returns the total loop count. */
+static int get_poly_offsets(const Mesh *mesh, std::vector<int> &poly_offsets)
+{
+  const MPoly *mpoly = mesh->mpoly;
+  int offset = 0;
+
+  poly_offsets.resize(mesh->totpoly);
+  for (int i = 0; i < mesh->totpoly; ++i) {
+    poly_offsets[i] = offset;
+    offset += mpoly[i].totloop;
   }
+
+  return offset;
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  std::vector<int> poly_offsets;
+  usd_mesh_data.face_indices.resize(get_poly_offsets(mesh, poly_offsets));
+  usd_mesh_data.face_vertex_counts.resize(mesh->totpoly);
+
+  int *face_indices = usd_mesh_data.face_indices.data();
+  int *face_vertex_counts = usd_mesh_data.face_vertex_counts.data();
+
+  const MLoop *mloop = mesh->mloop;
+  const MPoly *mpoly = mesh->mpoly;
+  parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MLoop *loop = mloop + mpoly[i].loopstart;
+      int *poly_indices = face_indices + poly_offsets[i];
+
+      face_vertex_counts[i] = mpoly[i].totloop;
+      for (int j = 0; j < mpoly[i].totloop; ++j, ++loop) {
+        poly_indices[j] = loop->v;
+      }
+    }
+  });
+}
+
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
    * assignments. */
-  bool construct_face_groups = mesh->totcol > 1;
-
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
-
-  MLoop *mloop = mesh->mloop;
-  MPoly *mpoly = mesh->mpoly;
-  for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
-    MLoop *loop = mloop + mpoly->loopstart;
-    usd_mesh_data.face_vertex_counts.push_back(mpoly->totloop);
-    for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
-      usd_mesh_data.face_indices.push_back(loop->v);
-    }
+  if (mesh->totcol <= 1) {
+    return;
+  }
 
-    if (construct_face_groups) {
-      usd_mesh_data.face_groups[mpoly->mat_nr].push_back(i);
-    }
+  const MPoly *mpoly = mesh->mpoly;
+  for (int i = 0; i < mesh->totpoly; ++i) {
+    usd_mesh_data.face_groups[mpoly[i].mat_nr].push_back(i);
   }
 }
 
@@ -296,6 +338,7 @@ void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_
 {
   get_vertices(mesh, usd_mesh_data);
   get_loops_polys(mesh, usd_mesh_data);
+  get_face_groups(mesh, usd_mesh_data);
   get_creases(mesh, usd_mesh_data);
 }
 
@@ -367,38 +410,44 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
 
   pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
 
   if (lnors != nullptr) {
-    /* Export custom loop normals. */
-    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
-    }
+    /* Export custom loop normals, which are laid out exactly like USD's normals. */
+    const pxr::GfVec3f *usd_lnors = reinterpret_cast<const pxr::GfVec3f *>(lnors);
+    loop_normals.assign(usd_lnors, usd_lnors + mesh->totloop);
   }
   else {
     /* Compute the loop normals based on the 'smooth' flag. */
-    float normal[3];
-    MPoly *mpoly = mesh->mpoly;
+    std::vector<int> poly_offsets;
+    loop_normals.resize(get_poly_offsets(mesh, poly_offsets));
+    pxr::GfVec3f *usd_normals = loop_normals.data();
+
+    const MPoly *mpoly = mesh->mpoly;
     const MVert *mvert = mesh->mvert;
-    for (int poly_idx = 0, totpoly = mesh->totpoly; poly_idx < totpoly; ++poly_idx, ++mpoly) {
-      MLoop *mloop = mesh->mloop + mpoly->loopstart;
-
-      if ((mpoly->flag & ME_SMOOTH) == 0) {
-        /* Flat shaded, use common normal for all verts. */
-        BKE_mesh_calc_poly_normal(mpoly, mloop, mvert, normal);
-        pxr::GfVec3f pxr_normal(normal);
-        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
+    parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+      float normal[3];
+      for (const int poly_idx : range) {
+        const MPoly *mp = &mpoly[poly_idx];
+        const MLoop *mloop = mesh->mloop + mp->loopstart;
+        pxr::GfVec3f *poly_normals = usd_normals + poly_offsets[poly_idx];
+
+        if ((mp->flag & ME_SMOOTH) == 0) {
+          /* Flat shaded, use common normal for all verts. */
+          BKE_mesh_calc_poly_normal(mp, mloop, mvert, normal);
+          pxr::GfVec3f pxr_normal(normal);
+          for (int loop_idx = 0; loop_idx < mp->totloop; ++loop_idx) {
+            poly_normals[loop_idx] = pxr_normal;
+          }
         }
-      }
-      else {
-        /* Smooth shaded, use individual vert normals. */
-        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx, ++mloop) {
-          normal_short_to_float_v3(normal, mvert[mloop->v].no);
-          loop_normals.push_back(pxr::GfVec3f(normal));
+        else {
+          /* Smooth shaded, use individual vert normals. */
+          for (int loop_idx = 0; loop_idx < mp->totloop; ++loop_idx, ++mloop) {
+            normal_short_to_float_v3(normal, mvert[mloop->v].no);
+            poly_normals[loop_idx] = pxr::GfVec3f(normal);
+          }
         }
       }
-    }
+    });
   }
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
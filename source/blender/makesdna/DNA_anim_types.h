@@ -624,6 +624,14 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Runtime: index of the keyframe ending the segment found by the last evaluation. Consecutive
+   * evaluations usually fall in the same or the next segment, which are checked first.
+   * Only a hint, it is validated before being used.
+   */
+  int segment_hint;
+  char _pad2[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -225,6 +225,10 @@ enum {
   IMA_GPU_REFRESH = (1 << 0),
   /** All mipmap levels in OpenGL texture set? */
   IMA_GPU_MIPMAP_COMPLETE = (1 << 1),
+  /** 2D texture is block compressed (see #USER_GPU_FLAG_TEXTURE_COMPRESSION). */
+  IMA_GPU_COMPRESSED = (1 << 2),
+  /** Image is painted, keep its texture uncompressed so it can be updated partially. */
+  IMA_GPU_NO_COMPRESSION = (1 << 3),
 };
 
 /* Image.source, where the image comes from */
@@ -182,6 +182,8 @@ typedef struct LightCache {
   /* All lightprobes data contained in the cache. */
   LightProbeCache *cube_data;
   LightGridCache *grid_data;
+  /** Hash of the scene data each cube-map was rendered from, to skip unchanged ones. */
+  unsigned int *cube_hash;
 } LightCache;
 
 /* Bump the version number for lightcache data structure changes. */
@@ -88,7 +88,13 @@ typedef struct Mesh_Runtime {
   void *batch_cache;
 
   struct SubdivCCG *subdiv_ccg;
-  void *_pad1;
+  /**
+   * Vertex to element maps, `MeshTopologyMap` is defined in 'mesh_runtime.c'.
+   * Shared by copies of the mesh with the same topology.
+   */
+  struct MeshTopologyMap *vert_loop_map;
+  struct MeshTopologyMap *vert_poly_map;
+  struct MeshTopologyMap *vert_edge_map;
   int subdiv_ccg_tot_level;
   char _pad2[4];
 
@@ -124,7 +130,12 @@ typedef struct Mesh_Runtime {
    */
   char wrapper_type_finalize;
 
-  char _pad[4];
+  /**
+   * The batch cache was kept from the previous evaluation of the object, only the vertex
+   * positions changed since (see `mesh_build_data`).
+   */
+  char batch_cache_deformed_only;
+  char _pad[3];
 
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra;
@@ -136,6 +136,12 @@ typedef struct ModifierData {
 
   /* Runtime field which contains runtime data which is specific to a modifier type. */
   void *runtime;
+
+  /* Runtime field, result of the last evaluation when #eModifierFlag_CacheResult is set. */
+  struct ModifierResultCache *result_cache;
+
+  /* Runtime field, time in seconds the last evaluation of the modifier took. */
+  double execution_time;
 } ModifierData;
 
 typedef enum {
@@ -143,6 +149,8 @@ typedef enum {
   eModifierFlag_OverrideLibrary_Local = (1 << 0),
   /* This modifier does not own its caches, but instead shares them with another modifier. */
   eModifierFlag_SharedCaches = (1 << 1),
+  /* Keep the result of the modifier, and reuse it as long as its input and settings match. */
+  eModifierFlag_CacheResult = (1 << 2),
 } ModifierFlag;
 
 /* not a real modifier */
@@ -784,6 +784,7 @@ typedef struct RenderData {
 /* RenderData.quality_flag */
 typedef enum eQualityOption {
   SCE_PERF_HQ_NORMALS = (1 << 0),
+  SCE_PERF_HAIR_LOD = (1 << 1),
 } eQualityOption;
 
 /* RenderData.hair_type */
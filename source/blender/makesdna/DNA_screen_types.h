@@ -724,7 +724,8 @@ enum {
   /* For popups, to refresh UI layout along with drawing. */
   RGN_REFRESH_UI = 16,
 
-  /* Only editor overlays (currently gizmos only!) should be redrawn. */
+  /* Only editor overlays (currently gizmos only!) should be redrawn.
+   * The 3D viewport draws them over its cached overlay layer without running the draw engines. */
   RGN_DRAW_EDITOR_OVERLAYS = 32,
 };
 
@@ -637,7 +637,10 @@ typedef struct UserDef_Experimental {
   char use_switch_object_operator;
   char use_sculpt_tools_tilt;
   char use_object_add_tool;
-  char _pad[6];
+  char use_undo_skip_unchanged_ids;
+  char use_cow_reference_custom_data;
+  char use_persistent_evaluated_data;
+  char _pad[3];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -1083,6 +1086,7 @@ typedef enum eUserpref_GPU_Flag {
   USER_GPU_FLAG_NO_DEPT_PICK = (1 << 0),
   USER_GPU_FLAG_NO_EDIT_MODE_SMOOTH_WIRE = (1 << 1),
   USER_GPU_FLAG_OVERLAY_SMOOTH_WIRE = (1 << 2),
+  USER_GPU_FLAG_TEXTURE_COMPRESSION = (1 << 3),
 } eUserpref_GPU_Flag;
 
 /** #UserDef.tablet_api */
@@ -4529,6 +4529,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        if (out.stride == size) {
+          /* The items are packed, copy the whole array at once. */
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4544,8 +4555,32 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* could also be faster with non-matching types,
-       * for now we just do slower loop .. */
+      /* Non-matching types, convert while walking the raw array rather than looking up the
+       * property for every item in the slower loop below. */
+      if (in.type != PROP_RAW_UNSET && out.type != PROP_RAW_UNSET) {
+        RawArray in_item = in, out_item = out;
+        const int in_size = RNA_raw_type_sizeof(in.type) * arraylen;
+        int a, j;
+        double value;
+
+        for (a = 0; a < out.len; a++) {
+          for (j = 0; j < arraylen; j++) {
+            if (set) {
+              RAW_GET(double, value, in_item, j);
+              RAW_SET(double, out_item, j, value);
+            }
+            else {
+              RAW_GET(double, value, out_item, j);
+              RAW_SET(double, in_item, j, value);
+            }
+          }
+
+          in_item.array = (char *)in_item.array + in_size;
+          out_item.array = (char *)out_item.array + out.stride;
+        }
+
+        return 1;
+      }
     }
   }
 
@@ -5474,6 +5474,14 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       prop, "GL Texture Limit", "Limit the texture size to save graphics memory");
   RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
 
+  prop = RNA_def_property(srna, "use_gpu_texture_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "gpu_flag", USER_GPU_FLAG_TEXTURE_COMPRESSION);
+  RNA_def_property_ui_text(prop,
+                           "Texture Compression",
+                           "Compress 8-bit image textures to save graphics memory, at the cost "
+                           "of a lower quality and a longer loading time");
+  RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
+
   prop = RNA_def_property(srna, "texture_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "textimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -6191,6 +6199,31 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, NULL, "use_object_add_tool", 1);
   RNA_def_property_ui_text(
       prop, "Add Object Tool", "Show add object tool in the toolbar in Object Mode and Edit Mode");
+
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged_ids", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_skip_unchanged_ids", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged Data",
+                           "Re-use the undo memory of data-blocks not tagged for update since the "
+                           "previous undo step instead of writing them again (faster undo pushes, "
+                           "but changes done without update tagging may not be undone)");
+
+  prop = RNA_def_property(srna, "use_cow_reference_custom_data", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_cow_reference_custom_data", 1);
+  RNA_def_property_ui_text(prop,
+                           "Evaluation Shares Geometry",
+                           "Evaluated copies of meshes, hair and point clouds reference the "
+                           "geometry layers of the original data until they are modified, instead "
+                           "of duplicating them (less memory and faster dependency graph updates)");
+
+  prop = RNA_def_property(srna, "use_persistent_evaluated_data", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_persistent_evaluated_data", 1);
+  RNA_def_property_ui_text(prop,
+                           "Keep Evaluated Data of Hidden Objects",
+                           "Keep the evaluated data of objects and other data-blocks removed from "
+                           "the dependency graph (for example by hiding a collection), so showing "
+                           "them again does not need re-evaluation when nothing changed (uses more "
+                           "memory)");
 }
 
 static void rna_def_userdef_addon_collection(BlenderRNA *brna, PropertyRNA *cprop)
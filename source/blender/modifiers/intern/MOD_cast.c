@@ -24,6 +24,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -106,6 +107,116 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
+typedef struct CastUserdata {
+  const CastModifierData *cmd;
+  float (*vertexCos)[3];
+  const MDeformVert *dvert;
+  int defgrp_index;
+  bool invert_vgroup;
+  bool use_ctrl_ob;
+  bool has_radius;
+  short flag, type;
+  /* Sphere and cylinder. */
+  float len;
+  /* Cuboid. */
+  float bb[8][3];
+  float center[3];
+  float mat[4][4], imat[4][4];
+} CastUserdata;
+
+/**
+ * Get the influence of the effect on vertex \a i,
+ * returns false when the vertex is not affected.
+ */
+static bool cast_vertex_factor_get(const CastUserdata *data, const int i, float *r_fac)
+{
+  *r_fac = data->cmd->fac;
+
+  if (data->dvert) {
+    const float weight = data->invert_vgroup ?
+                             1.0f - BKE_defvert_find_weight(&data->dvert[i], data->defgrp_index) :
+                             BKE_defvert_find_weight(&data->dvert[i], data->defgrp_index);
+
+    if (weight == 0.0f) {
+      return false;
+    }
+
+    *r_fac *= weight;
+  }
+  return true;
+}
+
+static void cast_vertex_to_local(const CastUserdata *data, float co[3])
+{
+  if (data->use_ctrl_ob) {
+    if (data->flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3((float(*)[4])data->mat, co);
+    }
+    else {
+      sub_v3_v3(co, data->center);
+    }
+  }
+}
+
+static void cast_vertex_from_local(const CastUserdata *data, float co[3])
+{
+  if (data->use_ctrl_ob) {
+    if (data->flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3((float(*)[4])data->imat, co);
+    }
+    else {
+      add_v3_v3(co, data->center);
+    }
+  }
+}
+
+static void sphere_do_task(void *__restrict userdata,
+                           const int i,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CastUserdata *data = userdata;
+  const short flag = data->flag;
+  const float len = data->len;
+  float fac, facm;
+  float vec[3], tmp_co[3];
+
+  copy_v3_v3(tmp_co, data->vertexCos[i]);
+  cast_vertex_to_local(data, tmp_co);
+
+  copy_v3_v3(vec, tmp_co);
+
+  if (data->type == MOD_CAST_TYPE_CYLINDER) {
+    vec[2] = 0.0f;
+  }
+
+  if (data->has_radius) {
+    if (len_v3(vec) > data->cmd->radius) {
+      return;
+    }
+  }
+
+  if (!cast_vertex_factor_get(data, i, &fac)) {
+    return;
+  }
+  facm = 1.0f - fac;
+
+  normalize_v3(vec);
+
+  if (flag & MOD_CAST_X) {
+    tmp_co[0] = fac * vec[0] * len + facm * tmp_co[0];
+  }
+  if (flag & MOD_CAST_Y) {
+    tmp_co[1] = fac * vec[1] * len + facm * tmp_co[1];
+  }
+  if (flag & MOD_CAST_Z) {
+    tmp_co[2] = fac * vec[2] * len + facm * tmp_co[2];
+  }
+
+  cast_vertex_from_local(data, tmp_co);
+
+  copy_v3_v3(data->vertexCos[i], tmp_co);
+}
+
 static void sphere_do(CastModifierData *cmd,
                       const ModifierEvalContext *UNUSED(ctx),
                       Object *ob,
@@ -122,10 +233,7 @@ static void sphere_do(CastModifierData *cmd,
   bool has_radius = false;
   short flag, type;
   float len = 0.0f;
-  float fac = cmd->fac;
-  float facm = 1.0f - fac;
-  const float fac_orig = fac;
-  float vec[3], center[3] = {0.0f, 0.0f, 0.0f};
+  float center[3] = {0.0f, 0.0f, 0.0f};
   float mat[4][4], imat[4][4];
 
   flag = cmd->flag;
@@ -184,67 +292,120 @@ static void sphere_do(CastModifierData *cmd,
     }
   }
 
-  for (i = 0; i < numVerts; i++) {
-    float tmp_co[3];
+  CastUserdata data = {
+      .cmd = cmd,
+      .vertexCos = vertexCos,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .invert_vgroup = invert_vgroup,
+      .use_ctrl_ob = (ctrl_ob != NULL),
+      .has_radius = has_radius,
+      .flag = flag,
+      .type = type,
+      .len = len,
+  };
+  copy_v3_v3(data.center, center);
+  if (ctrl_ob && (flag & MOD_CAST_USE_OB_TRANSFORM)) {
+    copy_m4_m4(data.mat, mat);
+    copy_m4_m4(data.imat, imat);
+  }
 
-    copy_v3_v3(tmp_co, vertexCos[i]);
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(mat, tmp_co);
-      }
-      else {
-        sub_v3_v3(tmp_co, center);
-      }
-    }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 512);
+  BLI_task_parallel_range(0, numVerts, &data, sphere_do_task, &settings);
+}
 
-    copy_v3_v3(vec, tmp_co);
+static void cuboid_do_task(void *__restrict userdata,
+                           const int i,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CastUserdata *data = userdata;
+  const short flag = data->flag;
+  const float radius = data->cmd->radius;
+  int octant, coord;
+  float d[3], dmax, apex[3], fbb;
+  float fac, facm;
+  float tmp_co[3];
 
-    if (type == MOD_CAST_TYPE_CYLINDER) {
-      vec[2] = 0.0f;
-    }
+  copy_v3_v3(tmp_co, data->vertexCos[i]);
+  cast_vertex_to_local(data, tmp_co);
 
-    if (has_radius) {
-      if (len_v3(vec) > cmd->radius) {
-        continue;
-      }
+  if (data->has_radius) {
+    if (fabsf(tmp_co[0]) > radius || fabsf(tmp_co[1]) > radius || fabsf(tmp_co[2]) > radius) {
+      return;
     }
+  }
 
-    if (dvert) {
-      const float weight = invert_vgroup ?
-                               1.0f - BKE_defvert_find_weight(&dvert[i], defgrp_index) :
-                               BKE_defvert_find_weight(&dvert[i], defgrp_index);
+  if (!cast_vertex_factor_get(data, i, &fac)) {
+    return;
+  }
+  facm = 1.0f - fac;
+
+  /* The algorithm used to project the vertices to their
+   * bounding box (bb) is pretty simple:
+   * for each vertex v:
+   * 1) find in which octant v is in;
+   * 2) find which outer "wall" of that octant is closer to v;
+   * 3) calculate factor (var fbb) to project v to that wall;
+   * 4) project. */
+
+  /* find in which octant this vertex is in */
+  octant = 0;
+  if (tmp_co[0] > 0.0f) {
+    octant += 1;
+  }
+  if (tmp_co[1] > 0.0f) {
+    octant += 2;
+  }
+  if (tmp_co[2] > 0.0f) {
+    octant += 4;
+  }
 
-      if (weight == 0.0f) {
-        continue;
-      }
+  /* apex is the bb's vertex at the chosen octant */
+  copy_v3_v3(apex, data->bb[octant]);
 
-      fac = fac_orig * weight;
-      facm = 1.0f - fac;
-    }
+  /* find which bb plane is closest to this vertex ... */
+  d[0] = tmp_co[0] / apex[0];
+  d[1] = tmp_co[1] / apex[1];
+  d[2] = tmp_co[2] / apex[2];
 
-    normalize_v3(vec);
+  /* ... (the closest has the higher (closer to 1) d value) */
+  dmax = d[0];
+  coord = 0;
+  if (d[1] > dmax) {
+    dmax = d[1];
+    coord = 1;
+  }
+  if (d[2] > dmax) {
+    /* dmax = d[2]; */ /* commented, we don't need it */
+    coord = 2;
+  }
 
-    if (flag & MOD_CAST_X) {
-      tmp_co[0] = fac * vec[0] * len + facm * tmp_co[0];
-    }
-    if (flag & MOD_CAST_Y) {
-      tmp_co[1] = fac * vec[1] * len + facm * tmp_co[1];
-    }
-    if (flag & MOD_CAST_Z) {
-      tmp_co[2] = fac * vec[2] * len + facm * tmp_co[2];
-    }
+  /* ok, now we know which coordinate of the vertex to use */
 
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(imat, tmp_co);
-      }
-      else {
-        add_v3_v3(tmp_co, center);
-      }
-    }
+  if (fabsf(tmp_co[coord]) < FLT_EPSILON) { /* avoid division by zero */
+    return;
+  }
 
-    copy_v3_v3(vertexCos[i], tmp_co);
+  /* finally, this is the factor we wanted, to project the vertex
+   * to its bounding box (bb) */
+  fbb = apex[coord] / tmp_co[coord];
+
+  /* calculate the new vertex position */
+  if (flag & MOD_CAST_X) {
+    tmp_co[0] = facm * tmp_co[0] + fac * tmp_co[0] * fbb;
+  }
+  if (flag & MOD_CAST_Y) {
+    tmp_co[1] = facm * tmp_co[1] + fac * tmp_co[1] * fbb;
   }
+  if (flag & MOD_CAST_Z) {
+    tmp_co[2] = facm * tmp_co[2] + fac * tmp_co[2] * fbb;
+  }
+
+  cast_vertex_from_local(data, tmp_co);
+
+  copy_v3_v3(data->vertexCos[i], tmp_co);
 }
 
 static void cuboid_do(CastModifierData *cmd,
@@ -263,9 +424,6 @@ static void cuboid_do(CastModifierData *cmd,
   int i;
   bool has_radius = false;
   short flag;
-  float fac = cmd->fac;
-  float facm = 1.0f - fac;
-  const float fac_orig = fac;
   float min[3], max[3], bb[8][3];
   float center[3] = {0.0f, 0.0f, 0.0f};
   float mat[4][4], imat[4][4];
@@ -362,113 +520,27 @@ static void cuboid_do(CastModifierData *cmd,
   bb[4][2] = bb[5][2] = bb[6][2] = bb[7][2] = max[2];
 
   /* ready to apply the effect, one vertex at a time */
-  for (i = 0; i < numVerts; i++) {
-    int octant, coord;
-    float d[3], dmax, apex[3], fbb;
-    float tmp_co[3];
-
-    copy_v3_v3(tmp_co, vertexCos[i]);
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(mat, tmp_co);
-      }
-      else {
-        sub_v3_v3(tmp_co, center);
-      }
-    }
-
-    if (has_radius) {
-      if (fabsf(tmp_co[0]) > cmd->radius || fabsf(tmp_co[1]) > cmd->radius ||
-          fabsf(tmp_co[2]) > cmd->radius) {
-        continue;
-      }
-    }
-
-    if (dvert) {
-      const float weight = invert_vgroup ?
-                               1.0f - BKE_defvert_find_weight(&dvert[i], defgrp_index) :
-                               BKE_defvert_find_weight(&dvert[i], defgrp_index);
-
-      if (weight == 0.0f) {
-        continue;
-      }
-
-      fac = fac_orig * weight;
-      facm = 1.0f - fac;
-    }
-
-    /* The algorithm used to project the vertices to their
-     * bounding box (bb) is pretty simple:
-     * for each vertex v:
-     * 1) find in which octant v is in;
-     * 2) find which outer "wall" of that octant is closer to v;
-     * 3) calculate factor (var fbb) to project v to that wall;
-     * 4) project. */
-
-    /* find in which octant this vertex is in */
-    octant = 0;
-    if (tmp_co[0] > 0.0f) {
-      octant += 1;
-    }
-    if (tmp_co[1] > 0.0f) {
-      octant += 2;
-    }
-    if (tmp_co[2] > 0.0f) {
-      octant += 4;
-    }
-
-    /* apex is the bb's vertex at the chosen octant */
-    copy_v3_v3(apex, bb[octant]);
-
-    /* find which bb plane is closest to this vertex ... */
-    d[0] = tmp_co[0] / apex[0];
-    d[1] = tmp_co[1] / apex[1];
-    d[2] = tmp_co[2] / apex[2];
-
-    /* ... (the closest has the higher (closer to 1) d value) */
-    dmax = d[0];
-    coord = 0;
-    if (d[1] > dmax) {
-      dmax = d[1];
-      coord = 1;
-    }
-    if (d[2] > dmax) {
-      /* dmax = d[2]; */ /* commented, we don't need it */
-      coord = 2;
-    }
-
-    /* ok, now we know which coordinate of the vertex to use */
-
-    if (fabsf(tmp_co[coord]) < FLT_EPSILON) { /* avoid division by zero */
-      continue;
-    }
-
-    /* finally, this is the factor we wanted, to project the vertex
-     * to its bounding box (bb) */
-    fbb = apex[coord] / tmp_co[coord];
-
-    /* calculate the new vertex position */
-    if (flag & MOD_CAST_X) {
-      tmp_co[0] = facm * tmp_co[0] + fac * tmp_co[0] * fbb;
-    }
-    if (flag & MOD_CAST_Y) {
-      tmp_co[1] = facm * tmp_co[1] + fac * tmp_co[1] * fbb;
-    }
-    if (flag & MOD_CAST_Z) {
-      tmp_co[2] = facm * tmp_co[2] + fac * tmp_co[2] * fbb;
-    }
-
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(imat, tmp_co);
-      }
-      else {
-        add_v3_v3(tmp_co, center);
-      }
-    }
-
-    copy_v3_v3(vertexCos[i], tmp_co);
+  CastUserdata data = {
+      .cmd = cmd,
+      .vertexCos = vertexCos,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .invert_vgroup = invert_vgroup,
+      .use_ctrl_ob = (ctrl_ob != NULL),
+      .has_radius = has_radius,
+      .flag = flag,
+  };
+  copy_v3_v3(data.center, center);
+  if (ctrl_ob && (flag & MOD_CAST_USE_OB_TRANSFORM)) {
+    copy_m4_m4(data.mat, mat);
+    copy_m4_m4(data.imat, imat);
   }
+  memcpy(data.bb, bb, sizeof(bb));
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 512);
+  BLI_task_parallel_range(0, numVerts, &data, cuboid_do_task, &settings);
 }
 
 static void deformVerts(ModifierData *md,
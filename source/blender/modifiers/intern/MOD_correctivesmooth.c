@@ -26,6 +26,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -43,6 +44,8 @@
 #include "BKE_editmesh.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
+#include "BKE_mesh_runtime.h"
 #include "BKE_mesh_wrapper.h"
 #include "BKE_screen.h"
 
@@ -177,6 +180,110 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
   MEM_freeN(boundaries);
 }
 
+/* -------------------------------------------------------------------- */
+/* Threaded Smoothing
+ *
+ * Each iteration first gathers the deltas of all vertices from their edges, then applies them.
+ * The vertex to edge map lists edges in index order, so the deltas are summed in the same order
+ * as when looping over the edges. */
+
+typedef struct SmoothingData {
+  float delta[3];
+  float edge_length_sum;
+} SmoothingData;
+
+typedef struct SmoothIterData {
+  const MEdge *edges;
+  const MeshElemMap *vert_edges;
+  float (*vertexCos)[3];
+  SmoothingData *smooth_data;
+
+  /* Simple smoothing, the factor applied to the delta of each vertex. */
+  const float *vertex_factor;
+
+  /* Length weighted smoothing. */
+  const float *vertex_edge_count;
+  const float *smooth_weights;
+  float lambda;
+} SmoothIterData;
+
+static void smooth_iter_gather_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SmoothIterData *data = userdata;
+  const MeshElemMap *vert_edges = &data->vert_edges[i];
+  SmoothingData *sd = &data->smooth_data[i];
+  const bool use_length_weight = (data->vertex_factor == NULL);
+
+  zero_v3(sd->delta);
+  sd->edge_length_sum = 0.0f;
+
+  for (int j = 0; j < vert_edges->count; j++) {
+    const MEdge *e = &data->edges[vert_edges->indices[j]];
+    float edge_dir[3];
+
+    sub_v3_v3v3(edge_dir, data->vertexCos[e->v2], data->vertexCos[e->v1]);
+
+    if (use_length_weight) {
+      const float edge_dist = len_v3(edge_dir);
+
+      /* weight by distance */
+      mul_v3_fl(edge_dir, edge_dist);
+      sd->edge_length_sum += edge_dist;
+    }
+
+    if (e->v1 == (uint)i) {
+      add_v3_v3(sd->delta, edge_dir);
+    }
+    else {
+      sub_v3_v3(sd->delta, edge_dir);
+    }
+  }
+}
+
+static void smooth_iter_simple_apply_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SmoothIterData *data = userdata;
+  madd_v3_v3fl(data->vertexCos[i], data->smooth_data[i].delta, data->vertex_factor[i]);
+}
+
+static void smooth_iter_length_weight_apply_cb(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const float eps = FLT_EPSILON * 10.0f;
+  SmoothIterData *data = userdata;
+  const SmoothingData *sd = &data->smooth_data[i];
+
+  /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
+   * (mean average). */
+  const float div = sd->edge_length_sum * data->vertex_edge_count[i];
+  if (div > eps) {
+    const float lambda_w = data->smooth_weights ? data->lambda * data->smooth_weights[i] :
+                                                  data->lambda;
+    madd_v3_v3fl(data->vertexCos[i], sd->delta, lambda_w / div);
+  }
+}
+
+static void smooth_iter_threaded(SmoothIterData *data,
+                                 const uint numVerts,
+                                 uint iterations,
+                                 TaskParallelRangeFunc apply_cb)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 1024);
+  settings.min_iter_per_thread = 1024;
+
+  while (iterations--) {
+    BLI_task_parallel_range(0, (int)numVerts, data, smooth_iter_gather_cb, &settings);
+    BLI_task_parallel_range(0, (int)numVerts, data, apply_cb, &settings);
+  }
+}
+
 /* -------------------------------------------------------------------- */
 /* Simple Weighted Smoothing
  *
@@ -192,64 +299,40 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
   const float lambda = csmd->lambda;
   uint i;
 
-  const uint numEdges = (uint)mesh->totedge;
-  const MEdge *edges = mesh->medge;
+  const MeshElemMap *vert_edges = BKE_mesh_runtime_vert_edge_map_ensure(mesh);
   float *vertex_edge_count_div;
 
-  struct SmoothingData_Simple {
-    float delta[3];
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  SmoothingData *smooth_data = MEM_malloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
 
-  vertex_edge_count_div = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
-
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  for (i = 0; i < numEdges; i++) {
-    vertex_edge_count_div[edges[i].v1] += 1.0f;
-    vertex_edge_count_div[edges[i].v2] += 1.0f;
-  }
+  vertex_edge_count_div = MEM_malloc_arrayN(numVerts, sizeof(float), __func__);
 
   /* a little confusing, but we can include 'lambda' and smoothing weight
    * here to avoid multiplying for every iteration */
   if (smooth_weights == NULL) {
     for (i = 0; i < numVerts; i++) {
-      vertex_edge_count_div[i] = lambda * (vertex_edge_count_div[i] ?
-                                               (1.0f / vertex_edge_count_div[i]) :
-                                               1.0f);
+      const float edge_count = (float)vert_edges[i].count;
+      vertex_edge_count_div[i] = lambda * (edge_count ? (1.0f / edge_count) : 1.0f);
     }
   }
   else {
     for (i = 0; i < numVerts; i++) {
+      const float edge_count = (float)vert_edges[i].count;
       vertex_edge_count_div[i] = smooth_weights[i] * lambda *
-                                 (vertex_edge_count_div[i] ? (1.0f / vertex_edge_count_div[i]) :
-                                                             1.0f);
+                                 (edge_count ? (1.0f / edge_count) : 1.0f);
     }
   }
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
-  while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Simple *sd_v1;
-      struct SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-    }
-
-    for (i = 0; i < numVerts; i++) {
-      struct SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
-  }
+  SmoothIterData data = {
+      .edges = mesh->medge,
+      .vert_edges = vert_edges,
+      .vertexCos = vertexCos,
+      .smooth_data = smooth_data,
+      .vertex_factor = vertex_edge_count_div,
+  };
+  smooth_iter_threaded(&data, numVerts, iterations, smooth_iter_simple_apply_cb);
 
   MEM_freeN(vertex_edge_count_div);
   MEM_freeN(smooth_data);
@@ -265,88 +348,34 @@ static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
                                        const float *smooth_weights,
                                        uint iterations)
 {
-  const float eps = FLT_EPSILON * 10.0f;
-  const uint numEdges = (uint)mesh->totedge;
   /* note: the way this smoothing method works, its approx half as strong as the simple-smooth,
    * and 2.0 rarely spikes, double the value for consistent behavior. */
   const float lambda = csmd->lambda * 2.0f;
-  const MEdge *edges = mesh->medge;
+  const MeshElemMap *vert_edges = BKE_mesh_runtime_vert_edge_map_ensure(mesh);
   float *vertex_edge_count;
   uint i;
 
-  struct SmoothingData_Weighted {
-    float delta[3];
-    float edge_length_sum;
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  SmoothingData *smooth_data = MEM_malloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
 
   /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  vertex_edge_count = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
-  for (i = 0; i < numEdges; i++) {
-    vertex_edge_count[edges[i].v1] += 1.0f;
-    vertex_edge_count[edges[i].v2] += 1.0f;
+  vertex_edge_count = MEM_malloc_arrayN(numVerts, sizeof(float), __func__);
+  for (i = 0; i < numVerts; i++) {
+    vertex_edge_count[i] = (float)vert_edges[i].count;
   }
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
-  while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Weighted *sd_v1;
-      struct SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-      edge_dist = len_v3(edge_dir);
-
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
-
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
-    }
-
-    if (smooth_weights == NULL) {
-      /* fast-path */
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
-         * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
-        }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-    else {
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
-        }
-
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-  }
+  SmoothIterData data = {
+      .edges = mesh->medge,
+      .vert_edges = vert_edges,
+      .vertexCos = vertexCos,
+      .smooth_data = smooth_data,
+      .vertex_edge_count = vertex_edge_count,
+      .smooth_weights = smooth_weights,
+      .lambda = lambda,
+  };
+  smooth_iter_threaded(&data, numVerts, iterations, smooth_iter_length_weight_apply_cb);
 
   MEM_freeN(vertex_edge_count);
   MEM_freeN(smooth_data);
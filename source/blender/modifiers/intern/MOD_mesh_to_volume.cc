@@ -53,6 +53,7 @@
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/openvdb.h>
+#  include <openvdb/tools/LevelSetUtil.h>
 #  include <openvdb/tools/MeshToVolume.h>
 #endif
 
@@ -242,9 +243,13 @@ static Volume *modifyVolume(ModifierData *md, const ModifierEvalContext *ctx, Vo
 
   openvdb::FloatGrid::Ptr new_grid;
   if (mvmd->fill_volume) {
-    /* Setting the interior bandwidth to FLT_MAX, will make it fill the entire volume. */
+    /* Computing the distances in the entire interior is expensive and not needed, since all
+     * active cells get the same density below. Instead only compute a narrow band and activate
+     * the interior based on the sign of the level set, which also activates whole tiles. */
     new_grid = openvdb::tools::meshToVolume<openvdb::FloatGrid>(
-        mesh_adapter, {}, exterior_band_width, FLT_MAX);
+        mesh_adapter, {}, exterior_band_width, 1.0f);
+    openvdb::BoolGrid::Ptr interior_mask = openvdb::tools::sdfInteriorMask(*new_grid);
+    new_grid->topologyUnion(*interior_mask);
   }
   else {
     new_grid = openvdb::tools::meshToVolume<openvdb::FloatGrid>(
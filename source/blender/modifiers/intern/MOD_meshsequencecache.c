@@ -57,8 +57,10 @@
 
 #ifdef WITH_ALEMBIC
 #  include "ABC_alembic.h"
+#  include "BKE_customdata.h"
 #  include "BKE_global.h"
 #  include "BKE_lib_id.h"
+#  include "BKE_mesh.h"
 #endif
 
 static void initData(ModifierData *md)
@@ -146,7 +148,14 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
 
     /* TODO(sybren+bastien): possibly check relevant custom data layers (UV/color depending on
      * flags) and duplicate those too. */
-    if ((me->mvert == mvert) || (me->medge == medge) || (me->mpoly == mpoly)) {
+    if ((mcmd->read_flag & MOD_MESHSEQ_READ_ALL) == MOD_MESHSEQ_READ_VERT &&
+        (me->mvert == mvert)) {
+      /* Only vertices are read into the mesh, the rest of its data can be shared. */
+      mesh = BKE_mesh_copy_for_eval(mesh, true);
+      CustomData_duplicate_referenced_layer(&mesh->vdata, CD_MVERT, mesh->totvert);
+      BKE_mesh_update_customdata_pointers(mesh, false);
+    }
+    else if ((me->mvert == mvert) || (me->medge == medge) || (me->mpoly == mpoly)) {
       /* We need to duplicate data here, otherwise we'll modify org mesh, see T51701. */
       mesh = (Mesh *)BKE_id_copy_ex(NULL,
                                     &mesh->id,
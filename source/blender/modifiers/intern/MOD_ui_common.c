@@ -32,6 +32,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
 #include "ED_object.h"
 
@@ -110,6 +111,14 @@ void modifier_panel_end(uiLayout *layout, PointerRNA *ptr)
     uiLayout *row = uiLayoutRow(layout, false);
     uiItemL(row, IFACE_(md->error), ICON_ERROR);
   }
+
+  /* The execution time is stored on the evaluated modifier and copied back to the original. */
+  if ((U.flag & USER_DEVELOPER_UI) && md->execution_time > 0.0) {
+    char time_str[64];
+    BLI_snprintf(
+        time_str, sizeof(time_str), TIP_("Evaluation: %.2f ms"), md->execution_time * 1000.0);
+    uiItemL(layout, time_str, ICON_TIME);
+  }
 }
 
 /**
@@ -287,6 +296,13 @@ static void modifier_ops_extra_draw(bContext *C, uiLayout *layout, void *md_v)
   if (!md->next) {
     uiLayoutSetEnabled(row, false);
   }
+
+  /* Result cache, only constructive modifiers are cached. */
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+  if (mti->type != eModifierTypeType_OnlyDeform) {
+    uiItemS(layout);
+    uiItemR(layout, &ptr, "use_cache_result", 0, NULL, ICON_NONE);
+  }
 }
 
 static void modifier_panel_header(const bContext *C, Panel *panel)
@@ -182,12 +182,6 @@ class NodeTreeRef : NonCopyable, NonMovable {
 
  private:
   /* Utility functions used during construction. */
-  InputSocketRef &find_input_socket(Map<bNode *, NodeRef *> &node_mapping,
-                                    bNode *bnode,
-                                    bNodeSocket *bsocket);
-  OutputSocketRef &find_output_socket(Map<bNode *, NodeRef *> &node_mapping,
-                                      bNode *bnode,
-                                      bNodeSocket *bsocket);
   void find_targets_skipping_reroutes(OutputSocketRef &socket_ref, Vector<SocketRef *> &r_targets);
 };
 
@@ -22,7 +22,10 @@ namespace blender::nodes {
 
 NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
 {
-  Map<bNode *, NodeRef *> node_mapping;
+  /* Links are resolved with these, so that it is not necessary to search through all sockets of
+   * a node for every link. Group nodes with many sockets would make that quadratic. */
+  Map<bNodeSocket *, InputSocketRef *> input_socket_mapping;
+  Map<bNodeSocket *, OutputSocketRef *> output_socket_mapping;
 
   LISTBASE_FOREACH (bNode *, bnode, &btree->nodes) {
     NodeRef &node = *allocator_.construct<NodeRef>();
@@ -40,6 +43,7 @@ NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
       socket.bsocket_ = bsocket;
       socket.id_ = sockets_by_id_.append_and_get_index(&socket);
       RNA_pointer_create(&btree->id, &RNA_NodeSocket, bsocket, &socket.rna_);
+      input_socket_mapping.add_new(bsocket, &socket);
     }
 
     LISTBASE_FOREACH (bNodeSocket *, bsocket, &bnode->outputs) {
@@ -50,19 +54,16 @@ NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
       socket.bsocket_ = bsocket;
       socket.id_ = sockets_by_id_.append_and_get_index(&socket);
       RNA_pointer_create(&btree->id, &RNA_NodeSocket, bsocket, &socket.rna_);
+      output_socket_mapping.add_new(bsocket, &socket);
     }
 
     input_sockets_.extend(node.inputs_.as_span());
     output_sockets_.extend(node.outputs_.as_span());
-
-    node_mapping.add_new(bnode, &node);
   }
 
   LISTBASE_FOREACH (bNodeLink *, blink, &btree->links) {
-    OutputSocketRef &from_socket = this->find_output_socket(
-        node_mapping, blink->fromnode, blink->fromsock);
-    InputSocketRef &to_socket = this->find_input_socket(
-        node_mapping, blink->tonode, blink->tosock);
+    OutputSocketRef &from_socket = *output_socket_mapping.lookup(blink->fromsock);
+    InputSocketRef &to_socket = *input_socket_mapping.lookup(blink->tosock);
 
     from_socket.directly_linked_sockets_.append(&to_socket);
     to_socket.directly_linked_sockets_.append(&from_socket);
@@ -96,34 +97,6 @@ NodeTreeRef::~NodeTreeRef()
   }
 }
 
-InputSocketRef &NodeTreeRef::find_input_socket(Map<bNode *, NodeRef *> &node_mapping,
-                                               bNode *bnode,
-                                               bNodeSocket *bsocket)
-{
-  NodeRef *node = node_mapping.lookup(bnode);
-  for (InputSocketRef *socket : node->inputs_) {
-    if (socket->bsocket_ == bsocket) {
-      return *socket;
-    }
-  }
-  BLI_assert(false);
-  return *node->inputs_[0];
-}
-
-OutputSocketRef &NodeTreeRef::find_output_socket(Map<bNode *, NodeRef *> &node_mapping,
-                                                 bNode *bnode,
-                                                 bNodeSocket *bsocket)
-{
-  NodeRef *node = node_mapping.lookup(bnode);
-  for (OutputSocketRef *socket : node->outputs_) {
-    if (socket->bsocket_ == bsocket) {
-      return *socket;
-    }
-  }
-  BLI_assert(false);
-  return *node->outputs_[0];
-}
-
 void NodeTreeRef::find_targets_skipping_reroutes(OutputSocketRef &socket,
                                                  Vector<SocketRef *> &r_targets)
 {
@@ -34,6 +34,7 @@
 #include "GPU_primitive.h"
 
 #include "gpu_py_matrix.h"
+#include "gpu_py_profile.h"
 #include "gpu_py_select.h"
 #include "gpu_py_types.h"
 
@@ -128,6 +129,9 @@ PyObject *BPyInit_gpu(void)
   PyModule_AddObject(mod, "matrix", (submodule = BPyInit_gpu_matrix()));
   PyDict_SetItem(sys_modules, PyModule_GetNameObject(submodule), submodule);
 
+  PyModule_AddObject(mod, "profile", (submodule = BPyInit_gpu_profile()));
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(submodule), submodule);
+
   PyModule_AddObject(mod, "select", (submodule = BPyInit_gpu_select()));
   PyDict_SetItem(sys_modules, PyModule_GetNameObject(submodule), submodule);
 
@@ -0,0 +1,173 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bpygpu
+ *
+ * This file defines the gpu.profile API.
+ *
+ * Exposes the timings recorded by the draw manager for each engine and pass,
+ * to test the viewport performance from scripts.
+ *
+ * - Use ``bpygpu_`` for local API.
+ * - Use ``BPyGPU`` for public API.
+ */
+
+#include <Python.h>
+
+#include "BLI_utildefines.h"
+
+#include "../generic/py_capi_utils.h"
+#include "../generic/python_utildefines.h"
+
+#include "DRW_engine.h"
+
+#include "gpu_py_profile.h" /* own include */
+
+/* -------------------------------------------------------------------- */
+/** \name Methods
+ * \{ */
+
+/* Set the item and transfer ownership of \a value to the dictionary. */
+static void bpygpu_dict_set_item_steal(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyDoc_STRVAR(bpygpu_profile_enable_doc,
+             ".. function:: enable(state)\n"
+             "\n"
+             "   Record the timings of the following viewport redraws.\n"
+             "\n"
+             "   :param state: Enable or disable the recording.\n"
+             "   :type state: bool\n");
+static PyObject *bpygpu_profile_enable(PyObject *UNUSED(self), PyObject *value)
+{
+  bool state;
+  if (!PyC_ParseBool(value, &state)) {
+    return NULL;
+  }
+  DRW_stats_enable(state);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    bpygpu_profile_report_doc,
+    ".. function:: report()\n"
+    "\n"
+    "   Timings of the last redraw recorded by the draw manager.\n"
+    "   Times are in milliseconds, GPU times are measured one redraw later.\n"
+    "\n"
+    "   :return: Dictionary with an ``engines`` list of dictionaries (``name``, ``init``,\n"
+    "      ``background`` and ``render`` times, averaged over several redraws) and a\n"
+    "      ``timers`` list of dictionaries (``name``, ``level``, ``is_pass``, ``cpu_start``,\n"
+    "      ``cpu_time``, ``gpu_time``, ``draw_calls`` and ``state_changes``).\n"
+    "   :rtype: dict\n");
+static PyObject *bpygpu_profile_report(PyObject *UNUSED(self))
+{
+  const int engine_len = DRW_stats_engine_len();
+  PyObject *engines = PyList_New(engine_len);
+  for (int i = 0; i < engine_len; i++) {
+    DRWStatsEngineInfo info;
+    DRW_stats_engine_info_get(i, &info);
+    PyObject *item = PyDict_New();
+    bpygpu_dict_set_item_steal(item, "name", PyUnicode_FromString(info.name));
+    bpygpu_dict_set_item_steal(item, "init", PyFloat_FromDouble(info.init_time));
+    bpygpu_dict_set_item_steal(item, "background", PyFloat_FromDouble(info.background_time));
+    bpygpu_dict_set_item_steal(item, "render", PyFloat_FromDouble(info.render_time));
+    PyList_SET_ITEM(engines, i, item);
+  }
+
+  const int timer_len = DRW_stats_timer_len();
+  PyObject *timers = PyList_New(timer_len);
+  for (int i = 0; i < timer_len; i++) {
+    DRWStatsTimerInfo info;
+    DRW_stats_timer_info_get(i, &info);
+    PyObject *item = PyDict_New();
+    bpygpu_dict_set_item_steal(item, "name", PyUnicode_FromString(info.name));
+    bpygpu_dict_set_item_steal(item, "level", PyLong_FromLong(info.level));
+    bpygpu_dict_set_item_steal(item, "is_pass", PyBool_FromLong(info.is_pass));
+    bpygpu_dict_set_item_steal(item, "cpu_start", PyFloat_FromDouble(info.cpu_start));
+    bpygpu_dict_set_item_steal(item, "cpu_time", PyFloat_FromDouble(info.cpu_time));
+    bpygpu_dict_set_item_steal(item, "gpu_time", PyFloat_FromDouble(info.gpu_time));
+    bpygpu_dict_set_item_steal(item, "draw_calls", PyLong_FromUnsignedLong(info.draw_call_len));
+    bpygpu_dict_set_item_steal(
+        item, "state_changes", PyLong_FromUnsignedLong(info.state_change_len));
+    PyList_SET_ITEM(timers, i, item);
+  }
+
+  PyObject *ret = PyDict_New();
+  bpygpu_dict_set_item_steal(ret, "engines", engines);
+  bpygpu_dict_set_item_steal(ret, "timers", timers);
+  return ret;
+}
+
+PyDoc_STRVAR(bpygpu_profile_trace_write_doc,
+             ".. function:: trace_write(filepath)\n"
+             "\n"
+             "   Write the timings of the last recorded redraw in the Chrome trace event format.\n"
+             "\n"
+             "   :param filepath: Path of the JSON file to write.\n"
+             "   :type filepath: str\n");
+static PyObject *bpygpu_profile_trace_write(PyObject *UNUSED(self), PyObject *value)
+{
+  const char *filepath = _PyUnicode_AsString(value);
+  if (filepath == NULL) {
+    PyErr_Format(PyExc_TypeError, "expected a string, got %s", Py_TYPE(value)->tp_name);
+    return NULL;
+  }
+  if (!DRW_stats_trace_write(filepath)) {
+    PyErr_Format(PyExc_IOError, "could not write trace to '%s'", filepath);
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Module
+ * \{ */
+
+static struct PyMethodDef bpygpu_profile_methods[] = {
+    {"enable", (PyCFunction)bpygpu_profile_enable, METH_O, bpygpu_profile_enable_doc},
+    {"report", (PyCFunction)bpygpu_profile_report, METH_NOARGS, bpygpu_profile_report_doc},
+    {"trace_write",
+     (PyCFunction)bpygpu_profile_trace_write,
+     METH_O,
+     bpygpu_profile_trace_write_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+PyDoc_STRVAR(bpygpu_profile_doc, "This module provides access to the viewport timings.");
+static PyModuleDef BPyGPU_profile_module_def = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "gpu.profile",
+    .m_doc = bpygpu_profile_doc,
+    .m_methods = bpygpu_profile_methods,
+};
+
+PyObject *BPyInit_gpu_profile(void)
+{
+  PyObject *submodule;
+
+  submodule = PyModule_Create(&BPyGPU_profile_module_def);
+
+  return submodule;
+}
+
+/** \} */
@@ -43,6 +43,7 @@
 
 /* modules */
 #include "bpy_app_icons.h"
+#include "bpy_app_memory.h"
 #include "bpy_app_timers.h"
 
 #include "BLI_utildefines.h"
@@ -122,6 +123,7 @@ static PyStructSequence_Field app_info_fields[] = {
 
     /* Modules (not struct sequence). */
     {"icons", "Manage custom icons"},
+    {"memory", "Memory usage statistics"},
     {"timers", "Manage timers"},
     {NULL},
 };
@@ -208,6 +210,7 @@ static PyObject *make_app_info(void)
 
   /* modules */
   SetObjItem(BPY_app_icons_module());
+  SetObjItem(BPY_app_memory_module());
   SetObjItem(BPY_app_timers_module());
 
 #undef SetIntItem
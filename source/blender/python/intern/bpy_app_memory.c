@@ -0,0 +1,140 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Memory usage statistics per allocation name, see #MEM_profile_enable.
+ */
+
+#include <Python.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "bpy_app_memory.h"
+
+PyDoc_STRVAR(bpy_app_memory_profile_enable_doc,
+             ".. function:: profile_enable()\n"
+             "\n"
+             "   Start collecting memory statistics per allocation name for memory allocated from\n"
+             "   now on (enabled from startup with the ``--debug-memory-profile`` argument).\n"
+             "   Profiling can't be disabled again.\n");
+static PyObject *bpy_app_memory_profile_enable(PyObject *UNUSED(self))
+{
+  MEM_profile_enable();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_memory_profile_is_enabled_doc,
+             ".. function:: profile_is_enabled()\n"
+             "\n"
+             "   :return: True when memory statistics are being collected.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_memory_profile_is_enabled(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(MEM_profile_is_enabled());
+}
+
+static void bpy_app_memory_profile_stats_add(const MEM_ProfileStats *stats, void *user_data)
+{
+  PyObject *dict = user_data;
+  const size_t values[4] = {
+      stats->live_len, stats->live_blocks, stats->total_len, stats->total_blocks};
+
+  /* The same name may be reported more than once, accumulate. */
+  PyObject *item_prev = PyDict_GetItemString(dict, stats->name);
+  PyObject *item = PyTuple_New(ARRAY_SIZE(values));
+  for (uint i = 0; i < ARRAY_SIZE(values); i++) {
+    size_t value = values[i];
+    if (item_prev) {
+      value += PyLong_AsSize_t(PyTuple_GET_ITEM(item_prev, i));
+    }
+    PyTuple_SET_ITEM(item, i, PyLong_FromSize_t(value));
+  }
+  PyDict_SetItemString(dict, stats->name, item);
+  Py_DECREF(item);
+}
+
+PyDoc_STRVAR(bpy_app_memory_profile_stats_doc,
+             ".. function:: profile_stats()\n"
+             "\n"
+             "   Memory statistics per allocation name. Sampling the totals over time gives the\n"
+             "   allocation rate.\n"
+             "\n"
+             "   :return: Dictionary mapping allocation names to\n"
+             "      (live_bytes, live_blocks, total_bytes, total_blocks) tuples.\n"
+             "   :rtype: dict\n");
+static PyObject *bpy_app_memory_profile_stats(PyObject *UNUSED(self))
+{
+  PyObject *dict = PyDict_New();
+  MEM_profile_stats_foreach(bpy_app_memory_profile_stats_add, dict);
+  return dict;
+}
+
+PyDoc_STRVAR(bpy_app_memory_profile_print_doc,
+             ".. function:: profile_print()\n"
+             "\n"
+             "   Print the memory statistics per allocation name, sorted by live memory.\n");
+static PyObject *bpy_app_memory_profile_print(PyObject *UNUSED(self))
+{
+  MEM_profile_print();
+  Py_RETURN_NONE;
+}
+
+static struct PyMethodDef M_AppMemory_methods[] = {
+    {"profile_enable",
+     (PyCFunction)bpy_app_memory_profile_enable,
+     METH_NOARGS,
+     bpy_app_memory_profile_enable_doc},
+    {"profile_is_enabled",
+     (PyCFunction)bpy_app_memory_profile_is_enabled,
+     METH_NOARGS,
+     bpy_app_memory_profile_is_enabled_doc},
+    {"profile_stats",
+     (PyCFunction)bpy_app_memory_profile_stats,
+     METH_NOARGS,
+     bpy_app_memory_profile_stats_doc},
+    {"profile_print",
+     (PyCFunction)bpy_app_memory_profile_print,
+     METH_NOARGS,
+     bpy_app_memory_profile_print_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef M_AppMemory_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.memory",    /* m_name */
+    NULL,                /* m_doc */
+    0,                   /* m_size */
+    M_AppMemory_methods, /* m_methods */
+    NULL,                /* m_reload */
+    NULL,                /* m_traverse */
+    NULL,                /* m_clear */
+    NULL,                /* m_free */
+};
+
+PyObject *BPY_app_memory_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+
+  PyObject *mod = PyModule_Create(&M_AppMemory_module_def);
+
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+
+  return mod;
+}
@@ -445,6 +445,9 @@ static void bpy_pydriver_namespace_add_depsgraph(PyObject *driver_vars,
  * For copy-on-write we always cache expressions and write errors in the
  * original driver, otherwise these would get freed while editing. Due to
  * the GIL this is thread-safe.
+ *
+ * Variables other than single properties must have been evaluated into `dvar->curval`
+ * by the caller, outside of the GIL.
  */
 float BPY_driver_exec(struct PathResolvedRNA *anim_rna,
                       ChannelDriver *driver,
@@ -593,8 +596,11 @@ float BPY_driver_exec(struct PathResolvedRNA *anim_rna,
     else
 #endif
     {
-      /* try to get variable value */
-      const float tval = driver_get_variable_value(driver, dvar);
+      /* Try to get variable value, other types than single properties were already evaluated by
+       * the caller before taking the Python driver lock. */
+      const float tval = (dvar->type == DVAR_TYPE_SINGLE_PROP) ?
+                             driver_get_variable_value(driver, dvar) :
+                             dvar->curval;
       driver_arg = PyFloat_FromDouble((double)tval);
     }
 
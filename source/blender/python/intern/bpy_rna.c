@@ -5235,6 +5235,45 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Raw type of a buffer that doesn't match the attribute, but which RNA can convert from and to
+ * itself, without creating a Python object per item (e.g. a double array for float data).
+ */
+static RawPropertyType foreach_buffer_convert_raw_type(const Py_buffer *buf, const int tot)
+{
+  RawPropertyType raw_type;
+
+  if (buf->format == NULL || buf->format[0] == '\0' || buf->format[1] != '\0') {
+    return PROP_RAW_UNSET;
+  }
+
+  switch (buf->format[0]) {
+    case 'h':
+      raw_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+      raw_type = PROP_RAW_INT;
+      break;
+    case '?':
+      raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      raw_type = PROP_RAW_DOUBLE;
+      break;
+    default:
+      return PROP_RAW_UNSET;
+  }
+
+  if (buf->len != (Py_ssize_t)tot * RNA_raw_type_sizeof(raw_type)) {
+    return PROP_RAW_UNSET;
+  }
+
+  return raw_type;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5272,6 +5311,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_raw_type = foreach_buffer_convert_raw_type(&buf, tot);
+        if (buf_raw_type != PROP_RAW_UNSET) {
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+          buffer_is_compat = true;
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5328,6 +5375,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_raw_type = foreach_buffer_convert_raw_type(&buf, tot);
+        if (buf_raw_type != PROP_RAW_UNSET) {
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+          buffer_is_compat = true;
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -66,6 +66,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -332,15 +333,15 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     hit_distance = FLT_MAX;
   }
 
-  BVHTreeRayHit *hits;
-  hits = MEM_mallocN(sizeof(BVHTreeRayHit) * tot_highpoly, "Bake Highpoly to Lowpoly: BVH Rays");
+  /* Only the closest hit is needed, this runs for every pixel so avoid allocating. */
+  BVHTreeRayHit hit, hit_closest;
 
   for (i = 0; i < tot_highpoly; i++) {
     float co_high[3], dir_high[3];
 
-    hits[i].index = -1;
+    hit.index = -1;
     /* TODO: we should use FLT_MAX here, but sweepsphere code isn't prepared for that */
-    hits[i].dist = BVH_RAYCAST_DIST_MAX;
+    hit.dist = BVH_RAYCAST_DIST_MAX;
 
     /* transform the ray from the world space to the highpoly space */
     mul_v3_m4v3(co_high, highpoly[i].imat, co);
@@ -355,28 +356,29 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
                            co_high,
                            dir_high,
                            0.0f,
-                           &hits[i],
+                           &hit,
                            treeData[i].raycast_callback,
                            &treeData[i]);
     }
 
-    if (hits[i].index != -1) {
+    if (hit.index != -1) {
       float distance;
       float hit_world[3];
 
       /* distance comparison in world space */
-      mul_v3_m4v3(hit_world, highpoly[i].obmat, hits[i].co);
+      mul_v3_m4v3(hit_world, highpoly[i].obmat, hit.co);
       distance = len_squared_v3v3(hit_world, co);
 
       if (distance < hit_distance) {
         hit_mesh = i;
         hit_distance = distance;
+        hit_closest = hit;
       }
     }
   }
 
   if (hit_mesh != -1) {
-    int primitive_id_high = hits[hit_mesh].index;
+    int primitive_id_high = hit_closest.index;
     TriTessFace *triangle_high = &triangles[hit_mesh][primitive_id_high];
     BakePixel *pixel_low = &pixel_array_low[pixel_id];
     BakePixel *pixel_high = &pixel_array[pixel_id];
@@ -412,7 +414,7 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     madd_v3_v3fl(dyco, tmp, -dot_v3v3(dyco, triangle_high->normal));
 
     /* compute barycentric differentials from position differentials */
-    barycentric_differentials_from_position(hits[hit_mesh].co,
+    barycentric_differentials_from_position(hit_closest.co,
                                             triangle_high->mverts[0]->co,
                                             triangle_high->mverts[1]->co,
                                             triangle_high->mverts[2]->co,
@@ -436,7 +438,6 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     pixel_array[pixel_id].object_id = -1;
   }
 
-  MEM_freeN(hits);
   return hit_mesh != -1;
 }
 
@@ -517,6 +518,103 @@ static TriTessFace *mesh_calc_tri_tessface(Mesh *me, bool tangent, Mesh *me_eval
   return triangles;
 }
 
+typedef struct BakeHighPolyRaycastData {
+  BakePixel *pixel_array_from;
+  BakePixel *pixel_array_to;
+  BakeHighPolyData *highpoly;
+  int tot_highpoly;
+  bool is_custom_cage;
+  bool is_cage;
+  float cage_extrusion;
+  float max_ray_distance;
+  float (*mat_low)[4];
+  float (*imat_low)[4];
+  float (*mat_cage)[4];
+  TriTessFace *tris_low;
+  TriTessFace *tris_cage;
+  TriTessFace **tris_high;
+  BVHTreeFromMesh *treeData;
+} BakeHighPolyRaycastData;
+
+static void bake_highpoly_raycast_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BakeHighPolyRaycastData *data = userdata;
+  BakePixel *pixel_array_from = data->pixel_array_from;
+  BakePixel *pixel_array_to = data->pixel_array_to;
+  float co[3];
+  float dir[3];
+  TriTessFace *tri_low;
+
+  const int primitive_id = pixel_array_from[i].primitive_id;
+
+  if (primitive_id == -1) {
+    pixel_array_to[i].primitive_id = -1;
+    return;
+  }
+
+  const float u = pixel_array_from[i].uv[0];
+  const float v = pixel_array_from[i].uv[1];
+
+  /* calculate from low poly mesh cage */
+  if (data->is_custom_cage) {
+    calc_point_from_barycentric_cage(data->tris_low,
+                                     data->tris_cage,
+                                     data->mat_low,
+                                     data->mat_cage,
+                                     primitive_id,
+                                     u,
+                                     v,
+                                     co,
+                                     dir);
+    tri_low = &data->tris_cage[primitive_id];
+  }
+  else if (data->is_cage) {
+    calc_point_from_barycentric_extrusion(data->tris_cage,
+                                          data->mat_low,
+                                          data->imat_low,
+                                          primitive_id,
+                                          u,
+                                          v,
+                                          data->cage_extrusion,
+                                          co,
+                                          dir,
+                                          true);
+    tri_low = &data->tris_cage[primitive_id];
+  }
+  else {
+    calc_point_from_barycentric_extrusion(data->tris_low,
+                                          data->mat_low,
+                                          data->imat_low,
+                                          primitive_id,
+                                          u,
+                                          v,
+                                          data->cage_extrusion,
+                                          co,
+                                          dir,
+                                          false);
+    tri_low = &data->tris_low[primitive_id];
+  }
+
+  /* cast ray */
+  if (!cast_ray_highpoly(data->treeData,
+                         tri_low,
+                         data->tris_high,
+                         pixel_array_from,
+                         pixel_array_to,
+                         data->mat_low,
+                         data->highpoly,
+                         co,
+                         dir,
+                         i,
+                         data->tot_highpoly,
+                         data->max_ray_distance)) {
+    /* if it fails mask out the original pixel array */
+    pixel_array_from[i].primitive_id = -1;
+  }
+}
+
 bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           BakePixel pixel_array_from[],
                                           BakePixel pixel_array_to[],
@@ -531,8 +629,6 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           struct Mesh *me_cage)
 {
   size_t i;
-  int primitive_id;
-  float u, v;
   float imat_low[4][4];
   bool is_cage = me_cage != NULL;
   bool result = true;
@@ -586,55 +682,29 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
     }
   }
 
-  for (i = 0; i < num_pixels; i++) {
-    float co[3];
-    float dir[3];
-    TriTessFace *tri_low;
-
-    primitive_id = pixel_array_from[i].primitive_id;
-
-    if (primitive_id == -1) {
-      pixel_array_to[i].primitive_id = -1;
-      continue;
-    }
-
-    u = pixel_array_from[i].uv[0];
-    v = pixel_array_from[i].uv[1];
-
-    /* calculate from low poly mesh cage */
-    if (is_custom_cage) {
-      calc_point_from_barycentric_cage(
-          tris_low, tris_cage, mat_low, mat_cage, primitive_id, u, v, co, dir);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else if (is_cage) {
-      calc_point_from_barycentric_extrusion(
-          tris_cage, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, true);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else {
-      calc_point_from_barycentric_extrusion(
-          tris_low, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, false);
-      tri_low = &tris_low[primitive_id];
-    }
+  BakeHighPolyRaycastData data = {
+      .pixel_array_from = pixel_array_from,
+      .pixel_array_to = pixel_array_to,
+      .highpoly = highpoly,
+      .tot_highpoly = tot_highpoly,
+      .is_custom_cage = is_custom_cage,
+      .is_cage = is_cage,
+      .cage_extrusion = cage_extrusion,
+      .max_ray_distance = max_ray_distance,
+      .mat_low = mat_low,
+      .imat_low = imat_low,
+      .mat_cage = mat_cage,
+      .tris_low = tris_low,
+      .tris_cage = tris_cage,
+      .tris_high = tris_high,
+      .treeData = treeData,
+  };
 
-    /* cast ray */
-    if (!cast_ray_highpoly(treeData,
-                           tri_low,
-                           tris_high,
-                           pixel_array_from,
-                           pixel_array_to,
-                           mat_low,
-                           highpoly,
-                           co,
-                           dir,
-                           i,
-                           tot_highpoly,
-                           max_ray_distance)) {
-      /* if it fails mask out the original pixel array */
-      pixel_array_from[i].primitive_id = -1;
-    }
-  }
+  /* Pixels are independent, and the BVH trees are only read. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, (int)num_pixels, &data, bake_highpoly_raycast_cb, &settings);
 
   /* garbage collection */
 cleanup:
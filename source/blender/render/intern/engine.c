@@ -47,6 +47,7 @@
 #include "BKE_scene.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_query.h"
 
@@ -148,6 +149,9 @@ void RE_engine_free(RenderEngine *engine)
   }
 #endif
 
+  /* Depsgraph kept with persistent data. */
+  DEG_graph_free(engine->depsgraph);
+
   BLI_mutex_end(&engine->update_render_passes_mutex);
 
   MEM_freeN(engine);
@@ -599,13 +603,42 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+static bool engine_keep_depsgraph(RenderEngine *engine)
+{
+  /* With persistent data the depsgraph is kept between frames and renders, so that engines can
+   * find which data changed and keep the rest. */
+  return (engine->re->r.mode & R_PERSISTENT_DATA) && !(engine->re->r.scemode & R_BUTS_PREVIEW);
+}
+
+static void engine_depsgraph_free(RenderEngine *engine)
+{
+  DEG_graph_free(engine->depsgraph);
+
+  engine->depsgraph = NULL;
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
 
-  engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(engine->depsgraph, "RENDER");
+  /* Reuse the depsgraph kept with persistent data when possible. */
+  if (engine->depsgraph) {
+    if (DEG_get_bmain(engine->depsgraph) != bmain ||
+        DEG_get_input_scene(engine->depsgraph) != scene) {
+      engine_depsgraph_free(engine);
+    }
+    else if (DEG_get_input_view_layer(engine->depsgraph) != view_layer) {
+      /* Objects shared between view layers can still be reused. */
+      DEG_graph_replace_owners(engine->depsgraph, bmain, scene, view_layer);
+      DEG_graph_tag_relations_update(engine->depsgraph);
+    }
+  }
+
+  if (!engine->depsgraph) {
+    engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_debug_name_set(engine->depsgraph, "RENDER");
+  }
 
   if (engine->re->r.scemode & R_BUTS_PREVIEW) {
     Depsgraph *depsgraph = engine->depsgraph;
@@ -621,11 +654,19 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
   engine->has_grease_pencil = DRW_render_check_grease_pencil(engine->depsgraph);
 }
 
-static void engine_depsgraph_free(RenderEngine *engine)
+static void engine_depsgraph_exit(RenderEngine *engine)
 {
-  DEG_graph_free(engine->depsgraph);
+  if (engine->depsgraph == NULL) {
+    return;
+  }
 
-  engine->depsgraph = NULL;
+  if (engine_keep_depsgraph(engine)) {
+    /* The engine has handled the updates of this render, only report changes made after it. */
+    DEG_ids_clear_recalc(engine->re->main, engine->depsgraph);
+  }
+  else {
+    engine_depsgraph_free(engine);
+  }
 }
 
 void RE_engine_frame_set(RenderEngine *engine, int frame, float subframe)
@@ -700,6 +741,8 @@ bool RE_bake_engine(Render *re,
   BLI_rw_mutex_unlock(&re->partsmutex);
 
   if (type->bake) {
+    /* Baking uses the depsgraph of the caller. */
+    engine_depsgraph_free(engine);
     engine->depsgraph = depsgraph;
 
     /* update is only called so we create the engine.session */
@@ -800,8 +843,8 @@ static void engine_render_view_layer(Render *re,
     }
   }
 
-  /* Free dependency graph, if engine has not done it already. */
-  engine_depsgraph_free(engine);
+  /* Free dependency graph, if engine has not done it already and does not keep it. */
+  engine_depsgraph_exit(engine);
 }
 
 int RE_engine_render(Render *re, int do_all)
@@ -1027,6 +1070,10 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
   if (engine->has_grease_pencil) {
     return;
   }
+  /* The depsgraph is needed to find what changed in the next render. */
+  if (engine_keep_depsgraph(engine)) {
+    return;
+  }
   DEG_graph_free(engine->depsgraph);
   engine->depsgraph = NULL;
 }
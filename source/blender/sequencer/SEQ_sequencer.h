@@ -120,6 +120,7 @@ void BKE_sequence_iterator_end(SeqIterator *iter);
 
 typedef enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
+  /* First prefetch worker, the other workers use consecutive values. */
   SEQ_TASK_PREFETCH_RENDER,
 } eSeqTaskId;
 
@@ -245,6 +246,7 @@ void SEQ_proxy_rebuild(struct SeqIndexBuildContext *context,
                        short *stop,
                        short *do_update,
                        float *progress);
+bool SEQ_proxy_rebuild_is_threadsafe(const struct SeqIndexBuildContext *context);
 void SEQ_proxy_rebuild_finish(struct SeqIndexBuildContext *context, bool stop);
 void SEQ_proxy_set(struct Sequence *seq, bool value);
 bool SEQ_can_use_proxy(struct Sequence *seq, int psize);
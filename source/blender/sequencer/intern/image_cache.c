@@ -40,6 +40,7 @@
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
 #include "BLI_threads.h"
@@ -840,68 +841,13 @@ static void seq_cache_relink_keys(SeqCacheKey *link_next, SeqCacheKey *link_prev
   }
 }
 
-/* Choose a key out of 2 candidates(leftmost and rightmost items)
- * to recycle based on currently used strategy */
-static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCacheKey *rkey)
+/* Score of a frame for recycling, frames that are far from the playhead are unlikely to be needed
+ * soon and frames that are cheap to render again cost little to lose. Highest score is recycled
+ * first. */
+static float seq_cache_recycle_score(Scene *scene, SeqCacheKey *key)
 {
-  SeqCacheKey *finalkey = NULL;
-
-  /* Ideally, cache would not need to check the state of prefetching task
-   * that is tricky to do however, because prefetch would need to know,
-   * if a key, that is about to be created would be removed by itself.
-   *
-   * This can happen because only FINAL_OUT item insertion will trigger recycling
-   * but that is also the point, where prefetch can be suspended.
-   *
-   * We could use temp cache as a shield and later make it a non-temporary entry,
-   * but it is not worth of increasing system complexity.
-   */
-  if (scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE &&
-      BKE_sequencer_prefetch_job_is_running(scene)) {
-    int pfjob_start, pfjob_end;
-    BKE_sequencer_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
-
-    if (lkey) {
-      if (lkey->timeline_frame < pfjob_start || lkey->timeline_frame > pfjob_end) {
-        return lkey;
-      }
-    }
-
-    if (rkey) {
-      if (rkey->timeline_frame < pfjob_start || rkey->timeline_frame > pfjob_end) {
-        return rkey;
-      }
-    }
-
-    return NULL;
-  }
-
-  if (rkey && lkey) {
-    if (lkey->timeline_frame > rkey->timeline_frame) {
-      SeqCacheKey *swapkey = lkey;
-      lkey = rkey;
-      rkey = swapkey;
-    }
-
-    int l_diff = scene->r.cfra - lkey->timeline_frame;
-    int r_diff = rkey->timeline_frame - scene->r.cfra;
-
-    if (l_diff > r_diff) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  else {
-    if (lkey) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  return finalkey;
+  const float distance = fabsf(key->timeline_frame - (float)scene->r.cfra);
+  return distance / (1.0f + key->cost);
 }
 
 static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
@@ -931,16 +877,28 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *finalkey = NULL;
-  /* Leftmost key. */
-  SeqCacheKey *lkey = NULL;
-  /* Rightmost key. */
-  SeqCacheKey *rkey = NULL;
+  float finalkey_score = -1.0f;
   SeqCacheKey *key = NULL;
 
+  /* Ideally, cache would not need to check the state of prefetching task
+   * that is tricky to do however, because prefetch would need to know,
+   * if a key, that is about to be created would be removed by itself.
+   *
+   * This can happen because only FINAL_OUT item insertion will trigger recycling
+   * but that is also the point, where prefetch can be suspended.
+   *
+   * We could use temp cache as a shield and later make it a non-temporary entry,
+   * but it is not worth of increasing system complexity.
+   */
+  const bool use_prefetch_range = (scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) &&
+                                  BKE_sequencer_prefetch_job_is_running(scene);
+  int pfjob_start = 0, pfjob_end = 0;
+  if (use_prefetch_range) {
+    BKE_sequencer_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
+  }
+
   GHashIterator gh_iter;
   BLI_ghashIterator_init(&gh_iter, cache->hash);
-  int total_count = 0;
-  int cheap_count = 0;
 
   while (!BLI_ghashIterator_done(&gh_iter)) {
     key = BLI_ghashIterator_getKey(&gh_iter);
@@ -952,6 +910,8 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       seq_cache_recycle_linked(scene, key);
       /* Can not continue iterating after linked remove. */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
+      finalkey = NULL;
+      finalkey_score = -1.0f;
       continue;
     }
 
@@ -959,30 +919,21 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
-    total_count++;
+    if (key->cost > scene->ed->recycle_max_cost) {
+      continue;
+    }
 
-    if (key->cost <= scene->ed->recycle_max_cost) {
-      cheap_count++;
-      if (lkey) {
-        if (key->timeline_frame < lkey->timeline_frame) {
-          lkey = key;
-        }
-      }
-      else {
-        lkey = key;
-      }
-      if (rkey) {
-        if (key->timeline_frame > rkey->timeline_frame) {
-          rkey = key;
-        }
-      }
-      else {
-        rkey = key;
-      }
+    if (use_prefetch_range && key->timeline_frame >= pfjob_start &&
+        key->timeline_frame <= pfjob_end) {
+      continue;
     }
-  }
 
-  finalkey = seq_cache_choose_key(scene, lkey, rkey);
+    const float score = seq_cache_recycle_score(scene, key);
+    if (score > finalkey_score) {
+      finalkey = key;
+      finalkey_score = score;
+    }
+  }
 
   return finalkey;
 }
@@ -536,6 +536,13 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
   }
 }
 
+/* Movie strips are built from their own copy of the strip with separate decoder and encoder
+ * contexts, other strips render through the sequencer. */
+bool SEQ_proxy_rebuild_is_threadsafe(const SeqIndexBuildContext *context)
+{
+  return context->seq->type == SEQ_TYPE_MOVIE;
+}
+
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
 {
   if (context->index_context) {
@@ -37,6 +37,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1772,15 +1773,15 @@ static ImBuf *do_render_strip_uncached(const SeqRenderData *context,
     case SEQ_TYPE_MOVIECLIP: {
       ibuf = seq_render_movieclip_strip(context, seq, frame_index, r_is_proxy_image);
 
-      if (ibuf) {
-        /* duplicate frame so movie cache wouldn't be confused by sequencer's stuff */
+      /* Byte frames are shared with the movie clip cache, further changes to the pixels go
+       * through IMB_makeSingleUser. Float frames are converted to sequencer space in place,
+       * so duplicate them first to keep the movie cache from being confused. */
+      if (ibuf && ibuf->rect_float) {
         ImBuf *i = IMB_dupImBuf(ibuf);
         IMB_freeImBuf(ibuf);
         ibuf = i;
 
-        if (ibuf->rect_float) {
-          seq_imbuf_to_sequencer_space(context->scene, ibuf, false);
-        }
+        seq_imbuf_to_sequencer_space(context->scene, ibuf, false);
       }
 
       break;
@@ -1905,6 +1906,84 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Strips that only read their own media can be rendered on any thread. Strips that render other
+ * strips or scenes, or use them as modifier masks, are rendered in order. */
+static bool seq_can_render_concurrently(Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE, SEQ_TYPE_COLOR)) {
+    return false;
+  }
+
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL || smd->mask_id != NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+typedef struct RenderStripsConcurrentlyData {
+  const SeqRenderData *context;
+  SeqRenderState *state;
+  Sequence **seq_arr;
+  ImBuf **ibuf_arr;
+  float timeline_frame;
+} RenderStripsConcurrentlyData;
+
+static void seq_render_strips_concurrently_fn(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderStripsConcurrentlyData *data = userdata;
+
+  if (data->seq_arr[i] != NULL) {
+    data->ibuf_arr[i] = seq_render_strip(
+        data->context, data->state, data->seq_arr[i], data->timeline_frame);
+  }
+}
+
+/* Render the strips from `start` that get blended on top of the stack ahead of blending, so that
+ * independent strips are decoded and preprocessed in parallel. Strips that can't be rendered
+ * concurrently are left NULL in `ibuf_arr`. */
+static void seq_render_strips_concurrently(const SeqRenderData *context,
+                                           SeqRenderState *state,
+                                           Sequence **seq_arr,
+                                           ImBuf **ibuf_arr,
+                                           int start,
+                                           int count,
+                                           float timeline_frame)
+{
+  Sequence *render_arr[MAXSEQ + 1] = {NULL};
+  int num_render = 0;
+
+  for (int i = start; i < count; i++) {
+    Sequence *seq = seq_arr[i];
+    if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT &&
+        seq_can_render_concurrently(seq)) {
+      render_arr[i] = seq;
+      num_render++;
+    }
+  }
+
+  if (num_render < 2) {
+    return;
+  }
+
+  RenderStripsConcurrentlyData data = {
+      .context = context,
+      .state = state,
+      .seq_arr = render_arr,
+      .ibuf_arr = ibuf_arr,
+      .timeline_frame = timeline_frame,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(start, count, &data, seq_render_strips_concurrently_fn, &settings);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -1973,13 +2052,18 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+
+  ImBuf *ibuf_arr[MAXSEQ + 1] = {NULL};
+  seq_render_strips_concurrently(context, state, seq_arr, ibuf_arr, i, count, timeline_frame);
+
   for (; i < count; i++) {
     begin = seq_estimate_render_cost_begin();
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = ibuf_arr[i] ? ibuf_arr[i] :
+                                   seq_render_strip(context, state, seq, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
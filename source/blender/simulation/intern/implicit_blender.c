@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -50,6 +51,12 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum number of vertices to multi-thread the solver. */
+#  define CLOTH_PARALLEL_LIMIT 1024
+/* Number of vertices summed by one task of a parallel dot product. The blocks are fixed so that
+ * the result does not depend on the number of threads. */
+#  define CLOTH_DOT_BLOCK_SIZE 1024
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -192,6 +199,28 @@ DO_INLINE void submul_lfvectorS(float (*to)[3],
     VECSUBMUL(to[i], fLongVector[i], scalar);
   }
 }
+typedef struct DotLongVectorData {
+  float (*a)[3];
+  float (*b)[3];
+  unsigned int verts;
+  float *block_sums;
+} DotLongVectorData;
+
+static void dot_lfvector_block(void *__restrict userdata,
+                               const int block,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DotLongVectorData *data = userdata;
+  const unsigned int start = (unsigned int)block * CLOTH_DOT_BLOCK_SIZE;
+  const unsigned int end = min_ii(start + CLOTH_DOT_BLOCK_SIZE, data->verts);
+  float temp = 0.0f;
+
+  for (unsigned int i = start; i < end; i++) {
+    temp += dot_v3v3(data->a[i], data->b[i]);
+  }
+  data->block_sums[block] = temp;
+}
+
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3],
                              float (*fLongVectorB)[3],
@@ -199,11 +228,31 @@ DO_INLINE float dot_lfvector(float (*fLongVectorA)[3],
 {
   long i = 0;
   float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  //#pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
+
+  /* Due to non-commutative nature of floating point ops a regular parallel reduction would
+   * give different results each time the sim is run. Instead fixed size blocks are summed in
+   * parallel, and the block sums are added up in order. */
+  if (verts > CLOTH_PARALLEL_LIMIT) {
+    const int num_blocks = (int)((verts + CLOTH_DOT_BLOCK_SIZE - 1) / CLOTH_DOT_BLOCK_SIZE);
+    float *block_sums = MEM_mallocN(sizeof(float) * num_blocks, __func__);
+    DotLongVectorData data = {
+        .a = fLongVectorA,
+        .b = fLongVectorB,
+        .verts = verts,
+        .block_sums = block_sums,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, num_blocks, &data, dot_lfvector_block, &settings);
+
+    for (i = 0; i < num_blocks; i++) {
+      temp += block_sums[i];
+    }
+    MEM_freeN(block_sums);
+    return temp;
+  }
+
   for (i = 0; i < (long)verts; i++) {
     temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
   }
@@ -644,18 +693,149 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/* Index of the blocks of a sparse symmetric big matrix by row, so that the rows of a product
+ * can be computed independently. Off-diagonal blocks are listed in both of their rows, blocks
+ * that are used transposed are stored as `-1 - index`. */
+typedef struct BigMatrixRows {
+  int *offsets; /* start of each row in blocks, vcount + 1 items */
+  int *blocks;
+} BigMatrixRows;
+
+static void create_bfmatrix_rows(BigMatrixRows *rows, unsigned int verts, unsigned int springs)
+{
+  rows->offsets = MEM_callocN(sizeof(int) * (verts + 1), "cloth_implicit_alloc_rows");
+  rows->blocks = MEM_mallocN(sizeof(int) * (verts + 2 * springs), "cloth_implicit_alloc_rows");
+}
+
+static void del_bfmatrix_rows(BigMatrixRows *rows)
+{
+  MEM_SAFE_FREE(rows->offsets);
+  MEM_SAFE_FREE(rows->blocks);
+}
+
+/* Build the row index from the first num_blocks off-diagonal blocks of the matrix. All big
+ * matrices of the solver share the same layout, so one index is valid for all of them. */
+static void update_bfmatrix_rows(BigMatrixRows *rows, fmatrix3x3 *matrix, int num_blocks)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int end = vcount + (unsigned int)num_blocks;
+  int *offsets = rows->offsets;
+  unsigned int i;
+
+  memset(offsets, 0, sizeof(int) * (vcount + 1));
+  for (i = 0; i < vcount; i++) {
+    offsets[i + 1] = 1;
+  }
+  for (i = vcount; i < end; i++) {
+    offsets[matrix[i].r + 1]++;
+    offsets[matrix[i].c + 1]++;
+  }
+  for (i = 0; i < vcount; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  /* Fill the rows, using the offsets as cursors and shifting them back afterwards. */
+  for (i = 0; i < vcount; i++) {
+    rows->blocks[offsets[i]++] = (int)i;
+  }
+  for (i = vcount; i < end; i++) {
+    rows->blocks[offsets[matrix[i].r]++] = (int)i;
+    rows->blocks[offsets[matrix[i].c]++] = -1 - (int)i;
+  }
+  for (i = vcount; i > 0; i--) {
+    offsets[i] = offsets[i - 1];
+  }
+  offsets[0] = 0;
+}
+
+typedef struct MulBigMatrixData {
+  float (*to)[3];
+  fmatrix3x3 *from;
+  const BigMatrixRows *rows;
+  lfVector *fLongVector;
+} MulBigMatrixData;
+
+static void mul_bfmatrix_rows_lfvector_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBigMatrixData *data = userdata;
+  const fmatrix3x3 *from = data->from;
+  const int *blocks = data->rows->blocks;
+  float *to = data->to[i];
+
+  zero_v3(to);
+  for (int k = data->rows->offsets[i]; k < data->rows->offsets[i + 1]; k++) {
+    const int block = blocks[k];
+    if (block >= 0) {
+      muladd_fmatrix_fvector(to, from[block].m, data->fLongVector[from[block].c]);
+    }
+    else {
+      /* This is the lower triangle of the sparse matrix,
+       * therefore multiplication occurs with transposed submatrices. */
+      const fmatrix3x3 *matrix = &from[-1 - block];
+      muladd_fmatrixT_fvector(to, matrix->m, data->fLongVector[matrix->r]);
+    }
+  }
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, one row at a time in parallel */
+DO_INLINE void mul_bfmatrix_rows_lfvector(float (*to)[3],
+                                          fmatrix3x3 *from,
+                                          const BigMatrixRows *rows,
+                                          lfVector *fLongVector)
+{
+  MulBigMatrixData data = {
+      .to = to,
+      .from = from,
+      .rows = rows,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (from[0].vcount > CLOTH_PARALLEL_LIMIT);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, (int)from[0].vcount, &data, mul_bfmatrix_rows_lfvector_cb, &settings);
+}
+
+typedef struct SubaddBigMatrixData {
+  fmatrix3x3 *to, *from, *matrix;
+  float aS, bS;
+} SubaddBigMatrixData;
+
+static void subadd_bfmatrixS_bfmatrixS_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubaddBigMatrixData *data = userdata;
+  subadd_fmatrixS_fmatrixS(data->to[i].m, data->from[i].m, data->aS, data->matrix[i].m, data->bS);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
 DO_INLINE void subadd_bfmatrixS_bfmatrixS(
     fmatrix3x3 *to, fmatrix3x3 *from, float aS, fmatrix3x3 *matrix, float bS)
 {
-  unsigned int i = 0;
+  SubaddBigMatrixData data = {
+      .to = to,
+      .from = from,
+      .matrix = matrix,
+      .aS = aS,
+      .bS = bS,
+  };
 
   /* process diagonal elements */
-  for (i = 0; i < matrix[0].vcount + matrix[0].scount; i++) {
-    subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (matrix[0].vcount > CLOTH_PARALLEL_LIMIT);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0,
+                          (int)(matrix[0].vcount + matrix[0].scount),
+                          &data,
+                          subadd_bfmatrixS_bfmatrixS_cb,
+                          &settings);
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -683,6 +863,7 @@ typedef struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+  BigMatrixRows rows;   /* blocks of the big matrices by row */
 } Implicit_Data;
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
@@ -707,6 +888,7 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->B = create_lfvector(numverts);
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
+  create_bfmatrix_rows(&id->rows, numverts, numsprings);
 
   initdiag_bfmatrix(id->bigI, I);
 
@@ -733,6 +915,7 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->B);
   del_lfvector(id->dV);
   del_lfvector(id->z);
+  del_bfmatrix_rows(&id->rows);
 
   MEM_freeN(id);
 }
@@ -852,6 +1035,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BigMatrixRows *rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -879,7 +1063,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_rows_lfvector(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -902,7 +1086,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_rows_lfvector(q, lA, rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1162,7 +1346,9 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  update_bfmatrix_rows(&data->rows, data->A, data->num_blocks);
+
+  mul_bfmatrix_rows_lfvector(dFdXmV, data->dFdX, &data->rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1171,7 +1357,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &data->rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -712,12 +712,9 @@ static int wm_lib_relocate_invoke(bContext *C, wmOperator *op, const wmEvent *UN
   return OPERATOR_CANCELLED;
 }
 
-static void lib_relocate_do_remap(Main *bmain,
-                                  ID *old_id,
-                                  ID *new_id,
-                                  ReportList *reports,
-                                  const bool do_reload,
-                                  const short remap_flags)
+/* Handle an old ID once all old IDs have been remapped to their new version. */
+static void lib_relocate_do_remap_finalize(
+    Main *bmain, ID *old_id, ID *new_id, ReportList *reports, const bool do_reload)
 {
   BLI_assert(old_id);
   if (do_reload) {
@@ -726,14 +723,6 @@ static void lib_relocate_do_remap(Main *bmain,
     BLI_assert(new_id);
   }
   if (new_id) {
-#ifdef PRINT_DEBUG
-    printf("before remap of %s, old_id users: %d, new_id users: %d\n",
-           old_id->name,
-           old_id->us,
-           new_id->us);
-#endif
-    BKE_libblock_remap_locked(bmain, old_id, new_id, remap_flags);
-
     if (old_id->flag & LIB_FAKEUSER) {
       id_fake_user_clear(old_id);
       id_fake_user_set(new_id);
@@ -883,17 +872,31 @@ static void lib_relocate_do(Main *bmain,
   const short remap_flags = ID_REMAP_SKIP_NEVER_NULL_USAGE |
                             ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE |
                             (do_reload ? 0 : ID_REMAP_SKIP_INDIRECT_USAGE);
+
+  /* All old IDs are remapped at once, this avoids a full pass over Main for each of them. */
+  GHash *old_to_new_ids = BLI_ghash_ptr_new_ex(__func__, (uint)lapp_data->num_items);
+  for (itemlink = lapp_data->items.list; itemlink; itemlink = itemlink->next) {
+    WMLinkAppendDataItem *item = itemlink->link;
+    if (item->new_id != NULL) {
+      BLI_ghash_insert(old_to_new_ids, item->customdata, item->new_id);
+    }
+  }
+  BKE_libblock_remap_multiple_locked(bmain, old_to_new_ids, remap_flags);
+
+  /* Usual special code for ShapeKeys snowflakes... Their owners must not use them while they are
+   * remapped, so they are remapped in a second batch. */
+  Key **old_keys = MEM_calloc_arrayN((size_t)lapp_data->num_items, sizeof(*old_keys), __func__);
+  BLI_ghash_clear(old_to_new_ids, NULL, NULL);
   for (item_idx = 0, itemlink = lapp_data->items.list; itemlink;
        item_idx++, itemlink = itemlink->next) {
     WMLinkAppendDataItem *item = itemlink->link;
     ID *old_id = item->customdata;
     ID *new_id = item->new_id;
 
-    lib_relocate_do_remap(bmain, old_id, new_id, reports, do_reload, remap_flags);
+    lib_relocate_do_remap_finalize(bmain, old_id, new_id, reports, do_reload);
     if (new_id == NULL) {
       continue;
     }
-    /* Usual special code for ShapeKeys snowflakes... */
     Key **old_key_p = BKE_key_from_id_p(old_id);
     if (old_key_p == NULL) {
       continue;
@@ -903,11 +906,25 @@ static void lib_relocate_do(Main *bmain,
     if (old_key != NULL) {
       *old_key_p = NULL;
       id_us_min(&old_key->id);
-      lib_relocate_do_remap(bmain, &old_key->id, &new_key->id, reports, do_reload, remap_flags);
-      *old_key_p = old_key;
+      BLI_ghash_insert(old_to_new_ids, &old_key->id, &new_key->id);
+      old_keys[item_idx] = old_key;
+    }
+  }
+  BKE_libblock_remap_multiple_locked(bmain, old_to_new_ids, remap_flags);
+  BLI_ghash_free(old_to_new_ids, NULL, NULL);
+
+  for (item_idx = 0, itemlink = lapp_data->items.list; itemlink;
+       item_idx++, itemlink = itemlink->next) {
+    WMLinkAppendDataItem *item = itemlink->link;
+    Key *old_key = old_keys[item_idx];
+    if (old_key != NULL) {
+      Key *new_key = BKE_key_from_id(item->new_id);
+      lib_relocate_do_remap_finalize(bmain, &old_key->id, &new_key->id, reports, do_reload);
+      *BKE_key_from_id_p(item->customdata) = old_key;
       id_us_plus_no_lib(&old_key->id);
     }
   }
+  MEM_freeN(old_keys);
 
   BKE_main_unlock(bmain);
 
@@ -49,6 +49,7 @@
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
+#include "BLO_readfile.h"
 #include "BLO_undofile.h"
 #include "BLO_writefile.h"
 
@@ -578,6 +579,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
 #endif
 
   BKE_subdiv_exit();
+  BKE_image_gpu_load_exit();
 
   if (opengl_is_init) {
     BKE_image_free_unused_gpu_textures();
@@ -647,6 +649,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   GHOST_DisposeSystemPaths();
 
+  BLO_file_dna_cache_clear();
   DNA_sdna_current_free();
 
   BLI_threadapi_exit();
@@ -297,6 +297,16 @@ int main(int argc,
         break;
       }
     }
+    /* Profile from the start as well, so that all blocks are accounted for. */
+    for (i = 0; i < argc; i++) {
+      if (STREQ(argv[i], "--debug-memory-profile")) {
+        MEM_profile_enable();
+        break;
+      }
+      if (STREQ(argv[i], "--")) {
+        break;
+      }
+    }
     MEM_init_memleak_detection();
   }
 
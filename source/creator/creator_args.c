@@ -45,6 +45,7 @@
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
 
+#  include "BKE_blender.h"
 #  include "BKE_blender_version.h"
 #  include "BKE_context.h"
 
@@ -577,6 +578,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-cycles");
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--debug-memory-profile");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -1058,6 +1060,25 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static void memory_profile_print_atexit(void *UNUSED(user_data))
+{
+  MEM_profile_print();
+}
+
+static const char arg_handle_debug_mode_memory_profile_set_doc[] =
+    "\n\t"
+    "Collect memory statistics per allocation name (live memory and total allocations),\n"
+    "\tprinted on exit. Also available from Python with 'bpy.app.memory'.";
+static int arg_handle_debug_mode_memory_profile_set(int UNUSED(argc),
+                                                    const char **UNUSED(argv),
+                                                    void *UNUSED(data))
+{
+  /* Profiling is already enabled in main(), before any allocation happened. */
+  MEM_profile_enable();
+  BKE_blender_atexit_register(memory_profile_print_atexit, NULL);
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -2110,6 +2131,8 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_args_add(ba, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_args_add(
+      ba, NULL, "--debug-memory-profile", CB(arg_handle_debug_mode_memory_profile_set), NULL);
 
   BLI_args_add(ba, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_args_add(ba,
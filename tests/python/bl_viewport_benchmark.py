@@ -0,0 +1,192 @@
+# Apache License, Version 2.0
+
+# Interactive workflow benchmark. Drawing needs a GPU context, so this runs with a window and
+# not in background mode:
+#
+# ./blender.bin --factory-startup -noaudio --python tests/python/bl_viewport_benchmark.py -- \
+#     --scenes scene_a.blend scene_b.blend --output /tmp/viewport_benchmark.json
+#
+# Each scene is opened with its UI and timed for:
+# - drawing the whole window,
+# - animation playback of the scene frame range, including drawing,
+# - entering and leaving edit mode on the active object,
+# - an undo push, and an undo and redo step.
+#
+# Timings are written as JSON, one entry per scene, so that reports from different builds can
+# be compared for regressions. Blender quits when all scenes are done.
+
+import argparse
+import json
+import os
+import statistics
+import sys
+import time
+
+import bpy
+
+
+def time_calls(func, iterations):
+    timings = []
+    for _ in range(iterations):
+        time_start = time.perf_counter()
+        func()
+        timings.append(time.perf_counter() - time_start)
+
+    return {
+        "iterations": iterations,
+        "min": min(timings),
+        "median": statistics.median(timings),
+        "mean": statistics.mean(timings),
+    }
+
+
+def context_override():
+    window = bpy.context.window_manager.windows[0]
+    screen = window.screen
+    override = {"window": window, "screen": screen}
+
+    for area in screen.areas:
+        if area.type == 'VIEW_3D':
+            override["area"] = area
+            override["region"] = next(region for region in area.regions if region.type == 'WINDOW')
+            break
+
+    return override
+
+
+def benchmark_draw(override, args):
+    return time_calls(
+        lambda: bpy.ops.wm.redraw_timer(override, type='DRAW_WIN_SWAP', iterations=1),
+        args.iterations)
+
+
+def benchmark_playback(override, args):
+    scene = bpy.context.scene
+    frames = scene.frame_end - scene.frame_start + 1
+    result = time_calls(
+        lambda: bpy.ops.wm.redraw_timer(override, type='ANIM_PLAY', iterations=1),
+        args.playback_iterations)
+    result["frames"] = frames
+    result["fps"] = frames / result["median"]
+    return result
+
+
+def benchmark_edit_mode(override, args):
+    ob = bpy.context.view_layer.objects.active
+    if ob is None or ob.type not in {'MESH', 'CURVE', 'SURFACE', 'ARMATURE', 'LATTICE'}:
+        return None
+
+    enter_timings = []
+    exit_timings = []
+    for _ in range(args.iterations):
+        enter_timings.append(time_calls(
+            lambda: bpy.ops.object.mode_set(override, mode='EDIT'), 1)["min"])
+        exit_timings.append(time_calls(
+            lambda: bpy.ops.object.mode_set(override, mode='OBJECT'), 1)["min"])
+
+    return {
+        "object": ob.name,
+        "enter_median": statistics.median(enter_timings),
+        "exit_median": statistics.median(exit_timings),
+    }
+
+
+def benchmark_undo_push(override, args):
+    return time_calls(
+        lambda: bpy.ops.ed.undo_push(override, message="Benchmark"),
+        args.iterations)
+
+
+def benchmark_undo_redo(override, args):
+    return time_calls(
+        lambda: bpy.ops.wm.redraw_timer(override, type='UNDO', iterations=1),
+        args.iterations)
+
+
+BENCHMARKS = (
+    ("draw", benchmark_draw),
+    ("playback", benchmark_playback),
+    ("edit_mode", benchmark_edit_mode),
+    ("undo_push", benchmark_undo_push),
+    ("undo_redo", benchmark_undo_redo),
+)
+
+
+class ViewportBenchmark:
+
+    def __init__(self, args):
+        self.args = args
+        self.scenes = list(args.scenes)
+        self.report = {
+            "blender_version": bpy.app.version_string,
+            "build_hash": bpy.app.build_hash.decode("utf-8", "replace"),
+            "scenes": {},
+        }
+        self.current = None
+
+    def step(self):
+        # Benchmarks of a scene run one timer step after loading it, so that the window and its
+        # draw data exist.
+        if self.current is not None:
+            self.report["scenes"][self.current] = self.run_scene()
+            self.current = None
+
+        if not self.scenes:
+            self.write_report()
+            bpy.ops.wm.quit_blender()
+            return None
+
+        filepath = self.scenes.pop(0)
+        self.current = os.path.basename(filepath)
+        bpy.ops.wm.open_mainfile(filepath=filepath, load_ui=True)
+        return self.args.settle_time
+
+    def run_scene(self):
+        override = context_override()
+        results = {}
+
+        for name, func in BENCHMARKS:
+            if name in self.args.skip:
+                continue
+            try:
+                result = func(override, self.args)
+            except Exception as ex:
+                result = {"error": str(ex)}
+            if result is not None:
+                results[name] = result
+            print("{:s} {:s}: {!r}".format(self.current, name, result))
+
+        return results
+
+    def write_report(self):
+        with open(self.args.output, "w", encoding="utf-8") as fh:
+            json.dump(self.report, fh, indent=2, sort_keys=True)
+        print("Viewport benchmark report written to {:s}".format(self.args.output))
+
+
+def main():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+
+    parser = argparse.ArgumentParser(description="Interactive workflow benchmark")
+    parser.add_argument("--scenes", nargs="+", required=True, help="Blend files to benchmark")
+    parser.add_argument("--output", required=True, help="JSON report file")
+    parser.add_argument("--iterations", type=int, default=10,
+                        help="Number of repetitions for short benchmarks")
+    parser.add_argument("--playback-iterations", type=int, default=3,
+                        help="Number of times the frame range is played back")
+    parser.add_argument("--settle-time", type=float, default=1.0,
+                        help="Seconds to wait after loading a scene before timing it")
+    parser.add_argument("--skip", nargs="*", default=[],
+                        choices=[name for name, _ in BENCHMARKS], help="Benchmarks to skip")
+    args = parser.parse_args(argv)
+
+    if bpy.app.background:
+        print("Viewport benchmark needs a window, run without --background")
+        sys.exit(1)
+
+    benchmark = ViewportBenchmark(args)
+    bpy.app.timers.register(benchmark.step, first_interval=args.settle_time, persistent=True)
+
+
+if __name__ == "__main__":
+    main()